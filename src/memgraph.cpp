@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -196,6 +196,31 @@ DEFINE_bool(allow_load_csv, true, "Controls whether LOAD CSV clause is allowed i
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_VALIDATED_uint64(storage_gc_cycle_sec, 30, "Storage garbage collector interval (in seconds).",
                         FLAG_IN_RANGE(1, 24 * 3600));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(storage_gc_thread_count, memgraph::storage::Config::Gc().num_threads,
+                        "Number of threads used by a single run of the storage garbage collector.",
+                        FLAG_IN_RANGE(1, 1024));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_gc_adaptive, false,
+            "Controls whether the storage garbage collector also runs right away when one of its triggers is "
+            "reached. Its interval is doubled up to --storage-gc-max-cycle-sec while there is nothing to collect.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(storage_gc_max_cycle_sec, 300,
+                        "Maximum interval of the adaptive storage garbage collector (in seconds).",
+                        FLAG_IN_RANGE(1, 24 * 3600));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(storage_gc_trigger_transactions, memgraph::storage::Config::Gc().trigger_transactions,
+              "Number of committed transactions added since the last run which triggers the adaptive storage "
+              "garbage collector. Set to 0 to disable the trigger.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(storage_gc_trigger_delta_mb, memgraph::storage::Config::Gc().trigger_delta_bytes / 1024 / 1024,
+              "Size of the deltas (in MiB) added since the last run which triggers the adaptive storage garbage "
+              "collector. Set to 0 to disable the trigger.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(storage_gc_trigger_memory_percent, 80,
+                        "Percentage of the memory limit in use after which any new garbage triggers the adaptive "
+                        "storage garbage collector. Set to 0 to disable the trigger.",
+                        FLAG_IN_RANGE(0, 100));
 // NOTE: The `storage_properties_on_edges` flag must be the same here and in
 // `mg_import_csv`. If you change it, make sure to change it there as well.
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
@@ -215,6 +240,12 @@ DEFINE_bool(storage_wal_enabled, false,
 DEFINE_VALIDATED_uint64(storage_snapshot_retention_count, 3, "The number of snapshots that should always be kept.",
                         FLAG_IN_RANGE(1, 1000000));
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(storage_snapshot_incremental_count, 0,
+                        "Number of incremental snapshots, which hold only the objects modified since the previous "
+                        "snapshot, that are created between two full snapshots. Set to 0 to disable incremental "
+                        "snapshots.",
+                        FLAG_IN_RANGE(0, 1000000));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_VALIDATED_uint64(storage_wal_file_size_kib, memgraph::storage::Config::Durability().wal_file_size_kibibytes,
                         "Minimum file size of each WAL file.",
                         FLAG_IN_RANGE(1, static_cast<unsigned long>(1000) * 1024));
@@ -225,7 +256,61 @@ DEFINE_VALIDATED_uint64(storage_wal_file_flush_every_n_tx,
                         "WAL file. Set to 1 for fully synchronous operation.",
                         FLAG_IN_RANGE(1, 1000000));
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(storage_wal_fsync_interval_ms,
+                        memgraph::storage::Config::Durability().wal_fsync_interval.count(),
+                        "Interval (in milliseconds) of the WAL 'fsync' calls when the commit durability is "
+                        "PERIODIC_FSYNC.",
+                        FLAG_IN_RANGE(1, 60000));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_bool(storage_snapshot_on_exit, false, "Controls whether the storage creates another snapshot on exit.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_durability_async_writes, false,
+            "Controls whether the snapshot and WAL files are written asynchronously using io_uring. The blocking "
+            "writes are used if io_uring isn't available.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(storage_items_per_batch, memgraph::storage::Config::Durability().items_per_batch,
+                        "The number of vertices or edges written to a snapshot as a single batch. The batches "
+                        "are recovered in parallel.",
+                        FLAG_IN_RANGE(1, std::numeric_limits<uint32_t>::max()));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(storage_recovery_thread_count, memgraph::storage::Config::Durability().recovery_thread_count,
+                        "The number of threads used to recover persisted data and to recreate the indices and "
+                        "constraints on startup.",
+                        FLAG_IN_RANGE(1, 1024));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(storage_snapshot_thread_count, memgraph::storage::Config::Durability().snapshot_thread_count,
+                        "The number of threads used to write the vertices and edges of a snapshot.",
+                        FLAG_IN_RANGE(1, 1024));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(storage_index_creation_threads, memgraph::storage::Config::IndexCreation().num_threads,
+                        "Number of threads used to scan the vertices when an index is created.",
+                        FLAG_IN_RANGE(1, 1024));
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_bool(storage_index_creation_concurrent, false,
+            "Controls whether indices are populated while writes are running. The storage is then locked "
+            "exclusively only at the start and at the end of the index creation.");
+
+namespace {
+std::vector<std::pair<std::string, std::string>> storage_property_columns;
+}  // namespace
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_string(storage_property_columns, "",
+                        "Comma-separated list of Label.property pairs whose values are kept in columns, which makes "
+                        "the aggregations of the properties over all vertices with the label much faster.",
+                        {
+                          storage_property_columns.clear();
+                          if (value.empty()) return true;
+                          for (const auto &column : memgraph::utils::Split(value, ",")) {
+                            const auto parts = memgraph::utils::Split(column, ".");
+                            if (parts.size() != 2 || parts[0].empty() || parts[1].empty()) {
+                              std::cout << "Expected --" << flagname << " to be a list of Label.property pairs."
+                                        << std::endl;
+                              return false;
+                            }
+                            storage_property_columns.emplace_back(parts[0], parts[1]);
+                          }
+                          return true;
+                        });
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_bool(telemetry_enabled, false,
@@ -314,6 +399,72 @@ DEFINE_VALIDATED_string(isolation_level, "SNAPSHOT_ISOLATION", isolation_level_h
   return true;
 });
 
+namespace {
+inline constexpr std::array durability_compression_mappings{
+    std::pair{"NONE"sv, memgraph::storage::Config::Durability::Compression::NONE},
+    std::pair{"ZLIB"sv, memgraph::storage::Config::Durability::Compression::ZLIB}};
+
+const std::string durability_compression_help_string =
+    fmt::format("Block compression of the snapshot and WAL files. Allowed values: {}",
+                GetAllowedEnumValuesString(durability_compression_mappings));
+}  // namespace
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_string(storage_durability_compression, "NONE", durability_compression_help_string.c_str(), {
+  if (const auto result = IsValidEnumValueString(value, durability_compression_mappings); result.HasError()) {
+    const auto error = result.GetError();
+    switch (error) {
+      case ValidationError::EmptyValue: {
+        std::cout << "Durability compression cannot be empty." << std::endl;
+        break;
+      }
+      case ValidationError::InvalidValue: {
+        std::cout << "Invalid value for durability compression. Allowed values: "
+                  << GetAllowedEnumValuesString(durability_compression_mappings) << std::endl;
+        break;
+      }
+    }
+    return false;
+  }
+
+  return true;
+});
+
+namespace {
+inline constexpr std::array commit_durability_mappings{
+    std::pair{"ASYNC"sv, memgraph::storage::Config::Durability::CommitDurability::ASYNC},
+    std::pair{"FSYNC_ON_COMMIT"sv, memgraph::storage::Config::Durability::CommitDurability::FSYNC_ON_COMMIT},
+    std::pair{"PERIODIC_FSYNC"sv, memgraph::storage::Config::Durability::CommitDurability::PERIODIC_FSYNC}};
+
+const std::string commit_durability_help_string = fmt::format(
+    "Default durability of the committed transactions when the WAL is enabled. ASYNC syncs the WAL after "
+    "--storage-wal-file-flush-every-n-tx transactions, FSYNC_ON_COMMIT waits for the WAL to be synced (concurrent "
+    "commits share a single sync) and PERIODIC_FSYNC syncs the WAL every --storage-wal-fsync-interval-ms. "
+    "Allowed values: {}",
+    GetAllowedEnumValuesString(commit_durability_mappings));
+}  // namespace
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_string(storage_wal_commit_durability, "ASYNC", commit_durability_help_string.c_str(), {
+  if (const auto result = IsValidEnumValueString(value, commit_durability_mappings); result.HasError()) {
+    const auto error = result.GetError();
+    switch (error) {
+      case ValidationError::EmptyValue: {
+        std::cout << "Commit durability cannot be empty." << std::endl;
+        break;
+      }
+      case ValidationError::InvalidValue: {
+        std::cout << "Invalid value for commit durability. Allowed values: "
+                  << GetAllowedEnumValuesString(commit_durability_mappings) << std::endl;
+        break;
+      }
+    }
+    return false;
+  }
+
+  return true;
+});
+
 namespace {
 memgraph::storage::IsolationLevel ParseIsolationLevel() {
   const auto isolation_level =
@@ -322,6 +473,20 @@ memgraph::storage::IsolationLevel ParseIsolationLevel() {
   return *isolation_level;
 }
 
+memgraph::storage::Config::Durability::Compression ParseDurabilityCompression() {
+  const auto compression = StringToEnum<memgraph::storage::Config::Durability::Compression>(
+      FLAGS_storage_durability_compression, durability_compression_mappings);
+  MG_ASSERT(compression, "Invalid durability compression");
+  return *compression;
+}
+
+memgraph::storage::Config::Durability::CommitDurability ParseCommitDurability() {
+  const auto commit_durability = StringToEnum<memgraph::storage::Config::Durability::CommitDurability>(
+      FLAGS_storage_wal_commit_durability, commit_durability_mappings);
+  MG_ASSERT(commit_durability, "Invalid commit durability");
+  return *commit_durability;
+}
+
 int64_t GetMemoryLimit() {
   if (FLAGS_memory_limit == 0) {
     auto maybe_total_memory = memgraph::utils::sysinfo::TotalMemory();
@@ -871,17 +1036,34 @@ int main(int argc, char **argv) {
 
   // Main storage and execution engines initialization
   memgraph::storage::Config db_config{
-      .gc = {.type = memgraph::storage::Config::Gc::Type::PERIODIC,
-             .interval = std::chrono::seconds(FLAGS_storage_gc_cycle_sec)},
+      .gc = {.type = FLAGS_storage_gc_adaptive ? memgraph::storage::Config::Gc::Type::ADAPTIVE
+                                               : memgraph::storage::Config::Gc::Type::PERIODIC,
+             .interval = std::chrono::seconds(FLAGS_storage_gc_cycle_sec),
+             .max_interval = std::chrono::seconds(FLAGS_storage_gc_max_cycle_sec),
+             .trigger_transactions = FLAGS_storage_gc_trigger_transactions,
+             .trigger_delta_bytes = FLAGS_storage_gc_trigger_delta_mb * 1024 * 1024,
+             .trigger_memory_ratio = static_cast<double>(FLAGS_storage_gc_trigger_memory_percent) / 100.0,
+             .num_threads = FLAGS_storage_gc_thread_count},
       .items = {.properties_on_edges = FLAGS_storage_properties_on_edges},
       .durability = {.storage_directory = FLAGS_data_directory,
                      .recover_on_startup = FLAGS_storage_recover_on_startup,
                      .snapshot_retention_count = FLAGS_storage_snapshot_retention_count,
+                     .snapshot_incremental_count = FLAGS_storage_snapshot_incremental_count,
                      .wal_file_size_kibibytes = FLAGS_storage_wal_file_size_kib,
                      .wal_file_flush_every_n_tx = FLAGS_storage_wal_file_flush_every_n_tx,
+                     .commit_durability = ParseCommitDurability(),
+                     .wal_fsync_interval = std::chrono::milliseconds(FLAGS_storage_wal_fsync_interval_ms),
                      .snapshot_on_exit = FLAGS_storage_snapshot_on_exit,
-                     .restore_replicas_on_startup = true},
-      .transaction = {.isolation_level = ParseIsolationLevel()}};
+                     .restore_replicas_on_startup = true,
+                     .items_per_batch = FLAGS_storage_items_per_batch,
+                     .recovery_thread_count = FLAGS_storage_recovery_thread_count,
+                     .snapshot_thread_count = FLAGS_storage_snapshot_thread_count,
+                     .compression = ParseDurabilityCompression(),
+                     .async_writes = FLAGS_storage_durability_async_writes},
+      .transaction = {.isolation_level = ParseIsolationLevel()},
+      .index_creation = {.num_threads = FLAGS_storage_index_creation_threads,
+                         .concurrent = FLAGS_storage_index_creation_concurrent},
+      .columns = {.label_properties = storage_property_columns}};
   if (FLAGS_storage_snapshot_interval_sec == 0) {
     if (FLAGS_storage_wal_enabled) {
       LOG_FATAL(
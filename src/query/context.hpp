@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -24,6 +24,12 @@
 
 namespace memgraph::query {
 
+class CompiledExpressions;
+
+namespace plan {
+class VertexMorsels;
+}  // namespace plan
+
 struct EvaluationContext {
   /// Memory for allocations during evaluation of a *single* Pull call.
   ///
@@ -73,6 +79,13 @@ struct ExecutionContext {
   ExecutionStats execution_stats;
   TriggerContextCollector *trigger_context_collector{nullptr};
   utils::AsyncTimer timer;
+  /// Set only for the workers of a `ParallelAggregate`. The scan at the start of
+  /// the worker's pipeline takes its vertices from the shared morsels instead of
+  /// scanning the storage on its own.
+  plan::VertexMorsels *vertex_morsels{nullptr};
+  /// Compiled expressions of the executed plan, which are evaluated instead of
+  /// walking the expressions with `ExpressionEvaluator`.
+  const CompiledExpressions *compiled_expressions{nullptr};
 #ifdef MG_ENTERPRISE
   std::unique_ptr<FineGrainedAuthChecker> auth_checker{nullptr};
 #endif
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -17,6 +17,7 @@
 #include "query/frontend/semantic/required_privileges.hpp"
 #include "query/frontend/semantic/symbol_generator.hpp"
 #include "query/frontend/stripped.hpp"
+#include "query/interpret/compiled_expression.hpp"
 #include "query/plan/planner.hpp"
 #include "utils/flag_validation.hpp"
 #include "utils/timer.hpp"
@@ -55,6 +56,9 @@ class CachedPlan {
   double cost() const { return plan_->GetCost(); }
   const auto &symbol_table() const { return plan_->GetSymbolTable(); }
   const auto &ast_storage() const { return plan_->GetAstStorage(); }
+  /// Expressions of the plan which are compiled once and evaluated by every
+  /// execution of the plan.
+  const auto &compiled_expressions() const { return compiled_expressions_; }
 
   bool IsExpired() const {
     // NOLINTNEXTLINE (modernize-use-nullptr)
@@ -63,6 +67,7 @@ class CachedPlan {
 
  private:
   std::unique_ptr<LogicalPlan> plan_;
+  CompiledExpressions compiled_expressions_;
   utils::Timer cache_timer_;
 };
 
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -121,6 +121,11 @@ class VertexAccessor final {
     return impl_.GetProperty(key, view);
   }
 
+  storage::Result<storage::PropertyPredicate::Result> CheckPropertyPredicate(
+      storage::View view, storage::PropertyId key, const storage::PropertyPredicate &predicate) const {
+    return impl_.CheckPropertyPredicate(key, predicate, view);
+  }
+
   storage::Result<storage::PropertyValue> SetProperty(storage::PropertyId key, const storage::PropertyValue &value) {
     return impl_.SetProperty(key, value);
   }
@@ -166,9 +171,13 @@ class VertexAccessor final {
     return iter::imap(MakeEdgeAccessor, std::move(*maybe_edges));
   }
 
-  storage::Result<size_t> InDegree(storage::View view) const { return impl_.InDegree(view); }
+  storage::Result<size_t> InDegree(storage::View view, const std::vector<storage::EdgeTypeId> &edge_types = {}) const {
+    return impl_.InDegree(view, edge_types);
+  }
 
-  storage::Result<size_t> OutDegree(storage::View view) const { return impl_.OutDegree(view); }
+  storage::Result<size_t> OutDegree(storage::View view, const std::vector<storage::EdgeTypeId> &edge_types = {}) const {
+    return impl_.OutDegree(view, edge_types);
+  }
 
   int64_t CypherId() const { return impl_.Gid().AsInt(); }
 
@@ -302,6 +311,35 @@ class VerticesIterable final {
   }
 };
 
+class EdgesIterable final {
+  storage::EdgesIterable iterable_;
+
+ public:
+  class Iterator final {
+    storage::EdgesIterable::Iterator it_;
+
+   public:
+    explicit Iterator(storage::EdgesIterable::Iterator it) : it_(std::move(it)) {}
+
+    EdgeAccessor operator*() const { return EdgeAccessor(*it_); }
+
+    Iterator &operator++() {
+      ++it_;
+      return *this;
+    }
+
+    bool operator==(const Iterator &other) const { return it_ == other.it_; }
+
+    bool operator!=(const Iterator &other) const { return !(other == *this); }
+  };
+
+  explicit EdgesIterable(storage::EdgesIterable iterable) : iterable_(std::move(iterable)) {}
+
+  Iterator begin() { return Iterator(iterable_.begin()); }
+
+  Iterator end() { return Iterator(iterable_.end()); }
+};
+
 class DbAccessor final {
   storage::Storage::Accessor *accessor_;
 
@@ -322,6 +360,16 @@ class DbAccessor final {
     return VerticesIterable(accessor_->Vertices(label, view));
   }
 
+  /// Splits the vertices into at most `num_chunks` chunks, which can be
+  /// scanned concurrently.
+  storage::VertexChunks ChunkVertices(storage::View view, uint64_t num_chunks) {
+    return accessor_->ChunkVertices(view, num_chunks);
+  }
+
+  storage::VertexChunks ChunkVertices(storage::View view, storage::LabelId label, uint64_t num_chunks) {
+    return accessor_->ChunkVertices(label, view, num_chunks);
+  }
+
   VerticesIterable Vertices(storage::View view, storage::LabelId label, storage::PropertyId property) {
     return VerticesIterable(accessor_->Vertices(label, property, view));
   }
@@ -337,6 +385,23 @@ class DbAccessor final {
     return VerticesIterable(accessor_->Vertices(label, property, lower, upper, view));
   }
 
+  VerticesIterable Vertices(storage::View view, storage::LabelId label,
+                            const std::vector<storage::PropertyId> &properties,
+                            const std::vector<storage::PropertyValue> &prefix,
+                            const std::optional<utils::Bound<storage::PropertyValue>> &lower,
+                            const std::optional<utils::Bound<storage::PropertyValue>> &upper) {
+    return VerticesIterable(accessor_->Vertices(label, properties, prefix, lower, upper, view));
+  }
+
+  EdgesIterable Edges(storage::View view, storage::EdgeTypeId edge_type) {
+    return EdgesIterable(accessor_->Edges(edge_type, view));
+  }
+
+  EdgesIterable Edges(storage::View view, storage::EdgeTypeId edge_type, storage::PropertyId property,
+                      const storage::PropertyValue &value) {
+    return EdgesIterable(accessor_->Edges(edge_type, property, value, view));
+  }
+
   VertexAccessor InsertVertex() { return VertexAccessor(accessor_->CreateVertex()); }
 
   storage::Result<EdgeAccessor> InsertEdge(VertexAccessor *from, VertexAccessor *to,
@@ -422,6 +487,30 @@ class DbAccessor final {
     return accessor_->LabelPropertyIndexExists(label, prop);
   }
 
+  bool LabelPropertyCompositeIndexExists(storage::LabelId label,
+                                         const std::vector<storage::PropertyId> &properties) const {
+    return accessor_->LabelPropertyCompositeIndexExists(label, properties);
+  }
+
+  std::vector<std::vector<storage::PropertyId>> LabelPropertyCompositeIndices(storage::LabelId label) const {
+    return accessor_->LabelPropertyCompositeIndices(label);
+  }
+
+  bool EdgeTypeIndexExists(storage::EdgeTypeId edge_type) const { return accessor_->EdgeTypeIndexExists(edge_type); }
+
+  bool EdgeTypePropertyIndexExists(storage::EdgeTypeId edge_type, storage::PropertyId property) const {
+    return accessor_->EdgeTypePropertyIndexExists(edge_type, property);
+  }
+
+  bool PropertyColumnExists(storage::LabelId label, storage::PropertyId property) const {
+    return accessor_->PropertyColumnExists(label, property);
+  }
+
+  std::optional<storage::PropertyColumnsScanResult> ScanPropertyColumns(
+      storage::View view, storage::LabelId label, const std::vector<storage::PropertyId> &properties) {
+    return accessor_->ScanPropertyColumns(label, properties, view);
+  }
+
   int64_t VerticesCount() const { return accessor_->ApproximateVertexCount(); }
 
   int64_t VerticesCount(storage::LabelId label) const { return accessor_->ApproximateVertexCount(label); }
@@ -441,6 +530,44 @@ class DbAccessor final {
     return accessor_->ApproximateVertexCount(label, property, lower, upper);
   }
 
+  int64_t VerticesCount(storage::LabelId label, const std::vector<storage::PropertyId> &properties,
+                        const std::vector<storage::PropertyValue> &prefix) const {
+    return accessor_->ApproximateVertexCount(label, properties, prefix);
+  }
+
+  int64_t VerticesCount(storage::LabelId label, const std::vector<storage::PropertyId> &properties,
+                        const std::vector<storage::PropertyValue> &prefix,
+                        const std::optional<utils::Bound<storage::PropertyValue>> &lower,
+                        const std::optional<utils::Bound<storage::PropertyValue>> &upper) const {
+    return accessor_->ApproximateVertexCount(label, properties, prefix, lower, upper);
+  }
+
+  int64_t EdgesCount(storage::EdgeTypeId edge_type) const { return accessor_->ApproximateEdgeCount(edge_type); }
+
+  int64_t EdgesCount(storage::EdgeTypeId edge_type, storage::PropertyId property) const {
+    return accessor_->ApproximateEdgeCount(edge_type, property);
+  }
+
+  int64_t EdgesCount(storage::EdgeTypeId edge_type, storage::PropertyId property,
+                     const storage::PropertyValue &value) const {
+    return accessor_->ApproximateEdgeCount(edge_type, property, value);
+  }
+
+  std::optional<storage::LabelStats> GetLabelStats(storage::LabelId label) const {
+    return accessor_->GetLabelStats(label);
+  }
+
+  std::optional<storage::LabelPropertyStats> GetLabelPropertyStats(storage::LabelId label,
+                                                                   storage::PropertyId property) const {
+    return accessor_->GetLabelPropertyStats(label, property);
+  }
+
+  std::optional<storage::EdgeTypeStats> GetEdgeTypeStats(storage::EdgeTypeId edge_type) const {
+    return accessor_->GetEdgeTypeStats(edge_type);
+  }
+
+  std::optional<double> GetAverageDegree() const { return accessor_->GetAverageDegree(); }
+
   storage::IndicesInfo ListAllIndices() const { return accessor_->ListAllIndices(); }
 
   storage::ConstraintsInfo ListAllConstraints() const { return accessor_->ListAllConstraints(); }
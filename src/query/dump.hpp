@@ -55,6 +55,9 @@ struct PullPlanDump {
 
   PullChunk CreateLabelIndicesPullChunk();
   PullChunk CreateLabelPropertyIndicesPullChunk();
+  PullChunk CreateLabelPropertyCompositeIndicesPullChunk();
+  PullChunk CreateEdgeTypeIndicesPullChunk();
+  PullChunk CreateEdgeTypePropertyIndicesPullChunk();
   PullChunk CreateExistenceConstraintsPullChunk();
   PullChunk CreateUniqueConstraintsPullChunk();
   PullChunk CreateInternalIndexPullChunk();
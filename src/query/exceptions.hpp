@@ -224,6 +224,12 @@ class SettingConfigInMulticommandTxException final : public QueryException {
       : QueryException("Settings cannot be changed or fetched in multicommand transactions.") {}
 };
 
+class AnalyzeGraphInMulticommandTxException : public QueryException {
+ public:
+  AnalyzeGraphInMulticommandTxException()
+      : QueryException("Analyzing the graph is not allowed in multicommand transactions.") {}
+};
+
 class VersionInfoInMulticommandTxException : public QueryException {
  public:
   VersionInfoInMulticommandTxException()
@@ -22,6 +22,7 @@ import Cypher ;
 memgraphCypherKeyword : cypherKeyword
                       | AFTER
                       | ALTER
+                      | ANALYZE
                       | ASYNC
                       | AUTH
                       | BAD
@@ -46,6 +47,7 @@ memgraphCypherKeyword : cypherKeyword
                       | DENY
                       | DROP
                       | DUMP
+                      | EDGE
                       | EDGE_TYPES
                       | EXECUTE
                       | FOR
@@ -54,6 +56,7 @@ memgraphCypherKeyword : cypherKeyword
                       | FROM
                       | GLOBAL
                       | GRANT
+                      | GRAPH
                       | HEADER
                       | IDENTIFIED
                       | ISOLATION
@@ -85,6 +88,7 @@ memgraphCypherKeyword : cypherKeyword
                       | SETTINGS
                       | SNAPSHOT
                       | START
+                      | STATISTICS
                       | STATS
                       | STREAM
                       | STREAMS
@@ -111,6 +115,7 @@ symbolicName : UnescapedSymbolicName
 
 query : cypherQuery
       | indexQuery
+      | edgeIndexQuery
       | explainQuery
       | profileQuery
       | infoQuery
@@ -126,6 +131,7 @@ query : cypherQuery
       | streamQuery
       | settingQuery
       | versionQuery
+      | analyzeGraphQuery
       | showConfigQuery
       ;
 
@@ -402,3 +408,11 @@ showSettings : SHOW DATABASE SETTINGS ;
 showConfigQuery : SHOW CONFIG ;
 
 versionQuery : SHOW VERSION ;
+
+analyzeGraphQuery : ANALYZE GRAPH ( DELETE STATISTICS )? ;
+
+edgeIndexQuery : createEdgeIndex | dropEdgeIndex ;
+
+createEdgeIndex : CREATE EDGE INDEX ON ':' relTypeName ( '(' propertyKeyName ')' )? ;
+
+dropEdgeIndex : DROP EDGE INDEX ON ':' relTypeName ( '(' propertyKeyName ')' )? ;
@@ -27,6 +27,7 @@ UNDERSCORE : '_' ;
 
 AFTER               : A F T E R ;
 ALTER               : A L T E R ;
+ANALYZE             : A N A L Y Z E ;
 ASYNC               : A S Y N C ;
 AUTH                : A U T H ;
 BAD                 : B A D ;
@@ -53,6 +54,7 @@ DIRECTORY           : D I R E C T O R Y ;
 DROP                : D R O P ;
 DUMP                : D U M P ;
 DURABILITY          : D U R A B I L I T Y ;
+EDGE                : E D G E ;
 EXECUTE             : E X E C U T E ;
 FOR                 : F O R ;
 FOREACH             : F O R E A C H;
@@ -62,6 +64,7 @@ FROM                : F R O M ;
 GLOBAL              : G L O B A L ;
 GRANT               : G R A N T ;
 GRANTS              : G R A N T S ;
+GRAPH               : G R A P H ;
 HEADER              : H E A D E R ;
 IDENTIFIED          : I D E N T I F I E D ;
 IGNORE              : I G N O R E ;
@@ -98,6 +101,7 @@ SETTING             : S E T T I N G ;
 SETTINGS            : S E T T I N G S ;
 SNAPSHOT            : S N A P S H O T ;
 START               : S T A R T ;
+STATISTICS          : S T A T I S T I C S ;
 STATS               : S T A T S ;
 STOP                : S T O P ;
 STREAM              : S T R E A M ;
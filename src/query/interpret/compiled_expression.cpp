@@ -0,0 +1,325 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/interpret/compiled_expression.hpp"
+
+#include <optional>
+#include <utility>
+
+#include "query/exceptions.hpp"
+#include "utils/logging.hpp"
+#include "utils/typeinfo.hpp"
+
+namespace memgraph::query {
+
+namespace {
+
+using Ternary = CompiledExpression::Ternary;
+using ValueFun = CompiledExpression::ValueFun;
+using PredicateFun = CompiledExpression::PredicateFun;
+
+// The result of a comparison is always a boolean or null.
+Ternary ToTernary(const TypedValue &value) {
+  if (value.IsNull()) return Ternary::kNull;
+  return value.ValueBool() ? Ternary::kTrue : Ternary::kFalse;
+}
+
+std::optional<int32_t> FramePosition(const SymbolTable &symbol_table, int32_t symbol_pos) {
+  if (symbol_table.table().find(symbol_pos) == symbol_table.table().end()) return std::nullopt;
+  return symbol_table.table().at(symbol_pos).position();
+}
+
+// Returns true if the expression is compiled to a `PredicateFun`. The boolean
+// operators are compiled only when both of their operands are predicates,
+// because the evaluator throws an exception which names the types of both
+// operands if any of them isn't a boolean or null.
+bool IsPredicate(Expression *expression) {
+  if (utils::Downcast<EqualOperator>(expression) || utils::Downcast<NotEqualOperator>(expression) ||
+      utils::Downcast<LessOperator>(expression) || utils::Downcast<GreaterOperator>(expression) ||
+      utils::Downcast<LessEqualOperator>(expression) || utils::Downcast<GreaterEqualOperator>(expression) ||
+      utils::Downcast<IsNullOperator>(expression)) {
+    return true;
+  }
+  if (auto *op = utils::Downcast<NotOperator>(expression)) return IsPredicate(op->expression_);
+  if (auto *op = utils::Downcast<AndOperator>(expression)) {
+    return IsPredicate(op->expression1_) && IsPredicate(op->expression2_);
+  }
+  if (auto *op = utils::Downcast<OrOperator>(expression)) {
+    return IsPredicate(op->expression1_) && IsPredicate(op->expression2_);
+  }
+  if (auto *op = utils::Downcast<XorOperator>(expression)) {
+    return IsPredicate(op->expression1_) && IsPredicate(op->expression2_);
+  }
+  return false;
+}
+
+// Applies `op` to the values of both operands, in the same way as the
+// `BINARY_OPERATOR_VISITOR` of the evaluator.
+template <class TOp>
+ValueFun BinaryValue(ValueFun lhs, ValueFun rhs, const char *cypher_op, TOp op) {
+  return [lhs = std::move(lhs), rhs = std::move(rhs), cypher_op, op](ExpressionEvaluator &evaluator,
+                                                                     TypedValue &out) -> const TypedValue & {
+    TypedValue lhs_out(evaluator.GetMemoryResource());
+    TypedValue rhs_out(evaluator.GetMemoryResource());
+    const auto &val1 = lhs(evaluator, lhs_out);
+    const auto &val2 = rhs(evaluator, rhs_out);
+    try {
+      out = op(val1, val2);
+    } catch (const TypedValueException &) {
+      throw QueryRuntimeException("Invalid types: {} and {} for '{}'.", val1.type(), val2.type(), cypher_op);
+    }
+    return out;
+  };
+}
+
+template <class TOp>
+PredicateFun Comparison(ValueFun lhs, ValueFun rhs, const char *cypher_op, TOp op) {
+  return [value = BinaryValue(std::move(lhs), std::move(rhs), cypher_op, op)](ExpressionEvaluator &evaluator) {
+    TypedValue out(evaluator.GetMemoryResource());
+    return ToTernary(value(evaluator, out));
+  };
+}
+
+}  // namespace
+
+CompiledExpression::CompiledExpression(Expression *expression, const SymbolTable &symbol_table)
+    : symbol_table_(&symbol_table) {
+  if (IsPredicate(expression)) {
+    predicate_ = CompilePredicate(expression);
+  } else {
+    value_ = CompileValue(expression);
+  }
+}
+
+CompiledExpression::CompiledExpression(NamedExpression *named_expression, const SymbolTable &symbol_table)
+    : symbol_table_(&symbol_table) {
+  auto position = FramePosition(symbol_table, named_expression->symbol_pos_);
+  if (!position) {
+    ++fallback_count_;
+    value_ = [named_expression](ExpressionEvaluator &evaluator, TypedValue &out) -> const TypedValue & {
+      out = named_expression->Accept(evaluator);
+      return out;
+    };
+    return;
+  }
+  value_ = [position = *position, value = CompileValue(named_expression->expression_)](
+               ExpressionEvaluator &evaluator, TypedValue &out) -> const TypedValue & {
+    auto &element = evaluator.GetFrame()->elems()[position];
+    element = value(evaluator, out);
+    return element;
+  };
+}
+
+TypedValue CompiledExpression::Evaluate(ExpressionEvaluator *evaluator) const {
+  auto *memory = evaluator->GetMemoryResource();
+  if (predicate_) {
+    switch (predicate_(*evaluator)) {
+      case Ternary::kFalse:
+        return TypedValue(false, memory);
+      case Ternary::kTrue:
+        return TypedValue(true, memory);
+      case Ternary::kNull:
+        return TypedValue(memory);
+    }
+  }
+  TypedValue out(memory);
+  const auto &value = value_(*evaluator, out);
+  if (&value == &out) return out;
+  return TypedValue(value, memory);
+}
+
+bool CompiledExpression::EvaluateFilter(ExpressionEvaluator *evaluator) const {
+  if (predicate_) return predicate_(*evaluator) == Ternary::kTrue;
+  TypedValue out(evaluator->GetMemoryResource());
+  const auto &value = value_(*evaluator, out);
+  // Null is treated like false.
+  if (value.IsNull()) return false;
+  if (value.type() != TypedValue::Type::Bool)
+    throw QueryRuntimeException("Filter expression must evaluate to bool or null, got {}.", value.type());
+  return value.ValueBool();
+}
+
+CompiledExpression::ValueFun CompiledExpression::CompileValue(Expression *expression) {
+  if (IsPredicate(expression)) {
+    return [predicate = CompilePredicate(expression)](ExpressionEvaluator &evaluator,
+                                                      TypedValue &out) -> const TypedValue & {
+      switch (predicate(evaluator)) {
+        case Ternary::kFalse:
+          out = TypedValue(false);
+          break;
+        case Ternary::kTrue:
+          out = TypedValue(true);
+          break;
+        case Ternary::kNull:
+          out = TypedValue();
+          break;
+      }
+      return out;
+    };
+  }
+
+  if (auto *identifier = utils::Downcast<Identifier>(expression)) {
+    auto position = FramePosition(*symbol_table_, identifier->symbol_pos_);
+    if (!position) return Fallback(expression);
+    return [position = *position](ExpressionEvaluator &evaluator, TypedValue &) -> const TypedValue & {
+      return evaluator.GetFrame()->elems()[position];
+    };
+  }
+
+  if (auto *literal = utils::Downcast<PrimitiveLiteral>(expression)) {
+    return [value = TypedValue(literal->value_)](ExpressionEvaluator &, TypedValue &) -> const TypedValue & {
+      return value;
+    };
+  }
+
+  if (auto *lookup = utils::Downcast<PropertyLookup>(expression)) {
+    // Only the lookups on an identifier are compiled, because the lookups on
+    // anything except a node or an edge are evaluated again by the evaluator.
+    auto *identifier = utils::Downcast<Identifier>(lookup->expression_);
+    auto position = identifier ? FramePosition(*symbol_table_, identifier->symbol_pos_) : std::nullopt;
+    if (!position) return Fallback(expression);
+    return [position = *position, lookup, null = TypedValue()](ExpressionEvaluator &evaluator,
+                                                               TypedValue &out) -> const TypedValue & {
+      const auto &value = evaluator.GetFrame()->elems()[position];
+      switch (value.type()) {
+        case TypedValue::Type::Null:
+          return null;
+        case TypedValue::Type::Vertex:
+          out = TypedValue(evaluator.GetProperty(value.ValueVertex(), lookup->property_));
+          return out;
+        case TypedValue::Type::Edge:
+          out = TypedValue(evaluator.GetProperty(value.ValueEdge(), lookup->property_));
+          return out;
+        default:
+          out = lookup->Accept(evaluator);
+          return out;
+      }
+    };
+  }
+
+  if (auto *op = utils::Downcast<AdditionOperator>(expression)) {
+    return BinaryValue(CompileValue(op->expression1_), CompileValue(op->expression2_), "+",
+                       [](const auto &a, const auto &b) { return a + b; });
+  }
+  if (auto *op = utils::Downcast<SubtractionOperator>(expression)) {
+    return BinaryValue(CompileValue(op->expression1_), CompileValue(op->expression2_), "-",
+                       [](const auto &a, const auto &b) { return a - b; });
+  }
+  if (auto *op = utils::Downcast<MultiplicationOperator>(expression)) {
+    return BinaryValue(CompileValue(op->expression1_), CompileValue(op->expression2_), "*",
+                       [](const auto &a, const auto &b) { return a * b; });
+  }
+  if (auto *op = utils::Downcast<DivisionOperator>(expression)) {
+    return BinaryValue(CompileValue(op->expression1_), CompileValue(op->expression2_), "/",
+                       [](const auto &a, const auto &b) { return a / b; });
+  }
+  if (auto *op = utils::Downcast<ModOperator>(expression)) {
+    return BinaryValue(CompileValue(op->expression1_), CompileValue(op->expression2_), "%",
+                       [](const auto &a, const auto &b) { return a % b; });
+  }
+
+  return Fallback(expression);
+}
+
+CompiledExpression::PredicateFun CompiledExpression::CompilePredicate(Expression *expression) {
+  if (auto *op = utils::Downcast<EqualOperator>(expression)) {
+    return Comparison(CompileValue(op->expression1_), CompileValue(op->expression2_), "=",
+                      [](const auto &a, const auto &b) { return a == b; });
+  }
+  if (auto *op = utils::Downcast<NotEqualOperator>(expression)) {
+    return Comparison(CompileValue(op->expression1_), CompileValue(op->expression2_), "<>",
+                      [](const auto &a, const auto &b) { return a != b; });
+  }
+  if (auto *op = utils::Downcast<LessOperator>(expression)) {
+    return Comparison(CompileValue(op->expression1_), CompileValue(op->expression2_), "<",
+                      [](const auto &a, const auto &b) { return a < b; });
+  }
+  if (auto *op = utils::Downcast<GreaterOperator>(expression)) {
+    return Comparison(CompileValue(op->expression1_), CompileValue(op->expression2_), ">",
+                      [](const auto &a, const auto &b) { return a > b; });
+  }
+  if (auto *op = utils::Downcast<LessEqualOperator>(expression)) {
+    return Comparison(CompileValue(op->expression1_), CompileValue(op->expression2_), "<=",
+                      [](const auto &a, const auto &b) { return a <= b; });
+  }
+  if (auto *op = utils::Downcast<GreaterEqualOperator>(expression)) {
+    return Comparison(CompileValue(op->expression1_), CompileValue(op->expression2_), ">=",
+                      [](const auto &a, const auto &b) { return a >= b; });
+  }
+
+  if (auto *op = utils::Downcast<IsNullOperator>(expression)) {
+    return [value = CompileValue(op->expression_)](ExpressionEvaluator &evaluator) {
+      TypedValue out(evaluator.GetMemoryResource());
+      return value(evaluator, out).IsNull() ? Ternary::kTrue : Ternary::kFalse;
+    };
+  }
+
+  if (auto *op = utils::Downcast<NotOperator>(expression)) {
+    return [operand = CompilePredicate(op->expression_)](ExpressionEvaluator &evaluator) {
+      switch (operand(evaluator)) {
+        case Ternary::kFalse:
+          return Ternary::kTrue;
+        case Ternary::kTrue:
+          return Ternary::kFalse;
+        case Ternary::kNull:
+          return Ternary::kNull;
+      }
+      return Ternary::kNull;
+    };
+  }
+
+  if (auto *op = utils::Downcast<AndOperator>(expression)) {
+    return [lhs = CompilePredicate(op->expression1_),
+            rhs = CompilePredicate(op->expression2_)](ExpressionEvaluator &evaluator) {
+      const auto value1 = lhs(evaluator);
+      // If first expression is false, don't evaluate the second one.
+      if (value1 == Ternary::kFalse) return Ternary::kFalse;
+      const auto value2 = rhs(evaluator);
+      if (value2 == Ternary::kFalse) return Ternary::kFalse;
+      if (value1 == Ternary::kNull || value2 == Ternary::kNull) return Ternary::kNull;
+      return Ternary::kTrue;
+    };
+  }
+
+  // Like with the evaluator, both operands of OR and XOR are always evaluated.
+  if (auto *op = utils::Downcast<OrOperator>(expression)) {
+    return [lhs = CompilePredicate(op->expression1_),
+            rhs = CompilePredicate(op->expression2_)](ExpressionEvaluator &evaluator) {
+      const auto value1 = lhs(evaluator);
+      const auto value2 = rhs(evaluator);
+      if (value1 == Ternary::kTrue || value2 == Ternary::kTrue) return Ternary::kTrue;
+      if (value1 == Ternary::kNull || value2 == Ternary::kNull) return Ternary::kNull;
+      return Ternary::kFalse;
+    };
+  }
+
+  if (auto *op = utils::Downcast<XorOperator>(expression)) {
+    return [lhs = CompilePredicate(op->expression1_),
+            rhs = CompilePredicate(op->expression2_)](ExpressionEvaluator &evaluator) {
+      const auto value1 = lhs(evaluator);
+      const auto value2 = rhs(evaluator);
+      if (value1 == Ternary::kNull || value2 == Ternary::kNull) return Ternary::kNull;
+      return value1 == value2 ? Ternary::kFalse : Ternary::kTrue;
+    };
+  }
+
+  LOG_FATAL("Expression isn't a predicate!");
+}
+
+CompiledExpression::ValueFun CompiledExpression::Fallback(Expression *expression) {
+  ++fallback_count_;
+  return [expression](ExpressionEvaluator &evaluator, TypedValue &out) -> const TypedValue & {
+    out = expression->Accept(evaluator);
+    return out;
+  };
+}
+
+}  // namespace memgraph::query
@@ -0,0 +1,117 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+#include "query/frontend/ast/ast.hpp"
+#include "query/frontend/semantic/symbol_table.hpp"
+#include "query/interpret/eval.hpp"
+#include "query/typed_value.hpp"
+
+namespace memgraph::query {
+
+/// An expression which is lowered into a tree of closures that are
+/// specialised for the node types of the expression.
+///
+/// `ExpressionEvaluator` creates a new `TypedValue` for every node it visits,
+/// so every identifier and literal is copied and every comparison produces a
+/// `TypedValue`. The compiled tree avoids most of that:
+///   * identifiers are resolved to frame positions when compiling and are
+///     read from the frame by reference,
+///   * literals are converted once when compiling,
+///   * comparisons, boolean operators and `IS NULL` are evaluated to a
+///     three-valued boolean instead of a `TypedValue`,
+///   * the property of a node or an edge is looked up without copying the
+///     node or the edge.
+///
+/// The nodes which aren't supported by the compiler are evaluated with the
+/// `ExpressionEvaluator`, so any expression can be compiled and evaluates to
+/// the same value (or throws the same exception) as with the evaluator.
+///
+/// A compiled expression holds only constants, so it can be evaluated by many
+/// threads at once.
+class CompiledExpression {
+ public:
+  /// Compiles `expression` whose identifiers are resolved with
+  /// `symbol_table`. The expression must outlive the compiled expression.
+  CompiledExpression(Expression *expression, const SymbolTable &symbol_table);
+
+  /// Compiles a named expression, which stores its value on the frame when
+  /// evaluated, like it does with the evaluator.
+  CompiledExpression(NamedExpression *named_expression, const SymbolTable &symbol_table);
+
+  /// Evaluates the expression on the frame of `evaluator`, which is also used
+  /// to evaluate the unsupported nodes.
+  TypedValue Evaluate(ExpressionEvaluator *evaluator) const;
+
+  /// Evaluates the expression as a filter, where null counts as false.
+  /// @throw QueryRuntimeException if the expression isn't a boolean or null.
+  bool EvaluateFilter(ExpressionEvaluator *evaluator) const;
+
+  /// Number of nodes which are evaluated with the `ExpressionEvaluator`.
+  size_t FallbackCount() const { return fallback_count_; }
+
+  /// Three-valued boolean of Cypher.
+  enum class Ternary : uint8_t { kFalse, kTrue, kNull };
+
+  /// Evaluates a node whose value may already exist, e.g. on the frame or as
+  /// a constant, in which case a reference to it is returned. Otherwise the
+  /// value is stored in the given `TypedValue`, which is then returned.
+  using ValueFun = std::function<const TypedValue &(ExpressionEvaluator &, TypedValue &)>;
+  /// Evaluates a node whose value is always a boolean or null.
+  using PredicateFun = std::function<Ternary(ExpressionEvaluator &)>;
+
+ private:
+  ValueFun CompileValue(Expression *expression);
+  PredicateFun CompilePredicate(Expression *expression);
+  ValueFun Fallback(Expression *expression);
+
+  const SymbolTable *symbol_table_;
+  size_t fallback_count_{0};
+  // Only one of these is set, depending on whether the root of the
+  // expression is a predicate.
+  ValueFun value_;
+  PredicateFun predicate_;
+};
+
+/// Compiled expressions of a plan, found by the expression they were compiled
+/// from.
+class CompiledExpressions {
+ public:
+  /// Compiles `expression` unless it's already compiled.
+  void Add(Expression *expression, const SymbolTable &symbol_table) {
+    expressions_.try_emplace(expression, expression, symbol_table);
+  }
+
+  /// Compiles `named_expression` unless it's already compiled.
+  void Add(NamedExpression *named_expression, const SymbolTable &symbol_table) {
+    expressions_.try_emplace(named_expression, named_expression, symbol_table);
+  }
+
+  /// Returns `nullptr` if the expression wasn't compiled.
+  const CompiledExpression *Find(const Tree *expression) const {
+    auto it = expressions_.find(expression);
+    return it == expressions_.end() ? nullptr : &it->second;
+  }
+
+  size_t size() const { return expressions_.size(); }
+
+ private:
+  std::unordered_map<const Tree *, CompiledExpression> expressions_;
+};
+
+}  // namespace memgraph::query
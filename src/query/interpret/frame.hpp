@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <vector>
 
 #include "query/frontend/semantic/symbol_table.hpp"
@@ -35,6 +36,7 @@ class Frame {
   const TypedValue &at(const Symbol &symbol) const { return elems_.at(symbol.position()); }
 
   auto &elems() { return elems_; }
+  const auto &elems() const { return elems_; }
 
   utils::MemoryResource *GetMemoryResource() const { return elems_.get_allocator().GetMemoryResource(); }
 
@@ -42,4 +44,94 @@ class Frame {
   utils::pmr::vector<TypedValue> elems_;
 };
 
+/// Rows which are passed between the cursors in batched execution, see
+/// `plan::Cursor::PullBatch`.
+///
+/// Every row is a whole `Frame`, so the expressions are evaluated on a row of
+/// the batch in the same way as on the frame of a single pulled row. A row
+/// starts out as a copy of the frame of the batch's consumer, which holds the
+/// symbols bound outside of the pulled operators, and the producer of the row
+/// sets the symbols that are bound by it and by its inputs. The rows are
+/// allocated when they are first used and are reused after `Clear`.
+class FrameBatch {
+ public:
+  static constexpr size_t kDefaultCapacity = 1024;
+
+  /// Creates an empty batch whose rows start as copies of `frame`. The frame
+  /// has to outlive the batch.
+  explicit FrameBatch(const Frame &frame, size_t capacity = kDefaultCapacity)
+      : base_(&frame), frame_(CopyOf(frame)), capacity_(capacity) {
+    MG_ASSERT(capacity > 0, "The batch must hold at least one row!");
+    rows_.reserve(capacity);
+  }
+
+  FrameBatch(const FrameBatch &) = delete;
+  FrameBatch &operator=(const FrameBatch &) = delete;
+  FrameBatch(FrameBatch &&) = default;
+  FrameBatch &operator=(FrameBatch &&) = default;
+  ~FrameBatch() = default;
+
+  size_t size() const { return size_; }
+  size_t capacity() const { return capacity_; }
+  bool empty() const { return size_ == 0; }
+  bool full() const { return size_ == capacity_; }
+
+  Frame &operator[](size_t row) { return rows_[row]; }
+  const Frame &operator[](size_t row) const { return rows_[row]; }
+
+  /// The frame of the batch's consumer, which is copied into new rows.
+  const Frame &base() const { return *base_; }
+
+  /// Frame into which the producer of the rows may pull its own input one row
+  /// at a time. It starts out as a copy of `base()` and keeps its values
+  /// between the pulls of the batch.
+  Frame &frame() { return frame_; }
+
+  /// Appends a copy of the whole `frame`.
+  Frame &Append(const Frame &frame) {
+    auto &row = NextRow();
+    row.elems() = frame.elems();
+    return row;
+  }
+
+  /// Appends a row with the values of `symbols` copied from `frame`. The
+  /// other symbols of the row keep the values of a previously appended row.
+  Frame &Append(const Frame &frame, const std::vector<Symbol> &symbols) {
+    auto &row = NextRow();
+    for (const auto &symbol : symbols) row[symbol] = frame[symbol];
+    return row;
+  }
+
+  void SwapRows(size_t first, size_t second) {
+    if (first != second) rows_[first].elems().swap(rows_[second].elems());
+  }
+
+  /// Drops the rows after the first `size` rows.
+  void Truncate(size_t size) {
+    DMG_ASSERT(size <= size_, "Can't truncate the batch to a larger size!");
+    size_ = size;
+  }
+
+  void Clear() { size_ = 0; }
+
+ private:
+  static Frame CopyOf(const Frame &frame) {
+    Frame copy(static_cast<int64_t>(frame.elems().size()), frame.GetMemoryResource());
+    copy.elems() = frame.elems();
+    return copy;
+  }
+
+  Frame &NextRow() {
+    DMG_ASSERT(size_ < capacity_, "The batch is full!");
+    if (size_ == rows_.size()) rows_.push_back(CopyOf(*base_));
+    return rows_[size_++];
+  }
+
+  const Frame *base_;
+  Frame frame_;
+  std::vector<Frame> rows_;
+  size_t size_{0};
+  size_t capacity_;
+};
+
 }  // namespace memgraph::query
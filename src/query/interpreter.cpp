@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -71,6 +71,7 @@ extern Event WriteQuery;
 extern Event ReadWriteQuery;
 
 extern const Event LabelIndexCreated;
+extern const Event EdgeIndexCreated;
 extern const Event LabelPropertyIndexCreated;
 
 extern const Event StreamsCreated;
@@ -1000,6 +1001,12 @@ struct PullPlan {
   // we have to keep track of any unsent results from previous `PullPlan::Pull`
   // manually by using this flag.
   bool has_unsent_results_ = false;
+
+  // Set when the plan is pulled in batches, see `plan::CanPullBatches`. The
+  // results are streamed from the rows of the batch, and `batch_row_` is the
+  // number of the rows that were already taken from it.
+  std::optional<FrameBatch> batch_;
+  size_t batch_row_{0};
 };
 
 PullPlan::PullPlan(const std::shared_ptr<CachedPlan> plan, const Parameters &parameters, const bool is_profile_query,
@@ -1027,6 +1034,12 @@ PullPlan::PullPlan(const std::shared_ptr<CachedPlan> plan, const Parameters &par
   ctx_.is_shutting_down = &interpreter_context->is_shutting_down;
   ctx_.is_profile_query = is_profile_query;
   ctx_.trigger_context_collector = trigger_context_collector;
+  ctx_.compiled_expressions = &plan->compiled_expressions();
+  // The profiling stats count the pulls, so profiled plans are pulled row by
+  // row to keep the counts the same.
+  if (!is_profile_query && plan::CanPullBatches(plan->plan())) {
+    batch_.emplace(frame_);
+  }
 }
 
 std::optional<plan::ProfilingStatsWithTotalTime> PullPlan::Pull(AnyStream *stream, std::optional<int> n,
@@ -1055,15 +1068,24 @@ std::optional<plan::ProfilingStatsWithTotalTime> PullPlan::Pull(AnyStream *strea
   }
 
   // Returns true if a result was pulled.
-  const auto pull_result = [&]() -> bool { return cursor_->Pull(frame_, ctx_); };
+  const auto pull_result = [&]() -> bool {
+    if (!batch_) return cursor_->Pull(frame_, ctx_);
+    if (batch_row_ == batch_->size()) {
+      batch_row_ = 0;
+      if (!cursor_->PullBatch(*batch_, ctx_)) return false;
+    }
+    ++batch_row_;
+    return true;
+  };
 
   const auto stream_values = [&]() {
+    const auto &frame = batch_ ? (*batch_)[batch_row_ - 1] : frame_;
     // TODO: The streamed values should also probably use the above memory.
     std::vector<TypedValue> values;
     values.reserve(output_symbols.size());
 
     for (const auto &symbol : output_symbols) {
-      values.emplace_back(frame_[symbol]);
+      values.emplace_back(frame[symbol]);
     }
 
     stream->Result(values);
@@ -1428,8 +1450,8 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
   }
   auto properties_stringified = utils::Join(properties_string, ", ");
 
-  if (properties.size() > 1) {
-    throw utils::NotYetImplemented("index on multiple properties");
+  if (std::set<storage::PropertyId>(properties.begin(), properties.end()).size() != properties.size()) {
+    throw SyntaxException("The given set of properties contains duplicates.");
   }
 
   Notification index_notification(SeverityLevel::INFO);
@@ -1442,9 +1464,12 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
       handler = [interpreter_context, label, properties_stringified = std::move(properties_stringified),
                  label_name = index_query->label_.name, properties = std::move(properties),
                  invalidate_plan_cache = std::move(invalidate_plan_cache)](Notification &index_notification) {
-        MG_ASSERT(properties.size() <= 1U);
-        auto maybe_index_error = properties.empty() ? interpreter_context->db->CreateIndex(label)
-                                                    : interpreter_context->db->CreateIndex(label, properties[0]);
+        auto maybe_index_error = [&] {
+          if (properties.empty()) return interpreter_context->db->CreateIndex(label);
+          if (properties.size() == 1) return interpreter_context->db->CreateIndex(label, properties[0]);
+          // Multiple properties are indexed by a composite index.
+          return interpreter_context->db->CreateIndex(label, properties);
+        }();
         utils::OnScopeExit invalidator(invalidate_plan_cache);
 
         if (maybe_index_error.HasError()) {
@@ -1462,6 +1487,9 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
                   index_notification.code = NotificationCode::EXISTENT_INDEX;
                   index_notification.title = fmt::format("Index on label {} on properties {} already exists.",
                                                          label_name, properties_stringified);
+                } else if constexpr (std::is_same_v<ErrorType, storage::IndexBeingCreatedError>) {
+                  throw QueryRuntimeException("Index on label {} on properties {} is still being created.",
+                                              label_name, properties_stringified);
                 } else {
                   static_assert(kAlwaysFalse<T>, "Missing type from variant visitor");
                 }
@@ -1480,9 +1508,12 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
       handler = [interpreter_context, label, properties_stringified = std::move(properties_stringified),
                  label_name = index_query->label_.name, properties = std::move(properties),
                  invalidate_plan_cache = std::move(invalidate_plan_cache)](Notification &index_notification) {
-        MG_ASSERT(properties.size() <= 1U);
-        auto maybe_index_error = properties.empty() ? interpreter_context->db->DropIndex(label)
-                                                    : interpreter_context->db->DropIndex(label, properties[0]);
+        auto maybe_index_error = [&] {
+          if (properties.empty()) return interpreter_context->db->DropIndex(label);
+          if (properties.size() == 1) return interpreter_context->db->DropIndex(label, properties[0]);
+          // Multiple properties are indexed by a composite index.
+          return interpreter_context->db->DropIndex(label, properties);
+        }();
         utils::OnScopeExit invalidator(invalidate_plan_cache);
 
         if (maybe_index_error.HasError()) {
@@ -1499,6 +1530,134 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
                   index_notification.code = NotificationCode::NONEXISTENT_INDEX;
                   index_notification.title = fmt::format("Index on label {} on properties {} doesn't exist.",
                                                          label_name, properties_stringified);
+                } else if constexpr (std::is_same_v<ErrorType, storage::IndexBeingCreatedError>) {
+                  throw QueryRuntimeException("Index on label {} on properties {} is still being created.",
+                                              label_name, properties_stringified);
+                } else {
+                  static_assert(kAlwaysFalse<T>, "Missing type from variant visitor");
+                }
+              },
+              error);
+        }
+      };
+      break;
+    }
+  }
+
+  return PreparedQuery{
+      {},
+      std::move(parsed_query.required_privileges),
+      [handler = std::move(handler), notifications, index_notification = std::move(index_notification)](
+          AnyStream * /*stream*/, std::optional<int> /*unused*/) mutable {
+        handler(index_notification);
+        notifications->push_back(index_notification);
+        return QueryHandlerResult::NOTHING;
+      },
+      RWType::W};
+}
+
+PreparedQuery PrepareEdgeIndexQuery(ParsedQuery parsed_query, bool in_explicit_transaction,
+                                    std::vector<Notification> *notifications,
+                                    InterpreterContext *interpreter_context) {
+  if (in_explicit_transaction) {
+    throw IndexInMulticommandTxException();
+  }
+
+  auto *index_query = utils::Downcast<EdgeIndexQuery>(parsed_query.query);
+  std::function<void(Notification &)> handler;
+
+  // Creating an index influences computed plan costs.
+  auto invalidate_plan_cache = [plan_cache = &interpreter_context->plan_cache] {
+    auto access = plan_cache->access();
+    for (auto &kv : access) {
+      access.remove(kv.first);
+    }
+  };
+
+  auto edge_type = interpreter_context->db->NameToEdgeType(index_query->edge_type_.name);
+
+  if (index_query->properties_.size() > 1) {
+    throw utils::NotYetImplemented("index on multiple properties");
+  }
+  std::optional<storage::PropertyId> property;
+  std::string property_name;
+  if (!index_query->properties_.empty()) {
+    property = interpreter_context->db->NameToProperty(index_query->properties_[0].name);
+    property_name = index_query->properties_[0].name;
+  }
+
+  Notification index_notification(SeverityLevel::INFO);
+  switch (index_query->action_) {
+    case EdgeIndexQuery::Action::CREATE: {
+      index_notification.code = NotificationCode::CREATE_INDEX;
+      index_notification.title = fmt::format("Created index on edge type {} on properties {}.",
+                                             index_query->edge_type_.name, property_name);
+
+      handler = [interpreter_context, edge_type, property, property_name,
+                 edge_type_name = index_query->edge_type_.name,
+                 invalidate_plan_cache = std::move(invalidate_plan_cache)](Notification &index_notification) {
+        auto maybe_index_error = property ? interpreter_context->db->CreateIndex(edge_type, *property)
+                                          : interpreter_context->db->CreateIndex(edge_type);
+        utils::OnScopeExit invalidator(invalidate_plan_cache);
+
+        if (maybe_index_error.HasError()) {
+          const auto &error = maybe_index_error.GetError();
+          std::visit(
+              [&index_notification, &edge_type_name, &property_name]<typename T>(T &&) {
+                using ErrorType = std::remove_cvref_t<T>;
+                if constexpr (std::is_same_v<ErrorType, storage::ReplicationError>) {
+                  EventCounter::IncrementCounter(EventCounter::EdgeIndexCreated);
+                  throw ReplicationException(fmt::format(
+                      "At least one SYNC replica has not confirmed the creation of the index on edge type {} "
+                      "on properties {}.",
+                      edge_type_name, property_name));
+                } else if constexpr (std::is_same_v<ErrorType, storage::IndexDefinitionError>) {
+                  index_notification.code = NotificationCode::EXISTENT_INDEX;
+                  index_notification.title = fmt::format(
+                      "Index on edge type {} on properties {} already exists or properties on edges are disabled.",
+                      edge_type_name, property_name);
+                } else if constexpr (std::is_same_v<ErrorType, storage::IndexBeingCreatedError>) {
+                  throw QueryRuntimeException("Index on edge type {} on properties {} is still being created.",
+                                              edge_type_name, property_name);
+                } else {
+                  static_assert(kAlwaysFalse<T>, "Missing type from variant visitor");
+                }
+              },
+              error);
+        } else {
+          EventCounter::IncrementCounter(EventCounter::EdgeIndexCreated);
+        }
+      };
+      break;
+    }
+    case EdgeIndexQuery::Action::DROP: {
+      index_notification.code = NotificationCode::DROP_INDEX;
+      index_notification.title = fmt::format("Dropped index on edge type {} on properties {}.",
+                                             index_query->edge_type_.name, property_name);
+      handler = [interpreter_context, edge_type, property, property_name,
+                 edge_type_name = index_query->edge_type_.name,
+                 invalidate_plan_cache = std::move(invalidate_plan_cache)](Notification &index_notification) {
+        auto maybe_index_error = property ? interpreter_context->db->DropIndex(edge_type, *property)
+                                          : interpreter_context->db->DropIndex(edge_type);
+        utils::OnScopeExit invalidator(invalidate_plan_cache);
+
+        if (maybe_index_error.HasError()) {
+          const auto &error = maybe_index_error.GetError();
+          std::visit(
+              [&index_notification, &edge_type_name, &property_name]<typename T>(T &&) {
+                using ErrorType = std::remove_cvref_t<T>;
+                if constexpr (std::is_same_v<ErrorType, storage::ReplicationError>) {
+                  throw ReplicationException(fmt::format(
+                      "At least one SYNC replica has not confirmed the dropping of the index on edge type {} "
+                      "on properties {}.",
+                      edge_type_name, property_name));
+                } else if constexpr (std::is_same_v<ErrorType, storage::IndexDefinitionError>) {
+                  index_notification.code = NotificationCode::NONEXISTENT_INDEX;
+                  index_notification.title = fmt::format("Index on edge type {} on properties {} doesn't exist.",
+                                                         edge_type_name, property_name);
+                } else if constexpr (std::is_same_v<ErrorType, storage::IndexBeingCreatedError>) {
+                  throw QueryRuntimeException("Index on edge type {} on properties {} is still being created.",
+                                              edge_type_name, property_name);
                 } else {
                   static_assert(kAlwaysFalse<T>, "Missing type from variant visitor");
                 }
@@ -1927,6 +2086,73 @@ PreparedQuery PrepareVersionQuery(ParsedQuery parsed_query, const bool in_explic
                        RWType::NONE};
 }
 
+PreparedQuery PrepareAnalyzeGraphQuery(ParsedQuery parsed_query, const bool in_explicit_transaction,
+                                       InterpreterContext *interpreter_context) {
+  if (in_explicit_transaction) {
+    throw AnalyzeGraphInMulticommandTxException();
+  }
+
+  auto *analyze_graph_query = utils::Downcast<AnalyzeGraphQuery>(parsed_query.query);
+  MG_ASSERT(analyze_graph_query);
+
+  // The statistics influence computed plan costs.
+  auto invalidate_plan_cache = [plan_cache = &interpreter_context->plan_cache] {
+    auto access = plan_cache->access();
+    for (auto &kv : access) {
+      access.remove(kv.first);
+    }
+  };
+
+  auto handler = [interpreter_context, action = analyze_graph_query->action_,
+                  invalidate_plan_cache = std::move(invalidate_plan_cache)] {
+    auto *db = interpreter_context->db;
+    storage::GraphStatistics statistics;
+    if (action == AnalyzeGraphQuery::Action::ANALYZE) {
+      // The accessor has to be released before the statistics are set because
+      // setting them requires unique access to the storage.
+      auto access = db->Access();
+      statistics = access.ComputeGraphStatistics();
+    }
+
+    std::vector<std::vector<TypedValue>> results;
+    for (const auto &[label, stats] : statistics.labels) {
+      results.push_back({TypedValue("label"), TypedValue(db->LabelToName(label)), TypedValue(),
+                         TypedValue(static_cast<int64_t>(stats.count)), TypedValue(), TypedValue(stats.avg_degree)});
+    }
+    for (const auto &[key, stats] : statistics.label_properties) {
+      results.push_back({TypedValue("label+property"), TypedValue(db->LabelToName(key.first)),
+                         TypedValue(db->PropertyToName(key.second)), TypedValue(static_cast<int64_t>(stats.count)),
+                         TypedValue(static_cast<int64_t>(stats.distinct_values_count)), TypedValue()});
+    }
+    for (const auto &[edge_type, stats] : statistics.edge_types) {
+      results.push_back({TypedValue("edge-type"), TypedValue(db->EdgeTypeToName(edge_type)), TypedValue(),
+                         TypedValue(static_cast<int64_t>(stats.count)), TypedValue(),
+                         TypedValue(stats.avg_out_degree)});
+    }
+
+    utils::OnScopeExit invalidator(invalidate_plan_cache);
+    if (db->SetGraphStatistics(std::move(statistics)).HasError()) {
+      throw ReplicationException("At least one SYNC replica has not confirmed the update of the graph statistics.");
+    }
+    return results;
+  };
+
+  return PreparedQuery{{"type", "name", "property", "count", "distinct values", "average degree"},
+                       std::move(parsed_query.required_privileges),
+                       [handler = std::move(handler), pull_plan = std::shared_ptr<PullPlanVector>(nullptr)](
+                           AnyStream *stream, std::optional<int> n) mutable -> std::optional<QueryHandlerResult> {
+                         if (!pull_plan) {
+                           pull_plan = std::make_shared<PullPlanVector>(handler());
+                         }
+
+                         if (pull_plan->Pull(stream, n)) {
+                           return QueryHandlerResult::COMMIT;
+                         }
+                         return std::nullopt;
+                       },
+                       RWType::NONE};
+}
+
 PreparedQuery PrepareInfoQuery(ParsedQuery parsed_query, bool in_explicit_transaction,
                                std::map<std::string, TypedValue> *summary, InterpreterContext *interpreter_context,
                                storage::Storage *db, utils::MemoryResource *execution_memory) {
@@ -1947,11 +2173,38 @@ PreparedQuery PrepareInfoQuery(ParsedQuery parsed_query, bool in_explicit_transa
             {TypedValue("vertex_count"), TypedValue(static_cast<int64_t>(info.vertex_count))},
             {TypedValue("edge_count"), TypedValue(static_cast<int64_t>(info.edge_count))},
             {TypedValue("average_degree"), TypedValue(info.average_degree)},
+            {TypedValue("average_vertex_footprint"),
+             TypedValue(static_cast<int64_t>(info.average_vertex_footprint))},
             {TypedValue("memory_usage"), TypedValue(static_cast<int64_t>(info.memory_usage))},
             {TypedValue("disk_usage"), TypedValue(static_cast<int64_t>(info.disk_usage))},
             {TypedValue("memory_allocated"), TypedValue(static_cast<int64_t>(utils::total_memory_tracker.Amount()))},
             {TypedValue("allocation_limit"),
-             TypedValue(static_cast<int64_t>(utils::total_memory_tracker.HardLimit()))}};
+             TypedValue(static_cast<int64_t>(utils::total_memory_tracker.HardLimit()))},
+            {TypedValue("gc_runs"), TypedValue(static_cast<int64_t>(info.gc.runs))},
+            {TypedValue("gc_last_unlink_duration_us"),
+             TypedValue(static_cast<int64_t>(info.gc.last_unlink_duration.count()))},
+            {TypedValue("gc_last_index_cleanup_duration_us"),
+             TypedValue(static_cast<int64_t>(info.gc.last_index_cleanup_duration.count()))},
+            {TypedValue("gc_last_free_duration_us"),
+             TypedValue(static_cast<int64_t>(info.gc.last_free_duration.count()))},
+            {TypedValue("gc_pending_transactions"), TypedValue(static_cast<int64_t>(info.gc.pending_transactions))},
+            {TypedValue("gc_pending_undo_buffers"), TypedValue(static_cast<int64_t>(info.gc.pending_undo_buffers))},
+            {TypedValue("gc_pending_vertices"), TypedValue(static_cast<int64_t>(info.gc.pending_vertices))},
+            {TypedValue("gc_pending_edges"), TypedValue(static_cast<int64_t>(info.gc.pending_edges))},
+            {TypedValue("gc_pending_delta_bytes"), TypedValue(static_cast<int64_t>(info.gc.pending_delta_bytes))},
+            {TypedValue("gc_interval_ms"), TypedValue(static_cast<int64_t>(info.gc.interval.count()))},
+            {TypedValue("gc_interval_triggers"), TypedValue(static_cast<int64_t>(info.gc.interval_triggers))},
+            {TypedValue("gc_transactions_triggers"),
+             TypedValue(static_cast<int64_t>(info.gc.transactions_triggers))},
+            {TypedValue("gc_delta_bytes_triggers"), TypedValue(static_cast<int64_t>(info.gc.delta_bytes_triggers))},
+            {TypedValue("gc_memory_triggers"), TypedValue(static_cast<int64_t>(info.gc.memory_triggers))},
+            {TypedValue("object_memory_reserved"),
+             TypedValue(static_cast<int64_t>(info.object_memory.reserved_bytes))},
+            {TypedValue("object_memory_allocated"),
+             TypedValue(static_cast<int64_t>(info.object_memory.allocated_bytes))},
+            {TypedValue("object_memory_fragmentation"), TypedValue(info.object_memory.Fragmentation())},
+            {TypedValue("object_memory_released_slabs"),
+             TypedValue(static_cast<int64_t>(info.object_memory.released_slabs))}};
         return std::pair{results, QueryHandlerResult::COMMIT};
       };
       break;
@@ -1961,7 +2214,8 @@ PreparedQuery PrepareInfoQuery(ParsedQuery parsed_query, bool in_explicit_transa
         auto *db = interpreter_context->db;
         auto info = db->ListAllIndices();
         std::vector<std::vector<TypedValue>> results;
-        results.reserve(info.label.size() + info.label_property.size());
+        results.reserve(info.label.size() + info.label_property.size() + info.label_property_composite.size() +
+                        info.edge_type.size() + info.edge_type_property.size());
         for (const auto &item : info.label) {
           results.push_back({TypedValue("label"), TypedValue(db->LabelToName(item)), TypedValue()});
         }
@@ -1969,6 +2223,22 @@ PreparedQuery PrepareInfoQuery(ParsedQuery parsed_query, bool in_explicit_transa
           results.push_back({TypedValue("label+property"), TypedValue(db->LabelToName(item.first)),
                              TypedValue(db->PropertyToName(item.second))});
         }
+        for (const auto &item : info.label_property_composite) {
+          std::vector<TypedValue> properties;
+          properties.reserve(item.second.size());
+          for (const auto &property : item.second) {
+            properties.emplace_back(db->PropertyToName(property));
+          }
+          results.push_back({TypedValue("label+properties"), TypedValue(db->LabelToName(item.first)),
+                             TypedValue(std::move(properties))});
+        }
+        for (const auto &item : info.edge_type) {
+          results.push_back({TypedValue("edge-type"), TypedValue(db->EdgeTypeToName(item)), TypedValue()});
+        }
+        for (const auto &item : info.edge_type_property) {
+          results.push_back({TypedValue("edge-type+property"), TypedValue(db->EdgeTypeToName(item.first)),
+                             TypedValue(db->PropertyToName(item.second))});
+        }
         return std::pair{results, QueryHandlerResult::NOTHING};
       };
       break;
@@ -2358,6 +2628,9 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
     } else if (utils::Downcast<IndexQuery>(parsed_query.query)) {
       prepared_query = PrepareIndexQuery(std::move(parsed_query), in_explicit_transaction_,
                                          &query_execution->notifications, interpreter_context_);
+    } else if (utils::Downcast<EdgeIndexQuery>(parsed_query.query)) {
+      prepared_query = PrepareEdgeIndexQuery(std::move(parsed_query), in_explicit_transaction_,
+                                             &query_execution->notifications, interpreter_context_);
     } else if (utils::Downcast<AuthQuery>(parsed_query.query)) {
       prepared_query = PrepareAuthQuery(std::move(parsed_query), in_explicit_transaction_, &query_execution->summary,
                                         interpreter_context_, &*execution_db_accessor_,
@@ -2398,6 +2671,9 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
       prepared_query = PrepareSettingQuery(std::move(parsed_query), in_explicit_transaction_, &*execution_db_accessor_);
     } else if (utils::Downcast<VersionQuery>(parsed_query.query)) {
       prepared_query = PrepareVersionQuery(std::move(parsed_query), in_explicit_transaction_);
+    } else if (utils::Downcast<AnalyzeGraphQuery>(parsed_query.query)) {
+      prepared_query =
+          PrepareAnalyzeGraphQuery(std::move(parsed_query), in_explicit_transaction_, interpreter_context_);
     } else {
       LOG_FATAL("Should not get here -- unknown query type!");
     }
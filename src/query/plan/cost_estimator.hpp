@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <unordered_set>
+
 #include "query/frontend/ast/ast.hpp"
 #include "query/parameters.hpp"
 #include "query/plan/operator.hpp"
@@ -56,12 +58,17 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     static constexpr double MakeScanAllByLabelPropertyValue{1.1};
     static constexpr double MakeScanAllByLabelPropertyRange{1.1};
     static constexpr double MakeScanAllByLabelProperty{1.1};
+    static constexpr double kScanAllByLabelPropertyComposite{1.1};
+    static constexpr double kScanAllByEdgeType{1.1};
+    static constexpr double kScanAllByEdgeTypePropertyValue{1.1};
     static constexpr double kExpand{2.0};
     static constexpr double kExpandVariable{3.0};
     static constexpr double kFilter{1.5};
+    static constexpr double kPropertyPredicate{1.0};
     static constexpr double kEdgeUniquenessFilter{1.5};
     static constexpr double kUnwind{1.3};
     static constexpr double kForeach{1.0};
+    static constexpr double kHashJoin{1.5};
   };
 
   struct CardParam {
@@ -82,10 +89,11 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
   CostEstimator(TDbAccessor *db_accessor, const Parameters &parameters)
       : db_accessor_(db_accessor), parameters(parameters) {}
 
-  bool PostVisit(ScanAll &) override {
+  bool PostVisit(ScanAll &scan) override {
     cardinality_ *= db_accessor_->VerticesCount();
     // ScanAll performs some work for every element that is produced
     IncrementCost(CostParam::kScanAll);
+    ApplyPropertyPredicates(scan);
     return true;
   }
 
@@ -93,6 +101,7 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     cardinality_ *= db_accessor_->VerticesCount(scan_all_by_label.label_);
     // ScanAll performs some work for every element that is produced
     IncrementCost(CostParam::kScanAllByLabel);
+    ApplyPropertyPredicates(scan_all_by_label);
     return true;
   }
 
@@ -102,17 +111,23 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     // we estimate
     auto property_value = ConstPropertyValue(logical_op.expression_);
     double factor = 1.0;
-    if (property_value)
+    if (property_value) {
       // get the exact influence based on ScanAll(label, property, value)
       factor = db_accessor_->VerticesCount(logical_op.label_, logical_op.property_, property_value.value());
-    else
+    } else if (auto stats = db_accessor_->GetLabelPropertyStats(logical_op.label_, logical_op.property_)) {
+      // the average number of vertices with the same value is the expected
+      // result of a lookup with an unknown value
+      factor = stats->AvgGroupSize();
+    } else {
       // estimate the influence as ScanAll(label, property) * filtering
       factor = db_accessor_->VerticesCount(logical_op.label_, logical_op.property_) * CardParam::kFilter;
+    }
 
     cardinality_ *= factor;
 
     // ScanAll performs some work for every element that is produced
     IncrementCost(CostParam::MakeScanAllByLabelPropertyValue);
+    ApplyPropertyPredicates(logical_op);
     return true;
   }
 
@@ -122,8 +137,18 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     auto lower = BoundToPropertyValue(logical_op.lower_bound_);
     auto upper = BoundToPropertyValue(logical_op.upper_bound_);
 
-    int64_t factor = 1;
-    if (upper || lower)
+    double factor = 1;
+    std::optional<double> fraction;
+    if (upper || lower) {
+      // the histogram estimate is preferred because counting the vertices in
+      // the index range has to scan the whole range
+      if (auto stats = db_accessor_->GetLabelPropertyStats(logical_op.label_, logical_op.property_)) {
+        fraction = stats->EstimateRangeFraction(lower, upper);
+      }
+    }
+    if (fraction)
+      factor = *fraction * db_accessor_->VerticesCount(logical_op.label_, logical_op.property_);
+    else if (upper || lower)
       // if we have either Bound<PropertyValue>, use the value index
       factor = db_accessor_->VerticesCount(logical_op.label_, logical_op.property_, lower, upper);
     else
@@ -138,6 +163,7 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
 
     // ScanAll performs some work for every element that is produced
     IncrementCost(CostParam::MakeScanAllByLabelPropertyRange);
+    ApplyPropertyPredicates(logical_op);
     return true;
   }
 
@@ -145,11 +171,69 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     const auto factor = db_accessor_->VerticesCount(logical_op.label_, logical_op.property_);
     cardinality_ *= factor;
     IncrementCost(CostParam::MakeScanAllByLabelProperty);
+    ApplyPropertyPredicates(logical_op);
+    return true;
+  }
+
+  bool PostVisit(ScanAllByLabelPropertyComposite &logical_op) override {
+    // Only the leading constant values of the prefix can be used when
+    // counting the vertices in the index. Each of the remaining equalities
+    // and the range are accounted for with the filtering constant.
+    std::vector<storage::PropertyValue> prefix;
+    for (auto *expression : logical_op.prefix_) {
+      auto property_value = ConstPropertyValue(expression);
+      if (!property_value) break;
+      prefix.push_back(std::move(*property_value));
+    }
+    const bool has_bounds = logical_op.lower_bound_ || logical_op.upper_bound_;
+
+    double factor = 1.0;
+    if (prefix.size() == logical_op.prefix_.size() && has_bounds) {
+      auto lower = BoundToPropertyValue(logical_op.lower_bound_);
+      auto upper = BoundToPropertyValue(logical_op.upper_bound_);
+      factor = db_accessor_->VerticesCount(logical_op.label_, logical_op.properties_, prefix, lower, upper);
+      if ((logical_op.upper_bound_ && !upper) || (logical_op.lower_bound_ && !lower)) factor *= CardParam::kFilter;
+    } else {
+      factor = db_accessor_->VerticesCount(logical_op.label_, logical_op.properties_, prefix);
+      for (auto i = prefix.size(); i < logical_op.prefix_.size(); ++i) factor *= CardParam::kFilter;
+      if (has_bounds) factor *= CardParam::kFilter;
+    }
+    cardinality_ *= factor;
+
+    // ScanAll performs some work for every element that is produced
+    IncrementCost(CostParam::kScanAllByLabelPropertyComposite);
+    ApplyPropertyPredicates(logical_op);
     return true;
   }
 
   // TODO: Cost estimate ScanAllById?
 
+  bool PostVisit(ScanAllByEdgeType &logical_op) override {
+    cardinality_ *= db_accessor_->EdgesCount(logical_op.edge_type_);
+    IncrementCost(CostParam::kScanAllByEdgeType);
+    return true;
+  }
+
+  bool PostVisit(ScanAllByEdgeTypePropertyValue &logical_op) override {
+    // Same as for ScanAllByLabelPropertyValue, the cardinality is exact only if
+    // the property value is a constant.
+    auto property_value = ConstPropertyValue(logical_op.expression_);
+    double factor = 1.0;
+    if (property_value)
+      factor = db_accessor_->EdgesCount(logical_op.edge_type_, logical_op.property_, property_value.value());
+    else
+      factor = db_accessor_->EdgesCount(logical_op.edge_type_, logical_op.property_) * CardParam::kFilter;
+    cardinality_ *= factor;
+    IncrementCost(CostParam::kScanAllByEdgeTypePropertyValue);
+    return true;
+  }
+
+  bool PostVisit(Expand &expand) override {
+    cardinality_ *= ExpandCardinality(expand.common_);
+    IncrementCost(CostParam::kExpand);
+    return true;
+  }
+
 // For the given op first increments the cardinality and then cost.
 #define POST_VISIT_CARD_FIRST(NAME)     \
   bool PostVisit(NAME &) override {     \
@@ -158,7 +242,6 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     return true;                        \
   }
 
-  POST_VISIT_CARD_FIRST(Expand);
   POST_VISIT_CARD_FIRST(ExpandVariable);
 
 #undef POST_VISIT_CARD_FIRST
@@ -212,6 +295,20 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
+  bool PreVisit(HashJoin &hash_join) override {
+    // The left branch continues the current estimate, while the right branch
+    // is estimated on its own. Each row of both branches is either put in the
+    // hash table or it probes it, and each of the keys filters the product of
+    // the branches.
+    hash_join.left_op_->Accept(*this);
+    CostEstimator<TDbAccessor> right_estimator(db_accessor_, parameters);
+    hash_join.right_op_->Accept(right_estimator);
+    cost_ += right_estimator.cost() + CostParam::kHashJoin * (cardinality_ + right_estimator.cardinality());
+    cardinality_ *= right_estimator.cardinality();
+    for (size_t i = 0; i < hash_join.left_keys_.size(); ++i) cardinality_ *= CardParam::kFilter;
+    return false;
+  }
+
   bool Visit(Once &) override { return true; }
 
   auto cost() const { return cost_; }
@@ -232,6 +329,42 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
 
   void IncrementCost(double param) { cost_ += param * cardinality_; }
 
+  // The predicates which are pushed down into a scan are checked for every
+  // vertex that is scanned, and each of them filters the scanned vertices like
+  // a `Filter` would.
+  void ApplyPropertyPredicates(const ScanAll &scan) {
+    for (size_t i = 0; i < scan.property_predicates_.size(); ++i) {
+      IncrementCost(CostParam::kPropertyPredicate);
+      cardinality_ *= CardParam::kFilter;
+    }
+  }
+
+  // Estimates the number of edges a single vertex is expanded to. When the
+  // expansion is limited to some edge types, the average degree of those edge
+  // types is used. Otherwise, the average degree from the graph statistics is
+  // used if they were computed, and the constant estimate if they weren't.
+  double ExpandCardinality(const ExpandCommon &common) {
+    if (common.edge_types.empty()) {
+      auto degree = db_accessor_->GetAverageDegree();
+      if (!degree) return CardParam::kExpand;
+      return common.direction == EdgeAtom::Direction::BOTH ? *degree * 2 : *degree;
+    }
+    const auto vertices_count = db_accessor_->VerticesCount();
+    if (vertices_count == 0) return CardParam::kExpand;
+    // A type that is listed more than once, e.g. in `[:A|A]`, still matches
+    // each of its edges only once.
+    const std::unordered_set<storage::EdgeTypeId> edge_types(common.edge_types.begin(), common.edge_types.end());
+    double edges_count = 0;
+    for (const auto &edge_type : edge_types) {
+      edges_count += db_accessor_->EdgesCount(edge_type);
+    }
+    // The average in degree and the average out degree are both equal to the
+    // number of edges divided by the number of vertices.
+    auto degree = edges_count / vertices_count;
+    if (common.direction == EdgeAtom::Direction::BOTH) degree *= 2;
+    return degree;
+  }
+
   // converts an optional ScanAll range bound into a property value
   // if the bound is present and is a constant expression convertible to
   // a property value. otherwise returns nullopt
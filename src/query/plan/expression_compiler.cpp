@@ -0,0 +1,35 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/plan/expression_compiler.hpp"
+
+#include <utility>
+
+namespace memgraph::query::plan {
+
+CompiledExpressions ExpressionCompiler::Compile(LogicalOperator &root) {
+  root.Accept(*this);
+  return std::exchange(expressions_, CompiledExpressions());
+}
+
+bool ExpressionCompiler::PreVisit(Filter &op) {
+  expressions_.Add(op.expression_, symbol_table_);
+  return true;
+}
+
+bool ExpressionCompiler::PreVisit(Produce &op) {
+  for (auto *named_expression : op.named_expressions_) expressions_.Add(named_expression, symbol_table_);
+  return true;
+}
+
+bool ExpressionCompiler::Visit(Once &) { return true; }  // NOLINT(hicpp-named-parameter)
+
+}  // namespace memgraph::query::plan
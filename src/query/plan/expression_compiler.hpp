@@ -0,0 +1,48 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include "query/frontend/semantic/symbol_table.hpp"
+#include "query/interpret/compiled_expression.hpp"
+#include "query/plan/operator.hpp"
+
+namespace memgraph::query::plan {
+
+/// Compiles the expressions of the plan which are evaluated for every row:
+/// the expressions of `Filter` and the named expressions of `Produce`.
+class ExpressionCompiler : public virtual HierarchicalLogicalOperatorVisitor {
+ public:
+  explicit ExpressionCompiler(const SymbolTable &symbol_table) : symbol_table_(symbol_table) {}
+
+  ExpressionCompiler(const ExpressionCompiler &) = delete;
+  ExpressionCompiler(ExpressionCompiler &&) = delete;
+
+  ExpressionCompiler &operator=(const ExpressionCompiler &) = delete;
+  ExpressionCompiler &operator=(ExpressionCompiler &&) = delete;
+
+  using HierarchicalLogicalOperatorVisitor::PostVisit;
+  using HierarchicalLogicalOperatorVisitor::PreVisit;
+  using HierarchicalLogicalOperatorVisitor::Visit;
+
+  CompiledExpressions Compile(LogicalOperator &root);
+
+  bool PreVisit(Filter &) override;
+  bool PreVisit(Produce &) override;
+
+  bool Visit(Once &) override;
+
+ private:
+  const SymbolTable &symbol_table_;
+  CompiledExpressions expressions_;
+};
+
+}  // namespace memgraph::query::plan
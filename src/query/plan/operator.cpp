@@ -12,11 +12,16 @@
 #include "query/plan/operator.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <exception>
+#include <latch>
 #include <limits>
 #include <queue>
 #include <random>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
@@ -35,9 +40,11 @@
 #include "query/frontend/ast/ast.hpp"
 #include "query/frontend/semantic/symbol_table.hpp"
 #include "query/graph.hpp"
+#include "query/interpret/compiled_expression.hpp"
 #include "query/interpret/eval.hpp"
 #include "query/path.hpp"
 #include "query/plan/scoped_profile.hpp"
+#include "query/plan/spill_file.hpp"
 #include "query/procedure/cypher_types.hpp"
 #include "query/procedure/mg_procedure_impl.hpp"
 #include "query/procedure/module.hpp"
@@ -59,6 +66,7 @@
 #include "utils/readable_size.hpp"
 #include "utils/string.hpp"
 #include "utils/temporal.hpp"
+#include "utils/thread_pool.hpp"
 
 // macro for the default implementation of LogicalOperator::Accept
 // that accepts the visitor and visits it's input_ operator
@@ -88,7 +96,10 @@ extern const Event ScanAllByLabelOperator;
 extern const Event ScanAllByLabelPropertyRangeOperator;
 extern const Event ScanAllByLabelPropertyValueOperator;
 extern const Event ScanAllByLabelPropertyOperator;
+extern const Event ScanAllByLabelPropertyCompositeOperator;
 extern const Event ScanAllByIdOperator;
+extern const Event ScanAllByEdgeTypeOperator;
+extern const Event ScanAllByEdgeTypePropertyValueOperator;
 extern const Event ExpandOperator;
 extern const Event ExpandVariableOperator;
 extern const Event ConstructNamedPathOperator;
@@ -103,15 +114,19 @@ extern const Event RemoveLabelsOperator;
 extern const Event EdgeUniquenessFilterOperator;
 extern const Event AccumulateOperator;
 extern const Event AggregateOperator;
+extern const Event ParallelAggregateOperator;
+extern const Event ColumnarAggregateOperator;
 extern const Event SkipOperator;
 extern const Event LimitOperator;
 extern const Event OrderByOperator;
+extern const Event TopKOperator;
 extern const Event MergeOperator;
 extern const Event OptionalOperator;
 extern const Event UnwindOperator;
 extern const Event DistinctOperator;
 extern const Event UnionOperator;
 extern const Event CartesianOperator;
+extern const Event HashJoinOperator;
 extern const Event CallProcedureOperator;
 extern const Event ForeachOperator;
 extern const Event EmptyResultOperator;
@@ -145,16 +160,69 @@ bool EvaluateFilter(ExpressionEvaluator &evaluator, Expression *filter) {
   return result.ValueBool();
 }
 
+// Returns `nullptr` if the expression isn't compiled.
+const CompiledExpression *FindCompiledExpression(const ExecutionContext &context, const Tree *expression) {
+  if (!context.compiled_expressions) return nullptr;
+  return context.compiled_expressions->Find(expression);
+}
+
 template <typename T>
 uint64_t ComputeProfilingKey(const T *obj) {
   static_assert(sizeof(T *) == sizeof(uint64_t));
   return reinterpret_cast<uint64_t>(obj);
 }
 
+// Threads shared by the parallel operators of all queries. The number of
+// threads a single query uses is limited by its operators.
+utils::ThreadPool &ParallelWorkerPool() {
+  static utils::ThreadPool pool(std::max(std::thread::hardware_concurrency(), 1U));
+  return pool;
+}
+
+// Adds the profiling stats of a parallel worker to the stats of the operator
+// that started it. The workers run their own copies of the same operators, so
+// the stats are matched by the operator name. The cycles are averaged over the
+// workers so that the operators never take more time than their parent.
+void MergeWorkerStats(ProfilingStats *stats_root, const ProfilingStats &worker_stats, int64_t num_workers) {
+  auto it = std::find_if(stats_root->children.begin(), stats_root->children.end(),
+                         [&](const auto &stats) { return std::strcmp(stats.name, worker_stats.name) == 0; });
+  if (it == stats_root->children.end()) {
+    it = stats_root->children.insert(it, ProfilingStats{.key = worker_stats.key, .name = worker_stats.name});
+  }
+  it->actual_hits += worker_stats.actual_hits;
+  it->num_cycles += worker_stats.num_cycles / num_workers;
+  for (const auto &child : worker_stats.children) {
+    MergeWorkerStats(&*it, child, num_workers);
+  }
+}
+
 }  // namespace
 
 #define SCOPED_PROFILE_OP(name) ScopedProfile profile{ComputeProfilingKey(this), name, &context};
 
+bool Cursor::PullBatch(FrameBatch &batch, ExecutionContext &context) {
+  batch.Clear();
+  auto &frame = batch.frame();
+  while (!batch.full() && Pull(frame, context)) batch.Append(frame);
+  return !batch.empty();
+}
+
+bool CanPullBatches(const LogicalOperator &op) {
+  const auto *current = &op;
+  while (true) {
+    const auto &type = current->GetTypeInfo();
+    if (type == Once::kType) return true;
+    // The scans which are listed here use `ScanAllCursor`.
+    const bool batched = type == ScanAll::kType || type == ScanAllByLabel::kType ||
+                         type == ScanAllByLabelPropertyRange::kType || type == ScanAllByLabelPropertyValue::kType ||
+                         type == ScanAllByLabelProperty::kType || type == ScanAllByLabelPropertyComposite::kType ||
+                         type == ScanAllById::kType || type == Expand::kType || type == Filter::kType ||
+                         type == Produce::kType;
+    if (!batched) return false;
+    current = current->input().get();
+  }
+}
+
 bool Once::OnceCursor::Pull(Frame &, ExecutionContext &context) {
   SCOPED_PROFILE_OP("Once");
 
@@ -407,12 +475,71 @@ VertexAccessor &CreateExpand::CreateExpandCursor::OtherVertex(Frame &frame, Exec
   }
 }
 
+/// Hands out the vertices of a scan that is shared by the workers of a
+/// `ParallelAggregate`. The vertices are split into many more chunks than
+/// there are workers, and a worker takes the next chunk with an atomic counter
+/// once it is done with its previous one, so the workers balance the load
+/// between themselves without any locking. Each worker scans its chunk on its
+/// own and hands the vertices to its pipeline in batches (morsels).
+class VertexMorsels final {
+ public:
+  static constexpr size_t kMorselSize = 1024;
+  static constexpr uint64_t kChunksPerWorker = 16;
+
+  VertexMorsels(storage::VertexChunks chunks, const ExecutionContext *context)
+      : chunks_(std::move(chunks)), context_(context) {}
+
+  VertexMorsels(const VertexMorsels &) = delete;
+  VertexMorsels(VertexMorsels &&) = delete;
+  VertexMorsels &operator=(const VertexMorsels &) = delete;
+  VertexMorsels &operator=(VertexMorsels &&) = delete;
+  ~VertexMorsels() = default;
+
+  /// Replaces the contents of `morsel` with the next batch of vertices of the
+  /// worker, whose current chunk is scanned by `scanner`. A new chunk is taken
+  /// when the current one is exhausted. Returns `false` when all of the chunks
+  /// are taken and scanned, or when the scan is stopped.
+  /// @throw HintedAbortError if the query was aborted.
+  bool Next(std::optional<storage::VertexChunks::Scanner> *scanner, std::vector<VertexAccessor> *morsel) {
+    morsel->clear();
+    if (MustAbort(*context_)) throw HintedAbortError();
+    if (stopped_.load(std::memory_order_acquire)) return false;
+    while (morsel->size() < kMorselSize) {
+      if (!*scanner) {
+        const auto chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= chunks_.size()) break;
+        scanner->emplace(chunks_.Scan(chunk));
+      }
+      auto vertex = (*scanner)->Next();
+      if (!vertex) {
+        scanner->reset();
+        continue;
+      }
+      morsel->emplace_back(*vertex);
+    }
+    return !morsel->empty();
+  }
+
+  /// Makes all following calls to `Next` return `false`. This is used to stop
+  /// the other workers early when one of them fails.
+  void Stop() { stopped_.store(true, std::memory_order_release); }
+
+ private:
+  const storage::VertexChunks chunks_;
+  // The context of the query that owns the workers, checked for the abort
+  // condition because the contexts of the workers don't have the timer.
+  const ExecutionContext *context_;
+  std::atomic<size_t> next_chunk_{0};
+  std::atomic<bool> stopped_{false};
+};
+
 template <class TVerticesFun>
 class ScanAllCursor : public Cursor {
  public:
-  explicit ScanAllCursor(Symbol output_symbol, UniqueCursorPtr input_cursor, TVerticesFun get_vertices,
+  explicit ScanAllCursor(const ScanAll &self, UniqueCursorPtr input_cursor, TVerticesFun get_vertices,
                          const char *op_name)
-      : output_symbol_(output_symbol),
+      : self_(self),
+        output_symbol_(self.output_symbol_),
         input_cursor_(std::move(input_cursor)),
         get_vertices_(std::move(get_vertices)),
         op_name_(op_name) {}
@@ -422,27 +549,67 @@ class ScanAllCursor : public Cursor {
 
     if (MustAbort(context)) throw HintedAbortError();
 
-    while (!vertices_ || vertices_it_.value() == vertices_.value().end()) {
-      if (!input_cursor_->Pull(frame, context)) return false;
-      // We need a getter function, because in case of exhausting a lazy
-      // iterable, we cannot simply reset it by calling begin().
-      auto next_vertices = get_vertices_(frame, context);
-      if (!next_vertices) continue;
-      // Since vertices iterator isn't nothrow_move_assignable, we have to use
-      // the roundabout assignment + emplace, instead of simple:
-      // vertices _ = get_vertices_(frame, context);
-      vertices_.emplace(std::move(next_vertices.value()));
-      vertices_it_.emplace(vertices_.value().begin());
-    }
+    if (context.vertex_morsels) return PullMorsel(frame, context);
+
+    while (true) {
+      while (!vertices_ || vertices_it_.value() == vertices_.value().end()) {
+        if (!input_cursor_->Pull(frame, context)) return false;
+        // We need a getter function, because in case of exhausting a lazy
+        // iterable, we cannot simply reset it by calling begin().
+        auto next_vertices = get_vertices_(frame, context);
+        if (!next_vertices) continue;
+        // Since vertices iterator isn't nothrow_move_assignable, we have to use
+        // the roundabout assignment + emplace, instead of simple:
+        // vertices _ = get_vertices_(frame, context);
+        vertices_.emplace(std::move(next_vertices.value()));
+        vertices_it_.emplace(vertices_.value().begin());
+      }
 #ifdef MG_ENTERPRISE
-    if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker && !FindNextVertex(context)) {
-      return false;
-    }
+      if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker && !FindNextVertex(context)) {
+        return false;
+      }
 #endif
 
-    frame[output_symbol_] = *vertices_it_.value();
-    ++vertices_it_.value();
-    return true;
+      auto vertex = *vertices_it_.value();
+      ++vertices_it_.value();
+      if (!MatchesPropertyPredicates(vertex, frame, context)) continue;
+      frame[output_symbol_] = vertex;
+      return true;
+    }
+  }
+
+  bool PullBatch(FrameBatch &batch, ExecutionContext &context) override {
+    SCOPED_PROFILE_OP(op_name_);
+
+    if (MustAbort(context)) throw HintedAbortError();
+
+    batch.Clear();
+    if (context.vertex_morsels) return PullMorselBatch(batch, context);
+
+    // The input is pulled one row at a time, and its symbols are copied into
+    // every row that is scanned for it.
+    if (!input_symbols_) input_symbols_.emplace(self_.input()->ModifiedSymbols(context.symbol_table));
+    auto &input_frame = batch.frame();
+    while (!batch.full()) {
+      if (!vertices_ || vertices_it_.value() == vertices_.value().end()) {
+        if (!input_cursor_->Pull(input_frame, context)) break;
+        auto next_vertices = get_vertices_(input_frame, context);
+        if (!next_vertices) continue;
+        vertices_.emplace(std::move(next_vertices.value()));
+        vertices_it_.emplace(vertices_.value().begin());
+        continue;
+      }
+#ifdef MG_ENTERPRISE
+      if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker && !FindNextVertex(context)) {
+        continue;
+      }
+#endif
+      auto vertex = *vertices_it_.value();
+      ++vertices_it_.value();
+      if (!MatchesPropertyPredicates(vertex, input_frame, context)) continue;
+      batch.Append(input_frame, *input_symbols_)[output_symbol_] = vertex;
+    }
+    return !batch.empty();
   }
 
 #ifdef MG_ENTERPRISE
@@ -464,14 +631,131 @@ class ScanAllCursor : public Cursor {
     input_cursor_->Reset();
     vertices_ = std::nullopt;
     vertices_it_ = std::nullopt;
+    morsel_.clear();
+    morsel_pos_ = 0;
+    chunk_scanner_ = std::nullopt;
   }
 
  private:
+  // Used by the workers of a `ParallelAggregate`, whose pipelines always start
+  // with a scan that has `Once` as its input, so the input isn't pulled at all.
+  bool PullMorsel(Frame &frame, ExecutionContext &context) {
+    while (true) {
+      if (morsel_pos_ == morsel_.size()) {
+        morsel_pos_ = 0;
+        if (!context.vertex_morsels->Next(&chunk_scanner_, &morsel_)) return false;
+      }
+      const auto &vertex = morsel_[morsel_pos_++];
+      if (!MatchesPropertyPredicates(vertex, frame, context)) continue;
+      frame[output_symbol_] = vertex;
+      return true;
+    }
+  }
+
+  bool PullMorselBatch(FrameBatch &batch, ExecutionContext &context) {
+    auto &frame = batch.frame();
+    while (!batch.full()) {
+      if (morsel_pos_ == morsel_.size()) {
+        morsel_pos_ = 0;
+        if (!context.vertex_morsels->Next(&chunk_scanner_, &morsel_)) break;
+      }
+      const auto &vertex = morsel_[morsel_pos_++];
+      if (!MatchesPropertyPredicates(vertex, frame, context)) continue;
+      batch.Append(frame, {})[output_symbol_] = vertex;
+    }
+    return !batch.empty();
+  }
+
+  // Checks the predicates which were pushed down into the scan. A predicate
+  // which the storage can't check is replaced by its filter expression, which
+  // is evaluated with the vertex stored on `frame`.
+  bool MatchesPropertyPredicates(const VertexAccessor &vertex, Frame &frame, ExecutionContext &context) {
+    if (self_.property_predicates_.empty()) return true;
+    if (!property_predicates_) EvaluatePropertyPredicates(frame, context);
+    for (size_t i = 0; i < self_.property_predicates_.size(); ++i) {
+      const auto &predicate = self_.property_predicates_[i];
+      const auto &storage_predicate = (*property_predicates_)[i];
+      if (storage_predicate) {
+        // Like all filters, newly set values should not affect filtering of
+        // old nodes.
+        auto result = vertex.CheckPropertyPredicate(storage::View::OLD, predicate.property, *storage_predicate);
+        if (result.HasValue() && *result == storage::PropertyPredicate::Result::MATCH) continue;
+        if (result.HasValue() && *result == storage::PropertyPredicate::Result::NO_MATCH) return false;
+      }
+      frame[output_symbol_] = vertex;
+      ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
+                                    storage::View::OLD);
+      if (!EvaluateFilter(evaluator, predicate.expression)) return false;
+    }
+    return true;
+  }
+
+  // The values of the predicates don't depend on the frame, so they are
+  // evaluated only once. A predicate whose values aren't property values is
+  // left to its filter expression.
+  void EvaluatePropertyPredicates(Frame &frame, ExecutionContext &context) {
+    ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
+                                  storage::View::OLD);
+    auto evaluate = [&evaluator](Expression *expression) -> std::optional<storage::PropertyValue> {
+      try {
+        return storage::PropertyValue(expression->Accept(evaluator));
+      } catch (const TypedValueException &) {
+        return std::nullopt;
+      }
+    };
+    auto evaluate_bound = [&evaluate](const std::optional<ScanAll::Bound> &bound,
+                                      bool *valid) -> std::optional<utils::Bound<storage::PropertyValue>> {
+      if (!bound) return std::nullopt;
+      auto value = evaluate(bound->value());
+      if (!value) {
+        *valid = false;
+        return std::nullopt;
+      }
+      return utils::Bound<storage::PropertyValue>(std::move(*value), bound->type());
+    };
+    property_predicates_.emplace();
+    property_predicates_->reserve(self_.property_predicates_.size());
+    for (const auto &predicate : self_.property_predicates_) {
+      auto &storage_predicate = property_predicates_->emplace_back();
+      switch (predicate.type) {
+        case storage::PropertyPredicate::Type::EQUAL: {
+          auto value = evaluate(predicate.value);
+          if (value) storage_predicate = storage::PropertyPredicate::Equal(std::move(*value));
+          break;
+        }
+        case storage::PropertyPredicate::Type::RANGE: {
+          bool valid = true;
+          auto lower = evaluate_bound(predicate.lower_bound, &valid);
+          auto upper = evaluate_bound(predicate.upper_bound, &valid);
+          if (valid) storage_predicate = storage::PropertyPredicate::Range(std::move(lower), std::move(upper));
+          break;
+        }
+        case storage::PropertyPredicate::Type::IS_NULL:
+          storage_predicate = storage::PropertyPredicate::IsNull();
+          break;
+        case storage::PropertyPredicate::Type::IS_NOT_NULL:
+          storage_predicate = storage::PropertyPredicate::IsNotNull();
+          break;
+      }
+    }
+  }
+
+  const ScanAll &self_;
   const Symbol output_symbol_;
   const UniqueCursorPtr input_cursor_;
   TVerticesFun get_vertices_;
   std::optional<typename std::result_of<TVerticesFun(Frame &, ExecutionContext &)>::type::value_type> vertices_;
   std::optional<decltype(vertices_.value().begin())> vertices_it_;
+  // The scanner of the chunk which this worker of a `ParallelAggregate` took
+  // from `ExecutionContext::vertex_morsels`.
+  std::optional<storage::VertexChunks::Scanner> chunk_scanner_;
+  std::vector<VertexAccessor> morsel_;
+  size_t morsel_pos_{0};
+  // Symbols bound by the input, used only by `PullBatch`.
+  std::optional<std::vector<Symbol>> input_symbols_;
+  // Evaluated `self_.property_predicates_`, `std::nullopt` for the predicates
+  // which are left to their filter expressions.
+  std::optional<std::vector<std::optional<storage::PropertyPredicate>>> property_predicates_;
   const char *op_name_;
 };
 
@@ -487,7 +771,7 @@ UniqueCursorPtr ScanAll::MakeCursor(utils::MemoryResource *mem) const {
     auto *db = context.db_accessor;
     return std::make_optional(db->Vertices(view_));
   };
-  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, output_symbol_, input_->MakeCursor(mem),
+  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, *this, input_->MakeCursor(mem),
                                                                 std::move(vertices), "ScanAll");
 }
 
@@ -510,13 +794,47 @@ UniqueCursorPtr ScanAllByLabel::MakeCursor(utils::MemoryResource *mem) const {
     auto *db = context.db_accessor;
     return std::make_optional(db->Vertices(view_, label_));
   };
-  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, output_symbol_, input_->MakeCursor(mem),
+  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, *this, input_->MakeCursor(mem),
                                                                 std::move(vertices), "ScanAllByLabel");
 }
 
 // TODO(buda): Implement ScanAllByLabelProperty operator to iterate over
 // vertices that have the label and some value for the given property.
 
+namespace {
+
+// Evaluates the expression of a range bound used for an indexed lookup.
+std::optional<utils::Bound<storage::PropertyValue>> EvaluateBound(
+    const std::optional<utils::Bound<Expression *>> &bound, ExpressionEvaluator *evaluator) {
+  if (!bound) return std::nullopt;
+  const auto &value = bound->value()->Accept(*evaluator);
+  try {
+    const auto &property_value = storage::PropertyValue(value);
+    switch (property_value.type()) {
+      case storage::PropertyValue::Type::Bool:
+      case storage::PropertyValue::Type::List:
+      case storage::PropertyValue::Type::Map:
+        // Prevent indexed lookup with something that would fail if we did
+        // the original filter with `operator<`. Note, for some reason,
+        // Cypher does not support comparing boolean values.
+        throw QueryRuntimeException("Invalid type {} for '<'.", value.type());
+      case storage::PropertyValue::Type::Null:
+      case storage::PropertyValue::Type::Int:
+      case storage::PropertyValue::Type::Double:
+      case storage::PropertyValue::Type::String:
+      case storage::PropertyValue::Type::TemporalData:
+        // These are all fine, there's also Point, Date and Time data types
+        // which were added to Cypher, but we don't have support for those
+        // yet.
+        return std::make_optional(utils::Bound<storage::PropertyValue>(property_value, bound->type()));
+    }
+  } catch (const TypedValueException &) {
+    throw QueryRuntimeException("'{}' cannot be used as a property value.", value.type());
+  }
+}
+
+}  // namespace
+
 ScanAllByLabelPropertyRange::ScanAllByLabelPropertyRange(const std::shared_ptr<LogicalOperator> &input,
                                                          Symbol output_symbol, storage::LabelId label,
                                                          storage::PropertyId property, const std::string &property_name,
@@ -540,42 +858,15 @@ UniqueCursorPtr ScanAllByLabelPropertyRange::MakeCursor(utils::MemoryResource *m
       -> std::optional<decltype(context.db_accessor->Vertices(view_, label_, property_, std::nullopt, std::nullopt))> {
     auto *db = context.db_accessor;
     ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor, view_);
-    auto convert = [&evaluator](const auto &bound) -> std::optional<utils::Bound<storage::PropertyValue>> {
-      if (!bound) return std::nullopt;
-      const auto &value = bound->value()->Accept(evaluator);
-      try {
-        const auto &property_value = storage::PropertyValue(value);
-        switch (property_value.type()) {
-          case storage::PropertyValue::Type::Bool:
-          case storage::PropertyValue::Type::List:
-          case storage::PropertyValue::Type::Map:
-            // Prevent indexed lookup with something that would fail if we did
-            // the original filter with `operator<`. Note, for some reason,
-            // Cypher does not support comparing boolean values.
-            throw QueryRuntimeException("Invalid type {} for '<'.", value.type());
-          case storage::PropertyValue::Type::Null:
-          case storage::PropertyValue::Type::Int:
-          case storage::PropertyValue::Type::Double:
-          case storage::PropertyValue::Type::String:
-          case storage::PropertyValue::Type::TemporalData:
-            // These are all fine, there's also Point, Date and Time data types
-            // which were added to Cypher, but we don't have support for those
-            // yet.
-            return std::make_optional(utils::Bound<storage::PropertyValue>(property_value, bound->type()));
-        }
-      } catch (const TypedValueException &) {
-        throw QueryRuntimeException("'{}' cannot be used as a property value.", value.type());
-      }
-    };
-    auto maybe_lower = convert(lower_bound_);
-    auto maybe_upper = convert(upper_bound_);
+    auto maybe_lower = EvaluateBound(lower_bound_, &evaluator);
+    auto maybe_upper = EvaluateBound(upper_bound_, &evaluator);
     // If any bound is null, then the comparison would result in nulls. This
     // is treated as not satisfying the filter, so return no vertices.
     if (maybe_lower && maybe_lower->value().IsNull()) return std::nullopt;
     if (maybe_upper && maybe_upper->value().IsNull()) return std::nullopt;
     return std::make_optional(db->Vertices(view_, label_, property_, maybe_lower, maybe_upper));
   };
-  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, output_symbol_, input_->MakeCursor(mem),
+  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, *this, input_->MakeCursor(mem),
                                                                 std::move(vertices), "ScanAllByLabelPropertyRange");
 }
 
@@ -607,7 +898,7 @@ UniqueCursorPtr ScanAllByLabelPropertyValue::MakeCursor(utils::MemoryResource *m
     }
     return std::make_optional(db->Vertices(view_, label_, property_, storage::PropertyValue(value)));
   };
-  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, output_symbol_, input_->MakeCursor(mem),
+  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, *this, input_->MakeCursor(mem),
                                                                 std::move(vertices), "ScanAllByLabelPropertyValue");
 }
 
@@ -625,10 +916,60 @@ UniqueCursorPtr ScanAllByLabelProperty::MakeCursor(utils::MemoryResource *mem) c
     auto *db = context.db_accessor;
     return std::make_optional(db->Vertices(view_, label_, property_));
   };
-  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, output_symbol_, input_->MakeCursor(mem),
+  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, *this, input_->MakeCursor(mem),
                                                                 std::move(vertices), "ScanAllByLabelProperty");
 }
 
+ScanAllByLabelPropertyComposite::ScanAllByLabelPropertyComposite(
+    const std::shared_ptr<LogicalOperator> &input, Symbol output_symbol, storage::LabelId label,
+    const std::vector<storage::PropertyId> &properties, const std::vector<std::string> &property_names,
+    const std::vector<Expression *> &prefix, std::optional<Bound> lower_bound, std::optional<Bound> upper_bound,
+    storage::View view)
+    : ScanAll(input, output_symbol, view),
+      label_(label),
+      properties_(properties),
+      property_names_(property_names),
+      prefix_(prefix),
+      lower_bound_(lower_bound),
+      upper_bound_(upper_bound) {
+  MG_ASSERT(properties_.size() == property_names_.size(), "Each property must have a name");
+  MG_ASSERT(prefix_.size() <= properties_.size(), "The prefix is longer than the index");
+  MG_ASSERT(prefix_.size() < properties_.size() || (!lower_bound_ && !upper_bound_),
+            "The bounds must be on a property of the index");
+  MG_ASSERT(!prefix_.empty() || lower_bound_ || upper_bound_, "Either the prefix or a bound must be given");
+}
+
+ACCEPT_WITH_INPUT(ScanAllByLabelPropertyComposite)
+
+UniqueCursorPtr ScanAllByLabelPropertyComposite::MakeCursor(utils::MemoryResource *mem) const {
+  EventCounter::IncrementCounter(EventCounter::ScanAllByLabelPropertyCompositeOperator);
+
+  auto vertices = [this](Frame &frame, ExecutionContext &context)
+      -> std::optional<decltype(context.db_accessor->Vertices(view_, label_, properties_, {}, std::nullopt,
+                                                              std::nullopt))> {
+    auto *db = context.db_accessor;
+    ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor, view_);
+    std::vector<storage::PropertyValue> prefix;
+    prefix.reserve(prefix_.size());
+    for (auto *expression : prefix_) {
+      auto value = expression->Accept(evaluator);
+      // An equality with null is never satisfied.
+      if (value.IsNull()) return std::nullopt;
+      if (!value.IsPropertyValue()) {
+        throw QueryRuntimeException("'{}' cannot be used as a property value.", value.type());
+      }
+      prefix.emplace_back(value);
+    }
+    auto maybe_lower = EvaluateBound(lower_bound_, &evaluator);
+    auto maybe_upper = EvaluateBound(upper_bound_, &evaluator);
+    if (maybe_lower && maybe_lower->value().IsNull()) return std::nullopt;
+    if (maybe_upper && maybe_upper->value().IsNull()) return std::nullopt;
+    return std::make_optional(db->Vertices(view_, label_, properties_, prefix, maybe_lower, maybe_upper));
+  };
+  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, *this, input_->MakeCursor(mem),
+                                                                std::move(vertices), "ScanAllByLabelPropertyComposite");
+}
+
 ScanAllById::ScanAllById(const std::shared_ptr<LogicalOperator> &input, Symbol output_symbol, Expression *expression,
                          storage::View view)
     : ScanAll(input, output_symbol, view), expression_(expression) {
@@ -651,10 +992,133 @@ UniqueCursorPtr ScanAllById::MakeCursor(utils::MemoryResource *mem) const {
     if (!maybe_vertex) return std::nullopt;
     return std::vector<VertexAccessor>{*maybe_vertex};
   };
-  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, output_symbol_, input_->MakeCursor(mem),
+  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, *this, input_->MakeCursor(mem),
                                                                 std::move(vertices), "ScanAllById");
 }
 
+namespace {
+
+template <typename TEdgesFun>
+class ScanAllByEdgeTypeCursor : public Cursor {
+ public:
+  explicit ScanAllByEdgeTypeCursor(const ScanAllByEdgeType &self, UniqueCursorPtr &&input_cursor,
+                                   TEdgesFun get_edges, const char *op_name)
+      : self_(self), input_cursor_(std::move(input_cursor)), get_edges_(std::move(get_edges)), op_name_(op_name) {}
+
+  bool Pull(Frame &frame, ExecutionContext &context) override {
+    SCOPED_PROFILE_OP(op_name_);
+
+    while (true) {
+      if (MustAbort(context)) throw HintedAbortError();
+
+      while (!edges_ || edges_it_.value() == edges_.value().end()) {
+        if (!input_cursor_->Pull(frame, context)) return false;
+        auto next_edges = get_edges_(frame, context);
+        if (!next_edges) continue;
+        edges_.emplace(std::move(next_edges.value()));
+        edges_it_.emplace(edges_.value().begin());
+      }
+
+      auto edge = *edges_it_.value();
+      ++edges_it_.value();
+#ifdef MG_ENTERPRISE
+      if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
+          !(context.auth_checker->Has(edge, memgraph::query::AuthQuery::FineGrainedPrivilege::READ) &&
+            context.auth_checker->Has(edge.From(), self_.view_,
+                                      memgraph::query::AuthQuery::FineGrainedPrivilege::READ) &&
+            context.auth_checker->Has(edge.To(), self_.view_,
+                                      memgraph::query::AuthQuery::FineGrainedPrivilege::READ))) {
+        continue;
+      }
+#endif
+      frame[self_.from_symbol_] = edge.From();
+      frame[self_.edge_symbol_] = edge;
+      frame[self_.to_symbol_] = edge.To();
+      return true;
+    }
+  }
+
+  void Shutdown() override { input_cursor_->Shutdown(); }
+
+  void Reset() override {
+    input_cursor_->Reset();
+    edges_ = std::nullopt;
+    edges_it_ = std::nullopt;
+  }
+
+ private:
+  const ScanAllByEdgeType &self_;
+  const UniqueCursorPtr input_cursor_;
+  TEdgesFun get_edges_;
+  std::optional<typename std::result_of<TEdgesFun(Frame &, ExecutionContext &)>::type::value_type> edges_;
+  std::optional<decltype(edges_.value().begin())> edges_it_;
+  const char *op_name_;
+};
+
+}  // namespace
+
+ScanAllByEdgeType::ScanAllByEdgeType(const std::shared_ptr<LogicalOperator> &input, Symbol from_symbol,
+                                     Symbol edge_symbol, Symbol to_symbol, storage::EdgeTypeId edge_type,
+                                     storage::View view)
+    : input_(input ? input : std::make_shared<Once>()),
+      from_symbol_(from_symbol),
+      edge_symbol_(edge_symbol),
+      to_symbol_(to_symbol),
+      edge_type_(edge_type),
+      view_(view) {}
+
+ACCEPT_WITH_INPUT(ScanAllByEdgeType)
+
+UniqueCursorPtr ScanAllByEdgeType::MakeCursor(utils::MemoryResource *mem) const {
+  EventCounter::IncrementCounter(EventCounter::ScanAllByEdgeTypeOperator);
+
+  auto edges = [this](Frame &, ExecutionContext &context) {
+    auto *db = context.db_accessor;
+    return std::make_optional(db->Edges(view_, edge_type_));
+  };
+  return MakeUniqueCursorPtr<ScanAllByEdgeTypeCursor<decltype(edges)>>(mem, *this, input_->MakeCursor(mem),
+                                                                       std::move(edges), "ScanAllByEdgeType");
+}
+
+std::vector<Symbol> ScanAllByEdgeType::ModifiedSymbols(const SymbolTable &table) const {
+  auto symbols = input_->ModifiedSymbols(table);
+  symbols.emplace_back(from_symbol_);
+  symbols.emplace_back(edge_symbol_);
+  symbols.emplace_back(to_symbol_);
+  return symbols;
+}
+
+ScanAllByEdgeTypePropertyValue::ScanAllByEdgeTypePropertyValue(
+    const std::shared_ptr<LogicalOperator> &input, Symbol from_symbol, Symbol edge_symbol, Symbol to_symbol,
+    storage::EdgeTypeId edge_type, storage::PropertyId property, const std::string &property_name,
+    Expression *expression, storage::View view)
+    : ScanAllByEdgeType(input, from_symbol, edge_symbol, to_symbol, edge_type, view),
+      property_(property),
+      property_name_(property_name),
+      expression_(expression) {
+  DMG_ASSERT(expression, "Expression is not optional.");
+}
+
+ACCEPT_WITH_INPUT(ScanAllByEdgeTypePropertyValue)
+
+UniqueCursorPtr ScanAllByEdgeTypePropertyValue::MakeCursor(utils::MemoryResource *mem) const {
+  EventCounter::IncrementCounter(EventCounter::ScanAllByEdgeTypePropertyValueOperator);
+
+  auto edges = [this](Frame &frame, ExecutionContext &context)
+      -> std::optional<decltype(context.db_accessor->Edges(view_, edge_type_, property_, storage::PropertyValue()))> {
+    auto *db = context.db_accessor;
+    ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor, view_);
+    auto value = expression_->Accept(evaluator);
+    if (value.IsNull()) return std::nullopt;
+    if (!value.IsPropertyValue()) {
+      throw QueryRuntimeException("'{}' cannot be used as a property value.", value.type());
+    }
+    return std::make_optional(db->Edges(view_, edge_type_, property_, storage::PropertyValue(value)));
+  };
+  return MakeUniqueCursorPtr<ScanAllByEdgeTypeCursor<decltype(edges)>>(
+      mem, *this, input_->MakeCursor(mem), std::move(edges), "ScanAllByEdgeTypePropertyValue");
+}
+
 namespace {
 bool CheckExistingNode(const VertexAccessor &new_node, const Symbol &existing_node_sym, Frame &frame) {
   const TypedValue &existing_node = frame[existing_node_sym];
@@ -711,57 +1175,10 @@ Expand::ExpandCursor::ExpandCursor(const Expand &self, utils::MemoryResource *me
 bool Expand::ExpandCursor::Pull(Frame &frame, ExecutionContext &context) {
   SCOPED_PROFILE_OP("Expand");
 
-  // A helper function for expanding a node from an edge.
-  auto pull_node = [this, &frame](const EdgeAccessor &new_edge, EdgeAtom::Direction direction) {
-    if (self_.common_.existing_node) return;
-    switch (direction) {
-      case EdgeAtom::Direction::IN:
-        frame[self_.common_.node_symbol] = new_edge.From();
-        break;
-      case EdgeAtom::Direction::OUT:
-        frame[self_.common_.node_symbol] = new_edge.To();
-        break;
-      case EdgeAtom::Direction::BOTH:
-        LOG_FATAL("Must indicate exact expansion direction here");
-    }
-  };
-
   while (true) {
     if (MustAbort(context)) throw HintedAbortError();
-    // attempt to get a value from the incoming edges
-    if (in_edges_ && *in_edges_it_ != in_edges_->end()) {
-      auto edge = *(*in_edges_it_)++;
-#ifdef MG_ENTERPRISE
-      if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
-          !(context.auth_checker->Has(edge, memgraph::query::AuthQuery::FineGrainedPrivilege::READ) &&
-            context.auth_checker->Has(edge.From(), self_.view_,
-                                      memgraph::query::AuthQuery::FineGrainedPrivilege::READ))) {
-        continue;
-      }
-#endif
-
-      frame[self_.common_.edge_symbol] = edge;
-      pull_node(edge, EdgeAtom::Direction::IN);
-      return true;
-    }
-
-    // attempt to get a value from the outgoing edges
-    if (out_edges_ && *out_edges_it_ != out_edges_->end()) {
-      auto edge = *(*out_edges_it_)++;
-      // when expanding in EdgeAtom::Direction::BOTH directions
-      // we should do only one expansion for cycles, and it was
-      // already done in the block above
-      if (self_.common_.direction == EdgeAtom::Direction::BOTH && edge.IsCycle()) continue;
-#ifdef MG_ENTERPRISE
-      if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
-          !(context.auth_checker->Has(edge, memgraph::query::AuthQuery::FineGrainedPrivilege::READ) &&
-            context.auth_checker->Has(edge.To(), self_.view_,
-                                      memgraph::query::AuthQuery::FineGrainedPrivilege::READ))) {
-        continue;
-      }
-#endif
-      frame[self_.common_.edge_symbol] = edge;
-      pull_node(edge, EdgeAtom::Direction::OUT);
+    if (auto next = NextEdge(context)) {
+      SetEdge(frame, next->first, next->second);
       return true;
     }
 
@@ -773,6 +1190,34 @@ bool Expand::ExpandCursor::Pull(Frame &frame, ExecutionContext &context) {
   }
 }
 
+bool Expand::ExpandCursor::PullBatch(FrameBatch &batch, ExecutionContext &context) {
+  SCOPED_PROFILE_OP("Expand");
+
+  if (MustAbort(context)) throw HintedAbortError();
+
+  if (!input_batch_) {
+    input_batch_.emplace(batch.base(), batch.capacity());
+    input_symbols_ = self_.input_->ModifiedSymbols(context.symbol_table);
+  }
+  batch.Clear();
+  while (!batch.full()) {
+    // The edges are expanded from the input row which was taken last.
+    if (input_row_ > 0) {
+      if (auto next = NextEdge(context)) {
+        auto &row = batch.Append((*input_batch_)[input_row_ - 1], input_symbols_);
+        SetEdge(row, next->first, next->second);
+        continue;
+      }
+    }
+    if (input_row_ == input_batch_->size()) {
+      if (!input_cursor_->PullBatch(*input_batch_, context)) break;
+      input_row_ = 0;
+    }
+    ExpandVertex((*input_batch_)[input_row_++]);
+  }
+  return !batch.empty();
+}
+
 void Expand::ExpandCursor::Shutdown() { input_cursor_->Shutdown(); }
 
 void Expand::ExpandCursor::Reset() {
@@ -781,6 +1226,60 @@ void Expand::ExpandCursor::Reset() {
   in_edges_it_ = std::nullopt;
   out_edges_ = std::nullopt;
   out_edges_it_ = std::nullopt;
+  input_batch_ = std::nullopt;
+  input_row_ = 0;
+}
+
+std::optional<std::pair<EdgeAccessor, EdgeAtom::Direction>> Expand::ExpandCursor::NextEdge(
+    [[maybe_unused]] const ExecutionContext &context) {
+  // attempt to get a value from the incoming edges
+  while (in_edges_ && *in_edges_it_ != in_edges_->end()) {
+    auto edge = *(*in_edges_it_)++;
+#ifdef MG_ENTERPRISE
+    if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
+        !(context.auth_checker->Has(edge, memgraph::query::AuthQuery::FineGrainedPrivilege::READ) &&
+          context.auth_checker->Has(edge.From(), self_.view_,
+                                    memgraph::query::AuthQuery::FineGrainedPrivilege::READ))) {
+      continue;
+    }
+#endif
+    return std::make_pair(edge, EdgeAtom::Direction::IN);
+  }
+
+  // attempt to get a value from the outgoing edges
+  while (out_edges_ && *out_edges_it_ != out_edges_->end()) {
+    auto edge = *(*out_edges_it_)++;
+    // when expanding in EdgeAtom::Direction::BOTH directions
+    // we should do only one expansion for cycles, and it was
+    // already done in the block above
+    if (self_.common_.direction == EdgeAtom::Direction::BOTH && edge.IsCycle()) continue;
+#ifdef MG_ENTERPRISE
+    if (license::global_license_checker.IsEnterpriseValidFast() && context.auth_checker &&
+        !(context.auth_checker->Has(edge, memgraph::query::AuthQuery::FineGrainedPrivilege::READ) &&
+          context.auth_checker->Has(edge.To(), self_.view_,
+                                    memgraph::query::AuthQuery::FineGrainedPrivilege::READ))) {
+      continue;
+    }
+#endif
+    return std::make_pair(edge, EdgeAtom::Direction::OUT);
+  }
+  return std::nullopt;
+}
+
+// Places the edge and the node it leads to on the frame.
+void Expand::ExpandCursor::SetEdge(Frame &frame, const EdgeAccessor &edge, EdgeAtom::Direction direction) const {
+  frame[self_.common_.edge_symbol] = edge;
+  if (self_.common_.existing_node) return;
+  switch (direction) {
+    case EdgeAtom::Direction::IN:
+      frame[self_.common_.node_symbol] = edge.From();
+      break;
+    case EdgeAtom::Direction::OUT:
+      frame[self_.common_.node_symbol] = edge.To();
+      break;
+    case EdgeAtom::Direction::BOTH:
+      LOG_FATAL("Must indicate exact expansion direction here");
+  }
 }
 
 bool Expand::ExpandCursor::InitEdges(Frame &frame, ExecutionContext &context) {
@@ -788,51 +1287,57 @@ bool Expand::ExpandCursor::InitEdges(Frame &frame, ExecutionContext &context) {
   // those cases we skip that input pull and continue with the next.
   while (true) {
     if (!input_cursor_->Pull(frame, context)) return false;
-    TypedValue &vertex_value = frame[self_.input_symbol_];
-
-    // Null check due to possible failed optional match.
-    if (vertex_value.IsNull()) continue;
-
-    ExpectType(self_.input_symbol_, vertex_value, TypedValue::Type::Vertex);
-    auto &vertex = vertex_value.ValueVertex();
-
-    auto direction = self_.common_.direction;
-    if (direction == EdgeAtom::Direction::IN || direction == EdgeAtom::Direction::BOTH) {
-      if (self_.common_.existing_node) {
-        TypedValue &existing_node = frame[self_.common_.node_symbol];
-        // old_node_value may be Null when using optional matching
-        if (!existing_node.IsNull()) {
-          ExpectType(self_.common_.node_symbol, existing_node, TypedValue::Type::Vertex);
-          in_edges_.emplace(
-              UnwrapEdgesResult(vertex.InEdges(self_.view_, self_.common_.edge_types, existing_node.ValueVertex())));
-        }
-      } else {
-        in_edges_.emplace(UnwrapEdgesResult(vertex.InEdges(self_.view_, self_.common_.edge_types)));
-      }
-      if (in_edges_) {
-        in_edges_it_.emplace(in_edges_->begin());
+    if (ExpandVertex(frame)) return true;
+  }
+}
+
+// Initializes the edges of the input vertex on the frame. Returns false if the
+// vertex is null.
+bool Expand::ExpandCursor::ExpandVertex(Frame &frame) {
+  TypedValue &vertex_value = frame[self_.input_symbol_];
+
+  // Null check due to possible failed optional match.
+  if (vertex_value.IsNull()) return false;
+
+  ExpectType(self_.input_symbol_, vertex_value, TypedValue::Type::Vertex);
+  auto &vertex = vertex_value.ValueVertex();
+
+  auto direction = self_.common_.direction;
+  if (direction == EdgeAtom::Direction::IN || direction == EdgeAtom::Direction::BOTH) {
+    if (self_.common_.existing_node) {
+      TypedValue &existing_node = frame[self_.common_.node_symbol];
+      // old_node_value may be Null when using optional matching
+      if (!existing_node.IsNull()) {
+        ExpectType(self_.common_.node_symbol, existing_node, TypedValue::Type::Vertex);
+        in_edges_.emplace(
+            UnwrapEdgesResult(vertex.InEdges(self_.view_, self_.common_.edge_types, existing_node.ValueVertex())));
       }
+    } else {
+      in_edges_.emplace(UnwrapEdgesResult(vertex.InEdges(self_.view_, self_.common_.edge_types)));
+    }
+    if (in_edges_) {
+      in_edges_it_.emplace(in_edges_->begin());
     }
+  }
 
-    if (direction == EdgeAtom::Direction::OUT || direction == EdgeAtom::Direction::BOTH) {
-      if (self_.common_.existing_node) {
-        TypedValue &existing_node = frame[self_.common_.node_symbol];
-        // old_node_value may be Null when using optional matching
-        if (!existing_node.IsNull()) {
-          ExpectType(self_.common_.node_symbol, existing_node, TypedValue::Type::Vertex);
-          out_edges_.emplace(
-              UnwrapEdgesResult(vertex.OutEdges(self_.view_, self_.common_.edge_types, existing_node.ValueVertex())));
-        }
-      } else {
-        out_edges_.emplace(UnwrapEdgesResult(vertex.OutEdges(self_.view_, self_.common_.edge_types)));
-      }
-      if (out_edges_) {
-        out_edges_it_.emplace(out_edges_->begin());
+  if (direction == EdgeAtom::Direction::OUT || direction == EdgeAtom::Direction::BOTH) {
+    if (self_.common_.existing_node) {
+      TypedValue &existing_node = frame[self_.common_.node_symbol];
+      // old_node_value may be Null when using optional matching
+      if (!existing_node.IsNull()) {
+        ExpectType(self_.common_.node_symbol, existing_node, TypedValue::Type::Vertex);
+        out_edges_.emplace(
+            UnwrapEdgesResult(vertex.OutEdges(self_.view_, self_.common_.edge_types, existing_node.ValueVertex())));
       }
+    } else {
+      out_edges_.emplace(UnwrapEdgesResult(vertex.OutEdges(self_.view_, self_.common_.edge_types)));
+    }
+    if (out_edges_) {
+      out_edges_it_.emplace(out_edges_->begin());
     }
-
-    return true;
   }
+
+  return true;
 }
 
 ExpandVariable::ExpandVariable(const std::shared_ptr<LogicalOperator> &input, Symbol input_symbol, Symbol node_symbol,
@@ -2275,8 +2780,31 @@ bool Filter::FilterCursor::Pull(Frame &frame, ExecutionContext &context) {
   // nodes and edges.
   ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
                                 storage::View::OLD);
+  if (!compiled_expression_) compiled_expression_ = FindCompiledExpression(context, self_.expression_);
+  const auto *compiled = *compiled_expression_;
   while (input_cursor_->Pull(frame, context)) {
-    if (EvaluateFilter(evaluator, self_.expression_)) return true;
+    if (compiled ? compiled->EvaluateFilter(&evaluator) : EvaluateFilter(evaluator, self_.expression_)) return true;
+  }
+  return false;
+}
+
+bool Filter::FilterCursor::PullBatch(FrameBatch &batch, ExecutionContext &context) {
+  SCOPED_PROFILE_OP("Filter");
+
+  if (!compiled_expression_) compiled_expression_ = FindCompiledExpression(context, self_.expression_);
+  const auto *compiled = *compiled_expression_;
+  while (input_cursor_->PullBatch(batch, context)) {
+    // The rows that pass the filter are moved to the front of the batch.
+    size_t passed = 0;
+    for (size_t row = 0; row < batch.size(); ++row) {
+      ExpressionEvaluator evaluator(&batch[row], context.symbol_table, context.evaluation_context, context.db_accessor,
+                                    storage::View::OLD);
+      if (compiled ? compiled->EvaluateFilter(&evaluator) : EvaluateFilter(evaluator, self_.expression_)) {
+        batch.SwapRows(passed++, row);
+      }
+    }
+    batch.Truncate(passed);
+    if (!batch.empty()) return true;
   }
   return false;
 }
@@ -2313,16 +2841,40 @@ bool Produce::ProduceCursor::Pull(Frame &frame, ExecutionContext &context) {
   SCOPED_PROFILE_OP("Produce");
 
   if (input_cursor_->Pull(frame, context)) {
-    // Produce should always yield the latest results.
-    ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
-                                  storage::View::NEW);
-    for (auto named_expr : self_.named_expressions_) named_expr->Accept(evaluator);
-
+    EvaluateNamedExpressions(frame, context);
     return true;
   }
   return false;
 }
 
+bool Produce::ProduceCursor::PullBatch(FrameBatch &batch, ExecutionContext &context) {
+  SCOPED_PROFILE_OP("Produce");
+
+  if (!input_cursor_->PullBatch(batch, context)) return false;
+  for (size_t row = 0; row < batch.size(); ++row) EvaluateNamedExpressions(batch[row], context);
+  return true;
+}
+
+void Produce::ProduceCursor::EvaluateNamedExpressions(Frame &frame, ExecutionContext &context) {
+  if (!compiled_expressions_) {
+    auto &compiled_expressions = compiled_expressions_.emplace();
+    compiled_expressions.reserve(self_.named_expressions_.size());
+    for (auto *named_expr : self_.named_expressions_) {
+      compiled_expressions.push_back(FindCompiledExpression(context, named_expr));
+    }
+  }
+  // Produce should always yield the latest results.
+  ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
+                                storage::View::NEW);
+  for (size_t i = 0; i < self_.named_expressions_.size(); ++i) {
+    if (const auto *compiled = (*compiled_expressions_)[i]) {
+      compiled->Evaluate(&evaluator);
+    } else {
+      self_.named_expressions_[i]->Accept(evaluator);
+    }
+  }
+}
+
 void Produce::ProduceCursor::Shutdown() { input_cursor_->Shutdown(); }
 
 void Produce::ProduceCursor::Reset() { input_cursor_->Reset(); }
@@ -3206,11 +3758,18 @@ TypedValue DefaultAggregationOpValue(const Aggregate::Element &element, utils::M
 
 class AggregateCursor : public Cursor {
  public:
-  AggregateCursor(const Aggregate &self, utils::MemoryResource *mem)
-      : self_(self), input_cursor_(self_.input_->MakeCursor(mem)), aggregation_(mem) {}
+  AggregateCursor(const Aggregate &self, utils::MemoryResource *mem, int64_t num_workers = 1,
+                  const char *op_name = "Aggregate")
+      : self_(self),
+        input_cursor_(self_.input_->MakeCursor(mem)),
+        aggregation_(mem),
+        num_workers_(num_workers),
+        pull_batches_(CanPullBatches(*self_.input_)),
+        columnar_(utils::Downcast<const ColumnarAggregate>(&self)),
+        op_name_(op_name) {}
 
   bool Pull(Frame &frame, ExecutionContext &context) override {
-    SCOPED_PROFILE_OP("Aggregate");
+    SCOPED_PROFILE_OP(op_name_);
 
     if (!pulled_all_input_) {
       ProcessAll(&frame, &context);
@@ -3295,6 +3854,13 @@ class AggregateCursor : public Cursor {
   // this LogicalOp pulls all from the input on it's first pull
   // this switch tracks if this has been performed
   bool pulled_all_input_{false};
+  // number of threads that pull the input, see `ParallelAggregate`
+  const int64_t num_workers_;
+  // whether the input is pulled in batches, see `CanPullBatches`
+  const bool pull_batches_;
+  // set when the property columns can be aggregated, see `ColumnarAggregate`
+  const ColumnarAggregate *columnar_;
+  const char *op_name_;
 
   /**
    * Pulls from the input operator until exhausted and aggregates the
@@ -3306,10 +3872,12 @@ class AggregateCursor : public Cursor {
    * aggregation results, and not on the number of inputs.
    */
   void ProcessAll(Frame *frame, ExecutionContext *context) {
-    ExpressionEvaluator evaluator(frame, context->symbol_table, context->evaluation_context, context->db_accessor,
-                                  storage::View::NEW);
-    while (input_cursor_->Pull(*frame, *context)) {
-      ProcessOne(*frame, &evaluator);
+    if (!columnar_ || !AggregateColumns(frame, context)) {
+      if (num_workers_ > 1 && CanPullInParallel(*context)) {
+        PullAllInParallel(context);
+      } else {
+        PullAll(frame, context);
+      }
     }
 
     // calculate AVG aggregations (so far they have only been summed)
@@ -3326,6 +3894,281 @@ class AggregateCursor : public Cursor {
     }
   }
 
+  void PullAll(Frame *frame, ExecutionContext *context) {
+    // The profiling stats count the pulls, so the input is pulled row by row
+    // when profiling to keep the counts the same.
+    if (pull_batches_ && !context->is_profile_query) {
+      FrameBatch batch(*frame);
+      while (input_cursor_->PullBatch(batch, *context)) {
+        for (size_t row = 0; row < batch.size(); ++row) {
+          ExpressionEvaluator evaluator(&batch[row], context->symbol_table, context->evaluation_context,
+                                        context->db_accessor, storage::View::NEW);
+          ProcessOne(batch[row], &evaluator);
+        }
+      }
+      return;
+    }
+
+    ExpressionEvaluator evaluator(frame, context->symbol_table, context->evaluation_context, context->db_accessor,
+                                  storage::View::NEW);
+    while (input_cursor_->Pull(*frame, *context)) {
+      ProcessOne(*frame, &evaluator);
+    }
+  }
+
+  static bool CanPullInParallel(const ExecutionContext &context) {
+#ifdef MG_ENTERPRISE
+    // Fine grained access checks are done by the scan for every vertex and the
+    // checker can't be shared between the workers.
+    if (context.auth_checker) return false;
+#endif
+    return true;
+  }
+
+  /**
+   * Aggregates the summaries of the property columns instead of pulling the
+   * input. The vertices whose rows are newer than the transaction are
+   * aggregated one by one. Returns false without aggregating anything if the
+   * columns can't be used, in which case the input has to be pulled.
+   */
+  bool AggregateColumns(Frame *frame, ExecutionContext *context) {
+#ifdef MG_ENTERPRISE
+    // Fine grained access checks are done by the scan for every vertex.
+    if (context->auth_checker) return false;
+#endif
+    const auto &scan = *utils::Downcast<const ScanAllByLabel>(self_.input_.get());
+    auto result = context->db_accessor->ScanPropertyColumns(scan.view_, columnar_->label_, columnar_->properties_);
+    if (!result) return false;
+
+    // The summaries of the values which would raise an error or whose result
+    // depends on the order of the values are left to the regular aggregation.
+    auto summary_it = result->summaries.begin();
+    for (const auto &element : self_.aggregations_) {
+      if (!element.value) continue;
+      const auto &summary = *summary_it++;
+      const auto numeric_count = summary.int_count + summary.double_count;
+      switch (element.op) {
+        case Aggregation::Op::SUM:
+        case Aggregation::Op::AVG:
+          if (summary.string_count > 0 || summary.other_count > 0) return false;
+          break;
+        case Aggregation::Op::MIN:
+        case Aggregation::Op::MAX:
+          if (summary.other_count > 0 || (numeric_count > 0 && summary.string_count > 0)) return false;
+          break;
+        case Aggregation::Op::COUNT:
+        case Aggregation::Op::COLLECT_LIST:
+        case Aggregation::Op::COLLECT_MAP:
+        case Aggregation::Op::PROJECT:
+          break;
+      }
+    }
+
+    auto *mem = aggregation_.get_allocator().GetMemoryResource();
+    if (result->count > 0) {
+      auto &agg_value = aggregation_.try_emplace(utils::pmr::vector<TypedValue>(mem), mem).first->second;
+      EnsureInitialized(*frame, &agg_value);
+      summary_it = result->summaries.begin();
+      for (size_t pos = 0; pos < self_.aggregations_.size(); ++pos) {
+        const auto &element = self_.aggregations_[pos];
+        if (!element.value) {
+          agg_value.counts_[pos] = static_cast<int64_t>(result->count);
+          agg_value.values_[pos] = TypedValue(agg_value.counts_[pos], mem);
+          continue;
+        }
+        const auto &summary = *summary_it++;
+        agg_value.counts_[pos] = static_cast<int64_t>(summary.Count());
+        if (agg_value.counts_[pos] == 0) continue;
+        agg_value.values_[pos] = SummaryValue(element.op, summary, agg_value.counts_[pos], mem);
+      }
+    }
+
+    ExpressionEvaluator evaluator(frame, context->symbol_table, context->evaluation_context, context->db_accessor,
+                                  storage::View::NEW);
+    for (const auto &vertex : result->vertices) {
+      (*frame)[scan.output_symbol_] = TypedValue(VertexAccessor(vertex), context->evaluation_context.memory);
+      ProcessOne(*frame, &evaluator);
+    }
+    return true;
+  }
+
+  /** Returns the value of a COUNT, SUM, MIN or MAX aggregation of the
+   * summarized values, or the sum in case of AVG. */
+  static TypedValue SummaryValue(Aggregation::Op op, const storage::PropertyColumnSummary &summary, int64_t count,
+                                 utils::MemoryResource *mem) {
+    switch (op) {
+      case Aggregation::Op::COUNT:
+        return TypedValue(count, mem);
+      case Aggregation::Op::SUM:
+      case Aggregation::Op::AVG:
+        if (summary.double_count == 0) return TypedValue(summary.int_sum, mem);
+        return TypedValue(static_cast<double>(summary.int_sum) + summary.double_sum, mem);
+      case Aggregation::Op::MIN:
+        if (summary.string_count > 0) return TypedValue(summary.string_min, mem);
+        if (summary.double_count == 0 ||
+            (summary.int_count > 0 && static_cast<double>(summary.int_min) <= summary.double_min)) {
+          return TypedValue(summary.int_min, mem);
+        }
+        return TypedValue(summary.double_min, mem);
+      case Aggregation::Op::MAX:
+        if (summary.string_count > 0) return TypedValue(summary.string_max, mem);
+        if (summary.double_count == 0 ||
+            (summary.int_count > 0 && static_cast<double>(summary.int_max) >= summary.double_max)) {
+          return TypedValue(summary.int_max, mem);
+        }
+        return TypedValue(summary.double_max, mem);
+      case Aggregation::Op::COLLECT_LIST:
+      case Aggregation::Op::COLLECT_MAP:
+      case Aggregation::Op::PROJECT:
+        break;
+    }
+    LOG_FATAL("{} can't be computed from property columns!", Aggregation::OpToString(op));
+  }
+
+  /**
+   * Pulls the input on `num_workers_` threads, including the calling one.
+   * Every worker runs its own copy of the input pipeline and aggregates into
+   * its own partial result. The partial results are merged into
+   * `aggregation_` once all workers are done.
+   */
+  void PullAllInParallel(ExecutionContext *context) {
+    // The worker's memory has to outlive the cursor that allocates from it.
+    struct Worker {
+      utils::PoolResource memory{128, 1024};
+      ExecutionContext context;
+      std::optional<AggregateCursor> partial;
+      std::exception_ptr exception;
+    };
+
+    VertexMorsels morsels(
+        ChunkVertices(FindScan(*self_.input_), context->db_accessor, num_workers_ * VertexMorsels::kChunksPerWorker),
+        context);
+    std::vector<std::unique_ptr<Worker>> workers;
+    workers.reserve(num_workers_);
+    for (int64_t i = 0; i < num_workers_; ++i) {
+      auto &worker = workers.emplace_back(std::make_unique<Worker>());
+      worker->context.db_accessor = context->db_accessor;
+      worker->context.symbol_table = context->symbol_table;
+      worker->context.evaluation_context = context->evaluation_context;
+      worker->context.evaluation_context.memory = &worker->memory;
+      worker->context.is_shutting_down = context->is_shutting_down;
+      worker->context.is_profile_query = context->is_profile_query;
+      worker->context.vertex_morsels = &morsels;
+      worker->context.compiled_expressions = context->compiled_expressions;
+      worker->partial.emplace(self_, &worker->memory);
+    }
+
+    auto run = [&morsels, frame_size = context->symbol_table.max_position()](Worker *worker) {
+      try {
+        Frame frame(frame_size, &worker->memory);
+        worker->partial->PullAll(&frame, &worker->context);
+      } catch (...) {
+        worker->exception = std::current_exception();
+        morsels.Stop();
+      }
+    };
+    std::latch done(num_workers_ - 1);
+    for (int64_t i = 1; i < num_workers_; ++i) {
+      ParallelWorkerPool().AddTask([&run, &done, worker = workers[i].get()] {
+        run(worker);
+        done.count_down();
+      });
+    }
+    run(workers[0].get());
+    done.wait();
+
+    for (const auto &worker : workers) {
+      if (worker->exception) std::rethrow_exception(worker->exception);
+    }
+    for (const auto &worker : workers) {
+      MergePartial(*worker->partial);
+      if (context->is_profile_query && worker->context.stats.name) {
+        MergeWorkerStats(context->stats_root, worker->context.stats, num_workers_);
+      }
+    }
+  }
+
+  /** Finds the scan at the start of the input pipeline. */
+  static const ScanAll &FindScan(const LogicalOperator &input) {
+    const auto *op = &input;
+    while (!utils::IsSubtype(*op, ScanAll::kType)) {
+      MG_ASSERT(op->HasSingleInput(), "Expected a scan at the start of the ParallelAggregate input!");
+      op = op->input().get();
+    }
+    return *utils::Downcast<const ScanAll>(op);
+  }
+
+  static storage::VertexChunks ChunkVertices(const ScanAll &scan, DbAccessor *db, uint64_t num_chunks) {
+    if (scan.GetTypeInfo() == ScanAllByLabel::kType) {
+      return db->ChunkVertices(scan.view_, static_cast<const ScanAllByLabel &>(scan).label_, num_chunks);
+    }
+    MG_ASSERT(scan.GetTypeInfo() == ScanAll::kType, "Unexpected scan {} in the ParallelAggregate input!",
+              scan.GetTypeInfo().name);
+    return db->ChunkVertices(scan.view_, num_chunks);
+  }
+
+  /** Merges the partial result of a worker into `aggregation_`. AVG
+   * aggregations are merged as sums. */
+  void MergePartial(const AggregateCursor &partial) {
+    auto *mem = aggregation_.get_allocator().GetMemoryResource();
+    for (const auto &[group_by, partial_value] : partial.aggregation_) {
+      auto &agg_value = aggregation_.try_emplace(utils::pmr::vector<TypedValue>(group_by, mem), mem).first->second;
+      if (agg_value.values_.empty()) {
+        // The group wasn't seen by the other workers so far.
+        agg_value.counts_.assign(partial_value.counts_.begin(), partial_value.counts_.end());
+        agg_value.values_.assign(partial_value.values_.begin(), partial_value.values_.end());
+        agg_value.remember_.assign(partial_value.remember_.begin(), partial_value.remember_.end());
+        for (size_t i = 0; i < self_.aggregations_.size(); ++i) {
+          agg_value.unique_values_.emplace_back(AggregationValue::TSet(mem));
+        }
+        continue;
+      }
+
+      for (size_t pos = 0; pos < self_.aggregations_.size(); ++pos) {
+        const auto partial_count = partial_value.counts_[pos];
+        if (partial_count == 0) continue;
+        const auto &partial_agg_value = partial_value.values_[pos];
+        auto &value = agg_value.values_[pos];
+        auto &count = agg_value.counts_[pos];
+        if (count == 0) {
+          value = partial_agg_value;
+          count = partial_count;
+          continue;
+        }
+        count += partial_count;
+        switch (self_.aggregations_[pos].op) {
+          case Aggregation::Op::COUNT:
+            value = count;
+            break;
+          case Aggregation::Op::MIN:
+            try {
+              if ((partial_agg_value < value).ValueBool()) value = partial_agg_value;
+            } catch (const TypedValueException &) {
+              throw QueryRuntimeException("Unable to get MIN of '{}' and '{}'.", partial_agg_value.type(),
+                                          value.type());
+            }
+            break;
+          case Aggregation::Op::MAX:
+            try {
+              if ((partial_agg_value > value).ValueBool()) value = partial_agg_value;
+            } catch (const TypedValueException &) {
+              throw QueryRuntimeException("Unable to get MAX of '{}' and '{}'.", partial_agg_value.type(),
+                                          value.type());
+            }
+            break;
+          case Aggregation::Op::AVG:
+          case Aggregation::Op::SUM:
+            value = value + partial_agg_value;
+            break;
+          case Aggregation::Op::COLLECT_LIST:
+          case Aggregation::Op::COLLECT_MAP:
+          case Aggregation::Op::PROJECT:
+            LOG_FATAL("Partial results of {} can't be merged!", Aggregation::OpToString(self_.aggregations_[pos].op));
+        }
+      }
+    }
+  }
+
   /**
    * Performs a single accumulation.
    */
@@ -3527,6 +4370,36 @@ UniqueCursorPtr Aggregate::MakeCursor(utils::MemoryResource *mem) const {
   return MakeUniqueCursorPtr<AggregateCursor>(mem, *this, mem);
 }
 
+ParallelAggregate::ParallelAggregate(const std::shared_ptr<LogicalOperator> &input,
+                                     const std::vector<Aggregate::Element> &aggregations,
+                                     const std::vector<Expression *> &group_by, const std::vector<Symbol> &remember,
+                                     int64_t num_workers)
+    : Aggregate(input, aggregations, group_by, remember), num_workers_(num_workers) {
+  MG_ASSERT(num_workers_ >= 1, "ParallelAggregate needs at least one worker!");
+}
+
+ACCEPT_WITH_INPUT(ParallelAggregate)
+
+UniqueCursorPtr ParallelAggregate::MakeCursor(utils::MemoryResource *mem) const {
+  EventCounter::IncrementCounter(EventCounter::ParallelAggregateOperator);
+
+  return MakeUniqueCursorPtr<AggregateCursor>(mem, *this, mem, num_workers_, "ParallelAggregate");
+}
+
+ColumnarAggregate::ColumnarAggregate(const std::shared_ptr<LogicalOperator> &input,
+                                     const std::vector<Aggregate::Element> &aggregations,
+                                     const std::vector<Symbol> &remember, storage::LabelId label,
+                                     const std::vector<storage::PropertyId> &properties)
+    : Aggregate(input, aggregations, {}, remember), label_(label), properties_(properties) {}
+
+ACCEPT_WITH_INPUT(ColumnarAggregate)
+
+UniqueCursorPtr ColumnarAggregate::MakeCursor(utils::MemoryResource *mem) const {
+  EventCounter::IncrementCounter(EventCounter::ColumnarAggregateOperator);
+
+  return MakeUniqueCursorPtr<AggregateCursor>(mem, *this, mem, 1, "ColumnarAggregate");
+}
+
 Skip::Skip(const std::shared_ptr<LogicalOperator> &input, Expression *expression)
     : input_(input), expression_(expression) {}
 
@@ -3658,63 +4531,68 @@ std::vector<Symbol> OrderBy::OutputSymbols(const SymbolTable &symbol_table) cons
 
 std::vector<Symbol> OrderBy::ModifiedSymbols(const SymbolTable &table) const { return input_->ModifiedSymbols(table); }
 
+/**
+ * The cursor of `OrderBy` and `TopK`.
+ *
+ * `OrderBy` caches all of the input rows and sorts them. When the cached rows
+ * exceed `FLAGS_query_order_by_memory_limit_mb`, they are sorted and spilled
+ * to a file as a sorted run, and the runs are merged once the input is
+ * exhausted. Rows which hold graph elements can't be spilled, so spilling
+ * stops at the first such row.
+ *
+ * `TopK` only keeps the first rows in the order, in a heap whose top is the
+ * last of the kept rows. If the kept rows exceed the memory limit, all of the
+ * following rows are sorted like with `OrderBy`.
+ */
 class OrderByCursor : public Cursor {
  public:
   OrderByCursor(const OrderBy &self, utils::MemoryResource *mem)
-      : self_(self), input_cursor_(self_.input_->MakeCursor(mem)), cache_(mem) {}
+      : self_(self),
+        input_cursor_(self_.input_->MakeCursor(mem)),
+        top_k_(utils::Downcast<const TopK>(&self)),
+        op_name_(top_k_ ? "TopK" : "OrderBy"),
+        memory_limit_(FLAGS_query_order_by_memory_limit_mb * 1024 * 1024),
+        cache_(&rows_memory_) {}
 
   bool Pull(Frame &frame, ExecutionContext &context) override {
-    SCOPED_PROFILE_OP("OrderBy");
+    SCOPED_PROFILE_OP(op_name_);
 
     if (!did_pull_all_) {
-      ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
-                                    storage::View::OLD);
-      auto *mem = cache_.get_allocator().GetMemoryResource();
-      while (input_cursor_->Pull(frame, context)) {
-        // collect the order_by elements
-        utils::pmr::vector<TypedValue> order_by(mem);
-        order_by.reserve(self_.order_by_.size());
-        for (auto expression_ptr : self_.order_by_) {
-          order_by.emplace_back(expression_ptr->Accept(evaluator));
-        }
-
-        // collect the output elements
-        utils::pmr::vector<TypedValue> output(mem);
-        output.reserve(self_.output_symbols_.size());
-        for (const Symbol &output_sym : self_.output_symbols_) output.emplace_back(frame[output_sym]);
-
-        cache_.push_back(Element{std::move(order_by), std::move(output)});
-      }
-
-      std::sort(cache_.begin(), cache_.end(), [this](const auto &pair1, const auto &pair2) {
-        return self_.compare_(pair1.order_by, pair2.order_by);
-      });
-
+      PullAll(frame, context);
       did_pull_all_ = true;
-      cache_it_ = cache_.begin();
     }
 
-    if (cache_it_ == cache_.end()) return false;
+    if (runs_.empty() ? cache_it_ == cache_.end() : merge_heap_.empty()) return false;
 
     if (MustAbort(context)) throw HintedAbortError();
 
     // place the output values on the frame
-    DMG_ASSERT(self_.output_symbols_.size() == cache_it_->remember.size(),
+    const auto merged_run = runs_.empty() ? kCacheRun : PopMergedRun();
+    const auto &element = Head(merged_run);
+    DMG_ASSERT(self_.output_symbols_.size() == element.remember.size(),
                "Number of values does not match the number of output symbols "
                "in OrderBy");
     auto output_sym_it = self_.output_symbols_.begin();
-    for (const TypedValue &output : cache_it_->remember) frame[*output_sym_it++] = output;
+    for (const TypedValue &output : element.remember) frame[*output_sym_it++] = output;
 
-    cache_it_++;
+    if (runs_.empty()) {
+      cache_it_++;
+    } else if (Advance(merged_run)) {
+      merge_heap_.push_back(merged_run);
+      std::push_heap(merge_heap_.begin(), merge_heap_.end(), MergeCompare());
+    }
     return true;
   }
+
   void Shutdown() override { input_cursor_->Shutdown(); }
 
   void Reset() override {
     input_cursor_->Reset();
     did_pull_all_ = false;
-    cache_.clear();
-    cache_it_ = cache_.begin();
+    ClearCache();
+    runs_.clear();
+    merge_heap_.clear();
+    can_spill_ = true;
   }
 
  private:
@@ -3723,14 +4601,192 @@ class OrderByCursor : public Cursor {
     utils::pmr::vector<TypedValue> remember;
   };
 
+  // A sorted run of rows which was spilled to a file. The rows are read back
+  // one by one while the runs are merged.
+  struct SpilledRun {
+    SpillFile file;
+    // number of rows which weren't read yet
+    size_t rows_left{0};
+    // the row which was read last
+    Element head{utils::pmr::vector<TypedValue>(utils::NewDeleteResource()),
+                 utils::pmr::vector<TypedValue>(utils::NewDeleteResource())};
+  };
+
+  // The index of the cached rows among the merged runs.
+  static constexpr size_t kCacheRun = std::numeric_limits<size_t>::max();
+
   const OrderBy &self_;
   const UniqueCursorPtr input_cursor_;
+  const TopK *top_k_;
+  const char *op_name_;
+  // 0 when the rows are never spilled
+  const uint64_t memory_limit_;
   bool did_pull_all_{false};
+  // The cached rows are allocated separately, so that their memory can be
+  // released when they are spilled.
+  utils::PoolResource rows_memory_{128, 1024};
   // a cache of elements pulled from the input
   // the cache is filled and sorted (only on first elem) on first Pull
   utils::pmr::vector<Element> cache_;
   // iterator over the cache_, maintains state between Pulls
   decltype(cache_.begin()) cache_it_ = cache_.begin();
+  // estimated memory of the cached rows, only counted with a memory limit
+  size_t cache_memory_{0};
+  // whether all of the cached rows can be spilled
+  bool can_spill_{true};
+  std::vector<std::unique_ptr<SpilledRun>> runs_;
+  // Heap of the runs which still have rows, ordered by their heads. The top
+  // of the heap is the run with the first row.
+  std::vector<size_t> merge_heap_;
+
+  bool IsBefore(const Element &element1, const Element &element2) const {
+    return self_.compare_(element1.order_by, element2.order_by);
+  }
+
+  // Compares the runs in the merge heap, whose top is the run with the first
+  // row.
+  auto MergeCompare() const {
+    return [this](size_t run1, size_t run2) { return IsBefore(Head(run2), Head(run1)); };
+  }
+
+  static size_t EstimateMemoryUsage(const Element &element) {
+    size_t size = sizeof(Element);
+    for (const auto &value : element.order_by) size += plan::EstimateMemoryUsage(value);
+    for (const auto &value : element.remember) size += plan::EstimateMemoryUsage(value);
+    return size;
+  }
+
+  void PullAll(Frame &frame, ExecutionContext &context) {
+    ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
+                                  storage::View::OLD);
+    auto top_k_rows = top_k_ ? TopKRows(&evaluator) : std::nullopt;
+    auto *mem = cache_.get_allocator().GetMemoryResource();
+    auto is_before = [this](const Element &element1, const Element &element2) { return IsBefore(element1, element2); };
+    while (input_cursor_->Pull(frame, context)) {
+      // collect the order_by elements
+      utils::pmr::vector<TypedValue> order_by(mem);
+      order_by.reserve(self_.order_by_.size());
+      for (auto expression_ptr : self_.order_by_) {
+        order_by.emplace_back(expression_ptr->Accept(evaluator));
+      }
+
+      // Rows which come after all of the kept rows are skipped without
+      // collecting their output.
+      if (top_k_rows && cache_.size() == *top_k_rows &&
+          (*top_k_rows == 0 || !self_.compare_(order_by, cache_.front().order_by))) {
+        continue;
+      }
+
+      // collect the output elements
+      utils::pmr::vector<TypedValue> output(mem);
+      output.reserve(self_.output_symbols_.size());
+      for (const Symbol &output_sym : self_.output_symbols_) output.emplace_back(frame[output_sym]);
+
+      Element element{std::move(order_by), std::move(output)};
+      if (memory_limit_ > 0) {
+        cache_memory_ += EstimateMemoryUsage(element);
+        if (can_spill_) {
+          can_spill_ = std::all_of(element.order_by.begin(), element.order_by.end(), IsSpillable) &&
+                       std::all_of(element.remember.begin(), element.remember.end(), IsSpillable);
+        }
+      }
+      if (top_k_rows && cache_.size() == *top_k_rows) {
+        std::pop_heap(cache_.begin(), cache_.end(), is_before);
+        if (memory_limit_ > 0) cache_memory_ -= EstimateMemoryUsage(cache_.back());
+        cache_.pop_back();
+      }
+      cache_.push_back(std::move(element));
+      if (top_k_rows) std::push_heap(cache_.begin(), cache_.end(), is_before);
+
+      if (memory_limit_ == 0 || cache_memory_ <= memory_limit_) continue;
+      if (top_k_rows) {
+        // The kept rows don't fit into memory, so the following rows are
+        // sorted with the kept ones.
+        top_k_rows = std::nullopt;
+      }
+      if (can_spill_) Spill();
+    }
+
+    if (top_k_rows) {
+      std::sort_heap(cache_.begin(), cache_.end(), is_before);
+    } else {
+      std::sort(cache_.begin(), cache_.end(), is_before);
+    }
+    cache_it_ = cache_.begin();
+    if (runs_.empty()) return;
+
+    // The remaining cached rows are merged with the spilled runs.
+    for (size_t run = 0; run < runs_.size(); ++run) {
+      if (Advance(run)) merge_heap_.push_back(run);
+    }
+    if (cache_it_ != cache_.end()) merge_heap_.push_back(kCacheRun);
+    std::make_heap(merge_heap_.begin(), merge_heap_.end(), MergeCompare());
+  }
+
+  // Returns the number of rows kept by `TopK`, or `std::nullopt` if all of
+  // the rows have to be sorted because the skip or the limit isn't valid.
+  std::optional<size_t> TopKRows(ExpressionEvaluator *evaluator) const {
+    auto limit = top_k_->limit_->Accept(*evaluator);
+    if (!limit.IsInt() || limit.ValueInt() < 0) return std::nullopt;
+    int64_t skip = 0;
+    if (top_k_->skip_) {
+      auto skip_value = top_k_->skip_->Accept(*evaluator);
+      if (!skip_value.IsInt() || skip_value.ValueInt() < 0) return std::nullopt;
+      skip = skip_value.ValueInt();
+    }
+    if (limit.ValueInt() > std::numeric_limits<int64_t>::max() - skip) return std::nullopt;
+    return limit.ValueInt() + skip;
+  }
+
+  // Sorts the cached rows and writes them to a new spilled run.
+  void Spill() {
+    std::sort(cache_.begin(), cache_.end(),
+              [this](const Element &element1, const Element &element2) { return IsBefore(element1, element2); });
+    auto run = std::make_unique<SpilledRun>();
+    for (const auto &element : cache_) {
+      for (const auto &value : element.order_by) run->file.Write(value);
+      for (const auto &value : element.remember) run->file.Write(value);
+    }
+    run->file.FinishWriting();
+    run->rows_left = cache_.size();
+    runs_.push_back(std::move(run));
+    ClearCache();
+  }
+
+  void ClearCache() {
+    // The vector is swapped out to free its buffer before the memory is
+    // released.
+    utils::pmr::vector<Element>(&rows_memory_).swap(cache_);
+    rows_memory_.Release();
+    cache_it_ = cache_.begin();
+    cache_memory_ = 0;
+  }
+
+  const Element &Head(size_t run) const { return run == kCacheRun ? *cache_it_ : runs_[run]->head; }
+
+  // Moves the run with the first row out of the merge heap.
+  size_t PopMergedRun() {
+    std::pop_heap(merge_heap_.begin(), merge_heap_.end(), MergeCompare());
+    const auto run = merge_heap_.back();
+    merge_heap_.pop_back();
+    return run;
+  }
+
+  // Moves the head of the run to its next row. Returns false if there are no
+  // rows left.
+  bool Advance(size_t run) {
+    if (run == kCacheRun) return ++cache_it_ != cache_.end();
+    auto &spilled_run = *runs_[run];
+    if (spilled_run.rows_left == 0) return false;
+    --spilled_run.rows_left;
+    auto &head = spilled_run.head;
+    auto *mem = head.order_by.get_allocator().GetMemoryResource();
+    head.order_by.clear();
+    for (size_t i = 0; i < self_.order_by_.size(); ++i) head.order_by.emplace_back(spilled_run.file.Read(mem));
+    head.remember.clear();
+    for (size_t i = 0; i < self_.output_symbols_.size(); ++i) head.remember.emplace_back(spilled_run.file.Read(mem));
+    return true;
+  }
 };
 
 UniqueCursorPtr OrderBy::MakeCursor(utils::MemoryResource *mem) const {
@@ -3739,6 +4795,24 @@ UniqueCursorPtr OrderBy::MakeCursor(utils::MemoryResource *mem) const {
   return MakeUniqueCursorPtr<OrderByCursor>(mem, *this, mem);
 }
 
+TopK::TopK(const std::shared_ptr<LogicalOperator> &input, const TypedValueVectorCompare &compare,
+           const std::vector<Expression *> &order_by, const std::vector<Symbol> &output_symbols, Expression *limit,
+           Expression *skip)
+    : limit_(limit), skip_(skip) {
+  input_ = input;
+  compare_ = compare;
+  order_by_ = order_by;
+  output_symbols_ = output_symbols;
+}
+
+ACCEPT_WITH_INPUT(TopK)
+
+UniqueCursorPtr TopK::MakeCursor(utils::MemoryResource *mem) const {
+  EventCounter::IncrementCounter(EventCounter::TopKOperator);
+
+  return MakeUniqueCursorPtr<OrderByCursor>(mem, *this, mem);
+}
+
 Merge::Merge(const std::shared_ptr<LogicalOperator> &input, const std::shared_ptr<LogicalOperator> &merge_match,
              const std::shared_ptr<LogicalOperator> &merge_create)
     : input_(input ? input : std::make_shared<Once>()), merge_match_(merge_match), merge_create_(merge_create) {}
@@ -4193,6 +5267,188 @@ UniqueCursorPtr Cartesian::MakeCursor(utils::MemoryResource *mem) const {
   return MakeUniqueCursorPtr<CartesianCursor>(mem, *this, mem);
 }
 
+std::vector<Symbol> HashJoin::ModifiedSymbols(const SymbolTable &table) const {
+  auto symbols = left_op_->ModifiedSymbols(table);
+  auto right = right_op_->ModifiedSymbols(table);
+  symbols.insert(symbols.end(), right.begin(), right.end());
+  return symbols;
+}
+
+bool HashJoin::Accept(HierarchicalLogicalOperatorVisitor &visitor) {
+  if (visitor.PreVisit(*this)) {
+    left_op_->Accept(visitor) && right_op_->Accept(visitor);
+  }
+  return visitor.PostVisit(*this);
+}
+
+WITHOUT_SINGLE_INPUT(HashJoin);
+
+namespace {
+
+class HashJoinCursor : public Cursor {
+ public:
+  HashJoinCursor(const HashJoin &self, utils::MemoryResource *mem)
+      : self_(self),
+        left_(self.left_op_->MakeCursor(mem), self.left_symbols_, self.left_keys_, mem),
+        right_(self.right_op_->MakeCursor(mem), self.right_symbols_, self.right_keys_, mem),
+        table_(mem) {
+    MG_ASSERT(left_.cursor != nullptr, "HashJoinCursor: Missing left operator cursor.");
+    MG_ASSERT(right_.cursor != nullptr, "HashJoinCursor: Missing right operator cursor.");
+    MG_ASSERT(self.left_keys_.size() == self.right_keys_.size() && !self.left_keys_.empty(),
+              "HashJoinCursor: Expected the same number of left and right keys.");
+  }
+
+  bool Pull(Frame &frame, ExecutionContext &context) override {
+    SCOPED_PROFILE_OP("HashJoin");
+
+    if (!build_) Build(frame, context);
+    // Nothing can be joined with an empty branch.
+    if (table_.empty()) return false;
+
+    while (true) {
+      if (MustAbort(context)) throw HintedAbortError();
+      if (matches_ && match_index_ < matches_->size()) {
+        build_->Restore(frame, (*matches_)[match_index_++]);
+        return true;
+      }
+      if (!NextProbeRow(frame, context)) return false;
+    }
+  }
+
+  void Shutdown() override {
+    left_.cursor->Shutdown();
+    right_.cursor->Shutdown();
+  }
+
+  void Reset() override {
+    left_.Reset();
+    right_.Reset();
+    table_.clear();
+    build_ = nullptr;
+    probe_ = nullptr;
+    next_probe_row_ = 0;
+    matches_ = nullptr;
+    match_index_ = 0;
+  }
+
+ private:
+  // Rows pulled from one of the branches. Only the values of the key
+  // expressions and of the symbols modified by the branch are kept.
+  struct Branch {
+    Branch(UniqueCursorPtr cursor, const std::vector<Symbol> &symbols, const std::vector<Expression *> &key_exprs,
+           utils::MemoryResource *mem)
+        : cursor(std::move(cursor)), symbols(symbols), key_exprs(key_exprs), keys(mem), values(mem) {}
+
+    // Pulls the next row whose keys aren't null. Rows with a null key can't be
+    // joined with any row, so they are skipped. Returns false when the branch
+    // is exhausted.
+    bool Pull(Frame &frame, ExecutionContext &context, bool store) {
+      while (true) {
+        if (!cursor->Pull(frame, context)) {
+          exhausted = true;
+          return false;
+        }
+        ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
+                                      storage::View::OLD);
+        utils::pmr::vector<TypedValue> key(keys.get_allocator().GetMemoryResource());
+        key.reserve(key_exprs.size());
+        for (auto *key_expr : key_exprs) {
+          key.emplace_back(key_expr->Accept(evaluator));
+          if (key.back().IsNull()) break;
+        }
+        if (key.back().IsNull()) continue;
+        if (!store) {
+          current_key = std::move(key);
+          return true;
+        }
+        keys.emplace_back(std::move(key));
+        auto &row = values.emplace_back();
+        row.reserve(symbols.size());
+        for (const auto &symbol : symbols) row.emplace_back(frame[symbol]);
+        return true;
+      }
+    }
+
+    void Restore(Frame &frame, size_t row) const {
+      for (size_t i = 0; i < symbols.size(); ++i) frame[symbols[i]] = values[row][i];
+    }
+
+    void Reset() {
+      cursor->Reset();
+      keys.clear();
+      values.clear();
+      current_key = std::nullopt;
+      exhausted = false;
+    }
+
+    UniqueCursorPtr cursor;
+    const std::vector<Symbol> &symbols;
+    const std::vector<Expression *> &key_exprs;
+    utils::pmr::vector<utils::pmr::vector<TypedValue>> keys;
+    utils::pmr::vector<utils::pmr::vector<TypedValue>> values;
+    // Key of the last row pulled without storing it.
+    std::optional<utils::pmr::vector<TypedValue>> current_key;
+    bool exhausted{false};
+  };
+
+  using HashTable = utils::pmr::unordered_map<
+      utils::pmr::vector<TypedValue>, utils::pmr::vector<size_t>,
+      utils::FnvCollection<utils::pmr::vector<TypedValue>, TypedValue, TypedValue::Hash>, TypedValueVectorEqual>;
+
+  // Pulls both branches in turns until one of them is exhausted and builds
+  // the hash table from the rows of the exhausted branch.
+  void Build(Frame &frame, ExecutionContext &context) {
+    while (left_.Pull(frame, context, true) && right_.Pull(frame, context, true)) {
+      if (MustAbort(context)) throw HintedAbortError();
+    }
+    build_ = left_.exhausted ? &left_ : &right_;
+    probe_ = left_.exhausted ? &right_ : &left_;
+    for (size_t row = 0; row < build_->keys.size(); ++row) {
+      table_[std::move(build_->keys[row])].push_back(row);
+    }
+  }
+
+  // Puts the next row of the probe branch on the frame and finds its
+  // matches. The rows which were pulled while building are probed first.
+  // Returns false when the probe branch is exhausted.
+  bool NextProbeRow(Frame &frame, ExecutionContext &context) {
+    matches_ = nullptr;
+    match_index_ = 0;
+    const utils::pmr::vector<TypedValue> *key = nullptr;
+    if (next_probe_row_ < probe_->keys.size()) {
+      probe_->Restore(frame, next_probe_row_);
+      key = &probe_->keys[next_probe_row_++];
+    } else {
+      if (probe_->exhausted || !probe_->Pull(frame, context, false)) return false;
+      key = &*probe_->current_key;
+    }
+    if (auto found = table_.find(*key); found != table_.end()) matches_ = &found->second;
+    return true;
+  }
+
+  const HashJoin &self_;
+  Branch left_;
+  Branch right_;
+  HashTable table_;
+  // Branch whose rows are in the hash table and the branch which probes it.
+  // Both are set once the hash table is built.
+  Branch *build_{nullptr};
+  Branch *probe_{nullptr};
+  // Index of the next stored row of the probe branch.
+  size_t next_probe_row_{0};
+  // Rows of the build branch which match the current probe row.
+  const utils::pmr::vector<size_t> *matches_{nullptr};
+  size_t match_index_{0};
+};
+
+}  // namespace
+
+UniqueCursorPtr HashJoin::MakeCursor(utils::MemoryResource *mem) const {
+  EventCounter::IncrementCounter(EventCounter::HashJoinOperator);
+
+  return MakeUniqueCursorPtr<HashJoinCursor>(mem, *this, mem);
+}
+
 OutputTable::OutputTable(std::vector<Symbol> output_symbols, std::vector<std::vector<TypedValue>> rows)
     : output_symbols_(std::move(output_symbols)), callback_([rows](Frame *, ExecutionContext *) { return rows; }) {}
 
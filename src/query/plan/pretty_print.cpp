@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -18,6 +18,20 @@
 
 namespace memgraph::query::plan {
 
+namespace {
+
+// Prints the properties which are filtered by the predicates pushed down into
+// the scan, if there are any.
+void PrintPropertyPredicates(std::ostream &out, const ScanAll &op) {
+  if (op.property_predicates_.empty()) return;
+  out << " filter {";
+  utils::PrintIterable(out, op.property_predicates_, ", ",
+                       [](auto &stream, const auto &predicate) { stream << predicate.property_name; });
+  out << "}";
+}
+
+}  // namespace
+
 PlanPrinter::PlanPrinter(const DbAccessor *dba, std::ostream *out) : dba_(dba), out_(out) {}
 
 #define PRE_VISIT(TOp)                                   \
@@ -45,6 +59,7 @@ bool PlanPrinter::PreVisit(query::plan::ScanAll &op) {
   WithPrintLn([&](auto &out) {
     out << "* ScanAll"
         << " (" << op.output_symbol_.name() << ")";
+    PrintPropertyPredicates(out, op);
   });
   return true;
 }
@@ -53,6 +68,7 @@ bool PlanPrinter::PreVisit(query::plan::ScanAllByLabel &op) {
   WithPrintLn([&](auto &out) {
     out << "* ScanAllByLabel"
         << " (" << op.output_symbol_.name() << " :" << dba_->LabelToName(op.label_) << ")";
+    PrintPropertyPredicates(out, op);
   });
   return true;
 }
@@ -62,6 +78,7 @@ bool PlanPrinter::PreVisit(query::plan::ScanAllByLabelPropertyValue &op) {
     out << "* ScanAllByLabelPropertyValue"
         << " (" << op.output_symbol_.name() << " :" << dba_->LabelToName(op.label_) << " {"
         << dba_->PropertyToName(op.property_) << "})";
+    PrintPropertyPredicates(out, op);
   });
   return true;
 }
@@ -71,6 +88,7 @@ bool PlanPrinter::PreVisit(query::plan::ScanAllByLabelPropertyRange &op) {
     out << "* ScanAllByLabelPropertyRange"
         << " (" << op.output_symbol_.name() << " :" << dba_->LabelToName(op.label_) << " {"
         << dba_->PropertyToName(op.property_) << "})";
+    PrintPropertyPredicates(out, op);
   });
   return true;
 }
@@ -80,6 +98,19 @@ bool PlanPrinter::PreVisit(query::plan::ScanAllByLabelProperty &op) {
     out << "* ScanAllByLabelProperty"
         << " (" << op.output_symbol_.name() << " :" << dba_->LabelToName(op.label_) << " {"
         << dba_->PropertyToName(op.property_) << "})";
+    PrintPropertyPredicates(out, op);
+  });
+  return true;
+}
+
+bool PlanPrinter::PreVisit(query::plan::ScanAllByLabelPropertyComposite &op) {
+  WithPrintLn([&](auto &out) {
+    out << "* ScanAllByLabelPropertyComposite"
+        << " (" << op.output_symbol_.name() << " :" << dba_->LabelToName(op.label_) << " {";
+    utils::PrintIterable(out, op.properties_, ", ",
+                         [&](auto &stream, const auto &property) { stream << dba_->PropertyToName(property); });
+    out << "})";
+    PrintPropertyPredicates(out, op);
   });
   return true;
 }
@@ -88,6 +119,26 @@ bool PlanPrinter::PreVisit(ScanAllById &op) {
   WithPrintLn([&](auto &out) {
     out << "* ScanAllById"
         << " (" << op.output_symbol_.name() << ")";
+    PrintPropertyPredicates(out, op);
+  });
+  return true;
+}
+
+bool PlanPrinter::PreVisit(query::plan::ScanAllByEdgeType &op) {
+  WithPrintLn([&](auto &out) {
+    out << "* ScanAllByEdgeType"
+        << " (" << op.from_symbol_.name() << ")-[" << op.edge_symbol_.name() << ":"
+        << dba_->EdgeTypeToName(op.edge_type_) << "]->(" << op.to_symbol_.name() << ")";
+  });
+  return true;
+}
+
+bool PlanPrinter::PreVisit(query::plan::ScanAllByEdgeTypePropertyValue &op) {
+  WithPrintLn([&](auto &out) {
+    out << "* ScanAllByEdgeTypePropertyValue"
+        << " (" << op.from_symbol_.name() << ")-[" << op.edge_symbol_.name() << ":"
+        << dba_->EdgeTypeToName(op.edge_type_) << " {" << dba_->PropertyToName(op.property_) << "}]->("
+        << op.to_symbol_.name() << ")";
   });
   return true;
 }
@@ -170,6 +221,33 @@ bool PlanPrinter::PreVisit(query::plan::Aggregate &op) {
   return true;
 }
 
+bool PlanPrinter::PreVisit(query::plan::ParallelAggregate &op) {
+  WithPrintLn([&](auto &out) {
+    out << "* ParallelAggregate {";
+    utils::PrintIterable(out, op.aggregations_, ", ",
+                         [](auto &out, const auto &aggr) { out << aggr.output_sym.name(); });
+    out << "} {";
+    utils::PrintIterable(out, op.remember_, ", ", [](auto &out, const auto &sym) { out << sym.name(); });
+    out << "} (" << op.num_workers_ << " workers)";
+  });
+  return true;
+}
+
+bool PlanPrinter::PreVisit(query::plan::ColumnarAggregate &op) {
+  WithPrintLn([&](auto &out) {
+    out << "* ColumnarAggregate {";
+    utils::PrintIterable(out, op.aggregations_, ", ",
+                         [](auto &out, const auto &aggr) { out << aggr.output_sym.name(); });
+    out << "} {";
+    utils::PrintIterable(out, op.remember_, ", ", [](auto &out, const auto &sym) { out << sym.name(); });
+    out << "} (:" << dba_->LabelToName(op.label_) << " {";
+    utils::PrintIterable(out, op.properties_, ", ",
+                         [&](auto &out, const auto &property) { out << dba_->PropertyToName(property); });
+    out << "})";
+  });
+  return true;
+}
+
 PRE_VISIT(Skip);
 PRE_VISIT(Limit);
 
@@ -182,6 +260,15 @@ bool PlanPrinter::PreVisit(query::plan::OrderBy &op) {
   return true;
 }
 
+bool PlanPrinter::PreVisit(query::plan::TopK &op) {
+  WithPrintLn([&op](auto &out) {
+    out << "* TopK {";
+    utils::PrintIterable(out, op.output_symbols_, ", ", [](auto &out, const auto &sym) { out << sym.name(); });
+    out << "}";
+  });
+  return true;
+}
+
 bool PlanPrinter::PreVisit(query::plan::Merge &op) {
   WithPrintLn([](auto &out) { out << "* Merge"; });
   Branch(*op.merge_match_, "On Match");
@@ -245,6 +332,19 @@ bool PlanPrinter::PreVisit(query::plan::Cartesian &op) {
   return false;
 }
 
+bool PlanPrinter::PreVisit(query::plan::HashJoin &op) {
+  WithPrintLn([&op](auto &out) {
+    out << "* HashJoin {";
+    utils::PrintIterable(out, op.left_symbols_, ", ", [](auto &out, const auto &sym) { out << sym.name(); });
+    out << " : ";
+    utils::PrintIterable(out, op.right_symbols_, ", ", [](auto &out, const auto &sym) { out << sym.name(); });
+    out << "}";
+  });
+  Branch(*op.right_op_);
+  op.left_op_->Accept(*this);
+  return false;
+}
+
 bool PlanPrinter::PreVisit(query::plan::Foreach &op) {
   WithPrintLn([](auto &out) { out << "* Foreach"; });
   Branch(*op.update_clauses_);
@@ -486,6 +586,23 @@ bool PlanToJsonVisitor::PreVisit(ScanAllByLabelProperty &op) {
   return false;
 }
 
+bool PlanToJsonVisitor::PreVisit(ScanAllByLabelPropertyComposite &op) {
+  json self;
+  self["name"] = "ScanAllByLabelPropertyComposite";
+  self["label"] = ToJson(op.label_, *dba_);
+  self["properties"] = ToJson(op.properties_, *dba_);
+  self["prefix"] = ToJson(op.prefix_);
+  self["lower_bound"] = op.lower_bound_ ? ToJson(*op.lower_bound_) : json();
+  self["upper_bound"] = op.upper_bound_ ? ToJson(*op.upper_bound_) : json();
+  self["output_symbol"] = ToJson(op.output_symbol_);
+
+  op.input_->Accept(*this);
+  self["input"] = PopOutput();
+
+  output_ = std::move(self);
+  return false;
+}
+
 bool PlanToJsonVisitor::PreVisit(ScanAllById &op) {
   json self;
   self["name"] = "ScanAllById";
@@ -496,6 +613,38 @@ bool PlanToJsonVisitor::PreVisit(ScanAllById &op) {
   return false;
 }
 
+bool PlanToJsonVisitor::PreVisit(ScanAllByEdgeType &op) {
+  json self;
+  self["name"] = "ScanAllByEdgeType";
+  self["edge_type"] = ToJson(op.edge_type_, *dba_);
+  self["from_symbol"] = ToJson(op.from_symbol_);
+  self["edge_symbol"] = ToJson(op.edge_symbol_);
+  self["to_symbol"] = ToJson(op.to_symbol_);
+
+  op.input_->Accept(*this);
+  self["input"] = PopOutput();
+
+  output_ = std::move(self);
+  return false;
+}
+
+bool PlanToJsonVisitor::PreVisit(ScanAllByEdgeTypePropertyValue &op) {
+  json self;
+  self["name"] = "ScanAllByEdgeTypePropertyValue";
+  self["edge_type"] = ToJson(op.edge_type_, *dba_);
+  self["property"] = ToJson(op.property_, *dba_);
+  self["expression"] = ToJson(op.expression_);
+  self["from_symbol"] = ToJson(op.from_symbol_);
+  self["edge_symbol"] = ToJson(op.edge_symbol_);
+  self["to_symbol"] = ToJson(op.to_symbol_);
+
+  op.input_->Accept(*this);
+  self["input"] = PopOutput();
+
+  output_ = std::move(self);
+  return false;
+}
+
 bool PlanToJsonVisitor::PreVisit(CreateNode &op) {
   json self;
   self["name"] = "CreateNode";
@@ -744,6 +893,36 @@ bool PlanToJsonVisitor::PreVisit(Aggregate &op) {
   return false;
 }
 
+bool PlanToJsonVisitor::PreVisit(ParallelAggregate &op) {
+  json self;
+  self["name"] = "ParallelAggregate";
+  self["aggregations"] = ToJson(op.aggregations_);
+  self["group_by"] = ToJson(op.group_by_);
+  self["remember"] = ToJson(op.remember_);
+  self["num_workers"] = op.num_workers_;
+
+  op.input_->Accept(*this);
+  self["input"] = PopOutput();
+
+  output_ = std::move(self);
+  return false;
+}
+
+bool PlanToJsonVisitor::PreVisit(ColumnarAggregate &op) {
+  json self;
+  self["name"] = "ColumnarAggregate";
+  self["aggregations"] = ToJson(op.aggregations_);
+  self["remember"] = ToJson(op.remember_);
+  self["label"] = ToJson(op.label_, *dba_);
+  self["properties"] = ToJson(op.properties_, *dba_);
+
+  op.input_->Accept(*this);
+  self["input"] = PopOutput();
+
+  output_ = std::move(self);
+  return false;
+}
+
 bool PlanToJsonVisitor::PreVisit(Skip &op) {
   json self;
   self["name"] = "Skip";
@@ -787,6 +966,27 @@ bool PlanToJsonVisitor::PreVisit(OrderBy &op) {
   return false;
 }
 
+bool PlanToJsonVisitor::PreVisit(TopK &op) {
+  json self;
+  self["name"] = "TopK";
+
+  for (auto i = 0; i < op.order_by_.size(); ++i) {
+    json json;
+    json["ordering"] = ToString(op.compare_.ordering_[i]);
+    json["expression"] = ToJson(op.order_by_[i]);
+    self["order_by"].push_back(json);
+  }
+  self["output_symbols"] = ToJson(op.output_symbols_);
+  self["limit"] = ToJson(op.limit_);
+  self["skip"] = op.skip_ ? ToJson(op.skip_) : json();
+
+  op.input_->Accept(*this);
+  self["input"] = PopOutput();
+
+  output_ = std::move(self);
+  return false;
+}
+
 bool PlanToJsonVisitor::PreVisit(Merge &op) {
   json self;
   self["name"] = "Merge";
@@ -908,6 +1108,24 @@ bool PlanToJsonVisitor::PreVisit(Cartesian &op) {
   output_ = std::move(self);
   return false;
 }
+bool PlanToJsonVisitor::PreVisit(HashJoin &op) {
+  json self;
+  self["name"] = "HashJoin";
+  self["left_symbols"] = ToJson(op.left_symbols_);
+  self["right_symbols"] = ToJson(op.right_symbols_);
+  self["left_keys"] = ToJson(op.left_keys_);
+  self["right_keys"] = ToJson(op.right_keys_);
+
+  op.left_op_->Accept(*this);
+  self["left_op"] = PopOutput();
+
+  op.right_op_->Accept(*this);
+  self["right_op"] = PopOutput();
+
+  output_ = std::move(self);
+  return false;
+}
+
 bool PlanToJsonVisitor::PreVisit(Foreach &op) {
   json self;
   self["name"] = "Foreach";
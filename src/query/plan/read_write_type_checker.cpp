@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -36,7 +36,10 @@ PRE_VISIT(ScanAllByLabel, RWType::R, true)
 PRE_VISIT(ScanAllByLabelPropertyRange, RWType::R, true)
 PRE_VISIT(ScanAllByLabelPropertyValue, RWType::R, true)
 PRE_VISIT(ScanAllByLabelProperty, RWType::R, true)
+PRE_VISIT(ScanAllByLabelPropertyComposite, RWType::R, true)
 PRE_VISIT(ScanAllById, RWType::R, true)
+PRE_VISIT(ScanAllByEdgeType, RWType::R, true)
+PRE_VISIT(ScanAllByEdgeTypePropertyValue, RWType::R, true)
 
 PRE_VISIT(Expand, RWType::R, true)
 PRE_VISIT(ExpandVariable, RWType::R, true)
@@ -55,13 +58,22 @@ bool ReadWriteTypeChecker::PreVisit(Cartesian &op) {
   return false;
 }
 
+bool ReadWriteTypeChecker::PreVisit(HashJoin &op) {
+  op.left_op_->Accept(*this);
+  op.right_op_->Accept(*this);
+  return false;
+}
+
 PRE_VISIT(EmptyResult, RWType::NONE, true)
 PRE_VISIT(Produce, RWType::NONE, true)
 PRE_VISIT(Accumulate, RWType::NONE, true)
 PRE_VISIT(Aggregate, RWType::NONE, true)
+PRE_VISIT(ParallelAggregate, RWType::NONE, true)
+PRE_VISIT(ColumnarAggregate, RWType::NONE, true)
 PRE_VISIT(Skip, RWType::NONE, true)
 PRE_VISIT(Limit, RWType::NONE, true)
 PRE_VISIT(OrderBy, RWType::NONE, true)
+PRE_VISIT(TopK, RWType::NONE, true)
 PRE_VISIT(Distinct, RWType::NONE, true)
 
 bool ReadWriteTypeChecker::PreVisit(Union &op) {
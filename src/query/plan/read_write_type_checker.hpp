@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -59,7 +59,10 @@ struct ReadWriteTypeChecker : public virtual HierarchicalLogicalOperatorVisitor
   bool PreVisit(ScanAllByLabelPropertyValue &) override;
   bool PreVisit(ScanAllByLabelPropertyRange &) override;
   bool PreVisit(ScanAllByLabelProperty &) override;
+  bool PreVisit(ScanAllByLabelPropertyComposite &) override;
   bool PreVisit(ScanAllById &) override;
+  bool PreVisit(ScanAllByEdgeType &) override;
+  bool PreVisit(ScanAllByEdgeTypePropertyValue &) override;
 
   bool PreVisit(Expand &) override;
   bool PreVisit(ExpandVariable &) override;
@@ -72,14 +75,18 @@ struct ReadWriteTypeChecker : public virtual HierarchicalLogicalOperatorVisitor
   bool PreVisit(Merge &) override;
   bool PreVisit(Optional &) override;
   bool PreVisit(Cartesian &) override;
+  bool PreVisit(HashJoin &) override;
 
   bool PreVisit(EmptyResult &) override;
   bool PreVisit(Produce &) override;
   bool PreVisit(Accumulate &) override;
   bool PreVisit(Aggregate &) override;
+  bool PreVisit(ParallelAggregate &) override;
+  bool PreVisit(ColumnarAggregate &) override;
   bool PreVisit(Skip &) override;
   bool PreVisit(Limit &) override;
   bool PreVisit(OrderBy &) override;
+  bool PreVisit(TopK &) override;
   bool PreVisit(Distinct &) override;
   bool PreVisit(Union &) override;
 
@@ -0,0 +1,59 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/plan/rewrite/columnar_aggregate.hpp"
+
+#include "utils/typeinfo.hpp"
+
+namespace memgraph::query::plan::impl {
+
+namespace {
+
+bool IsSummarizable(const Aggregate::Element &element) {
+  if (element.distinct) return false;
+  switch (element.op) {
+    case Aggregation::Op::COUNT:
+    case Aggregation::Op::SUM:
+    case Aggregation::Op::AVG:
+    case Aggregation::Op::MIN:
+    case Aggregation::Op::MAX:
+      return true;
+    case Aggregation::Op::COLLECT_LIST:
+    case Aggregation::Op::COLLECT_MAP:
+    case Aggregation::Op::PROJECT:
+      return false;
+  }
+  return false;
+}
+
+}  // namespace
+
+const ScanAllByLabel *FindColumnarScan(const Aggregate &aggregate, std::vector<const PropertyLookup *> *lookups) {
+  if (!aggregate.group_by_.empty()) return nullptr;
+  if (aggregate.input_->GetTypeInfo() != ScanAllByLabel::kType) return nullptr;
+  const auto *scan = static_cast<const ScanAllByLabel *>(aggregate.input_.get());
+  if (scan->input()->GetTypeInfo() != Once::kType || !scan->property_predicates_.empty()) return nullptr;
+  lookups->clear();
+  for (const auto &element : aggregate.aggregations_) {
+    if (!IsSummarizable(element)) return nullptr;
+    // COUNT(*)
+    if (!element.value) continue;
+    const auto *lookup = utils::Downcast<const PropertyLookup>(element.value);
+    if (!lookup) return nullptr;
+    const auto *identifier = utils::Downcast<const Identifier>(lookup->expression_);
+    if (!identifier || identifier->symbol_pos_ != scan->output_symbol_.position()) return nullptr;
+    lookups->push_back(lookup);
+  }
+  if (lookups->empty()) return nullptr;
+  return scan;
+}
+
+}  // namespace memgraph::query::plan::impl
@@ -0,0 +1,68 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// This file provides a plan rewriter which replaces `Aggregate` operations
+/// over the properties of the vertices with a label by `ColumnarAggregate`
+/// when the properties have columns. The public entrypoint is
+/// `RewriteWithColumnarAggregate`.
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "query/plan/operator.hpp"
+
+namespace memgraph::query::plan {
+
+namespace impl {
+
+// Returns the scan which is the input of the `Aggregate` if the aggregations
+// can be computed from property columns, `nullptr` otherwise. The input has to
+// be a `ScanAllByLabel` without property predicates whose input is `Once`, there
+// can't be any grouping, and each of the aggregations has to be a mergeable
+// aggregation of a property of the scanned vertex or COUNT(*). The lookups of
+// the properties are appended to `lookups`, in the order of the aggregations.
+const ScanAllByLabel *FindColumnarScan(const Aggregate &aggregate, std::vector<const PropertyLookup *> *lookups);
+
+}  // namespace impl
+
+/// Replaces the `Aggregate` operators found on the single input chain of the
+/// plan with `ColumnarAggregate` if all of the aggregated properties have
+/// columns.
+template <class TDbAccessor>
+std::unique_ptr<LogicalOperator> RewriteWithColumnarAggregate(std::unique_ptr<LogicalOperator> root_op,
+                                                              TDbAccessor *db) {
+  for (auto *op = root_op.get(); op->HasSingleInput(); op = op->input().get()) {
+    auto input = op->input();
+    if (input->GetTypeInfo() != Aggregate::kType) continue;
+    const auto &aggregate = static_cast<const Aggregate &>(*input);
+    std::vector<const PropertyLookup *> lookups;
+    const auto *scan = impl::FindColumnarScan(aggregate, &lookups);
+    if (!scan) continue;
+    std::vector<storage::PropertyId> properties;
+    properties.reserve(lookups.size());
+    for (const auto *lookup : lookups) {
+      properties.push_back(db->NameToProperty(lookup->property_.name));
+    }
+    if (!std::all_of(properties.begin(), properties.end(),
+                     [db, label = scan->label_](auto property) { return db->PropertyColumnExists(label, property); })) {
+      continue;
+    }
+    op->set_input(std::make_shared<ColumnarAggregate>(aggregate.input_, aggregate.aggregations_, aggregate.remember_,
+                                                      scan->label_, properties));
+  }
+  return root_op;
+}
+
+}  // namespace memgraph::query::plan
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -48,4 +48,15 @@ Expression *RemoveAndExpressions(Expression *expr, const std::unordered_set<Expr
   return and_op;
 }
 
+void CollectAndExpressions(Expression *expr, std::unordered_set<Expression *> *exprs) {
+  if (!expr) return;
+  auto *and_op = utils::Downcast<AndOperator>(expr);
+  if (!and_op) {
+    exprs->insert(expr);
+    return;
+  }
+  CollectAndExpressions(and_op->expression1_, exprs);
+  CollectAndExpressions(and_op->expression2_, exprs);
+}
+
 }  // namespace memgraph::query::plan::impl
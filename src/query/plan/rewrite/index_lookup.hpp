@@ -38,6 +38,10 @@ namespace impl {
 // given expression tree.
 Expression *RemoveAndExpressions(Expression *expr, const std::unordered_set<Expression *> &exprs_to_remove);
 
+// Collect the expressions which are joined with AND operators into the given
+// expression tree.
+void CollectAndExpressions(Expression *expr, std::unordered_set<Expression *> *exprs);
+
 template <class TDbAccessor>
 class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
  public:
@@ -80,7 +84,10 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     prev_ops_.pop_back();
     auto indexed_scan = GenScanByIndex(scan);
     if (indexed_scan) {
+      PushDownPropertyPredicates(indexed_scan.get());
       SetOnParent(std::move(indexed_scan));
+    } else {
+      PushDownPropertyPredicates(&scan);
     }
     return true;
   }
@@ -90,13 +97,19 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
-  // See if it might be better to do ScanAllBy<Index> of the destination and
-  // then do Expand to existing.
+  // Replace the ScanAll and the Expand with a ScanAllByEdgeType if there is an
+  // edge index. Otherwise see if it might be better to do ScanAllBy<Index> of
+  // the destination and then do Expand to existing.
   bool PostVisit(Expand &expand) override {
     prev_ops_.pop_back();
     if (expand.common_.existing_node) {
       return true;
     }
+    auto edge_scan = GenScanByEdgeIndex(expand);
+    if (edge_scan) {
+      SetOnParent(std::move(edge_scan));
+      return true;
+    }
     ScanAll dst_scan(expand.input(), expand.common_.node_symbol, expand.view_);
     auto indexed_scan = GenScanByIndex(dst_scan, FLAGS_query_vertex_count_to_expand_existing);
     if (indexed_scan) {
@@ -203,6 +216,20 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
+  // Like with Cartesian, the filters of the branches are expected to be
+  // planned inside of the branches.
+  bool PreVisit(HashJoin &op) override {
+    prev_ops_.push_back(&op);
+    RewriteBranch(&op.left_op_);
+    RewriteBranch(&op.right_op_);
+    return false;
+  }
+
+  bool PostVisit(HashJoin &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
   bool PreVisit(Union &op) override {
     prev_ops_.push_back(&op);
     RewriteBranch(&op.left_op_);
@@ -280,6 +307,26 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
+  bool PreVisit(ScanAllByEdgeType &op) override {
+    prev_ops_.push_back(&op);
+    return true;
+  }
+
+  bool PostVisit(ScanAllByEdgeType &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
+  bool PreVisit(ScanAllByEdgeTypePropertyValue &op) override {
+    prev_ops_.push_back(&op);
+    return true;
+  }
+
+  bool PostVisit(ScanAllByEdgeTypePropertyValue &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
   bool PreVisit(ConstructNamedPath &op) override {
     prev_ops_.push_back(&op);
     return true;
@@ -388,6 +435,15 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     return true;
   }
 
+  bool PreVisit(ParallelAggregate &op) override {
+    prev_ops_.push_back(&op);
+    return true;
+  }
+  bool PostVisit(ParallelAggregate &) override {
+    prev_ops_.pop_back();
+    return true;
+  }
+
   bool PreVisit(Skip &op) override {
     prev_ops_.push_back(&op);
     return true;
@@ -474,6 +530,20 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     int64_t vertex_count;
   };
 
+  struct LabelPropertyCompositeIndex {
+    LabelIx label;
+    std::vector<storage::PropertyId> properties;
+    // FilterInfo with an equality PropertyFilter for each of the leading
+    // properties of the index.
+    std::vector<FilterInfo> prefix;
+    // FilterInfo with a range PropertyFilter on the property which follows the
+    // prefix.
+    std::optional<FilterInfo> range;
+    int64_t vertex_count;
+
+    size_t CoveredFilters() const { return prefix.size() + (range ? 1 : 0); }
+  };
+
   bool DefaultPreVisit() override { throw utils::NotYetImplemented("optimizing index lookup"); }
 
   void SetOnParent(const std::shared_ptr<LogicalOperator> &input) {
@@ -556,6 +626,173 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
     return found;
   }
 
+  // Finds the composite label+properties index which can be used for the
+  // largest number of property filters. An index is used for the equality
+  // filters on its leading properties and for an optional range filter on the
+  // property which follows them. Only the indices which cover at least 2
+  // filters are considered, because otherwise a label+property index does the
+  // same job. Ties are broken by the lowest amount of indexed vertices.
+  std::optional<LabelPropertyCompositeIndex> FindBestLabelPropertyCompositeIndex(
+      const Symbol &symbol, const std::unordered_set<Symbol> &bound_symbols) {
+    auto are_bound = [&bound_symbols](const auto &used_symbols) {
+      for (const auto &used_symbol : used_symbols) {
+        if (!utils::Contains(bound_symbols, used_symbol)) {
+          return false;
+        }
+      }
+      return true;
+    };
+    const auto property_filters = filters_.PropertyFilters(symbol);
+    auto find_filter = [&](storage::PropertyId property, PropertyFilter::Type type) -> std::optional<FilterInfo> {
+      for (const auto &filter : property_filters) {
+        const auto &prop_filter = *filter.property_filter;
+        if (prop_filter.type_ != type || prop_filter.is_symbol_in_value_ || !are_bound(filter.used_symbols)) continue;
+        if (GetProperty(prop_filter.property_) == property) return filter;
+      }
+      return std::nullopt;
+    };
+    std::optional<LabelPropertyCompositeIndex> found;
+    for (const auto &label : filters_.FilteredLabels(symbol)) {
+      for (auto &properties : db_->LabelPropertyCompositeIndices(GetLabel(label))) {
+        LabelPropertyCompositeIndex candidate{label, std::move(properties), {}, std::nullopt, 0};
+        for (const auto &property : candidate.properties) {
+          if (auto filter = find_filter(property, PropertyFilter::Type::EQUAL)) {
+            candidate.prefix.push_back(std::move(*filter));
+            continue;
+          }
+          candidate.range = find_filter(property, PropertyFilter::Type::RANGE);
+          break;
+        }
+        if (candidate.CoveredFilters() < 2) continue;
+        candidate.vertex_count = db_->VerticesCount(GetLabel(label), candidate.properties, {});
+        if (!found || candidate.CoveredFilters() > found->CoveredFilters() ||
+            (candidate.CoveredFilters() == found->CoveredFilters() && candidate.vertex_count < found->vertex_count)) {
+          found = std::move(candidate);
+        }
+      }
+    }
+    return found;
+  }
+
+  // Creates a ScanAllByEdgeType or a ScanAllByEdgeTypePropertyValue which
+  // replaces both the `expand` and the plain ScanAll of its input vertex. The
+  // edge index can be used only if the expansion goes in a single direction
+  // over a single edge type and the input vertex is produced by a ScanAll
+  // which isn't replaced by an indexed lookup. If the edge index cannot be
+  // used, `nullptr` is returned.
+  std::unique_ptr<ScanAllByEdgeType> GenScanByEdgeIndex(const Expand &expand) {
+    const auto &common = expand.common_;
+    if (common.direction == EdgeAtom::Direction::BOTH || common.edge_types.size() != 1) return nullptr;
+    if (expand.input()->GetTypeInfo() != ScanAll::kType) return nullptr;
+    const auto &scan = static_cast<const ScanAll &>(*expand.input());
+    if (scan.output_symbol_ != expand.input_symbol_ || !scan.property_predicates_.empty()) return nullptr;
+    const auto edge_type = common.edge_types[0];
+    const auto &edge_symbol = common.edge_symbol;
+    auto from_symbol = expand.input_symbol_;
+    auto to_symbol = common.node_symbol;
+    if (common.direction == EdgeAtom::Direction::IN) std::swap(from_symbol, to_symbol);
+
+    const auto &input = scan.input();
+    const auto &modified_symbols = input->ModifiedSymbols(*symbol_table_);
+    std::unordered_set<Symbol> bound_symbols(modified_symbols.begin(), modified_symbols.end());
+    auto are_bound = [&bound_symbols](const auto &used_symbols) {
+      for (const auto &used_symbol : used_symbols) {
+        if (!utils::Contains(bound_symbols, used_symbol)) {
+          return false;
+        }
+      }
+      return true;
+    };
+    // Use the edge-type+property index with the least number of edges for an
+    // equality filter on the edge.
+    std::optional<FilterInfo> found_filter;
+    int64_t found_edge_count = 0;
+    for (const auto &filter : filters_.PropertyFilters(edge_symbol)) {
+      const auto &prop_filter = *filter.property_filter;
+      if (prop_filter.type_ != PropertyFilter::Type::EQUAL || prop_filter.is_symbol_in_value_ ||
+          !are_bound(filter.used_symbols)) {
+        continue;
+      }
+      const auto property = GetProperty(prop_filter.property_);
+      if (!db_->EdgeTypePropertyIndexExists(edge_type, property)) continue;
+      const auto edge_count = db_->EdgesCount(edge_type, property);
+      if (!found_filter || edge_count < found_edge_count) {
+        found_filter = filter;
+        found_edge_count = edge_count;
+      }
+    }
+    if (found_filter) {
+      const auto prop_filter = *found_filter->property_filter;
+      filter_exprs_for_removal_.insert(found_filter->expression);
+      filters_.EraseFilter(*found_filter);
+      return std::make_unique<ScanAllByEdgeTypePropertyValue>(
+          input, from_symbol, edge_symbol, to_symbol, edge_type, GetProperty(prop_filter.property_),
+          prop_filter.property_.name, prop_filter.value_, expand.view_);
+    }
+    if (!db_->EdgeTypeIndexExists(edge_type)) return nullptr;
+    return std::make_unique<ScanAllByEdgeType>(input, from_symbol, edge_symbol, to_symbol, edge_type, expand.view_);
+  }
+
+  // Moves the simple filters on the properties of the vertices produced by
+  // `scan` into the scan, where they are checked on the stored properties. The
+  // filters are moved only from the `Filter` which directly follows the scan,
+  // and only if they compare a property to a literal or a parameter.
+  void PushDownPropertyPredicates(ScanAll *scan) {
+    if (prev_ops_.empty() || prev_ops_.back()->GetTypeInfo() != Filter::kType) return;
+    std::unordered_set<Expression *> filter_exprs;
+    CollectAndExpressions(static_cast<Filter *>(prev_ops_.back())->expression_, &filter_exprs);
+    const auto &symbol = scan->output_symbol_;
+    auto is_constant = [](Expression *expr) {
+      return utils::Downcast<PrimitiveLiteral>(expr) || utils::Downcast<ParameterLookup>(expr);
+    };
+    auto is_constant_bound = [&is_constant](const std::optional<PropertyFilter::Bound> &bound) {
+      return !bound || is_constant(bound->value());
+    };
+    std::vector<FilterInfo> pushed_filters;
+    for (const auto &filter : filters_) {
+      if (!utils::Contains(filter_exprs, filter.expression)) continue;
+      if (filter.used_symbols.size() != 1U || !utils::Contains(filter.used_symbols, symbol)) continue;
+      ScanAll::PropertyPredicate predicate;
+      predicate.expression = filter.expression;
+      if (filter.type == FilterInfo::Type::Property) {
+        const auto &prop_filter = *filter.property_filter;
+        if (prop_filter.is_symbol_in_value_) continue;
+        if (prop_filter.type_ == PropertyFilter::Type::EQUAL && is_constant(prop_filter.value_)) {
+          predicate.type = storage::PropertyPredicate::Type::EQUAL;
+          predicate.value = prop_filter.value_;
+        } else if (prop_filter.type_ == PropertyFilter::Type::RANGE && is_constant_bound(prop_filter.lower_bound_) &&
+                   is_constant_bound(prop_filter.upper_bound_)) {
+          predicate.type = storage::PropertyPredicate::Type::RANGE;
+          predicate.lower_bound = prop_filter.lower_bound_;
+          predicate.upper_bound = prop_filter.upper_bound_;
+        } else if (prop_filter.type_ == PropertyFilter::Type::IS_NOT_NULL) {
+          predicate.type = storage::PropertyPredicate::Type::IS_NOT_NULL;
+        } else {
+          continue;
+        }
+        predicate.property = GetProperty(prop_filter.property_);
+        predicate.property_name = prop_filter.property_.name;
+      } else if (filter.type == FilterInfo::Type::Generic) {
+        // `n.prop IS NULL` isn't analyzed as a property filter, because it
+        // can't be used for an index lookup.
+        auto *is_null = utils::Downcast<IsNullOperator>(filter.expression);
+        auto *prop_lookup = is_null ? utils::Downcast<PropertyLookup>(is_null->expression_) : nullptr;
+        if (!prop_lookup || !utils::Downcast<Identifier>(prop_lookup->expression_)) continue;
+        predicate.type = storage::PropertyPredicate::Type::IS_NULL;
+        predicate.property = GetProperty(prop_lookup->property_);
+        predicate.property_name = prop_lookup->property_.name;
+      } else {
+        continue;
+      }
+      scan->property_predicates_.emplace_back(std::move(predicate));
+      pushed_filters.push_back(filter);
+    }
+    for (const auto &filter : pushed_filters) {
+      filter_exprs_for_removal_.insert(filter.expression);
+      filters_.EraseFilter(filter);
+    }
+  }
+
   // Creates a ScanAll by the best possible index for the `node_symbol`. Best
   // index is defined as the index with least number of vertices. If the node
   // does not have at least a label, no indexed lookup can be created and
@@ -595,6 +832,38 @@ class IndexLookupRewriter final : public HierarchicalLogicalOperatorVisitor {
       // Without labels, we cannot generate any indexed ScanAll.
       return nullptr;
     }
+    // A composite index is preferred to the label+property index, since it
+    // covers multiple property filters at once.
+    auto found_composite_index = FindBestLabelPropertyCompositeIndex(node_symbol, bound_symbols);
+    if (found_composite_index &&
+        (!max_vertex_count || *max_vertex_count >= found_composite_index->vertex_count)) {
+      std::vector<std::string> property_names;
+      property_names.reserve(found_composite_index->properties.size());
+      for (const auto &property : found_composite_index->properties) {
+        property_names.push_back(db_->PropertyToName(property));
+      }
+      std::vector<Expression *> prefix;
+      prefix.reserve(found_composite_index->prefix.size());
+      for (const auto &filter : found_composite_index->prefix) {
+        prefix.push_back(filter.property_filter->value_);
+        filter_exprs_for_removal_.insert(filter.expression);
+        filters_.EraseFilter(filter);
+      }
+      std::optional<ScanAllByLabelPropertyComposite::Bound> lower_bound;
+      std::optional<ScanAllByLabelPropertyComposite::Bound> upper_bound;
+      if (found_composite_index->range) {
+        lower_bound = found_composite_index->range->property_filter->lower_bound_;
+        upper_bound = found_composite_index->range->property_filter->upper_bound_;
+        filter_exprs_for_removal_.insert(found_composite_index->range->expression);
+        filters_.EraseFilter(*found_composite_index->range);
+      }
+      std::vector<Expression *> removed_expressions;
+      filters_.EraseLabelFilter(node_symbol, found_composite_index->label, &removed_expressions);
+      filter_exprs_for_removal_.insert(removed_expressions.begin(), removed_expressions.end());
+      return std::make_unique<ScanAllByLabelPropertyComposite>(
+          input, node_symbol, GetLabel(found_composite_index->label), found_composite_index->properties,
+          property_names, prefix, lower_bound, upper_bound, view);
+    }
     auto found_index = FindBestLabelPropertyIndex(node_symbol, bound_symbols);
     if (found_index &&
         // Use label+property index if we satisfy max_vertex_count.
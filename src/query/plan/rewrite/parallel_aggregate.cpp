@@ -0,0 +1,66 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/plan/rewrite/parallel_aggregate.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "utils/flag_validation.hpp"
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_int64(query_parallel_workers, 1,
+                       "Maximum number of threads a single query uses to scan the vertices and aggregate the results. "
+                       "Default is 1, which disables parallel aggregation.",
+                       FLAG_IN_RANGE(1, 1024));
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_int64(query_parallel_scan_min_vertices, 100000,
+                       "Minimum estimated number of scanned vertices for which an aggregation is run in parallel.",
+                       FLAG_IN_RANGE(0, std::numeric_limits<std::int64_t>::max()));
+
+namespace memgraph::query::plan::impl {
+
+namespace {
+
+bool IsMergeable(const Aggregate::Element &element) {
+  if (element.distinct) return false;
+  switch (element.op) {
+    case Aggregation::Op::COUNT:
+    case Aggregation::Op::SUM:
+    case Aggregation::Op::AVG:
+    case Aggregation::Op::MIN:
+    case Aggregation::Op::MAX:
+      return true;
+    case Aggregation::Op::COLLECT_LIST:
+    case Aggregation::Op::COLLECT_MAP:
+    case Aggregation::Op::PROJECT:
+      return false;
+  }
+  return false;
+}
+
+}  // namespace
+
+const ScanAll *FindParallelScan(const Aggregate &aggregate) {
+  if (!std::all_of(aggregate.aggregations_.begin(), aggregate.aggregations_.end(), IsMergeable)) return nullptr;
+  const auto *op = aggregate.input_.get();
+  while (op->GetTypeInfo() == Filter::kType || op->GetTypeInfo() == Expand::kType ||
+         op->GetTypeInfo() == EdgeUniquenessFilter::kType) {
+    op = op->input().get();
+  }
+  if (op->GetTypeInfo() != ScanAll::kType && op->GetTypeInfo() != ScanAllByLabel::kType) return nullptr;
+  const auto *scan = static_cast<const ScanAll *>(op);
+  if (scan->input()->GetTypeInfo() != Once::kType) return nullptr;
+  return scan;
+}
+
+}  // namespace memgraph::query::plan::impl
@@ -0,0 +1,65 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// This file provides a plan rewriter which replaces `Aggregate` operations
+/// whose input is a read-only pipeline over a large scan with
+/// `ParallelAggregate`. The public entrypoint is `RewriteWithParallelAggregate`.
+
+#pragma once
+
+#include <memory>
+
+#include <gflags/gflags.h>
+
+#include "query/plan/operator.hpp"
+
+DECLARE_int64(query_parallel_workers);
+DECLARE_int64(query_parallel_scan_min_vertices);
+
+namespace memgraph::query::plan {
+
+namespace impl {
+
+// Returns the scan at the start of the `Aggregate` input if the input can be
+// run by parallel workers, `nullptr` otherwise. The input has to be a chain of
+// `Filter`, `Expand` and `EdgeUniquenessFilter` operators which starts with a
+// `ScanAll` or a `ScanAllByLabel` whose input is `Once`, and all of the
+// aggregations have to be mergeable.
+const ScanAll *FindParallelScan(const Aggregate &aggregate);
+
+}  // namespace impl
+
+/// Replaces the `Aggregate` operators found on the single input chain of the
+/// plan with `ParallelAggregate` if their scan is expected to produce at least
+/// `FLAGS_query_parallel_scan_min_vertices` vertices. The number of workers is
+/// `FLAGS_query_parallel_workers`, a value of 1 disables the rewrite.
+template <class TDbAccessor>
+std::unique_ptr<LogicalOperator> RewriteWithParallelAggregate(std::unique_ptr<LogicalOperator> root_op,
+                                                              TDbAccessor *db) {
+  if (FLAGS_query_parallel_workers <= 1) return root_op;
+  for (auto *op = root_op.get(); op->HasSingleInput(); op = op->input().get()) {
+    auto input = op->input();
+    if (input->GetTypeInfo() != Aggregate::kType) continue;
+    const auto &aggregate = static_cast<const Aggregate &>(*input);
+    const auto *scan = impl::FindParallelScan(aggregate);
+    if (!scan) continue;
+    const auto vertex_count = scan->GetTypeInfo() == ScanAllByLabel::kType
+                                  ? db->VerticesCount(static_cast<const ScanAllByLabel *>(scan)->label_)
+                                  : db->VerticesCount();
+    if (vertex_count < FLAGS_query_parallel_scan_min_vertices) continue;
+    op->set_input(std::make_shared<ParallelAggregate>(aggregate.input_, aggregate.aggregations_, aggregate.group_by_,
+                                                      aggregate.remember_, FLAGS_query_parallel_workers));
+  }
+  return root_op;
+}
+
+}  // namespace memgraph::query::plan
@@ -0,0 +1,37 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/plan/rewrite/top_k.hpp"
+
+namespace memgraph::query::plan {
+
+std::unique_ptr<LogicalOperator> RewriteWithTopK(std::unique_ptr<LogicalOperator> root_op) {
+  for (auto *op = root_op.get(); op->HasSingleInput(); op = op->input().get()) {
+    if (op->GetTypeInfo() != Limit::kType) continue;
+    auto *limit = static_cast<Limit *>(op);
+    // The operator whose input is replaced.
+    LogicalOperator *parent = limit;
+    Expression *skip = nullptr;
+    if (limit->input_->GetTypeInfo() == Skip::kType) {
+      auto *skip_op = static_cast<Skip *>(limit->input_.get());
+      skip = skip_op->expression_;
+      parent = skip_op;
+    }
+    const auto input = parent->input();
+    if (input->GetTypeInfo() != OrderBy::kType) continue;
+    const auto &order_by = static_cast<const OrderBy &>(*input);
+    parent->set_input(std::make_shared<TopK>(order_by.input_, order_by.compare_, order_by.order_by_,
+                                             order_by.output_symbols_, limit->expression_, skip));
+  }
+  return root_op;
+}
+
+}  // namespace memgraph::query::plan
@@ -0,0 +1,31 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// This file provides a plan rewriter which replaces `OrderBy` operations
+/// followed by a `Limit` (and a `Skip`) with `TopK`. The public entrypoint is
+/// `RewriteWithTopK`.
+
+#pragma once
+
+#include <memory>
+
+#include "query/plan/operator.hpp"
+
+namespace memgraph::query::plan {
+
+/// Replaces the `OrderBy` operators found on the single input chain of the
+/// plan with `TopK` if they are the input of a `Limit`, or of a `Skip` which
+/// is the input of a `Limit`. The `Skip` and the `Limit` are kept above the
+/// `TopK`.
+std::unique_ptr<LogicalOperator> RewriteWithTopK(std::unique_ptr<LogicalOperator> root_op);
+
+}  // namespace memgraph::query::plan
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -517,6 +517,57 @@ Expression *ExtractFilters(const std::unordered_set<Symbol> &bound_symbols, Filt
   return filter_expr;
 }
 
+size_t FindIndependentPart(const Matching &matching, size_t begin, const std::unordered_set<Symbol> &bound_symbols,
+                           const SymbolTable &symbol_table, std::unordered_set<Symbol> *part_symbols) {
+  auto end = begin;
+  for (; end < matching.expansions.size(); ++end) {
+    const auto &expansion = matching.expansions[end];
+    const auto &node1_symbol = symbol_table.at(*expansion.node1->identifier_);
+    if (utils::Contains(bound_symbols, node1_symbol)) break;
+    // Each of the following expansions has to continue from the part.
+    if (end != begin && !utils::Contains(*part_symbols, node1_symbol)) break;
+    if (!expansion.edge) {
+      part_symbols->insert(node1_symbol);
+      continue;
+    }
+    if (expansion.edge->IsVariable()) break;
+    const auto &node2_symbol = symbol_table.at(*expansion.node2->identifier_);
+    if (utils::Contains(bound_symbols, node2_symbol)) break;
+    part_symbols->insert(node1_symbol);
+    part_symbols->insert(symbol_table.at(*expansion.edge->identifier_));
+    part_symbols->insert(node2_symbol);
+  }
+  return end;
+}
+
+std::vector<HashJoinKey> FindHashJoinKeys(const std::unordered_set<Symbol> &left_symbols,
+                                          const std::unordered_set<Symbol> &right_symbols, const Filters &filters,
+                                          const SymbolTable &symbol_table) {
+  auto uses_only = [&symbol_table](Expression *expression, const std::unordered_set<Symbol> &symbols) {
+    UsedSymbolsCollector collector(symbol_table);
+    expression->Accept(collector);
+    return !collector.symbols_.empty() &&
+           std::all_of(collector.symbols_.begin(), collector.symbols_.end(),
+                       [&symbols](const auto &symbol) { return utils::Contains(symbols, symbol); });
+  };
+  std::vector<HashJoinKey> keys;
+  for (const auto &filter : filters) {
+    auto *equal = utils::Downcast<EqualOperator>(filter.expression);
+    if (!equal) continue;
+    // Property equalities are stored once for each of the compared symbols.
+    if (std::any_of(keys.begin(), keys.end(),
+                    [&filter](const auto &key) { return key.filter.expression == filter.expression; })) {
+      continue;
+    }
+    if (uses_only(equal->expression1_, left_symbols) && uses_only(equal->expression2_, right_symbols)) {
+      keys.push_back({equal->expression1_, equal->expression2_, filter});
+    } else if (uses_only(equal->expression2_, left_symbols) && uses_only(equal->expression1_, right_symbols)) {
+      keys.push_back({equal->expression2_, equal->expression1_, filter});
+    }
+  }
+  return keys;
+}
+
 std::unique_ptr<LogicalOperator> GenFilters(std::unique_ptr<LogicalOperator> last_op,
                                             const std::unordered_set<Symbol> &bound_symbols, Filters &filters,
                                             AstStorage &storage) {
@@ -84,6 +84,28 @@ Expression *ExtractFilters(const std::unordered_set<Symbol> &, Filters &, AstSto
 std::unique_ptr<LogicalOperator> GenFilters(std::unique_ptr<LogicalOperator>, const std::unordered_set<Symbol> &,
                                             Filters &, AstStorage &);
 
+// Returns the end of the part of the pattern which starts at the expansion
+// `begin` and doesn't use any of the `bound_symbols`. The part is made of the
+// connected expansions following `begin` and it ends before a variable length
+// expansion. The symbols matched by the part are stored in `part_symbols`.
+size_t FindIndependentPart(const Matching &matching, size_t begin, const std::unordered_set<Symbol> &bound_symbols,
+                           const SymbolTable &symbol_table, std::unordered_set<Symbol> *part_symbols);
+
+// Equality filter which joins two independent parts of the pattern.
+struct HashJoinKey {
+  // Side of the equality which uses only the symbols of the left part.
+  Expression *left;
+  // Side of the equality which uses only the symbols of the right part.
+  Expression *right;
+  FilterInfo filter;
+};
+
+// Finds the equality filters whose one side uses only the `left_symbols` and
+// the other side only the `right_symbols`. The filters aren't removed.
+std::vector<HashJoinKey> FindHashJoinKeys(const std::unordered_set<Symbol> &left_symbols,
+                                          const std::unordered_set<Symbol> &right_symbols, const Filters &filters,
+                                          const SymbolTable &symbol_table);
+
 /// Utility function for iterating pattern atoms and accumulating a result.
 ///
 /// Each pattern is of the form `NodeAtom (, EdgeAtom, NodeAtom)*`. Therefore,
@@ -399,128 +421,219 @@ class RuleBasedPlanner {
     // optimizes the optional match which filters only on symbols bound in
     // regular match.
     auto last_op = impl::GenFilters(std::move(input_op), bound_symbols, filters, storage);
-    for (const auto &expansion : matching.expansions) {
-      const auto &node1_symbol = symbol_table.at(*expansion.node1->identifier_);
-      if (bound_symbols.insert(node1_symbol).second) {
-        // We have just bound this symbol, so generate ScanAll which fills it.
-        last_op = std::make_unique<ScanAll>(std::move(last_op), node1_symbol, match_context.view);
-        match_context.new_symbols.emplace_back(node1_symbol);
-        last_op = impl::GenFilters(std::move(last_op), bound_symbols, filters, storage);
-        last_op = impl::GenNamedPaths(std::move(last_op), bound_symbols, named_paths);
-        last_op = impl::GenFilters(std::move(last_op), bound_symbols, filters, storage);
-      }
-      // We have an edge, so generate Expand.
-      if (expansion.edge) {
-        auto *edge = expansion.edge;
-        // If the expand symbols were already bound, then we need to indicate
-        // that they exist. The Expand will then check whether the pattern holds
-        // instead of writing the expansion to symbols.
-        const auto &node_symbol = symbol_table.at(*expansion.node2->identifier_);
-        auto existing_node = utils::Contains(bound_symbols, node_symbol);
-        const auto &edge_symbol = symbol_table.at(*edge->identifier_);
-        MG_ASSERT(!utils::Contains(bound_symbols, edge_symbol), "Existing edges are not supported");
-        std::vector<storage::EdgeTypeId> edge_types;
-        edge_types.reserve(edge->edge_types_.size());
-        for (const auto &type : edge->edge_types_) {
-          edge_types.push_back(GetEdgeType(type));
+    for (size_t i = 0; i < matching.expansions.size();) {
+      if (i > 0) {
+        if (auto end = PlanHashJoin(match_context, i, filters, named_paths, &last_op)) {
+          i = *end;
+          continue;
         }
-        if (edge->IsVariable()) {
-          std::optional<ExpansionLambda> weight_lambda;
-          std::optional<Symbol> total_weight;
-
-          if (edge->type_ == EdgeAtom::Type::WEIGHTED_SHORTEST_PATH ||
-              edge->type_ == EdgeAtom::Type::ALL_SHORTEST_PATHS) {
-            weight_lambda.emplace(ExpansionLambda{symbol_table.at(*edge->weight_lambda_.inner_edge),
-                                                  symbol_table.at(*edge->weight_lambda_.inner_node),
-                                                  edge->weight_lambda_.expression});
+      }
+      last_op = PlanExpansion(match_context, matching.expansions[i], std::move(last_op), bound_symbols, filters,
+                              named_paths);
+      ++i;
+    }
+    MG_ASSERT(named_paths.empty(), "Expected to generate all named paths");
+    // We bound all named path symbols, so just add them to new_symbols.
+    for (const auto &named_path : matching.named_paths) {
+      MG_ASSERT(utils::Contains(bound_symbols, named_path.first), "Expected generated named path to have bound symbol");
+      match_context.new_symbols.emplace_back(named_path.first);
+    }
+    MG_ASSERT(filters.empty(), "Expected to generate all filters");
+    return last_op;
+  }
 
-            total_weight.emplace(symbol_table.at(*edge->total_weight_));
-          }
+  // Plans a single expansion on top of `last_op`, binding its symbols into
+  // `bound_symbols` and generating the filters and named paths which become
+  // available.
+  std::unique_ptr<LogicalOperator> PlanExpansion(MatchContext &match_context, const Expansion &expansion,
+                                                 std::unique_ptr<LogicalOperator> last_op,
+                                                 std::unordered_set<Symbol> &bound_symbols, Filters &filters,
+                                                 std::unordered_map<Symbol, std::vector<Symbol>> &named_paths) {
+    auto &storage = *context_->ast_storage;
+    const auto &symbol_table = match_context.symbol_table;
+    const auto &matching = match_context.matching;
+    const auto &node1_symbol = symbol_table.at(*expansion.node1->identifier_);
+    if (bound_symbols.insert(node1_symbol).second) {
+      // We have just bound this symbol, so generate ScanAll which fills it.
+      last_op = std::make_unique<ScanAll>(std::move(last_op), node1_symbol, match_context.view);
+      match_context.new_symbols.emplace_back(node1_symbol);
+      last_op = impl::GenFilters(std::move(last_op), bound_symbols, filters, storage);
+      last_op = impl::GenNamedPaths(std::move(last_op), bound_symbols, named_paths);
+      last_op = impl::GenFilters(std::move(last_op), bound_symbols, filters, storage);
+    }
+    // We have an edge, so generate Expand.
+    if (expansion.edge) {
+      auto *edge = expansion.edge;
+      // If the expand symbols were already bound, then we need to indicate
+      // that they exist. The Expand will then check whether the pattern holds
+      // instead of writing the expansion to symbols.
+      const auto &node_symbol = symbol_table.at(*expansion.node2->identifier_);
+      auto existing_node = utils::Contains(bound_symbols, node_symbol);
+      const auto &edge_symbol = symbol_table.at(*edge->identifier_);
+      MG_ASSERT(!utils::Contains(bound_symbols, edge_symbol), "Existing edges are not supported");
+      std::vector<storage::EdgeTypeId> edge_types;
+      edge_types.reserve(edge->edge_types_.size());
+      for (const auto &type : edge->edge_types_) {
+        edge_types.push_back(GetEdgeType(type));
+      }
+      if (edge->IsVariable()) {
+        std::optional<ExpansionLambda> weight_lambda;
+        std::optional<Symbol> total_weight;
 
-          ExpansionLambda filter_lambda;
-          filter_lambda.inner_edge_symbol = symbol_table.at(*edge->filter_lambda_.inner_edge);
-          filter_lambda.inner_node_symbol = symbol_table.at(*edge->filter_lambda_.inner_node);
-          {
-            // Bind the inner edge and node symbols so they're available for
-            // inline filtering in ExpandVariable.
-            bool inner_edge_bound = bound_symbols.insert(filter_lambda.inner_edge_symbol).second;
-            bool inner_node_bound = bound_symbols.insert(filter_lambda.inner_node_symbol).second;
-            MG_ASSERT(inner_edge_bound && inner_node_bound, "An inner edge and node can't be bound from before");
-          }
-          // Join regular filters with lambda filter expression, so that they
-          // are done inline together. Semantic analysis should guarantee that
-          // lambda filtering uses bound symbols.
-          filter_lambda.expression = impl::BoolJoin<AndOperator>(
-              storage, impl::ExtractFilters(bound_symbols, filters, storage), edge->filter_lambda_.expression);
-          // At this point it's possible we have leftover filters for inline
-          // filtering (they use the inner symbols. If they were not collected,
-          // we have to remove them manually because no other filter-extraction
-          // will ever bind them again.
-          filters.erase(std::remove_if(
-                            filters.begin(), filters.end(),
-                            [e = filter_lambda.inner_edge_symbol, n = filter_lambda.inner_node_symbol](FilterInfo &fi) {
-                              return utils::Contains(fi.used_symbols, e) || utils::Contains(fi.used_symbols, n);
-                            }),
-                        filters.end());
-          // Unbind the temporarily bound inner symbols for filtering.
-          bound_symbols.erase(filter_lambda.inner_edge_symbol);
-          bound_symbols.erase(filter_lambda.inner_node_symbol);
-
-          if (total_weight) {
-            bound_symbols.insert(*total_weight);
-          }
+        if (edge->type_ == EdgeAtom::Type::WEIGHTED_SHORTEST_PATH ||
+            edge->type_ == EdgeAtom::Type::ALL_SHORTEST_PATHS) {
+          weight_lambda.emplace(ExpansionLambda{symbol_table.at(*edge->weight_lambda_.inner_edge),
+                                                symbol_table.at(*edge->weight_lambda_.inner_node),
+                                                edge->weight_lambda_.expression});
 
-          // TODO: Pass weight lambda.
-          MG_ASSERT(match_context.view == storage::View::OLD,
-                    "ExpandVariable should only be planned with storage::View::OLD");
-          last_op = std::make_unique<ExpandVariable>(std::move(last_op), node1_symbol, node_symbol, edge_symbol,
-                                                     edge->type_, expansion.direction, edge_types, expansion.is_flipped,
-                                                     edge->lower_bound_, edge->upper_bound_, existing_node,
-                                                     filter_lambda, weight_lambda, total_weight);
-        } else {
-          last_op = std::make_unique<Expand>(std::move(last_op), node1_symbol, node_symbol, edge_symbol,
-                                             expansion.direction, edge_types, existing_node, match_context.view);
+          total_weight.emplace(symbol_table.at(*edge->total_weight_));
         }
 
-        // Bind the expanded edge and node.
-        bound_symbols.insert(edge_symbol);
-        match_context.new_symbols.emplace_back(edge_symbol);
-        if (bound_symbols.insert(node_symbol).second) {
-          match_context.new_symbols.emplace_back(node_symbol);
+        ExpansionLambda filter_lambda;
+        filter_lambda.inner_edge_symbol = symbol_table.at(*edge->filter_lambda_.inner_edge);
+        filter_lambda.inner_node_symbol = symbol_table.at(*edge->filter_lambda_.inner_node);
+        {
+          // Bind the inner edge and node symbols so they're available for
+          // inline filtering in ExpandVariable.
+          bool inner_edge_bound = bound_symbols.insert(filter_lambda.inner_edge_symbol).second;
+          bool inner_node_bound = bound_symbols.insert(filter_lambda.inner_node_symbol).second;
+          MG_ASSERT(inner_edge_bound && inner_node_bound, "An inner edge and node can't be bound from before");
+        }
+        // Join regular filters with lambda filter expression, so that they
+        // are done inline together. Semantic analysis should guarantee that
+        // lambda filtering uses bound symbols.
+        filter_lambda.expression = impl::BoolJoin<AndOperator>(
+            storage, impl::ExtractFilters(bound_symbols, filters, storage), edge->filter_lambda_.expression);
+        // At this point it's possible we have leftover filters for inline
+        // filtering (they use the inner symbols. If they were not collected,
+        // we have to remove them manually because no other filter-extraction
+        // will ever bind them again.
+        filters.erase(std::remove_if(
+                          filters.begin(), filters.end(),
+                          [e = filter_lambda.inner_edge_symbol, n = filter_lambda.inner_node_symbol](FilterInfo &fi) {
+                            return utils::Contains(fi.used_symbols, e) || utils::Contains(fi.used_symbols, n);
+                          }),
+                      filters.end());
+        // Unbind the temporarily bound inner symbols for filtering.
+        bound_symbols.erase(filter_lambda.inner_edge_symbol);
+        bound_symbols.erase(filter_lambda.inner_node_symbol);
+
+        if (total_weight) {
+          bound_symbols.insert(*total_weight);
         }
 
-        // Ensure Cyphermorphism (different edge symbols always map to
-        // different edges).
-        for (const auto &edge_symbols : matching.edge_symbols) {
-          if (edge_symbols.find(edge_symbol) == edge_symbols.end()) {
+        // TODO: Pass weight lambda.
+        MG_ASSERT(match_context.view == storage::View::OLD,
+                  "ExpandVariable should only be planned with storage::View::OLD");
+        last_op = std::make_unique<ExpandVariable>(std::move(last_op), node1_symbol, node_symbol, edge_symbol,
+                                                   edge->type_, expansion.direction, edge_types, expansion.is_flipped,
+                                                   edge->lower_bound_, edge->upper_bound_, existing_node,
+                                                   filter_lambda, weight_lambda, total_weight);
+      } else {
+        last_op = std::make_unique<Expand>(std::move(last_op), node1_symbol, node_symbol, edge_symbol,
+                                           expansion.direction, edge_types, existing_node, match_context.view);
+      }
+
+      // Bind the expanded edge and node.
+      bound_symbols.insert(edge_symbol);
+      match_context.new_symbols.emplace_back(edge_symbol);
+      if (bound_symbols.insert(node_symbol).second) {
+        match_context.new_symbols.emplace_back(node_symbol);
+      }
+
+      // Ensure Cyphermorphism (different edge symbols always map to
+      // different edges).
+      for (const auto &edge_symbols : matching.edge_symbols) {
+        if (edge_symbols.find(edge_symbol) == edge_symbols.end()) {
+          continue;
+        }
+        std::vector<Symbol> other_symbols;
+        for (const auto &symbol : edge_symbols) {
+          if (symbol == edge_symbol || bound_symbols.find(symbol) == bound_symbols.end()) {
             continue;
           }
-          std::vector<Symbol> other_symbols;
-          for (const auto &symbol : edge_symbols) {
-            if (symbol == edge_symbol || bound_symbols.find(symbol) == bound_symbols.end()) {
-              continue;
-            }
-            other_symbols.push_back(symbol);
-          }
-          if (!other_symbols.empty()) {
-            last_op = std::make_unique<EdgeUniquenessFilter>(std::move(last_op), edge_symbol, other_symbols);
-          }
+          other_symbols.push_back(symbol);
+        }
+        if (!other_symbols.empty()) {
+          last_op = std::make_unique<EdgeUniquenessFilter>(std::move(last_op), edge_symbol, other_symbols);
         }
-        last_op = impl::GenFilters(std::move(last_op), bound_symbols, filters, storage);
-        last_op = impl::GenNamedPaths(std::move(last_op), bound_symbols, named_paths);
-        last_op = impl::GenFilters(std::move(last_op), bound_symbols, filters, storage);
       }
+      last_op = impl::GenFilters(std::move(last_op), bound_symbols, filters, storage);
+      last_op = impl::GenNamedPaths(std::move(last_op), bound_symbols, named_paths);
+      last_op = impl::GenFilters(std::move(last_op), bound_symbols, filters, storage);
     }
-    MG_ASSERT(named_paths.empty(), "Expected to generate all named paths");
-    // We bound all named path symbols, so just add them to new_symbols.
-    for (const auto &named_path : matching.named_paths) {
-      MG_ASSERT(utils::Contains(bound_symbols, named_path.first), "Expected generated named path to have bound symbol");
-      match_context.new_symbols.emplace_back(named_path.first);
-    }
-    MG_ASSERT(filters.empty(), "Expected to generate all filters");
     return last_op;
   }
 
+  // Plans the part of the pattern which starts at the expansion `begin` and
+  // doesn't use any of the already bound symbols as the right branch of a
+  // `HashJoin`, if the part is joined with the bound symbols by equality
+  // filters. Otherwise, the part would be matched again for each of the rows
+  // of `last_op`. Returns the index of the first expansion after the planned
+  // part, or `std::nullopt` if no join was planned.
+  std::optional<size_t> PlanHashJoin(MatchContext &match_context, size_t begin, Filters &filters,
+                                     std::unordered_map<Symbol, std::vector<Symbol>> &named_paths,
+                                     std::unique_ptr<LogicalOperator> *last_op) {
+    // Clauses which write may change the graph between the pulls of the
+    // branches, so they keep matching the pattern for each row.
+    if (match_context.view != storage::View::OLD) return std::nullopt;
+    auto &bound_symbols = match_context.bound_symbols;
+    auto &storage = *context_->ast_storage;
+    const auto &symbol_table = match_context.symbol_table;
+    const auto &matching = match_context.matching;
+    std::unordered_set<Symbol> part_symbols;
+    const auto end = impl::FindIndependentPart(matching, begin, bound_symbols, symbol_table, &part_symbols);
+    if (end == begin) return std::nullopt;
+    auto keys = impl::FindHashJoinKeys(bound_symbols, part_symbols, filters, symbol_table);
+    if (keys.empty()) return std::nullopt;
+    // A lookup in a label-property index for each of the rows is cheaper than
+    // building the hash table over the whole part, so keep the nested loop.
+    for (const auto &key : keys) {
+      auto *property_lookup = utils::Downcast<PropertyLookup>(key.right);
+      if (!property_lookup) continue;
+      auto *identifier = utils::Downcast<Identifier>(property_lookup->expression_);
+      if (!identifier) continue;
+      const auto property = GetProperty(property_lookup->property_);
+      for (const auto &label : filters.FilteredLabels(symbol_table.at(*identifier))) {
+        if (context_->db->LabelPropertyIndexExists(GetLabel(label), property)) return std::nullopt;
+      }
+    }
+    std::vector<Expression *> left_keys;
+    std::vector<Expression *> right_keys;
+    for (const auto &key : keys) {
+      left_keys.push_back(key.left);
+      right_keys.push_back(key.right);
+      filters.EraseFilter(key.filter);
+    }
+    std::unordered_set<Symbol> right_bound_symbols;
+    std::unique_ptr<LogicalOperator> right_op = std::make_unique<Once>();
+    for (auto i = begin; i < end; ++i) {
+      right_op = PlanExpansion(match_context, matching.expansions[i], std::move(right_op), right_bound_symbols, filters,
+                               named_paths);
+    }
+    auto left_symbols = (*last_op)->ModifiedSymbols(symbol_table);
+    auto right_symbols = right_op->ModifiedSymbols(symbol_table);
+    *last_op = std::make_unique<HashJoin>(std::move(*last_op), left_symbols, std::move(right_op), right_symbols,
+                                          left_keys, right_keys);
+    // Ensure Cyphermorphism between the edges matched in different branches.
+    for (const auto &edge_symbols : matching.edge_symbols) {
+      std::vector<Symbol> left_edges;
+      for (const auto &symbol : edge_symbols) {
+        if (utils::Contains(bound_symbols, symbol)) left_edges.push_back(symbol);
+      }
+      if (left_edges.empty()) continue;
+      for (const auto &symbol : edge_symbols) {
+        if (!utils::Contains(right_bound_symbols, symbol)) continue;
+        *last_op = std::make_unique<EdgeUniquenessFilter>(std::move(*last_op), symbol, left_edges);
+      }
+    }
+    bound_symbols.insert(right_bound_symbols.begin(), right_bound_symbols.end());
+    *last_op = impl::GenFilters(std::move(*last_op), bound_symbols, filters, storage);
+    *last_op = impl::GenNamedPaths(std::move(*last_op), bound_symbols, named_paths);
+    *last_op = impl::GenFilters(std::move(*last_op), bound_symbols, filters, storage);
+    return end;
+  }
+
   auto GenMerge(query::Merge &merge, std::unique_ptr<LogicalOperator> input_op, const Matching &matching) {
     // Copy the bound symbol set, because we don't want to use the updated
     // version when generating the create part.
@@ -0,0 +1,249 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/plan/spill_file.hpp"
+
+#include <string>
+
+#include "query/exceptions.hpp"
+#include "utils/cast.hpp"
+#include "utils/file.hpp"
+#include "utils/logging.hpp"
+#include "utils/uuid.hpp"
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_order_by_memory_limit_mb, 0,
+              "Memory (in MiB) which ORDER BY may use to hold the rows of a query before it starts spilling sorted "
+              "runs of rows to disk. Default is 0, which disables spilling. Rows which hold graph elements are never "
+              "spilled.");
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_string(query_order_by_spill_directory, "",
+              "Directory where ORDER BY spills the rows which don't fit into its memory limit. Default is a directory "
+              "in the system's temporary directory.");
+
+namespace memgraph::query::plan {
+
+namespace {
+
+std::filesystem::path SpillDirectory() {
+  if (!FLAGS_query_order_by_spill_directory.empty()) return FLAGS_query_order_by_spill_directory;
+  return std::filesystem::temp_directory_path() / "memgraph" / "order_by";
+}
+
+}  // namespace
+
+bool IsSpillable(const TypedValue &value) {
+  switch (value.type()) {
+    case TypedValue::Type::List:
+      for (const auto &element : value.ValueList()) {
+        if (!IsSpillable(element)) return false;
+      }
+      return true;
+    case TypedValue::Type::Map:
+      for (const auto &[key, element] : value.ValueMap()) {
+        if (!IsSpillable(element)) return false;
+      }
+      return true;
+    case TypedValue::Type::Vertex:
+    case TypedValue::Type::Edge:
+    case TypedValue::Type::Path:
+    case TypedValue::Type::Graph:
+      return false;
+    default:
+      return value.IsPropertyValue();
+  }
+}
+
+size_t EstimateMemoryUsage(const TypedValue &value) {
+  size_t size = sizeof(TypedValue);
+  switch (value.type()) {
+    case TypedValue::Type::String:
+      size += value.ValueString().capacity();
+      break;
+    case TypedValue::Type::List:
+      for (const auto &element : value.ValueList()) size += EstimateMemoryUsage(element);
+      break;
+    case TypedValue::Type::Map:
+      for (const auto &[key, element] : value.ValueMap()) {
+        // The key and the pointers of the tree node.
+        size += sizeof(TypedValue::TString) + key.capacity() + 4 * sizeof(void *) + EstimateMemoryUsage(element);
+      }
+      break;
+    default:
+      break;
+  }
+  return size;
+}
+
+SpillFile::SpillFile() {
+  const auto directory = SpillDirectory();
+  if (!utils::EnsureDir(directory)) {
+    throw QueryRuntimeException("Couldn't create the directory {} for the rows spilled by ORDER BY.",
+                                directory.string());
+  }
+  path_ = directory / utils::GenerateUUID();
+  output_.open(path_, std::ios::binary | std::ios::trunc);
+  if (!output_) {
+    throw QueryRuntimeException("Couldn't create the file {} for the rows spilled by ORDER BY.", path_.string());
+  }
+}
+
+SpillFile::~SpillFile() {
+  output_.close();
+  input_.close();
+  utils::DeleteFile(path_);
+}
+
+void SpillFile::Write(const TypedValue &value) { WriteValue(value); }
+
+void SpillFile::FinishWriting() {
+  output_.close();
+  if (!output_) {
+    throw QueryRuntimeException("Couldn't write the rows spilled by ORDER BY to {}.", path_.string());
+  }
+  input_.open(path_, std::ios::binary);
+  if (!input_) {
+    throw QueryRuntimeException("Couldn't open the file {} with the rows spilled by ORDER BY.", path_.string());
+  }
+}
+
+TypedValue SpillFile::Read(utils::MemoryResource *memory) { return ReadValue(memory); }
+
+// The file is only read by the process which wrote it, so the values are
+// written in the host byte order.
+void SpillFile::WriteBytes(const void *data, size_t size) {
+  output_.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+  if (!output_) {
+    throw QueryRuntimeException("Couldn't write the rows spilled by ORDER BY to {}.", path_.string());
+  }
+}
+
+void SpillFile::WriteUint(uint64_t value) { WriteBytes(&value, sizeof(value)); }
+
+void SpillFile::WriteValue(const TypedValue &value) {
+  const auto type = static_cast<uint8_t>(value.type());
+  WriteBytes(&type, sizeof(type));
+  switch (value.type()) {
+    case TypedValue::Type::Null:
+      break;
+    case TypedValue::Type::Bool:
+      WriteUint(value.ValueBool() ? 1 : 0);
+      break;
+    case TypedValue::Type::Int:
+      WriteUint(utils::MemcpyCast<uint64_t>(value.ValueInt()));
+      break;
+    case TypedValue::Type::Double:
+      WriteUint(utils::MemcpyCast<uint64_t>(value.ValueDouble()));
+      break;
+    case TypedValue::Type::String: {
+      const auto &string = value.ValueString();
+      WriteUint(string.size());
+      WriteBytes(string.data(), string.size());
+      break;
+    }
+    case TypedValue::Type::List:
+      WriteUint(value.ValueList().size());
+      for (const auto &element : value.ValueList()) WriteValue(element);
+      break;
+    case TypedValue::Type::Map:
+      WriteUint(value.ValueMap().size());
+      for (const auto &[key, element] : value.ValueMap()) {
+        WriteUint(key.size());
+        WriteBytes(key.data(), key.size());
+        WriteValue(element);
+      }
+      break;
+    case TypedValue::Type::Date:
+      WriteUint(utils::MemcpyCast<uint64_t>(value.ValueDate().MicrosecondsSinceEpoch()));
+      break;
+    case TypedValue::Type::LocalTime:
+      WriteUint(utils::MemcpyCast<uint64_t>(value.ValueLocalTime().MicrosecondsSinceEpoch()));
+      break;
+    case TypedValue::Type::LocalDateTime:
+      WriteUint(utils::MemcpyCast<uint64_t>(value.ValueLocalDateTime().MicrosecondsSinceEpoch()));
+      break;
+    case TypedValue::Type::Duration:
+      WriteUint(utils::MemcpyCast<uint64_t>(value.ValueDuration().microseconds));
+      break;
+    case TypedValue::Type::Vertex:
+    case TypedValue::Type::Edge:
+    case TypedValue::Type::Path:
+    case TypedValue::Type::Graph:
+      LOG_FATAL("Graph elements can't be spilled by ORDER BY!");
+  }
+}
+
+void SpillFile::ReadBytes(void *data, size_t size) {
+  input_.read(static_cast<char *>(data), static_cast<std::streamsize>(size));
+  if (!input_) {
+    throw QueryRuntimeException("Couldn't read the rows spilled by ORDER BY from {}.", path_.string());
+  }
+}
+
+uint64_t SpillFile::ReadUint() {
+  uint64_t value{0};
+  ReadBytes(&value, sizeof(value));
+  return value;
+}
+
+TypedValue SpillFile::ReadValue(utils::MemoryResource *memory) {
+  uint8_t type{0};
+  ReadBytes(&type, sizeof(type));
+  switch (static_cast<TypedValue::Type>(type)) {
+    case TypedValue::Type::Null:
+      return TypedValue(memory);
+    case TypedValue::Type::Bool:
+      return TypedValue(ReadUint() != 0, memory);
+    case TypedValue::Type::Int:
+      return TypedValue(utils::MemcpyCast<int64_t>(ReadUint()), memory);
+    case TypedValue::Type::Double:
+      return TypedValue(utils::MemcpyCast<double>(ReadUint()), memory);
+    case TypedValue::Type::String: {
+      TypedValue::TString string(ReadUint(), '\0', memory);
+      ReadBytes(string.data(), string.size());
+      return TypedValue(std::move(string), memory);
+    }
+    case TypedValue::Type::List: {
+      const auto size = ReadUint();
+      TypedValue::TVector list(memory);
+      list.reserve(size);
+      for (uint64_t i = 0; i < size; ++i) list.emplace_back(ReadValue(memory));
+      return TypedValue(std::move(list), memory);
+    }
+    case TypedValue::Type::Map: {
+      const auto size = ReadUint();
+      TypedValue::TMap map(memory);
+      for (uint64_t i = 0; i < size; ++i) {
+        TypedValue::TString key(ReadUint(), '\0', memory);
+        ReadBytes(key.data(), key.size());
+        map.emplace(std::move(key), ReadValue(memory));
+      }
+      return TypedValue(std::move(map), memory);
+    }
+    case TypedValue::Type::Date:
+      return TypedValue(utils::Date(utils::MemcpyCast<int64_t>(ReadUint())), memory);
+    case TypedValue::Type::LocalTime:
+      return TypedValue(utils::LocalTime(utils::MemcpyCast<int64_t>(ReadUint())), memory);
+    case TypedValue::Type::LocalDateTime:
+      return TypedValue(utils::LocalDateTime(utils::MemcpyCast<int64_t>(ReadUint())), memory);
+    case TypedValue::Type::Duration:
+      return TypedValue(utils::Duration(utils::MemcpyCast<int64_t>(ReadUint())), memory);
+    case TypedValue::Type::Vertex:
+    case TypedValue::Type::Edge:
+    case TypedValue::Type::Path:
+    case TypedValue::Type::Graph:
+      break;
+  }
+  throw QueryRuntimeException("Couldn't read the rows spilled by ORDER BY from {}.", path_.string());
+}
+
+}  // namespace memgraph::query::plan
@@ -0,0 +1,86 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// This file provides the temporary files to which `OrderBy` spills the
+/// sorted runs of rows which don't fit into its memory limit.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+#include <gflags/gflags.h>
+
+#include "query/typed_value.hpp"
+#include "utils/memory.hpp"
+
+DECLARE_uint64(query_order_by_memory_limit_mb);
+DECLARE_string(query_order_by_spill_directory);
+
+namespace memgraph::query::plan {
+
+/// Returns true if the value can be written to a `SpillFile`. Graph elements
+/// (vertices, edges, paths and graphs) can't be spilled, because they are only
+/// valid in the memory of the transaction.
+bool IsSpillable(const TypedValue &value);
+
+/// Returns an estimate of the memory used by the value, including the memory
+/// of its elements.
+size_t EstimateMemoryUsage(const TypedValue &value);
+
+/// A temporary file which holds a sequence of values. The values are written
+/// first and then read back once, in the same order. The file is deleted when
+/// the object is destroyed.
+///
+/// The files are created in `FLAGS_query_order_by_spill_directory`. Failing to
+/// write or read a file only fails the query which spilled the rows, so a full
+/// disk doesn't bring down the database.
+class SpillFile {
+ public:
+  /// @throw QueryRuntimeException if the directory or the file can't be created.
+  SpillFile();
+  ~SpillFile();
+
+  SpillFile(const SpillFile &) = delete;
+  SpillFile &operator=(const SpillFile &) = delete;
+  SpillFile(SpillFile &&) = delete;
+  SpillFile &operator=(SpillFile &&) = delete;
+
+  /// Appends the value, which has to be spillable.
+  /// @throw QueryRuntimeException if the value can't be written.
+  void Write(const TypedValue &value);
+
+  /// Finishes writing the file, so that the values can be read.
+  /// @throw QueryRuntimeException if the file can't be written or opened.
+  void FinishWriting();
+
+  /// Reads the next value and allocates it from `memory`.
+  /// @throw QueryRuntimeException if the value can't be read.
+  TypedValue Read(utils::MemoryResource *memory);
+
+ private:
+  void WriteBytes(const void *data, size_t size);
+  void WriteUint(uint64_t value);
+  void WriteValue(const TypedValue &value);
+
+  void ReadBytes(void *data, size_t size);
+  uint64_t ReadUint();
+  TypedValue ReadValue(utils::MemoryResource *memory);
+
+  std::filesystem::path path_;
+  std::ofstream output_;
+  std::ifstream input_;
+};
+
+}  // namespace memgraph::query::plan
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -11,6 +11,7 @@
 
 #include "query/plan/variable_start_planner.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <queue>
 
@@ -21,6 +22,13 @@
 DEFINE_VALIDATED_uint64(query_max_plans, 1000U, "Maximum number of generated plans for a query.",
                         FLAG_IN_RANGE(1, std::numeric_limits<std::uint64_t>::max()));
 
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_uint64(query_join_order_budget, 1000U,
+                        "Maximum number of partial expansion orders which are considered when ordering the expansions "
+                        "of a pattern from a single starting node. When the budget is exceeded, the expansions are "
+                        "ordered greedily.",
+                        FLAG_IN_RANGE(0, std::numeric_limits<std::uint64_t>::max()));
+
 namespace memgraph::query::plan::impl {
 
 namespace {
@@ -140,6 +148,213 @@ std::vector<Expansion> ExpansionsFrom(const NodeAtom *start_node, const Matching
   return expansions;
 }
 
+// Single step of an expansion order.
+struct ExpansionStep {
+  // Index of the expansion in `Matching::expansions`.
+  size_t index{0};
+  // True if the expansion is started from `node2`, so it needs to be flipped.
+  bool flip{false};
+  // Factor by which the expansion multiplies the number of produced rows.
+  double factor{1};
+};
+
+// Enumerates the orders of the expansions of a matching. The performed
+// expansions are tracked with a bit mask, so at most `kMaxExpansions` can be
+// ordered.
+class ExpansionOrdering {
+ public:
+  static constexpr size_t kMaxExpansions = 64;
+
+  ExpansionOrdering(const Symbol &start, const Matching &matching, const SymbolTable &symbol_table,
+                    const PatternEstimates &estimates)
+      : start_(start), matching_(matching), estimates_(estimates) {
+    MG_ASSERT(matching.expansions.size() <= kMaxExpansions, "Too many expansions to order");
+    symbols_.reserve(matching.expansions.size());
+    for (const auto &expansion : matching.expansions) {
+      auto &symbols = symbols_.emplace_back();
+      symbols.node1 = symbol_table.at(*expansion.node1->identifier_);
+      if (!expansion.edge) continue;
+      symbols.edge = symbol_table.at(*expansion.edge->identifier_);
+      symbols.node2 = symbol_table.at(*expansion.node2->identifier_);
+    }
+  }
+
+  // Finds the order with the smallest sum of the intermediate result sizes
+  // using dynamic programming over the sets of performed expansions. All of
+  // the orders which perform the same set of expansions continue the same
+  // way, so only the cheapest one is kept. Returns `std::nullopt` if the
+  // number of the considered sets exceeds `budget`.
+  std::optional<std::vector<ExpansionStep>> FindCheapest(uint64_t budget) const {
+    struct State {
+      double cardinality;
+      double cost;
+      uint64_t previous;
+      ExpansionStep step;
+    };
+    std::unordered_map<uint64_t, State> states{{0, State{NodeCardinality(start_), 0, 0, {}}}};
+    std::vector<uint64_t> layer{0};
+    while (true) {
+      std::vector<uint64_t> next_layer;
+      for (const auto mask : layer) {
+        const auto state = states.at(mask);
+        for (const auto &step : NextSteps(mask)) {
+          const auto next = mask | (uint64_t{1} << step.index);
+          const auto cardinality = state.cardinality * step.factor;
+          const State next_state{cardinality, state.cost + cardinality, mask, step};
+          auto [it, inserted] = states.try_emplace(next, next_state);
+          if (inserted) {
+            if (states.size() > budget) return std::nullopt;
+            next_layer.push_back(next);
+          } else if (next_state.cost < it->second.cost) {
+            it->second = next_state;
+          }
+        }
+      }
+      if (next_layer.empty()) break;
+      // Sort the sets, so that the ties are always resolved the same way.
+      std::sort(next_layer.begin(), next_layer.end());
+      layer = std::move(next_layer);
+    }
+    auto mask = *std::min_element(layer.begin(), layer.end(),
+                                  [&](auto lhs, auto rhs) { return states.at(lhs).cost < states.at(rhs).cost; });
+    std::vector<ExpansionStep> steps;
+    while (mask != 0) {
+      const auto &state = states.at(mask);
+      steps.push_back(state.step);
+      mask = state.previous;
+    }
+    std::reverse(steps.begin(), steps.end());
+    return steps;
+  }
+
+  // Orders the expansions by always picking the one which produces the
+  // smallest result.
+  std::vector<ExpansionStep> FindGreedy() const {
+    std::vector<ExpansionStep> steps;
+    uint64_t mask = 0;
+    while (true) {
+      const auto next_steps = NextSteps(mask);
+      if (next_steps.empty()) break;
+      const auto &step = *std::min_element(next_steps.begin(), next_steps.end(),
+                                           [](const auto &lhs, const auto &rhs) { return lhs.factor < rhs.factor; });
+      steps.push_back(step);
+      mask |= uint64_t{1} << step.index;
+    }
+    return steps;
+  }
+
+  // Creates the expansions in the order of the given steps. The expansions
+  // which weren't ordered are appended in their original order.
+  std::vector<Expansion> Apply(const std::vector<ExpansionStep> &steps) const {
+    std::vector<Expansion> expansions;
+    expansions.reserve(matching_.expansions.size());
+    std::vector<bool> seen(matching_.expansions.size(), false);
+    for (const auto &step : steps) {
+      auto expansion = matching_.expansions[step.index];
+      if (step.flip) {
+        std::swap(expansion.node1, expansion.node2);
+        expansion.is_flipped = true;
+        if (expansion.direction != EdgeAtom::Direction::BOTH) {
+          expansion.direction =
+              expansion.direction == EdgeAtom::Direction::IN ? EdgeAtom::Direction::OUT : EdgeAtom::Direction::IN;
+        }
+      }
+      expansions.emplace_back(std::move(expansion));
+      seen[step.index] = true;
+    }
+    for (size_t i = 0; i < matching_.expansions.size(); ++i) {
+      if (!seen[i]) expansions.emplace_back(matching_.expansions[i]);
+    }
+    return expansions;
+  }
+
+ private:
+  struct ExpansionSymbols {
+    Symbol node1;
+    std::optional<Symbol> edge;
+    std::optional<Symbol> node2;
+  };
+
+  double NodeCardinality(const Symbol &symbol) const {
+    auto found = estimates_.node_cardinalities.find(symbol);
+    return found == estimates_.node_cardinalities.end() ? estimates_.vertex_count : found->second;
+  }
+
+  double EdgeDegree(const Symbol &symbol) const {
+    auto found = estimates_.edge_degrees.find(symbol);
+    return found == estimates_.edge_degrees.end() ? estimates_.average_degree : found->second;
+  }
+
+  std::unordered_set<Symbol> BoundSymbols(uint64_t mask) const {
+    std::unordered_set<Symbol> bound_symbols{start_};
+    for (size_t i = 0; i < symbols_.size(); ++i) {
+      if (!(mask & (uint64_t{1} << i))) continue;
+      bound_symbols.insert(symbols_[i].node1);
+      if (symbols_[i].edge) {
+        bound_symbols.insert(*symbols_[i].edge);
+        bound_symbols.insert(*symbols_[i].node2);
+      }
+    }
+    return bound_symbols;
+  }
+
+  // Estimates the factor of the expansion when it is started from `from`. A
+  // node which isn't bound yet is scanned, while the node at the other end of
+  // the edge is filtered by its selectivity. When both ends are bound, the
+  // edge has to close the cycle.
+  double StepFactor(const ExpansionSymbols &symbols, const Symbol &from, const Symbol &to,
+                    const std::unordered_set<Symbol> &bound_symbols) const {
+    auto factor = bound_symbols.contains(from) ? 1.0 : NodeCardinality(from);
+    if (!symbols.edge) return factor;
+    const auto is_to_bound = to == from || bound_symbols.contains(to);
+    return factor * EdgeDegree(*symbols.edge) * (is_to_bound ? 1.0 : NodeCardinality(to)) / estimates_.vertex_count;
+  }
+
+  // Returns the expansions which can be performed after the expansions in
+  // `mask`. The expansions connected to the bound symbols are preferred, a new
+  // part of the pattern is started only if there are none.
+  std::vector<ExpansionStep> NextSteps(uint64_t mask) const {
+    const auto bound_symbols = BoundSymbols(mask);
+    // Same as in `AddNextExpansions`, the symbols used in the range of a
+    // variable path expand have to be bound before the expansion.
+    auto can_expand = [&](const Expansion &expansion) {
+      return std::all_of(expansion.symbols_in_range.begin(), expansion.symbols_in_range.end(), [&](const auto &symbol) {
+        return !matching_.expansion_symbols.contains(symbol) || bound_symbols.contains(symbol);
+      });
+    };
+    std::vector<ExpansionStep> connected;
+    std::vector<ExpansionStep> disconnected;
+    for (size_t i = 0; i < symbols_.size(); ++i) {
+      if (mask & (uint64_t{1} << i)) continue;
+      const auto &expansion = matching_.expansions[i];
+      if (!can_expand(expansion)) continue;
+      const auto &symbols = symbols_[i];
+      if (!symbols.edge) {
+        auto &steps = bound_symbols.contains(symbols.node1) ? connected : disconnected;
+        steps.push_back({i, false, StepFactor(symbols, symbols.node1, symbols.node1, bound_symbols)});
+        continue;
+      }
+      // BFS must *not* be flipped. Doing that changes the BFS results.
+      const auto can_flip = expansion.edge->type_ != EdgeAtom::Type::BREADTH_FIRST;
+      const auto forward = StepFactor(symbols, symbols.node1, *symbols.node2, bound_symbols);
+      const auto backward = StepFactor(symbols, *symbols.node2, symbols.node1, bound_symbols);
+      auto flip = false;
+      if (can_flip && !bound_symbols.contains(symbols.node1)) {
+        flip = bound_symbols.contains(*symbols.node2) || backward < forward;
+      }
+      auto &steps = bound_symbols.contains(symbols.node1) || bound_symbols.contains(*symbols.node2) ? connected
+                                                                                                   : disconnected;
+      steps.push_back({i, flip, flip ? backward : forward});
+    }
+    return connected.empty() ? disconnected : connected;
+  }
+
+  Symbol start_;
+  const Matching &matching_;
+  const PatternEstimates &estimates_;
+  std::vector<ExpansionSymbols> symbols_;
+};
+
 // Collect all unique nodes from expansions. Uniqueness is determined by
 // symbol uniqueness.
 auto ExpansionNodes(const std::vector<Expansion> &expansions, const SymbolTable &symbol_table) {
@@ -157,8 +372,27 @@ auto ExpansionNodes(const std::vector<Expansion> &expansions, const SymbolTable
 
 }  // namespace
 
-VaryMatchingStart::VaryMatchingStart(Matching matching, const SymbolTable &symbol_table)
-    : matching_(matching), symbol_table_(symbol_table), nodes_(ExpansionNodes(matching.expansions, symbol_table)) {}
+std::vector<Expansion> OrderExpansions(const NodeAtom *start_node, const Matching &matching,
+                                       const SymbolTable &symbol_table, const PatternEstimates &estimates) {
+  if (matching.expansions.size() > ExpansionOrdering::kMaxExpansions) {
+    return ExpansionsFrom(start_node, matching, symbol_table);
+  }
+  ExpansionOrdering ordering(symbol_table.at(*start_node->identifier_), matching, symbol_table, estimates);
+  auto steps = ordering.FindCheapest(FLAGS_query_join_order_budget);
+  return ordering.Apply(steps ? *steps : ordering.FindGreedy());
+}
+
+VaryMatchingStart::VaryMatchingStart(Matching matching, const SymbolTable &symbol_table,
+                                     std::shared_ptr<const PatternEstimates> estimates)
+    : matching_(matching),
+      symbol_table_(symbol_table),
+      nodes_(ExpansionNodes(matching.expansions, symbol_table)),
+      estimates_(std::move(estimates)) {}
+
+std::vector<Expansion> VaryMatchingStart::OrderFrom(const NodeAtom *start_node) const {
+  if (!estimates_) return ExpansionsFrom(start_node, matching_, symbol_table_);
+  return OrderExpansions(start_node, matching_, symbol_table_, *estimates_);
+}
 
 VaryMatchingStart::iterator::iterator(VaryMatchingStart *self, bool is_done)
     : self_(self),
@@ -171,7 +405,7 @@ VaryMatchingStart::iterator::iterator(VaryMatchingStart *self, bool is_done)
     // Overwrite the original matching expansions with the new ones by
     // generating it from the first start node.
     start_nodes_it_ = self_->nodes_.begin();
-    current_matching_.expansions = ExpansionsFrom(**start_nodes_it_, self_->matching_, self_->symbol_table_);
+    current_matching_.expansions = self_->OrderFrom(**start_nodes_it_);
   }
   DMG_ASSERT(start_nodes_it_ || self_->nodes_.empty(),
              "start_nodes_it_ should only be nullopt when self_->nodes_ is empty");
@@ -195,25 +429,27 @@ VaryMatchingStart::iterator &VaryMatchingStart::iterator::operator++() {
     return *this;
   }
   const auto &start_node = **start_nodes_it_;
-  current_matching_.expansions = ExpansionsFrom(start_node, self_->matching_, self_->symbol_table_);
+  current_matching_.expansions = self_->OrderFrom(start_node);
   return *this;
 }
 
 CartesianProduct<VaryMatchingStart> VaryMultiMatchingStarts(const std::vector<Matching> &matchings,
-                                                            const SymbolTable &symbol_table) {
+                                                            const SymbolTable &symbol_table,
+                                                            std::shared_ptr<const PatternEstimates> estimates) {
   std::vector<VaryMatchingStart> variants;
   variants.reserve(matchings.size());
   for (const auto &matching : matchings) {
-    variants.emplace_back(VaryMatchingStart(matching, symbol_table));
+    variants.emplace_back(VaryMatchingStart(matching, symbol_table, estimates));
   }
   return MakeCartesianProduct(std::move(variants));
 }
 
-VaryQueryPartMatching::VaryQueryPartMatching(SingleQueryPart query_part, const SymbolTable &symbol_table)
+VaryQueryPartMatching::VaryQueryPartMatching(SingleQueryPart query_part, const SymbolTable &symbol_table,
+                                             std::shared_ptr<const PatternEstimates> estimates)
     : query_part_(std::move(query_part)),
-      matchings_(VaryMatchingStart(query_part_.matching, symbol_table)),
-      optional_matchings_(VaryMultiMatchingStarts(query_part_.optional_matching, symbol_table)),
-      merge_matchings_(VaryMultiMatchingStarts(query_part_.merge_matching, symbol_table)) {}
+      matchings_(VaryMatchingStart(query_part_.matching, symbol_table, estimates)),
+      optional_matchings_(VaryMultiMatchingStarts(query_part_.optional_matching, symbol_table, estimates)),
+      merge_matchings_(VaryMultiMatchingStarts(query_part_.merge_matching, symbol_table, std::move(estimates))) {}
 
 VaryQueryPartMatching::iterator::iterator(const SingleQueryPart &query_part,
                                           VaryMatchingStart::iterator matchings_begin,
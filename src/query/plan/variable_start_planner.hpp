@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -12,13 +12,19 @@
 /// @file
 #pragma once
 
+#include <algorithm>
+#include <memory>
+#include <unordered_set>
+
 #include "cppitertools/imap.hpp"
 #include "cppitertools/slice.hpp"
 #include "gflags/gflags.h"
 
+#include "query/plan/cost_estimator.hpp"
 #include "query/plan/rule_based_planner.hpp"
 
 DECLARE_uint64(query_max_plans);
+DECLARE_uint64(query_join_order_budget);
 
 namespace memgraph::query::plan {
 
@@ -152,6 +158,100 @@ auto MakeCartesianProduct(std::vector<TSet> sets) {
   return CartesianProduct<TSet>(std::move(sets));
 }
 
+/// Cardinality estimates of the pattern atoms, which are used to order the
+/// expansions of a matching so that the intermediate results stay small.
+struct PatternEstimates {
+  /// Total number of vertices in the graph.
+  double vertex_count{1};
+  /// Estimated number of vertices matched by each node symbol.
+  std::unordered_map<Symbol, double> node_cardinalities;
+  /// Average number of edges of a vertex, used for the edges which weren't
+  /// estimated.
+  double average_degree{CostEstimator<DbAccessor>::CardParam::kExpand};
+  /// Estimated number of edges which are expanded from a single vertex for
+  /// each edge symbol.
+  std::unordered_map<Symbol, double> edge_degrees;
+};
+
+/// Estimates the cardinalities of the nodes and edges in all matchings of the
+/// given query parts. Only the information which is cheap to get is used, i.e.
+/// the index sizes and the graph statistics collected by `ANALYZE GRAPH`.
+template <class TDbAccessor>
+PatternEstimates EstimatePatterns(const std::vector<SingleQueryPart> &query_parts, const SymbolTable &symbol_table,
+                                  TDbAccessor *db) {
+  using CardParam = typename CostEstimator<TDbAccessor>::CardParam;
+  PatternEstimates estimates;
+  estimates.vertex_count = std::max(1.0, static_cast<double>(db->VerticesCount()));
+  estimates.average_degree = db->GetAverageDegree().value_or(CardParam::kExpand);
+  auto estimate_node = [&](const NodeAtom *node, const Filters &filters) {
+    const auto &symbol = symbol_table.at(*node->identifier_);
+    auto cardinality = estimates.vertex_count;
+    if (!filters.IdFilters(symbol).empty()) {
+      cardinality = 1.0;
+    }
+    const auto labels = filters.FilteredLabels(symbol);
+    for (const auto &label_ix : labels) {
+      const auto label = db->NameToLabel(label_ix.name);
+      const auto label_cardinality = db->LabelIndexExists(label) ? static_cast<double>(db->VerticesCount(label))
+                                                                 : estimates.vertex_count * CardParam::kFilter;
+      cardinality = std::min(cardinality, label_cardinality);
+    }
+    for (const auto &filter : filters.PropertyFilters(symbol)) {
+      const auto &property_filter = *filter.property_filter;
+      const auto property = db->NameToProperty(property_filter.property_.name);
+      auto filtered = cardinality * CardParam::kFilter;
+      if (property_filter.type_ == PropertyFilter::Type::EQUAL) {
+        for (const auto &label_ix : labels) {
+          const auto label = db->NameToLabel(label_ix.name);
+          if (!db->LabelPropertyIndexExists(label, property)) continue;
+          const auto stats = db->GetLabelPropertyStats(label, property);
+          filtered = std::min(filtered, stats ? stats->AvgGroupSize()
+                                              : db->VerticesCount(label, property) * CardParam::kFilter);
+        }
+      }
+      cardinality = filtered;
+    }
+    cardinality = std::max(1.0, cardinality);
+    auto [it, inserted] = estimates.node_cardinalities.emplace(symbol, cardinality);
+    if (!inserted) it->second = std::min(it->second, cardinality);
+  };
+  auto estimate_edge = [&](const EdgeAtom *edge) {
+    double degree = 0;
+    if (edge->IsVariable()) {
+      degree = CardParam::kExpandVariable;
+    } else if (edge->edge_types_.empty()) {
+      degree = estimates.average_degree;
+    } else {
+      // A type that is listed more than once still matches each of its edges
+      // only once.
+      std::unordered_set<storage::EdgeTypeId> edge_types;
+      for (const auto &edge_type_ix : edge->edge_types_) {
+        const auto edge_type = db->NameToEdgeType(edge_type_ix.name);
+        if (!edge_types.insert(edge_type).second) continue;
+        degree += db->EdgeTypeIndexExists(edge_type)
+                      ? static_cast<double>(db->EdgesCount(edge_type)) / estimates.vertex_count
+                      : estimates.average_degree;
+      }
+    }
+    if (edge->direction_ == EdgeAtom::Direction::BOTH) degree *= 2;
+    estimates.edge_degrees[symbol_table.at(*edge->identifier_)] = degree;
+  };
+  auto estimate_matching = [&](const Matching &matching) {
+    for (const auto &expansion : matching.expansions) {
+      estimate_node(expansion.node1, matching.filters);
+      if (!expansion.edge) continue;
+      estimate_edge(expansion.edge);
+      estimate_node(expansion.node2, matching.filters);
+    }
+  };
+  for (const auto &query_part : query_parts) {
+    estimate_matching(query_part.matching);
+    for (const auto &matching : query_part.optional_matching) estimate_matching(matching);
+    for (const auto &matching : query_part.merge_matching) estimate_matching(matching);
+  }
+  return estimates;
+}
+
 namespace impl {
 
 class NodeSymbolHash {
@@ -178,11 +278,22 @@ class NodeSymbolEqual {
   const SymbolTable &symbol_table_;
 };
 
+// Orders the expansions of the matching starting from `start_node`, so that
+// the estimated sum of the intermediate result sizes is minimal. The orders
+// are enumerated using dynamic programming over the sets of the performed
+// expansions. When the number of the considered sets exceeds
+// `FLAGS_query_join_order_budget`, the expansions are ordered greedily by
+// always picking the expansion which produces the smallest result.
+std::vector<Expansion> OrderExpansions(const NodeAtom *start_node, const Matching &matching,
+                                       const SymbolTable &symbol_table, const PatternEstimates &estimates);
+
 // Generates n matchings, where n is the number of nodes to match. Each Matching
-// will have a different node as a starting node for expansion.
+// will have a different node as a starting node for expansion. When the
+// estimates are given, the expansions from each starting node are ordered by
+// `OrderExpansions`, otherwise they are taken in breadth-first order.
 class VaryMatchingStart {
  public:
-  VaryMatchingStart(Matching, const SymbolTable &);
+  VaryMatchingStart(Matching, const SymbolTable &, std::shared_ptr<const PatternEstimates> estimates = nullptr);
 
   class iterator {
    public:
@@ -220,21 +331,26 @@ class VaryMatchingStart {
 
  private:
   friend class iterator;
+  std::vector<Expansion> OrderFrom(const NodeAtom *start_node) const;
+
   Matching matching_;
   const SymbolTable &symbol_table_;
   std::unordered_set<NodeAtom *, NodeSymbolHash, NodeSymbolEqual> nodes_;
+  std::shared_ptr<const PatternEstimates> estimates_;
 };
 
 // Similar to VaryMatchingStart, but varies the starting nodes for all given
 // matchings. After all matchings produce multiple alternative starts, the
 // Cartesian product of all of them is returned.
-CartesianProduct<VaryMatchingStart> VaryMultiMatchingStarts(const std::vector<Matching> &, const SymbolTable &);
+CartesianProduct<VaryMatchingStart> VaryMultiMatchingStarts(
+    const std::vector<Matching> &, const SymbolTable &, std::shared_ptr<const PatternEstimates> estimates = nullptr);
 
 // Produces alternative query parts out of a single part by varying how each
 // graph matching is done.
 class VaryQueryPartMatching {
  public:
-  VaryQueryPartMatching(SingleQueryPart, const SymbolTable &);
+  VaryQueryPartMatching(SingleQueryPart, const SymbolTable &,
+                        std::shared_ptr<const PatternEstimates> estimates = nullptr);
 
   class iterator {
    public:
@@ -294,7 +410,9 @@ class VaryQueryPartMatching {
 /// traversal.
 ///
 /// This planner picks different starting nodes from which to start graph
-/// traversal. Generating a single plan is backed by @c RuleBasedPlanner.
+/// traversal. The expansions from each of the starting nodes are ordered by
+/// their estimated cardinalities, so that the selective parts of a pattern are
+/// matched first. Generating a single plan is backed by @c RuleBasedPlanner.
 ///
 /// @sa MakeLogicalPlan
 template <class TPlanningContext>
@@ -305,10 +423,12 @@ class VariableStartPlanner {
   // Generates different, equivalent query parts by taking different graph
   // matching routes for each query part.
   auto VaryQueryMatching(const std::vector<SingleQueryPart> &query_parts, const SymbolTable &symbol_table) {
+    auto estimates =
+        std::make_shared<const PatternEstimates>(EstimatePatterns(query_parts, symbol_table, context_->db));
     std::vector<impl::VaryQueryPartMatching> alternative_query_parts;
     alternative_query_parts.reserve(query_parts.size());
     for (const auto &query_part : query_parts) {
-      alternative_query_parts.emplace_back(impl::VaryQueryPartMatching(query_part, symbol_table));
+      alternative_query_parts.emplace_back(impl::VaryQueryPartMatching(query_part, symbol_table, estimates));
     }
     return iter::slice(MakeCartesianProduct(std::move(alternative_query_parts)), 0UL, FLAGS_query_max_plans);
   }
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -13,17 +13,19 @@
 #pragma once
 
 #include <optional>
+#include <vector>
 
 #include "query/typed_value.hpp"
 #include "storage/v2/id_types.hpp"
 #include "storage/v2/property_value.hpp"
+#include "storage/v2/statistics.hpp"
 #include "utils/bound.hpp"
 #include "utils/fnv.hpp"
 
 namespace memgraph::query::plan {
 
 /// A stand in class for `TDbAccessor` which provides memoized calls to
-/// `VerticesCount`.
+/// `VerticesCount` and `EdgesCount`. The graph statistics are passed through.
 template <class TDbAccessor>
 class VertexCountCache {
  public:
@@ -32,6 +34,7 @@ class VertexCountCache {
   auto NameToLabel(const std::string &name) { return db_->NameToLabel(name); }
   auto NameToProperty(const std::string &name) { return db_->NameToProperty(name); }
   auto NameToEdgeType(const std::string &name) { return db_->NameToEdgeType(name); }
+  auto PropertyToName(storage::PropertyId property) { return db_->PropertyToName(property); }
 
   int64_t VerticesCount() {
     if (!vertices_count_) vertices_count_ = db_->VerticesCount();
@@ -72,12 +75,66 @@ class VertexCountCache {
     return bounds_vertex_count.at(bounds);
   }
 
+  int64_t VerticesCount(storage::LabelId label, const std::vector<storage::PropertyId> &properties,
+                        const std::vector<storage::PropertyValue> &prefix) {
+    return db_->VerticesCount(label, properties, prefix);
+  }
+
+  int64_t VerticesCount(storage::LabelId label, const std::vector<storage::PropertyId> &properties,
+                        const std::vector<storage::PropertyValue> &prefix,
+                        const std::optional<utils::Bound<storage::PropertyValue>> &lower,
+                        const std::optional<utils::Bound<storage::PropertyValue>> &upper) {
+    return db_->VerticesCount(label, properties, prefix, lower, upper);
+  }
+
+  int64_t EdgesCount(storage::EdgeTypeId edge_type) {
+    if (edge_type_edge_count_.find(edge_type) == edge_type_edge_count_.end())
+      edge_type_edge_count_[edge_type] = db_->EdgesCount(edge_type);
+    return edge_type_edge_count_.at(edge_type);
+  }
+
+  int64_t EdgesCount(storage::EdgeTypeId edge_type, storage::PropertyId property) {
+    return db_->EdgesCount(edge_type, property);
+  }
+
+  int64_t EdgesCount(storage::EdgeTypeId edge_type, storage::PropertyId property,
+                     const storage::PropertyValue &value) {
+    return db_->EdgesCount(edge_type, property, value);
+  }
+
   bool LabelIndexExists(storage::LabelId label) { return db_->LabelIndexExists(label); }
 
   bool LabelPropertyIndexExists(storage::LabelId label, storage::PropertyId property) {
     return db_->LabelPropertyIndexExists(label, property);
   }
 
+  std::vector<std::vector<storage::PropertyId>> LabelPropertyCompositeIndices(storage::LabelId label) {
+    return db_->LabelPropertyCompositeIndices(label);
+  }
+
+  bool EdgeTypeIndexExists(storage::EdgeTypeId edge_type) { return db_->EdgeTypeIndexExists(edge_type); }
+
+  bool EdgeTypePropertyIndexExists(storage::EdgeTypeId edge_type, storage::PropertyId property) {
+    return db_->EdgeTypePropertyIndexExists(edge_type, property);
+  }
+
+  bool PropertyColumnExists(storage::LabelId label, storage::PropertyId property) {
+    return db_->PropertyColumnExists(label, property);
+  }
+
+  std::optional<storage::LabelStats> GetLabelStats(storage::LabelId label) { return db_->GetLabelStats(label); }
+
+  std::optional<storage::LabelPropertyStats> GetLabelPropertyStats(storage::LabelId label,
+                                                                   storage::PropertyId property) {
+    return db_->GetLabelPropertyStats(label, property);
+  }
+
+  std::optional<storage::EdgeTypeStats> GetEdgeTypeStats(storage::EdgeTypeId edge_type) {
+    return db_->GetEdgeTypeStats(edge_type);
+  }
+
+  std::optional<double> GetAverageDegree() { return db_->GetAverageDegree(); }
+
  private:
   typedef std::pair<storage::LabelId, storage::PropertyId> LabelPropertyKey;
 
@@ -121,6 +178,7 @@ class VertexCountCache {
   TDbAccessor *db_;
   std::optional<int64_t> vertices_count_;
   std::unordered_map<storage::LabelId, int64_t> label_vertex_count_;
+  std::unordered_map<storage::EdgeTypeId, int64_t> edge_type_edge_count_;
   std::unordered_map<LabelPropertyKey, int64_t, LabelPropertyHash> label_property_vertex_count_;
   std::unordered_map<
       LabelPropertyKey,
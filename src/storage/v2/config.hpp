@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -14,6 +14,10 @@
 #include <chrono>
 #include <cstdint>
 #include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "storage/v2/isolation_level.hpp"
 #include "storage/v2/transaction.hpp"
 
@@ -23,10 +27,27 @@ namespace memgraph::storage {
 /// the storage. This class also defines the default behavior.
 struct Config {
   struct Gc {
-    enum class Type { NONE, PERIODIC };
+    // The ADAPTIVE garbage collector runs every `interval` like the PERIODIC
+    // one, but it also runs right away when any of the triggers below is
+    // reached. While the runs don't find anything to collect, the interval is
+    // doubled up to `max_interval`.
+    enum class Type { NONE, PERIODIC, ADAPTIVE };
 
     Type type{Type::PERIODIC};
     std::chrono::milliseconds interval{std::chrono::milliseconds(1000)};
+    std::chrono::milliseconds max_interval{std::chrono::milliseconds(60000)};
+    // Number of committed transactions whose deltas aren't unlinked yet, and
+    // the number of bytes of deltas which aren't freed yet, which were added
+    // since the last run. 0 disables the trigger.
+    uint64_t trigger_transactions{10000};
+    uint64_t trigger_delta_bytes{256UL * 1024UL * 1024UL};
+    // Share of the memory limit which is in use after which any new garbage
+    // triggers a run. 0 disables the trigger.
+    double trigger_memory_ratio{0.8};
+    // Number of threads used by a single garbage collection run. The deltas
+    // of different transactions are unlinked, the indices are cleaned up and
+    // the deleted objects are freed in parallel.
+    uint64_t num_threads{1};
   } gc;
 
   struct Items {
@@ -35,6 +56,21 @@ struct Config {
 
   struct Durability {
     enum class SnapshotWalMode { DISABLED, PERIODIC_SNAPSHOT, PERIODIC_SNAPSHOT_WITH_WAL };
+    // The values are written to the snapshot and WAL files, so they must not
+    // be changed.
+    enum class Compression : uint8_t { NONE = 0, ZLIB = 1 };
+    // When is a transaction which is written to the WAL synced to disk.
+    enum class CommitDurability {
+      // The WAL is synced every `wal_file_flush_every_n_tx` transactions, the
+      // commit doesn't wait for the sync.
+      ASYNC,
+      // The commit returns after the WAL is synced. The concurrent commits
+      // are synced together with a single sync.
+      FSYNC_ON_COMMIT,
+      // The WAL is synced every `wal_fsync_interval`, the commit doesn't wait
+      // for the sync.
+      PERIODIC_FSYNC,
+    };
 
     std::filesystem::path storage_directory{"storage"};
 
@@ -44,17 +80,54 @@ struct Config {
 
     std::chrono::milliseconds snapshot_interval{std::chrono::minutes(2)};
     uint64_t snapshot_retention_count{3};
+    // Number of incremental snapshots which are created between two full
+    // snapshots. An incremental snapshot holds only the objects which were
+    // modified since the previous snapshot. 0 disables incremental snapshots.
+    uint64_t snapshot_incremental_count{0};
 
     uint64_t wal_file_size_kibibytes{20 * 1024};
     uint64_t wal_file_flush_every_n_tx{100000};
+    // Default durability of the committed transactions, it can be overridden
+    // for each transaction.
+    CommitDurability commit_durability{CommitDurability::ASYNC};
+    std::chrono::milliseconds wal_fsync_interval{10};
 
     bool snapshot_on_exit{false};
     bool restore_replicas_on_startup{false};
+
+    // Number of vertices or edges which are written to a snapshot as a
+    // single batch. The batches are recovered in parallel.
+    uint64_t items_per_batch{1000000};
+    // Number of threads used to recover the batches of a snapshot and to
+    // recreate the indices and constraints on startup.
+    uint64_t recovery_thread_count{8};
+    // Number of threads used to write the vertices and edges of a snapshot.
+    // Each of the threads writes its own segment of the snapshot.
+    uint64_t snapshot_thread_count{8};
+    // Block compression of the snapshot and WAL files.
+    Compression compression{Compression::NONE};
+    // Write the snapshot and WAL files asynchronously using io_uring. The
+    // blocking writes are used if io_uring isn't available.
+    bool async_writes{false};
   } durability;
 
   struct Transaction {
     IsolationLevel isolation_level{IsolationLevel::SNAPSHOT_ISOLATION};
   } transaction;
+
+  struct IndexCreation {
+    // Number of threads that scan the vertices when an index is created.
+    uint64_t num_threads{1};
+    // When set, the index is populated while the writers run and the storage
+    // is locked exclusively only to register and publish the index.
+    bool concurrent{false};
+  } index_creation;
+
+  struct Columns {
+    // Names of the labels and properties whose values are kept in property
+    // columns. The columns are created on startup, after the recovery.
+    std::vector<std::pair<std::string, std::string>> label_properties;
+  } columns;
 };
 
 }  // namespace memgraph::storage
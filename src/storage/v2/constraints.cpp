@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -389,25 +389,28 @@ std::vector<std::pair<LabelId, std::set<PropertyId>>> UniqueConstraints::ListCon
   return ret;
 }
 
-void UniqueConstraints::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) {
+void UniqueConstraints::CollectCleanupTasks(uint64_t oldest_active_start_timestamp,
+                                            std::vector<std::function<void()>> *tasks) {
   for (auto &[label_props, storage] : constraints_) {
-    auto acc = storage.access();
-    for (auto it = acc.begin(); it != acc.end();) {
-      auto next_it = it;
-      ++next_it;
+    tasks->emplace_back([label_props = &label_props, storage = &storage, oldest_active_start_timestamp] {
+      auto acc = storage->access();
+      for (auto it = acc.begin(); it != acc.end();) {
+        auto next_it = it;
+        ++next_it;
+
+        if (it->timestamp >= oldest_active_start_timestamp) {
+          it = next_it;
+          continue;
+        }
 
-      if (it->timestamp >= oldest_active_start_timestamp) {
+        if ((next_it != acc.end() && it->vertex == next_it->vertex && it->values == next_it->values) ||
+            !AnyVersionHasLabelProperty(*it->vertex, label_props->first, label_props->second, it->values,
+                                        oldest_active_start_timestamp)) {
+          acc.remove(*it);
+        }
         it = next_it;
-        continue;
       }
-
-      if ((next_it != acc.end() && it->vertex == next_it->vertex && it->values == next_it->values) ||
-          !AnyVersionHasLabelProperty(*it->vertex, label_props.first, label_props.second, it->values,
-                                      oldest_active_start_timestamp)) {
-        acc.remove(*it);
-      }
-      it = next_it;
-    }
+    });
   }
 }
 
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <functional>
 #include <optional>
 #include <set>
 #include <vector>
@@ -131,8 +132,9 @@ class UniqueConstraints {
 
   std::vector<std::pair<LabelId, std::set<PropertyId>>> ListConstraints() const;
 
-  /// GC method that removes outdated entries from constraints' storages.
-  void RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp);
+  /// GC method that appends a task for each of the constraints which removes
+  /// the outdated entries from the constraint's storage.
+  void CollectCleanupTasks(uint64_t oldest_active_start_timestamp, std::vector<std::function<void()>> *tasks);
 
   void Clear() { constraints_.clear(); }
 
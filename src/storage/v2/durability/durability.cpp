@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -20,6 +20,8 @@
 #include <cstring>
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -30,6 +32,8 @@
 #include "utils/logging.hpp"
 #include "utils/memory_tracker.hpp"
 #include "utils/message.hpp"
+#include "utils/thread.hpp"
+#include "utils/timer.hpp"
 
 namespace memgraph::storage::durability {
 
@@ -71,7 +75,9 @@ std::vector<SnapshotDurabilityInfo> GetSnapshotFiles(const std::filesystem::path
       try {
         auto info = ReadSnapshotInfo(item.path());
         if (uuid.empty() || info.uuid == uuid) {
-          snapshot_files.emplace_back(item.path(), std::move(info.uuid), info.start_timestamp);
+          std::optional<uint64_t> base_timestamp;
+          if (info.incremental) base_timestamp = info.base_timestamp;
+          snapshot_files.emplace_back(item.path(), std::move(info.uuid), info.start_timestamp, base_timestamp);
         }
       } catch (const RecoveryFailure &) {
         continue;
@@ -113,12 +119,15 @@ std::optional<std::vector<WalDurabilityInfo>> GetWalFiles(const std::filesystem:
 // to ensure that the indices and constraints are consistent at the end of the
 // recovery process.
 void RecoverIndicesAndConstraints(const RecoveredIndicesAndConstraints &indices_constraints, Indices *indices,
-                                  Constraints *constraints, utils::SkipList<Vertex> *vertices) {
+                                  Constraints *constraints, utils::SkipList<Vertex> *vertices, uint64_t num_threads) {
+  utils::Timer timer;
   spdlog::info("Recreating indices from metadata.");
+  // The label based indices are filled using multiple threads each, so they
+  // are recreated one after another.
   // Recover label indices.
   spdlog::info("Recreating {} label indices from metadata.", indices_constraints.indices.label.size());
   for (const auto &item : indices_constraints.indices.label) {
-    if (!indices->label_index.CreateIndex(item, vertices->access()))
+    if (!indices->label_index.CreateIndex(item, vertices->access(), num_threads))
       throw RecoveryFailure("The label index must be created here!");
     spdlog::info("A label index is recreated from metadata.");
   }
@@ -128,33 +137,78 @@ void RecoverIndicesAndConstraints(const RecoveredIndicesAndConstraints &indices_
   spdlog::info("Recreating {} label+property indices from metadata.",
                indices_constraints.indices.label_property.size());
   for (const auto &item : indices_constraints.indices.label_property) {
-    if (!indices->label_property_index.CreateIndex(item.first, item.second, vertices->access()))
+    if (!indices->label_property_index.CreateIndex(item.first, item.second, vertices->access(), num_threads))
       throw RecoveryFailure("The label+property index must be created here!");
     spdlog::info("A label+property index is recreated from metadata.");
   }
   spdlog::info("Label+property indices are recreated.");
-  spdlog::info("Indices are recreated.");
-
-  spdlog::info("Recreating constraints from metadata.");
-  // Recover existence constraints.
-  spdlog::info("Recreating {} existence constraints from metadata.", indices_constraints.constraints.existence.size());
-  for (const auto &item : indices_constraints.constraints.existence) {
-    auto ret = CreateExistenceConstraint(constraints, item.first, item.second, vertices->access());
-    if (ret.HasError() || !ret.GetValue()) throw RecoveryFailure("The existence constraint must be created here!");
-    spdlog::info("A existence constraint is recreated from metadata.");
-  }
-  spdlog::info("Existence constraints are recreated from metadata.");
-
-  // Recover unique constraints.
-  spdlog::info("Recreating {} unique constraints from metadata.", indices_constraints.constraints.unique.size());
-  for (const auto &item : indices_constraints.constraints.unique) {
-    auto ret = constraints->unique_constraints.CreateConstraint(item.first, item.second, vertices->access());
-    if (ret.HasError() || ret.GetValue() != UniqueConstraints::CreationStatus::SUCCESS)
-      throw RecoveryFailure("The unique constraint must be created here!");
-    spdlog::info("A unique constraint is recreated from metadata.");
+
+  // Recover label+properties composite indices.
+  spdlog::info("Recreating {} label+properties composite indices from metadata.",
+               indices_constraints.indices.label_property_composite.size());
+  for (const auto &item : indices_constraints.indices.label_property_composite) {
+    if (!indices->label_property_composite_index.CreateIndex(item.first, item.second, vertices->access(),
+                                                             num_threads))
+      throw RecoveryFailure("The label+properties composite index must be created here!");
+    spdlog::info("A label+properties composite index is recreated from metadata.");
   }
-  spdlog::info("Unique constraints are recreated from metadata.");
-  spdlog::info("Constraints are recreated from metadata.");
+  spdlog::info("Label+properties composite indices are recreated.");
+
+  // The edge type indices and the constraints are kept in separate
+  // structures, so each kind of them is recreated by its own thread.
+  std::vector<std::function<void()>> tasks;
+  tasks.emplace_back([&] {
+    // Recover edge type indices.
+    spdlog::info("Recreating {} edge type indices from metadata.", indices_constraints.indices.edge_type.size());
+    for (const auto &item : indices_constraints.indices.edge_type) {
+      if (!indices->edge_type_index.CreateIndex(item, vertices->access()))
+        throw RecoveryFailure("The edge type index must be created here!");
+      spdlog::info("An edge type index is recreated from metadata.");
+    }
+    spdlog::info("Edge type indices are recreated.");
+  });
+  tasks.emplace_back([&] {
+    // Recover edge type+property indices.
+    spdlog::info("Recreating {} edge type+property indices from metadata.",
+                 indices_constraints.indices.edge_type_property.size());
+    for (const auto &item : indices_constraints.indices.edge_type_property) {
+      if (!indices->edge_type_property_index.CreateIndex(item.first, item.second, vertices->access()))
+        throw RecoveryFailure("The edge type+property index must be created here!");
+      spdlog::info("An edge type+property index is recreated from metadata.");
+    }
+    spdlog::info("Edge type+property indices are recreated.");
+  });
+  tasks.emplace_back([&] {
+    // Recover existence constraints.
+    spdlog::info("Recreating {} existence constraints from metadata.",
+                 indices_constraints.constraints.existence.size());
+    for (const auto &item : indices_constraints.constraints.existence) {
+      auto ret = CreateExistenceConstraint(constraints, item.first, item.second, vertices->access());
+      if (ret.HasError() || !ret.GetValue()) throw RecoveryFailure("The existence constraint must be created here!");
+      spdlog::info("A existence constraint is recreated from metadata.");
+    }
+    spdlog::info("Existence constraints are recreated from metadata.");
+  });
+  tasks.emplace_back([&] {
+    // Recover unique constraints.
+    spdlog::info("Recreating {} unique constraints from metadata.", indices_constraints.constraints.unique.size());
+    for (const auto &item : indices_constraints.constraints.unique) {
+      auto ret = constraints->unique_constraints.CreateConstraint(item.first, item.second, vertices->access());
+      if (ret.HasError() || ret.GetValue() != UniqueConstraints::CreationStatus::SUCCESS)
+        throw RecoveryFailure("The unique constraint must be created here!");
+      spdlog::info("A unique constraint is recreated from metadata.");
+    }
+    spdlog::info("Unique constraints are recreated from metadata.");
+  });
+  utils::RunTasksInParallel(tasks, num_threads);
+  spdlog::info("Indices and constraints are recreated in {:.3f} seconds.", timer.Elapsed().count());
+}
+
+void RecoverGraphStatistics(const RecoveredIndicesAndConstraints &indices_constraints, NameIdMapper *name_id_mapper,
+                            GraphStatistics *statistics) {
+  if (!indices_constraints.statistics) return;
+  *statistics = FromNamedGraphStatistics(*indices_constraints.statistics, name_id_mapper);
+  spdlog::info("Graph statistics are loaded.");
 }
 
 std::optional<RecoveryInfo> RecoverData(const std::filesystem::path &snapshot_directory,
@@ -163,8 +217,8 @@ std::optional<RecoveryInfo> RecoverData(const std::filesystem::path &snapshot_di
                                         std::deque<std::pair<std::string, uint64_t>> *epoch_history,
                                         utils::SkipList<Vertex> *vertices, utils::SkipList<Edge> *edges,
                                         std::atomic<uint64_t> *edge_count, NameIdMapper *name_id_mapper,
-                                        Indices *indices, Constraints *constraints, Config::Items items,
-                                        uint64_t *wal_seq_num) {
+                                        Indices *indices, Constraints *constraints, GraphStatistics *statistics,
+                                        const Config &config, uint64_t *wal_seq_num) {
   utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
   spdlog::info("Recovering persisted data using snapshot ({}) and WAL directory ({}).", snapshot_directory,
                wal_directory);
@@ -188,18 +242,53 @@ std::optional<RecoveryInfo> RecoverData(const std::filesystem::path &snapshot_di
     *uuid = snapshot_files.back().uuid;
     std::optional<RecoveredSnapshot> recovered_snapshot;
     for (auto it = snapshot_files.rbegin(); it != snapshot_files.rend(); ++it) {
-      const auto &[path, file_uuid, _] = *it;
+      const auto &[path, file_uuid, start_timestamp, base_timestamp] = *it;
       if (file_uuid != *uuid) {
         spdlog::warn("The snapshot file {} isn't related to the latest snapshot file!", path);
         continue;
       }
+      // An incremental snapshot is recovered by loading the full snapshot on
+      // which it is based and then all of the incremental snapshots in order.
+      std::vector<std::filesystem::path> chain{path};
+      for (auto base = base_timestamp; base;) {
+        auto base_it = std::find_if(snapshot_files.begin(), snapshot_files.end(), [&](const auto &file) {
+          return file.uuid == *uuid && file.start_timestamp == *base;
+        });
+        if (base_it == snapshot_files.end()) {
+          chain.clear();
+          break;
+        }
+        chain.push_back(base_it->path);
+        base = base_it->base_timestamp;
+      }
+      if (chain.empty()) {
+        spdlog::warn("Couldn't find all of the snapshots on which the incremental snapshot {} is based.", path);
+        continue;
+      }
       spdlog::info("Starting snapshot recovery from {}.", path);
       try {
-        recovered_snapshot = LoadSnapshot(path, vertices, edges, epoch_history, name_id_mapper, edge_count, items);
+        std::optional<RecoveredSnapshot> chain_snapshot;
+        for (auto chain_it = chain.rbegin(); chain_it != chain.rend(); ++chain_it) {
+          auto loaded = LoadSnapshot(*chain_it, vertices, edges, epoch_history, name_id_mapper, edge_count, config);
+          if (chain_snapshot) {
+            loaded.recovery_info.next_vertex_id =
+                std::max(loaded.recovery_info.next_vertex_id, chain_snapshot->recovery_info.next_vertex_id);
+            loaded.recovery_info.next_edge_id =
+                std::max(loaded.recovery_info.next_edge_id, chain_snapshot->recovery_info.next_edge_id);
+          }
+          chain_snapshot = std::move(loaded);
+        }
+        recovered_snapshot = std::move(chain_snapshot);
         spdlog::info("Snapshot recovery successful!");
         break;
       } catch (const RecoveryFailure &e) {
         spdlog::warn("Couldn't recover snapshot from {} because of: {}.", path, e.what());
+        // The snapshots of the chain which were loaded before the failure
+        // have to be dropped.
+        edges->clear();
+        vertices->clear();
+        epoch_history->clear();
+        edge_count->store(0, std::memory_order_release);
         continue;
       }
     }
@@ -213,7 +302,9 @@ std::optional<RecoveryInfo> RecoverData(const std::filesystem::path &snapshot_di
     *epoch_id = std::move(recovered_snapshot->snapshot_info.epoch_id);
 
     if (!utils::DirExists(wal_directory)) {
-      RecoverIndicesAndConstraints(indices_constraints, indices, constraints, vertices);
+      RecoverIndicesAndConstraints(indices_constraints, indices, constraints, vertices,
+                                   config.durability.recovery_thread_count);
+      RecoverGraphStatistics(indices_constraints, name_id_mapper, statistics);
       return recovered_snapshot->recovery_info;
     }
   } else {
@@ -301,6 +392,7 @@ std::optional<RecoveryInfo> RecoverData(const std::filesystem::path &snapshot_di
     std::optional<uint64_t> previous_seq_num;
     auto last_loaded_timestamp = snapshot_timestamp;
     spdlog::info("Trying to load WAL files.");
+    utils::Timer timer;
     for (auto &wal_file : wal_files) {
       if (previous_seq_num && (wal_file.seq_num - *previous_seq_num) > 1) {
         LOG_FATAL("You are missing a WAL file with the sequence number {}!", *previous_seq_num + 1);
@@ -319,7 +411,7 @@ std::optional<RecoveryInfo> RecoverData(const std::filesystem::path &snapshot_di
       }
       try {
         auto info = LoadWal(wal_file.path, &indices_constraints, last_loaded_timestamp, vertices, edges, name_id_mapper,
-                            edge_count, items);
+                            edge_count, config.items);
         recovery_info.next_vertex_id = std::max(recovery_info.next_vertex_id, info.next_vertex_id);
         recovery_info.next_edge_id = std::max(recovery_info.next_edge_id, info.next_edge_id);
         recovery_info.next_timestamp = std::max(recovery_info.next_timestamp, info.next_timestamp);
@@ -337,10 +429,12 @@ std::optional<RecoveryInfo> RecoverData(const std::filesystem::path &snapshot_di
     // load any deltas from that file.
     *wal_seq_num = *previous_seq_num + 1;
 
-    spdlog::info("All necessary WAL files are loaded successfully.");
+    spdlog::info("All necessary WAL files are loaded successfully in {:.3f} seconds.", timer.Elapsed().count());
   }
 
-  RecoverIndicesAndConstraints(indices_constraints, indices, constraints, vertices);
+  RecoverIndicesAndConstraints(indices_constraints, indices, constraints, vertices,
+                               config.durability.recovery_thread_count);
+  RecoverGraphStatistics(indices_constraints, name_id_mapper, statistics);
   return recovery_info;
 }
 
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -25,6 +25,7 @@
 #include "storage/v2/edge.hpp"
 #include "storage/v2/indices.hpp"
 #include "storage/v2/name_id_mapper.hpp"
+#include "storage/v2/statistics.hpp"
 #include "storage/v2/vertex.hpp"
 #include "utils/skip_list.hpp"
 
@@ -37,12 +38,19 @@ void VerifyStorageDirectoryOwnerAndProcessUserOrDie(const std::filesystem::path
 
 // Used to capture the snapshot's data related to durability
 struct SnapshotDurabilityInfo {
-  explicit SnapshotDurabilityInfo(std::filesystem::path path, std::string uuid, const uint64_t start_timestamp)
-      : path(std::move(path)), uuid(std::move(uuid)), start_timestamp(start_timestamp) {}
+  explicit SnapshotDurabilityInfo(std::filesystem::path path, std::string uuid, const uint64_t start_timestamp,
+                                  const std::optional<uint64_t> base_timestamp = std::nullopt)
+      : path(std::move(path)),
+        uuid(std::move(uuid)),
+        start_timestamp(start_timestamp),
+        base_timestamp(base_timestamp) {}
 
   std::filesystem::path path;
   std::string uuid;
   uint64_t start_timestamp;
+  // Start timestamp of the snapshot on which an incremental snapshot is based,
+  // `std::nullopt` for a full snapshot.
+  std::optional<uint64_t> base_timestamp;
 
   auto operator<=>(const SnapshotDurabilityInfo &) const = default;
 };
@@ -94,10 +102,18 @@ std::optional<std::vector<WalDurabilityInfo>> GetWalFiles(const std::filesystem:
 // Helper function used to recover all discovered indices and constraints. The
 // indices and constraints must be recovered after the data recovery is done
 // to ensure that the indices and constraints are consistent at the end of the
-// recovery process.
+// recovery process. The vertices are scanned by `num_threads` threads while
+// each of the label based indices is filled, and the remaining kinds of
+// indices and constraints are recreated concurrently with each other.
 /// @throw RecoveryFailure
 void RecoverIndicesAndConstraints(const RecoveredIndicesAndConstraints &indices_constraints, Indices *indices,
-                                  Constraints *constraints, utils::SkipList<Vertex> *vertices);
+                                  Constraints *constraints, utils::SkipList<Vertex> *vertices,
+                                  uint64_t num_threads = 1);
+
+// Helper function used to recover the graph statistics which were set last.
+/// @throw RecoveryFailure
+void RecoverGraphStatistics(const RecoveredIndicesAndConstraints &indices_constraints, NameIdMapper *name_id_mapper,
+                            GraphStatistics *statistics);
 
 /// Recovers data either from a snapshot and/or WAL files.
 /// @throw RecoveryFailure
@@ -108,7 +124,7 @@ std::optional<RecoveryInfo> RecoverData(const std::filesystem::path &snapshot_di
                                         std::deque<std::pair<std::string, uint64_t>> *epoch_history,
                                         utils::SkipList<Vertex> *vertices, utils::SkipList<Edge> *edges,
                                         std::atomic<uint64_t> *edge_count, NameIdMapper *name_id_mapper,
-                                        Indices *indices, Constraints *constraints, Config::Items items,
-                                        uint64_t *wal_seq_num);
+                                        Indices *indices, Constraints *constraints, GraphStatistics *statistics,
+                                        const Config &config, uint64_t *wal_seq_num);
 
 }  // namespace memgraph::storage::durability
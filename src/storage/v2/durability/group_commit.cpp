@@ -0,0 +1,57 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/durability/group_commit.hpp"
+
+#include "utils/on_scope_exit.hpp"
+
+namespace memgraph::storage::durability {
+
+void GroupCommit::WaitDurable(uint64_t seq_num, const std::function<uint64_t()> &sync) {
+  if (LastDurable() >= seq_num) return;
+  std::unique_lock guard(lock_);
+  while (LastDurable() < seq_num) {
+    if (syncing_) {
+      // The transaction will be synced either by the current leader or by the
+      // next one, which is elected when the current leader finishes.
+      durable_cv_.wait(guard);
+      continue;
+    }
+    syncing_ = true;
+    guard.unlock();
+    uint64_t synced = 0;
+    {
+      // The leader has to be released even if the sync fails so that the
+      // waiting transactions don't wait forever.
+      utils::OnScopeExit release_leader([&] {
+        guard.lock();
+        syncing_ = false;
+        durable_cv_.notify_all();
+      });
+      synced = sync();
+      sync_count_.fetch_add(1, std::memory_order_acq_rel);
+    }
+    MarkDurableLocked(synced);
+  }
+}
+
+void GroupCommit::MarkDurable(uint64_t seq_num) {
+  std::lock_guard guard(lock_);
+  MarkDurableLocked(seq_num);
+}
+
+void GroupCommit::MarkDurableLocked(uint64_t seq_num) {
+  if (seq_num <= durable_.load(std::memory_order_acquire)) return;
+  durable_.store(seq_num, std::memory_order_release);
+  durable_cv_.notify_all();
+}
+
+}  // namespace memgraph::storage::durability
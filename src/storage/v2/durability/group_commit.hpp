@@ -0,0 +1,67 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace memgraph::storage::durability {
+
+/// Coordinates the syncing of the WAL between concurrently committing
+/// transactions. Each transaction which is appended to the WAL gets a
+/// sequence number. A transaction that has to be durable waits until its
+/// sequence number is synced. The first waiting transaction becomes the leader
+/// of the group and syncs the WAL, while the other transactions wait for it,
+/// so a single sync makes all of the transactions in the group durable.
+class GroupCommit {
+ public:
+  /// Returns the sequence number of the transaction which was just appended to
+  /// the WAL. It has to be called while holding the lock which serializes the
+  /// appends to the WAL.
+  uint64_t Register() { return registered_.fetch_add(1, std::memory_order_acq_rel) + 1; }
+
+  /// Sequence number of the last transaction appended to the WAL.
+  uint64_t LastRegistered() const { return registered_.load(std::memory_order_acquire); }
+
+  /// Sequence number of the last transaction which is synced to disk.
+  uint64_t LastDurable() const { return durable_.load(std::memory_order_acquire); }
+
+  /// Waits until the transaction with the given sequence number is synced to
+  /// disk. If no other thread is syncing the WAL, the calling thread calls
+  /// `sync` which has to sync all of the appended transactions and return the
+  /// sequence number of the last synced one.
+  void WaitDurable(uint64_t seq_num, const std::function<uint64_t()> &sync);
+
+  /// Marks the transactions up to the given sequence number as durable. It is
+  /// used when the WAL is synced outside of the group commit, e.g. when the
+  /// WAL file is finalized.
+  void MarkDurable(uint64_t seq_num);
+
+  /// Number of syncs done by the group commit leaders.
+  uint64_t SyncCount() const { return sync_count_.load(std::memory_order_acquire); }
+
+ private:
+  void MarkDurableLocked(uint64_t seq_num);
+
+  std::atomic<uint64_t> registered_{0};
+  std::atomic<uint64_t> durable_{0};
+  std::atomic<uint64_t> sync_count_{0};
+
+  std::mutex lock_;
+  std::condition_variable durable_cv_;
+  bool syncing_{false};
+};
+
+}  // namespace memgraph::storage::durability
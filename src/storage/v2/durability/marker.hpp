@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -37,6 +37,7 @@ enum class Marker : uint8_t {
   SECTION_CONSTRAINTS = 0x25,
   SECTION_DELTA = 0x26,
   SECTION_EPOCH_HISTORY = 0x27,
+  SECTION_DELETED = 0x28,
   SECTION_OFFSETS = 0x42,
 
   DELTA_VERTEX_CREATE = 0x50,
@@ -56,6 +57,13 @@ enum class Marker : uint8_t {
   DELTA_EXISTENCE_CONSTRAINT_DROP = 0x5e,
   DELTA_UNIQUE_CONSTRAINT_CREATE = 0x5f,
   DELTA_UNIQUE_CONSTRAINT_DROP = 0x60,
+  DELTA_EDGE_TYPE_INDEX_CREATE = 0x61,
+  DELTA_EDGE_TYPE_INDEX_DROP = 0x62,
+  DELTA_EDGE_TYPE_PROPERTY_INDEX_CREATE = 0x63,
+  DELTA_EDGE_TYPE_PROPERTY_INDEX_DROP = 0x64,
+  DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_CREATE = 0x65,
+  DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_DROP = 0x66,
+  DELTA_GRAPH_STATISTICS_SET = 0x67,
 
   VALUE_FALSE = 0x00,
   VALUE_TRUE = 0xff,
@@ -81,6 +89,7 @@ static const Marker kMarkersAll[] = {
     Marker::SECTION_CONSTRAINTS,
     Marker::SECTION_DELTA,
     Marker::SECTION_EPOCH_HISTORY,
+    Marker::SECTION_DELETED,
     Marker::SECTION_OFFSETS,
     Marker::DELTA_VERTEX_CREATE,
     Marker::DELTA_VERTEX_DELETE,
@@ -99,6 +108,13 @@ static const Marker kMarkersAll[] = {
     Marker::DELTA_EXISTENCE_CONSTRAINT_DROP,
     Marker::DELTA_UNIQUE_CONSTRAINT_CREATE,
     Marker::DELTA_UNIQUE_CONSTRAINT_DROP,
+    Marker::DELTA_EDGE_TYPE_INDEX_CREATE,
+    Marker::DELTA_EDGE_TYPE_INDEX_DROP,
+    Marker::DELTA_EDGE_TYPE_PROPERTY_INDEX_CREATE,
+    Marker::DELTA_EDGE_TYPE_PROPERTY_INDEX_DROP,
+    Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_CREATE,
+    Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_DROP,
+    Marker::DELTA_GRAPH_STATISTICS_SET,
     Marker::VALUE_FALSE,
     Marker::VALUE_TRUE,
 };
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -12,12 +12,15 @@
 #pragma once
 
 #include <algorithm>
+#include <optional>
 #include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "storage/v2/durability/exceptions.hpp"
 #include "storage/v2/id_types.hpp"
+#include "storage/v2/statistics.hpp"
 
 namespace memgraph::storage::durability {
 
@@ -36,12 +39,18 @@ struct RecoveredIndicesAndConstraints {
   struct {
     std::vector<LabelId> label;
     std::vector<std::pair<LabelId, PropertyId>> label_property;
+    std::vector<std::pair<LabelId, std::vector<PropertyId>>> label_property_composite;
+    std::vector<EdgeTypeId> edge_type;
+    std::vector<std::pair<EdgeTypeId, PropertyId>> edge_type_property;
   } indices;
 
   struct {
     std::vector<std::pair<LabelId, PropertyId>> existence;
     std::vector<std::pair<LabelId, std::set<PropertyId>>> unique;
   } constraints;
+
+  // The last graph statistics which were set.
+  std::optional<NamedGraphStatistics> statistics;
 };
 
 // Helper function used to insert indices/constraints into the recovered
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -11,8 +11,15 @@
 
 #include "storage/v2/durability/serialization.hpp"
 
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "storage/v2/durability/version.hpp"
 #include "storage/v2/temporal.hpp"
 #include "utils/endian.hpp"
+#include "utils/logging.hpp"
 
 namespace memgraph::storage::durability {
 
@@ -25,26 +32,128 @@ void WriteSize(Encoder *encoder, uint64_t size) {
   size = utils::HostToLittleEndian(size);
   encoder->Write(reinterpret_cast<const uint8_t *>(&size), sizeof(size));
 }
+
+// Header of a compressed block, see `Encoder`.
+struct BlockHeader {
+  uint32_t size;
+  uint32_t compressed_size;
+  uint32_t checksum;
+};
+
+constexpr uint64_t kBlockHeaderSize = 3 * sizeof(uint32_t);
+
+void EncodeBlockHeader(const BlockHeader &header, uint8_t *data) {
+  const uint32_t values[] = {utils::HostToLittleEndian(header.size), utils::HostToLittleEndian(header.compressed_size),
+                             utils::HostToLittleEndian(header.checksum)};
+  memcpy(data, values, kBlockHeaderSize);
+}
+
+BlockHeader DecodeBlockHeader(const uint8_t *data) {
+  uint32_t values[3];
+  memcpy(values, data, kBlockHeaderSize);
+  return {utils::LittleEndianToHost(values[0]), utils::LittleEndianToHost(values[1]),
+          utils::LittleEndianToHost(values[2])};
+}
+
+uint32_t Checksum(const uint8_t *data, uint64_t size) {
+  return crc32(crc32(0L, Z_NULL, 0), data, static_cast<uInt>(size));
+}
 }  // namespace
 
-void Encoder::Initialize(const std::filesystem::path &path, const std::string_view magic, uint64_t version) {
+void Encoder::Initialize(const std::filesystem::path &path, const std::string_view magic, uint64_t version,
+                         Config::Durability::Compression compression) {
   file_.Open(path, utils::OutputFile::Mode::OVERWRITE_EXISTING);
   Write(reinterpret_cast<const uint8_t *>(magic.data()), magic.size());
   auto version_encoded = utils::HostToLittleEndian(version);
   Write(reinterpret_cast<const uint8_t *>(&version_encoded), sizeof(version_encoded));
+  if (version < kCompressionVersion) {
+    MG_ASSERT(compression == Config::Durability::Compression::NONE,
+              "Compression isn't supported by the version {} of the file!", version);
+    return;
+  }
+  compression_ = compression;
+  auto compression_encoded = static_cast<uint8_t>(compression);
+  Write(&compression_encoded, sizeof(compression_encoded));
+  // The start of the compressed data is written once the compression starts.
+  compressed_start_offset_ = magic.size() + sizeof(version_encoded) + sizeof(compression_encoded);
+  uint64_t compressed_start = 0;
+  Write(reinterpret_cast<const uint8_t *>(&compressed_start), sizeof(compressed_start));
+}
+
+void Encoder::StartCompression() {
+  if (compression_ == Config::Durability::Compression::NONE) return;
+  MG_ASSERT(compressed_start_offset_ && !compressing_, "The compression can't be started!");
+  compressed_start_ = file_.GetPosition();
+  file_.SetPosition(utils::OutputFile::Position::SET, *compressed_start_offset_);
+  auto compressed_start_encoded = utils::HostToLittleEndian(compressed_start_);
+  file_.Write(reinterpret_cast<const uint8_t *>(&compressed_start_encoded), sizeof(compressed_start_encoded));
+  file_.SetPosition(utils::OutputFile::Position::SET, compressed_start_);
+  compressing_ = true;
 }
 
-void Encoder::OpenExisting(const std::filesystem::path &path) {
+void Encoder::OpenExisting(const std::filesystem::path &path, Config::Durability::Compression compression) {
   file_.Open(path, utils::OutputFile::Mode::APPEND_TO_EXISTING);
+  if (compression == Config::Durability::Compression::NONE) return;
+  compression_ = compression;
+  compressed_start_ = file_.GetSize();
+  compressing_ = true;
 }
 
+void Encoder::EnableAsyncWrites() { file_.EnableAsyncWrites(); }
+
 void Encoder::Close() {
   if (file_.IsOpen()) {
+    FlushBlock();
     file_.Close();
   }
 }
 
-void Encoder::Write(const uint8_t *data, uint64_t size) { file_.Write(data, size); }
+void Encoder::Write(const uint8_t *data, uint64_t size) {
+  if (!compressing_ || overwriting_) {
+    file_.Write(data, size);
+    return;
+  }
+  while (size > 0) {
+    const auto to_write = std::min(size, kCompressionBlockSize - block_.size());
+    block_.insert(block_.end(), data, data + to_write);
+    uncompressed_size_ += to_write;
+    data += to_write;
+    size -= to_write;
+    if (block_.size() == kCompressionBlockSize) FlushBlock();
+  }
+}
+
+void Encoder::FlushBlock() {
+  if (block_.empty()) return;
+  MG_ASSERT(compression_ == Config::Durability::Compression::ZLIB, "Unknown compression!");
+  auto compressed_size = compressBound(block_.size());
+  compressed_block_.resize(kBlockHeaderSize + compressed_size);
+  auto *compressed_data = compressed_block_.data() + kBlockHeaderSize;
+  const auto ret = compress2(compressed_data, &compressed_size, block_.data(), block_.size(), Z_BEST_SPEED);
+  MG_ASSERT(ret == Z_OK, "Couldn't compress the data of {}!", file_.path());
+  EncodeBlockHeader({static_cast<uint32_t>(block_.size()), static_cast<uint32_t>(compressed_size),
+                     Checksum(compressed_data, compressed_size)},
+                    compressed_block_.data());
+  file_.Write(compressed_block_.data(), kBlockHeaderSize + compressed_size);
+  block_.clear();
+}
+
+void Encoder::Append(const std::filesystem::path &path, uint64_t size) {
+  FlushBlock();
+  utils::InputFile file;
+  MG_ASSERT(file.Open(path), "Couldn't open {} for appending it to {}!", path, file_.path());
+  const auto file_size = file.GetSize();
+  MG_ASSERT(compressing_ || file_size == size, "Invalid size of the uncompressed data in {}!", path);
+  compressed_block_.resize(kCompressionBlockSize);
+  for (auto left = file_size; left > 0;) {
+    const auto to_read = std::min(left, compressed_block_.size());
+    MG_ASSERT(file.Read(compressed_block_.data(), to_read), "Couldn't read {} for appending it to {}!", path,
+              file_.path());
+    file_.Write(compressed_block_.data(), to_read);
+    left -= to_read;
+  }
+  if (compressing_) uncompressed_size_ += size;
+}
 
 void Encoder::WriteMarker(Marker marker) {
   auto value = static_cast<uint8_t>(marker);
@@ -131,22 +240,59 @@ void Encoder::WritePropertyValue(const PropertyValue &value) {
   }
 }
 
-uint64_t Encoder::GetPosition() { return file_.GetPosition(); }
+uint64_t Encoder::GetPosition() {
+  if (compressing_ && !overwriting_) return compressed_start_ + uncompressed_size_;
+  return file_.GetPosition();
+}
 
-void Encoder::SetPosition(uint64_t position) { file_.SetPosition(utils::OutputFile::Position::SET, position); }
+void Encoder::SetPosition(uint64_t position) {
+  if (!compressing_) {
+    file_.SetPosition(utils::OutputFile::Position::SET, position);
+    return;
+  }
+  if (position < compressed_start_) {
+    FlushBlock();
+    file_.SetPosition(utils::OutputFile::Position::SET, position);
+    overwriting_ = true;
+    return;
+  }
+  MG_ASSERT(position == compressed_start_ + uncompressed_size_,
+            "The compressed data of {} can only be written at its end!", file_.path());
+  if (overwriting_) {
+    file_.SetPosition(utils::OutputFile::Position::RELATIVE_TO_END, 0);
+    overwriting_ = false;
+  }
+}
+
+void Encoder::Sync() {
+  FlushBlock();
+  file_.Sync();
+}
 
-void Encoder::Sync() { file_.Sync(); }
+utils::FileSyncHandle Encoder::FlushForSync() {
+  FlushBlock();
+  return file_.FlushForSync();
+}
 
 void Encoder::Finalize() {
+  FlushBlock();
   file_.Sync();
   file_.Close();
 }
 
-void Encoder::DisableFlushing() { file_.DisableFlushing(); }
+void Encoder::DisableFlushing() {
+  // The whole written data has to be in the buffer of the file while the
+  // flushing is disabled, see `CurrentFileBuffer`.
+  FlushBlock();
+  file_.DisableFlushing();
+}
 
 void Encoder::EnableFlushing() { file_.EnableFlushing(); }
 
-void Encoder::TryFlushing() { file_.TryFlushing(); }
+void Encoder::TryFlushing() {
+  FlushBlock();
+  file_.TryFlushing();
+}
 
 std::pair<const uint8_t *, size_t> Encoder::CurrentFileBuffer() const { return file_.CurrentBuffer(); }
 
@@ -181,12 +327,133 @@ std::optional<uint64_t> Decoder::Initialize(const std::filesystem::path &path, c
   if (file_magic != magic) return std::nullopt;
   uint64_t version_encoded;
   if (!Read(reinterpret_cast<uint8_t *>(&version_encoded), sizeof(version_encoded))) return std::nullopt;
-  return utils::LittleEndianToHost(version_encoded);
+  const auto version = utils::LittleEndianToHost(version_encoded);
+  if (version < kCompressionVersion) return version;
+
+  uint8_t compression;
+  if (!Read(&compression, sizeof(compression))) return std::nullopt;
+  uint64_t compressed_start_encoded;
+  if (!Read(reinterpret_cast<uint8_t *>(&compressed_start_encoded), sizeof(compressed_start_encoded))) {
+    return std::nullopt;
+  }
+  switch (static_cast<Config::Durability::Compression>(compression)) {
+    case Config::Durability::Compression::NONE:
+      return version;
+    case Config::Durability::Compression::ZLIB:
+      break;
+    default:
+      return std::nullopt;
+  }
+  compression_ = static_cast<Config::Durability::Compression>(compression);
+  compressed_start_ = utils::LittleEndianToHost(compressed_start_encoded);
+  // The header is read before the compression is started, so the compressed
+  // data can't start before the current position.
+  position_ = file_.GetPosition();
+  if (compressed_start_ < position_ || compressed_start_ > file_.GetSize()) return std::nullopt;
+  ReadBlocks();
+  return version;
 }
 
-bool Decoder::Read(uint8_t *data, size_t size) { return file_.Read(data, size); }
+bool Decoder::Initialize(const Decoder &other) {
+  if (!file_.Open(other.file_.path())) return false;
+  compression_ = other.compression_;
+  compressed_start_ = other.compressed_start_;
+  blocks_ = other.blocks_;
+  size_ = other.size_;
+  position_ = 0;
+  return true;
+}
 
-bool Decoder::Peek(uint8_t *data, size_t size) { return file_.Peek(data, size); }
+void Decoder::ReadBlocks() {
+  auto blocks = std::make_shared<std::vector<CompressedBlock>>();
+  const auto file_size = file_.GetSize();
+  uint64_t position = compressed_start_;
+  uint64_t offset = compressed_start_;
+  while (offset + kBlockHeaderSize <= file_size) {
+    uint8_t header_data[kBlockHeaderSize];
+    if (!file_.SetPosition(utils::InputFile::Position::SET, offset) || !file_.Read(header_data, kBlockHeaderSize)) {
+      break;
+    }
+    const auto header = DecodeBlockHeader(header_data);
+    if (header.size == 0 || header.size > kCompressionBlockSize ||
+        offset + kBlockHeaderSize + header.compressed_size > file_size) {
+      break;
+    }
+    blocks->push_back({position, offset + kBlockHeaderSize, header.size, header.compressed_size, header.checksum});
+    position += header.size;
+    offset += kBlockHeaderSize + header.compressed_size;
+  }
+  size_ = position;
+  blocks_ = std::move(blocks);
+}
+
+bool Decoder::LoadBlock() {
+  const auto &blocks = *blocks_;
+  if (block_index_ && blocks[*block_index_].position <= position_ &&
+      position_ < blocks[*block_index_].position + blocks[*block_index_].size) {
+    return true;
+  }
+  // The blocks are usually read sequentially, so the next block is checked
+  // before searching for the block.
+  size_t index = 0;
+  if (block_index_ && *block_index_ + 1 < blocks.size() && blocks[*block_index_ + 1].position == position_) {
+    index = *block_index_ + 1;
+  } else {
+    auto it = std::upper_bound(blocks.begin(), blocks.end(), position_,
+                               [](uint64_t position, const auto &block) { return position < block.position; });
+    if (it == blocks.begin()) return false;
+    index = std::prev(it) - blocks.begin();
+  }
+  const auto &block = blocks[index];
+  if (position_ >= block.position + block.size) return false;
+
+  block_index_ = std::nullopt;
+  compressed_block_.resize(block.compressed_size);
+  if (!file_.SetPosition(utils::InputFile::Position::SET, block.offset) ||
+      !file_.Read(compressed_block_.data(), block.compressed_size)) {
+    return false;
+  }
+  if (Checksum(compressed_block_.data(), block.compressed_size) != block.checksum) return false;
+  block_.resize(block.size);
+  uLongf size = block.size;
+  if (uncompress(block_.data(), &size, compressed_block_.data(), block.compressed_size) != Z_OK ||
+      size != block.size) {
+    return false;
+  }
+  block_index_ = index;
+  return true;
+}
+
+bool Decoder::Read(uint8_t *data, size_t size) {
+  if (compression_ == Config::Durability::Compression::NONE) return file_.Read(data, size);
+  if (position_ + size > size_) return false;
+  while (size > 0) {
+    size_t to_read = 0;
+    if (position_ < compressed_start_) {
+      // The uncompressed data at the start of the file.
+      to_read = std::min<uint64_t>(size, compressed_start_ - position_);
+      if (!file_.SetPosition(utils::InputFile::Position::SET, position_) || !file_.Read(data, to_read)) return false;
+    } else {
+      if (!LoadBlock()) return false;
+      const auto &block = (*blocks_)[*block_index_];
+      const auto block_position = position_ - block.position;
+      to_read = std::min<uint64_t>(size, block.size - block_position);
+      memcpy(data, block_.data() + block_position, to_read);
+    }
+    position_ += to_read;
+    data += to_read;
+    size -= to_read;
+  }
+  return true;
+}
+
+bool Decoder::Peek(uint8_t *data, size_t size) {
+  if (compression_ == Config::Durability::Compression::NONE) return file_.Peek(data, size);
+  const auto position = position_;
+  const auto ret = Read(data, size);
+  position_ = position;
+  return ret;
+}
 
 std::optional<Marker> Decoder::PeekMarker() {
   uint8_t value;
@@ -350,6 +617,13 @@ std::optional<PropertyValue> Decoder::ReadPropertyValue() {
     case Marker::DELTA_EXISTENCE_CONSTRAINT_DROP:
     case Marker::DELTA_UNIQUE_CONSTRAINT_CREATE:
     case Marker::DELTA_UNIQUE_CONSTRAINT_DROP:
+    case Marker::DELTA_EDGE_TYPE_INDEX_CREATE:
+    case Marker::DELTA_EDGE_TYPE_INDEX_DROP:
+    case Marker::DELTA_EDGE_TYPE_PROPERTY_INDEX_CREATE:
+    case Marker::DELTA_EDGE_TYPE_PROPERTY_INDEX_DROP:
+    case Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+    case Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+    case Marker::DELTA_GRAPH_STATISTICS_SET:
     case Marker::VALUE_FALSE:
     case Marker::VALUE_TRUE:
       return std::nullopt;
@@ -449,16 +723,36 @@ bool Decoder::SkipPropertyValue() {
     case Marker::DELTA_EXISTENCE_CONSTRAINT_DROP:
     case Marker::DELTA_UNIQUE_CONSTRAINT_CREATE:
     case Marker::DELTA_UNIQUE_CONSTRAINT_DROP:
+    case Marker::DELTA_EDGE_TYPE_INDEX_CREATE:
+    case Marker::DELTA_EDGE_TYPE_INDEX_DROP:
+    case Marker::DELTA_EDGE_TYPE_PROPERTY_INDEX_CREATE:
+    case Marker::DELTA_EDGE_TYPE_PROPERTY_INDEX_DROP:
+    case Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+    case Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+    case Marker::DELTA_GRAPH_STATISTICS_SET:
     case Marker::VALUE_FALSE:
     case Marker::VALUE_TRUE:
       return false;
   }
 }
 
-std::optional<uint64_t> Decoder::GetSize() { return file_.GetSize(); }
+std::optional<uint64_t> Decoder::GetSize() {
+  if (compression_ != Config::Durability::Compression::NONE) return size_;
+  return file_.GetSize();
+}
 
-std::optional<uint64_t> Decoder::GetPosition() { return file_.GetPosition(); }
+std::optional<uint64_t> Decoder::GetPosition() {
+  if (compression_ != Config::Durability::Compression::NONE) return position_;
+  return file_.GetPosition();
+}
 
-bool Decoder::SetPosition(uint64_t position) { return !!file_.SetPosition(utils::InputFile::Position::SET, position); }
+bool Decoder::SetPosition(uint64_t position) {
+  if (compression_ != Config::Durability::Compression::NONE) {
+    if (position > size_) return false;
+    position_ = position;
+    return true;
+  }
+  return !!file_.SetPosition(utils::InputFile::Position::SET, position);
+}
 
 }  // namespace memgraph::storage::durability
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -13,7 +13,10 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <optional>
 #include <string_view>
+#include <vector>
 
 #include "storage/v2/config.hpp"
 #include "storage/v2/durability/marker.hpp"
@@ -38,12 +41,42 @@ class BaseEncoder {
   virtual void WritePropertyValue(const PropertyValue &value) = 0;
 };
 
+/// Maximum size of the uncompressed data in a single compressed block.
+inline constexpr uint64_t kCompressionBlockSize = 262144;
+
 /// Encoder that is used to generate a snapshot/WAL.
+///
+/// The data of the file can be compressed using block compression. The data
+/// is buffered and compressed in blocks of at most `kCompressionBlockSize`
+/// bytes, each of the blocks is written as:
+///     * size of the uncompressed data (uint32)
+///     * size of the compressed data (uint32)
+///     * CRC32 checksum of the compressed data (uint32)
+///     * compressed data
+/// All positions of the encoder (and the decoder) are positions in the
+/// uncompressed data, so the users of the encoder don't depend on the
+/// compression.
 class Encoder final : public BaseEncoder {
  public:
-  void Initialize(const std::filesystem::path &path, std::string_view magic, uint64_t version);
-
-  void OpenExisting(const std::filesystem::path &path);
+  /// Creates the file and writes the header. From `kCompressionVersion` the
+  /// header also holds the compression of the file and the position where the
+  /// compressed data starts.
+  void Initialize(const std::filesystem::path &path, std::string_view magic, uint64_t version,
+                  Config::Durability::Compression compression = Config::Durability::Compression::NONE);
+
+  /// Starts compressing the data using the compression given to `Initialize`.
+  /// The data before the current position stays uncompressed, so it can still
+  /// be overwritten using `SetPosition`.
+  void StartCompression();
+
+  /// Opens an existing file for appending. The appended data is compressed
+  /// using the given compression from the start, without a header.
+  void OpenExisting(const std::filesystem::path &path,
+                    Config::Durability::Compression compression = Config::Durability::Compression::NONE);
+
+  /// Writes the data to the file asynchronously if possible, see
+  /// `utils::OutputFile::EnableAsyncWrites`.
+  void EnableAsyncWrites();
 
   void Close();
   // Main write function, the only one that is allowed to write to the `file_`
@@ -57,10 +90,22 @@ class Encoder final : public BaseEncoder {
   void WriteString(std::string_view value) override;
   void WritePropertyValue(const PropertyValue &value) override;
 
+  /// Appends the file written by another encoder which was opened using
+  /// `OpenExisting` with the same compression. `size` is the position of the
+  /// other encoder after all of its data was written. The compressed blocks
+  /// are copied as they are.
+  void Append(const std::filesystem::path &path, uint64_t size);
+
   uint64_t GetPosition();
+  /// Sets the position of the encoder. When the data is compressed, only the
+  /// uncompressed data at the start of the file can be overwritten, after
+  /// which the data can only be appended at the end.
   void SetPosition(uint64_t position);
 
   void Sync();
+  // Write all of the data to the file and get a handle which syncs it, see
+  // `utils::OutputFile::FlushForSync`.
+  utils::FileSyncHandle FlushForSync();
 
   void Finalize();
 
@@ -77,7 +122,23 @@ class Encoder final : public BaseEncoder {
   size_t GetSize();
 
  private:
+  // Compresses the buffered data and writes it to the file as a single block.
+  void FlushBlock();
+
   utils::OutputFile file_;
+
+  Config::Durability::Compression compression_{Config::Durability::Compression::NONE};
+  // Position of the placeholder in the header for the start of the compressed
+  // data.
+  std::optional<uint64_t> compressed_start_offset_;
+  bool compressing_{false};
+  // Set while the uncompressed data at the start of the file is overwritten.
+  bool overwriting_{false};
+  uint64_t compressed_start_{0};
+  // Size of the uncompressed data written since the start of the compression.
+  uint64_t uncompressed_size_{0};
+  std::vector<uint8_t> block_;
+  std::vector<uint8_t> compressed_block_;
 };
 
 /// Decoder interface class. Used to implement streams from different sources
@@ -98,11 +159,16 @@ class BaseDecoder {
   virtual bool SkipPropertyValue() = 0;
 };
 
-/// Decoder that is used to read a generated snapshot/WAL.
+/// Decoder that is used to read a generated snapshot/WAL. Compressed files
+/// are decompressed block by block while they are read, see `Encoder`.
 class Decoder final : public BaseDecoder {
  public:
   std::optional<uint64_t> Initialize(const std::filesystem::path &path, const std::string &magic);
 
+  /// Opens the file read by the other decoder. The decoders share the list of
+  /// compressed blocks of the file, so it isn't read again.
+  bool Initialize(const Decoder &other);
+
   // Main read functions, the only one that are allowed to read from the `file_`
   // directly.
   bool Read(uint8_t *data, size_t size);
@@ -125,7 +191,33 @@ class Decoder final : public BaseDecoder {
   bool SetPosition(uint64_t position);
 
  private:
+  struct CompressedBlock {
+    // Position of the uncompressed data of the block.
+    uint64_t position;
+    // Offset of the compressed data in the file.
+    uint64_t offset;
+    uint32_t size;
+    uint32_t compressed_size;
+    uint32_t checksum;
+  };
+
+  // Reads the headers of all complete blocks in the file. An incomplete block
+  // at the end of the file is ignored.
+  void ReadBlocks();
+  // Decompresses the block which holds the current position.
+  bool LoadBlock();
+
   utils::InputFile file_;
+
+  Config::Durability::Compression compression_{Config::Durability::Compression::NONE};
+  uint64_t compressed_start_{0};
+  std::shared_ptr<const std::vector<CompressedBlock>> blocks_;
+  uint64_t size_{0};
+  uint64_t position_{0};
+  // Index of the decompressed block in `blocks_`.
+  std::optional<size_t> block_index_;
+  std::vector<uint8_t> block_;
+  std::vector<uint8_t> compressed_block_;
 };
 
 }  // namespace memgraph::storage::durability
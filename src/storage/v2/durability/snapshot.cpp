@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -11,6 +11,15 @@
 
 #include "storage/v2/durability/snapshot.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_set>
+
 #include "storage/v2/durability/exceptions.hpp"
 #include "storage/v2/durability/paths.hpp"
 #include "storage/v2/durability/serialization.hpp"
@@ -22,7 +31,10 @@
 #include "storage/v2/vertex_accessor.hpp"
 #include "utils/file_locker.hpp"
 #include "utils/logging.hpp"
+#include "utils/memory_tracker.hpp"
 #include "utils/message.hpp"
+#include "utils/on_scope_exit.hpp"
+#include "utils/timer.hpp"
 
 namespace memgraph::storage::durability {
 
@@ -32,6 +44,10 @@ namespace memgraph::storage::durability {
 //
 // 2) Snapshot version (non-encoded, little-endian)
 //
+// 2a) Compression (from version 19, non-encoded)
+//     * compression of the data after the section offsets
+//     * offset to the start of the compressed data
+//
 // 3) Section offsets:
 //     * offset to the first edge in the snapshot (`0` if properties on edges
 //       are disabled)
@@ -65,6 +81,16 @@ namespace memgraph::storage::durability {
 //     * label+property indices
 //         * label
 //         * property
+//     * edge type indices (from version 15)
+//         * edge type
+//     * edge type+property indices (from version 15)
+//         * edge type
+//         * property
+//     * label+properties composite indices (from version 16)
+//         * label
+//         * properties (in the order of the index)
+//     * graph statistics (from version 17)
+//         * serialized graph statistics
 //
 // 7) Constraints
 //     * existence constraints
@@ -86,6 +112,35 @@ namespace memgraph::storage::durability {
 //       applied)
 //     * number of edges
 //     * number of vertices
+//     * batches of edges (from version 18)
+//         * offset to the first edge in the batch
+//         * number of edges in the batch
+//     * batches of vertices (from version 18)
+//         * offset to the first vertex in the batch
+//         * number of vertices in the batch
+//     * whether the snapshot is incremental (from version 20)
+//     * start timestamp of the snapshot which the incremental snapshot is
+//       based on (from version 20)
+//     * offset to the deleted objects section, `0` if the snapshot isn't
+//       incremental (from version 20)
+//
+// 10) Deleted objects (only in incremental snapshots, placed after the
+//     vertices)
+//     * GIDs of the deleted edges
+//     * GIDs of the deleted vertices
+//
+// The edges and the vertices are written in batches of
+// `Config::Durability::items_per_batch` objects. Each of the batches can be
+// decoded on its own, so the batches are recovered in parallel.
+//
+// An incremental snapshot has the same layout as a full snapshot, but only
+// the edges and vertices which were modified since the snapshot it is based on
+// are written. It is recovered by loading the full snapshot at the start of
+// the chain and applying the incremental snapshots on top of it in order.
+//
+// All of the data after the section offsets is compressed using block
+// compression if enabled (see `Encoder`). All offsets in the snapshot are
+// offsets in the uncompressed data.
 //
 // IMPORTANT: When changing snapshot encoding/decoding bump the snapshot/WAL
 // version in `version.hpp`.
@@ -152,15 +207,92 @@ SnapshotInfo ReadSnapshotInfo(const std::filesystem::path &path) {
     auto maybe_vertices = snapshot.ReadUint();
     if (!maybe_vertices) throw RecoveryFailure("Invalid snapshot data!");
     info.vertices_count = *maybe_vertices;
+
+    if (*version >= kSnapshotBatchesVersion) {
+      auto read_batches = [&snapshot](uint64_t expected_count) {
+        auto size = snapshot.ReadUint();
+        if (!size) throw RecoveryFailure("Invalid snapshot data!");
+        std::vector<BatchInfo> batches;
+        batches.reserve(*size);
+        uint64_t count = 0;
+        for (uint64_t i = 0; i < *size; ++i) {
+          auto offset = snapshot.ReadUint();
+          if (!offset) throw RecoveryFailure("Invalid snapshot data!");
+          auto batch_count = snapshot.ReadUint();
+          if (!batch_count) throw RecoveryFailure("Invalid snapshot data!");
+          batches.push_back({*offset, *batch_count});
+          count += *batch_count;
+        }
+        if (count != expected_count) throw RecoveryFailure("Invalid snapshot data!");
+        return batches;
+      };
+      info.edge_batches = read_batches(info.edges_count);
+      info.vertex_batches = read_batches(info.vertices_count);
+    } else {
+      if (info.offset_edges != 0) info.edge_batches.push_back({info.offset_edges, info.edges_count});
+      info.vertex_batches.push_back({info.offset_vertices, info.vertices_count});
+    }
+
+    if (*version >= kIncrementalSnapshotVersion) {
+      auto incremental = snapshot.ReadBool();
+      if (!incremental) throw RecoveryFailure("Invalid snapshot data!");
+      info.incremental = *incremental;
+      auto base_timestamp = snapshot.ReadUint();
+      if (!base_timestamp) throw RecoveryFailure("Invalid snapshot data!");
+      info.base_timestamp = *base_timestamp;
+      auto offset_deleted = snapshot.ReadUint();
+      if (!offset_deleted) throw RecoveryFailure("Invalid snapshot data!");
+      if (info.incremental == (*offset_deleted == 0)) throw RecoveryFailure("Invalid snapshot data!");
+      info.offset_deleted = *offset_deleted;
+    }
   }
 
   return info;
 }
 
+namespace {
+
+// Calls `callback(batch_index, batch)` for each of the batches. The batches are
+// distributed between at most `num_threads` threads, including the calling
+// thread. If any of the callbacks throws, the exception is rethrown once all
+// threads are done.
+template <typename TCallback>
+void ForEachBatchInParallel(const std::vector<BatchInfo> &batches, uint64_t num_threads, const TCallback &callback) {
+  std::atomic<size_t> next_batch{0};
+  std::atomic<bool> failed{false};
+  const auto thread_count = std::min<size_t>(std::max<uint64_t>(num_threads, 1), batches.size());
+  if (thread_count == 0) return;
+  std::vector<std::exception_ptr> errors(thread_count);
+  auto process_batches = [&](size_t thread_index) {
+    utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+    try {
+      for (auto i = next_batch.fetch_add(1); i < batches.size() && !failed.load(); i = next_batch.fetch_add(1)) {
+        callback(i, batches[i]);
+      }
+    } catch (...) {
+      errors[thread_index] = std::current_exception();
+      failed.store(true);
+    }
+  };
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(thread_count - 1);
+    for (size_t i = 1; i < thread_count; ++i) {
+      threads.emplace_back(process_batches, i);
+    }
+    process_batches(0);
+  }
+  for (const auto &error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
+
+}  // namespace
+
 RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipList<Vertex> *vertices,
                                utils::SkipList<Edge> *edges,
                                std::deque<std::pair<std::string, uint64_t>> *epoch_history,
-                               NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count, Config::Items items) {
+                               NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count, const Config &config) {
   RecoveryInfo ret;
   RecoveredIndicesAndConstraints indices_constraints;
 
@@ -181,7 +313,12 @@ RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipLis
 
   // Read snapshot info.
   const auto info = ReadSnapshotInfo(path);
-  spdlog::info("Recovering {} vertices and {} edges.", info.vertices_count, info.edges_count);
+  if (info.incremental) {
+    spdlog::info("Applying {} modified vertices and {} modified edges of an incremental snapshot.",
+                 info.vertices_count, info.edges_count);
+  } else {
+    spdlog::info("Recovering {} vertices and {} edges.", info.vertices_count, info.edges_count);
+  }
   // Check for edges.
   bool snapshot_has_edges = info.offset_edges != 0;
 
@@ -223,265 +360,380 @@ RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipLis
     return EdgeTypeId::FromUint(it->second);
   };
 
-  // Reset current edge count.
+  // Reset current edge count. The edges of an incremental snapshot are
+  // counted once it is applied.
   edge_count->store(0, std::memory_order_release);
 
+  const auto num_threads = config.durability.recovery_thread_count;
+  const auto items = config.items;
+
+  // Each of the batches is recovered by a thread which has its own decoder.
+  auto open_batch = [&snapshot](const BatchInfo &batch) {
+    auto decoder = std::make_unique<Decoder>();
+    if (!decoder->Initialize(snapshot)) throw RecoveryFailure("Couldn't read data from snapshot!");
+    if (!decoder->SetPosition(batch.offset)) throw RecoveryFailure("Couldn't read data from snapshot!");
+    return decoder;
+  };
+  // Checks that the GIDs are sorted across the batches. Each batch checks
+  // only the order of its own GIDs.
+  auto check_batches_order = [](const std::vector<std::pair<uint64_t, uint64_t>> &gid_ranges) {
+    for (size_t i = 1; i < gid_ranges.size(); ++i) {
+      if (gid_ranges[i].first <= gid_ranges[i - 1].second) throw RecoveryFailure("Invalid snapshot data!");
+    }
+  };
+
   {
     // Recover edges.
-    auto edge_acc = edges->access();
     uint64_t last_edge_gid = 0;
     if (snapshot_has_edges) {
-      spdlog::info("Recovering {} edges.", info.edges_count);
-      if (!snapshot.SetPosition(info.offset_edges)) throw RecoveryFailure("Couldn't read data from snapshot!");
-      for (uint64_t i = 0; i < info.edges_count; ++i) {
-        {
-          const auto marker = snapshot.ReadMarker();
-          if (!marker || *marker != Marker::SECTION_EDGE) throw RecoveryFailure("Invalid snapshot data!");
+      spdlog::info("Recovering {} edges in {} batches.", info.edges_count, info.edge_batches.size());
+      utils::Timer timer;
+      // The first and the last GID of each batch.
+      std::vector<std::pair<uint64_t, uint64_t>> gid_ranges(info.edge_batches.size());
+      ForEachBatchInParallel(info.edge_batches, num_threads, [&](size_t batch_index, const BatchInfo &batch) {
+        auto snapshot = open_batch(batch);
+        auto edge_acc = edges->access();
+        auto &[first_gid, last_gid] = gid_ranges[batch_index];
+        for (uint64_t i = 0; i < batch.count; ++i) {
+          {
+            const auto marker = snapshot->ReadMarker();
+            if (!marker || *marker != Marker::SECTION_EDGE) throw RecoveryFailure("Invalid snapshot data!");
+          }
+
+          // Read edge GID.
+          auto gid = snapshot->ReadUint();
+          if (!gid) throw RecoveryFailure("Invalid snapshot data!");
+          if (i > 0 && *gid <= last_gid) throw RecoveryFailure("Invalid snapshot data!");
+          if (i == 0) first_gid = *gid;
+          last_gid = *gid;
+
+          if (items.properties_on_edges) {
+            // Insert edge.
+            spdlog::debug("Recovering edge {} with properties.", *gid);
+            auto [it, inserted] = edge_acc.insert(Edge{Gid::FromUint(*gid), nullptr});
+            if (!inserted) {
+              // An incremental snapshot replaces the properties of the edges
+              // which already exist.
+              if (!info.incremental) throw RecoveryFailure("The edge must be inserted here!");
+              it->properties.ClearProperties();
+            }
+
+            // Recover properties.
+            {
+              auto props_size = snapshot->ReadUint();
+              if (!props_size) throw RecoveryFailure("Invalid snapshot data!");
+              auto &props = it->properties;
+              for (uint64_t j = 0; j < *props_size; ++j) {
+                auto key = snapshot->ReadUint();
+                if (!key) throw RecoveryFailure("Invalid snapshot data!");
+                auto value = snapshot->ReadPropertyValue();
+                if (!value) throw RecoveryFailure("Invalid snapshot data!");
+                SPDLOG_TRACE("Recovered property \"{}\" with value \"{}\" for edge {}.",
+                             name_id_mapper->IdToName(snapshot_id_map.at(*key)), *value, *gid);
+                props.SetProperty(get_property_from_id(*key), *value);
+              }
+            }
+          } else {
+            spdlog::debug("Ensuring edge {} doesn't have any properties.", *gid);
+            // Read properties.
+            {
+              auto props_size = snapshot->ReadUint();
+              if (!props_size) throw RecoveryFailure("Invalid snapshot data!");
+              if (*props_size != 0)
+                throw RecoveryFailure(
+                    "The snapshot has properties on edges, but the storage is "
+                    "configured without properties on edges!");
+            }
+          }
         }
+      });
+      check_batches_order(gid_ranges);
+      if (!gid_ranges.empty()) last_edge_gid = gid_ranges.back().second;
+      spdlog::info("Edges are recovered in {:.3f} seconds.", timer.Elapsed().count());
+    }
 
-        if (items.properties_on_edges) {
-          // Insert edge.
-          auto gid = snapshot.ReadUint();
+    // Recover vertices (labels and properties).
+    uint64_t last_vertex_gid = 0;
+    {
+      spdlog::info("Recovering {} vertices in {} batches.", info.vertices_count, info.vertex_batches.size());
+      utils::Timer timer;
+      std::vector<std::pair<uint64_t, uint64_t>> gid_ranges(info.vertex_batches.size());
+      ForEachBatchInParallel(info.vertex_batches, num_threads, [&](size_t batch_index, const BatchInfo &batch) {
+        auto snapshot = open_batch(batch);
+        auto vertex_acc = vertices->access();
+        auto &[first_gid, last_gid] = gid_ranges[batch_index];
+        for (uint64_t i = 0; i < batch.count; ++i) {
+          {
+            auto marker = snapshot->ReadMarker();
+            if (!marker || *marker != Marker::SECTION_VERTEX) throw RecoveryFailure("Invalid snapshot data!");
+          }
+
+          // Insert vertex.
+          auto gid = snapshot->ReadUint();
           if (!gid) throw RecoveryFailure("Invalid snapshot data!");
-          if (i > 0 && *gid <= last_edge_gid) throw RecoveryFailure("Invalid snapshot data!");
-          last_edge_gid = *gid;
-          spdlog::debug("Recovering edge {} with properties.", *gid);
-          auto [it, inserted] = edge_acc.insert(Edge{Gid::FromUint(*gid), nullptr});
-          if (!inserted) throw RecoveryFailure("The edge must be inserted here!");
+          if (i > 0 && *gid <= last_gid) {
+            throw RecoveryFailure("Invalid snapshot data!");
+          }
+          if (i == 0) first_gid = *gid;
+          last_gid = *gid;
+          spdlog::debug("Recovering vertex {}.", *gid);
+          auto [it, inserted] = vertex_acc.insert(Vertex{Gid::FromUint(*gid), nullptr});
+          if (!inserted) {
+            // An incremental snapshot replaces the labels and the properties
+            // of the vertices which already exist.
+            if (!info.incremental) throw RecoveryFailure("The vertex must be inserted here!");
+            it->labels.clear();
+            it->properties.ClearProperties();
+          }
+
+          // Recover labels.
+          spdlog::trace("Recovering labels for vertex {}.", *gid);
+          {
+            auto labels_size = snapshot->ReadUint();
+            if (!labels_size) throw RecoveryFailure("Invalid snapshot data!");
+            auto &labels = it->labels;
+            labels.reserve(*labels_size);
+            for (uint64_t j = 0; j < *labels_size; ++j) {
+              auto label = snapshot->ReadUint();
+              if (!label) throw RecoveryFailure("Invalid snapshot data!");
+              SPDLOG_TRACE("Recovered label \"{}\" for vertex {}.",
+                           name_id_mapper->IdToName(snapshot_id_map.at(*label)), *gid);
+              labels.emplace_back(get_label_from_id(*label));
+            }
+          }
 
           // Recover properties.
+          spdlog::trace("Recovering properties for vertex {}.", *gid);
           {
-            auto props_size = snapshot.ReadUint();
+            auto props_size = snapshot->ReadUint();
             if (!props_size) throw RecoveryFailure("Invalid snapshot data!");
             auto &props = it->properties;
             for (uint64_t j = 0; j < *props_size; ++j) {
-              auto key = snapshot.ReadUint();
+              auto key = snapshot->ReadUint();
               if (!key) throw RecoveryFailure("Invalid snapshot data!");
-              auto value = snapshot.ReadPropertyValue();
+              auto value = snapshot->ReadPropertyValue();
               if (!value) throw RecoveryFailure("Invalid snapshot data!");
-              SPDLOG_TRACE("Recovered property \"{}\" with value \"{}\" for edge {}.",
+              SPDLOG_TRACE("Recovered property \"{}\" with value \"{}\" for vertex {}.",
                            name_id_mapper->IdToName(snapshot_id_map.at(*key)), *value, *gid);
               props.SetProperty(get_property_from_id(*key), *value);
             }
           }
-        } else {
-          // Read edge GID.
-          auto gid = snapshot.ReadUint();
-          if (!gid) throw RecoveryFailure("Invalid snapshot data!");
-          if (i > 0 && *gid <= last_edge_gid) throw RecoveryFailure("Invalid snapshot data!");
-          last_edge_gid = *gid;
 
-          spdlog::debug("Ensuring edge {} doesn't have any properties.", *gid);
-          // Read properties.
+          // Skip in edges.
           {
-            auto props_size = snapshot.ReadUint();
-            if (!props_size) throw RecoveryFailure("Invalid snapshot data!");
-            if (*props_size != 0)
-              throw RecoveryFailure(
-                  "The snapshot has properties on edges, but the storage is "
-                  "configured without properties on edges!");
+            auto in_size = snapshot->ReadUint();
+            if (!in_size) throw RecoveryFailure("Invalid snapshot data!");
+            for (uint64_t j = 0; j < *in_size; ++j) {
+              auto edge_gid = snapshot->ReadUint();
+              if (!edge_gid) throw RecoveryFailure("Invalid snapshot data!");
+              auto from_gid = snapshot->ReadUint();
+              if (!from_gid) throw RecoveryFailure("Invalid snapshot data!");
+              auto edge_type = snapshot->ReadUint();
+              if (!edge_type) throw RecoveryFailure("Invalid snapshot data!");
+            }
           }
-        }
-      }
-      spdlog::info("Edges are recovered.");
-    }
-
-    // Recover vertices (labels and properties).
-    if (!snapshot.SetPosition(info.offset_vertices)) throw RecoveryFailure("Couldn't read data from snapshot!");
-    auto vertex_acc = vertices->access();
-    uint64_t last_vertex_gid = 0;
-    spdlog::info("Recovering {} vertices.", info.vertices_count);
-    for (uint64_t i = 0; i < info.vertices_count; ++i) {
-      {
-        auto marker = snapshot.ReadMarker();
-        if (!marker || *marker != Marker::SECTION_VERTEX) throw RecoveryFailure("Invalid snapshot data!");
-      }
-
-      // Insert vertex.
-      auto gid = snapshot.ReadUint();
-      if (!gid) throw RecoveryFailure("Invalid snapshot data!");
-      if (i > 0 && *gid <= last_vertex_gid) {
-        throw RecoveryFailure("Invalid snapshot data!");
-      }
-      last_vertex_gid = *gid;
-      spdlog::debug("Recovering vertex {}.", *gid);
-      auto [it, inserted] = vertex_acc.insert(Vertex{Gid::FromUint(*gid), nullptr});
-      if (!inserted) throw RecoveryFailure("The vertex must be inserted here!");
-
-      // Recover labels.
-      spdlog::trace("Recovering labels for vertex {}.", *gid);
-      {
-        auto labels_size = snapshot.ReadUint();
-        if (!labels_size) throw RecoveryFailure("Invalid snapshot data!");
-        auto &labels = it->labels;
-        labels.reserve(*labels_size);
-        for (uint64_t j = 0; j < *labels_size; ++j) {
-          auto label = snapshot.ReadUint();
-          if (!label) throw RecoveryFailure("Invalid snapshot data!");
-          SPDLOG_TRACE("Recovered label \"{}\" for vertex {}.", name_id_mapper->IdToName(snapshot_id_map.at(*label)),
-                       *gid);
-          labels.emplace_back(get_label_from_id(*label));
-        }
-      }
-
-      // Recover properties.
-      spdlog::trace("Recovering properties for vertex {}.", *gid);
-      {
-        auto props_size = snapshot.ReadUint();
-        if (!props_size) throw RecoveryFailure("Invalid snapshot data!");
-        auto &props = it->properties;
-        for (uint64_t j = 0; j < *props_size; ++j) {
-          auto key = snapshot.ReadUint();
-          if (!key) throw RecoveryFailure("Invalid snapshot data!");
-          auto value = snapshot.ReadPropertyValue();
-          if (!value) throw RecoveryFailure("Invalid snapshot data!");
-          SPDLOG_TRACE("Recovered property \"{}\" with value \"{}\" for vertex {}.",
-                       name_id_mapper->IdToName(snapshot_id_map.at(*key)), *value, *gid);
-          props.SetProperty(get_property_from_id(*key), *value);
-        }
-      }
 
-      // Skip in edges.
-      {
-        auto in_size = snapshot.ReadUint();
-        if (!in_size) throw RecoveryFailure("Invalid snapshot data!");
-        for (uint64_t j = 0; j < *in_size; ++j) {
-          auto edge_gid = snapshot.ReadUint();
-          if (!edge_gid) throw RecoveryFailure("Invalid snapshot data!");
-          auto from_gid = snapshot.ReadUint();
-          if (!from_gid) throw RecoveryFailure("Invalid snapshot data!");
-          auto edge_type = snapshot.ReadUint();
-          if (!edge_type) throw RecoveryFailure("Invalid snapshot data!");
+          // Skip out edges.
+          auto out_size = snapshot->ReadUint();
+          if (!out_size) throw RecoveryFailure("Invalid snapshot data!");
+          for (uint64_t j = 0; j < *out_size; ++j) {
+            auto edge_gid = snapshot->ReadUint();
+            if (!edge_gid) throw RecoveryFailure("Invalid snapshot data!");
+            auto to_gid = snapshot->ReadUint();
+            if (!to_gid) throw RecoveryFailure("Invalid snapshot data!");
+            auto edge_type = snapshot->ReadUint();
+            if (!edge_type) throw RecoveryFailure("Invalid snapshot data!");
+          }
         }
-      }
-
-      // Skip out edges.
-      auto out_size = snapshot.ReadUint();
-      if (!out_size) throw RecoveryFailure("Invalid snapshot data!");
-      for (uint64_t j = 0; j < *out_size; ++j) {
-        auto edge_gid = snapshot.ReadUint();
-        if (!edge_gid) throw RecoveryFailure("Invalid snapshot data!");
-        auto to_gid = snapshot.ReadUint();
-        if (!to_gid) throw RecoveryFailure("Invalid snapshot data!");
-        auto edge_type = snapshot.ReadUint();
-        if (!edge_type) throw RecoveryFailure("Invalid snapshot data!");
-      }
+      });
+      check_batches_order(gid_ranges);
+      if (!gid_ranges.empty()) last_vertex_gid = gid_ranges.back().second;
+      spdlog::info("Vertices are recovered in {:.3f} seconds.", timer.Elapsed().count());
     }
-    spdlog::info("Vertices are recovered.");
-
-    // Recover vertices (in/out edges).
-    spdlog::info("Recovering connectivity.");
-    if (!snapshot.SetPosition(info.offset_vertices)) throw RecoveryFailure("Couldn't read data from snapshot!");
-    for (auto &vertex : vertex_acc) {
-      {
-        auto marker = snapshot.ReadMarker();
-        if (!marker || *marker != Marker::SECTION_VERTEX) throw RecoveryFailure("Invalid snapshot data!");
-      }
-
-      spdlog::trace("Recovering connectivity for vertex {}.", vertex.gid.AsUint());
-      // Check vertex.
-      auto gid = snapshot.ReadUint();
-      if (!gid) throw RecoveryFailure("Invalid snapshot data!");
-      if (gid != vertex.gid.AsUint()) throw RecoveryFailure("Invalid snapshot data!");
-
-      // Skip labels.
-      {
-        auto labels_size = snapshot.ReadUint();
-        if (!labels_size) throw RecoveryFailure("Invalid snapshot data!");
-        for (uint64_t j = 0; j < *labels_size; ++j) {
-          auto label = snapshot.ReadUint();
-          if (!label) throw RecoveryFailure("Invalid snapshot data!");
-        }
-      }
 
-      // Skip properties.
-      {
-        auto props_size = snapshot.ReadUint();
-        if (!props_size) throw RecoveryFailure("Invalid snapshot data!");
-        for (uint64_t j = 0; j < *props_size; ++j) {
-          auto key = snapshot.ReadUint();
-          if (!key) throw RecoveryFailure("Invalid snapshot data!");
-          auto value = snapshot.SkipPropertyValue();
-          if (!value) throw RecoveryFailure("Invalid snapshot data!");
-        }
-      }
-
-      // Recover in edges.
-      {
-        spdlog::trace("Recovering inbound edges for vertex {}.", vertex.gid.AsUint());
-        auto in_size = snapshot.ReadUint();
-        if (!in_size) throw RecoveryFailure("Invalid snapshot data!");
-        vertex.in_edges.reserve(*in_size);
-        for (uint64_t j = 0; j < *in_size; ++j) {
-          auto edge_gid = snapshot.ReadUint();
-          if (!edge_gid) throw RecoveryFailure("Invalid snapshot data!");
-          last_edge_gid = std::max(last_edge_gid, *edge_gid);
-
-          auto from_gid = snapshot.ReadUint();
-          if (!from_gid) throw RecoveryFailure("Invalid snapshot data!");
-          auto edge_type = snapshot.ReadUint();
-          if (!edge_type) throw RecoveryFailure("Invalid snapshot data!");
+    // Recover vertices (in/out edges). All of the vertices have to be
+    // inserted before, because the edges point to the vertices from the other
+    // batches. Each vertex is modified only by the thread which recovers its
+    // batch.
+    {
+      spdlog::info("Recovering connectivity.");
+      utils::Timer timer;
+      std::vector<uint64_t> last_edge_gids(info.vertex_batches.size(), 0);
+      ForEachBatchInParallel(info.vertex_batches, num_threads, [&](size_t batch_index, const BatchInfo &batch) {
+        if (batch.count == 0) return;
+        auto snapshot = open_batch(batch);
+        auto vertex_acc = vertices->access();
+        auto edge_acc = edges->access();
+        auto &batch_last_edge_gid = last_edge_gids[batch_index];
+        uint64_t batch_edge_count = 0;
+        // The vertices of the batch are consecutive in the skip list, so only
+        // the first one has to be searched for. That doesn't hold for an
+        // incremental snapshot because the list holds the unmodified vertices
+        // as well.
+        auto vertex_it = vertex_acc.end();
+        for (uint64_t i = 0; i < batch.count; ++i) {
+          {
+            auto marker = snapshot->ReadMarker();
+            if (!marker || *marker != Marker::SECTION_VERTEX) throw RecoveryFailure("Invalid snapshot data!");
+          }
 
-          auto from_vertex = vertex_acc.find(Gid::FromUint(*from_gid));
-          if (from_vertex == vertex_acc.end()) throw RecoveryFailure("Invalid from vertex!");
+          // Check vertex.
+          auto gid = snapshot->ReadUint();
+          if (!gid) throw RecoveryFailure("Invalid snapshot data!");
+          if (i == 0 || info.incremental) {
+            vertex_it = vertex_acc.find(Gid::FromUint(*gid));
+          } else if (vertex_it != vertex_acc.end()) {
+            ++vertex_it;
+          }
+          if (vertex_it == vertex_acc.end() || *gid != vertex_it->gid.AsUint()) {
+            throw RecoveryFailure("Invalid snapshot data!");
+          }
+          auto &vertex = *vertex_it;
+          spdlog::trace("Recovering connectivity for vertex {}.", vertex.gid.AsUint());
+          if (info.incremental) {
+            // The snapshot holds all of the edges of the modified vertex.
+            vertex.in_edges = EdgeList();
+            vertex.out_edges = EdgeList();
+          }
 
-          EdgeRef edge_ref(Gid::FromUint(*edge_gid));
-          if (items.properties_on_edges) {
-            if (snapshot_has_edges) {
-              auto edge = edge_acc.find(Gid::FromUint(*edge_gid));
-              if (edge == edge_acc.end()) throw RecoveryFailure("Invalid edge!");
-              edge_ref = EdgeRef(&*edge);
-            } else {
-              auto [edge, inserted] = edge_acc.insert(Edge{Gid::FromUint(*edge_gid), nullptr});
-              edge_ref = EdgeRef(&*edge);
+          // Skip labels.
+          {
+            auto labels_size = snapshot->ReadUint();
+            if (!labels_size) throw RecoveryFailure("Invalid snapshot data!");
+            for (uint64_t j = 0; j < *labels_size; ++j) {
+              auto label = snapshot->ReadUint();
+              if (!label) throw RecoveryFailure("Invalid snapshot data!");
             }
           }
-          SPDLOG_TRACE("Recovered inbound edge {} with label \"{}\" from vertex {}.", *edge_gid,
-                       name_id_mapper->IdToName(snapshot_id_map.at(*edge_type)), from_vertex->gid.AsUint());
-          vertex.in_edges.emplace_back(get_edge_type_from_id(*edge_type), &*from_vertex, edge_ref);
-        }
-      }
 
-      // Recover out edges.
-      {
-        spdlog::trace("Recovering outbound edges for vertex {}.", vertex.gid.AsUint());
-        auto out_size = snapshot.ReadUint();
-        if (!out_size) throw RecoveryFailure("Invalid snapshot data!");
-        vertex.out_edges.reserve(*out_size);
-        for (uint64_t j = 0; j < *out_size; ++j) {
-          auto edge_gid = snapshot.ReadUint();
-          if (!edge_gid) throw RecoveryFailure("Invalid snapshot data!");
-          last_edge_gid = std::max(last_edge_gid, *edge_gid);
-
-          auto to_gid = snapshot.ReadUint();
-          if (!to_gid) throw RecoveryFailure("Invalid snapshot data!");
-          auto edge_type = snapshot.ReadUint();
-          if (!edge_type) throw RecoveryFailure("Invalid snapshot data!");
+          // Skip properties.
+          {
+            auto props_size = snapshot->ReadUint();
+            if (!props_size) throw RecoveryFailure("Invalid snapshot data!");
+            for (uint64_t j = 0; j < *props_size; ++j) {
+              auto key = snapshot->ReadUint();
+              if (!key) throw RecoveryFailure("Invalid snapshot data!");
+              auto value = snapshot->SkipPropertyValue();
+              if (!value) throw RecoveryFailure("Invalid snapshot data!");
+            }
+          }
 
-          auto to_vertex = vertex_acc.find(Gid::FromUint(*to_gid));
-          if (to_vertex == vertex_acc.end()) throw RecoveryFailure("Invalid to vertex!");
+          // Recover in edges.
+          {
+            spdlog::trace("Recovering inbound edges for vertex {}.", vertex.gid.AsUint());
+            auto in_size = snapshot->ReadUint();
+            if (!in_size) throw RecoveryFailure("Invalid snapshot data!");
+            for (uint64_t j = 0; j < *in_size; ++j) {
+              auto edge_gid = snapshot->ReadUint();
+              if (!edge_gid) throw RecoveryFailure("Invalid snapshot data!");
+              batch_last_edge_gid = std::max(batch_last_edge_gid, *edge_gid);
+
+              auto from_gid = snapshot->ReadUint();
+              if (!from_gid) throw RecoveryFailure("Invalid snapshot data!");
+              auto edge_type = snapshot->ReadUint();
+              if (!edge_type) throw RecoveryFailure("Invalid snapshot data!");
+
+              auto from_vertex = vertex_acc.find(Gid::FromUint(*from_gid));
+              if (from_vertex == vertex_acc.end()) throw RecoveryFailure("Invalid from vertex!");
+
+              EdgeRef edge_ref(Gid::FromUint(*edge_gid));
+              if (items.properties_on_edges) {
+                if (snapshot_has_edges) {
+                  auto edge = edge_acc.find(Gid::FromUint(*edge_gid));
+                  if (edge == edge_acc.end()) throw RecoveryFailure("Invalid edge!");
+                  edge_ref = EdgeRef(&*edge);
+                } else {
+                  // The edge is inserted by the thread which recovers the
+                  // other endpoint if it's in a different batch, so it may
+                  // already exist.
+                  auto [edge, inserted] = edge_acc.insert(Edge{Gid::FromUint(*edge_gid), nullptr});
+                  edge_ref = EdgeRef(&*edge);
+                }
+              }
+              SPDLOG_TRACE("Recovered inbound edge {} with label \"{}\" from vertex {}.", *edge_gid,
+                           name_id_mapper->IdToName(snapshot_id_map.at(*edge_type)), from_vertex->gid.AsUint());
+              vertex.in_edges.Add(get_edge_type_from_id(*edge_type), &*from_vertex, edge_ref);
+            }
+          }
 
-          EdgeRef edge_ref(Gid::FromUint(*edge_gid));
-          if (items.properties_on_edges) {
-            if (snapshot_has_edges) {
-              auto edge = edge_acc.find(Gid::FromUint(*edge_gid));
-              if (edge == edge_acc.end()) throw RecoveryFailure("Invalid edge!");
-              edge_ref = EdgeRef(&*edge);
-            } else {
-              auto [edge, inserted] = edge_acc.insert(Edge{Gid::FromUint(*edge_gid), nullptr});
-              edge_ref = EdgeRef(&*edge);
+          // Recover out edges.
+          {
+            spdlog::trace("Recovering outbound edges for vertex {}.", vertex.gid.AsUint());
+            auto out_size = snapshot->ReadUint();
+            if (!out_size) throw RecoveryFailure("Invalid snapshot data!");
+            for (uint64_t j = 0; j < *out_size; ++j) {
+              auto edge_gid = snapshot->ReadUint();
+              if (!edge_gid) throw RecoveryFailure("Invalid snapshot data!");
+              batch_last_edge_gid = std::max(batch_last_edge_gid, *edge_gid);
+
+              auto to_gid = snapshot->ReadUint();
+              if (!to_gid) throw RecoveryFailure("Invalid snapshot data!");
+              auto edge_type = snapshot->ReadUint();
+              if (!edge_type) throw RecoveryFailure("Invalid snapshot data!");
+
+              auto to_vertex = vertex_acc.find(Gid::FromUint(*to_gid));
+              if (to_vertex == vertex_acc.end()) throw RecoveryFailure("Invalid to vertex!");
+
+              EdgeRef edge_ref(Gid::FromUint(*edge_gid));
+              if (items.properties_on_edges) {
+                if (snapshot_has_edges) {
+                  auto edge = edge_acc.find(Gid::FromUint(*edge_gid));
+                  if (edge == edge_acc.end()) throw RecoveryFailure("Invalid edge!");
+                  edge_ref = EdgeRef(&*edge);
+                } else {
+                  auto [edge, inserted] = edge_acc.insert(Edge{Gid::FromUint(*edge_gid), nullptr});
+                  edge_ref = EdgeRef(&*edge);
+                }
+              }
+              SPDLOG_TRACE("Recovered outbound edge {} with label \"{}\" to vertex {}.", *edge_gid,
+                           name_id_mapper->IdToName(snapshot_id_map.at(*edge_type)), to_vertex->gid.AsUint());
+              vertex.out_edges.Add(get_edge_type_from_id(*edge_type), &*to_vertex, edge_ref);
             }
+            // Increment edge count. We only increment the count here because
+            // the information is duplicated in in_edges.
+            batch_edge_count += *out_size;
           }
-          SPDLOG_TRACE("Recovered outbound edge {} with label \"{}\" to vertex {}.", *edge_gid,
-                       name_id_mapper->IdToName(snapshot_id_map.at(*edge_type)), to_vertex->gid.AsUint());
-          vertex.out_edges.emplace_back(get_edge_type_from_id(*edge_type), &*to_vertex, edge_ref);
         }
-        // Increment edge count. We only increment the count here because the
-        // information is duplicated in in_edges.
-        edge_count->fetch_add(*out_size, std::memory_order_acq_rel);
+        edge_count->fetch_add(batch_edge_count, std::memory_order_acq_rel);
+      });
+      for (const auto gid : last_edge_gids) last_edge_gid = std::max(last_edge_gid, gid);
+      spdlog::info("Connectivity is recovered in {:.3f} seconds.", timer.Elapsed().count());
+    }
+
+    // Remove the deleted objects and count the edges of an incremental
+    // snapshot. The vertices which were connected to the deleted objects are
+    // modified as well, so none of the remaining vertices point to them.
+    if (info.incremental) {
+      if (!snapshot.SetPosition(info.offset_deleted)) throw RecoveryFailure("Couldn't read data from snapshot!");
+      const auto marker = snapshot.ReadMarker();
+      if (!marker || *marker != Marker::SECTION_DELETED) throw RecoveryFailure("Invalid snapshot data!");
+      auto read_gids = [&snapshot] {
+        auto size = snapshot.ReadUint();
+        if (!size) throw RecoveryFailure("Invalid snapshot data!");
+        std::vector<Gid> gids;
+        gids.reserve(*size);
+        for (uint64_t i = 0; i < *size; ++i) {
+          auto gid = snapshot.ReadUint();
+          if (!gid) throw RecoveryFailure("Invalid snapshot data!");
+          gids.push_back(Gid::FromUint(*gid));
+        }
+        return gids;
+      };
+      const auto deleted_edges = read_gids();
+      const auto deleted_vertices = read_gids();
+      spdlog::info("Removing {} deleted vertices and {} deleted edges.", deleted_vertices.size(),
+                   deleted_edges.size());
+      {
+        auto edge_acc = edges->access();
+        for (const auto gid : deleted_edges) edge_acc.remove(gid);
       }
+      auto vertex_acc = vertices->access();
+      for (const auto gid : deleted_vertices) vertex_acc.remove(gid);
+
+      uint64_t total_edge_count = 0;
+      for (const auto &vertex : vertex_acc) total_edge_count += vertex.out_edges.size();
+      edge_count->store(total_edge_count, std::memory_order_release);
     }
-    spdlog::info("Connectivity is recovered.");
 
     // Set initial values for edge/vertex ID generators.
     ret.next_edge_id = last_edge_gid + 1;
@@ -530,6 +782,78 @@ RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipLis
       }
       spdlog::info("Metadata of label+property indices are recovered.");
     }
+
+    // Recover edge type and edge type+property indices.
+    // Snapshot version should be checked since edge indices were implemented
+    // in later versions of snapshot.
+    if (*version >= kEdgeTypeIndexVersion) {
+      {
+        auto size = snapshot.ReadUint();
+        if (!size) throw RecoveryFailure("Invalid snapshot data!");
+        spdlog::info("Recovering metadata of {} edge type indices.", *size);
+        for (uint64_t i = 0; i < *size; ++i) {
+          auto edge_type = snapshot.ReadUint();
+          if (!edge_type) throw RecoveryFailure("Invalid snapshot data!");
+          AddRecoveredIndexConstraint(&indices_constraints.indices.edge_type, get_edge_type_from_id(*edge_type),
+                                      "The edge type index already exists!");
+          SPDLOG_TRACE("Recovered metadata of edge type index for :{}",
+                       name_id_mapper->IdToName(snapshot_id_map.at(*edge_type)));
+        }
+        spdlog::info("Metadata of edge type indices are recovered.");
+      }
+      {
+        auto size = snapshot.ReadUint();
+        if (!size) throw RecoveryFailure("Invalid snapshot data!");
+        spdlog::info("Recovering metadata of {} edge type+property indices.", *size);
+        for (uint64_t i = 0; i < *size; ++i) {
+          auto edge_type = snapshot.ReadUint();
+          if (!edge_type) throw RecoveryFailure("Invalid snapshot data!");
+          auto property = snapshot.ReadUint();
+          if (!property) throw RecoveryFailure("Invalid snapshot data!");
+          AddRecoveredIndexConstraint(&indices_constraints.indices.edge_type_property,
+                                      {get_edge_type_from_id(*edge_type), get_property_from_id(*property)},
+                                      "The edge type+property index already exists!");
+          SPDLOG_TRACE("Recovered metadata of edge type+property index for :{}({})",
+                       name_id_mapper->IdToName(snapshot_id_map.at(*edge_type)),
+                       name_id_mapper->IdToName(snapshot_id_map.at(*property)));
+        }
+        spdlog::info("Metadata of edge type+property indices are recovered.");
+      }
+    }
+
+    // Recover label+properties composite indices.
+    if (*version >= kCompositeIndexVersion) {
+      auto size = snapshot.ReadUint();
+      if (!size) throw RecoveryFailure("Invalid snapshot data!");
+      spdlog::info("Recovering metadata of {} label+properties composite indices.", *size);
+      for (uint64_t i = 0; i < *size; ++i) {
+        auto label = snapshot.ReadUint();
+        if (!label) throw RecoveryFailure("Invalid snapshot data!");
+        auto properties_count = snapshot.ReadUint();
+        if (!properties_count) throw RecoveryFailure("Invalid snapshot data!");
+        std::vector<PropertyId> properties;
+        properties.reserve(*properties_count);
+        for (uint64_t j = 0; j < *properties_count; ++j) {
+          auto property = snapshot.ReadUint();
+          if (!property) throw RecoveryFailure("Invalid snapshot data!");
+          properties.push_back(get_property_from_id(*property));
+        }
+        AddRecoveredIndexConstraint(&indices_constraints.indices.label_property_composite,
+                                    {get_label_from_id(*label), std::move(properties)},
+                                    "The label+properties composite index already exists!");
+        SPDLOG_TRACE("Recovered metadata of label+properties composite index for :{}",
+                     name_id_mapper->IdToName(snapshot_id_map.at(*label)));
+      }
+      spdlog::info("Metadata of label+properties composite indices are recovered.");
+    }
+
+    // Recover graph statistics.
+    if (*version >= kGraphStatisticsVersion) {
+      auto statistics = DecodeGraphStatistics(&snapshot);
+      if (!statistics) throw RecoveryFailure("Invalid snapshot data!");
+      indices_constraints.statistics = std::move(*statistics);
+      spdlog::info("Graph statistics are recovered.");
+    }
     spdlog::info("Metadata of indices are recovered.");
   }
 
@@ -602,6 +926,10 @@ RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipLis
       throw RecoveryFailure("Invalid snapshot data!");
     }
 
+    // The history of an incremental snapshot replaces the history of the
+    // snapshot it is based on.
+    epoch_history->clear();
+
     for (int i = 0; i < *history_size; ++i) {
       auto maybe_epoch_id = snapshot.ReadString();
       if (!maybe_epoch_id) {
@@ -625,20 +953,192 @@ RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipLis
   return {info, ret, std::move(indices_constraints)};
 }
 
+namespace {
+
+// Part of the snapshot which is written by a single thread into its own file.
+struct SnapshotSegment {
+  std::filesystem::path path;
+  // Batches of the objects in the segment. The offsets are relative to the
+  // start of the segment.
+  std::vector<BatchInfo> batches;
+  uint64_t count{0};
+  // Size of the segment data before it is compressed.
+  uint64_t size{0};
+  // Ids of the labels, properties and edge types used by the objects.
+  std::unordered_set<uint64_t> used_ids;
+};
+
+template <typename TId>
+void WriteMapping(Encoder *encoder, std::unordered_set<uint64_t> *used_ids, TId mapping) {
+  used_ids->insert(mapping.AsUint());
+  encoder->WriteUint(mapping.AsUint());
+}
+
+void RemoveSegments(const std::vector<SnapshotSegment> &segments) {
+  for (const auto &segment : segments) {
+    std::error_code error_code;  // For exception suppression.
+    std::filesystem::remove(segment.path, error_code);
+  }
+}
+
+// Splits the objects into at most `num_threads` chunks and writes each of the
+// chunks into its own segment, the calling thread writes the first one.
+// `encode(encoder, object, used_ids)` writes a single object and returns
+// whether the object was written at all. The segments are returned in the
+// order of the objects. If any of the threads fails, all of the segments are
+// removed and the exception is rethrown once all threads are done.
+template <typename TAccessor, typename TPathFunc, typename TCallback>
+std::vector<SnapshotSegment> WriteSegmentsInParallel(TAccessor *objects, uint64_t num_threads,
+                                                     uint64_t items_per_batch,
+                                                     Config::Durability::Compression compression,
+                                                     bool async_writes, const TPathFunc &segment_path,
+                                                     const TCallback &encode) {
+  auto chunks = objects->chunks(std::max<uint64_t>(num_threads, 1));
+  std::vector<SnapshotSegment> segments(chunks.size());
+  for (size_t i = 0; i < segments.size(); ++i) {
+    segments[i].path = segment_path(i);
+  }
+  std::vector<std::exception_ptr> errors(chunks.size());
+  auto write_segment = [&](size_t index) {
+    utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+    try {
+      auto &segment = segments[index];
+      // The segment doesn't have a header, so a leftover of a failed snapshot
+      // creation is removed to make the segment start at position 0.
+      std::filesystem::remove(segment.path);
+      Encoder encoder;
+      if (async_writes) encoder.EnableAsyncWrites();
+      encoder.OpenExisting(segment.path, compression);
+      // Getting the position of uncompressed data flushes the buffer of the
+      // encoder, so it is only done when a new batch has to be started.
+      std::optional<uint64_t> next_batch_offset;
+      for (auto &object : chunks[index]) {
+        if (!next_batch_offset && (segment.batches.empty() || segment.batches.back().count == items_per_batch)) {
+          next_batch_offset = encoder.GetPosition();
+        }
+        if (!encode(&encoder, object, &segment.used_ids)) continue;
+        if (next_batch_offset) {
+          segment.batches.push_back({*next_batch_offset, 0});
+          next_batch_offset.reset();
+        }
+        ++segment.batches.back().count;
+        ++segment.count;
+      }
+      segment.size = encoder.GetPosition();
+      encoder.Close();
+    } catch (...) {
+      errors[index] = std::current_exception();
+    }
+  };
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(chunks.size() - 1);
+    for (size_t i = 1; i < chunks.size(); ++i) {
+      threads.emplace_back(write_segment, i);
+    }
+    write_segment(0);
+  }
+  for (const auto &error : errors) {
+    if (!error) continue;
+    RemoveSegments(segments);
+    std::rethrow_exception(error);
+  }
+  return segments;
+}
+
+// Objects of an incremental snapshot, split into chunks like the objects of a
+// `utils::SkipList` so that they can be written with `WriteSegmentsInParallel`.
+template <typename TObject>
+class ChangedObjects {
+ public:
+  explicit ChangedObjects(std::vector<TObject *> objects) : objects_(std::move(objects)) {}
+
+  // Splits the objects into at most `num_chunks` chunks of consecutive
+  // objects. There is always at least one chunk.
+  std::vector<std::vector<std::reference_wrapper<TObject>>> chunks(uint64_t num_chunks) const {
+    num_chunks = std::clamp<uint64_t>(num_chunks, 1, std::max<uint64_t>(objects_.size(), 1));
+    std::vector<std::vector<std::reference_wrapper<TObject>>> chunks(num_chunks);
+    for (size_t i = 0; i < objects_.size(); ++i) {
+      chunks[i * num_chunks / objects_.size()].emplace_back(*objects_[i]);
+    }
+    return chunks;
+  }
+
+ private:
+  std::vector<TObject *> objects_;
+};
+
+// Finds the objects with the given GIDs. The GIDs of the objects which don't
+// exist anymore are added to `deleted`.
+template <typename TAccessor>
+auto FindChangedObjects(TAccessor *objects, const std::vector<Gid> &gids, std::vector<uint64_t> *deleted) {
+  using TObject = std::remove_reference_t<decltype(*objects->begin())>;
+  std::vector<TObject *> found;
+  found.reserve(gids.size());
+  for (const auto gid : gids) {
+    auto it = objects->find(gid);
+    if (it == objects->end()) {
+      deleted->push_back(gid.AsUint());
+    } else {
+      found.push_back(&*it);
+    }
+  }
+  return ChangedObjects<TObject>(std::move(found));
+}
+
+// Appends the segments to the snapshot and removes their files. The batches
+// of the segments are added to `batches` with their offsets in the snapshot.
+// Returns the number of objects in the segments.
+uint64_t AppendSegments(Encoder *snapshot, const std::vector<SnapshotSegment> &segments,
+                        std::vector<BatchInfo> *batches, std::unordered_set<uint64_t> *used_ids) {
+  uint64_t count = 0;
+  for (const auto &segment : segments) {
+    const auto segment_offset = snapshot->GetPosition();
+    snapshot->Append(segment.path, segment.size);
+    std::error_code error_code;  // For exception suppression.
+    std::filesystem::remove(segment.path, error_code);
+
+    for (const auto &batch : segment.batches) {
+      batches->push_back({segment_offset + batch.offset, batch.count});
+    }
+    count += segment.count;
+    used_ids->insert(segment.used_ids.begin(), segment.used_ids.end());
+  }
+  return count;
+}
+
+}  // namespace
+
 void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snapshot_directory,
-                    const std::filesystem::path &wal_directory, uint64_t snapshot_retention_count,
-                    utils::SkipList<Vertex> *vertices, utils::SkipList<Edge> *edges, NameIdMapper *name_id_mapper,
-                    Indices *indices, Constraints *constraints, Config::Items items, const std::string &uuid,
-                    const std::string_view epoch_id, const std::deque<std::pair<std::string, uint64_t>> &epoch_history,
-                    utils::FileRetainer *file_retainer) {
+                    const std::filesystem::path &wal_directory, utils::SkipList<Vertex> *vertices,
+                    utils::SkipList<Edge> *edges, NameIdMapper *name_id_mapper, Indices *indices,
+                    Constraints *constraints, const GraphStatistics &statistics, const Config &config,
+                    const std::string &uuid, const std::string_view epoch_id,
+                    const std::deque<std::pair<std::string, uint64_t>> &epoch_history,
+                    const std::optional<SnapshotChanges> &changes, utils::FileRetainer *file_retainer,
+                    const std::function<void()> &finish_transaction) {
+  const auto items = config.items;
+  const auto snapshot_retention_count = config.durability.snapshot_retention_count;
+  const auto items_per_batch = config.durability.items_per_batch;
+  const auto num_threads = config.durability.snapshot_thread_count;
+  const auto compression = config.durability.compression;
+  const auto async_writes = config.durability.async_writes;
+
   // Ensure that the storage directory exists.
   utils::EnsureDirOrDie(snapshot_directory);
 
   // Create snapshot file.
-  auto path = snapshot_directory / MakeSnapshotName(transaction->start_timestamp);
-  spdlog::info("Starting snapshot creation to {}", path);
+  const auto start_timestamp = transaction->start_timestamp;
+  auto path = snapshot_directory / MakeSnapshotName(start_timestamp);
+  if (changes) {
+    spdlog::info("Starting incremental snapshot creation to {} with {} modified vertices and {} modified edges", path,
+                 changes->vertices.size(), changes->edges.size());
+  } else {
+    spdlog::info("Starting snapshot creation to {}", path);
+  }
   Encoder snapshot;
-  snapshot.Initialize(path, kSnapshotMagic, kVersion);
+  if (async_writes) snapshot.EnableAsyncWrites();
+  snapshot.Initialize(path, kSnapshotMagic, kVersion, compression);
 
   // Write placeholder offsets.
   uint64_t offset_offsets = 0;
@@ -661,134 +1161,199 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
     snapshot.WriteUint(offset_metadata);
   }
 
-  // Object counters.
-  uint64_t edges_count = 0;
-  uint64_t vertices_count = 0;
+  // Everything after the offsets is compressed.
+  snapshot.StartCompression();
 
   // Mapper data.
   std::unordered_set<uint64_t> used_ids;
-  auto write_mapping = [&snapshot, &used_ids](auto mapping) {
-    used_ids.insert(mapping.AsUint());
-    snapshot.WriteUint(mapping.AsUint());
+  auto write_mapping = [&snapshot, &used_ids](auto mapping) { WriteMapping(&snapshot, &used_ids, mapping); };
+
+  // The edges and the vertices are written by multiple threads into separate
+  // segment files next to the snapshot. The segments are appended to the
+  // snapshot once all of them are written. The transaction isn't used after
+  // that, so it is finished before the segments are merged.
+  auto segment_path = [&path](std::string_view objects, size_t index) {
+    auto segment = path;
+    segment += fmt::format(".{}_segment_{}", objects, index);
+    return segment;
+  };
+  std::vector<SnapshotSegment> edge_segments;
+  std::vector<SnapshotSegment> vertex_segments;
+  utils::OnScopeExit remove_segments([&edge_segments, &vertex_segments] {
+    RemoveSegments(edge_segments);
+    RemoveSegments(vertex_segments);
+  });
+  utils::Timer timer;
+
+  // Writes either all of the objects or, for an incremental snapshot, only the
+  // modified ones. The GIDs of the modified objects which aren't visible to
+  // the snapshot transaction are added to `deleted`.
+  std::mutex deleted_lock;
+  auto write_objects = [&](auto *objects, const std::vector<Gid> *changed, std::vector<uint64_t> *deleted,
+                           std::string_view name, const auto &encode) {
+    auto acc = objects->access();
+    auto path_of_segment = [&](size_t index) { return segment_path(name, index); };
+    if (!changes) {
+      return WriteSegmentsInParallel(&acc, num_threads, items_per_batch, compression, async_writes, path_of_segment,
+                                     encode);
+    }
+    auto changed_objects = FindChangedObjects(&acc, *changed, deleted);
+    auto segments = WriteSegmentsInParallel(
+        &changed_objects, num_threads, items_per_batch, compression, async_writes, path_of_segment,
+        [&](Encoder *encoder, auto &object, std::unordered_set<uint64_t> *segment_used_ids) {
+          if (encode(encoder, object.get(), segment_used_ids)) return true;
+          std::lock_guard guard(deleted_lock);
+          deleted->push_back(object.get().gid.AsUint());
+          return false;
+        });
+    std::sort(deleted->begin(), deleted->end());
+    return segments;
   };
+  std::vector<uint64_t> deleted_edges;
+  std::vector<uint64_t> deleted_vertices;
 
-  // Store all edges.
+  // Write all edges.
   if (items.properties_on_edges) {
-    offset_edges = snapshot.GetPosition();
-    auto acc = edges->access();
-    for (auto &edge : acc) {
-      // The edge visibility check must be done here manually because we don't
-      // allow direct access to the edges through the public API.
-      bool is_visible = true;
-      Delta *delta = nullptr;
-      {
-        std::lock_guard<utils::SpinLock> guard(edge.lock);
-        is_visible = !edge.deleted;
-        delta = edge.delta;
-      }
-      ApplyDeltasForRead(transaction, delta, View::OLD, [&is_visible](const Delta &delta) {
-        switch (delta.action) {
-          case Delta::Action::ADD_LABEL:
-          case Delta::Action::REMOVE_LABEL:
-          case Delta::Action::SET_PROPERTY:
-          case Delta::Action::ADD_IN_EDGE:
-          case Delta::Action::ADD_OUT_EDGE:
-          case Delta::Action::REMOVE_IN_EDGE:
-          case Delta::Action::REMOVE_OUT_EDGE:
-            break;
-          case Delta::Action::RECREATE_OBJECT: {
-            is_visible = true;
-            break;
+    edge_segments = write_objects(
+        edges, changes ? &changes->edges : nullptr, &deleted_edges, "edges",
+        [&](Encoder *encoder, Edge &edge, std::unordered_set<uint64_t> *segment_used_ids) {
+          // The edge visibility check must be done here manually because we don't
+          // allow direct access to the edges through the public API.
+          bool is_visible = true;
+          Delta *delta = nullptr;
+          {
+            std::lock_guard<utils::SpinLock> guard(edge.lock);
+            is_visible = !edge.deleted;
+            delta = edge.delta;
           }
-          case Delta::Action::DELETE_OBJECT: {
-            is_visible = false;
-            break;
+          ApplyDeltasForRead(transaction, delta, View::OLD, [&is_visible](const Delta &delta) {
+            switch (delta.action) {
+              case Delta::Action::ADD_LABEL:
+              case Delta::Action::REMOVE_LABEL:
+              case Delta::Action::SET_PROPERTY:
+              case Delta::Action::ADD_IN_EDGE:
+              case Delta::Action::ADD_OUT_EDGE:
+              case Delta::Action::REMOVE_IN_EDGE:
+              case Delta::Action::REMOVE_OUT_EDGE:
+                break;
+              case Delta::Action::RECREATE_OBJECT: {
+                is_visible = true;
+                break;
+              }
+              case Delta::Action::DELETE_OBJECT: {
+                is_visible = false;
+                break;
+              }
+            }
+          });
+          if (!is_visible) return false;
+          EdgeRef edge_ref(&edge);
+          // Here we create an edge accessor that we will use to get the
+          // properties of the edge. The accessor is created with an invalid
+          // type and invalid from/to pointers because we don't know them here,
+          // but that isn't an issue because we won't use that part of the API
+          // here.
+          auto ea = EdgeAccessor{
+              edge_ref, EdgeTypeId::FromUint(0UL), nullptr, nullptr, transaction, indices, constraints, items};
+
+          // Get edge data.
+          auto maybe_props = ea.Properties(View::OLD);
+          MG_ASSERT(maybe_props.HasValue(), "Invalid database state!");
+
+          // Store the edge.
+          encoder->WriteMarker(Marker::SECTION_EDGE);
+          encoder->WriteUint(edge.gid.AsUint());
+          const auto &props = maybe_props.GetValue();
+          encoder->WriteUint(props.size());
+          for (const auto &item : props) {
+            WriteMapping(encoder, segment_used_ids, item.first);
+            encoder->WritePropertyValue(item.second);
           }
-        }
-      });
-      if (!is_visible) continue;
-      EdgeRef edge_ref(&edge);
-      // Here we create an edge accessor that we will use to get the
-      // properties of the edge. The accessor is created with an invalid
-      // type and invalid from/to pointers because we don't know them here,
-      // but that isn't an issue because we won't use that part of the API
-      // here.
-      auto ea =
-          EdgeAccessor{edge_ref, EdgeTypeId::FromUint(0UL), nullptr, nullptr, transaction, indices, constraints, items};
-
-      // Get edge data.
-      auto maybe_props = ea.Properties(View::OLD);
-      MG_ASSERT(maybe_props.HasValue(), "Invalid database state!");
-
-      // Store the edge.
-      {
-        snapshot.WriteMarker(Marker::SECTION_EDGE);
-        snapshot.WriteUint(edge.gid.AsUint());
-        const auto &props = maybe_props.GetValue();
-        snapshot.WriteUint(props.size());
-        for (const auto &item : props) {
-          write_mapping(item.first);
-          snapshot.WritePropertyValue(item.second);
-        }
-      }
-
-      ++edges_count;
-    }
+          return true;
+        });
   }
 
-  // Store all vertices.
+  // Write all vertices.
   {
-    offset_vertices = snapshot.GetPosition();
-    auto acc = vertices->access();
-    for (auto &vertex : acc) {
-      // The visibility check is implemented for vertices so we use it here.
-      auto va = VertexAccessor::Create(&vertex, transaction, indices, constraints, items, View::OLD);
-      if (!va) continue;
-
-      // Get vertex data.
-      // TODO (mferencevic): All of these functions could be written into a
-      // single function so that we traverse the undo deltas only once.
-      auto maybe_labels = va->Labels(View::OLD);
-      MG_ASSERT(maybe_labels.HasValue(), "Invalid database state!");
-      auto maybe_props = va->Properties(View::OLD);
-      MG_ASSERT(maybe_props.HasValue(), "Invalid database state!");
-      auto maybe_in_edges = va->InEdges(View::OLD);
-      MG_ASSERT(maybe_in_edges.HasValue(), "Invalid database state!");
-      auto maybe_out_edges = va->OutEdges(View::OLD);
-      MG_ASSERT(maybe_out_edges.HasValue(), "Invalid database state!");
-
-      // Store the vertex.
-      {
-        snapshot.WriteMarker(Marker::SECTION_VERTEX);
-        snapshot.WriteUint(vertex.gid.AsUint());
-        const auto &labels = maybe_labels.GetValue();
-        snapshot.WriteUint(labels.size());
-        for (const auto &item : labels) {
-          write_mapping(item);
-        }
-        const auto &props = maybe_props.GetValue();
-        snapshot.WriteUint(props.size());
-        for (const auto &item : props) {
-          write_mapping(item.first);
-          snapshot.WritePropertyValue(item.second);
-        }
-        const auto &in_edges = maybe_in_edges.GetValue();
-        snapshot.WriteUint(in_edges.size());
-        for (const auto &item : in_edges) {
-          snapshot.WriteUint(item.Gid().AsUint());
-          snapshot.WriteUint(item.FromVertex().Gid().AsUint());
-          write_mapping(item.EdgeType());
-        }
-        const auto &out_edges = maybe_out_edges.GetValue();
-        snapshot.WriteUint(out_edges.size());
-        for (const auto &item : out_edges) {
-          snapshot.WriteUint(item.Gid().AsUint());
-          snapshot.WriteUint(item.ToVertex().Gid().AsUint());
-          write_mapping(item.EdgeType());
-        }
-      }
+    vertex_segments = write_objects(
+        vertices, changes ? &changes->vertices : nullptr, &deleted_vertices, "vertices",
+        [&](Encoder *encoder, Vertex &vertex, std::unordered_set<uint64_t> *segment_used_ids) {
+          // The visibility check is implemented for vertices so we use it here.
+          auto va = VertexAccessor::Create(&vertex, transaction, indices, constraints, items, View::OLD);
+          if (!va) return false;
+
+          // Get vertex data.
+          // TODO (mferencevic): All of these functions could be written into a
+          // single function so that we traverse the undo deltas only once.
+          auto maybe_labels = va->Labels(View::OLD);
+          MG_ASSERT(maybe_labels.HasValue(), "Invalid database state!");
+          auto maybe_props = va->Properties(View::OLD);
+          MG_ASSERT(maybe_props.HasValue(), "Invalid database state!");
+          auto maybe_in_edges = va->InEdges(View::OLD);
+          MG_ASSERT(maybe_in_edges.HasValue(), "Invalid database state!");
+          auto maybe_out_edges = va->OutEdges(View::OLD);
+          MG_ASSERT(maybe_out_edges.HasValue(), "Invalid database state!");
+
+          // Store the vertex.
+          encoder->WriteMarker(Marker::SECTION_VERTEX);
+          encoder->WriteUint(vertex.gid.AsUint());
+          const auto &labels = maybe_labels.GetValue();
+          encoder->WriteUint(labels.size());
+          for (const auto &item : labels) {
+            WriteMapping(encoder, segment_used_ids, item);
+          }
+          const auto &props = maybe_props.GetValue();
+          encoder->WriteUint(props.size());
+          for (const auto &item : props) {
+            WriteMapping(encoder, segment_used_ids, item.first);
+            encoder->WritePropertyValue(item.second);
+          }
+          const auto &in_edges = maybe_in_edges.GetValue();
+          encoder->WriteUint(in_edges.size());
+          for (const auto &item : in_edges) {
+            encoder->WriteUint(item.Gid().AsUint());
+            encoder->WriteUint(item.FromVertex().Gid().AsUint());
+            WriteMapping(encoder, segment_used_ids, item.EdgeType());
+          }
+          const auto &out_edges = maybe_out_edges.GetValue();
+          encoder->WriteUint(out_edges.size());
+          for (const auto &item : out_edges) {
+            encoder->WriteUint(item.Gid().AsUint());
+            encoder->WriteUint(item.ToVertex().Gid().AsUint());
+            WriteMapping(encoder, segment_used_ids, item.EdgeType());
+          }
+          return true;
+        });
+  }
+  spdlog::info("Snapshot objects written to {} segments in {:.3f} seconds.",
+               edge_segments.size() + vertex_segments.size(), timer.Elapsed().count());
 
-      ++vertices_count;
+  // All of the data that depends on the transaction is written, the rest of
+  // the snapshot is independent of it.
+  finish_transaction();
+
+  // Merge the segments into the snapshot.
+  uint64_t edges_count = 0;
+  uint64_t vertices_count = 0;
+  std::vector<BatchInfo> edge_batches;
+  std::vector<BatchInfo> vertex_batches;
+  if (items.properties_on_edges) {
+    offset_edges = snapshot.GetPosition();
+    edges_count = AppendSegments(&snapshot, edge_segments, &edge_batches, &used_ids);
+  }
+  offset_vertices = snapshot.GetPosition();
+  vertices_count = AppendSegments(&snapshot, vertex_segments, &vertex_batches, &used_ids);
+
+  // Write deleted objects.
+  uint64_t offset_deleted = 0;
+  if (changes) {
+    offset_deleted = snapshot.GetPosition();
+    snapshot.WriteMarker(Marker::SECTION_DELETED);
+    for (const auto *deleted : {&deleted_edges, &deleted_vertices}) {
+      snapshot.WriteUint(deleted->size());
+      for (const auto gid : *deleted) {
+        snapshot.WriteUint(gid);
+      }
     }
   }
 
@@ -815,6 +1380,41 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
         write_mapping(item.second);
       }
     }
+
+    // Write edge type indices.
+    {
+      auto edge_type = indices->edge_type_index.ListIndices();
+      snapshot.WriteUint(edge_type.size());
+      for (const auto &item : edge_type) {
+        write_mapping(item);
+      }
+    }
+
+    // Write edge type+property indices.
+    {
+      auto edge_type_property = indices->edge_type_property_index.ListIndices();
+      snapshot.WriteUint(edge_type_property.size());
+      for (const auto &item : edge_type_property) {
+        write_mapping(item.first);
+        write_mapping(item.second);
+      }
+    }
+
+    // Write label+properties composite indices.
+    {
+      auto label_property_composite = indices->label_property_composite_index.ListIndices();
+      snapshot.WriteUint(label_property_composite.size());
+      for (const auto &[label, properties] : label_property_composite) {
+        write_mapping(label);
+        snapshot.WriteUint(properties.size());
+        for (const auto &property : properties) {
+          write_mapping(property);
+        }
+      }
+    }
+
+    // Write graph statistics.
+    EncodeGraphStatistics(&snapshot, ToNamedGraphStatistics(statistics, name_id_mapper));
   }
 
   // Write constraints.
@@ -874,9 +1474,19 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
     snapshot.WriteMarker(Marker::SECTION_METADATA);
     snapshot.WriteString(uuid);
     snapshot.WriteString(epoch_id);
-    snapshot.WriteUint(transaction->start_timestamp);
+    snapshot.WriteUint(start_timestamp);
     snapshot.WriteUint(edges_count);
     snapshot.WriteUint(vertices_count);
+    for (const auto *batches : {&edge_batches, &vertex_batches}) {
+      snapshot.WriteUint(batches->size());
+      for (const auto &batch : *batches) {
+        snapshot.WriteUint(batch.offset);
+        snapshot.WriteUint(batch.count);
+      }
+    }
+    snapshot.WriteBool(changes.has_value());
+    snapshot.WriteUint(changes ? changes->base_timestamp : 0);
+    snapshot.WriteUint(offset_deleted);
   }
 
   // Write true offsets.
@@ -895,9 +1505,12 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
   snapshot.Finalize();
   spdlog::info("Snapshot creation successful!");
 
-  // Ensure exactly `snapshot_retention_count` snapshots exist.
+  // Ensure exactly `snapshot_retention_count` snapshots exist. The snapshots
+  // on which the retained incremental snapshots are based are kept as well
+  // because the incremental snapshots can't be recovered without them.
   std::vector<std::pair<uint64_t, std::filesystem::path>> old_snapshot_files;
   {
+    std::vector<std::tuple<uint64_t, std::filesystem::path, std::optional<uint64_t>>> snapshot_files;
     std::error_code error_code;
     for (const auto &item : std::filesystem::directory_iterator(snapshot_directory, error_code)) {
       if (!item.is_regular_file()) continue;
@@ -905,7 +1518,9 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
       try {
         auto info = ReadSnapshotInfo(item.path());
         if (info.uuid != uuid) continue;
-        old_snapshot_files.emplace_back(info.start_timestamp, item.path());
+        std::optional<uint64_t> base_timestamp;
+        if (info.incremental) base_timestamp = info.base_timestamp;
+        snapshot_files.emplace_back(info.start_timestamp, item.path(), base_timestamp);
       } catch (const RecoveryFailure &e) {
         spdlog::warn("Found a corrupt snapshot file {} becuase of: {}", item.path(), e.what());
         continue;
@@ -917,19 +1532,24 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
           utils::MessageWithLink("Couldn't ensure that exactly {} snapshots exist because an error occurred: {}.",
                                  snapshot_retention_count, error_code.message(), "https://memgr.ph/snapshots"));
     }
-    std::sort(old_snapshot_files.begin(), old_snapshot_files.end());
-    if (old_snapshot_files.size() > snapshot_retention_count - 1) {
-      auto num_to_erase = old_snapshot_files.size() - (snapshot_retention_count - 1);
-      for (size_t i = 0; i < num_to_erase; ++i) {
-        const auto &[start_timestamp, snapshot_path] = old_snapshot_files[i];
+    std::sort(snapshot_files.begin(), snapshot_files.end());
+    std::set<uint64_t> required_bases;
+    if (changes) required_bases.insert(changes->base_timestamp);
+    for (auto i = snapshot_files.size(); i > 0; --i) {
+      const auto &[start_timestamp, snapshot_path, base_timestamp] = snapshot_files[i - 1];
+      const auto newer_count = snapshot_files.size() - i;
+      if (newer_count >= snapshot_retention_count - 1 && !required_bases.contains(start_timestamp)) {
         file_retainer->DeleteFile(snapshot_path);
+        continue;
       }
-      old_snapshot_files.erase(old_snapshot_files.begin(), old_snapshot_files.begin() + num_to_erase);
+      if (base_timestamp) required_bases.insert(*base_timestamp);
+      old_snapshot_files.emplace_back(start_timestamp, snapshot_path);
     }
+    std::reverse(old_snapshot_files.begin(), old_snapshot_files.end());
   }
 
   // Ensure that only the absolutely necessary WAL files exist.
-  if (old_snapshot_files.size() == snapshot_retention_count - 1 && utils::DirExists(wal_directory)) {
+  if (old_snapshot_files.size() >= snapshot_retention_count - 1 && utils::DirExists(wal_directory)) {
     std::vector<std::tuple<uint64_t, uint64_t, uint64_t, std::filesystem::path>> wal_files;
     std::error_code error_code;
     for (const auto &item : std::filesystem::directory_iterator(wal_directory, error_code)) {
@@ -950,7 +1570,7 @@ void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snaps
                                  error_code.message(), "https://memgr.ph/snapshots"));
     }
     std::sort(wal_files.begin(), wal_files.end());
-    uint64_t snapshot_start_timestamp = transaction->start_timestamp;
+    uint64_t snapshot_start_timestamp = start_timestamp;
     if (!old_snapshot_files.empty()) {
       snapshot_start_timestamp = old_snapshot_files.front().first;
     }
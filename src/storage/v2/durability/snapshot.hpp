@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -13,7 +13,10 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "storage/v2/config.hpp"
 #include "storage/v2/constraints.hpp"
@@ -21,6 +24,7 @@
 #include "storage/v2/edge.hpp"
 #include "storage/v2/indices.hpp"
 #include "storage/v2/name_id_mapper.hpp"
+#include "storage/v2/statistics.hpp"
 #include "storage/v2/transaction.hpp"
 #include "storage/v2/vertex.hpp"
 #include "utils/file_locker.hpp"
@@ -28,6 +32,13 @@
 
 namespace memgraph::storage::durability {
 
+/// Structure used to hold the position of a batch of vertices or edges in a
+/// snapshot. Each batch can be decoded independently of the other batches.
+struct BatchInfo {
+  uint64_t offset;
+  uint64_t count;
+};
+
 /// Structure used to hold information about a snapshot.
 struct SnapshotInfo {
   uint64_t offset_edges;
@@ -43,6 +54,28 @@ struct SnapshotInfo {
   uint64_t start_timestamp;
   uint64_t edges_count;
   uint64_t vertices_count;
+
+  // Snapshots created before the batches were introduced are described with
+  // a single batch of edges and a single batch of vertices.
+  std::vector<BatchInfo> edge_batches;
+  std::vector<BatchInfo> vertex_batches;
+
+  // An incremental snapshot holds only the objects which were modified since
+  // the snapshot with the start timestamp `base_timestamp`, and the objects
+  // which were deleted since then in the section at `offset_deleted`.
+  bool incremental{false};
+  uint64_t base_timestamp{0};
+  uint64_t offset_deleted{0};
+};
+
+/// Objects which were modified since the previous snapshot. They are used to
+/// create an incremental snapshot on top of the previous snapshot.
+struct SnapshotChanges {
+  /// Start timestamp of the previous snapshot.
+  uint64_t base_timestamp{0};
+  /// GIDs of the modified vertices and edges, sorted ascending.
+  std::vector<Gid> vertices;
+  std::vector<Gid> edges;
 };
 
 /// Structure used to hold information about the snapshot that has been
@@ -57,19 +90,29 @@ struct RecoveredSnapshot {
 /// @throw RecoveryFailure
 SnapshotInfo ReadSnapshotInfo(const std::filesystem::path &path);
 
-/// Function used to load the snapshot data into the storage.
+/// Function used to load the snapshot data into the storage. The batches of
+/// edges and vertices are recovered using `recovery_thread_count` threads
+/// from the durability config. An incremental snapshot is applied on top of
+/// the data which was loaded from the snapshots it is based on.
 /// @throw RecoveryFailure
 RecoveredSnapshot LoadSnapshot(const std::filesystem::path &path, utils::SkipList<Vertex> *vertices,
                                utils::SkipList<Edge> *edges,
                                std::deque<std::pair<std::string, uint64_t>> *epoch_history,
-                               NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count, Config::Items items);
+                               NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count, const Config &config);
 
-/// Function used to create a snapshot using the given transaction.
+/// Function used to create a snapshot using the given transaction. The edges
+/// and vertices are written using `snapshot_thread_count` threads from the
+/// durability config. `finish_transaction` is called as soon as the
+/// transaction isn't needed anymore, i.e. before the rest of the snapshot is
+/// written. If `changes` are given, only the modified objects are written to
+/// an incremental snapshot.
 void CreateSnapshot(Transaction *transaction, const std::filesystem::path &snapshot_directory,
-                    const std::filesystem::path &wal_directory, uint64_t snapshot_retention_count,
-                    utils::SkipList<Vertex> *vertices, utils::SkipList<Edge> *edges, NameIdMapper *name_id_mapper,
-                    Indices *indices, Constraints *constraints, Config::Items items, const std::string &uuid,
-                    std::string_view epoch_id, const std::deque<std::pair<std::string, uint64_t>> &epoch_history,
-                    utils::FileRetainer *file_retainer);
+                    const std::filesystem::path &wal_directory, utils::SkipList<Vertex> *vertices,
+                    utils::SkipList<Edge> *edges, NameIdMapper *name_id_mapper, Indices *indices,
+                    Constraints *constraints, const GraphStatistics &statistics, const Config &config,
+                    const std::string &uuid, std::string_view epoch_id,
+                    const std::deque<std::pair<std::string, uint64_t>> &epoch_history,
+                    const std::optional<SnapshotChanges> &changes, utils::FileRetainer *file_retainer,
+                    const std::function<void()> &finish_transaction);
 
 }  // namespace memgraph::storage::durability
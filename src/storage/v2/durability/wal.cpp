@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -28,6 +28,10 @@ namespace memgraph::storage::durability {
 //
 // 2) WAL version (non-encoded, little-endian)
 //
+// 2a) Compression (from version 19, non-encoded)
+//     * compression of the deltas
+//     * offset to the start of the compressed data
+//
 // 3) Section offsets:
 //     * offset to the metadata section
 //     * offset to the first delta in the WAL
@@ -69,6 +73,21 @@ namespace memgraph::storage::durability {
 //         * unique constraint create, unique constraint drop
 //              * label name
 //              * property names
+//         * edge type index create, edge type index drop
+//              * edge type name
+//         * edge type property index create, edge type property index drop
+//              * edge type name
+//              * property name
+//         * label property composite index create, label property composite
+//           index drop
+//              * label name
+//              * property names (in the order of the index)
+//         * graph statistics set
+//              * serialized graph statistics
+//
+// The deltas are compressed using block compression if enabled (see
+// `Encoder`). The current block is written each time the WAL is flushed, i.e.
+// after each transaction.
 //
 // IMPORTANT: When changing WAL encoding/decoding bump the snapshot/WAL version
 // in `version.hpp`.
@@ -93,6 +112,20 @@ Marker OperationToMarker(StorageGlobalOperation operation) {
       return Marker::DELTA_UNIQUE_CONSTRAINT_CREATE;
     case StorageGlobalOperation::UNIQUE_CONSTRAINT_DROP:
       return Marker::DELTA_UNIQUE_CONSTRAINT_DROP;
+    case StorageGlobalOperation::EDGE_TYPE_INDEX_CREATE:
+      return Marker::DELTA_EDGE_TYPE_INDEX_CREATE;
+    case StorageGlobalOperation::EDGE_TYPE_INDEX_DROP:
+      return Marker::DELTA_EDGE_TYPE_INDEX_DROP;
+    case StorageGlobalOperation::EDGE_TYPE_PROPERTY_INDEX_CREATE:
+      return Marker::DELTA_EDGE_TYPE_PROPERTY_INDEX_CREATE;
+    case StorageGlobalOperation::EDGE_TYPE_PROPERTY_INDEX_DROP:
+      return Marker::DELTA_EDGE_TYPE_PROPERTY_INDEX_DROP;
+    case StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+      return Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_CREATE;
+    case StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+      return Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_DROP;
+    case StorageGlobalOperation::GRAPH_STATISTICS_SET:
+      return Marker::DELTA_GRAPH_STATISTICS_SET;
   }
 }
 
@@ -161,6 +194,20 @@ WalDeltaData::Type MarkerToWalDeltaDataType(Marker marker) {
       return WalDeltaData::Type::UNIQUE_CONSTRAINT_CREATE;
     case Marker::DELTA_UNIQUE_CONSTRAINT_DROP:
       return WalDeltaData::Type::UNIQUE_CONSTRAINT_DROP;
+    case Marker::DELTA_EDGE_TYPE_INDEX_CREATE:
+      return WalDeltaData::Type::EDGE_TYPE_INDEX_CREATE;
+    case Marker::DELTA_EDGE_TYPE_INDEX_DROP:
+      return WalDeltaData::Type::EDGE_TYPE_INDEX_DROP;
+    case Marker::DELTA_EDGE_TYPE_PROPERTY_INDEX_CREATE:
+      return WalDeltaData::Type::EDGE_TYPE_PROPERTY_INDEX_CREATE;
+    case Marker::DELTA_EDGE_TYPE_PROPERTY_INDEX_DROP:
+      return WalDeltaData::Type::EDGE_TYPE_PROPERTY_INDEX_DROP;
+    case Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+      return WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE;
+    case Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+      return WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_DROP;
+    case Marker::DELTA_GRAPH_STATISTICS_SET:
+      return WalDeltaData::Type::GRAPH_STATISTICS_SET;
 
     case Marker::TYPE_NULL:
     case Marker::TYPE_BOOL:
@@ -309,6 +356,65 @@ WalDeltaData ReadSkipWalDeltaData(BaseDecoder *decoder) {
           if (!decoder->SkipString()) throw RecoveryFailure("Invalid WAL data!");
         }
       }
+      break;
+    }
+    case WalDeltaData::Type::EDGE_TYPE_INDEX_CREATE:
+    case WalDeltaData::Type::EDGE_TYPE_INDEX_DROP: {
+      if constexpr (read_data) {
+        auto edge_type = decoder->ReadString();
+        if (!edge_type) throw RecoveryFailure("Invalid WAL data!");
+        delta.operation_edge_type.edge_type = std::move(*edge_type);
+      } else {
+        if (!decoder->SkipString()) throw RecoveryFailure("Invalid WAL data!");
+      }
+      break;
+    }
+    case WalDeltaData::Type::EDGE_TYPE_PROPERTY_INDEX_CREATE:
+    case WalDeltaData::Type::EDGE_TYPE_PROPERTY_INDEX_DROP: {
+      if constexpr (read_data) {
+        auto edge_type = decoder->ReadString();
+        if (!edge_type) throw RecoveryFailure("Invalid WAL data!");
+        delta.operation_edge_type_property.edge_type = std::move(*edge_type);
+        auto property = decoder->ReadString();
+        if (!property) throw RecoveryFailure("Invalid WAL data!");
+        delta.operation_edge_type_property.property = std::move(*property);
+      } else {
+        if (!decoder->SkipString() || !decoder->SkipString()) throw RecoveryFailure("Invalid WAL data!");
+      }
+      break;
+    }
+    case WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+    case WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_DROP: {
+      if constexpr (read_data) {
+        auto label = decoder->ReadString();
+        if (!label) throw RecoveryFailure("Invalid WAL data!");
+        delta.operation_label_property_list.label = std::move(*label);
+        auto properties_count = decoder->ReadUint();
+        if (!properties_count) throw RecoveryFailure("Invalid WAL data!");
+        for (uint64_t i = 0; i < *properties_count; ++i) {
+          auto property = decoder->ReadString();
+          if (!property) throw RecoveryFailure("Invalid WAL data!");
+          delta.operation_label_property_list.properties.emplace_back(std::move(*property));
+        }
+      } else {
+        if (!decoder->SkipString()) throw RecoveryFailure("Invalid WAL data!");
+        auto properties_count = decoder->ReadUint();
+        if (!properties_count) throw RecoveryFailure("Invalid WAL data!");
+        for (uint64_t i = 0; i < *properties_count; ++i) {
+          if (!decoder->SkipString()) throw RecoveryFailure("Invalid WAL data!");
+        }
+      }
+      break;
+    }
+    case WalDeltaData::Type::GRAPH_STATISTICS_SET: {
+      if constexpr (read_data) {
+        auto statistics = DecodeGraphStatistics(decoder);
+        if (!statistics) throw RecoveryFailure("Invalid WAL data!");
+        delta.operation_graph_statistics.statistics = std::move(*statistics);
+      } else {
+        if (!DecodeGraphStatistics(decoder)) throw RecoveryFailure("Invalid WAL data!");
+      }
+      break;
     }
   }
 
@@ -456,6 +562,23 @@ bool operator==(const WalDeltaData &a, const WalDeltaData &b) {
     case WalDeltaData::Type::UNIQUE_CONSTRAINT_DROP:
       return a.operation_label_properties.label == b.operation_label_properties.label &&
              a.operation_label_properties.properties == b.operation_label_properties.properties;
+
+    case WalDeltaData::Type::EDGE_TYPE_INDEX_CREATE:
+    case WalDeltaData::Type::EDGE_TYPE_INDEX_DROP:
+      return a.operation_edge_type.edge_type == b.operation_edge_type.edge_type;
+
+    case WalDeltaData::Type::EDGE_TYPE_PROPERTY_INDEX_CREATE:
+    case WalDeltaData::Type::EDGE_TYPE_PROPERTY_INDEX_DROP:
+      return a.operation_edge_type_property.edge_type == b.operation_edge_type_property.edge_type &&
+             a.operation_edge_type_property.property == b.operation_edge_type_property.property;
+
+    case WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+    case WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+      return a.operation_label_property_list.label == b.operation_label_property_list.label &&
+             a.operation_label_property_list.properties == b.operation_label_property_list.properties;
+
+    case WalDeltaData::Type::GRAPH_STATISTICS_SET:
+      return a.operation_graph_statistics.statistics == b.operation_graph_statistics.statistics;
   }
 }
 bool operator!=(const WalDeltaData &a, const WalDeltaData &b) { return !(a == b); }
@@ -582,42 +705,76 @@ void EncodeTransactionEnd(BaseEncoder *encoder, uint64_t timestamp) {
   encoder->WriteMarker(Marker::DELTA_TRANSACTION_END);
 }
 
-void EncodeOperation(BaseEncoder *encoder, NameIdMapper *name_id_mapper, StorageGlobalOperation operation,
-                     LabelId label, const std::set<PropertyId> &properties, uint64_t timestamp) {
+namespace {
+
+// Labels and edge types are both mapped by the `NameIdMapper` so the operation
+// is encoded using the name of the label or the edge type with the ID
+// `name_id`.
+void EncodeOperationOnName(BaseEncoder *encoder, NameIdMapper *name_id_mapper, StorageGlobalOperation operation,
+                           uint64_t name_id, const std::vector<PropertyId> &properties, uint64_t timestamp) {
   encoder->WriteMarker(Marker::SECTION_DELTA);
   encoder->WriteUint(timestamp);
   switch (operation) {
     case StorageGlobalOperation::LABEL_INDEX_CREATE:
-    case StorageGlobalOperation::LABEL_INDEX_DROP: {
+    case StorageGlobalOperation::LABEL_INDEX_DROP:
+    case StorageGlobalOperation::EDGE_TYPE_INDEX_CREATE:
+    case StorageGlobalOperation::EDGE_TYPE_INDEX_DROP: {
       MG_ASSERT(properties.empty(), "Invalid function call!");
       encoder->WriteMarker(OperationToMarker(operation));
-      encoder->WriteString(name_id_mapper->IdToName(label.AsUint()));
+      encoder->WriteString(name_id_mapper->IdToName(name_id));
       break;
     }
     case StorageGlobalOperation::LABEL_PROPERTY_INDEX_CREATE:
     case StorageGlobalOperation::LABEL_PROPERTY_INDEX_DROP:
     case StorageGlobalOperation::EXISTENCE_CONSTRAINT_CREATE:
-    case StorageGlobalOperation::EXISTENCE_CONSTRAINT_DROP: {
+    case StorageGlobalOperation::EXISTENCE_CONSTRAINT_DROP:
+    case StorageGlobalOperation::EDGE_TYPE_PROPERTY_INDEX_CREATE:
+    case StorageGlobalOperation::EDGE_TYPE_PROPERTY_INDEX_DROP: {
       MG_ASSERT(properties.size() == 1, "Invalid function call!");
       encoder->WriteMarker(OperationToMarker(operation));
-      encoder->WriteString(name_id_mapper->IdToName(label.AsUint()));
+      encoder->WriteString(name_id_mapper->IdToName(name_id));
       encoder->WriteString(name_id_mapper->IdToName((*properties.begin()).AsUint()));
       break;
     }
     case StorageGlobalOperation::UNIQUE_CONSTRAINT_CREATE:
-    case StorageGlobalOperation::UNIQUE_CONSTRAINT_DROP: {
+    case StorageGlobalOperation::UNIQUE_CONSTRAINT_DROP:
+    case StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+    case StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_DROP: {
       MG_ASSERT(!properties.empty(), "Invalid function call!");
       encoder->WriteMarker(OperationToMarker(operation));
-      encoder->WriteString(name_id_mapper->IdToName(label.AsUint()));
+      encoder->WriteString(name_id_mapper->IdToName(name_id));
       encoder->WriteUint(properties.size());
       for (const auto &property : properties) {
         encoder->WriteString(name_id_mapper->IdToName(property.AsUint()));
       }
       break;
     }
+    case StorageGlobalOperation::GRAPH_STATISTICS_SET:
+      LOG_FATAL("Invalid function call!");
   }
 }
 
+}  // namespace
+
+void EncodeOperation(BaseEncoder *encoder, NameIdMapper *name_id_mapper, StorageGlobalOperation operation,
+                     LabelId label, const std::vector<PropertyId> &properties, uint64_t timestamp) {
+  EncodeOperationOnName(encoder, name_id_mapper, operation, label.AsUint(), properties, timestamp);
+}
+
+void EncodeOperation(BaseEncoder *encoder, NameIdMapper *name_id_mapper, StorageGlobalOperation operation,
+                     EdgeTypeId edge_type, const std::vector<PropertyId> &properties, uint64_t timestamp) {
+  EncodeOperationOnName(encoder, name_id_mapper, operation, edge_type.AsUint(), properties, timestamp);
+}
+
+void EncodeOperation(BaseEncoder *encoder, StorageGlobalOperation operation, const NamedGraphStatistics &statistics,
+                     uint64_t timestamp) {
+  MG_ASSERT(operation == StorageGlobalOperation::GRAPH_STATISTICS_SET, "Invalid function call!");
+  encoder->WriteMarker(Marker::SECTION_DELTA);
+  encoder->WriteUint(timestamp);
+  encoder->WriteMarker(OperationToMarker(operation));
+  EncodeGraphStatistics(encoder, statistics);
+}
+
 RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConstraints *indices_constraints,
                      const std::optional<uint64_t> last_loaded_timestamp, utils::SkipList<Vertex> *vertices,
                      utils::SkipList<Edge> *edges, NameIdMapper *name_id_mapper, std::atomic<uint64_t> *edge_count,
@@ -717,18 +874,12 @@ RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConst
             if (!inserted) throw RecoveryFailure("The edge must be inserted here!");
             edge_ref = EdgeRef(&*edge);
           }
-          {
-            std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, &*to_vertex, edge_ref};
-            auto it = std::find(from_vertex->out_edges.begin(), from_vertex->out_edges.end(), link);
-            if (it != from_vertex->out_edges.end()) throw RecoveryFailure("The from vertex already has this edge!");
-            from_vertex->out_edges.push_back(link);
-          }
-          {
-            std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, &*from_vertex, edge_ref};
-            auto it = std::find(to_vertex->in_edges.begin(), to_vertex->in_edges.end(), link);
-            if (it != to_vertex->in_edges.end()) throw RecoveryFailure("The to vertex already has this edge!");
-            to_vertex->in_edges.push_back(link);
-          }
+          if (from_vertex->out_edges.Contains(edge_type_id, &*to_vertex, edge_ref))
+            throw RecoveryFailure("The from vertex already has this edge!");
+          from_vertex->out_edges.Add(edge_type_id, &*to_vertex, edge_ref);
+          if (to_vertex->in_edges.Contains(edge_type_id, &*from_vertex, edge_ref))
+            throw RecoveryFailure("The to vertex already has this edge!");
+          to_vertex->in_edges.Add(edge_type_id, &*from_vertex, edge_ref);
 
           ret.next_edge_id = std::max(ret.next_edge_id, edge_gid.AsUint() + 1);
 
@@ -751,20 +902,10 @@ RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConst
             if (edge == edge_acc.end()) throw RecoveryFailure("The edge doesn't exist!");
             edge_ref = EdgeRef(&*edge);
           }
-          {
-            std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, &*to_vertex, edge_ref};
-            auto it = std::find(from_vertex->out_edges.begin(), from_vertex->out_edges.end(), link);
-            if (it == from_vertex->out_edges.end()) throw RecoveryFailure("The from vertex doesn't have this edge!");
-            std::swap(*it, from_vertex->out_edges.back());
-            from_vertex->out_edges.pop_back();
-          }
-          {
-            std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{edge_type_id, &*from_vertex, edge_ref};
-            auto it = std::find(to_vertex->in_edges.begin(), to_vertex->in_edges.end(), link);
-            if (it == to_vertex->in_edges.end()) throw RecoveryFailure("The to vertex doesn't have this edge!");
-            std::swap(*it, to_vertex->in_edges.back());
-            to_vertex->in_edges.pop_back();
-          }
+          if (!from_vertex->out_edges.Remove(edge_type_id, &*to_vertex, edge_ref))
+            throw RecoveryFailure("The from vertex doesn't have this edge!");
+          if (!to_vertex->in_edges.Remove(edge_type_id, &*from_vertex, edge_ref))
+            throw RecoveryFailure("The to vertex doesn't have this edge!");
           if (items.properties_on_edges) {
             if (!edge_acc.remove(edge_gid)) throw RecoveryFailure("The edge must be removed here!");
           }
@@ -847,6 +988,62 @@ RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConst
                                          "The unique constraint doesn't exist!");
           break;
         }
+        case WalDeltaData::Type::EDGE_TYPE_INDEX_CREATE: {
+          auto edge_type_id = EdgeTypeId::FromUint(name_id_mapper->NameToId(delta.operation_edge_type.edge_type));
+          AddRecoveredIndexConstraint(&indices_constraints->indices.edge_type, edge_type_id,
+                                      "The edge type index already exists!");
+          break;
+        }
+        case WalDeltaData::Type::EDGE_TYPE_INDEX_DROP: {
+          auto edge_type_id = EdgeTypeId::FromUint(name_id_mapper->NameToId(delta.operation_edge_type.edge_type));
+          RemoveRecoveredIndexConstraint(&indices_constraints->indices.edge_type, edge_type_id,
+                                         "The edge type index doesn't exist!");
+          break;
+        }
+        case WalDeltaData::Type::EDGE_TYPE_PROPERTY_INDEX_CREATE: {
+          auto edge_type_id =
+              EdgeTypeId::FromUint(name_id_mapper->NameToId(delta.operation_edge_type_property.edge_type));
+          auto property_id =
+              PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_edge_type_property.property));
+          AddRecoveredIndexConstraint(&indices_constraints->indices.edge_type_property, {edge_type_id, property_id},
+                                      "The edge type property index already exists!");
+          break;
+        }
+        case WalDeltaData::Type::EDGE_TYPE_PROPERTY_INDEX_DROP: {
+          auto edge_type_id =
+              EdgeTypeId::FromUint(name_id_mapper->NameToId(delta.operation_edge_type_property.edge_type));
+          auto property_id =
+              PropertyId::FromUint(name_id_mapper->NameToId(delta.operation_edge_type_property.property));
+          RemoveRecoveredIndexConstraint(&indices_constraints->indices.edge_type_property,
+                                         {edge_type_id, property_id}, "The edge type property index doesn't exist!");
+          break;
+        }
+        case WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE: {
+          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property_list.label));
+          std::vector<PropertyId> property_ids;
+          for (const auto &prop : delta.operation_label_property_list.properties) {
+            property_ids.push_back(PropertyId::FromUint(name_id_mapper->NameToId(prop)));
+          }
+          AddRecoveredIndexConstraint(&indices_constraints->indices.label_property_composite,
+                                      {label_id, std::move(property_ids)},
+                                      "The label property composite index already exists!");
+          break;
+        }
+        case WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_DROP: {
+          auto label_id = LabelId::FromUint(name_id_mapper->NameToId(delta.operation_label_property_list.label));
+          std::vector<PropertyId> property_ids;
+          for (const auto &prop : delta.operation_label_property_list.properties) {
+            property_ids.push_back(PropertyId::FromUint(name_id_mapper->NameToId(prop)));
+          }
+          RemoveRecoveredIndexConstraint(&indices_constraints->indices.label_property_composite,
+                                         {label_id, std::move(property_ids)},
+                                         "The label property composite index doesn't exist!");
+          break;
+        }
+        case WalDeltaData::Type::GRAPH_STATISTICS_SET: {
+          indices_constraints->statistics = std::move(delta.operation_graph_statistics.statistics);
+          break;
+        }
       }
       ret.next_timestamp = std::max(ret.next_timestamp, timestamp + 1);
       ++deltas_applied;
@@ -864,7 +1061,8 @@ RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConst
 
 WalFile::WalFile(const std::filesystem::path &wal_directory, const std::string_view uuid,
                  const std::string_view epoch_id, Config::Items items, NameIdMapper *name_id_mapper, uint64_t seq_num,
-                 utils::FileRetainer *file_retainer)
+                 utils::FileRetainer *file_retainer, Config::Durability::Compression compression,
+                 bool async_writes)
     : items_(items),
       name_id_mapper_(name_id_mapper),
       path_(wal_directory / MakeWalName()),
@@ -877,7 +1075,8 @@ WalFile::WalFile(const std::filesystem::path &wal_directory, const std::string_v
   utils::EnsureDirOrDie(wal_directory);
 
   // Initialize the WAL file.
-  wal_.Initialize(path_, kWalMagic, kVersion);
+  if (async_writes) wal_.EnableAsyncWrites();
+  wal_.Initialize(path_, kWalMagic, kVersion, compression);
 
   // Write placeholder offsets.
   uint64_t offset_offsets = 0;
@@ -902,6 +1101,9 @@ WalFile::WalFile(const std::filesystem::path &wal_directory, const std::string_v
   wal_.WriteUint(offset_deltas);
   wal_.SetPosition(offset_deltas);
 
+  // Only the deltas are compressed.
+  wal_.StartCompression();
+
   // Sync the initial data.
   wal_.Sync();
 }
@@ -961,14 +1163,28 @@ void WalFile::AppendTransactionEnd(uint64_t timestamp) {
   UpdateStats(timestamp);
 }
 
-void WalFile::AppendOperation(StorageGlobalOperation operation, LabelId label, const std::set<PropertyId> &properties,
-                              uint64_t timestamp) {
+void WalFile::AppendOperation(StorageGlobalOperation operation, LabelId label,
+                              const std::vector<PropertyId> &properties, uint64_t timestamp) {
   EncodeOperation(&wal_, name_id_mapper_, operation, label, properties, timestamp);
   UpdateStats(timestamp);
 }
 
+void WalFile::AppendOperation(StorageGlobalOperation operation, EdgeTypeId edge_type,
+                              const std::vector<PropertyId> &properties, uint64_t timestamp) {
+  EncodeOperation(&wal_, name_id_mapper_, operation, edge_type, properties, timestamp);
+  UpdateStats(timestamp);
+}
+
+void WalFile::AppendOperation(StorageGlobalOperation operation, const NamedGraphStatistics &statistics,
+                              uint64_t timestamp) {
+  EncodeOperation(&wal_, operation, statistics, timestamp);
+  UpdateStats(timestamp);
+}
+
 void WalFile::Sync() { wal_.Sync(); }
 
+utils::FileSyncHandle WalFile::FlushForSync() { return wal_.FlushForSync(); }
+
 uint64_t WalFile::GetSize() { return wal_.GetSize(); }
 
 uint64_t WalFile::SequenceNumber() const { return seq_num_; }
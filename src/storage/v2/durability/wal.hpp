@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -15,6 +15,7 @@
 #include <filesystem>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "storage/v2/config.hpp"
 #include "storage/v2/delta.hpp"
@@ -24,6 +25,7 @@
 #include "storage/v2/id_types.hpp"
 #include "storage/v2/name_id_mapper.hpp"
 #include "storage/v2/property_value.hpp"
+#include "storage/v2/statistics.hpp"
 #include "storage/v2/vertex.hpp"
 #include "utils/file_locker.hpp"
 #include "utils/skip_list.hpp"
@@ -63,6 +65,13 @@ struct WalDeltaData {
     EXISTENCE_CONSTRAINT_DROP,
     UNIQUE_CONSTRAINT_CREATE,
     UNIQUE_CONSTRAINT_DROP,
+    EDGE_TYPE_INDEX_CREATE,
+    EDGE_TYPE_INDEX_DROP,
+    EDGE_TYPE_PROPERTY_INDEX_CREATE,
+    EDGE_TYPE_PROPERTY_INDEX_DROP,
+    LABEL_PROPERTY_COMPOSITE_INDEX_CREATE,
+    LABEL_PROPERTY_COMPOSITE_INDEX_DROP,
+    GRAPH_STATISTICS_SET,
   };
 
   Type type{Type::TRANSACTION_END};
@@ -102,6 +111,26 @@ struct WalDeltaData {
     std::string label;
     std::set<std::string> properties;
   } operation_label_properties;
+
+  struct {
+    std::string edge_type;
+  } operation_edge_type;
+
+  struct {
+    std::string edge_type;
+    std::string property;
+  } operation_edge_type_property;
+
+  // Unlike `operation_label_properties` the order of the properties is
+  // preserved.
+  struct {
+    std::string label;
+    std::vector<std::string> properties;
+  } operation_label_property_list;
+
+  struct {
+    NamedGraphStatistics statistics;
+  } operation_graph_statistics;
 };
 
 bool operator==(const WalDeltaData &a, const WalDeltaData &b);
@@ -117,6 +146,13 @@ enum class StorageGlobalOperation {
   EXISTENCE_CONSTRAINT_DROP,
   UNIQUE_CONSTRAINT_CREATE,
   UNIQUE_CONSTRAINT_DROP,
+  EDGE_TYPE_INDEX_CREATE,
+  EDGE_TYPE_INDEX_DROP,
+  EDGE_TYPE_PROPERTY_INDEX_CREATE,
+  EDGE_TYPE_PROPERTY_INDEX_DROP,
+  LABEL_PROPERTY_COMPOSITE_INDEX_CREATE,
+  LABEL_PROPERTY_COMPOSITE_INDEX_DROP,
+  GRAPH_STATISTICS_SET,
 };
 
 constexpr bool IsWalDeltaDataTypeTransactionEnd(const WalDeltaData::Type type) {
@@ -148,6 +184,13 @@ constexpr bool IsWalDeltaDataTypeTransactionEnd(const WalDeltaData::Type type) {
     case WalDeltaData::Type::EXISTENCE_CONSTRAINT_DROP:
     case WalDeltaData::Type::UNIQUE_CONSTRAINT_CREATE:
     case WalDeltaData::Type::UNIQUE_CONSTRAINT_DROP:
+    case WalDeltaData::Type::EDGE_TYPE_INDEX_CREATE:
+    case WalDeltaData::Type::EDGE_TYPE_INDEX_DROP:
+    case WalDeltaData::Type::EDGE_TYPE_PROPERTY_INDEX_CREATE:
+    case WalDeltaData::Type::EDGE_TYPE_PROPERTY_INDEX_DROP:
+    case WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+    case WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+    case WalDeltaData::Type::GRAPH_STATISTICS_SET:
       return true;
   }
 }
@@ -186,7 +229,16 @@ void EncodeTransactionEnd(BaseEncoder *encoder, uint64_t timestamp);
 
 /// Function used to encode non-transactional operation.
 void EncodeOperation(BaseEncoder *encoder, NameIdMapper *name_id_mapper, StorageGlobalOperation operation,
-                     LabelId label, const std::set<PropertyId> &properties, uint64_t timestamp);
+                     LabelId label, const std::vector<PropertyId> &properties, uint64_t timestamp);
+
+/// Function used to encode non-transactional operation on an edge type.
+void EncodeOperation(BaseEncoder *encoder, NameIdMapper *name_id_mapper, StorageGlobalOperation operation,
+                     EdgeTypeId edge_type, const std::vector<PropertyId> &properties, uint64_t timestamp);
+
+/// Function used to encode non-transactional operation on the graph
+/// statistics.
+void EncodeOperation(BaseEncoder *encoder, StorageGlobalOperation operation, const NamedGraphStatistics &statistics,
+                     uint64_t timestamp);
 
 /// Function used to load the WAL data into the storage.
 /// @throw RecoveryFailure
@@ -199,7 +251,9 @@ RecoveryInfo LoadWal(const std::filesystem::path &path, RecoveredIndicesAndConst
 class WalFile {
  public:
   WalFile(const std::filesystem::path &wal_directory, std::string_view uuid, std::string_view epoch_id,
-          Config::Items items, NameIdMapper *name_id_mapper, uint64_t seq_num, utils::FileRetainer *file_retainer);
+          Config::Items items, NameIdMapper *name_id_mapper, uint64_t seq_num, utils::FileRetainer *file_retainer,
+          Config::Durability::Compression compression = Config::Durability::Compression::NONE,
+          bool async_writes = false);
   WalFile(std::filesystem::path current_wal_path, Config::Items items, NameIdMapper *name_id_mapper, uint64_t seq_num,
           uint64_t from_timestamp, uint64_t to_timestamp, uint64_t count, utils::FileRetainer *file_retainer);
 
@@ -215,11 +269,20 @@ class WalFile {
 
   void AppendTransactionEnd(uint64_t timestamp);
 
-  void AppendOperation(StorageGlobalOperation operation, LabelId label, const std::set<PropertyId> &properties,
+  void AppendOperation(StorageGlobalOperation operation, LabelId label, const std::vector<PropertyId> &properties,
                        uint64_t timestamp);
 
+  void AppendOperation(StorageGlobalOperation operation, EdgeTypeId edge_type,
+                       const std::vector<PropertyId> &properties, uint64_t timestamp);
+
+  void AppendOperation(StorageGlobalOperation operation, const NamedGraphStatistics &statistics, uint64_t timestamp);
+
   void Sync();
 
+  // Write all of the appended data to the file and get a handle which syncs
+  // it without blocking further appends.
+  utils::FileSyncHandle FlushForSync();
+
   uint64_t GetSize();
 
   uint64_t SequenceNumber() const;
@@ -14,6 +14,7 @@
 #include <memory>
 #include <tuple>
 
+#include "storage/v2/indices.hpp"
 #include "storage/v2/mvcc.hpp"
 #include "storage/v2/property_value.hpp"
 #include "storage/v2/vertex_accessor.hpp"
@@ -31,9 +32,7 @@ bool EdgeAccessor::IsVisible(const View view) const {
     {
       std::lock_guard<utils::SpinLock> guard(from_vertex_->lock);
       // Initialize deleted by checking if out edges contain edge_
-      deleted = std::find_if(from_vertex_->out_edges.begin(), from_vertex_->out_edges.end(), [&](const auto &out_edge) {
-                  return std::get<2>(out_edge) == edge_;
-                }) == from_vertex_->out_edges.end();
+      deleted = !from_vertex_->out_edges.Contains(edge_type_, to_vertex_, edge_);
       delta = from_vertex_->delta;
     }
     ApplyDeltasForRead(transaction_, delta, view, [&](const Delta &delta) {
@@ -120,6 +119,8 @@ Result<storage::PropertyValue> EdgeAccessor::SetProperty(PropertyId property, co
   CreateAndLinkDelta(transaction_, edge_.ptr, Delta::SetPropertyTag(), property, current_value);
   edge_.ptr->properties.SetProperty(property, value);
 
+  UpdateOnSetEdgeProperty(indices_, property, value, from_vertex_, to_vertex_, edge_, edge_type_, *transaction_);
+
   return std::move(current_value);
 }
 
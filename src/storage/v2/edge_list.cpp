@@ -0,0 +1,301 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/edge_list.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "utils/logging.hpp"
+
+namespace memgraph::storage {
+
+namespace {
+
+static_assert(std::is_trivially_copyable_v<EdgeList::Entry>, "The EdgeList::Entry must be trivially copyable!");
+static_assert(std::is_trivially_copyable_v<EdgeList::Group>, "The EdgeList::Group must be trivially copyable!");
+
+// All arrays are allocated with a capacity that is the smallest power of two
+// that is greater than or equal to their size. That way the capacity doesn't
+// have to be stored anywhere.
+size_t Capacity(size_t size) { return std::bit_ceil(size); }
+
+template <typename T>
+T *Allocate(size_t capacity) {
+  return static_cast<T *>(::operator new(capacity * sizeof(T)));
+}
+
+template <typename T>
+void Deallocate(T *data) {
+  ::operator delete(static_cast<void *>(data));
+}
+
+// Changes the capacity of the array `data` that currently holds `size`
+// elements so that it can hold `new_size` elements. The elements that fit into
+// the new array are preserved.
+template <typename T>
+T *Resize(T *data, size_t size, size_t new_size) {
+  if (Capacity(size) == Capacity(new_size)) return data;
+  auto *new_data = Allocate<T>(Capacity(new_size));
+  memcpy(static_cast<void *>(new_data), static_cast<const void *>(data), std::min(size, new_size) * sizeof(T));
+  Deallocate(data);
+  return new_data;
+}
+
+uint32_t CompactEdgeType(EdgeTypeId edge_type) {
+  MG_ASSERT(edge_type.AsUint() <= std::numeric_limits<uint32_t>::max(), "Edge type ID is too large for the EdgeList!");
+  return static_cast<uint32_t>(edge_type.AsUint());
+}
+
+bool IsSameEntry(const EdgeList::Entry &entry, Vertex *vertex, EdgeRef edge) {
+  return entry.vertex == vertex && entry.edge == edge;
+}
+
+// Removes the entry from the array by replacing it with the last entry of the
+// array. Returns `false` if the entry wasn't found.
+bool RemoveEntry(EdgeList::Entry *entries, uint32_t size, Vertex *vertex, EdgeRef edge) {
+  for (uint32_t i = 0; i < size; ++i) {
+    if (IsSameEntry(entries[i], vertex, edge)) {
+      entries[i] = entries[size - 1];
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+EdgeList::EdgeList() noexcept : heap{{nullptr}, 0}, edge_type_(0), size_(0) {}
+
+EdgeList::EdgeList(EdgeList &&other) noexcept : edge_type_(other.edge_type_), size_(other.size_) {
+  memcpy(static_cast<void *>(&single), static_cast<const void *>(&other.single), sizeof(single));
+  other.size_ = 0;
+}
+
+EdgeList &EdgeList::operator=(EdgeList &&other) noexcept {
+  if (this == &other) return *this;
+  Clear();
+  memcpy(static_cast<void *>(&single), static_cast<const void *>(&other.single), sizeof(single));
+  edge_type_ = other.edge_type_;
+  size_ = other.size_;
+  other.size_ = 0;
+  return *this;
+}
+
+EdgeList::~EdgeList() { Clear(); }
+
+void EdgeList::Clear() noexcept {
+  if (size_ > 1) {
+    if (heap.num_groups == 1) {
+      Deallocate(heap.entries);
+    } else {
+      for (uint32_t i = 0; i < heap.num_groups; ++i) {
+        Deallocate(heap.groups[i].entries);
+      }
+      Deallocate(heap.groups);
+    }
+  }
+  size_ = 0;
+}
+
+EdgeList::Iterator EdgeList::begin() const {
+  const auto edge_type = EdgeTypeId::FromUint(edge_type_);
+  if (size_ == 0) return {};
+  if (size_ == 1) return {edge_type, &single, &single + 1, nullptr, nullptr};
+  if (heap.num_groups == 1) return {edge_type, heap.entries, heap.entries + size_, nullptr, nullptr};
+  Iterator it(edge_type, nullptr, nullptr, heap.groups, heap.groups + heap.num_groups);
+  it.LoadGroup();
+  return it;
+}
+
+EdgeList::Iterator EdgeList::end() const {
+  // Only the entry and group pointers are used when comparing iterators. The
+  // iterator past the last group has already loaded all of the groups.
+  if (size_ == 0) return {};
+  if (size_ == 1) return {EdgeTypeId(), &single + 1, nullptr, nullptr, nullptr};
+  if (heap.num_groups == 1) return {EdgeTypeId(), heap.entries + size_, nullptr, nullptr, nullptr};
+  const auto &last = heap.groups[heap.num_groups - 1];
+  const auto *groups_end = heap.groups + heap.num_groups;
+  return {EdgeTypeId(), last.entries + last.size, nullptr, groups_end, groups_end};
+}
+
+EdgeList::Group *EdgeList::LowerBound(uint32_t edge_type) const {
+  return std::lower_bound(heap.groups, heap.groups + heap.num_groups, edge_type,
+                          [](const Group &group, uint32_t edge_type) { return group.edge_type < edge_type; });
+}
+
+EdgeList::Group *EdgeList::FindGroup(uint32_t edge_type) const {
+  if (size_ <= 1 || heap.num_groups == 1) return nullptr;
+  auto *group = LowerBound(edge_type);
+  if (group == heap.groups + heap.num_groups || group->edge_type != edge_type) return nullptr;
+  return group;
+}
+
+std::pair<const EdgeList::Entry *, uint32_t> EdgeList::FindEntries(uint32_t edge_type) const {
+  if (size_ == 0) return {nullptr, 0};
+  if (size_ == 1) {
+    if (edge_type != edge_type_) return {nullptr, 0};
+    return {&single, 1};
+  }
+  if (heap.num_groups == 1) {
+    if (edge_type != edge_type_) return {nullptr, 0};
+    return {heap.entries, size_};
+  }
+  const auto *group = FindGroup(edge_type);
+  if (!group) return {nullptr, 0};
+  return {group->entries, group->size};
+}
+
+void EdgeList::Add(EdgeTypeId edge_type_id, Vertex *vertex, EdgeRef edge) {
+  const auto edge_type = CompactEdgeType(edge_type_id);
+  MG_ASSERT(size_ < std::numeric_limits<uint32_t>::max(), "Too many edges in the EdgeList!");
+  const Entry entry{vertex, edge};
+  if (size_ == 0) {
+    single = entry;
+    edge_type_ = edge_type;
+  } else if (size_ == 1) {
+    const auto first = single;
+    if (edge_type == edge_type_) {
+      auto *entries = Allocate<Entry>(Capacity(2));
+      entries[0] = first;
+      entries[1] = entry;
+      heap.entries = entries;
+      heap.num_groups = 1;
+    } else {
+      auto *entries = Allocate<Entry>(Capacity(1));
+      entries[0] = first;
+      auto *other_entries = Allocate<Entry>(Capacity(1));
+      other_entries[0] = entry;
+      auto *groups = Allocate<Group>(Capacity(2));
+      groups[0] = {edge_type_, 1, entries};
+      groups[1] = {edge_type, 1, other_entries};
+      if (edge_type < edge_type_) std::swap(groups[0], groups[1]);
+      heap.groups = groups;
+      heap.num_groups = 2;
+    }
+  } else if (heap.num_groups == 1) {
+    if (edge_type == edge_type_) {
+      heap.entries = Resize(heap.entries, size_, size_ + 1);
+      heap.entries[size_] = entry;
+    } else {
+      auto *other_entries = Allocate<Entry>(Capacity(1));
+      other_entries[0] = entry;
+      auto *groups = Allocate<Group>(Capacity(2));
+      groups[0] = {edge_type_, size_, heap.entries};
+      groups[1] = {edge_type, 1, other_entries};
+      if (edge_type < edge_type_) std::swap(groups[0], groups[1]);
+      heap.groups = groups;
+      heap.num_groups = 2;
+    }
+  } else if (auto *group = FindGroup(edge_type); group) {
+    group->entries = Resize(group->entries, group->size, group->size + 1);
+    group->entries[group->size] = entry;
+    ++group->size;
+  } else {
+    // The new group is inserted so that the groups stay sorted by edge type.
+    auto *entries = Allocate<Entry>(Capacity(1));
+    entries[0] = entry;
+    auto pos = LowerBound(edge_type) - heap.groups;
+    heap.groups = Resize(heap.groups, heap.num_groups, heap.num_groups + 1);
+    memmove(static_cast<void *>(heap.groups + pos + 1), static_cast<const void *>(heap.groups + pos),
+            (heap.num_groups - pos) * sizeof(Group));
+    heap.groups[pos] = {edge_type, 1, entries};
+    ++heap.num_groups;
+  }
+  ++size_;
+}
+
+bool EdgeList::Remove(EdgeTypeId edge_type_id, Vertex *vertex, EdgeRef edge) {
+  const auto edge_type = CompactEdgeType(edge_type_id);
+  if (size_ == 0) return false;
+  if (size_ == 1) {
+    if (edge_type != edge_type_ || !IsSameEntry(single, vertex, edge)) return false;
+    size_ = 0;
+    return true;
+  }
+  if (heap.num_groups == 1) {
+    if (edge_type != edge_type_ || !RemoveEntry(heap.entries, size_, vertex, edge)) return false;
+    --size_;
+    if (size_ == 1) {
+      auto *entries = heap.entries;
+      single = entries[0];
+      Deallocate(entries);
+    } else {
+      heap.entries = Resize(heap.entries, size_ + 1, size_);
+    }
+    return true;
+  }
+  auto *group = FindGroup(edge_type);
+  if (!group || !RemoveEntry(group->entries, group->size, vertex, edge)) return false;
+  --size_;
+  --group->size;
+  if (group->size > 0) {
+    group->entries = Resize(group->entries, group->size + 1, group->size);
+    return true;
+  }
+  // The group is empty so we remove it while keeping the other groups sorted.
+  Deallocate(group->entries);
+  auto pos = group - heap.groups;
+  memmove(static_cast<void *>(heap.groups + pos), static_cast<const void *>(heap.groups + pos + 1),
+          (heap.num_groups - pos - 1) * sizeof(Group));
+  --heap.num_groups;
+  if (heap.num_groups > 1) {
+    heap.groups = Resize(heap.groups, heap.num_groups + 1, heap.num_groups);
+    return true;
+  }
+  // Only a single group remains so we switch to the single type
+  // representation.
+  auto *groups = heap.groups;
+  edge_type_ = groups[0].edge_type;
+  if (size_ == 1) {
+    single = groups[0].entries[0];
+    Deallocate(groups[0].entries);
+  } else {
+    heap.entries = groups[0].entries;
+    heap.num_groups = 1;
+  }
+  Deallocate(groups);
+  return true;
+}
+
+bool EdgeList::Contains(EdgeTypeId edge_type, Vertex *vertex, EdgeRef edge) const {
+  auto [entries, size] = FindEntries(CompactEdgeType(edge_type));
+  for (uint32_t i = 0; i < size; ++i) {
+    if (IsSameEntry(entries[i], vertex, edge)) return true;
+  }
+  return false;
+}
+
+EdgeList::Range EdgeList::EdgesOfType(EdgeTypeId edge_type) const {
+  auto [entries, size] = FindEntries(CompactEdgeType(edge_type));
+  if (size == 0) return {};
+  return {Iterator(edge_type, entries, entries + size, nullptr, nullptr),
+          Iterator(edge_type, entries + size, nullptr, nullptr, nullptr)};
+}
+
+size_t EdgeList::Degree(EdgeTypeId edge_type) const { return FindEntries(CompactEdgeType(edge_type)).second; }
+
+size_t EdgeList::HeapSize() const {
+  if (size_ <= 1) return 0;
+  if (heap.num_groups == 1) return Capacity(size_) * sizeof(Entry);
+  size_t ret = Capacity(heap.num_groups) * sizeof(Group);
+  for (uint32_t i = 0; i < heap.num_groups; ++i) {
+    ret += Capacity(heap.groups[i].size) * sizeof(Entry);
+  }
+  return ret;
+}
+
+}  // namespace memgraph::storage
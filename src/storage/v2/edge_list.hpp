@@ -0,0 +1,214 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+#include "storage/v2/edge_ref.hpp"
+#include "storage/v2/id_types.hpp"
+
+namespace memgraph::storage {
+
+// Forward declaration because we only store a pointer here.
+struct Vertex;
+
+/// Compact adjacency list of a vertex in one direction.
+///
+/// Edges are grouped by their `EdgeTypeId` so that the edge type is stored
+/// once per group instead of once per edge. Each stored edge is 16 bytes (the
+/// other vertex and the `EdgeRef`) compared to 24 bytes for a
+/// `std::tuple<EdgeTypeId, Vertex *, EdgeRef>`. A list that holds a single
+/// edge keeps it inline and doesn't allocate at all. A list that holds edges
+/// of a single type uses a single heap allocation.
+///
+/// The groups are kept sorted by the edge type so that all edges of a single
+/// type can be found in O(log(k)) time, where k is the number of distinct edge
+/// types in the list. The iteration order of the edges of the same type isn't
+/// specified and can change when edges are removed.
+class EdgeList final {
+ public:
+  using Item = std::tuple<EdgeTypeId, Vertex *, EdgeRef>;
+
+  struct Entry {
+    Vertex *vertex;
+    EdgeRef edge;
+  };
+
+  // Edge type IDs are handed out sequentially by the `NameIdMapper` so they are
+  // stored as 32-bit values to keep the groups small.
+  struct Group {
+    uint32_t edge_type;
+    uint32_t size;
+    Entry *entries;
+  };
+
+  class Iterator final {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Item;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Item;
+
+    Iterator() = default;
+
+    Item operator*() const { return {edge_type_, entry_->vertex, entry_->edge}; }
+
+    Iterator &operator++() {
+      ++entry_;
+      if (entry_ == entry_end_ && group_ != group_end_) LoadGroup();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto old = *this;
+      ++*this;
+      return old;
+    }
+
+    // The group is compared as well because the end of the last group's array
+    // can be the start of another group's array.
+    bool operator==(const Iterator &other) const { return entry_ == other.entry_ && group_ == other.group_; }
+    bool operator!=(const Iterator &other) const { return !(*this == other); }
+
+   private:
+    friend class EdgeList;
+
+    Iterator(EdgeTypeId edge_type, const Entry *entry, const Entry *entry_end, const Group *group,
+             const Group *group_end)
+        : edge_type_(edge_type), entry_(entry), entry_end_(entry_end), group_(group), group_end_(group_end) {}
+
+    void LoadGroup() {
+      edge_type_ = EdgeTypeId::FromUint(group_->edge_type);
+      entry_ = group_->entries;
+      entry_end_ = group_->entries + group_->size;
+      ++group_;
+    }
+
+    EdgeTypeId edge_type_;
+    const Entry *entry_{nullptr};
+    const Entry *entry_end_{nullptr};
+    const Group *group_{nullptr};
+    const Group *group_end_{nullptr};
+  };
+
+  /// Edges of a single edge type.
+  struct Range {
+    Iterator first;
+    Iterator last;
+
+    Iterator begin() const { return first; }
+    Iterator end() const { return last; }
+  };
+
+  EdgeList() noexcept;
+
+  EdgeList(const EdgeList &) = delete;
+  EdgeList(EdgeList &&other) noexcept;
+  EdgeList &operator=(const EdgeList &) = delete;
+  EdgeList &operator=(EdgeList &&other) noexcept;
+
+  ~EdgeList();
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  Iterator begin() const;
+  Iterator end() const;
+
+  /// Adds the edge to the list. The caller is responsible for checking that
+  /// the edge isn't already in the list.
+  /// @throw std::bad_alloc
+  void Add(EdgeTypeId edge_type, Vertex *vertex, EdgeRef edge);
+
+  /// Removes the edge from the list and returns `true` if the edge was found.
+  /// The time complexity of this function is O(n).
+  bool Remove(EdgeTypeId edge_type, Vertex *vertex, EdgeRef edge);
+
+  /// Checks whether the edge is in the list. The time complexity of this
+  /// function is O(n).
+  bool Contains(EdgeTypeId edge_type, Vertex *vertex, EdgeRef edge) const;
+
+  /// Returns all edges of the type `edge_type`. The time complexity of this
+  /// function is O(log(k)), where k is the number of distinct edge types.
+  Range EdgesOfType(EdgeTypeId edge_type) const;
+
+  /// Returns the number of edges of the type `edge_type`. The time complexity
+  /// of this function is O(log(k)), where k is the number of distinct edge
+  /// types.
+  size_t Degree(EdgeTypeId edge_type) const;
+
+  /// Calls `func(edge_type, degree)` for each edge type in the list with the
+  /// number of edges of that type. The time complexity of this function is
+  /// O(k), where k is the number of distinct edge types.
+  template <typename TFunc>
+  void ForEachEdgeType(const TFunc &func) const {
+    if (size_ == 0) return;
+    if (size_ == 1 || heap.num_groups == 1) {
+      func(EdgeTypeId::FromUint(edge_type_), static_cast<size_t>(size_));
+      return;
+    }
+    for (uint32_t i = 0; i < heap.num_groups; ++i) {
+      func(EdgeTypeId::FromUint(heap.groups[i].edge_type), static_cast<size_t>(heap.groups[i].size));
+    }
+  }
+
+  /// Returns the number of bytes the list occupies on the heap.
+  size_t HeapSize() const;
+
+ private:
+  // Returns the group holding edges of `edge_type` when the list is in the
+  // multiple groups representation, `nullptr` otherwise.
+  Group *FindGroup(uint32_t edge_type) const;
+
+  // Returns the first group whose edge type isn't less than `edge_type` when
+  // the list is in the multiple groups representation.
+  Group *LowerBound(uint32_t edge_type) const;
+
+  // Returns the array of edges of `edge_type` and its size.
+  std::pair<const Entry *, uint32_t> FindEntries(uint32_t edge_type) const;
+
+  void Clear() noexcept;
+
+  // The representation depends on `size_` and on `num_groups`:
+  //   * `size_ == 0` - the list is empty;
+  //   * `size_ == 1` - the edge is stored in `single` and its type is
+  //     `edge_type_`;
+  //   * `size_ > 1 && heap.num_groups == 1` - all edges are of type
+  //     `edge_type_` and are stored in the array `heap.entries`;
+  //   * `size_ > 1 && heap.num_groups > 1` - the edges are stored in the
+  //     array of groups `heap.groups` that is sorted by the edge type.
+  // All heap arrays have a capacity that is the smallest power of two that is
+  // greater than or equal to their size.
+  union {
+    Entry single;
+    struct {
+      union {
+        Entry *entries;
+        Group *groups;
+      };
+      uint32_t num_groups;
+    } heap;
+  };
+  uint32_t edge_type_;
+  uint32_t size_;
+};
+
+static_assert(sizeof(EdgeList::Entry) == 16, "The EdgeList::Entry should be 16 bytes!");
+static_assert(sizeof(EdgeList::Group) == 16, "The EdgeList::Group should be 16 bytes!");
+static_assert(sizeof(EdgeList) == 24, "The EdgeList should be 24 bytes!");
+
+}  // namespace memgraph::storage
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -10,7 +10,11 @@
 // licenses/APL.txt.
 
 #include "indices.hpp"
+#include <algorithm>
+#include <exception>
+#include <iterator>
 #include <limits>
+#include <thread>
 
 #include "storage/v2/mvcc.hpp"
 #include "storage/v2/property_value.hpp"
@@ -261,18 +265,1273 @@ bool CurrentVersionHasLabelProperty(const Vertex &vertex, LabelId label, Propert
   return !deleted && has_label && current_value_equal_to_value;
 }
 
+/// Helper function for the composite index. Returns the values of the
+/// properties of the vertex, or `std::nullopt` if the vertex doesn't have all
+/// of the properties. The vertex lock must be held by the caller.
+std::optional<std::vector<PropertyValue>> GetPropertyValues(const Vertex &vertex,
+                                                            const std::vector<PropertyId> &properties) {
+  std::vector<PropertyValue> values;
+  values.reserve(properties.size());
+  for (const auto &property : properties) {
+    auto value = vertex.properties.GetProperty(property);
+    if (value.IsNull()) return std::nullopt;
+    values.push_back(std::move(value));
+  }
+  return values;
+}
+
+/// Helper function for composite index garbage collection. Returns true if
+/// there's a reachable version of the vertex that has the given label and
+/// property values.
+bool AnyVersionHasLabelProperties(const Vertex &vertex, LabelId label, const std::vector<PropertyId> &keys,
+                                  const std::vector<PropertyValue> &values, uint64_t timestamp) {
+  bool has_label;
+  bool deleted;
+  std::vector<bool> current_values_equal(keys.size());
+  const Delta *delta;
+  {
+    std::lock_guard<utils::SpinLock> guard(vertex.lock);
+    has_label = utils::Contains(vertex.labels, label);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      current_values_equal[i] = vertex.properties.IsPropertyEqual(keys[i], values[i]);
+    }
+    deleted = vertex.deleted;
+    delta = vertex.delta;
+  }
+  auto all_values_equal = [&current_values_equal] {
+    return std::all_of(current_values_equal.begin(), current_values_equal.end(), [](bool equal) { return equal; });
+  };
+
+  if (!deleted && has_label && all_values_equal()) {
+    return true;
+  }
+
+  return AnyVersionSatisfiesPredicate(timestamp, delta, [&](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::ADD_LABEL:
+        if (delta.label == label) {
+          MG_ASSERT(!has_label, "Invalid database state!");
+          has_label = true;
+        }
+        break;
+      case Delta::Action::REMOVE_LABEL:
+        if (delta.label == label) {
+          MG_ASSERT(has_label, "Invalid database state!");
+          has_label = false;
+        }
+        break;
+      case Delta::Action::SET_PROPERTY:
+        for (size_t i = 0; i < keys.size(); ++i) {
+          if (delta.property.key == keys[i]) {
+            current_values_equal[i] = delta.property.value == values[i];
+          }
+        }
+        break;
+      case Delta::Action::RECREATE_OBJECT: {
+        MG_ASSERT(deleted, "Invalid database state!");
+        deleted = false;
+        break;
+      }
+      case Delta::Action::DELETE_OBJECT: {
+        MG_ASSERT(!deleted, "Invalid database state!");
+        deleted = true;
+        break;
+      }
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::ADD_OUT_EDGE:
+      case Delta::Action::REMOVE_IN_EDGE:
+      case Delta::Action::REMOVE_OUT_EDGE:
+        break;
+    }
+    return !deleted && has_label && all_values_equal();
+  });
+}
+
+// Helper function for iterating through the composite index. Returns true if
+// this transaction can see the given vertex, and the visible version has the
+// given label and property values.
+bool CurrentVersionHasLabelProperties(const Vertex &vertex, LabelId label, const std::vector<PropertyId> &keys,
+                                      const std::vector<PropertyValue> &values, Transaction *transaction, View view) {
+  bool deleted;
+  bool has_label;
+  std::vector<bool> current_values_equal(keys.size());
+  const Delta *delta;
+  {
+    std::lock_guard<utils::SpinLock> guard(vertex.lock);
+    deleted = vertex.deleted;
+    has_label = utils::Contains(vertex.labels, label);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      current_values_equal[i] = vertex.properties.IsPropertyEqual(keys[i], values[i]);
+    }
+    delta = vertex.delta;
+  }
+  ApplyDeltasForRead(transaction, delta, view, [&](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::SET_PROPERTY: {
+        for (size_t i = 0; i < keys.size(); ++i) {
+          if (delta.property.key == keys[i]) {
+            current_values_equal[i] = delta.property.value == values[i];
+          }
+        }
+        break;
+      }
+      case Delta::Action::DELETE_OBJECT: {
+        MG_ASSERT(!deleted, "Invalid database state!");
+        deleted = true;
+        break;
+      }
+      case Delta::Action::RECREATE_OBJECT: {
+        MG_ASSERT(deleted, "Invalid database state!");
+        deleted = false;
+        break;
+      }
+      case Delta::Action::ADD_LABEL:
+        if (delta.label == label) {
+          MG_ASSERT(!has_label, "Invalid database state!");
+          has_label = true;
+        }
+        break;
+      case Delta::Action::REMOVE_LABEL:
+        if (delta.label == label) {
+          MG_ASSERT(has_label, "Invalid database state!");
+          has_label = false;
+        }
+        break;
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::ADD_OUT_EDGE:
+      case Delta::Action::REMOVE_IN_EDGE:
+      case Delta::Action::REMOVE_OUT_EDGE:
+        break;
+    }
+  });
+  return !deleted && has_label &&
+         std::all_of(current_values_equal.begin(), current_values_equal.end(), [](bool equal) { return equal; });
+}
+
+/// Helper function for edge index garbage collection. Returns true if there's
+/// a reachable version of the from vertex that has the given out edge. Only
+/// the adjacency of the from vertex is checked because the edge object could
+/// already be removed from the storage.
+bool AnyVersionHasEdge(const Vertex &from_vertex, EdgeTypeId edge_type, Vertex *to_vertex, EdgeRef edge,
+                       uint64_t timestamp) {
+  bool has_edge;
+  const Delta *delta;
+  {
+    std::lock_guard<utils::SpinLock> guard(from_vertex.lock);
+    has_edge = from_vertex.out_edges.Contains(edge_type, to_vertex, edge);
+    delta = from_vertex.delta;
+  }
+  if (has_edge) {
+    return true;
+  }
+  return AnyVersionSatisfiesPredicate(timestamp, delta, [&has_edge, edge](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::ADD_OUT_EDGE:
+        if (delta.vertex_edge.edge == edge) {
+          MG_ASSERT(!has_edge, "Invalid database state!");
+          has_edge = true;
+        }
+        break;
+      case Delta::Action::REMOVE_OUT_EDGE:
+        if (delta.vertex_edge.edge == edge) {
+          MG_ASSERT(has_edge, "Invalid database state!");
+          has_edge = false;
+        }
+        break;
+      case Delta::Action::ADD_LABEL:
+      case Delta::Action::REMOVE_LABEL:
+      case Delta::Action::SET_PROPERTY:
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::REMOVE_IN_EDGE:
+      case Delta::Action::RECREATE_OBJECT:
+      case Delta::Action::DELETE_OBJECT:
+        break;
+    }
+    return has_edge;
+  });
+}
+
+/// Helper function for edge-type-property index garbage collection. Returns
+/// true if there's a reachable version of the edge that has the given property
+/// value. The edge must exist in a reachable version of its from vertex.
+bool AnyVersionHasEdgeProperty(const Edge &edge, PropertyId key, const PropertyValue &value, uint64_t timestamp) {
+  bool current_value_equal_to_value;
+  bool deleted;
+  const Delta *delta;
+  {
+    std::lock_guard<utils::SpinLock> guard(edge.lock);
+    current_value_equal_to_value = edge.properties.IsPropertyEqual(key, value);
+    deleted = edge.deleted;
+    delta = edge.delta;
+  }
+
+  if (!deleted && current_value_equal_to_value) {
+    return true;
+  }
+
+  return AnyVersionSatisfiesPredicate(
+      timestamp, delta, [&current_value_equal_to_value, &deleted, key, &value](const Delta &delta) {
+        switch (delta.action) {
+          case Delta::Action::SET_PROPERTY:
+            if (delta.property.key == key) {
+              current_value_equal_to_value = delta.property.value == value;
+            }
+            break;
+          case Delta::Action::RECREATE_OBJECT: {
+            MG_ASSERT(deleted, "Invalid database state!");
+            deleted = false;
+            break;
+          }
+          case Delta::Action::DELETE_OBJECT: {
+            MG_ASSERT(!deleted, "Invalid database state!");
+            deleted = true;
+            break;
+          }
+          case Delta::Action::ADD_LABEL:
+          case Delta::Action::REMOVE_LABEL:
+          case Delta::Action::ADD_IN_EDGE:
+          case Delta::Action::ADD_OUT_EDGE:
+          case Delta::Action::REMOVE_IN_EDGE:
+          case Delta::Action::REMOVE_OUT_EDGE:
+            break;
+        }
+        return !deleted && current_value_equal_to_value;
+      });
+}
+
+// Helper function for iterating through edge indices. Returns true if this
+// transaction can see the given edge in the out edges of its from vertex.
+bool CurrentVersionHasEdge(const Vertex &from_vertex, EdgeTypeId edge_type, Vertex *to_vertex, EdgeRef edge,
+                           Transaction *transaction, View view) {
+  bool has_edge;
+  const Delta *delta;
+  {
+    std::lock_guard<utils::SpinLock> guard(from_vertex.lock);
+    has_edge = from_vertex.out_edges.Contains(edge_type, to_vertex, edge);
+    delta = from_vertex.delta;
+  }
+  ApplyDeltasForRead(transaction, delta, view, [&has_edge, edge](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::ADD_OUT_EDGE:
+        if (delta.vertex_edge.edge == edge) {
+          MG_ASSERT(!has_edge, "Invalid database state!");
+          has_edge = true;
+        }
+        break;
+      case Delta::Action::REMOVE_OUT_EDGE:
+        if (delta.vertex_edge.edge == edge) {
+          MG_ASSERT(has_edge, "Invalid database state!");
+          has_edge = false;
+        }
+        break;
+      case Delta::Action::ADD_LABEL:
+      case Delta::Action::REMOVE_LABEL:
+      case Delta::Action::SET_PROPERTY:
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::REMOVE_IN_EDGE:
+      case Delta::Action::RECREATE_OBJECT:
+      case Delta::Action::DELETE_OBJECT:
+        break;
+    }
+  });
+  return has_edge;
+}
+
+/// Helper function for populating the label-property index while the vertex
+/// is modified concurrently. Calls the callback with the current value of the
+/// property and with each value that the property has in the versions that
+/// aren't visible to the transaction with the provided timestamp.
+template <typename TCallback>
+void ForEachNewerPropertyValue(const Vertex &vertex, PropertyId key, uint64_t timestamp, const TCallback &callback) {
+  PropertyValue value;
+  const Delta *delta;
+  {
+    std::lock_guard<utils::SpinLock> guard(vertex.lock);
+    value = vertex.properties.GetProperty(key);
+    delta = vertex.delta;
+  }
+  callback(std::move(value));
+  AnyVersionSatisfiesPredicate(timestamp, delta, [key, &callback](const Delta &delta) {
+    if (delta.action == Delta::Action::SET_PROPERTY && delta.property.key == key) {
+      callback(delta.property.value);
+    }
+    return false;
+  });
+}
+
+/// Splits the vertices into at most `num_threads` chunks and calls
+/// `callback(chunk_index, chunk)` for each chunk from its own thread. The
+/// calling thread processes the first chunk. If any of the callbacks throws,
+/// the exception is rethrown once all threads are done.
+template <typename TCallback>
+void ForEachChunkInParallel(utils::SkipList<Vertex>::Accessor &vertices, uint64_t num_threads,
+                            const TCallback &callback) {
+  auto chunks = vertices.chunks(num_threads);
+  std::vector<std::exception_ptr> errors(chunks.size());
+  auto process_chunk = [&](size_t chunk_index) {
+    utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+    try {
+      callback(chunk_index, chunks[chunk_index]);
+    } catch (...) {
+      errors[chunk_index] = std::current_exception();
+    }
+  };
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(chunks.size() - 1);
+    for (size_t i = 1; i < chunks.size(); ++i) {
+      threads.emplace_back(process_chunk, i);
+    }
+    process_chunk(0);
+  }
+  for (const auto &error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
+
+/// Input iterator that merges sorted runs of index entries into a single
+/// sorted sequence. The entries are moved out of the runs and each run is
+/// freed as soon as it is exhausted. Iterators can only be compared to the
+/// default constructed end iterator.
+template <typename TEntry>
+class MergedRunsIterator {
+ public:
+  using iterator_category = std::input_iterator_tag;
+  using value_type = TEntry;
+  using difference_type = std::ptrdiff_t;
+  using pointer = TEntry *;
+  using reference = TEntry &&;
+
+  MergedRunsIterator() = default;
+
+  explicit MergedRunsIterator(std::vector<std::vector<TEntry>> *runs) : runs_(runs) {
+    for (size_t i = 0; i < runs_->size(); ++i) {
+      if (!(*runs_)[i].empty()) heads_.emplace_back(i, 0);
+    }
+    std::make_heap(heads_.begin(), heads_.end(), Greater{runs_});
+  }
+
+  TEntry &&operator*() const {
+    const auto [run, pos] = heads_.front();
+    return std::move((*runs_)[run][pos]);
+  }
+
+  MergedRunsIterator &operator++() {
+    std::pop_heap(heads_.begin(), heads_.end(), Greater{runs_});
+    auto &[run, pos] = heads_.back();
+    if (++pos < (*runs_)[run].size()) {
+      std::push_heap(heads_.begin(), heads_.end(), Greater{runs_});
+    } else {
+      std::vector<TEntry>().swap((*runs_)[run]);
+      heads_.pop_back();
+    }
+    return *this;
+  }
+
+  bool operator==(const MergedRunsIterator &other) const { return heads_.empty() && other.heads_.empty(); }
+  bool operator!=(const MergedRunsIterator &other) const { return !(*this == other); }
+
+ private:
+  // The position of the first entry of a run that isn't merged yet.
+  using Head = std::pair<size_t, size_t>;
+
+  // Orders the heads so that the smallest entry is on the top of the heap.
+  struct Greater {
+    std::vector<std::vector<TEntry>> *runs;
+
+    bool operator()(const Head &lhs, const Head &rhs) const {
+      return (*runs)[rhs.first][rhs.second] < (*runs)[lhs.first][lhs.second];
+    }
+  };
+
+  std::vector<std::vector<TEntry>> *runs_{nullptr};
+  std::vector<Head> heads_;
+};
+
+/// Fills the empty index from the vertices using multiple threads. Each thread
+/// collects the entries of its chunk of vertices into a run which is then
+/// sorted, and the sorted runs are merged and bulk inserted into the index.
+/// The callback `collect(vertex, &run)` appends the entries of the vertex to
+/// the run.
+template <typename TEntry, typename TCallback>
+void FillIndexInParallel(utils::SkipList<TEntry> *index, utils::SkipList<Vertex>::Accessor &vertices,
+                         uint64_t num_threads, const TCallback &collect) {
+  std::vector<std::vector<TEntry>> runs(num_threads);
+  ForEachChunkInParallel(vertices, num_threads, [&runs, &collect](size_t chunk_index, const auto &chunk) {
+    auto &run = runs[chunk_index];
+    for (Vertex &vertex : chunk) {
+      collect(vertex, &run);
+    }
+    std::sort(run.begin(), run.end());
+  });
+  auto acc = index->access();
+  acc.bulk_insert(MergedRunsIterator<TEntry>(&runs), MergedRunsIterator<TEntry>());
+}
+
+}  // namespace
+
+void LabelIndex::UpdateOnAddLabel(LabelId label, Vertex *vertex, const Transaction &tx) {
+  auto it = index_.find(label);
+  if (it == index_.end()) return;
+  auto acc = it->second.access();
+  acc.insert(Entry{vertex, tx.start_timestamp});
+}
+
+bool LabelIndex::CreateIndex(LabelId label, utils::SkipList<Vertex>::Accessor vertices, uint64_t num_threads) {
+  utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+  auto [it, emplaced] = index_.emplace(std::piecewise_construct, std::forward_as_tuple(label), std::forward_as_tuple());
+  if (!emplaced) {
+    // Index already exists.
+    return false;
+  }
+  try {
+    if (num_threads > 1) {
+      FillIndexInParallel(&it->second, vertices, num_threads, [label](Vertex &vertex, std::vector<Entry> *run) {
+        if (vertex.deleted || !utils::Contains(vertex.labels, label)) {
+          return;
+        }
+        run->push_back(Entry{&vertex, 0});
+      });
+      return true;
+    }
+    auto acc = it->second.access();
+    for (Vertex &vertex : vertices) {
+      if (vertex.deleted || !utils::Contains(vertex.labels, label)) {
+        continue;
+      }
+      acc.insert(Entry{&vertex, 0});
+    }
+  } catch (const utils::OutOfMemoryException &) {
+    utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
+    index_.erase(it);
+    throw;
+  }
+  return true;
+}
+
+utils::SkipList<LabelIndex::Entry> *LabelIndex::RegisterIndex(LabelId label) {
+  auto [it, emplaced] = index_.emplace(std::piecewise_construct, std::forward_as_tuple(label), std::forward_as_tuple());
+  if (!emplaced) {
+    // Index already exists.
+    return nullptr;
+  }
+  unpublished_.insert(label);
+  return &it->second;
+}
+
+void LabelIndex::PopulateIndex(utils::SkipList<Entry> *index, LabelId label,
+                               utils::SkipList<Vertex>::Accessor vertices, uint64_t start_timestamp,
+                               uint64_t num_threads) {
+  // The writers insert into the index concurrently so the entries are
+  // inserted one by one instead of being bulk inserted.
+  auto populate_chunk = [index, label, start_timestamp](size_t /*chunk_index*/, const auto &chunk) {
+    auto acc = index->access();
+    for (Vertex &vertex : chunk) {
+      if (AnyVersionHasLabel(vertex, label, start_timestamp)) {
+        acc.insert(Entry{&vertex, 0});
+      }
+    }
+  };
+  ForEachChunkInParallel(vertices, num_threads, populate_chunk);
+}
+
+std::vector<LabelId> LabelIndex::ListIndices() const {
+  std::vector<LabelId> ret;
+  ret.reserve(index_.size());
+  for (const auto &item : index_) {
+    if (unpublished_.contains(item.first)) continue;
+    ret.push_back(item.first);
+  }
+  return ret;
+}
+
+void LabelIndex::CollectCleanupTasks(uint64_t oldest_active_start_timestamp,
+                                     std::vector<std::function<void()>> *tasks) {
+  for (auto &[label, storage] : index_) {
+    tasks->emplace_back([label = label, storage = &storage, oldest_active_start_timestamp] {
+      auto vertices_acc = storage->access();
+      for (auto it = vertices_acc.begin(); it != vertices_acc.end();) {
+        auto next_it = it;
+        ++next_it;
+
+        if (it->timestamp >= oldest_active_start_timestamp) {
+          it = next_it;
+          continue;
+        }
+
+        if ((next_it != vertices_acc.end() && it->vertex == next_it->vertex) ||
+            !AnyVersionHasLabel(*it->vertex, label, oldest_active_start_timestamp)) {
+          vertices_acc.remove(*it);
+        }
+
+        it = next_it;
+      }
+    });
+  }
+}
+
+LabelIndex::Iterable::Iterator::Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator)
+    : self_(self),
+      index_iterator_(index_iterator),
+      current_vertex_accessor_(nullptr, nullptr, nullptr, nullptr, self_->config_),
+      current_vertex_(nullptr) {
+  AdvanceUntilValid();
+}
+
+LabelIndex::Iterable::Iterator &LabelIndex::Iterable::Iterator::operator++() {
+  ++index_iterator_;
+  AdvanceUntilValid();
+  return *this;
+}
+
+void LabelIndex::Iterable::Iterator::AdvanceUntilValid() {
+  for (; index_iterator_ != self_->index_accessor_.end(); ++index_iterator_) {
+    if (index_iterator_->vertex == current_vertex_) {
+      continue;
+    }
+    if (CurrentVersionHasLabel(*index_iterator_->vertex, self_->label_, self_->transaction_, self_->view_)) {
+      current_vertex_ = index_iterator_->vertex;
+      current_vertex_accessor_ =
+          VertexAccessor{current_vertex_, self_->transaction_, self_->indices_, self_->constraints_, self_->config_};
+      break;
+    }
+  }
+}
+
+LabelIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label, View view,
+                               Transaction *transaction, Indices *indices, Constraints *constraints,
+                               Config::Items config)
+    : index_accessor_(std::move(index_accessor)),
+      label_(label),
+      view_(view),
+      transaction_(transaction),
+      indices_(indices),
+      constraints_(constraints),
+      config_(config) {}
+
+LabelIndex::Chunks::Chunks(utils::SkipList<Entry>::Accessor index_accessor, uint64_t num_chunks, LabelId label,
+                           View view, Transaction *transaction, Indices *indices, Constraints *constraints,
+                           Config::Items config)
+    : index_accessor_(std::move(index_accessor)),
+      chunks_(index_accessor_.chunks(num_chunks)),
+      end_vertices_(chunks_.size(), nullptr),
+      label_(label),
+      view_(view),
+      transaction_(transaction),
+      indices_(indices),
+      constraints_(constraints),
+      config_(config) {
+  for (size_t i = chunks_.size() - 1; i > 0; --i) {
+    auto first = chunks_[i].begin();
+    end_vertices_[i - 1] = first != chunks_[i].end() ? first->vertex : end_vertices_[i];
+  }
+}
+
+std::optional<VertexAccessor> LabelIndex::Chunks::Scanner::Next() {
+  for (; it_ != end_; ++it_) {
+    if (end_vertex_ && !std::less<>()(it_->vertex, end_vertex_)) {
+      // The vertex is scanned by one of the following chunks.
+      it_ = end_;
+      break;
+    }
+    if (it_->vertex == current_vertex_) continue;
+    if (CurrentVersionHasLabel(*it_->vertex, self_->label_, self_->transaction_, self_->view_)) {
+      current_vertex_ = it_->vertex;
+      ++it_;
+      return VertexAccessor{current_vertex_, self_->transaction_, self_->indices_, self_->constraints_,
+                            self_->config_};
+    }
+  }
+  return std::nullopt;
+}
+
+void LabelIndex::RunGC() {
+  for (auto &index_entry : index_) {
+    index_entry.second.run_gc();
+  }
+}
+
+bool LabelPropertyIndex::Entry::operator<(const Entry &rhs) {
+  if (value < rhs.value) {
+    return true;
+  }
+  if (rhs.value < value) {
+    return false;
+  }
+  return std::make_tuple(vertex, timestamp) < std::make_tuple(rhs.vertex, rhs.timestamp);
+}
+
+bool LabelPropertyIndex::Entry::operator==(const Entry &rhs) {
+  return value == rhs.value && vertex == rhs.vertex && timestamp == rhs.timestamp;
+}
+
+bool LabelPropertyIndex::Entry::operator<(const PropertyValue &rhs) { return value < rhs; }
+
+bool LabelPropertyIndex::Entry::operator==(const PropertyValue &rhs) { return value == rhs; }
+
+void LabelPropertyIndex::UpdateOnAddLabel(LabelId label, Vertex *vertex, const Transaction &tx) {
+  for (auto &[label_prop, storage] : index_) {
+    if (label_prop.first != label) {
+      continue;
+    }
+    auto prop_value = vertex->properties.GetProperty(label_prop.second);
+    if (!prop_value.IsNull()) {
+      auto acc = storage.access();
+      acc.insert(Entry{std::move(prop_value), vertex, tx.start_timestamp});
+    }
+  }
+}
+
+void LabelPropertyIndex::UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex,
+                                             const Transaction &tx) {
+  if (value.IsNull()) {
+    return;
+  }
+  for (auto &[label_prop, storage] : index_) {
+    if (label_prop.second != property) {
+      continue;
+    }
+    if (utils::Contains(vertex->labels, label_prop.first)) {
+      auto acc = storage.access();
+      acc.insert(Entry{value, vertex, tx.start_timestamp});
+    }
+  }
+}
+
+bool LabelPropertyIndex::CreateIndex(LabelId label, PropertyId property, utils::SkipList<Vertex>::Accessor vertices,
+                                     uint64_t num_threads) {
+  utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+  auto [it, emplaced] =
+      index_.emplace(std::piecewise_construct, std::forward_as_tuple(label, property), std::forward_as_tuple());
+  if (!emplaced) {
+    // Index already exists.
+    return false;
+  }
+  try {
+    if (num_threads > 1) {
+      FillIndexInParallel(&it->second, vertices, num_threads,
+                          [label, property](Vertex &vertex, std::vector<Entry> *run) {
+                            if (vertex.deleted || !utils::Contains(vertex.labels, label)) {
+                              return;
+                            }
+                            auto value = vertex.properties.GetProperty(property);
+                            if (value.IsNull()) {
+                              return;
+                            }
+                            run->push_back(Entry{std::move(value), &vertex, 0});
+                          });
+      return true;
+    }
+    auto acc = it->second.access();
+    for (Vertex &vertex : vertices) {
+      if (vertex.deleted || !utils::Contains(vertex.labels, label)) {
+        continue;
+      }
+      auto value = vertex.properties.GetProperty(property);
+      if (value.IsNull()) {
+        continue;
+      }
+      acc.insert(Entry{std::move(value), &vertex, 0});
+    }
+  } catch (const utils::OutOfMemoryException &) {
+    utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
+    index_.erase(it);
+    throw;
+  }
+  return true;
+}
+
+utils::SkipList<LabelPropertyIndex::Entry> *LabelPropertyIndex::RegisterIndex(LabelId label, PropertyId property) {
+  auto [it, emplaced] =
+      index_.emplace(std::piecewise_construct, std::forward_as_tuple(label, property), std::forward_as_tuple());
+  if (!emplaced) {
+    // Index already exists.
+    return nullptr;
+  }
+  unpublished_.emplace(label, property);
+  return &it->second;
+}
+
+void LabelPropertyIndex::PopulateIndex(utils::SkipList<Entry> *index, LabelId label, PropertyId property,
+                                       utils::SkipList<Vertex>::Accessor vertices, uint64_t start_timestamp,
+                                       uint64_t num_threads) {
+  // The writers insert into the index concurrently so the entries are
+  // inserted one by one instead of being bulk inserted.
+  auto populate_chunk = [index, label, property, start_timestamp](size_t /*chunk_index*/, const auto &chunk) {
+    auto acc = index->access();
+    for (Vertex &vertex : chunk) {
+      if (!AnyVersionHasLabel(vertex, label, start_timestamp)) {
+        continue;
+      }
+      ForEachNewerPropertyValue(vertex, property, start_timestamp, [&acc, &vertex](PropertyValue value) {
+        if (!value.IsNull()) {
+          acc.insert(Entry{std::move(value), &vertex, 0});
+        }
+      });
+    }
+  };
+  ForEachChunkInParallel(vertices, num_threads, populate_chunk);
+}
+
+std::vector<std::pair<LabelId, PropertyId>> LabelPropertyIndex::ListIndices() const {
+  std::vector<std::pair<LabelId, PropertyId>> ret;
+  ret.reserve(index_.size());
+  for (const auto &item : index_) {
+    if (unpublished_.contains(item.first)) continue;
+    ret.push_back(item.first);
+  }
+  return ret;
+}
+
+void LabelPropertyIndex::CollectCleanupTasks(uint64_t oldest_active_start_timestamp,
+                                             std::vector<std::function<void()>> *tasks) {
+  for (auto &[label_property, index] : index_) {
+    tasks->emplace_back([label_property = label_property, index = &index, oldest_active_start_timestamp] {
+      auto index_acc = index->access();
+      for (auto it = index_acc.begin(); it != index_acc.end();) {
+        auto next_it = it;
+        ++next_it;
+
+        if (it->timestamp >= oldest_active_start_timestamp) {
+          it = next_it;
+          continue;
+        }
+
+        if ((next_it != index_acc.end() && it->vertex == next_it->vertex && it->value == next_it->value) ||
+            !AnyVersionHasLabelProperty(*it->vertex, label_property.first, label_property.second, it->value,
+                                        oldest_active_start_timestamp)) {
+          index_acc.remove(*it);
+        }
+        it = next_it;
+      }
+    });
+  }
+}
+
+LabelPropertyIndex::Iterable::Iterator::Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator)
+    : self_(self),
+      index_iterator_(index_iterator),
+      current_vertex_accessor_(nullptr, nullptr, nullptr, nullptr, self_->config_),
+      current_vertex_(nullptr) {
+  AdvanceUntilValid();
+}
+
+LabelPropertyIndex::Iterable::Iterator &LabelPropertyIndex::Iterable::Iterator::operator++() {
+  ++index_iterator_;
+  AdvanceUntilValid();
+  return *this;
+}
+
+void LabelPropertyIndex::Iterable::Iterator::AdvanceUntilValid() {
+  for (; index_iterator_ != self_->index_accessor_.end(); ++index_iterator_) {
+    if (index_iterator_->vertex == current_vertex_) {
+      continue;
+    }
+
+    if (self_->lower_bound_) {
+      if (index_iterator_->value < self_->lower_bound_->value()) {
+        continue;
+      }
+      if (!self_->lower_bound_->IsInclusive() && index_iterator_->value == self_->lower_bound_->value()) {
+        continue;
+      }
+    }
+    if (self_->upper_bound_) {
+      if (self_->upper_bound_->value() < index_iterator_->value) {
+        index_iterator_ = self_->index_accessor_.end();
+        break;
+      }
+      if (!self_->upper_bound_->IsInclusive() && index_iterator_->value == self_->upper_bound_->value()) {
+        index_iterator_ = self_->index_accessor_.end();
+        break;
+      }
+    }
+
+    if (CurrentVersionHasLabelProperty(*index_iterator_->vertex, self_->label_, self_->property_,
+                                       index_iterator_->value, self_->transaction_, self_->view_)) {
+      current_vertex_ = index_iterator_->vertex;
+      current_vertex_accessor_ =
+          VertexAccessor(current_vertex_, self_->transaction_, self_->indices_, self_->constraints_, self_->config_);
+      break;
+    }
+  }
+}
+
+// These constants represent the smallest possible value of each type that is
+// contained in a `PropertyValue`. Note that numbers (integers and doubles) are
+// treated as the same "type" in `PropertyValue`.
+const PropertyValue kSmallestBool = PropertyValue(false);
+static_assert(-std::numeric_limits<double>::infinity() < std::numeric_limits<int64_t>::min());
+const PropertyValue kSmallestNumber = PropertyValue(-std::numeric_limits<double>::infinity());
+const PropertyValue kSmallestString = PropertyValue("");
+const PropertyValue kSmallestList = PropertyValue(std::vector<PropertyValue>());
+const PropertyValue kSmallestMap = PropertyValue(std::map<std::string, PropertyValue>());
+const PropertyValue kSmallestTemporalData =
+    PropertyValue(TemporalData{static_cast<TemporalType>(0), std::numeric_limits<int64_t>::min()});
+
+namespace {
+
+// Fixes the bounds that the user provided so that only values of the type of
+// the bounds are yielded from the index. Returns `false` if the bounds are of
+// types that aren't comparable, in which case no values should be yielded.
+bool SetMissingBounds(std::optional<utils::Bound<PropertyValue>> *lower_bound,
+                      std::optional<utils::Bound<PropertyValue>> *upper_bound) {
+  // We have to fix the bounds that the user provided to us. If the user
+  // provided only one bound we should make sure that only values of that type
+  // are returned by the iterator. We ensure this by supplying either an
+  // inclusive lower bound of the same type, or an exclusive upper bound of the
+  // following type. If neither bound is set we yield all items in the index.
+
+  // First we statically verify that our assumptions about the `PropertyValue`
+  // type ordering holds.
+  static_assert(PropertyValue::Type::Bool < PropertyValue::Type::Int);
+  static_assert(PropertyValue::Type::Int < PropertyValue::Type::Double);
+  static_assert(PropertyValue::Type::Double < PropertyValue::Type::String);
+  static_assert(PropertyValue::Type::String < PropertyValue::Type::List);
+  static_assert(PropertyValue::Type::List < PropertyValue::Type::Map);
+
+  // Remove any bounds that are set to `Null` because that isn't a valid value.
+  if (*lower_bound && (*lower_bound)->value().IsNull()) {
+    *lower_bound = std::nullopt;
+  }
+  if (*upper_bound && (*upper_bound)->value().IsNull()) {
+    *upper_bound = std::nullopt;
+  }
+
+  // Check whether the bounds are of comparable types if both are supplied.
+  if (*lower_bound && *upper_bound &&
+      !PropertyValue::AreComparableTypes((*lower_bound)->value().type(), (*upper_bound)->value().type())) {
+    return false;
+  }
+
+  // Set missing bounds.
+  if (*lower_bound && !*upper_bound) {
+    // Here we need to supply an upper bound. The upper bound is set to an
+    // exclusive lower bound of the following type.
+    switch ((*lower_bound)->value().type()) {
+      case PropertyValue::Type::Null:
+        // This shouldn't happen because of the nullopt-ing above.
+        LOG_FATAL("Invalid database state!");
+        break;
+      case PropertyValue::Type::Bool:
+        *upper_bound = utils::MakeBoundExclusive(kSmallestNumber);
+        break;
+      case PropertyValue::Type::Int:
+      case PropertyValue::Type::Double:
+        // Both integers and doubles are treated as the same type in
+        // `PropertyValue` and they are interleaved when sorted.
+        *upper_bound = utils::MakeBoundExclusive(kSmallestString);
+        break;
+      case PropertyValue::Type::String:
+        *upper_bound = utils::MakeBoundExclusive(kSmallestList);
+        break;
+      case PropertyValue::Type::List:
+        *upper_bound = utils::MakeBoundExclusive(kSmallestMap);
+        break;
+      case PropertyValue::Type::Map:
+        *upper_bound = utils::MakeBoundExclusive(kSmallestTemporalData);
+        break;
+      case PropertyValue::Type::TemporalData:
+        // This is the last type in the order so we leave the upper bound empty.
+        break;
+    }
+  }
+  if (*upper_bound && !*lower_bound) {
+    // Here we need to supply a lower bound. The lower bound is set to an
+    // inclusive lower bound of the current type.
+    switch ((*upper_bound)->value().type()) {
+      case PropertyValue::Type::Null:
+        // This shouldn't happen because of the nullopt-ing above.
+        LOG_FATAL("Invalid database state!");
+        break;
+      case PropertyValue::Type::Bool:
+        *lower_bound = utils::MakeBoundInclusive(kSmallestBool);
+        break;
+      case PropertyValue::Type::Int:
+      case PropertyValue::Type::Double:
+        // Both integers and doubles are treated as the same type in
+        // `PropertyValue` and they are interleaved when sorted.
+        *lower_bound = utils::MakeBoundInclusive(kSmallestNumber);
+        break;
+      case PropertyValue::Type::String:
+        *lower_bound = utils::MakeBoundInclusive(kSmallestString);
+        break;
+      case PropertyValue::Type::List:
+        *lower_bound = utils::MakeBoundInclusive(kSmallestList);
+        break;
+      case PropertyValue::Type::Map:
+        *lower_bound = utils::MakeBoundInclusive(kSmallestMap);
+        break;
+      case PropertyValue::Type::TemporalData:
+        *lower_bound = utils::MakeBoundInclusive(kSmallestTemporalData);
+        break;
+    }
+  }
+  return true;
+}
+
 }  // namespace
 
-void LabelIndex::UpdateOnAddLabel(LabelId label, Vertex *vertex, const Transaction &tx) {
-  auto it = index_.find(label);
+LabelPropertyIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label,
+                                       PropertyId property,
+                                       const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+                                       const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view,
+                                       Transaction *transaction, Indices *indices, Constraints *constraints,
+                                       Config::Items config)
+    : index_accessor_(std::move(index_accessor)),
+      label_(label),
+      property_(property),
+      lower_bound_(lower_bound),
+      upper_bound_(upper_bound),
+      view_(view),
+      transaction_(transaction),
+      indices_(indices),
+      constraints_(constraints),
+      config_(config) {
+  bounds_valid_ = SetMissingBounds(&lower_bound_, &upper_bound_);
+}
+
+LabelPropertyIndex::Iterable::Iterator LabelPropertyIndex::Iterable::begin() {
+  // If the bounds are set and don't have comparable types we don't yield any
+  // items from the index.
+  if (!bounds_valid_) return Iterator(this, index_accessor_.end());
+  auto index_iterator = index_accessor_.begin();
+  if (lower_bound_) {
+    index_iterator = index_accessor_.find_equal_or_greater(lower_bound_->value());
+  }
+  return Iterator(this, index_iterator);
+}
+
+LabelPropertyIndex::Iterable::Iterator LabelPropertyIndex::Iterable::end() {
+  return Iterator(this, index_accessor_.end());
+}
+
+int64_t LabelPropertyIndex::ApproximateVertexCount(LabelId label, PropertyId property,
+                                                   const PropertyValue &value) const {
+  auto it = index_.find({label, property});
+  MG_ASSERT(it != index_.end(), "Index for label {} and property {} doesn't exist", label.AsUint(), property.AsUint());
+  auto acc = it->second.access();
+  if (!value.IsNull()) {
+    return acc.estimate_count(value, utils::SkipListLayerForCountEstimation(acc.size()));
+  } else {
+    // The value `Null` won't ever appear in the index because it indicates that
+    // the property shouldn't exist. Instead, this value is used as an indicator
+    // to estimate the average number of equal elements in the list (for any
+    // given value).
+    return acc.estimate_average_number_of_equals(
+        [](const auto &first, const auto &second) { return first.value == second.value; },
+        utils::SkipListLayerForAverageEqualsEstimation(acc.size()));
+  }
+}
+
+int64_t LabelPropertyIndex::ApproximateVertexCount(LabelId label, PropertyId property,
+                                                   const std::optional<utils::Bound<PropertyValue>> &lower,
+                                                   const std::optional<utils::Bound<PropertyValue>> &upper) const {
+  auto it = index_.find({label, property});
+  MG_ASSERT(it != index_.end(), "Index for label {} and property {} doesn't exist", label.AsUint(), property.AsUint());
+  auto acc = it->second.access();
+  return acc.estimate_range_count(lower, upper, utils::SkipListLayerForCountEstimation(acc.size()));
+}
+
+void LabelPropertyIndex::RunGC() {
+  for (auto &index_entry : index_) {
+    index_entry.second.run_gc();
+  }
+}
+
+bool LabelPropertyCompositeIndex::Entry::operator<(const Entry &rhs) {
+  if (values < rhs.values) {
+    return true;
+  }
+  if (rhs.values < values) {
+    return false;
+  }
+  return std::make_tuple(vertex, timestamp) < std::make_tuple(rhs.vertex, rhs.timestamp);
+}
+
+bool LabelPropertyCompositeIndex::Entry::operator==(const Entry &rhs) {
+  return values == rhs.values && vertex == rhs.vertex && timestamp == rhs.timestamp;
+}
+
+bool LabelPropertyCompositeIndex::Entry::operator<(const std::vector<PropertyValue> &rhs) {
+  DMG_ASSERT(rhs.size() <= values.size(), "The prefix is longer than the indexed values!");
+  return std::lexicographical_compare(values.begin(), values.begin() + rhs.size(), rhs.begin(), rhs.end());
+}
+
+bool LabelPropertyCompositeIndex::Entry::operator==(const std::vector<PropertyValue> &rhs) {
+  DMG_ASSERT(rhs.size() <= values.size(), "The prefix is longer than the indexed values!");
+  return std::equal(rhs.begin(), rhs.end(), values.begin());
+}
+
+void LabelPropertyCompositeIndex::UpdateOnAddLabel(LabelId label, Vertex *vertex, const Transaction &tx) {
+  for (auto &[label_properties, storage] : index_) {
+    if (label_properties.first != label) {
+      continue;
+    }
+    auto values = GetPropertyValues(*vertex, label_properties.second);
+    if (values) {
+      auto acc = storage.access();
+      acc.insert(Entry{std::move(*values), vertex, tx.start_timestamp});
+    }
+  }
+}
+
+void LabelPropertyCompositeIndex::UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex,
+                                                      const Transaction &tx) {
+  if (value.IsNull()) {
+    return;
+  }
+  for (auto &[label_properties, storage] : index_) {
+    if (!utils::Contains(label_properties.second, property) ||
+        !utils::Contains(vertex->labels, label_properties.first)) {
+      continue;
+    }
+    // The vertex already holds the new value of the property.
+    auto values = GetPropertyValues(*vertex, label_properties.second);
+    if (values) {
+      auto acc = storage.access();
+      acc.insert(Entry{std::move(*values), vertex, tx.start_timestamp});
+    }
+  }
+}
+
+bool LabelPropertyCompositeIndex::CreateIndex(LabelId label, const std::vector<PropertyId> &properties,
+                                              utils::SkipList<Vertex>::Accessor vertices, uint64_t num_threads) {
+  utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+  auto [it, emplaced] =
+      index_.emplace(std::piecewise_construct, std::forward_as_tuple(label, properties), std::forward_as_tuple());
+  if (!emplaced) {
+    // Index already exists.
+    return false;
+  }
+  try {
+    if (num_threads > 1) {
+      FillIndexInParallel(&it->second, vertices, num_threads,
+                          [label, &properties](Vertex &vertex, std::vector<Entry> *run) {
+                            if (vertex.deleted || !utils::Contains(vertex.labels, label)) {
+                              return;
+                            }
+                            auto values = GetPropertyValues(vertex, properties);
+                            if (!values) {
+                              return;
+                            }
+                            run->push_back(Entry{std::move(*values), &vertex, 0});
+                          });
+      return true;
+    }
+    auto acc = it->second.access();
+    for (Vertex &vertex : vertices) {
+      if (vertex.deleted || !utils::Contains(vertex.labels, label)) {
+        continue;
+      }
+      auto values = GetPropertyValues(vertex, properties);
+      if (!values) {
+        continue;
+      }
+      acc.insert(Entry{std::move(*values), &vertex, 0});
+    }
+  } catch (const utils::OutOfMemoryException &) {
+    utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
+    index_.erase(it);
+    throw;
+  }
+  return true;
+}
+
+std::vector<std::pair<LabelId, std::vector<PropertyId>>> LabelPropertyCompositeIndex::ListIndices() const {
+  std::vector<std::pair<LabelId, std::vector<PropertyId>>> ret;
+  ret.reserve(index_.size());
+  for (const auto &item : index_) {
+    ret.push_back(item.first);
+  }
+  return ret;
+}
+
+std::vector<std::vector<PropertyId>> LabelPropertyCompositeIndex::ListIndices(LabelId label) const {
+  std::vector<std::vector<PropertyId>> ret;
+  for (const auto &item : index_) {
+    if (item.first.first == label) ret.push_back(item.first.second);
+  }
+  return ret;
+}
+
+void LabelPropertyCompositeIndex::CollectCleanupTasks(uint64_t oldest_active_start_timestamp,
+                                                      std::vector<std::function<void()>> *tasks) {
+  for (auto &[label_properties, index] : index_) {
+    tasks->emplace_back([label_properties = &label_properties, index = &index, oldest_active_start_timestamp] {
+      auto index_acc = index->access();
+      for (auto it = index_acc.begin(); it != index_acc.end();) {
+        auto next_it = it;
+        ++next_it;
+
+        if (it->timestamp >= oldest_active_start_timestamp) {
+          it = next_it;
+          continue;
+        }
+
+        if ((next_it != index_acc.end() && it->vertex == next_it->vertex && it->values == next_it->values) ||
+            !AnyVersionHasLabelProperties(*it->vertex, label_properties->first, label_properties->second, it->values,
+                                          oldest_active_start_timestamp)) {
+          index_acc.remove(*it);
+        }
+        it = next_it;
+      }
+    });
+  }
+}
+
+LabelPropertyCompositeIndex::Iterable::Iterator::Iterator(Iterable *self,
+                                                          utils::SkipList<Entry>::Iterator index_iterator)
+    : self_(self),
+      index_iterator_(index_iterator),
+      current_vertex_accessor_(nullptr, nullptr, nullptr, nullptr, self_->config_),
+      current_vertex_(nullptr) {
+  AdvanceUntilValid();
+}
+
+LabelPropertyCompositeIndex::Iterable::Iterator &LabelPropertyCompositeIndex::Iterable::Iterator::operator++() {
+  ++index_iterator_;
+  AdvanceUntilValid();
+  return *this;
+}
+
+void LabelPropertyCompositeIndex::Iterable::Iterator::AdvanceUntilValid() {
+  for (; index_iterator_ != self_->index_accessor_.end(); ++index_iterator_) {
+    if (index_iterator_->vertex == current_vertex_) {
+      continue;
+    }
+
+    // The entries are sorted so all entries with the prefix are next to each
+    // other.
+    if (!(*index_iterator_ == self_->prefix_)) {
+      index_iterator_ = self_->index_accessor_.end();
+      break;
+    }
+    if (self_->lower_bound_ || self_->upper_bound_) {
+      const auto &value = index_iterator_->values[self_->prefix_.size()];
+      if (self_->lower_bound_) {
+        if (value < self_->lower_bound_->value()) {
+          continue;
+        }
+        if (!self_->lower_bound_->IsInclusive() && value == self_->lower_bound_->value()) {
+          continue;
+        }
+      }
+      if (self_->upper_bound_) {
+        if (self_->upper_bound_->value() < value) {
+          index_iterator_ = self_->index_accessor_.end();
+          break;
+        }
+        if (!self_->upper_bound_->IsInclusive() && value == self_->upper_bound_->value()) {
+          index_iterator_ = self_->index_accessor_.end();
+          break;
+        }
+      }
+    }
+
+    if (CurrentVersionHasLabelProperties(*index_iterator_->vertex, self_->label_, self_->properties_,
+                                         index_iterator_->values, self_->transaction_, self_->view_)) {
+      current_vertex_ = index_iterator_->vertex;
+      current_vertex_accessor_ =
+          VertexAccessor(current_vertex_, self_->transaction_, self_->indices_, self_->constraints_, self_->config_);
+      break;
+    }
+  }
+}
+
+LabelPropertyCompositeIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label,
+                                                const std::vector<PropertyId> &properties,
+                                                const std::vector<PropertyValue> &prefix,
+                                                const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+                                                const std::optional<utils::Bound<PropertyValue>> &upper_bound,
+                                                View view, Transaction *transaction, Indices *indices,
+                                                Constraints *constraints, Config::Items config)
+    : index_accessor_(std::move(index_accessor)),
+      label_(label),
+      properties_(properties),
+      prefix_(prefix),
+      lower_bound_(lower_bound),
+      upper_bound_(upper_bound),
+      view_(view),
+      transaction_(transaction),
+      indices_(indices),
+      constraints_(constraints),
+      config_(config) {
+  MG_ASSERT(prefix_.size() <= properties_.size(), "The prefix is longer than the indexed properties!");
+  MG_ASSERT(prefix_.size() < properties_.size() || (!lower_bound_ && !upper_bound_),
+            "The bounds can't be used when the prefix covers all indexed properties!");
+  // `Null` is never stored in the index, and it isn't equal to any value.
+  if (std::any_of(prefix_.begin(), prefix_.end(), [](const auto &value) { return value.IsNull(); })) {
+    bounds_valid_ = false;
+    return;
+  }
+  bounds_valid_ = SetMissingBounds(&lower_bound_, &upper_bound_);
+}
+
+LabelPropertyCompositeIndex::Iterable::Iterator LabelPropertyCompositeIndex::Iterable::begin() {
+  if (!bounds_valid_) return Iterator(this, index_accessor_.end());
+  auto key = prefix_;
+  if (lower_bound_) {
+    key.push_back(lower_bound_->value());
+  }
+  if (key.empty()) return Iterator(this, index_accessor_.begin());
+  return Iterator(this, index_accessor_.find_equal_or_greater(key));
+}
+
+LabelPropertyCompositeIndex::Iterable::Iterator LabelPropertyCompositeIndex::Iterable::end() {
+  return Iterator(this, index_accessor_.end());
+}
+
+int64_t LabelPropertyCompositeIndex::ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties,
+                                                            const std::vector<PropertyValue> &prefix) const {
+  auto it = index_.find({label, properties});
+  MG_ASSERT(it != index_.end(), "Composite index for label {} doesn't exist", label.AsUint());
+  auto acc = it->second.access();
+  if (prefix.empty()) return acc.size();
+  return acc.estimate_count(prefix, utils::SkipListLayerForCountEstimation(acc.size()));
+}
+
+int64_t LabelPropertyCompositeIndex::ApproximateVertexCount(
+    LabelId label, const std::vector<PropertyId> &properties, const std::vector<PropertyValue> &prefix,
+    const std::optional<utils::Bound<PropertyValue>> &lower,
+    const std::optional<utils::Bound<PropertyValue>> &upper) const {
+  auto it = index_.find({label, properties});
+  MG_ASSERT(it != index_.end(), "Composite index for label {} doesn't exist", label.AsUint());
+  auto acc = it->second.access();
+  // The bounds are extended with the prefix. A missing bound is replaced with
+  // the prefix itself so that only the entries with the prefix are counted.
+  auto make_key_bound = [&prefix](const std::optional<utils::Bound<PropertyValue>> &bound)
+      -> std::optional<utils::Bound<std::vector<PropertyValue>>> {
+    if (!bound) {
+      if (prefix.empty()) return std::nullopt;
+      return utils::MakeBoundInclusive(prefix);
+    }
+    auto key = prefix;
+    key.push_back(bound->value());
+    return utils::Bound<std::vector<PropertyValue>>(std::move(key), bound->type());
+  };
+  return acc.estimate_range_count(make_key_bound(lower), make_key_bound(upper),
+                                  utils::SkipListLayerForCountEstimation(acc.size()));
+}
+
+void LabelPropertyCompositeIndex::RunGC() {
+  for (auto &index_entry : index_) {
+    index_entry.second.run_gc();
+  }
+}
+
+void EdgeTypeIndex::UpdateOnEdgeCreation(Vertex *from_vertex, Vertex *to_vertex, EdgeRef edge, EdgeTypeId edge_type,
+                                         const Transaction &tx) {
+  auto it = index_.find(edge_type);
   if (it == index_.end()) return;
   auto acc = it->second.access();
-  acc.insert(Entry{vertex, tx.start_timestamp});
+  acc.insert(Entry{from_vertex, to_vertex, edge, tx.start_timestamp});
 }
 
-bool LabelIndex::CreateIndex(LabelId label, utils::SkipList<Vertex>::Accessor vertices) {
+bool EdgeTypeIndex::CreateIndex(EdgeTypeId edge_type, utils::SkipList<Vertex>::Accessor vertices) {
   utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
-  auto [it, emplaced] = index_.emplace(std::piecewise_construct, std::forward_as_tuple(label), std::forward_as_tuple());
+  auto [it, emplaced] =
+      index_.emplace(std::piecewise_construct, std::forward_as_tuple(edge_type), std::forward_as_tuple());
   if (!emplaced) {
     // Index already exists.
     return false;
@@ -280,10 +1539,12 @@ bool LabelIndex::CreateIndex(LabelId label, utils::SkipList<Vertex>::Accessor ve
   try {
     auto acc = it->second.access();
     for (Vertex &vertex : vertices) {
-      if (vertex.deleted || !utils::Contains(vertex.labels, label)) {
+      if (vertex.deleted) {
         continue;
       }
-      acc.insert(Entry{&vertex, 0});
+      for (const auto &[type, to_vertex, edge] : vertex.out_edges.EdgesOfType(edge_type)) {
+        acc.insert(Entry{&vertex, to_vertex, edge, 0});
+      }
     }
   } catch (const utils::OutOfMemoryException &) {
     utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
@@ -293,8 +1554,8 @@ bool LabelIndex::CreateIndex(LabelId label, utils::SkipList<Vertex>::Accessor ve
   return true;
 }
 
-std::vector<LabelId> LabelIndex::ListIndices() const {
-  std::vector<LabelId> ret;
+std::vector<EdgeTypeId> EdgeTypeIndex::ListIndices() const {
+  std::vector<EdgeTypeId> ret;
   ret.reserve(index_.size());
   for (const auto &item : index_) {
     ret.push_back(item.first);
@@ -302,124 +1563,116 @@ std::vector<LabelId> LabelIndex::ListIndices() const {
   return ret;
 }
 
-void LabelIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) {
-  for (auto &label_storage : index_) {
-    auto vertices_acc = label_storage.second.access();
-    for (auto it = vertices_acc.begin(); it != vertices_acc.end();) {
-      auto next_it = it;
-      ++next_it;
+void EdgeTypeIndex::CollectCleanupTasks(uint64_t oldest_active_start_timestamp,
+                                        std::vector<std::function<void()>> *tasks) {
+  for (auto &[edge_type, index] : index_) {
+    tasks->emplace_back([edge_type = edge_type, index = &index, oldest_active_start_timestamp] {
+      auto index_acc = index->access();
+      for (auto it = index_acc.begin(); it != index_acc.end();) {
+        auto next_it = it;
+        ++next_it;
 
-      if (it->timestamp >= oldest_active_start_timestamp) {
-        it = next_it;
-        continue;
-      }
+        if (it->timestamp >= oldest_active_start_timestamp) {
+          it = next_it;
+          continue;
+        }
 
-      if ((next_it != vertices_acc.end() && it->vertex == next_it->vertex) ||
-          !AnyVersionHasLabel(*it->vertex, label_storage.first, oldest_active_start_timestamp)) {
-        vertices_acc.remove(*it);
-      }
+        if ((next_it != index_acc.end() && it->from_vertex == next_it->from_vertex && it->edge == next_it->edge) ||
+            !AnyVersionHasEdge(*it->from_vertex, edge_type, it->to_vertex, it->edge, oldest_active_start_timestamp)) {
+          index_acc.remove(*it);
+        }
 
-      it = next_it;
-    }
+        it = next_it;
+      }
+    });
   }
 }
 
-LabelIndex::Iterable::Iterator::Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator)
+EdgeTypeIndex::Iterable::Iterator::Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator)
     : self_(self),
       index_iterator_(index_iterator),
-      current_vertex_accessor_(nullptr, nullptr, nullptr, nullptr, self_->config_),
-      current_vertex_(nullptr) {
+      current_edge_accessor_(EdgeRef(nullptr), EdgeTypeId(), nullptr, nullptr, nullptr, nullptr, nullptr,
+                             self_->config_) {
   AdvanceUntilValid();
 }
 
-LabelIndex::Iterable::Iterator &LabelIndex::Iterable::Iterator::operator++() {
+EdgeTypeIndex::Iterable::Iterator &EdgeTypeIndex::Iterable::Iterator::operator++() {
   ++index_iterator_;
   AdvanceUntilValid();
   return *this;
 }
 
-void LabelIndex::Iterable::Iterator::AdvanceUntilValid() {
+void EdgeTypeIndex::Iterable::Iterator::AdvanceUntilValid() {
   for (; index_iterator_ != self_->index_accessor_.end(); ++index_iterator_) {
-    if (index_iterator_->vertex == current_vertex_) {
+    if (current_edge_ && index_iterator_->edge == *current_edge_) {
       continue;
     }
-    if (CurrentVersionHasLabel(*index_iterator_->vertex, self_->label_, self_->transaction_, self_->view_)) {
-      current_vertex_ = index_iterator_->vertex;
-      current_vertex_accessor_ =
-          VertexAccessor{current_vertex_, self_->transaction_, self_->indices_, self_->constraints_, self_->config_};
+    if (CurrentVersionHasEdge(*index_iterator_->from_vertex, self_->edge_type_, index_iterator_->to_vertex,
+                              index_iterator_->edge, self_->transaction_, self_->view_)) {
+      current_edge_ = index_iterator_->edge;
+      current_edge_accessor_ =
+          EdgeAccessor{index_iterator_->edge,      self_->edge_type_, index_iterator_->from_vertex,
+                       index_iterator_->to_vertex, self_->transaction_, self_->indices_,
+                       self_->constraints_,        self_->config_};
       break;
     }
   }
 }
 
-LabelIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label, View view,
-                               Transaction *transaction, Indices *indices, Constraints *constraints,
-                               Config::Items config)
+EdgeTypeIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, EdgeTypeId edge_type, View view,
+                                  Transaction *transaction, Indices *indices, Constraints *constraints,
+                                  Config::Items config)
     : index_accessor_(std::move(index_accessor)),
-      label_(label),
+      edge_type_(edge_type),
       view_(view),
       transaction_(transaction),
       indices_(indices),
       constraints_(constraints),
       config_(config) {}
 
-void LabelIndex::RunGC() {
+void EdgeTypeIndex::RunGC() {
   for (auto &index_entry : index_) {
     index_entry.second.run_gc();
   }
 }
 
-bool LabelPropertyIndex::Entry::operator<(const Entry &rhs) {
+bool EdgeTypePropertyIndex::Entry::operator<(const Entry &rhs) {
   if (value < rhs.value) {
     return true;
   }
   if (rhs.value < value) {
     return false;
   }
-  return std::make_tuple(vertex, timestamp) < std::make_tuple(rhs.vertex, rhs.timestamp);
+  return std::make_tuple(from_vertex, edge.gid, timestamp) <
+         std::make_tuple(rhs.from_vertex, rhs.edge.gid, rhs.timestamp);
 }
 
-bool LabelPropertyIndex::Entry::operator==(const Entry &rhs) {
-  return value == rhs.value && vertex == rhs.vertex && timestamp == rhs.timestamp;
+bool EdgeTypePropertyIndex::Entry::operator==(const Entry &rhs) {
+  return value == rhs.value && from_vertex == rhs.from_vertex && edge == rhs.edge && timestamp == rhs.timestamp;
 }
 
-bool LabelPropertyIndex::Entry::operator<(const PropertyValue &rhs) { return value < rhs; }
-
-bool LabelPropertyIndex::Entry::operator==(const PropertyValue &rhs) { return value == rhs; }
+bool EdgeTypePropertyIndex::Entry::operator<(const PropertyValue &rhs) { return value < rhs; }
 
-void LabelPropertyIndex::UpdateOnAddLabel(LabelId label, Vertex *vertex, const Transaction &tx) {
-  for (auto &[label_prop, storage] : index_) {
-    if (label_prop.first != label) {
-      continue;
-    }
-    auto prop_value = vertex->properties.GetProperty(label_prop.second);
-    if (!prop_value.IsNull()) {
-      auto acc = storage.access();
-      acc.insert(Entry{std::move(prop_value), vertex, tx.start_timestamp});
-    }
-  }
-}
+bool EdgeTypePropertyIndex::Entry::operator==(const PropertyValue &rhs) { return value == rhs; }
 
-void LabelPropertyIndex::UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex,
-                                             const Transaction &tx) {
+void EdgeTypePropertyIndex::UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *from_vertex,
+                                                Vertex *to_vertex, EdgeRef edge, EdgeTypeId edge_type,
+                                                const Transaction &tx) {
   if (value.IsNull()) {
     return;
   }
-  for (auto &[label_prop, storage] : index_) {
-    if (label_prop.second != property) {
-      continue;
-    }
-    if (utils::Contains(vertex->labels, label_prop.first)) {
-      auto acc = storage.access();
-      acc.insert(Entry{value, vertex, tx.start_timestamp});
-    }
-  }
+  auto it = index_.find({edge_type, property});
+  if (it == index_.end()) return;
+  auto acc = it->second.access();
+  acc.insert(Entry{value, from_vertex, to_vertex, edge, tx.start_timestamp});
 }
 
-bool LabelPropertyIndex::CreateIndex(LabelId label, PropertyId property, utils::SkipList<Vertex>::Accessor vertices) {
+bool EdgeTypePropertyIndex::CreateIndex(EdgeTypeId edge_type, PropertyId property,
+                                        utils::SkipList<Vertex>::Accessor vertices) {
+  MG_ASSERT(config_.properties_on_edges, "The edge-type-property index requires properties on edges!");
   utils::MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
   auto [it, emplaced] =
-      index_.emplace(std::piecewise_construct, std::forward_as_tuple(label, property), std::forward_as_tuple());
+      index_.emplace(std::piecewise_construct, std::forward_as_tuple(edge_type, property), std::forward_as_tuple());
   if (!emplaced) {
     // Index already exists.
     return false;
@@ -427,14 +1680,19 @@ bool LabelPropertyIndex::CreateIndex(LabelId label, PropertyId property, utils::
   try {
     auto acc = it->second.access();
     for (Vertex &vertex : vertices) {
-      if (vertex.deleted || !utils::Contains(vertex.labels, label)) {
+      if (vertex.deleted) {
         continue;
       }
-      auto value = vertex.properties.GetProperty(property);
-      if (value.IsNull()) {
-        continue;
+      for (const auto &[type, to_vertex, edge] : vertex.out_edges.EdgesOfType(edge_type)) {
+        if (edge.ptr->deleted) {
+          continue;
+        }
+        auto value = edge.ptr->properties.GetProperty(property);
+        if (value.IsNull()) {
+          continue;
+        }
+        acc.insert(Entry{std::move(value), &vertex, to_vertex, edge, 0});
       }
-      acc.insert(Entry{std::move(value), &vertex, 0});
     }
   } catch (const utils::OutOfMemoryException &) {
     utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_exception_blocker;
@@ -444,8 +1702,8 @@ bool LabelPropertyIndex::CreateIndex(LabelId label, PropertyId property, utils::
   return true;
 }
 
-std::vector<std::pair<LabelId, PropertyId>> LabelPropertyIndex::ListIndices() const {
-  std::vector<std::pair<LabelId, PropertyId>> ret;
+std::vector<std::pair<EdgeTypeId, PropertyId>> EdgeTypePropertyIndex::ListIndices() const {
+  std::vector<std::pair<EdgeTypeId, PropertyId>> ret;
   ret.reserve(index_.size());
   for (const auto &item : index_) {
     ret.push_back(item.first);
@@ -453,260 +1711,145 @@ std::vector<std::pair<LabelId, PropertyId>> LabelPropertyIndex::ListIndices() co
   return ret;
 }
 
-void LabelPropertyIndex::RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp) {
-  for (auto &[label_property, index] : index_) {
-    auto index_acc = index.access();
-    for (auto it = index_acc.begin(); it != index_acc.end();) {
-      auto next_it = it;
-      ++next_it;
+void EdgeTypePropertyIndex::CollectCleanupTasks(uint64_t oldest_active_start_timestamp,
+                                                std::vector<std::function<void()>> *tasks) {
+  for (auto &[edge_type_property, index] : index_) {
+    tasks->emplace_back([edge_type_property = edge_type_property, index = &index, oldest_active_start_timestamp] {
+      auto index_acc = index->access();
+      for (auto it = index_acc.begin(); it != index_acc.end();) {
+        auto next_it = it;
+        ++next_it;
 
-      if (it->timestamp >= oldest_active_start_timestamp) {
-        it = next_it;
-        continue;
-      }
+        if (it->timestamp >= oldest_active_start_timestamp) {
+          it = next_it;
+          continue;
+        }
 
-      if ((next_it != index_acc.end() && it->vertex == next_it->vertex && it->value == next_it->value) ||
-          !AnyVersionHasLabelProperty(*it->vertex, label_property.first, label_property.second, it->value,
-                                      oldest_active_start_timestamp)) {
-        index_acc.remove(*it);
+        // The edge is checked through its from vertex first so that the edge
+        // object is accessed only while it still exists.
+        if ((next_it != index_acc.end() && it->from_vertex == next_it->from_vertex && it->edge == next_it->edge &&
+             it->value == next_it->value) ||
+            !AnyVersionHasEdge(*it->from_vertex, edge_type_property.first, it->to_vertex, it->edge,
+                               oldest_active_start_timestamp) ||
+            !AnyVersionHasEdgeProperty(*it->edge.ptr, edge_type_property.second, it->value,
+                                       oldest_active_start_timestamp)) {
+          index_acc.remove(*it);
+        }
+        it = next_it;
       }
-      it = next_it;
-    }
+    });
   }
 }
 
-LabelPropertyIndex::Iterable::Iterator::Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator)
+EdgeTypePropertyIndex::Iterable::Iterator::Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator)
     : self_(self),
       index_iterator_(index_iterator),
-      current_vertex_accessor_(nullptr, nullptr, nullptr, nullptr, self_->config_),
-      current_vertex_(nullptr) {
+      current_edge_accessor_(EdgeRef(nullptr), EdgeTypeId(), nullptr, nullptr, nullptr, nullptr, nullptr,
+                             self_->config_) {
   AdvanceUntilValid();
 }
 
-LabelPropertyIndex::Iterable::Iterator &LabelPropertyIndex::Iterable::Iterator::operator++() {
+EdgeTypePropertyIndex::Iterable::Iterator &EdgeTypePropertyIndex::Iterable::Iterator::operator++() {
   ++index_iterator_;
   AdvanceUntilValid();
   return *this;
 }
 
-void LabelPropertyIndex::Iterable::Iterator::AdvanceUntilValid() {
+void EdgeTypePropertyIndex::Iterable::Iterator::AdvanceUntilValid() {
   for (; index_iterator_ != self_->index_accessor_.end(); ++index_iterator_) {
-    if (index_iterator_->vertex == current_vertex_) {
-      continue;
+    if (index_iterator_->value != self_->value_) {
+      // The entries are sorted by the value so there are no more matches.
+      index_iterator_ = self_->index_accessor_.end();
+      break;
     }
-
-    if (self_->lower_bound_) {
-      if (index_iterator_->value < self_->lower_bound_->value()) {
-        continue;
-      }
-      if (!self_->lower_bound_->IsInclusive() && index_iterator_->value == self_->lower_bound_->value()) {
-        continue;
-      }
+    if (current_edge_ && index_iterator_->edge == *current_edge_) {
+      continue;
     }
-    if (self_->upper_bound_) {
-      if (self_->upper_bound_->value() < index_iterator_->value) {
-        index_iterator_ = self_->index_accessor_.end();
-        break;
-      }
-      if (!self_->upper_bound_->IsInclusive() && index_iterator_->value == self_->upper_bound_->value()) {
-        index_iterator_ = self_->index_accessor_.end();
-        break;
-      }
+    if (!CurrentVersionHasEdge(*index_iterator_->from_vertex, self_->edge_type_, index_iterator_->to_vertex,
+                               index_iterator_->edge, self_->transaction_, self_->view_)) {
+      continue;
     }
-
-    if (CurrentVersionHasLabelProperty(*index_iterator_->vertex, self_->label_, self_->property_,
-                                       index_iterator_->value, self_->transaction_, self_->view_)) {
-      current_vertex_ = index_iterator_->vertex;
-      current_vertex_accessor_ =
-          VertexAccessor(current_vertex_, self_->transaction_, self_->indices_, self_->constraints_, self_->config_);
+    EdgeAccessor edge_accessor{index_iterator_->edge,      self_->edge_type_,   index_iterator_->from_vertex,
+                               index_iterator_->to_vertex, self_->transaction_, self_->indices_,
+                               self_->constraints_,        self_->config_};
+    auto value = edge_accessor.GetProperty(self_->property_, self_->view_);
+    if (value.HasValue() && *value == self_->value_) {
+      current_edge_ = index_iterator_->edge;
+      current_edge_accessor_ = edge_accessor;
       break;
     }
   }
 }
 
-// These constants represent the smallest possible value of each type that is
-// contained in a `PropertyValue`. Note that numbers (integers and doubles) are
-// treated as the same "type" in `PropertyValue`.
-const PropertyValue kSmallestBool = PropertyValue(false);
-static_assert(-std::numeric_limits<double>::infinity() < std::numeric_limits<int64_t>::min());
-const PropertyValue kSmallestNumber = PropertyValue(-std::numeric_limits<double>::infinity());
-const PropertyValue kSmallestString = PropertyValue("");
-const PropertyValue kSmallestList = PropertyValue(std::vector<PropertyValue>());
-const PropertyValue kSmallestMap = PropertyValue(std::map<std::string, PropertyValue>());
-const PropertyValue kSmallestTemporalData =
-    PropertyValue(TemporalData{static_cast<TemporalType>(0), std::numeric_limits<int64_t>::min()});
-
-LabelPropertyIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label,
-                                       PropertyId property,
-                                       const std::optional<utils::Bound<PropertyValue>> &lower_bound,
-                                       const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view,
-                                       Transaction *transaction, Indices *indices, Constraints *constraints,
-                                       Config::Items config)
+EdgeTypePropertyIndex::Iterable::Iterable(utils::SkipList<Entry>::Accessor index_accessor, EdgeTypeId edge_type,
+                                          PropertyId property, const PropertyValue &value, View view,
+                                          Transaction *transaction, Indices *indices, Constraints *constraints,
+                                          Config::Items config)
     : index_accessor_(std::move(index_accessor)),
-      label_(label),
+      edge_type_(edge_type),
       property_(property),
-      lower_bound_(lower_bound),
-      upper_bound_(upper_bound),
+      value_(value),
       view_(view),
       transaction_(transaction),
       indices_(indices),
       constraints_(constraints),
-      config_(config) {
-  // We have to fix the bounds that the user provided to us. If the user
-  // provided only one bound we should make sure that only values of that type
-  // are returned by the iterator. We ensure this by supplying either an
-  // inclusive lower bound of the same type, or an exclusive upper bound of the
-  // following type. If neither bound is set we yield all items in the index.
-
-  // First we statically verify that our assumptions about the `PropertyValue`
-  // type ordering holds.
-  static_assert(PropertyValue::Type::Bool < PropertyValue::Type::Int);
-  static_assert(PropertyValue::Type::Int < PropertyValue::Type::Double);
-  static_assert(PropertyValue::Type::Double < PropertyValue::Type::String);
-  static_assert(PropertyValue::Type::String < PropertyValue::Type::List);
-  static_assert(PropertyValue::Type::List < PropertyValue::Type::Map);
-
-  // Remove any bounds that are set to `Null` because that isn't a valid value.
-  if (lower_bound_ && lower_bound_->value().IsNull()) {
-    lower_bound_ = std::nullopt;
-  }
-  if (upper_bound_ && upper_bound_->value().IsNull()) {
-    upper_bound_ = std::nullopt;
-  }
-
-  // Check whether the bounds are of comparable types if both are supplied.
-  if (lower_bound_ && upper_bound_ &&
-      !PropertyValue::AreComparableTypes(lower_bound_->value().type(), upper_bound_->value().type())) {
-    bounds_valid_ = false;
-    return;
-  }
-
-  // Set missing bounds.
-  if (lower_bound_ && !upper_bound_) {
-    // Here we need to supply an upper bound. The upper bound is set to an
-    // exclusive lower bound of the following type.
-    switch (lower_bound_->value().type()) {
-      case PropertyValue::Type::Null:
-        // This shouldn't happen because of the nullopt-ing above.
-        LOG_FATAL("Invalid database state!");
-        break;
-      case PropertyValue::Type::Bool:
-        upper_bound_ = utils::MakeBoundExclusive(kSmallestNumber);
-        break;
-      case PropertyValue::Type::Int:
-      case PropertyValue::Type::Double:
-        // Both integers and doubles are treated as the same type in
-        // `PropertyValue` and they are interleaved when sorted.
-        upper_bound_ = utils::MakeBoundExclusive(kSmallestString);
-        break;
-      case PropertyValue::Type::String:
-        upper_bound_ = utils::MakeBoundExclusive(kSmallestList);
-        break;
-      case PropertyValue::Type::List:
-        upper_bound_ = utils::MakeBoundExclusive(kSmallestMap);
-        break;
-      case PropertyValue::Type::Map:
-        upper_bound_ = utils::MakeBoundExclusive(kSmallestTemporalData);
-        break;
-      case PropertyValue::Type::TemporalData:
-        // This is the last type in the order so we leave the upper bound empty.
-        break;
-    }
-  }
-  if (upper_bound_ && !lower_bound_) {
-    // Here we need to supply a lower bound. The lower bound is set to an
-    // inclusive lower bound of the current type.
-    switch (upper_bound_->value().type()) {
-      case PropertyValue::Type::Null:
-        // This shouldn't happen because of the nullopt-ing above.
-        LOG_FATAL("Invalid database state!");
-        break;
-      case PropertyValue::Type::Bool:
-        lower_bound_ = utils::MakeBoundInclusive(kSmallestBool);
-        break;
-      case PropertyValue::Type::Int:
-      case PropertyValue::Type::Double:
-        // Both integers and doubles are treated as the same type in
-        // `PropertyValue` and they are interleaved when sorted.
-        lower_bound_ = utils::MakeBoundInclusive(kSmallestNumber);
-        break;
-      case PropertyValue::Type::String:
-        lower_bound_ = utils::MakeBoundInclusive(kSmallestString);
-        break;
-      case PropertyValue::Type::List:
-        lower_bound_ = utils::MakeBoundInclusive(kSmallestList);
-        break;
-      case PropertyValue::Type::Map:
-        lower_bound_ = utils::MakeBoundInclusive(kSmallestMap);
-        break;
-      case PropertyValue::Type::TemporalData:
-        lower_bound_ = utils::MakeBoundInclusive(kSmallestTemporalData);
-        break;
-    }
-  }
-}
-
-LabelPropertyIndex::Iterable::Iterator LabelPropertyIndex::Iterable::begin() {
-  // If the bounds are set and don't have comparable types we don't yield any
-  // items from the index.
-  if (!bounds_valid_) return Iterator(this, index_accessor_.end());
-  auto index_iterator = index_accessor_.begin();
-  if (lower_bound_) {
-    index_iterator = index_accessor_.find_equal_or_greater(lower_bound_->value());
-  }
-  return Iterator(this, index_iterator);
-}
+      config_(config) {}
 
-LabelPropertyIndex::Iterable::Iterator LabelPropertyIndex::Iterable::end() {
-  return Iterator(this, index_accessor_.end());
+EdgeTypePropertyIndex::Iterable::Iterator EdgeTypePropertyIndex::Iterable::begin() {
+  // `Null` is never stored in the index so nothing is equal to it.
+  if (value_.IsNull()) return end();
+  return Iterator(this, index_accessor_.find_equal_or_greater(value_));
 }
 
-int64_t LabelPropertyIndex::ApproximateVertexCount(LabelId label, PropertyId property,
-                                                   const PropertyValue &value) const {
-  auto it = index_.find({label, property});
-  MG_ASSERT(it != index_.end(), "Index for label {} and property {} doesn't exist", label.AsUint(), property.AsUint());
+int64_t EdgeTypePropertyIndex::ApproximateEdgeCount(EdgeTypeId edge_type, PropertyId property,
+                                                    const PropertyValue &value) const {
+  auto it = index_.find({edge_type, property});
+  MG_ASSERT(it != index_.end(), "Index for edge type {} and property {} doesn't exist", edge_type.AsUint(),
+            property.AsUint());
   auto acc = it->second.access();
   if (!value.IsNull()) {
     return acc.estimate_count(value, utils::SkipListLayerForCountEstimation(acc.size()));
-  } else {
-    // The value `Null` won't ever appear in the index because it indicates that
-    // the property shouldn't exist. Instead, this value is used as an indicator
-    // to estimate the average number of equal elements in the list (for any
-    // given value).
-    return acc.estimate_average_number_of_equals(
-        [](const auto &first, const auto &second) { return first.value == second.value; },
-        utils::SkipListLayerForAverageEqualsEstimation(acc.size()));
   }
+  return acc.estimate_average_number_of_equals(
+      [](const auto &first, const auto &second) { return first.value == second.value; },
+      utils::SkipListLayerForAverageEqualsEstimation(acc.size()));
 }
 
-int64_t LabelPropertyIndex::ApproximateVertexCount(LabelId label, PropertyId property,
-                                                   const std::optional<utils::Bound<PropertyValue>> &lower,
-                                                   const std::optional<utils::Bound<PropertyValue>> &upper) const {
-  auto it = index_.find({label, property});
-  MG_ASSERT(it != index_.end(), "Index for label {} and property {} doesn't exist", label.AsUint(), property.AsUint());
-  auto acc = it->second.access();
-  return acc.estimate_range_count(lower, upper, utils::SkipListLayerForCountEstimation(acc.size()));
-}
-
-void LabelPropertyIndex::RunGC() {
+void EdgeTypePropertyIndex::RunGC() {
   for (auto &index_entry : index_) {
     index_entry.second.run_gc();
   }
 }
 
-void RemoveObsoleteEntries(Indices *indices, uint64_t oldest_active_start_timestamp) {
-  indices->label_index.RemoveObsoleteEntries(oldest_active_start_timestamp);
-  indices->label_property_index.RemoveObsoleteEntries(oldest_active_start_timestamp);
+void CollectCleanupTasks(Indices *indices, uint64_t oldest_active_start_timestamp,
+                         std::vector<std::function<void()>> *tasks) {
+  indices->label_index.CollectCleanupTasks(oldest_active_start_timestamp, tasks);
+  indices->label_property_index.CollectCleanupTasks(oldest_active_start_timestamp, tasks);
+  indices->label_property_composite_index.CollectCleanupTasks(oldest_active_start_timestamp, tasks);
+  indices->edge_type_index.CollectCleanupTasks(oldest_active_start_timestamp, tasks);
+  indices->edge_type_property_index.CollectCleanupTasks(oldest_active_start_timestamp, tasks);
 }
 
 void UpdateOnAddLabel(Indices *indices, LabelId label, Vertex *vertex, const Transaction &tx) {
   indices->label_index.UpdateOnAddLabel(label, vertex, tx);
   indices->label_property_index.UpdateOnAddLabel(label, vertex, tx);
+  indices->label_property_composite_index.UpdateOnAddLabel(label, vertex, tx);
 }
 
 void UpdateOnSetProperty(Indices *indices, PropertyId property, const PropertyValue &value, Vertex *vertex,
                          const Transaction &tx) {
   indices->label_property_index.UpdateOnSetProperty(property, value, vertex, tx);
+  indices->label_property_composite_index.UpdateOnSetProperty(property, value, vertex, tx);
+}
+
+void UpdateOnEdgeCreation(Indices *indices, Vertex *from_vertex, Vertex *to_vertex, EdgeRef edge,
+                          EdgeTypeId edge_type, const Transaction &tx) {
+  indices->edge_type_index.UpdateOnEdgeCreation(from_vertex, to_vertex, edge, edge_type, tx);
+}
+
+void UpdateOnSetEdgeProperty(Indices *indices, PropertyId property, const PropertyValue &value, Vertex *from_vertex,
+                             Vertex *to_vertex, EdgeRef edge, EdgeTypeId edge_type, const Transaction &tx) {
+  indices->edge_type_property_index.UpdateOnSetProperty(property, value, from_vertex, to_vertex, edge, edge_type, tx);
 }
 
 }  // namespace memgraph::storage
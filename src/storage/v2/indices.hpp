@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -11,11 +11,15 @@
 
 #pragma once
 
+#include <functional>
 #include <optional>
+#include <set>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include "storage/v2/config.hpp"
+#include "storage/v2/edge_accessor.hpp"
 #include "storage/v2/property_value.hpp"
 #include "storage/v2/transaction.hpp"
 #include "storage/v2/vertex_accessor.hpp"
@@ -57,17 +61,60 @@ class LabelIndex {
   /// @throw std::bad_alloc
   void UpdateOnAddLabel(LabelId label, Vertex *vertex, const Transaction &tx);
 
+  /// Creates the index and fills it with all vertices that have the label.
+  /// When `num_threads` is larger than 1 the vertices are split into chunks
+  /// which are scanned by separate threads, and the collected entries are
+  /// sorted and bulk inserted into the index. The vertices mustn't be
+  /// modified while the index is created.
   /// @throw std::bad_alloc
-  bool CreateIndex(LabelId label, utils::SkipList<Vertex>::Accessor vertices);
+  bool CreateIndex(LabelId label, utils::SkipList<Vertex>::Accessor vertices, uint64_t num_threads = 1);
+
+  /// Registers an empty index which is kept up to date by the writers, but
+  /// isn't visible to the readers until `PublishIndex` is called. Returns the
+  /// entries of the index, or `nullptr` if the index already exists. The
+  /// entries stay valid until the index is published or unregistered because
+  /// an index that is being created can't be dropped.
+  utils::SkipList<Entry> *RegisterIndex(LabelId label);
+
+  /// Fills the entries of the registered index while the vertices are
+  /// modified concurrently. Each vertex that has the label in its current
+  /// version or in any version that isn't visible to the transaction with
+  /// `start_timestamp` is added to the index. The transaction must be started
+  /// after the index was registered and must be active until the function
+  /// returns so that the traversed deltas aren't garbage collected. The index
+  /// isn't looked up, so the function doesn't have to hold any lock.
+  /// @throw std::bad_alloc
+  static void PopulateIndex(utils::SkipList<Entry> *index, LabelId label, utils::SkipList<Vertex>::Accessor vertices,
+                            uint64_t start_timestamp, uint64_t num_threads);
 
-  /// Returns false if there was no index to drop
-  bool DropIndex(LabelId label) { return index_.erase(label) > 0; }
+  /// Makes the registered index visible to the readers.
+  void PublishIndex(LabelId label) {
+    MG_ASSERT(unpublished_.erase(label) > 0, "Index for label {} isn't registered", label.AsUint());
+  }
+
+  /// Removes the registered index whose population failed.
+  void UnregisterIndex(LabelId label) {
+    MG_ASSERT(unpublished_.erase(label) > 0, "Index for label {} isn't registered", label.AsUint());
+    index_.erase(label);
+  }
 
-  bool IndexExists(LabelId label) const { return index_.find(label) != index_.end(); }
+  /// Returns whether the index is registered, but not yet published.
+  bool IndexBeingCreated(LabelId label) const { return unpublished_.contains(label); }
+
+  /// Returns false if there was no index to drop. An index that is being
+  /// created can't be dropped.
+  bool DropIndex(LabelId label) {
+    if (unpublished_.contains(label)) return false;
+    return index_.erase(label) > 0;
+  }
+
+  bool IndexExists(LabelId label) const { return index_.contains(label) && !unpublished_.contains(label); }
 
   std::vector<LabelId> ListIndices() const;
 
-  void RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp);
+  /// Appends a task for each of the indices which removes the entries that
+  /// aren't visible to any of the active transactions anymore.
+  void CollectCleanupTasks(uint64_t oldest_active_start_timestamp, std::vector<std::function<void()>> *tasks);
 
   class Iterable {
    public:
@@ -114,18 +161,75 @@ class LabelIndex {
     return Iterable(it->second.access(), label, view, transaction, indices_, constraints_, config_);
   }
 
+  /// The index split into chunks, which can be scanned concurrently by
+  /// different threads. The chunks are valid while the object is alive.
+  class Chunks {
+   public:
+    Chunks(utils::SkipList<Entry>::Accessor index_accessor, uint64_t num_chunks, LabelId label, View view,
+           Transaction *transaction, Indices *indices, Constraints *constraints, Config::Items config);
+
+    /// Returns the vertices of a single chunk that are visible to the
+    /// transaction, one by one.
+    class Scanner {
+     public:
+      std::optional<VertexAccessor> Next();
+
+     private:
+      friend class Chunks;
+
+      Scanner(const Chunks *self, const utils::SkipList<Entry>::Chunk &chunk, Vertex *end_vertex)
+          : self_(self), it_(chunk.begin()), end_(chunk.end()), end_vertex_(end_vertex) {}
+
+      const Chunks *self_;
+      utils::SkipList<Entry>::ChunkIterator it_;
+      utils::SkipList<Entry>::ChunkIterator end_;
+      Vertex *end_vertex_;
+      Vertex *current_vertex_{nullptr};
+    };
+
+    size_t size() const { return chunks_.size(); }
+
+    Scanner Scan(size_t chunk) const { return Scanner(this, chunks_[chunk], end_vertices_[chunk]); }
+
+   private:
+    utils::SkipList<Entry>::Accessor index_accessor_;
+    std::vector<utils::SkipList<Entry>::Chunk> chunks_;
+    // The entries of a vertex can span two chunks, so each chunk ends at the
+    // first vertex of the next non-empty chunk, which is `nullptr` for the
+    // last chunks.
+    std::vector<Vertex *> end_vertices_;
+    LabelId label_;
+    View view_;
+    Transaction *transaction_;
+    Indices *indices_;
+    Constraints *constraints_;
+    Config::Items config_;
+  };
+
+  /// Splits the index into at most `num_chunks` chunks of roughly equal sizes.
+  Chunks VertexChunks(LabelId label, View view, Transaction *transaction, uint64_t num_chunks) {
+    auto it = index_.find(label);
+    MG_ASSERT(it != index_.end(), "Index for label {} doesn't exist", label.AsUint());
+    return Chunks(it->second.access(), num_chunks, label, view, transaction, indices_, constraints_, config_);
+  }
+
   int64_t ApproximateVertexCount(LabelId label) {
     auto it = index_.find(label);
     MG_ASSERT(it != index_.end(), "Index for label {} doesn't exist", label.AsUint());
     return it->second.size();
   }
 
-  void Clear() { index_.clear(); }
+  void Clear() {
+    index_.clear();
+    unpublished_.clear();
+  }
 
   void RunGC();
 
  private:
   std::map<LabelId, utils::SkipList<Entry>> index_;
+  // Registered indices that are still being populated.
+  std::set<LabelId> unpublished_;
   Indices *indices_;
   Constraints *constraints_;
   Config::Items config_;
@@ -155,16 +259,60 @@ class LabelPropertyIndex {
   /// @throw std::bad_alloc
   void UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex, const Transaction &tx);
 
+  /// Creates the index and fills it with all vertices that have the label and
+  /// the property. See `LabelIndex::CreateIndex` for the meaning of
+  /// `num_threads`.
+  /// @throw std::bad_alloc
+  bool CreateIndex(LabelId label, PropertyId property, utils::SkipList<Vertex>::Accessor vertices,
+                   uint64_t num_threads = 1);
+
+  /// See `LabelIndex::RegisterIndex`.
+  utils::SkipList<Entry> *RegisterIndex(LabelId label, PropertyId property);
+
+  /// Fills the entries of the registered index while the vertices are
+  /// modified concurrently. The vertex is added to the index with its current
+  /// property value and with all property values from the versions that
+  /// aren't visible to the transaction with `start_timestamp`, if any of these
+  /// versions has the label. See `LabelIndex::PopulateIndex` for the
+  /// requirements on the transaction.
   /// @throw std::bad_alloc
-  bool CreateIndex(LabelId label, PropertyId property, utils::SkipList<Vertex>::Accessor vertices);
+  static void PopulateIndex(utils::SkipList<Entry> *index, LabelId label, PropertyId property,
+                            utils::SkipList<Vertex>::Accessor vertices, uint64_t start_timestamp,
+                            uint64_t num_threads);
+
+  /// See `LabelIndex::PublishIndex`.
+  void PublishIndex(LabelId label, PropertyId property) {
+    MG_ASSERT(unpublished_.erase({label, property}) > 0, "Index for label {} and property {} isn't registered",
+              label.AsUint(), property.AsUint());
+  }
 
-  bool DropIndex(LabelId label, PropertyId property) { return index_.erase({label, property}) > 0; }
+  /// See `LabelIndex::UnregisterIndex`.
+  void UnregisterIndex(LabelId label, PropertyId property) {
+    MG_ASSERT(unpublished_.erase({label, property}) > 0, "Index for label {} and property {} isn't registered",
+              label.AsUint(), property.AsUint());
+    index_.erase({label, property});
+  }
 
-  bool IndexExists(LabelId label, PropertyId property) const { return index_.find({label, property}) != index_.end(); }
+  /// See `LabelIndex::IndexBeingCreated`.
+  bool IndexBeingCreated(LabelId label, PropertyId property) const {
+    return unpublished_.contains({label, property});
+  }
+
+  /// See `LabelIndex::DropIndex`.
+  bool DropIndex(LabelId label, PropertyId property) {
+    if (unpublished_.contains({label, property})) return false;
+    return index_.erase({label, property}) > 0;
+  }
+
+  bool IndexExists(LabelId label, PropertyId property) const {
+    return index_.contains({label, property}) && !unpublished_.contains({label, property});
+  }
 
   std::vector<std::pair<LabelId, PropertyId>> ListIndices() const;
 
-  void RemoveObsoleteEntries(uint64_t oldest_active_start_timestamp);
+  /// Appends a task for each of the indices which removes the entries that
+  /// aren't visible to any of the active transactions anymore.
+  void CollectCleanupTasks(uint64_t oldest_active_start_timestamp, std::vector<std::function<void()>> *tasks);
 
   class Iterable {
    public:
@@ -237,12 +385,381 @@ class LabelPropertyIndex {
                                  const std::optional<utils::Bound<PropertyValue>> &lower,
                                  const std::optional<utils::Bound<PropertyValue>> &upper) const;
 
-  void Clear() { index_.clear(); }
+  void Clear() {
+    index_.clear();
+    unpublished_.clear();
+  }
 
   void RunGC();
 
  private:
   std::map<std::pair<LabelId, PropertyId>, utils::SkipList<Entry>> index_;
+  // Registered indices that are still being populated.
+  std::set<std::pair<LabelId, PropertyId>> unpublished_;
+  Indices *indices_;
+  Constraints *constraints_;
+  Config::Items config_;
+};
+
+/// Index of the vertices with a label by the values of an ordered list of
+/// properties. The entries are sorted lexicographically by the property values
+/// so the index can be searched by the values of a prefix of the properties
+/// followed by an optional range of values of the next property. A vertex is
+/// indexed only if it has all of the properties.
+class LabelPropertyCompositeIndex {
+ private:
+  struct Entry {
+    std::vector<PropertyValue> values;
+    Vertex *vertex;
+    uint64_t timestamp;
+
+    bool operator<(const Entry &rhs);
+    bool operator==(const Entry &rhs);
+
+    // These compare only the first `rhs.size()` values of the entry so that
+    // the skip list can be searched by a prefix of the values.
+    bool operator<(const std::vector<PropertyValue> &rhs);
+    bool operator==(const std::vector<PropertyValue> &rhs);
+  };
+
+ public:
+  LabelPropertyCompositeIndex(Indices *indices, Constraints *constraints, Config::Items config)
+      : indices_(indices), constraints_(constraints), config_(config) {}
+
+  /// @throw std::bad_alloc
+  void UpdateOnAddLabel(LabelId label, Vertex *vertex, const Transaction &tx);
+
+  /// @throw std::bad_alloc
+  void UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *vertex, const Transaction &tx);
+
+  /// Creates the index and fills it with all vertices that have the label and
+  /// all of the properties. See `LabelIndex::CreateIndex` for the meaning of
+  /// `num_threads`.
+  /// @throw std::bad_alloc
+  bool CreateIndex(LabelId label, const std::vector<PropertyId> &properties, utils::SkipList<Vertex>::Accessor vertices,
+                   uint64_t num_threads = 1);
+
+  bool DropIndex(LabelId label, const std::vector<PropertyId> &properties) {
+    return index_.erase({label, properties}) > 0;
+  }
+
+  bool IndexExists(LabelId label, const std::vector<PropertyId> &properties) const {
+    return index_.contains({label, properties});
+  }
+
+  std::vector<std::pair<LabelId, std::vector<PropertyId>>> ListIndices() const;
+
+  /// Returns the property lists of all indices on the label.
+  std::vector<std::vector<PropertyId>> ListIndices(LabelId label) const;
+
+  /// Appends a task for each of the indices which removes the entries that
+  /// aren't visible to any of the active transactions anymore.
+  void CollectCleanupTasks(uint64_t oldest_active_start_timestamp, std::vector<std::function<void()>> *tasks);
+
+  class Iterable {
+   public:
+    Iterable(utils::SkipList<Entry>::Accessor index_accessor, LabelId label, const std::vector<PropertyId> &properties,
+             const std::vector<PropertyValue> &prefix, const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+             const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view, Transaction *transaction,
+             Indices *indices, Constraints *constraints, Config::Items config);
+
+    class Iterator {
+     public:
+      Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator);
+
+      VertexAccessor operator*() const { return current_vertex_accessor_; }
+
+      bool operator==(const Iterator &other) const { return index_iterator_ == other.index_iterator_; }
+      bool operator!=(const Iterator &other) const { return index_iterator_ != other.index_iterator_; }
+
+      Iterator &operator++();
+
+     private:
+      void AdvanceUntilValid();
+
+      Iterable *self_;
+      utils::SkipList<Entry>::Iterator index_iterator_;
+      VertexAccessor current_vertex_accessor_;
+      Vertex *current_vertex_;
+    };
+
+    Iterator begin();
+    Iterator end();
+
+   private:
+    utils::SkipList<Entry>::Accessor index_accessor_;
+    LabelId label_;
+    std::vector<PropertyId> properties_;
+    // Values of the first `prefix_.size()` properties.
+    std::vector<PropertyValue> prefix_;
+    // Bounds of the value of the property that follows the prefix.
+    std::optional<utils::Bound<PropertyValue>> lower_bound_;
+    std::optional<utils::Bound<PropertyValue>> upper_bound_;
+    bool bounds_valid_{true};
+    View view_;
+    Transaction *transaction_;
+    Indices *indices_;
+    Constraints *constraints_;
+    Config::Items config_;
+  };
+
+  /// Returns the vertices whose first `prefix.size()` properties are equal to
+  /// `prefix` and whose next property is within the bounds, if any are given.
+  /// Bounds can only be given if `prefix` doesn't cover all properties.
+  Iterable Vertices(LabelId label, const std::vector<PropertyId> &properties, const std::vector<PropertyValue> &prefix,
+                    const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+                    const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view,
+                    Transaction *transaction) {
+    auto it = index_.find({label, properties});
+    MG_ASSERT(it != index_.end(), "Composite index for label {} doesn't exist", label.AsUint());
+    return Iterable(it->second.access(), label, properties, prefix, lower_bound, upper_bound, view, transaction,
+                    indices_, constraints_, config_);
+  }
+
+  int64_t ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties) const {
+    auto it = index_.find({label, properties});
+    MG_ASSERT(it != index_.end(), "Composite index for label {} doesn't exist", label.AsUint());
+    return it->second.size();
+  }
+
+  /// Returns an estimated count of the vertices whose first `prefix.size()`
+  /// properties are equal to `prefix`.
+  int64_t ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties,
+                                 const std::vector<PropertyValue> &prefix) const;
+
+  /// Returns an estimated count of the vertices whose first `prefix.size()`
+  /// properties are equal to `prefix` and whose next property is within the
+  /// bounds.
+  int64_t ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties,
+                                 const std::vector<PropertyValue> &prefix,
+                                 const std::optional<utils::Bound<PropertyValue>> &lower,
+                                 const std::optional<utils::Bound<PropertyValue>> &upper) const;
+
+  void Clear() { index_.clear(); }
+
+  void RunGC();
+
+ private:
+  std::map<std::pair<LabelId, std::vector<PropertyId>>, utils::SkipList<Entry>> index_;
+  Indices *indices_;
+  Constraints *constraints_;
+  Config::Items config_;
+};
+
+class EdgeTypeIndex {
+ private:
+  struct Entry {
+    Vertex *from_vertex;
+    Vertex *to_vertex;
+    EdgeRef edge;
+    uint64_t timestamp;
+
+    bool operator<(const Entry &rhs) {
+      return std::make_tuple(from_vertex, edge.gid, timestamp) <
+             std::make_tuple(rhs.from_vertex, rhs.edge.gid, rhs.timestamp);
+    }
+    bool operator==(const Entry &rhs) {
+      return from_vertex == rhs.from_vertex && edge == rhs.edge && timestamp == rhs.timestamp;
+    }
+  };
+
+ public:
+  EdgeTypeIndex(Indices *indices, Constraints *constraints, Config::Items config)
+      : indices_(indices), constraints_(constraints), config_(config) {}
+
+  /// @throw std::bad_alloc
+  void UpdateOnEdgeCreation(Vertex *from_vertex, Vertex *to_vertex, EdgeRef edge, EdgeTypeId edge_type,
+                            const Transaction &tx);
+
+  /// Creates the index and fills it with all edges of the edge type. The
+  /// edges are found through the out edges of the vertices.
+  /// @throw std::bad_alloc
+  bool CreateIndex(EdgeTypeId edge_type, utils::SkipList<Vertex>::Accessor vertices);
+
+  /// Returns false if there was no index to drop
+  bool DropIndex(EdgeTypeId edge_type) { return index_.erase(edge_type) > 0; }
+
+  bool IndexExists(EdgeTypeId edge_type) const { return index_.contains(edge_type); }
+
+  std::vector<EdgeTypeId> ListIndices() const;
+
+  /// Appends a task for each of the indices which removes the entries that
+  /// aren't visible to any of the active transactions anymore.
+  void CollectCleanupTasks(uint64_t oldest_active_start_timestamp, std::vector<std::function<void()>> *tasks);
+
+  class Iterable {
+   public:
+    Iterable(utils::SkipList<Entry>::Accessor index_accessor, EdgeTypeId edge_type, View view,
+             Transaction *transaction, Indices *indices, Constraints *constraints, Config::Items config);
+
+    class Iterator {
+     public:
+      Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator);
+
+      EdgeAccessor operator*() const { return current_edge_accessor_; }
+
+      bool operator==(const Iterator &other) const { return index_iterator_ == other.index_iterator_; }
+      bool operator!=(const Iterator &other) const { return index_iterator_ != other.index_iterator_; }
+
+      Iterator &operator++();
+
+     private:
+      void AdvanceUntilValid();
+
+      Iterable *self_;
+      utils::SkipList<Entry>::Iterator index_iterator_;
+      EdgeAccessor current_edge_accessor_;
+      std::optional<EdgeRef> current_edge_;
+    };
+
+    Iterator begin() { return Iterator(this, index_accessor_.begin()); }
+    Iterator end() { return Iterator(this, index_accessor_.end()); }
+
+   private:
+    utils::SkipList<Entry>::Accessor index_accessor_;
+    EdgeTypeId edge_type_;
+    View view_;
+    Transaction *transaction_;
+    Indices *indices_;
+    Constraints *constraints_;
+    Config::Items config_;
+  };
+
+  /// Returns an iterable with edges visible from the given transaction.
+  Iterable Edges(EdgeTypeId edge_type, View view, Transaction *transaction) {
+    auto it = index_.find(edge_type);
+    MG_ASSERT(it != index_.end(), "Index for edge type {} doesn't exist", edge_type.AsUint());
+    return Iterable(it->second.access(), edge_type, view, transaction, indices_, constraints_, config_);
+  }
+
+  int64_t ApproximateEdgeCount(EdgeTypeId edge_type) const {
+    auto it = index_.find(edge_type);
+    MG_ASSERT(it != index_.end(), "Index for edge type {} doesn't exist", edge_type.AsUint());
+    return it->second.size();
+  }
+
+  void Clear() { index_.clear(); }
+
+  void RunGC();
+
+ private:
+  std::map<EdgeTypeId, utils::SkipList<Entry>> index_;
+  Indices *indices_;
+  Constraints *constraints_;
+  Config::Items config_;
+};
+
+/// Index of the edges of an edge type by the value of a property. The index
+/// can only be used when properties on edges are enabled.
+class EdgeTypePropertyIndex {
+ private:
+  struct Entry {
+    PropertyValue value;
+    Vertex *from_vertex;
+    Vertex *to_vertex;
+    EdgeRef edge;
+    uint64_t timestamp;
+
+    bool operator<(const Entry &rhs);
+    bool operator==(const Entry &rhs);
+
+    bool operator<(const PropertyValue &rhs);
+    bool operator==(const PropertyValue &rhs);
+  };
+
+ public:
+  EdgeTypePropertyIndex(Indices *indices, Constraints *constraints, Config::Items config)
+      : indices_(indices), constraints_(constraints), config_(config) {}
+
+  /// @throw std::bad_alloc
+  void UpdateOnSetProperty(PropertyId property, const PropertyValue &value, Vertex *from_vertex, Vertex *to_vertex,
+                           EdgeRef edge, EdgeTypeId edge_type, const Transaction &tx);
+
+  /// Creates the index and fills it with all edges of the edge type that have
+  /// the property.
+  /// @throw std::bad_alloc
+  bool CreateIndex(EdgeTypeId edge_type, PropertyId property, utils::SkipList<Vertex>::Accessor vertices);
+
+  bool DropIndex(EdgeTypeId edge_type, PropertyId property) { return index_.erase({edge_type, property}) > 0; }
+
+  bool IndexExists(EdgeTypeId edge_type, PropertyId property) const {
+    return index_.contains({edge_type, property});
+  }
+
+  std::vector<std::pair<EdgeTypeId, PropertyId>> ListIndices() const;
+
+  /// Appends a task for each of the indices which removes the entries that
+  /// aren't visible to any of the active transactions anymore.
+  void CollectCleanupTasks(uint64_t oldest_active_start_timestamp, std::vector<std::function<void()>> *tasks);
+
+  class Iterable {
+   public:
+    Iterable(utils::SkipList<Entry>::Accessor index_accessor, EdgeTypeId edge_type, PropertyId property,
+             const PropertyValue &value, View view, Transaction *transaction, Indices *indices,
+             Constraints *constraints, Config::Items config);
+
+    class Iterator {
+     public:
+      Iterator(Iterable *self, utils::SkipList<Entry>::Iterator index_iterator);
+
+      EdgeAccessor operator*() const { return current_edge_accessor_; }
+
+      bool operator==(const Iterator &other) const { return index_iterator_ == other.index_iterator_; }
+      bool operator!=(const Iterator &other) const { return index_iterator_ != other.index_iterator_; }
+
+      Iterator &operator++();
+
+     private:
+      void AdvanceUntilValid();
+
+      Iterable *self_;
+      utils::SkipList<Entry>::Iterator index_iterator_;
+      EdgeAccessor current_edge_accessor_;
+      std::optional<EdgeRef> current_edge_;
+    };
+
+    Iterator begin();
+    Iterator end() { return Iterator(this, index_accessor_.end()); }
+
+   private:
+    utils::SkipList<Entry>::Accessor index_accessor_;
+    EdgeTypeId edge_type_;
+    PropertyId property_;
+    PropertyValue value_;
+    View view_;
+    Transaction *transaction_;
+    Indices *indices_;
+    Constraints *constraints_;
+    Config::Items config_;
+  };
+
+  /// Returns an iterable with edges visible from the given transaction whose
+  /// property is equal to `value`.
+  Iterable Edges(EdgeTypeId edge_type, PropertyId property, const PropertyValue &value, View view,
+                 Transaction *transaction) {
+    auto it = index_.find({edge_type, property});
+    MG_ASSERT(it != index_.end(), "Index for edge type {} and property {} doesn't exist", edge_type.AsUint(),
+              property.AsUint());
+    return Iterable(it->second.access(), edge_type, property, value, view, transaction, indices_, constraints_,
+                    config_);
+  }
+
+  int64_t ApproximateEdgeCount(EdgeTypeId edge_type, PropertyId property) const {
+    auto it = index_.find({edge_type, property});
+    MG_ASSERT(it != index_.end(), "Index for edge type {} and property {} doesn't exist", edge_type.AsUint(),
+              property.AsUint());
+    return it->second.size();
+  }
+
+  /// See `LabelPropertyIndex::ApproximateVertexCount`.
+  int64_t ApproximateEdgeCount(EdgeTypeId edge_type, PropertyId property, const PropertyValue &value) const;
+
+  void Clear() { index_.clear(); }
+
+  void RunGC();
+
+ private:
+  std::map<std::pair<EdgeTypeId, PropertyId>, utils::SkipList<Entry>> index_;
   Indices *indices_;
   Constraints *constraints_;
   Config::Items config_;
@@ -250,7 +767,11 @@ class LabelPropertyIndex {
 
 struct Indices {
   Indices(Constraints *constraints, Config::Items config)
-      : label_index(this, constraints, config), label_property_index(this, constraints, config) {}
+      : label_index(this, constraints, config),
+        label_property_index(this, constraints, config),
+        label_property_composite_index(this, constraints, config),
+        edge_type_index(this, constraints, config),
+        edge_type_property_index(this, constraints, config) {}
 
   // Disable copy and move because members hold pointer to `this`.
   Indices(const Indices &) = delete;
@@ -261,11 +782,16 @@ struct Indices {
 
   LabelIndex label_index;
   LabelPropertyIndex label_property_index;
+  LabelPropertyCompositeIndex label_property_composite_index;
+  EdgeTypeIndex edge_type_index;
+  EdgeTypePropertyIndex edge_type_property_index;
 };
 
 /// This function should be called from garbage collection to clean-up the
-/// index.
-void RemoveObsoleteEntries(Indices *indices, uint64_t oldest_active_start_timestamp);
+/// indices. Each label, label+property, edge type and edge type+property
+/// index is cleaned up by its own task, so the tasks can be run in parallel.
+void CollectCleanupTasks(Indices *indices, uint64_t oldest_active_start_timestamp,
+                         std::vector<std::function<void()>> *tasks);
 
 // Indices are updated whenever an update occurs, instead of only on commit or
 // advance command. This is necessary because we want indices to support `NEW`
@@ -279,4 +805,14 @@ void UpdateOnAddLabel(Indices *indices, LabelId label, Vertex *vertex, const Tra
 /// @throw std::bad_alloc
 void UpdateOnSetProperty(Indices *indices, PropertyId property, const PropertyValue &value, Vertex *vertex,
                          const Transaction &tx);
+
+/// This function should be called whenever an edge is created.
+/// @throw std::bad_alloc
+void UpdateOnEdgeCreation(Indices *indices, Vertex *from_vertex, Vertex *to_vertex, EdgeRef edge,
+                          EdgeTypeId edge_type, const Transaction &tx);
+
+/// This function should be called whenever a property is modified on an edge.
+/// @throw std::bad_alloc
+void UpdateOnSetEdgeProperty(Indices *indices, PropertyId property, const PropertyValue &value, Vertex *from_vertex,
+                             Vertex *to_vertex, EdgeRef edge, EdgeTypeId edge_type, const Transaction &tx);
 }  // namespace memgraph::storage
@@ -0,0 +1,329 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/property_columns.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <mutex>
+#include <shared_mutex>
+
+#include "utils/logging.hpp"
+
+namespace memgraph::storage {
+
+namespace {
+
+// Number of rows which are read while holding the lock on the rows of a
+// label. Commits which update the rows wait at most for a single chunk.
+constexpr size_t kScanChunkSize = 4096;
+
+bool HasLabel(const Vertex &vertex, LabelId label) {
+  return std::find(vertex.labels.begin(), vertex.labels.end(), label) != vertex.labels.end();
+}
+
+}  // namespace
+
+bool PropertyColumns::CreateColumn(LabelId label, PropertyId property, utils::SkipList<Vertex>::Accessor vertices) {
+  if (ColumnExists(label, property)) return false;
+  auto label_columns = std::make_unique<LabelColumns>();
+  if (auto it = labels_.find(label); it != labels_.end()) {
+    for (const auto &column : it->second->columns) label_columns->columns.push_back({.property = column.property});
+  }
+  label_columns->columns.push_back({.property = property});
+  Fill(label, label_columns.get(), vertices);
+  labels_[label] = std::move(label_columns);
+  return true;
+}
+
+bool PropertyColumns::DropColumn(LabelId label, PropertyId property) {
+  auto it = labels_.find(label);
+  if (it == labels_.end()) return false;
+  auto &columns = it->second->columns;
+  auto column_it =
+      std::find_if(columns.begin(), columns.end(), [property](const auto &column) { return column.property == property; });
+  if (column_it == columns.end()) return false;
+  columns.erase(column_it);
+  if (columns.empty()) labels_.erase(it);
+  return true;
+}
+
+bool PropertyColumns::ColumnExists(LabelId label, PropertyId property) const {
+  auto it = labels_.find(label);
+  if (it == labels_.end()) return false;
+  const auto &columns = it->second->columns;
+  return std::any_of(columns.begin(), columns.end(), [property](const auto &column) { return column.property == property; });
+}
+
+std::vector<std::pair<LabelId, PropertyId>> PropertyColumns::ListColumns() const {
+  std::vector<std::pair<LabelId, PropertyId>> ret;
+  for (const auto &[label, label_columns] : labels_) {
+    for (const auto &column : label_columns->columns) ret.emplace_back(label, column.property);
+  }
+  return ret;
+}
+
+void PropertyColumns::Rebuild(utils::SkipList<Vertex>::Accessor vertices) {
+  for (auto &[label, label_columns] : labels_) {
+    auto rebuilt = std::make_unique<LabelColumns>();
+    for (const auto &column : label_columns->columns) rebuilt->columns.push_back({.property = column.property});
+    Fill(label, rebuilt.get(), vertices);
+    label_columns = std::move(rebuilt);
+  }
+}
+
+void PropertyColumns::Fill(LabelId label, LabelColumns *label_columns, utils::SkipList<Vertex>::Accessor &vertices) {
+  // There are no active transactions, so the current version of each vertex
+  // is visible to all of the transactions which will use the rows.
+  for (auto &vertex : vertices) {
+    if (vertex.deleted || !HasLabel(vertex, label)) continue;
+    std::vector<PropertyValue> values;
+    values.reserve(label_columns->columns.size());
+    for (const auto &column : label_columns->columns) values.push_back(vertex.properties.GetProperty(column.property));
+    SetRow(label_columns, &vertex, values, 0);
+  }
+}
+
+void PropertyColumns::SetRow(LabelColumns *label_columns, Vertex *vertex, const std::vector<PropertyValue> &values,
+                             uint64_t timestamp) {
+  size_t row = 0;
+  if (auto it = label_columns->rows.find(vertex); it != label_columns->rows.end()) {
+    row = it->second;
+  } else if (!label_columns->free_rows.empty()) {
+    row = label_columns->free_rows.back();
+    label_columns->free_rows.pop_back();
+    label_columns->rows.emplace(vertex, row);
+  } else {
+    row = label_columns->vertices.size();
+    label_columns->vertices.push_back(nullptr);
+    label_columns->timestamps.push_back(0);
+    label_columns->removed.push_back(1);
+    for (auto &column : label_columns->columns) {
+      column.types.push_back(ValueType::NONE);
+      column.values.push_back(0);
+    }
+    label_columns->rows.emplace(vertex, row);
+  }
+
+  label_columns->vertices[row] = vertex;
+  label_columns->timestamps[row] = timestamp;
+  label_columns->removed[row] = 0;
+  for (size_t i = 0; i < label_columns->columns.size(); ++i) {
+    auto &column = label_columns->columns[i];
+    const auto &value = values[i];
+    auto &type = column.types[row];
+    auto &stored = column.values[row];
+    stored = 0;
+    switch (value.type()) {
+      case PropertyValue::Type::Null:
+        type = ValueType::NONE;
+        break;
+      case PropertyValue::Type::Int:
+        type = ValueType::INT;
+        stored = value.ValueInt();
+        break;
+      case PropertyValue::Type::Double:
+        // NaN isn't ordered, so it is only counted.
+        if (std::isnan(value.ValueDouble())) {
+          type = ValueType::OTHER;
+        } else {
+          type = ValueType::DOUBLE;
+          stored = std::bit_cast<int64_t>(value.ValueDouble());
+        }
+        break;
+      case PropertyValue::Type::String: {
+        type = ValueType::STRING;
+        auto [it, inserted] =
+            column.codes.try_emplace(value.ValueString(), static_cast<int64_t>(column.dictionary.size()));
+        if (inserted) column.dictionary.push_back(value.ValueString());
+        stored = it->second;
+        break;
+      }
+      case PropertyValue::Type::Bool:
+      case PropertyValue::Type::List:
+      case PropertyValue::Type::Map:
+      case PropertyValue::Type::TemporalData:
+        type = ValueType::OTHER;
+        break;
+    }
+  }
+}
+
+void PropertyColumns::UpdateOnCommit(Vertex *vertex, uint64_t commit_timestamp) {
+  for (auto &[label, label_columns] : labels_) {
+    if (!vertex->deleted && HasLabel(*vertex, label)) {
+      // The values are decoded before taking the lock, so that the scans
+      // aren't blocked by the decoding.
+      std::vector<PropertyValue> values;
+      values.reserve(label_columns->columns.size());
+      for (const auto &column : label_columns->columns) {
+        values.push_back(vertex->properties.GetProperty(column.property));
+      }
+      std::unique_lock guard(label_columns->lock);
+      SetRow(label_columns.get(), vertex, values, commit_timestamp);
+      continue;
+    }
+
+    std::unique_lock guard(label_columns->lock);
+    auto it = label_columns->rows.find(vertex);
+    if (it == label_columns->rows.end() || label_columns->removed[it->second]) continue;
+    // The transactions which started before the commit still see the vertex,
+    // so the row is kept until the cleanup.
+    label_columns->removed[it->second] = 1;
+    label_columns->timestamps[it->second] = commit_timestamp;
+    label_columns->removed_rows.push_back(it->second);
+  }
+}
+
+namespace {
+
+// Summarizes the values of the visible rows in `[begin, end)`. The loops over
+// the numbers don't branch on the rows, so the compiler can vectorize them.
+template <typename TValueType>
+void SummarizeChunk(const std::vector<TValueType> &types, const std::vector<int64_t> &values, size_t begin, size_t end,
+                    const uint8_t *visible, PropertyColumnSummary *summary, std::vector<uint8_t> *seen_codes) {
+  uint64_t int_count = 0;
+  // The sum wraps around like the sum of the integers in a query does.
+  uint64_t int_sum = 0;
+  int64_t int_min = summary->int_min;
+  int64_t int_max = summary->int_max;
+  for (size_t i = begin; i < end; ++i) {
+    const bool is_int = visible[i - begin] != 0 && types[i] == TValueType::INT;
+    const int64_t value = values[i];
+    int_count += is_int ? 1 : 0;
+    int_sum += is_int ? static_cast<uint64_t>(value) : 0;
+    int_min = is_int && value < int_min ? value : int_min;
+    int_max = is_int && value > int_max ? value : int_max;
+  }
+  summary->int_count += int_count;
+  summary->int_sum = static_cast<int64_t>(static_cast<uint64_t>(summary->int_sum) + int_sum);
+  summary->int_min = int_min;
+  summary->int_max = int_max;
+
+  uint64_t double_count = 0;
+  double double_sum = 0.0;
+  double double_min = summary->double_min;
+  double double_max = summary->double_max;
+  for (size_t i = begin; i < end; ++i) {
+    const bool is_double = visible[i - begin] != 0 && types[i] == TValueType::DOUBLE;
+    const double value = std::bit_cast<double>(values[i]);
+    double_count += is_double ? 1 : 0;
+    double_sum += is_double ? value : 0.0;
+    double_min = is_double && value < double_min ? value : double_min;
+    double_max = is_double && value > double_max ? value : double_max;
+  }
+  summary->double_count += double_count;
+  summary->double_sum += double_sum;
+  summary->double_min = double_min;
+  summary->double_max = double_max;
+
+  for (size_t i = begin; i < end; ++i) {
+    if (visible[i - begin] == 0) continue;
+    if (types[i] == TValueType::STRING) {
+      ++summary->string_count;
+      (*seen_codes)[values[i]] = 1;
+    } else if (types[i] == TValueType::OTHER) {
+      ++summary->other_count;
+    }
+  }
+}
+
+}  // namespace
+
+std::optional<PropertyColumnsScan> PropertyColumns::Scan(LabelId label, const std::vector<PropertyId> &properties,
+                                                         uint64_t start_timestamp) const {
+  auto it = labels_.find(label);
+  if (it == labels_.end()) return std::nullopt;
+  const auto &label_columns = *it->second;
+  std::vector<const Column *> columns;
+  columns.reserve(properties.size());
+  for (const auto property : properties) {
+    auto column_it = std::find_if(label_columns.columns.begin(), label_columns.columns.end(),
+                                  [property](const auto &column) { return column.property == property; });
+    if (column_it == label_columns.columns.end()) return std::nullopt;
+    columns.push_back(&*column_it);
+  }
+
+  PropertyColumnsScan scan;
+  scan.summaries.resize(columns.size());
+  // Codes of the strings which were seen in each of the columns.
+  std::vector<std::vector<uint8_t>> seen_codes(columns.size());
+  // The rows which are added after the scan started were committed after the
+  // transaction started, so they are ignored.
+  size_t size = 0;
+  {
+    std::shared_lock guard(label_columns.lock);
+    size = label_columns.vertices.size();
+  }
+  std::vector<uint8_t> visible;
+  visible.reserve(std::min(size, kScanChunkSize));
+  for (size_t begin = 0; begin < size; begin += kScanChunkSize) {
+    const auto end = std::min(begin + kScanChunkSize, size);
+    std::shared_lock guard(label_columns.lock);
+    visible.resize(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+      const bool committed = label_columns.timestamps[i] < start_timestamp;
+      visible[i - begin] = committed && label_columns.removed[i] == 0 ? 1 : 0;
+      scan.count += visible[i - begin];
+      // The free rows are never newer than the transaction.
+      if (!committed) scan.vertices.push_back(label_columns.vertices[i]);
+    }
+    for (size_t i = 0; i < columns.size(); ++i) {
+      seen_codes[i].resize(columns[i]->dictionary.size(), 0);
+      SummarizeChunk(columns[i]->types, columns[i]->values, begin, end, visible.data(), &scan.summaries[i],
+                     &seen_codes[i]);
+    }
+  }
+
+  // Each of the distinct strings is compared only once.
+  std::shared_lock guard(label_columns.lock);
+  for (size_t i = 0; i < columns.size(); ++i) {
+    auto &summary = scan.summaries[i];
+    bool first = true;
+    for (size_t code = 0; code < seen_codes[i].size(); ++code) {
+      if (seen_codes[i][code] == 0) continue;
+      const auto &value = columns[i]->dictionary[code];
+      if (first || value < summary.string_min) summary.string_min = value;
+      if (first || value > summary.string_max) summary.string_max = value;
+      first = false;
+    }
+  }
+  return scan;
+}
+
+void PropertyColumns::CollectCleanupTasks(uint64_t oldest_active_start_timestamp,
+                                          std::vector<std::function<void()>> *tasks) {
+  for (auto &[label, label_columns] : labels_) {
+    tasks->emplace_back([label_columns = label_columns.get(), oldest_active_start_timestamp] {
+      std::unique_lock guard(label_columns->lock);
+      auto &removed_rows = label_columns->removed_rows;
+      std::sort(removed_rows.begin(), removed_rows.end());
+      removed_rows.erase(std::unique(removed_rows.begin(), removed_rows.end()), removed_rows.end());
+      std::vector<size_t> kept_rows;
+      for (const auto row : removed_rows) {
+        // The row was reused by the vertex, or it was already freed.
+        if (label_columns->removed[row] == 0 || label_columns->vertices[row] == nullptr) continue;
+        if (label_columns->timestamps[row] >= oldest_active_start_timestamp) {
+          kept_rows.push_back(row);
+          continue;
+        }
+        label_columns->rows.erase(label_columns->vertices[row]);
+        label_columns->vertices[row] = nullptr;
+        label_columns->timestamps[row] = 0;
+        label_columns->free_rows.push_back(row);
+      }
+      removed_rows = std::move(kept_rows);
+    });
+  }
+}
+
+}  // namespace memgraph::storage
@@ -0,0 +1,167 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "storage/v2/id_types.hpp"
+#include "storage/v2/property_value.hpp"
+#include "storage/v2/vertex.hpp"
+#include "utils/rw_lock.hpp"
+#include "utils/skip_list.hpp"
+
+namespace memgraph::storage {
+
+/// Summary of the values in a property column which are visible to a
+/// transaction. The values are summarized by their type, so that COUNT, SUM,
+/// AVG, MIN and MAX of the property can be computed without reading the
+/// vertices.
+struct PropertyColumnSummary {
+  uint64_t int_count{0};
+  int64_t int_sum{0};
+  int64_t int_min{std::numeric_limits<int64_t>::max()};
+  int64_t int_max{std::numeric_limits<int64_t>::min()};
+
+  uint64_t double_count{0};
+  double double_sum{0.0};
+  double double_min{std::numeric_limits<double>::infinity()};
+  double double_max{-std::numeric_limits<double>::infinity()};
+
+  uint64_t string_count{0};
+  std::string string_min;
+  std::string string_max;
+
+  /// Number of booleans, lists, maps, temporal values and NaNs. These values
+  /// are only counted.
+  uint64_t other_count{0};
+
+  /// Number of values which aren't null.
+  uint64_t Count() const { return int_count + double_count + string_count + other_count; }
+};
+
+/// Result of `PropertyColumns::Scan`.
+struct PropertyColumnsScan {
+  /// Number of vertices whose values are summarized.
+  uint64_t count{0};
+  /// Summaries of the requested properties, in the requested order.
+  std::vector<PropertyColumnSummary> summaries;
+  /// Vertices whose columns were changed after the transaction started, so
+  /// they have to be read from the vertex. The vertices don't necessarily
+  /// have the label in the version which is visible to the transaction.
+  std::vector<Vertex *> vertices;
+};
+
+/// Opt-in columns which hold the values of chosen properties of the vertices
+/// with a label, in dense arrays which can be scanned much faster than the
+/// encoded properties of each vertex.
+///
+/// Each label has a row for each vertex with the label, and a column for
+/// each of its chosen properties. Integers and doubles are stored directly,
+/// strings are dictionary encoded, while the other values are only marked by
+/// their type. The dictionary only grows until the columns of the label are
+/// recreated.
+///
+/// The rows hold the latest committed version of the vertices. They are
+/// updated by each commit before the commit becomes visible, and each row
+/// remembers the commit timestamp of its version. A transaction can use the
+/// rows which were committed before it started. The vertices of the other
+/// rows are returned by `Scan`, so that they can be read through the version
+/// chain. A vertex which loses the label or is deleted leaves a removed row
+/// behind, which is freed once no active transaction can see the vertex, and
+/// reused by another vertex.
+///
+/// The rows never move, so a scan locks the rows only for each chunk it
+/// reads, and commits can update the rows in between.
+class PropertyColumns {
+ public:
+  /// Creates the column and fills the columns of the label with all vertices
+  /// that have the label. No transaction may be active while the column is
+  /// created. Returns false if the column already exists.
+  /// @throw std::bad_alloc
+  bool CreateColumn(LabelId label, PropertyId property, utils::SkipList<Vertex>::Accessor vertices);
+
+  /// Returns false if there was no column to drop.
+  bool DropColumn(LabelId label, PropertyId property);
+
+  bool ColumnExists(LabelId label, PropertyId property) const;
+
+  std::vector<std::pair<LabelId, PropertyId>> ListColumns() const;
+
+  bool empty() const { return labels_.empty(); }
+
+  /// Refills all of the columns after the vertices were replaced. No
+  /// transaction may be active.
+  /// @throw std::bad_alloc
+  void Rebuild(utils::SkipList<Vertex>::Accessor vertices);
+
+  /// Updates the rows of the vertex, which was modified by a transaction that
+  /// commits with `commit_timestamp`. Must be called after the commit
+  /// timestamp is taken and before the transaction becomes visible, while
+  /// the transaction still owns the vertex.
+  /// @throw std::bad_alloc
+  void UpdateOnCommit(Vertex *vertex, uint64_t commit_timestamp);
+
+  /// Summarizes the columns of the properties of the vertices with the label
+  /// whose rows were committed before `start_timestamp`. Returns
+  /// `std::nullopt` if any of the properties doesn't have a column.
+  /// @throw std::bad_alloc
+  std::optional<PropertyColumnsScan> Scan(LabelId label, const std::vector<PropertyId> &properties,
+                                          uint64_t start_timestamp) const;
+
+  /// Appends a task for each label which frees the removed rows that aren't
+  /// visible to any of the active transactions anymore.
+  void CollectCleanupTasks(uint64_t oldest_active_start_timestamp, std::vector<std::function<void()>> *tasks);
+
+ private:
+  enum class ValueType : uint8_t { NONE, INT, DOUBLE, STRING, OTHER };
+
+  struct Column {
+    PropertyId property;
+    std::vector<ValueType> types;
+    // Integers, bit casted doubles and codes of the strings.
+    std::vector<int64_t> values;
+    std::vector<std::string> dictionary;
+    std::unordered_map<std::string, int64_t> codes;
+  };
+
+  struct LabelColumns {
+    mutable utils::RWLock lock{utils::RWLock::Priority::WRITE};
+    // `nullptr` for the free rows.
+    std::vector<Vertex *> vertices;
+    std::vector<uint64_t> timestamps;
+    std::vector<uint8_t> removed;
+    std::unordered_map<Vertex *, size_t> rows;
+    std::vector<size_t> removed_rows;
+    std::vector<size_t> free_rows;
+    std::vector<Column> columns;
+  };
+
+  // Fills the rows of the label with the vertices which have the label.
+  static void Fill(LabelId label, LabelColumns *label_columns, utils::SkipList<Vertex>::Accessor &vertices);
+  // Stores the values of the properties in the row of the vertex, which is
+  // allocated if the vertex doesn't have a row.
+  static void SetRow(LabelColumns *label_columns, Vertex *vertex, const std::vector<PropertyValue> &values,
+                     uint64_t timestamp);
+
+  std::map<LabelId, std::unique_ptr<LabelColumns>> labels_;
+};
+
+}  // namespace memgraph::storage
@@ -0,0 +1,190 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/property_predicate.hpp"
+
+#include <cmath>
+
+#include "utils/logging.hpp"
+
+namespace memgraph::storage {
+
+namespace {
+
+// NaN isn't ordered, and the comparison operators of Cypher don't agree on how
+// to compare it, so it is left to the expression.
+bool IsSupportedForEqual(const PropertyValue &value) {
+  switch (value.type()) {
+    case PropertyValue::Type::Null:
+    case PropertyValue::Type::Bool:
+    case PropertyValue::Type::Int:
+    case PropertyValue::Type::String:
+      return true;
+    case PropertyValue::Type::Double:
+      return !std::isnan(value.ValueDouble());
+    case PropertyValue::Type::List:
+    case PropertyValue::Type::Map:
+    case PropertyValue::Type::TemporalData:
+      return false;
+  }
+}
+
+bool IsSupportedForRange(const std::optional<utils::Bound<PropertyValue>> &bound) {
+  if (!bound) return true;
+  const auto &value = bound->value();
+  return value.IsInt() || value.IsString() || (value.IsDouble() && !std::isnan(value.ValueDouble()));
+}
+
+template <typename T>
+int Compare(const T &a, const T &b) {
+  if (a < b) return -1;
+  if (b < a) return 1;
+  return 0;
+}
+
+}  // namespace
+
+PropertyPredicate::PropertyPredicate(Type type, PropertyValue value, std::optional<utils::Bound<PropertyValue>> lower,
+                                     std::optional<utils::Bound<PropertyValue>> upper)
+    : type_(type), value_(std::move(value)), lower_(std::move(lower)), upper_(std::move(upper)) {
+  switch (type_) {
+    case Type::EQUAL:
+      supported_ = IsSupportedForEqual(value_);
+      break;
+    case Type::RANGE:
+      MG_ASSERT(lower_ || upper_, "A range predicate must have at least one bound!");
+      supported_ = IsSupportedForRange(lower_) && IsSupportedForRange(upper_);
+      break;
+    case Type::IS_NULL:
+    case Type::IS_NOT_NULL:
+      break;
+  }
+}
+
+template <typename TCompare>
+PropertyPredicate::Result PropertyPredicate::EvaluateComparable(const TCompare &compare) const {
+  if (!supported_) return Result::UNKNOWN;
+  switch (type_) {
+    case Type::EQUAL: {
+      // Values of different types are never equal.
+      auto cmp = compare(value_);
+      return cmp && *cmp == 0 ? Result::MATCH : Result::NO_MATCH;
+    }
+    case Type::RANGE: {
+      // Ordering values of different types is an error in the expression.
+      std::optional<int> lower_cmp;
+      std::optional<int> upper_cmp;
+      if (lower_) {
+        lower_cmp = compare(lower_->value());
+        if (!lower_cmp) return Result::UNKNOWN;
+      }
+      if (upper_) {
+        upper_cmp = compare(upper_->value());
+        if (!upper_cmp) return Result::UNKNOWN;
+      }
+      if (lower_cmp && (*lower_cmp < 0 || (*lower_cmp == 0 && lower_->IsExclusive()))) return Result::NO_MATCH;
+      if (upper_cmp && (*upper_cmp > 0 || (*upper_cmp == 0 && upper_->IsExclusive()))) return Result::NO_MATCH;
+      return Result::MATCH;
+    }
+    case Type::IS_NULL:
+      return Result::NO_MATCH;
+    case Type::IS_NOT_NULL:
+      return Result::MATCH;
+  }
+}
+
+PropertyPredicate::Result PropertyPredicate::Evaluate(const PropertyValue &value) const {
+  switch (value.type()) {
+    case PropertyValue::Type::Null:
+      return EvaluateNull();
+    case PropertyValue::Type::Bool:
+      return EvaluateBool(value.ValueBool());
+    case PropertyValue::Type::Int:
+      return EvaluateInt(value.ValueInt());
+    case PropertyValue::Type::Double:
+      return EvaluateDouble(value.ValueDouble());
+    case PropertyValue::Type::String:
+      return EvaluateString(value.ValueString());
+    case PropertyValue::Type::List:
+    case PropertyValue::Type::Map:
+    case PropertyValue::Type::TemporalData:
+      return EvaluateOther();
+  }
+}
+
+PropertyPredicate::Result PropertyPredicate::EvaluateNull() const {
+  if (!supported_) return Result::UNKNOWN;
+  switch (type_) {
+    case Type::EQUAL:
+    case Type::RANGE:
+      // Comparing null to anything results in null, which doesn't match.
+      return Result::NO_MATCH;
+    case Type::IS_NULL:
+      return Result::MATCH;
+    case Type::IS_NOT_NULL:
+      return Result::NO_MATCH;
+  }
+}
+
+PropertyPredicate::Result PropertyPredicate::EvaluateBool(bool value) const {
+  if (!supported_) return Result::UNKNOWN;
+  switch (type_) {
+    case Type::EQUAL:
+      if (!value_.IsBool()) return Result::NO_MATCH;
+      return value_.ValueBool() == value ? Result::MATCH : Result::NO_MATCH;
+    case Type::RANGE:
+      // Booleans can't be ordered, so the expression raises an error.
+      return Result::UNKNOWN;
+    case Type::IS_NULL:
+      return Result::NO_MATCH;
+    case Type::IS_NOT_NULL:
+      return Result::MATCH;
+  }
+}
+
+PropertyPredicate::Result PropertyPredicate::EvaluateInt(int64_t value) const {
+  return EvaluateComparable([value](const PropertyValue &other) -> std::optional<int> {
+    if (other.IsInt()) return Compare(value, other.ValueInt());
+    if (other.IsDouble()) return Compare(static_cast<double>(value), other.ValueDouble());
+    return std::nullopt;
+  });
+}
+
+PropertyPredicate::Result PropertyPredicate::EvaluateDouble(double value) const {
+  if (std::isnan(value)) return EvaluateOther();
+  return EvaluateComparable([value](const PropertyValue &other) -> std::optional<int> {
+    if (other.IsInt()) return Compare(value, static_cast<double>(other.ValueInt()));
+    if (other.IsDouble()) return Compare(value, other.ValueDouble());
+    return std::nullopt;
+  });
+}
+
+PropertyPredicate::Result PropertyPredicate::EvaluateString(std::string_view value) const {
+  return EvaluateComparable([value](const PropertyValue &other) -> std::optional<int> {
+    if (!other.IsString()) return std::nullopt;
+    return Compare(value, std::string_view(other.ValueString()));
+  });
+}
+
+PropertyPredicate::Result PropertyPredicate::EvaluateOther() const {
+  if (!supported_) return Result::UNKNOWN;
+  switch (type_) {
+    case Type::EQUAL:
+    case Type::RANGE:
+      return Result::UNKNOWN;
+    case Type::IS_NULL:
+      return Result::NO_MATCH;
+    case Type::IS_NOT_NULL:
+      return Result::MATCH;
+  }
+}
+
+}  // namespace memgraph::storage
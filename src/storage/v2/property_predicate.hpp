@@ -0,0 +1,97 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "storage/v2/property_value.hpp"
+#include "utils/bound.hpp"
+
+namespace memgraph::storage {
+
+/// A simple predicate on a single property which can be checked directly on
+/// the encoded properties in the `PropertyStore`, without decoding the
+/// property into a `PropertyValue`.
+///
+/// The predicate follows the semantics of the equivalent Cypher expression,
+/// e.g. `n.prop = value` or `n.prop > value`, where a missing property is
+/// null. The predicate doesn't support all of the types which the expression
+/// does. When the stored value or the value of the predicate has such a type
+/// (or the expression would raise an error), the predicate is `UNKNOWN` and
+/// the caller should evaluate the expression instead.
+class PropertyPredicate {
+ public:
+  enum class Type : uint8_t { EQUAL, RANGE, IS_NULL, IS_NOT_NULL };
+
+  enum class Result : uint8_t { NO_MATCH, MATCH, UNKNOWN };
+
+  /// `n.prop = value`
+  static PropertyPredicate Equal(PropertyValue value) {
+    return PropertyPredicate(Type::EQUAL, std::move(value), std::nullopt, std::nullopt);
+  }
+
+  /// `lower < n.prop < upper`, where each of the bounds is optional and can be
+  /// inclusive or exclusive.
+  static PropertyPredicate Range(std::optional<utils::Bound<PropertyValue>> lower,
+                                 std::optional<utils::Bound<PropertyValue>> upper) {
+    return PropertyPredicate(Type::RANGE, PropertyValue(), std::move(lower), std::move(upper));
+  }
+
+  /// `n.prop IS NULL`
+  static PropertyPredicate IsNull() {
+    return PropertyPredicate(Type::IS_NULL, PropertyValue(), std::nullopt, std::nullopt);
+  }
+
+  /// `n.prop IS NOT NULL`
+  static PropertyPredicate IsNotNull() {
+    return PropertyPredicate(Type::IS_NOT_NULL, PropertyValue(), std::nullopt, std::nullopt);
+  }
+
+  Type type() const { return type_; }
+
+  /// Checks the predicate on a decoded value, which is null when the property
+  /// doesn't exist.
+  Result Evaluate(const PropertyValue &value) const;
+
+  /// Functions used to check the predicate on a value of a known type, e.g.
+  /// while reading it from the encoded buffer.
+  Result EvaluateNull() const;
+  Result EvaluateBool(bool value) const;
+  Result EvaluateInt(int64_t value) const;
+  Result EvaluateDouble(double value) const;
+  Result EvaluateString(std::string_view value) const;
+  /// The value is a list, a map or temporal data.
+  Result EvaluateOther() const;
+
+ private:
+  PropertyPredicate(Type type, PropertyValue value, std::optional<utils::Bound<PropertyValue>> lower,
+                    std::optional<utils::Bound<PropertyValue>> upper);
+
+  // Compares the stored value to the value of the predicate or a bound. The
+  // result is negative, zero or positive like with `memcmp` and `std::nullopt`
+  // if the values aren't comparable.
+  template <typename TCompare>
+  Result EvaluateComparable(const TCompare &compare) const;
+
+  Type type_;
+  PropertyValue value_;
+  std::optional<utils::Bound<PropertyValue>> lower_;
+  std::optional<utils::Bound<PropertyValue>> upper_;
+  // Whether the value and the bounds can be handled by the predicate. When
+  // they can't, the predicate is always `UNKNOWN`.
+  bool supported_{true};
+};
+
+}  // namespace memgraph::storage
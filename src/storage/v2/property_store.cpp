@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -14,6 +14,7 @@
 #include <cstring>
 #include <limits>
 #include <optional>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -370,6 +371,13 @@ class Reader {
     return VerifyBytes(reinterpret_cast<const uint8_t *>(data), size);
   }
 
+  std::optional<std::string_view> ReadStringView(uint64_t size) {
+    if (pos_ + size > size_) return std::nullopt;
+    std::string_view value(reinterpret_cast<const char *>(data_ + pos_), size);
+    pos_ += size;
+    return value;
+  }
+
   bool SkipBytes(uint64_t size) {
     if (pos_ + size > size_) return false;
     pos_ += size;
@@ -706,6 +714,46 @@ std::optional<TemporalData> DecodeTemporalData(Reader &reader) {
   }
 }
 
+// Function used to check a predicate on the PropertyValue stored in the byte
+// stream. Only the values that the predicate can check are read from the
+// stream, strings are checked in place.
+//
+// @sa ComparePropertyValue
+[[nodiscard]] PropertyPredicate::Result CheckPropertyValuePredicate(Reader *reader, Type type, Size payload_size,
+                                                                    const PropertyPredicate &predicate) {
+  switch (type) {
+    case Type::EMPTY:
+    case Type::NONE: {
+      return predicate.EvaluateNull();
+    }
+    case Type::BOOL: {
+      return predicate.EvaluateBool(payload_size == Size::INT64);
+    }
+    case Type::INT: {
+      auto int_v = reader->ReadInt(payload_size);
+      if (!int_v) return PropertyPredicate::Result::UNKNOWN;
+      return predicate.EvaluateInt(*int_v);
+    }
+    case Type::DOUBLE: {
+      auto double_v = reader->ReadDouble(payload_size);
+      if (!double_v) return PropertyPredicate::Result::UNKNOWN;
+      return predicate.EvaluateDouble(*double_v);
+    }
+    case Type::STRING: {
+      auto size = reader->ReadUint(payload_size);
+      if (!size) return PropertyPredicate::Result::UNKNOWN;
+      auto str = reader->ReadStringView(*size);
+      if (!str) return PropertyPredicate::Result::UNKNOWN;
+      return predicate.EvaluateString(*str);
+    }
+    case Type::LIST:
+    case Type::MAP:
+    case Type::TEMPORAL_DATA: {
+      return predicate.EvaluateOther();
+    }
+  }
+}
+
 // Function used to encode a property (PropertyId, PropertyValue) into a byte
 // stream.
 bool EncodeProperty(Writer *writer, PropertyId property, const PropertyValue &value) {
@@ -1001,6 +1049,32 @@ bool PropertyStore::IsPropertyEqual(PropertyId property, const PropertyValue &va
   return prop_reader.GetPosition() == info.property_size;
 }
 
+PropertyPredicate::Result PropertyStore::CheckPredicate(PropertyId property,
+                                                        const PropertyPredicate &predicate) const {
+  uint64_t size;
+  const uint8_t *data;
+  std::tie(size, data) = GetSizeData(buffer_);
+  if (size % 8 != 0) {
+    // We are storing the data in the local buffer.
+    size = sizeof(buffer_) - 1;
+    data = &buffer_[1];
+  }
+  Reader reader(data, size);
+  while (true) {
+    auto metadata = reader.ReadMetadata();
+    if (!metadata || metadata->type == Type::EMPTY) break;
+    auto property_id = reader.ReadUint(metadata->id_size);
+    if (!property_id) break;
+    if (*property_id == property.AsUint()) {
+      return CheckPropertyValuePredicate(&reader, metadata->type, metadata->payload_size, predicate);
+    }
+    // The properties are sorted by ID, so the property doesn't exist.
+    if (*property_id > property.AsUint()) break;
+    if (!DecodePropertyValue(&reader, metadata->type, metadata->payload_size, nullptr)) break;
+  }
+  return predicate.EvaluateNull();
+}
+
 std::map<PropertyId, PropertyValue> PropertyStore::Properties() const {
   uint64_t size;
   const uint8_t *data;
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -14,6 +14,7 @@
 #include <map>
 
 #include "storage/v2/id_types.hpp"
+#include "storage/v2/property_predicate.hpp"
 #include "storage/v2/property_value.hpp"
 
 namespace memgraph::storage {
@@ -48,6 +49,12 @@ class PropertyStore {
   /// O(n).
   bool IsPropertyEqual(PropertyId property, const PropertyValue &value) const;
 
+  /// Checks the predicate `predicate` on the property `property`. The
+  /// predicate is checked on the encoded value, so this function doesn't
+  /// perform any memory allocations either. The time complexity of this
+  /// function is O(n).
+  PropertyPredicate::Result CheckPredicate(PropertyId property, const PropertyPredicate &predicate) const;
+
   /// Returns all properties currently stored in the store. The time complexity
   /// of this function is O(n).
   /// @throw std::bad_alloc
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -375,7 +375,10 @@ std::vector<Storage::ReplicationClient::RecoveryStep> Storage::ReplicationClient
   auto wal_files = durability::GetWalFiles(storage_->wal_directory_, storage_->uuid_, current_wal_seq_num);
   MG_ASSERT(wal_files, "Wal files could not be loaded");
 
+  // Only a full snapshot can be sent to the replica because an incremental
+  // snapshot can't be loaded without the snapshots on which it is based.
   auto snapshot_files = durability::GetSnapshotFiles(storage_->snapshot_directory_, storage_->uuid_);
+  std::erase_if(snapshot_files, [](const auto &snapshot_file) { return snapshot_file.base_timestamp.has_value(); });
   std::optional<durability::SnapshotDurabilityInfo> latest_snapshot;
   if (!snapshot_files.empty()) {
     std::sort(snapshot_files.begin(), snapshot_files.end());
@@ -557,12 +560,28 @@ void Storage::ReplicationClient::ReplicaStream::AppendTransactionEnd(uint64_t fi
 }
 
 void Storage::ReplicationClient::ReplicaStream::AppendOperation(durability::StorageGlobalOperation operation,
-                                                                LabelId label, const std::set<PropertyId> &properties,
+                                                                LabelId label,
+                                                                const std::vector<PropertyId> &properties,
                                                                 uint64_t timestamp) {
   replication::Encoder encoder(stream_.GetBuilder());
   EncodeOperation(&encoder, &self_->storage_->name_id_mapper_, operation, label, properties, timestamp);
 }
 
+void Storage::ReplicationClient::ReplicaStream::AppendOperation(durability::StorageGlobalOperation operation,
+                                                                EdgeTypeId edge_type,
+                                                                const std::vector<PropertyId> &properties,
+                                                                uint64_t timestamp) {
+  replication::Encoder encoder(stream_.GetBuilder());
+  EncodeOperation(&encoder, &self_->storage_->name_id_mapper_, operation, edge_type, properties, timestamp);
+}
+
+void Storage::ReplicationClient::ReplicaStream::AppendOperation(durability::StorageGlobalOperation operation,
+                                                                const NamedGraphStatistics &statistics,
+                                                                uint64_t timestamp) {
+  replication::Encoder encoder(stream_.GetBuilder());
+  EncodeOperation(&encoder, operation, statistics, timestamp);
+}
+
 replication::AppendDeltasRes Storage::ReplicationClient::ReplicaStream::Finalize() { return stream_.AwaitResponse(); }
 
 ////// CurrentWalHandler //////
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -60,7 +60,15 @@ class Storage::ReplicationClient {
 
     /// @throw rpc::RpcFailedException
     void AppendOperation(durability::StorageGlobalOperation operation, LabelId label,
-                         const std::set<PropertyId> &properties, uint64_t timestamp);
+                         const std::vector<PropertyId> &properties, uint64_t timestamp);
+
+    /// @throw rpc::RpcFailedException
+    void AppendOperation(durability::StorageGlobalOperation operation, EdgeTypeId edge_type,
+                         const std::vector<PropertyId> &properties, uint64_t timestamp);
+
+    /// @throw rpc::RpcFailedException
+    void AppendOperation(durability::StorageGlobalOperation operation, const NamedGraphStatistics &statistics,
+                         uint64_t timestamp);
 
    private:
     /// @throw rpc::RpcFailedException
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -169,11 +169,18 @@ void Storage::ReplicationServer::SnapshotHandler(slk::Reader *req_reader, slk::B
   storage_->indices_.label_index = LabelIndex(&storage_->indices_, &storage_->constraints_, storage_->config_.items);
   storage_->indices_.label_property_index =
       LabelPropertyIndex(&storage_->indices_, &storage_->constraints_, storage_->config_.items);
+  storage_->indices_.label_property_composite_index =
+      LabelPropertyCompositeIndex(&storage_->indices_, &storage_->constraints_, storage_->config_.items);
+  storage_->indices_.edge_type_index =
+      EdgeTypeIndex(&storage_->indices_, &storage_->constraints_, storage_->config_.items);
+  storage_->indices_.edge_type_property_index =
+      EdgeTypePropertyIndex(&storage_->indices_, &storage_->constraints_, storage_->config_.items);
+  storage_->graph_statistics_ = {};
   try {
     spdlog::debug("Loading snapshot");
     auto recovered_snapshot = durability::LoadSnapshot(*maybe_snapshot_path, &storage_->vertices_, &storage_->edges_,
                                                        &storage_->epoch_history_, &storage_->name_id_mapper_,
-                                                       &storage_->edge_count_, storage_->config_.items);
+                                                       &storage_->edge_count_, storage_->config_);
     spdlog::debug("Snapshot loaded successfully");
     // If this step is present it should always be the first step of
     // the recovery so we use the UUID we read from snasphost
@@ -185,7 +192,12 @@ void Storage::ReplicationServer::SnapshotHandler(slk::Reader *req_reader, slk::B
     storage_->timestamp_ = std::max(storage_->timestamp_, recovery_info.next_timestamp);
 
     durability::RecoverIndicesAndConstraints(recovered_snapshot.indices_constraints, &storage_->indices_,
-                                             &storage_->constraints_, &storage_->vertices_);
+                                             &storage_->constraints_, &storage_->vertices_,
+                                             storage_->config_.durability.recovery_thread_count);
+    durability::RecoverGraphStatistics(recovered_snapshot.indices_constraints, &storage_->name_id_mapper_,
+                                       &storage_->graph_statistics_);
+    storage_->RecountEdgeTypes();
+    storage_->property_columns_.Rebuild(storage_->vertices_.access());
   } catch (const durability::RecoveryFailure &e) {
     LOG_FATAL("Couldn't load the snapshot because of: {}", e.what());
   }
@@ -196,7 +208,7 @@ void Storage::ReplicationServer::SnapshotHandler(slk::Reader *req_reader, slk::B
 
   // Delete other durability files
   auto snapshot_files = durability::GetSnapshotFiles(storage_->snapshot_directory_, storage_->uuid_);
-  for (const auto &[path, uuid, _] : snapshot_files) {
+  for (const auto &[path, uuid, start_timestamp, base_timestamp] : snapshot_files) {
     if (path != *maybe_snapshot_path) {
       storage_->file_retainer_.DeleteFile(path);
     }
@@ -579,6 +591,81 @@ uint64_t Storage::ReplicationServer::ReadAndApplyDelta(durability::BaseDecoder *
           throw utils::BasicException("Invalid transaction!");
         break;
       }
+      case durability::WalDeltaData::Type::EDGE_TYPE_INDEX_CREATE: {
+        spdlog::trace("       Create edge type index on :{}", delta.operation_edge_type.edge_type);
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        if (storage_->CreateIndex(storage_->NameToEdgeType(delta.operation_edge_type.edge_type), timestamp).HasError())
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
+      case durability::WalDeltaData::Type::EDGE_TYPE_INDEX_DROP: {
+        spdlog::trace("       Drop edge type index on :{}", delta.operation_edge_type.edge_type);
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        if (storage_->DropIndex(storage_->NameToEdgeType(delta.operation_edge_type.edge_type), timestamp).HasError())
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
+      case durability::WalDeltaData::Type::EDGE_TYPE_PROPERTY_INDEX_CREATE: {
+        spdlog::trace("       Create edge type+property index on :{} ({})",
+                      delta.operation_edge_type_property.edge_type, delta.operation_edge_type_property.property);
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        if (storage_
+                ->CreateIndex(storage_->NameToEdgeType(delta.operation_edge_type_property.edge_type),
+                              storage_->NameToProperty(delta.operation_edge_type_property.property), timestamp)
+                .HasError())
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
+      case durability::WalDeltaData::Type::EDGE_TYPE_PROPERTY_INDEX_DROP: {
+        spdlog::trace("       Drop edge type+property index on :{} ({})", delta.operation_edge_type_property.edge_type,
+                      delta.operation_edge_type_property.property);
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        if (storage_
+                ->DropIndex(storage_->NameToEdgeType(delta.operation_edge_type_property.edge_type),
+                            storage_->NameToProperty(delta.operation_edge_type_property.property), timestamp)
+                .HasError())
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
+      case durability::WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE: {
+        std::stringstream ss;
+        utils::PrintIterable(ss, delta.operation_label_property_list.properties);
+        spdlog::trace("       Create label+properties composite index on :{} ({})",
+                      delta.operation_label_property_list.label, ss.str());
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        std::vector<PropertyId> properties;
+        for (const auto &prop : delta.operation_label_property_list.properties) {
+          properties.push_back(storage_->NameToProperty(prop));
+        }
+        auto label = storage_->NameToLabel(delta.operation_label_property_list.label);
+        if (storage_->CreateIndex(label, properties, timestamp).HasError())
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
+      case durability::WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_DROP: {
+        std::stringstream ss;
+        utils::PrintIterable(ss, delta.operation_label_property_list.properties);
+        spdlog::trace("       Drop label+properties composite index on :{} ({})",
+                      delta.operation_label_property_list.label, ss.str());
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        std::vector<PropertyId> properties;
+        for (const auto &prop : delta.operation_label_property_list.properties) {
+          properties.push_back(storage_->NameToProperty(prop));
+        }
+        auto label = storage_->NameToLabel(delta.operation_label_property_list.label);
+        if (storage_->DropIndex(label, properties, timestamp).HasError())
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
+      case durability::WalDeltaData::Type::GRAPH_STATISTICS_SET: {
+        spdlog::trace("       Set graph statistics");
+        if (commit_timestamp_and_accessor) throw utils::BasicException("Invalid transaction!");
+        auto statistics =
+            FromNamedGraphStatistics(delta.operation_graph_statistics.statistics, &storage_->name_id_mapper_);
+        if (storage_->SetGraphStatistics(std::move(statistics), timestamp).HasError())
+          throw utils::BasicException("Invalid transaction!");
+        break;
+      }
     }
   }
 
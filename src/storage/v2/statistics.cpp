@@ -0,0 +1,329 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#include "storage/v2/durability/serialization.hpp"
+#include "utils/cast.hpp"
+#include "utils/fnv.hpp"
+
+namespace memgraph::storage {
+
+namespace {
+
+void EncodeHistogram(durability::BaseEncoder *encoder, const Histogram &histogram) {
+  encoder->WriteDouble(histogram.min);
+  encoder->WriteUint(histogram.count);
+  encoder->WriteUint(histogram.upper_bounds.size());
+  for (const auto upper_bound : histogram.upper_bounds) encoder->WriteDouble(upper_bound);
+  for (const auto distinct_count : histogram.distinct_counts) encoder->WriteUint(distinct_count);
+}
+
+std::optional<Histogram> DecodeHistogram(durability::BaseDecoder *decoder) {
+  Histogram histogram;
+  auto min = decoder->ReadDouble();
+  auto count = decoder->ReadUint();
+  auto size = decoder->ReadUint();
+  if (!min || !count || !size) return std::nullopt;
+  histogram.min = *min;
+  histogram.count = *count;
+  for (uint64_t i = 0; i < *size; ++i) {
+    auto upper_bound = decoder->ReadDouble();
+    if (!upper_bound) return std::nullopt;
+    histogram.upper_bounds.push_back(*upper_bound);
+  }
+  for (uint64_t i = 0; i < *size; ++i) {
+    auto distinct_count = decoder->ReadUint();
+    if (!distinct_count) return std::nullopt;
+    histogram.distinct_counts.push_back(*distinct_count);
+  }
+  return histogram;
+}
+
+std::optional<utils::Bound<double>> BoundToDouble(const utils::Bound<PropertyValue> &bound) {
+  const auto &value = bound.value();
+  if (value.IsInt()) return utils::Bound<double>(static_cast<double>(value.ValueInt()), bound.type());
+  if (value.IsDouble()) return utils::Bound<double>(value.ValueDouble(), bound.type());
+  return std::nullopt;
+}
+
+// Mixes the bits of the hash so that the hashes of similar values are
+// uniformly distributed, like the finalizer of MurmurHash3.
+uint64_t MixHash(uint64_t hash) {
+  hash ^= hash >> 33U;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33U;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33U;
+  return hash;
+}
+
+uint64_t CombineHash(uint64_t hash, uint64_t other) { return (hash ^ other) * 1099511628211ULL; }
+
+// Hashes the value consistently with the equality of the values, so the
+// integers are hashed as the equal doubles.
+uint64_t HashValue(const PropertyValue &value) {
+  switch (value.type()) {
+    case PropertyValue::Type::Null:
+      return 0;
+    case PropertyValue::Type::Bool:
+      return value.ValueBool() ? 1 : 2;
+    case PropertyValue::Type::Int:
+      // Adding zero turns a negative zero into a positive one.
+      return utils::MemcpyCast<uint64_t>(static_cast<double>(value.ValueInt()) + 0.0);
+    case PropertyValue::Type::Double:
+      return utils::MemcpyCast<uint64_t>(value.ValueDouble() + 0.0);
+    case PropertyValue::Type::String:
+      return utils::Fnv(value.ValueString());
+    case PropertyValue::Type::List: {
+      uint64_t hash = 3;
+      for (const auto &item : value.ValueList()) hash = CombineHash(hash, HashValue(item));
+      return hash;
+    }
+    case PropertyValue::Type::Map: {
+      uint64_t hash = 4;
+      for (const auto &[key, item] : value.ValueMap()) {
+        hash = CombineHash(CombineHash(hash, utils::Fnv(key)), HashValue(item));
+      }
+      return hash;
+    }
+    case PropertyValue::Type::TemporalData: {
+      const auto temporal_data = value.ValueTemporalData();
+      return CombineHash(static_cast<uint64_t>(temporal_data.type) + 5,
+                         utils::MemcpyCast<uint64_t>(temporal_data.microseconds));
+    }
+  }
+}
+
+}  // namespace
+
+Histogram Histogram::Build(const std::vector<double> &sorted_values, size_t max_buckets) {
+  Histogram histogram;
+  if (sorted_values.empty() || max_buckets == 0) return histogram;
+  const auto count = sorted_values.size();
+  const auto buckets = std::min(max_buckets, count);
+  histogram.min = sorted_values.front();
+  histogram.count = count;
+  histogram.upper_bounds.reserve(buckets);
+  histogram.distinct_counts.reserve(buckets);
+  size_t pos = 0;
+  for (size_t i = 1; i <= buckets; ++i) {
+    // The bucket `i` ends with the value at the `i / buckets` quantile.
+    const auto upper_bound = sorted_values[(i * count + buckets - 1) / buckets - 1];
+    uint64_t distinct_count = 0;
+    for (; pos < count && sorted_values[pos] <= upper_bound; ++pos) {
+      if (pos == 0 || sorted_values[pos] != sorted_values[pos - 1]) ++distinct_count;
+    }
+    histogram.upper_bounds.push_back(upper_bound);
+    histogram.distinct_counts.push_back(distinct_count);
+  }
+  return histogram;
+}
+
+double Histogram::EstimateFractionBelow(double value, bool inclusive) const {
+  if (value < min || (!inclusive && value == min)) return 0.0;
+  if (value > upper_bounds.back() || (inclusive && value == upper_bounds.back())) return 1.0;
+  // Buckets before `it` hold only the values which are below the given value.
+  auto it = inclusive ? std::upper_bound(upper_bounds.begin(), upper_bounds.end(), value)
+                      : std::lower_bound(upper_bounds.begin(), upper_bounds.end(), value);
+  const auto bucket = static_cast<size_t>(it - upper_bounds.begin());
+  const auto bucket_start = it == upper_bounds.begin() ? min : *(it - 1);
+  const auto bucket_end = *it;
+  auto in_bucket = bucket_end > bucket_start ? (value - bucket_start) / (bucket_end - bucket_start) : 0.0;
+  if (!inclusive && value == bucket_end && bucket_end > bucket_start && distinct_counts[bucket] > 0) {
+    // The values equal to the end of the bucket aren't below it.
+    in_bucket -= 1.0 / static_cast<double>(distinct_counts[bucket]);
+  }
+  return (static_cast<double>(bucket) + in_bucket) / static_cast<double>(upper_bounds.size());
+}
+
+double Histogram::EstimateFraction(const std::optional<utils::Bound<double>> &lower,
+                                   const std::optional<utils::Bound<double>> &upper) const {
+  if (empty()) return 0.0;
+  const auto below_upper = upper ? EstimateFractionBelow(upper->value(), upper->IsInclusive()) : 1.0;
+  const auto below_lower = lower ? EstimateFractionBelow(lower->value(), lower->IsExclusive()) : 0.0;
+  return std::max(0.0, below_upper - below_lower);
+}
+
+std::optional<double> LabelPropertyStats::EstimateRangeFraction(
+    const std::optional<utils::Bound<PropertyValue>> &lower,
+    const std::optional<utils::Bound<PropertyValue>> &upper) const {
+  if (count == 0 || histogram.empty()) return std::nullopt;
+  std::optional<utils::Bound<double>> lower_number;
+  std::optional<utils::Bound<double>> upper_number;
+  if (lower) {
+    lower_number = BoundToDouble(*lower);
+    if (!lower_number) return std::nullopt;
+  }
+  if (upper) {
+    upper_number = BoundToDouble(*upper);
+    if (!upper_number) return std::nullopt;
+  }
+  // Only the numeric values are in the histogram, so the fraction has to be
+  // scaled by the share of the numeric values.
+  const auto numeric_share = static_cast<double>(histogram.count) / static_cast<double>(count);
+  return histogram.EstimateFraction(lower_number, upper_number) * numeric_share;
+}
+
+void LabelPropertyStatsBuilder::Add(const PropertyValue &value) {
+  ++count_;
+  if (value.IsInt() || value.IsDouble()) {
+    const auto number = value.IsInt() ? static_cast<double>(value.ValueInt()) : value.ValueDouble();
+    ++numbers_count_;
+    if (sample_.size() < kHistogramSampleSize) {
+      sample_.push_back(number);
+    } else {
+      // Each of the numbers seen so far is in the sample with the same
+      // probability.
+      std::uniform_int_distribution<uint64_t> distribution(0, numbers_count_ - 1);
+      const auto index = distribution(generator_);
+      if (index < sample_.size()) sample_[index] = number;
+    }
+  }
+
+  const auto hash = MixHash(HashValue(value));
+  if (min_hashes_.size() < kDistinctValuesSketchSize) {
+    min_hashes_.insert(hash);
+  } else if (hash < *min_hashes_.rbegin() && min_hashes_.insert(hash).second) {
+    min_hashes_.erase(std::prev(min_hashes_.end()));
+  }
+}
+
+LabelPropertyStats LabelPropertyStatsBuilder::Finish() {
+  LabelPropertyStats stats;
+  stats.count = count_;
+  std::sort(sample_.begin(), sample_.end());
+  stats.histogram = Histogram::Build(sample_, kHistogramMaxBuckets);
+  // The histogram describes all of the numbers, not only the sampled ones.
+  stats.histogram.count = numbers_count_;
+  if (min_hashes_.size() < kDistinctValuesSketchSize) {
+    stats.distinct_values_count = min_hashes_.size();
+  } else {
+    // The k smallest hashes of n distinct values cover roughly the fraction
+    // k / n of the uniformly distributed hashes.
+    const auto covered = (static_cast<double>(*min_hashes_.rbegin()) + 1.0) / std::ldexp(1.0, 64);
+    const auto estimate = static_cast<double>(kDistinctValuesSketchSize - 1) / covered;
+    stats.distinct_values_count = std::min(count_, static_cast<uint64_t>(std::llround(estimate)));
+  }
+  return stats;
+}
+
+NamedGraphStatistics ToNamedGraphStatistics(const GraphStatistics &statistics, NameIdMapper *name_id_mapper) {
+  NamedGraphStatistics named;
+  named.vertex_count = statistics.vertex_count;
+  named.edge_count = statistics.edge_count;
+  for (const auto &[label, stats] : statistics.labels) {
+    named.labels.emplace_back(name_id_mapper->IdToName(label.AsUint()), stats);
+  }
+  for (const auto &[key, stats] : statistics.label_properties) {
+    named.label_properties.emplace_back(name_id_mapper->IdToName(key.first.AsUint()),
+                                        name_id_mapper->IdToName(key.second.AsUint()), stats);
+  }
+  for (const auto &[edge_type, stats] : statistics.edge_types) {
+    named.edge_types.emplace_back(name_id_mapper->IdToName(edge_type.AsUint()), stats);
+  }
+  return named;
+}
+
+GraphStatistics FromNamedGraphStatistics(const NamedGraphStatistics &statistics, NameIdMapper *name_id_mapper) {
+  GraphStatistics ret;
+  ret.vertex_count = statistics.vertex_count;
+  ret.edge_count = statistics.edge_count;
+  for (const auto &[label, stats] : statistics.labels) {
+    ret.labels[LabelId::FromUint(name_id_mapper->NameToId(label))] = stats;
+  }
+  for (const auto &[label, property, stats] : statistics.label_properties) {
+    const auto key = std::make_pair(LabelId::FromUint(name_id_mapper->NameToId(label)),
+                                    PropertyId::FromUint(name_id_mapper->NameToId(property)));
+    ret.label_properties[key] = stats;
+  }
+  for (const auto &[edge_type, stats] : statistics.edge_types) {
+    ret.edge_types[EdgeTypeId::FromUint(name_id_mapper->NameToId(edge_type))] = stats;
+  }
+  return ret;
+}
+
+void EncodeGraphStatistics(durability::BaseEncoder *encoder, const NamedGraphStatistics &statistics) {
+  encoder->WriteUint(statistics.vertex_count);
+  encoder->WriteUint(statistics.edge_count);
+  encoder->WriteUint(statistics.labels.size());
+  for (const auto &[label, stats] : statistics.labels) {
+    encoder->WriteString(label);
+    encoder->WriteUint(stats.count);
+    encoder->WriteDouble(stats.avg_degree);
+  }
+  encoder->WriteUint(statistics.label_properties.size());
+  for (const auto &[label, property, stats] : statistics.label_properties) {
+    encoder->WriteString(label);
+    encoder->WriteString(property);
+    encoder->WriteUint(stats.count);
+    encoder->WriteUint(stats.distinct_values_count);
+    EncodeHistogram(encoder, stats.histogram);
+  }
+  encoder->WriteUint(statistics.edge_types.size());
+  for (const auto &[edge_type, stats] : statistics.edge_types) {
+    encoder->WriteString(edge_type);
+    encoder->WriteUint(stats.count);
+    encoder->WriteDouble(stats.avg_out_degree);
+    encoder->WriteDouble(stats.avg_in_degree);
+  }
+}
+
+std::optional<NamedGraphStatistics> DecodeGraphStatistics(durability::BaseDecoder *decoder) {
+  NamedGraphStatistics statistics;
+  auto vertex_count = decoder->ReadUint();
+  auto edge_count = decoder->ReadUint();
+  if (!vertex_count || !edge_count) return std::nullopt;
+  statistics.vertex_count = *vertex_count;
+  statistics.edge_count = *edge_count;
+
+  auto labels_size = decoder->ReadUint();
+  if (!labels_size) return std::nullopt;
+  for (uint64_t i = 0; i < *labels_size; ++i) {
+    auto label = decoder->ReadString();
+    auto count = decoder->ReadUint();
+    auto avg_degree = decoder->ReadDouble();
+    if (!label || !count || !avg_degree) return std::nullopt;
+    statistics.labels.emplace_back(std::move(*label), LabelStats{*count, *avg_degree});
+  }
+
+  auto label_properties_size = decoder->ReadUint();
+  if (!label_properties_size) return std::nullopt;
+  for (uint64_t i = 0; i < *label_properties_size; ++i) {
+    auto label = decoder->ReadString();
+    auto property = decoder->ReadString();
+    auto count = decoder->ReadUint();
+    auto distinct_values_count = decoder->ReadUint();
+    if (!label || !property || !count || !distinct_values_count) return std::nullopt;
+    auto histogram = DecodeHistogram(decoder);
+    if (!histogram) return std::nullopt;
+    statistics.label_properties.emplace_back(std::move(*label), std::move(*property),
+                                             LabelPropertyStats{*count, *distinct_values_count, std::move(*histogram)});
+  }
+
+  auto edge_types_size = decoder->ReadUint();
+  if (!edge_types_size) return std::nullopt;
+  for (uint64_t i = 0; i < *edge_types_size; ++i) {
+    auto edge_type = decoder->ReadString();
+    auto count = decoder->ReadUint();
+    auto avg_out_degree = decoder->ReadDouble();
+    auto avg_in_degree = decoder->ReadDouble();
+    if (!edge_type || !count || !avg_out_degree || !avg_in_degree) return std::nullopt;
+    statistics.edge_types.emplace_back(std::move(*edge_type), EdgeTypeStats{*count, *avg_out_degree, *avg_in_degree});
+  }
+  return statistics;
+}
+
+}  // namespace memgraph::storage
@@ -0,0 +1,195 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <random>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "storage/v2/id_types.hpp"
+#include "storage/v2/name_id_mapper.hpp"
+#include "storage/v2/property_value.hpp"
+#include "utils/bound.hpp"
+
+namespace memgraph::storage {
+
+namespace durability {
+class BaseEncoder;
+class BaseDecoder;
+}  // namespace durability
+
+/// Equi-depth histogram of the numeric values of a property. Each of the
+/// buckets holds roughly the same number of values, so frequent values span
+/// multiple buckets and skewed distributions are estimated much better than
+/// with an uniform assumption.
+struct Histogram {
+  /// The smallest value in the histogram.
+  double min{0};
+  /// The largest value in each of the buckets, sorted ascending. The first
+  /// bucket starts at `min` and each of the following buckets starts at the
+  /// end of the previous one.
+  std::vector<double> upper_bounds;
+  /// Number of distinct values in each of the buckets. A bucket which ends
+  /// with the same value as the previous one holds no distinct values.
+  std::vector<uint64_t> distinct_counts;
+  /// Number of values described by the histogram.
+  uint64_t count{0};
+
+  bool empty() const { return upper_bounds.empty(); }
+
+  bool operator==(const Histogram &) const = default;
+
+  /// Builds the histogram with at most `max_buckets` buckets from the sorted
+  /// list of values.
+  static Histogram Build(const std::vector<double> &sorted_values, size_t max_buckets);
+
+  /// Estimates the fraction of the values in the histogram which are inside
+  /// the given range. The values are assumed to be uniformly distributed
+  /// inside of each bucket, and the value at the end of a bucket is assumed
+  /// to be as frequent as the other distinct values of the bucket.
+  double EstimateFraction(const std::optional<utils::Bound<double>> &lower,
+                          const std::optional<utils::Bound<double>> &upper) const;
+
+ private:
+  // Estimates the fraction of the values which are lower than `value` (or
+  // equal to it if `inclusive` is set).
+  double EstimateFractionBelow(double value, bool inclusive) const;
+};
+
+/// Statistics of the vertices with a label.
+struct LabelStats {
+  /// Number of vertices with the label.
+  uint64_t count{0};
+  /// Average number of edges (both in and out) of a vertex with the label.
+  double avg_degree{0};
+
+  bool operator==(const LabelStats &) const = default;
+};
+
+/// Statistics of the values of a property on the vertices with a label.
+struct LabelPropertyStats {
+  /// Number of vertices with the label that have the property.
+  uint64_t count{0};
+  /// Number of distinct values of the property.
+  uint64_t distinct_values_count{0};
+  /// Histogram of the numeric values of the property.
+  Histogram histogram;
+
+  bool operator==(const LabelPropertyStats &) const = default;
+
+  /// Average number of vertices which share a single property value.
+  double AvgGroupSize() const {
+    return distinct_values_count == 0 ? 0 : static_cast<double>(count) / distinct_values_count;
+  }
+
+  /// Estimates the fraction of the vertices whose property value is inside
+  /// the given range. Returns `std::nullopt` when the estimate can't be made
+  /// using the histogram, i.e. when a bound isn't a number.
+  std::optional<double> EstimateRangeFraction(const std::optional<utils::Bound<PropertyValue>> &lower,
+                                              const std::optional<utils::Bound<PropertyValue>> &upper) const;
+};
+
+/// Statistics of the edges with an edge type.
+struct EdgeTypeStats {
+  /// Number of edges with the edge type.
+  uint64_t count{0};
+  /// Average number of outgoing edges with the edge type of a vertex which
+  /// has at least one such edge.
+  double avg_out_degree{0};
+  /// Average number of incoming edges with the edge type of a vertex which
+  /// has at least one such edge.
+  double avg_in_degree{0};
+
+  bool operator==(const EdgeTypeStats &) const = default;
+};
+
+/// Statistics of the whole graph which are computed on demand by `ANALYZE
+/// GRAPH`. The statistics aren't maintained on changes of the graph, so they
+/// describe the graph at the time when they were computed.
+struct GraphStatistics {
+  uint64_t vertex_count{0};
+  uint64_t edge_count{0};
+  std::unordered_map<LabelId, LabelStats> labels;
+  std::map<std::pair<LabelId, PropertyId>, LabelPropertyStats> label_properties;
+  std::unordered_map<EdgeTypeId, EdgeTypeStats> edge_types;
+
+  bool empty() const { return vertex_count == 0 && labels.empty() && label_properties.empty() && edge_types.empty(); }
+};
+
+/// Maximum number of buckets in a histogram of a property.
+inline constexpr size_t kHistogramMaxBuckets = 64;
+
+/// Maximum number of numeric values of a property which are sampled to build
+/// its histogram.
+inline constexpr size_t kHistogramSampleSize = 16384;
+
+/// Number of hashes kept to estimate the number of distinct values of a
+/// property. The standard error of the estimate is about `1 / sqrt(k)`.
+inline constexpr size_t kDistinctValuesSketchSize = 1024;
+
+/// Computes the `LabelPropertyStats` of a property from a single pass over its
+/// values in bounded memory. The histogram is built from a uniform reservoir
+/// sample of the numeric values. The number of distinct values is estimated
+/// with a K minimum values sketch, which keeps only the smallest hashes of the
+/// values and is exact while there are at most `kDistinctValuesSketchSize`
+/// distinct values.
+class LabelPropertyStatsBuilder {
+ public:
+  /// Adds a value of the property, which must not be null.
+  void Add(const PropertyValue &value);
+
+  LabelPropertyStats Finish();
+
+ private:
+  uint64_t count_{0};
+  uint64_t numbers_count_{0};
+  std::vector<double> sample_;
+  // The sample is seeded deterministically so that repeated analyses of the
+  // same graph produce the same statistics.
+  std::mt19937_64 generator_{0};
+  std::set<uint64_t> min_hashes_;
+};
+
+/// The graph statistics with the labels, properties and edge types given by
+/// their names. The statistics are stored in the WAL and in snapshots and are
+/// sent to the replicas in this form, so they don't depend on the
+/// `NameIdMapper`.
+struct NamedGraphStatistics {
+  uint64_t vertex_count{0};
+  uint64_t edge_count{0};
+  std::vector<std::pair<std::string, LabelStats>> labels;
+  std::vector<std::tuple<std::string, std::string, LabelPropertyStats>> label_properties;
+  std::vector<std::pair<std::string, EdgeTypeStats>> edge_types;
+
+  bool operator==(const NamedGraphStatistics &) const = default;
+};
+
+NamedGraphStatistics ToNamedGraphStatistics(const GraphStatistics &statistics, NameIdMapper *name_id_mapper);
+
+GraphStatistics FromNamedGraphStatistics(const NamedGraphStatistics &statistics, NameIdMapper *name_id_mapper);
+
+/// Writes the statistics using the encoder of the WAL, snapshots and
+/// replication.
+void EncodeGraphStatistics(durability::BaseEncoder *encoder, const NamedGraphStatistics &statistics);
+
+/// Reads the statistics written by `EncodeGraphStatistics`. Returns
+/// `std::nullopt` if the data is malformed.
+std::optional<NamedGraphStatistics> DecodeGraphStatistics(durability::BaseDecoder *decoder);
+
+}  // namespace memgraph::storage
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -12,9 +12,14 @@
 #include "storage/v2/storage.hpp"
 #include <algorithm>
 #include <atomic>
+#include <functional>
+#include <list>
 #include <memory>
 #include <mutex>
+#include <span>
+#include <thread>
 #include <variant>
+#include <vector>
 
 #include <gflags/gflags.h>
 #include <spdlog/spdlog.h>
@@ -33,6 +38,7 @@
 #include "storage/v2/replication/replication_persistence_helper.hpp"
 #include "storage/v2/transaction.hpp"
 #include "storage/v2/vertex_accessor.hpp"
+#include "utils/event_counter.hpp"
 #include "utils/file.hpp"
 #include "utils/logging.hpp"
 #include "utils/memory_tracker.hpp"
@@ -40,6 +46,8 @@
 #include "utils/rw_lock.hpp"
 #include "utils/spin_lock.hpp"
 #include "utils/stat.hpp"
+#include "utils/thread.hpp"
+#include "utils/timer.hpp"
 #include "utils/uuid.hpp"
 
 /// REPLICATION ///
@@ -48,6 +56,13 @@
 #include "storage/v2/replication/rpc.hpp"
 #include "storage/v2/storage_error.hpp"
 
+namespace EventCounter {
+extern const Event GcIntervalTriggered;
+extern const Event GcTransactionsTriggered;
+extern const Event GcDeltaBytesTriggered;
+extern const Event GcMemoryTriggered;
+}  // namespace EventCounter
+
 namespace memgraph::storage {
 
 using OOMExceptionEnabler = utils::MemoryTracker::OutOfMemoryExceptionEnabler;
@@ -97,6 +112,16 @@ AllVerticesIterable::Iterator &AllVerticesIterable::Iterator::operator++() {
   return *this;
 }
 
+std::optional<VertexAccessor> AllVerticesChunks::Scanner::Next() {
+  while (it_ != end_) {
+    auto vertex = VertexAccessor::Create(&*it_, self_->transaction_, self_->indices_, self_->constraints_,
+                                         self_->config_, self_->view_);
+    ++it_;
+    if (vertex) return vertex;
+  }
+  return std::nullopt;
+}
+
 VerticesIterable::VerticesIterable(AllVerticesIterable vertices) : type_(Type::ALL) {
   new (&all_vertices_) AllVerticesIterable(std::move(vertices));
 }
@@ -109,6 +134,11 @@ VerticesIterable::VerticesIterable(LabelPropertyIndex::Iterable vertices) : type
   new (&vertices_by_label_property_) LabelPropertyIndex::Iterable(std::move(vertices));
 }
 
+VerticesIterable::VerticesIterable(LabelPropertyCompositeIndex::Iterable vertices)
+    : type_(Type::BY_LABEL_PROPERTY_COMPOSITE) {
+  new (&vertices_by_label_property_composite_) LabelPropertyCompositeIndex::Iterable(std::move(vertices));
+}
+
 VerticesIterable::VerticesIterable(VerticesIterable &&other) noexcept : type_(other.type_) {
   switch (other.type_) {
     case Type::ALL:
@@ -120,6 +150,10 @@ VerticesIterable::VerticesIterable(VerticesIterable &&other) noexcept : type_(ot
     case Type::BY_LABEL_PROPERTY:
       new (&vertices_by_label_property_) LabelPropertyIndex::Iterable(std::move(other.vertices_by_label_property_));
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE:
+      new (&vertices_by_label_property_composite_)
+          LabelPropertyCompositeIndex::Iterable(std::move(other.vertices_by_label_property_composite_));
+      break;
   }
 }
 
@@ -134,6 +168,9 @@ VerticesIterable &VerticesIterable::operator=(VerticesIterable &&other) noexcept
     case Type::BY_LABEL_PROPERTY:
       vertices_by_label_property_.LabelPropertyIndex::Iterable::~Iterable();
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE:
+      vertices_by_label_property_composite_.LabelPropertyCompositeIndex::Iterable::~Iterable();
+      break;
   }
   type_ = other.type_;
   switch (other.type_) {
@@ -146,6 +183,10 @@ VerticesIterable &VerticesIterable::operator=(VerticesIterable &&other) noexcept
     case Type::BY_LABEL_PROPERTY:
       new (&vertices_by_label_property_) LabelPropertyIndex::Iterable(std::move(other.vertices_by_label_property_));
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE:
+      new (&vertices_by_label_property_composite_)
+          LabelPropertyCompositeIndex::Iterable(std::move(other.vertices_by_label_property_composite_));
+      break;
   }
   return *this;
 }
@@ -161,6 +202,9 @@ VerticesIterable::~VerticesIterable() {
     case Type::BY_LABEL_PROPERTY:
       vertices_by_label_property_.LabelPropertyIndex::Iterable::~Iterable();
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE:
+      vertices_by_label_property_composite_.LabelPropertyCompositeIndex::Iterable::~Iterable();
+      break;
   }
 }
 
@@ -172,6 +216,8 @@ VerticesIterable::Iterator VerticesIterable::begin() {
       return Iterator(vertices_by_label_.begin());
     case Type::BY_LABEL_PROPERTY:
       return Iterator(vertices_by_label_property_.begin());
+    case Type::BY_LABEL_PROPERTY_COMPOSITE:
+      return Iterator(vertices_by_label_property_composite_.begin());
   }
 }
 
@@ -183,6 +229,8 @@ VerticesIterable::Iterator VerticesIterable::end() {
       return Iterator(vertices_by_label_.end());
     case Type::BY_LABEL_PROPERTY:
       return Iterator(vertices_by_label_property_.end());
+    case Type::BY_LABEL_PROPERTY_COMPOSITE:
+      return Iterator(vertices_by_label_property_composite_.end());
   }
 }
 
@@ -198,6 +246,11 @@ VerticesIterable::Iterator::Iterator(LabelPropertyIndex::Iterable::Iterator it)
   new (&by_label_property_it_) LabelPropertyIndex::Iterable::Iterator(std::move(it));
 }
 
+VerticesIterable::Iterator::Iterator(LabelPropertyCompositeIndex::Iterable::Iterator it)
+    : type_(Type::BY_LABEL_PROPERTY_COMPOSITE) {
+  new (&by_label_property_composite_it_) LabelPropertyCompositeIndex::Iterable::Iterator(std::move(it));
+}
+
 VerticesIterable::Iterator::Iterator(const VerticesIterable::Iterator &other) : type_(other.type_) {
   switch (other.type_) {
     case Type::ALL:
@@ -209,6 +262,10 @@ VerticesIterable::Iterator::Iterator(const VerticesIterable::Iterator &other) :
     case Type::BY_LABEL_PROPERTY:
       new (&by_label_property_it_) LabelPropertyIndex::Iterable::Iterator(other.by_label_property_it_);
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE:
+      new (&by_label_property_composite_it_)
+          LabelPropertyCompositeIndex::Iterable::Iterator(other.by_label_property_composite_it_);
+      break;
   }
 }
 
@@ -225,6 +282,10 @@ VerticesIterable::Iterator &VerticesIterable::Iterator::operator=(const Vertices
     case Type::BY_LABEL_PROPERTY:
       new (&by_label_property_it_) LabelPropertyIndex::Iterable::Iterator(other.by_label_property_it_);
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE:
+      new (&by_label_property_composite_it_)
+          LabelPropertyCompositeIndex::Iterable::Iterator(other.by_label_property_composite_it_);
+      break;
   }
   return *this;
 }
@@ -240,6 +301,10 @@ VerticesIterable::Iterator::Iterator(VerticesIterable::Iterator &&other) noexcep
     case Type::BY_LABEL_PROPERTY:
       new (&by_label_property_it_) LabelPropertyIndex::Iterable::Iterator(std::move(other.by_label_property_it_));
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE:
+      new (&by_label_property_composite_it_)
+          LabelPropertyCompositeIndex::Iterable::Iterator(std::move(other.by_label_property_composite_it_));
+      break;
   }
 }
 
@@ -256,6 +321,10 @@ VerticesIterable::Iterator &VerticesIterable::Iterator::operator=(VerticesIterab
     case Type::BY_LABEL_PROPERTY:
       new (&by_label_property_it_) LabelPropertyIndex::Iterable::Iterator(std::move(other.by_label_property_it_));
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE:
+      new (&by_label_property_composite_it_)
+          LabelPropertyCompositeIndex::Iterable::Iterator(std::move(other.by_label_property_composite_it_));
+      break;
   }
   return *this;
 }
@@ -273,6 +342,9 @@ void VerticesIterable::Iterator::Destroy() noexcept {
     case Type::BY_LABEL_PROPERTY:
       by_label_property_it_.LabelPropertyIndex::Iterable::Iterator::~Iterator();
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE:
+      by_label_property_composite_it_.LabelPropertyCompositeIndex::Iterable::Iterator::~Iterator();
+      break;
   }
 }
 
@@ -284,6 +356,8 @@ VertexAccessor VerticesIterable::Iterator::operator*() const {
       return *by_label_it_;
     case Type::BY_LABEL_PROPERTY:
       return *by_label_property_it_;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE:
+      return *by_label_property_composite_it_;
   }
 }
 
@@ -298,6 +372,9 @@ VerticesIterable::Iterator &VerticesIterable::Iterator::operator++() {
     case Type::BY_LABEL_PROPERTY:
       ++by_label_property_it_;
       break;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE:
+      ++by_label_property_composite_it_;
+      break;
   }
   return *this;
 }
@@ -310,11 +387,191 @@ bool VerticesIterable::Iterator::operator==(const Iterator &other) const {
       return by_label_it_ == other.by_label_it_;
     case Type::BY_LABEL_PROPERTY:
       return by_label_property_it_ == other.by_label_property_it_;
+    case Type::BY_LABEL_PROPERTY_COMPOSITE:
+      return by_label_property_composite_it_ == other.by_label_property_composite_it_;
+  }
+}
+
+EdgesIterable::EdgesIterable(EdgeTypeIndex::Iterable edges) : type_(Type::BY_EDGE_TYPE) {
+  new (&edges_by_edge_type_) EdgeTypeIndex::Iterable(std::move(edges));
+}
+
+EdgesIterable::EdgesIterable(EdgeTypePropertyIndex::Iterable edges) : type_(Type::BY_EDGE_TYPE_PROPERTY) {
+  new (&edges_by_edge_type_property_) EdgeTypePropertyIndex::Iterable(std::move(edges));
+}
+
+EdgesIterable::EdgesIterable(EdgesIterable &&other) noexcept : type_(other.type_) {
+  switch (other.type_) {
+    case Type::BY_EDGE_TYPE:
+      new (&edges_by_edge_type_) EdgeTypeIndex::Iterable(std::move(other.edges_by_edge_type_));
+      break;
+    case Type::BY_EDGE_TYPE_PROPERTY:
+      new (&edges_by_edge_type_property_)
+          EdgeTypePropertyIndex::Iterable(std::move(other.edges_by_edge_type_property_));
+      break;
+  }
+}
+
+EdgesIterable &EdgesIterable::operator=(EdgesIterable &&other) noexcept {
+  switch (type_) {
+    case Type::BY_EDGE_TYPE:
+      edges_by_edge_type_.EdgeTypeIndex::Iterable::~Iterable();
+      break;
+    case Type::BY_EDGE_TYPE_PROPERTY:
+      edges_by_edge_type_property_.EdgeTypePropertyIndex::Iterable::~Iterable();
+      break;
+  }
+  type_ = other.type_;
+  switch (other.type_) {
+    case Type::BY_EDGE_TYPE:
+      new (&edges_by_edge_type_) EdgeTypeIndex::Iterable(std::move(other.edges_by_edge_type_));
+      break;
+    case Type::BY_EDGE_TYPE_PROPERTY:
+      new (&edges_by_edge_type_property_)
+          EdgeTypePropertyIndex::Iterable(std::move(other.edges_by_edge_type_property_));
+      break;
+  }
+  return *this;
+}
+
+EdgesIterable::~EdgesIterable() {
+  switch (type_) {
+    case Type::BY_EDGE_TYPE:
+      edges_by_edge_type_.EdgeTypeIndex::Iterable::~Iterable();
+      break;
+    case Type::BY_EDGE_TYPE_PROPERTY:
+      edges_by_edge_type_property_.EdgeTypePropertyIndex::Iterable::~Iterable();
+      break;
+  }
+}
+
+EdgesIterable::Iterator EdgesIterable::begin() {
+  switch (type_) {
+    case Type::BY_EDGE_TYPE:
+      return Iterator(edges_by_edge_type_.begin());
+    case Type::BY_EDGE_TYPE_PROPERTY:
+      return Iterator(edges_by_edge_type_property_.begin());
+  }
+}
+
+EdgesIterable::Iterator EdgesIterable::end() {
+  switch (type_) {
+    case Type::BY_EDGE_TYPE:
+      return Iterator(edges_by_edge_type_.end());
+    case Type::BY_EDGE_TYPE_PROPERTY:
+      return Iterator(edges_by_edge_type_property_.end());
+  }
+}
+
+EdgesIterable::Iterator::Iterator(EdgeTypeIndex::Iterable::Iterator it) : type_(Type::BY_EDGE_TYPE) {
+  new (&by_edge_type_it_) EdgeTypeIndex::Iterable::Iterator(std::move(it));
+}
+
+EdgesIterable::Iterator::Iterator(EdgeTypePropertyIndex::Iterable::Iterator it) : type_(Type::BY_EDGE_TYPE_PROPERTY) {
+  new (&by_edge_type_property_it_) EdgeTypePropertyIndex::Iterable::Iterator(std::move(it));
+}
+
+EdgesIterable::Iterator::Iterator(const EdgesIterable::Iterator &other) : type_(other.type_) {
+  switch (other.type_) {
+    case Type::BY_EDGE_TYPE:
+      new (&by_edge_type_it_) EdgeTypeIndex::Iterable::Iterator(other.by_edge_type_it_);
+      break;
+    case Type::BY_EDGE_TYPE_PROPERTY:
+      new (&by_edge_type_property_it_) EdgeTypePropertyIndex::Iterable::Iterator(other.by_edge_type_property_it_);
+      break;
+  }
+}
+
+EdgesIterable::Iterator &EdgesIterable::Iterator::operator=(const EdgesIterable::Iterator &other) {
+  Destroy();
+  type_ = other.type_;
+  switch (other.type_) {
+    case Type::BY_EDGE_TYPE:
+      new (&by_edge_type_it_) EdgeTypeIndex::Iterable::Iterator(other.by_edge_type_it_);
+      break;
+    case Type::BY_EDGE_TYPE_PROPERTY:
+      new (&by_edge_type_property_it_) EdgeTypePropertyIndex::Iterable::Iterator(other.by_edge_type_property_it_);
+      break;
+  }
+  return *this;
+}
+
+EdgesIterable::Iterator::Iterator(EdgesIterable::Iterator &&other) noexcept : type_(other.type_) {
+  switch (other.type_) {
+    case Type::BY_EDGE_TYPE:
+      new (&by_edge_type_it_) EdgeTypeIndex::Iterable::Iterator(std::move(other.by_edge_type_it_));
+      break;
+    case Type::BY_EDGE_TYPE_PROPERTY:
+      new (&by_edge_type_property_it_)
+          EdgeTypePropertyIndex::Iterable::Iterator(std::move(other.by_edge_type_property_it_));
+      break;
+  }
+}
+
+EdgesIterable::Iterator &EdgesIterable::Iterator::operator=(EdgesIterable::Iterator &&other) noexcept {
+  Destroy();
+  type_ = other.type_;
+  switch (other.type_) {
+    case Type::BY_EDGE_TYPE:
+      new (&by_edge_type_it_) EdgeTypeIndex::Iterable::Iterator(std::move(other.by_edge_type_it_));
+      break;
+    case Type::BY_EDGE_TYPE_PROPERTY:
+      new (&by_edge_type_property_it_)
+          EdgeTypePropertyIndex::Iterable::Iterator(std::move(other.by_edge_type_property_it_));
+      break;
+  }
+  return *this;
+}
+
+EdgesIterable::Iterator::~Iterator() { Destroy(); }
+
+void EdgesIterable::Iterator::Destroy() noexcept {
+  switch (type_) {
+    case Type::BY_EDGE_TYPE:
+      by_edge_type_it_.EdgeTypeIndex::Iterable::Iterator::~Iterator();
+      break;
+    case Type::BY_EDGE_TYPE_PROPERTY:
+      by_edge_type_property_it_.EdgeTypePropertyIndex::Iterable::Iterator::~Iterator();
+      break;
+  }
+}
+
+EdgeAccessor EdgesIterable::Iterator::operator*() const {
+  switch (type_) {
+    case Type::BY_EDGE_TYPE:
+      return *by_edge_type_it_;
+    case Type::BY_EDGE_TYPE_PROPERTY:
+      return *by_edge_type_property_it_;
+  }
+}
+
+EdgesIterable::Iterator &EdgesIterable::Iterator::operator++() {
+  switch (type_) {
+    case Type::BY_EDGE_TYPE:
+      ++by_edge_type_it_;
+      break;
+    case Type::BY_EDGE_TYPE_PROPERTY:
+      ++by_edge_type_property_it_;
+      break;
+  }
+  return *this;
+}
+
+bool EdgesIterable::Iterator::operator==(const Iterator &other) const {
+  switch (type_) {
+    case Type::BY_EDGE_TYPE:
+      return by_edge_type_it_ == other.by_edge_type_it_;
+    case Type::BY_EDGE_TYPE_PROPERTY:
+      return by_edge_type_property_it_ == other.by_edge_type_property_it_;
   }
 }
 
 Storage::Storage(Config config)
-    : indices_(&constraints_, config.items),
+    : object_memory_(std::max(utils::MaxSkipListNodeSize<Vertex>(), utils::MaxSkipListNodeSize<Edge>()),
+                     std::max(1U, std::thread::hardware_concurrency())),
+      vertices_(&object_memory_),
+      edges_(&object_memory_),
+      indices_(&constraints_, config.items),
       isolation_level_(config.transaction.isolation_level),
       config_(config),
       snapshot_directory_(config_.durability.storage_directory / durability::kSnapshotDirectory),
@@ -358,7 +615,7 @@ Storage::Storage(Config config)
   if (config_.durability.recover_on_startup) {
     auto info = durability::RecoverData(snapshot_directory_, wal_directory_, &uuid_, &epoch_id_, &epoch_history_,
                                         &vertices_, &edges_, &edge_count_, &name_id_mapper_, &indices_, &constraints_,
-                                        config_.items, &wal_seq_num_);
+                                        &graph_statistics_, config_, &wal_seq_num_);
     if (info) {
       vertex_id_ = info->next_vertex_id;
       edge_id_ = info->next_edge_id;
@@ -367,6 +624,7 @@ Storage::Storage(Config config)
         last_commit_timestamp_ = *info->last_commit_timestamp;
       }
     }
+    RecountEdgeTypes();
   } else if (config_.durability.snapshot_wal_mode != Config::Durability::SnapshotWalMode::DISABLED ||
              config_.durability.snapshot_on_exit) {
     bool files_moved = false;
@@ -396,6 +654,9 @@ Storage::Storage(Config config)
           "those files into a .backup directory inside the storage directory.");
     }
   }
+  for (const auto &[label, property] : config_.columns.label_properties) {
+    property_columns_.CreateColumn(NameToLabel(label), NameToProperty(property), vertices_.access());
+  }
   if (config_.durability.snapshot_wal_mode != Config::Durability::SnapshotWalMode::DISABLED) {
     snapshot_runner_.Run("Snapshot", config_.durability.snapshot_interval, [this] {
       if (auto maybe_error = this->CreateSnapshot(); maybe_error.HasError()) {
@@ -408,8 +669,19 @@ Storage::Storage(Config config)
       }
     });
   }
+  if (config_.durability.snapshot_wal_mode == Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL) {
+    wal_sync_runner_.Run("WAL sync", config_.durability.wal_fsync_interval, [this] {
+      const auto pending = wal_periodic_sync_pending_.load(std::memory_order_acquire);
+      wal_group_commit_.WaitDurable(pending, [this] { return SyncWalFile(); });
+    });
+  }
   if (config_.gc.type == Config::Gc::Type::PERIODIC) {
     gc_runner_.Run("Storage GC", config_.gc.interval, [this] { this->CollectGarbage<false>(); });
+  } else if (config_.gc.type == Config::Gc::Type::ADAPTIVE) {
+    gc_interval_ = config_.gc.interval;
+    gc_next_run_ = std::chrono::steady_clock::now() + gc_interval_;
+    gc_info_->interval = gc_interval_;
+    gc_runner_.Run("Storage GC", config_.gc.interval, [this] { this->RunAdaptiveGc(); });
   }
 
   if (timestamp_ == kTimestampInitialId) {
@@ -430,7 +702,7 @@ Storage::Storage(Config config)
 }
 
 Storage::~Storage() {
-  if (config_.gc.type == Config::Gc::Type::PERIODIC) {
+  if (config_.gc.type != Config::Gc::Type::NONE) {
     gc_runner_.Stop();
   }
   {
@@ -438,6 +710,7 @@ Storage::~Storage() {
     replication_server_.reset();
     replication_clients_.WithLock([&](auto &clients) { clients.clear(); });
   }
+  wal_sync_runner_.Stop();
   if (wal_file_) {
     wal_file_->FinalizeWal();
     wal_file_ = std::nullopt;
@@ -456,7 +729,8 @@ Storage::~Storage() {
   }
 }
 
-Storage::Accessor::Accessor(Storage *storage, IsolationLevel isolation_level)
+Storage::Accessor::Accessor(Storage *storage, IsolationLevel isolation_level,
+                            Config::Durability::CommitDurability commit_durability)
     : storage_(storage),
       // The lock must be acquired before creating the transaction object to
       // prevent freshly created transactions from dangling in an active state
@@ -464,7 +738,8 @@ Storage::Accessor::Accessor(Storage *storage, IsolationLevel isolation_level)
       storage_guard_(storage_->main_lock_),
       transaction_(storage->CreateTransaction(isolation_level)),
       is_transaction_active_(true),
-      config_(storage->config_.items) {}
+      config_(storage->config_.items),
+      commit_durability_(commit_durability) {}
 
 Storage::Accessor::Accessor(Accessor &&other) noexcept
     : storage_(other.storage_),
@@ -472,7 +747,8 @@ Storage::Accessor::Accessor(Accessor &&other) noexcept
       transaction_(std::move(other.transaction_)),
       commit_timestamp_(other.commit_timestamp_),
       is_transaction_active_(other.is_transaction_active_),
-      config_(other.config_) {
+      config_(other.config_),
+      commit_durability_(other.commit_durability_) {
   // Don't allow the other accessor to abort our transaction in destructor.
   other.is_transaction_active_ = false;
   other.commit_timestamp_.reset();
@@ -566,8 +842,8 @@ Result<std::optional<std::pair<VertexAccessor, std::vector<EdgeAccessor>>>> Stor
 
     if (vertex_ptr->deleted) return std::optional<ReturnType>{};
 
-    in_edges = vertex_ptr->in_edges;
-    out_edges = vertex_ptr->out_edges;
+    in_edges.assign(vertex_ptr->in_edges.begin(), vertex_ptr->in_edges.end());
+    out_edges.assign(vertex_ptr->out_edges.begin(), vertex_ptr->out_edges.end());
   }
 
   std::vector<EdgeAccessor> deleted_edges;
@@ -665,13 +941,16 @@ Result<EdgeAccessor> Storage::Accessor::CreateEdge(VertexAccessor *from, VertexA
   }
 
   CreateAndLinkDelta(&transaction_, from_vertex, Delta::RemoveOutEdgeTag(), edge_type, to_vertex, edge);
-  from_vertex->out_edges.emplace_back(edge_type, to_vertex, edge);
+  from_vertex->out_edges.Add(edge_type, to_vertex, edge);
 
   CreateAndLinkDelta(&transaction_, to_vertex, Delta::RemoveInEdgeTag(), edge_type, from_vertex, edge);
-  to_vertex->in_edges.emplace_back(edge_type, from_vertex, edge);
+  to_vertex->in_edges.Add(edge_type, from_vertex, edge);
 
   // Increment edge count.
   storage_->edge_count_.fetch_add(1, std::memory_order_acq_rel);
+  ++transaction_.edge_type_count_diffs[edge_type];
+
+  UpdateOnEdgeCreation(&storage_->indices_, from_vertex, to_vertex, edge, edge_type, transaction_);
 
   return EdgeAccessor(edge, edge_type, from_vertex, to_vertex, &transaction_, &storage_->indices_,
                       &storage_->constraints_, config_);
@@ -733,13 +1012,16 @@ Result<EdgeAccessor> Storage::Accessor::CreateEdge(VertexAccessor *from, VertexA
   }
 
   CreateAndLinkDelta(&transaction_, from_vertex, Delta::RemoveOutEdgeTag(), edge_type, to_vertex, edge);
-  from_vertex->out_edges.emplace_back(edge_type, to_vertex, edge);
+  from_vertex->out_edges.Add(edge_type, to_vertex, edge);
 
   CreateAndLinkDelta(&transaction_, to_vertex, Delta::RemoveInEdgeTag(), edge_type, from_vertex, edge);
-  to_vertex->in_edges.emplace_back(edge_type, from_vertex, edge);
+  to_vertex->in_edges.Add(edge_type, from_vertex, edge);
 
   // Increment edge count.
   storage_->edge_count_.fetch_add(1, std::memory_order_acq_rel);
+  ++transaction_.edge_type_count_diffs[edge_type];
+
+  UpdateOnEdgeCreation(&storage_->indices_, from_vertex, to_vertex, edge, edge_type, transaction_);
 
   return EdgeAccessor(edge, edge_type, from_vertex, to_vertex, &transaction_, &storage_->indices_,
                       &storage_->constraints_, config_);
@@ -788,16 +1070,11 @@ Result<std::optional<EdgeAccessor>> Storage::Accessor::DeleteEdge(EdgeAccessor *
   }
 
   auto delete_edge_from_storage = [&edge_type, &edge_ref, this](auto *vertex, auto *edges) {
-    std::tuple<EdgeTypeId, Vertex *, EdgeRef> link(edge_type, vertex, edge_ref);
-    auto it = std::find(edges->begin(), edges->end(), link);
+    auto removed = edges->Remove(edge_type, vertex, edge_ref);
     if (config_.properties_on_edges) {
-      MG_ASSERT(it != edges->end(), "Invalid database state!");
-    } else if (it == edges->end()) {
-      return false;
+      MG_ASSERT(removed, "Invalid database state!");
     }
-    std::swap(*it, *edges->rbegin());
-    edges->pop_back();
-    return true;
+    return removed;
   };
 
   auto op1 = delete_edge_from_storage(to_vertex, &from_vertex->out_edges);
@@ -824,6 +1101,7 @@ Result<std::optional<EdgeAccessor>> Storage::Accessor::DeleteEdge(EdgeAccessor *
 
   // Decrement edge count.
   storage_->edge_count_.fetch_add(-1, std::memory_order_acq_rel);
+  --transaction_.edge_type_count_diffs[edge_type];
 
   return std::make_optional<EdgeAccessor>(edge_ref, edge_type, from_vertex, to_vertex, &transaction_,
                                           &storage_->indices_, &storage_->constraints_, config_, true);
@@ -845,6 +1123,144 @@ PropertyId Storage::Accessor::NameToProperty(const std::string_view name) { retu
 
 EdgeTypeId Storage::Accessor::NameToEdgeType(const std::string_view name) { return storage_->NameToEdgeType(name); }
 
+GraphStatistics Storage::Accessor::ComputeGraphStatistics() {
+  GraphStatistics statistics;
+  std::unordered_map<LabelId, uint64_t> label_degree_sum;
+  std::unordered_map<EdgeTypeId, uint64_t> edge_type_sources;
+  std::unordered_map<EdgeTypeId, uint64_t> edge_type_destinations;
+  std::map<std::pair<LabelId, PropertyId>, LabelPropertyStatsBuilder> label_property_builders;
+  for (const auto &key : storage_->indices_.label_property_index.ListIndices()) {
+    label_property_builders[key];
+  }
+
+  // Number of edges of each edge type of a vertex in one direction. A vertex
+  // has only a few edge types, so they are searched linearly.
+  using EdgeTypeDegrees = std::vector<std::pair<EdgeTypeId, int64_t>>;
+  EdgeTypeDegrees out_degrees;
+  EdgeTypeDegrees in_degrees;
+  auto add_degree = [](EdgeTypeDegrees *degrees, EdgeTypeId edge_type, int64_t degree) {
+    auto it = std::find_if(degrees->begin(), degrees->end(), [&](const auto &item) { return item.first == edge_type; });
+    if (it == degrees->end()) {
+      degrees->emplace_back(edge_type, degree);
+    } else {
+      it->second += degree;
+    }
+  };
+
+  for (auto vertex : Vertices(View::OLD)) {
+    auto labels = vertex.Labels(View::OLD);
+    if (labels.HasError()) continue;
+
+    // The degrees are read from the edge lists under the vertex lock and are
+    // corrected with the deltas like in `VertexAccessor::OutDegree`, so the
+    // edges themselves aren't collected.
+    out_degrees.clear();
+    in_degrees.clear();
+    Delta *delta = nullptr;
+    {
+      std::lock_guard<utils::SpinLock> guard(vertex.vertex_->lock);
+      vertex.vertex_->out_edges.ForEachEdgeType(
+          [&](EdgeTypeId edge_type, size_t degree) { out_degrees.emplace_back(edge_type, degree); });
+      vertex.vertex_->in_edges.ForEachEdgeType(
+          [&](EdgeTypeId edge_type, size_t degree) { in_degrees.emplace_back(edge_type, degree); });
+      delta = vertex.vertex_->delta;
+    }
+    ApplyDeltasForRead(&transaction_, delta, View::OLD, [&](const Delta &delta) {
+      switch (delta.action) {
+        case Delta::Action::ADD_OUT_EDGE:
+          add_degree(&out_degrees, delta.vertex_edge.edge_type, 1);
+          break;
+        case Delta::Action::REMOVE_OUT_EDGE:
+          add_degree(&out_degrees, delta.vertex_edge.edge_type, -1);
+          break;
+        case Delta::Action::ADD_IN_EDGE:
+          add_degree(&in_degrees, delta.vertex_edge.edge_type, 1);
+          break;
+        case Delta::Action::REMOVE_IN_EDGE:
+          add_degree(&in_degrees, delta.vertex_edge.edge_type, -1);
+          break;
+        case Delta::Action::DELETE_OBJECT:
+        case Delta::Action::RECREATE_OBJECT:
+        case Delta::Action::ADD_LABEL:
+        case Delta::Action::REMOVE_LABEL:
+        case Delta::Action::SET_PROPERTY:
+          break;
+      }
+    });
+
+    ++statistics.vertex_count;
+    uint64_t degree_sum = 0;
+    for (const auto &[edge_type, degree] : out_degrees) {
+      if (degree <= 0) continue;
+      statistics.edge_types[edge_type].count += degree;
+      ++edge_type_sources[edge_type];
+      statistics.edge_count += degree;
+      degree_sum += degree;
+    }
+    for (const auto &[edge_type, degree] : in_degrees) {
+      if (degree <= 0) continue;
+      ++edge_type_destinations[edge_type];
+      degree_sum += degree;
+    }
+
+    for (const auto label : *labels) {
+      ++statistics.labels[label].count;
+      label_degree_sum[label] += degree_sum;
+    }
+    for (auto &[key, builder] : label_property_builders) {
+      if (std::find(labels->begin(), labels->end(), key.first) == labels->end()) continue;
+      auto value = vertex.GetProperty(key.second, View::OLD);
+      if (value.HasError() || value->IsNull()) continue;
+      builder.Add(*value);
+    }
+  }
+
+  for (auto &[label, stats] : statistics.labels) {
+    stats.avg_degree = static_cast<double>(label_degree_sum[label]) / static_cast<double>(stats.count);
+  }
+  for (auto &[edge_type, stats] : statistics.edge_types) {
+    stats.avg_out_degree = static_cast<double>(stats.count) / static_cast<double>(edge_type_sources[edge_type]);
+    stats.avg_in_degree = static_cast<double>(stats.count) / static_cast<double>(edge_type_destinations[edge_type]);
+  }
+  for (auto &[key, builder] : label_property_builders) {
+    auto stats = builder.Finish();
+    if (stats.count == 0) continue;
+    statistics.label_properties[key] = std::move(stats);
+  }
+  return statistics;
+}
+
+std::optional<PropertyColumnsScanResult> Storage::Accessor::ScanPropertyColumns(
+    LabelId label, const std::vector<PropertyId> &properties, View view) {
+  // The columns hold only the committed versions of the vertices.
+  if (!transaction_.deltas.empty()) return std::nullopt;
+  uint64_t start_timestamp = transaction_.start_timestamp;
+  switch (transaction_.isolation_level) {
+    case IsolationLevel::SNAPSHOT_ISOLATION:
+      break;
+    case IsolationLevel::READ_COMMITTED:
+      // All of the committed rows are visible.
+      start_timestamp = kTransactionInitialId;
+      break;
+    case IsolationLevel::READ_UNCOMMITTED:
+      return std::nullopt;
+  }
+  auto scan = storage_->property_columns_.Scan(label, properties, start_timestamp);
+  if (!scan) return std::nullopt;
+
+  PropertyColumnsScanResult result{.count = scan->count, .summaries = std::move(scan->summaries)};
+  result.vertices.reserve(scan->vertices.size());
+  for (auto *vertex : scan->vertices) {
+    auto vertex_acc = VertexAccessor::Create(vertex, &transaction_, &storage_->indices_, &storage_->constraints_,
+                                             config_, view);
+    if (!vertex_acc) continue;
+    auto has_label = vertex_acc->HasLabel(label, view);
+    if (has_label.HasError() || !*has_label) continue;
+    result.vertices.push_back(*vertex_acc);
+  }
+  return result;
+}
+
 void Storage::Accessor::AdvanceCommand() { ++transaction_.command_id; }
 
 utils::BasicResult<StorageDataManipulationError, void> Storage::Accessor::Commit(
@@ -883,6 +1299,9 @@ utils::BasicResult<StorageDataManipulationError, void> Storage::Accessor::Commit
 
     // Save these so we can mark them used in the commit log.
     uint64_t start_timestamp = transaction_.start_timestamp;
+    // Sequence number of the transaction in the WAL, used to wait until the
+    // transaction is durable.
+    std::optional<uint64_t> wal_seq_num;
 
     {
       std::unique_lock<utils::SpinLock> engine_guard(storage_->engine_lock_);
@@ -930,6 +1349,41 @@ utils::BasicResult<StorageDataManipulationError, void> Storage::Accessor::Commit
         // so the Wal files are consistent
         if (storage_->replication_role_ == ReplicationRole::MAIN || desired_commit_timestamp.has_value()) {
           could_replicate_all_sync_replicas = storage_->AppendToWalDataManipulation(transaction_, *commit_timestamp_);
+          wal_seq_num = storage_->wal_group_commit_.LastRegistered();
+        }
+
+        // The property columns are updated before the transaction becomes
+        // visible so that the transactions which start after the commit see
+        // the new rows.
+        if (!storage_->property_columns_.empty()) {
+          for (const auto &delta : transaction_.deltas) {
+            // Only the newest delta of each modified vertex points to the
+            // vertex.
+            auto prev = delta.prev.Get();
+            if (prev.type != PreviousPtr::Type::VERTEX) continue;
+            storage_->property_columns_.UpdateOnCommit(prev.vertex, *commit_timestamp_);
+          }
+        }
+
+        // The modified objects are recorded before the transaction becomes
+        // visible so that a snapshot which sees the transaction also sees the
+        // objects.
+        if (storage_->config_.durability.snapshot_incremental_count > 0 &&
+            storage_->replication_role_ == ReplicationRole::MAIN) {
+          storage_->snapshot_dirty_objects_.WithLock([&](auto &dirty_objects) {
+            for (const auto &delta : transaction_.deltas) {
+              auto prev = delta.prev.Get();
+              auto mark_dirty = [this](auto *dirty, Gid gid) {
+                auto [it, inserted] = dirty->try_emplace(gid, *commit_timestamp_, *commit_timestamp_);
+                it->second.second = *commit_timestamp_;
+              };
+              if (prev.type == PreviousPtr::Type::VERTEX) {
+                mark_dirty(&dirty_objects.vertices, prev.vertex->gid);
+              } else if (prev.type == PreviousPtr::Type::EDGE) {
+                mark_dirty(&dirty_objects.edges, prev.edge->gid);
+              }
+            }
+          });
         }
 
         // Take committed_transactions lock while holding the engine lock to
@@ -952,6 +1406,10 @@ utils::BasicResult<StorageDataManipulationError, void> Storage::Accessor::Commit
         });
 
         storage_->commit_log_->MarkFinished(start_timestamp);
+
+        // The edge counts of the storage include only the committed
+        // transactions, the diffs of an aborted transaction are dropped.
+        storage_->ApplyEdgeTypeCountDiffs(transaction_.edge_type_count_diffs);
       }
     }
 
@@ -959,6 +1417,13 @@ utils::BasicResult<StorageDataManipulationError, void> Storage::Accessor::Commit
       Abort();
       return StorageDataManipulationError{*unique_constraint_violation};
     }
+
+    if (wal_seq_num) {
+      // The WAL is synced after the engine lock is released so that the
+      // transactions which commit in the meantime are synced together with
+      // this one.
+      storage_->WaitWalDurable(*wal_seq_num, commit_durability_);
+    }
   }
   is_transaction_active_ = false;
 
@@ -1006,19 +1471,15 @@ void Storage::Accessor::Abort() {
               break;
             }
             case Delta::Action::ADD_IN_EDGE: {
-              std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{current->vertex_edge.edge_type,
-                                                             current->vertex_edge.vertex, current->vertex_edge.edge};
-              auto it = std::find(vertex->in_edges.begin(), vertex->in_edges.end(), link);
-              MG_ASSERT(it == vertex->in_edges.end(), "Invalid database state!");
-              vertex->in_edges.push_back(link);
+              const auto &link = current->vertex_edge;
+              MG_ASSERT(!vertex->in_edges.Contains(link.edge_type, link.vertex, link.edge), "Invalid database state!");
+              vertex->in_edges.Add(link.edge_type, link.vertex, link.edge);
               break;
             }
             case Delta::Action::ADD_OUT_EDGE: {
-              std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{current->vertex_edge.edge_type,
-                                                             current->vertex_edge.vertex, current->vertex_edge.edge};
-              auto it = std::find(vertex->out_edges.begin(), vertex->out_edges.end(), link);
-              MG_ASSERT(it == vertex->out_edges.end(), "Invalid database state!");
-              vertex->out_edges.push_back(link);
+              const auto &link = current->vertex_edge;
+              MG_ASSERT(!vertex->out_edges.Contains(link.edge_type, link.vertex, link.edge), "Invalid database state!");
+              vertex->out_edges.Add(link.edge_type, link.vertex, link.edge);
               // Increment edge count. We only increment the count here because
               // the information in `ADD_IN_EDGE` and `Edge/RECREATE_OBJECT` is
               // redundant. Also, `Edge/RECREATE_OBJECT` isn't available when
@@ -1027,21 +1488,15 @@ void Storage::Accessor::Abort() {
               break;
             }
             case Delta::Action::REMOVE_IN_EDGE: {
-              std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{current->vertex_edge.edge_type,
-                                                             current->vertex_edge.vertex, current->vertex_edge.edge};
-              auto it = std::find(vertex->in_edges.begin(), vertex->in_edges.end(), link);
-              MG_ASSERT(it != vertex->in_edges.end(), "Invalid database state!");
-              std::swap(*it, *vertex->in_edges.rbegin());
-              vertex->in_edges.pop_back();
+              const auto &link = current->vertex_edge;
+              auto removed = vertex->in_edges.Remove(link.edge_type, link.vertex, link.edge);
+              MG_ASSERT(removed, "Invalid database state!");
               break;
             }
             case Delta::Action::REMOVE_OUT_EDGE: {
-              std::tuple<EdgeTypeId, Vertex *, EdgeRef> link{current->vertex_edge.edge_type,
-                                                             current->vertex_edge.vertex, current->vertex_edge.edge};
-              auto it = std::find(vertex->out_edges.begin(), vertex->out_edges.end(), link);
-              MG_ASSERT(it != vertex->out_edges.end(), "Invalid database state!");
-              std::swap(*it, *vertex->out_edges.rbegin());
-              vertex->out_edges.pop_back();
+              const auto &link = current->vertex_edge;
+              auto removed = vertex->out_edges.Remove(link.edge_type, link.vertex, link.edge);
+              MG_ASSERT(removed, "Invalid database state!");
               // Decrement edge count. We only decrement the count here because
               // the information in `REMOVE_IN_EDGE` and `Edge/DELETE_OBJECT` is
               // redundant. Also, `Edge/DELETE_OBJECT` isn't available when edge
@@ -1123,6 +1578,8 @@ void Storage::Accessor::Abort() {
       // Release engine lock because we don't have to hold it anymore and
       // emplace back could take a long time.
       engine_guard.unlock();
+      storage_->gc_pending_delta_bytes_.fetch_add(transaction_.deltas.size() * sizeof(Delta),
+                                                  std::memory_order_acq_rel);
       garbage_undo_buffers.emplace_back(mark_timestamp, std::move(transaction_.deltas));
     });
     storage_->deleted_vertices_.WithLock(
@@ -1133,14 +1590,27 @@ void Storage::Accessor::Abort() {
 
   storage_->commit_log_->MarkFinished(transaction_.start_timestamp);
   is_transaction_active_ = false;
+
+  if (storage_->config_.gc.type == Config::Gc::Type::ADAPTIVE &&
+      storage_->CheckGcTrigger(storage_->committed_transactions_->size())) {
+    storage_->gc_runner_.Notify();
+  }
 }
 
 void Storage::Accessor::FinalizeTransaction() {
   if (commit_timestamp_) {
     storage_->commit_log_->MarkFinished(*commit_timestamp_);
-    storage_->committed_transactions_.WithLock(
-        [&](auto &committed_transactions) { committed_transactions.emplace_back(std::move(transaction_)); });
+    storage_->gc_pending_delta_bytes_.fetch_add(transaction_.deltas.size() * sizeof(Delta), std::memory_order_acq_rel);
+    uint64_t num_committed_transactions = 0;
+    storage_->committed_transactions_.WithLock([&](auto &committed_transactions) {
+      committed_transactions.emplace_back(std::move(transaction_));
+      num_committed_transactions = committed_transactions.size();
+    });
     commit_timestamp_.reset();
+    if (storage_->config_.gc.type == Config::Gc::Type::ADAPTIVE &&
+        storage_->CheckGcTrigger(num_committed_transactions)) {
+      storage_->gc_runner_.Notify();
+    }
   }
 }
 
@@ -1167,7 +1637,32 @@ EdgeTypeId Storage::NameToEdgeType(const std::string_view name) {
 utils::BasicResult<StorageIndexDefinitionError, void> Storage::CreateIndex(
     LabelId label, const std::optional<uint64_t> desired_commit_timestamp) {
   std::unique_lock<utils::RWLock> storage_guard(main_lock_);
-  if (!indices_.label_index.CreateIndex(label, vertices_.access())) {
+  if (indices_.label_index.IndexBeingCreated(label)) {
+    return StorageIndexDefinitionError{IndexBeingCreatedError{}};
+  }
+  if (config_.index_creation.concurrent) {
+    // The entries are resolved under the lock. They can't be freed while the
+    // index is populated without the lock because an index that is being
+    // created can't be dropped.
+    auto *index = indices_.label_index.RegisterIndex(label);
+    if (!index) {
+      return StorageIndexDefinitionError{IndexDefinitionError{}};
+    }
+    storage_guard.unlock();
+    try {
+      // The transaction keeps the deltas that are traversed while the index
+      // is populated from being garbage collected.
+      auto accessor = Access();
+      LabelIndex::PopulateIndex(index, label, vertices_.access(), accessor.transaction_.start_timestamp,
+                                config_.index_creation.num_threads);
+    } catch (...) {
+      storage_guard.lock();
+      indices_.label_index.UnregisterIndex(label);
+      throw;
+    }
+    storage_guard.lock();
+    indices_.label_index.PublishIndex(label);
+  } else if (!indices_.label_index.CreateIndex(label, vertices_.access(), config_.index_creation.num_threads)) {
     return StorageIndexDefinitionError{IndexDefinitionError{}};
   }
   const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
@@ -1186,7 +1681,29 @@ utils::BasicResult<StorageIndexDefinitionError, void> Storage::CreateIndex(
 utils::BasicResult<StorageIndexDefinitionError, void> Storage::CreateIndex(
     LabelId label, PropertyId property, const std::optional<uint64_t> desired_commit_timestamp) {
   std::unique_lock<utils::RWLock> storage_guard(main_lock_);
-  if (!indices_.label_property_index.CreateIndex(label, property, vertices_.access())) {
+  if (indices_.label_property_index.IndexBeingCreated(label, property)) {
+    return StorageIndexDefinitionError{IndexBeingCreatedError{}};
+  }
+  if (config_.index_creation.concurrent) {
+    // See `CreateIndex(LabelId label)`.
+    auto *index = indices_.label_property_index.RegisterIndex(label, property);
+    if (!index) {
+      return StorageIndexDefinitionError{IndexDefinitionError{}};
+    }
+    storage_guard.unlock();
+    try {
+      auto accessor = Access();
+      LabelPropertyIndex::PopulateIndex(index, label, property, vertices_.access(),
+                                        accessor.transaction_.start_timestamp, config_.index_creation.num_threads);
+    } catch (...) {
+      storage_guard.lock();
+      indices_.label_property_index.UnregisterIndex(label, property);
+      throw;
+    }
+    storage_guard.lock();
+    indices_.label_property_index.PublishIndex(label, property);
+  } else if (!indices_.label_property_index.CreateIndex(label, property, vertices_.access(),
+                                                        config_.index_creation.num_threads)) {
     return StorageIndexDefinitionError{IndexDefinitionError{}};
   }
   const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
@@ -1205,6 +1722,9 @@ utils::BasicResult<StorageIndexDefinitionError, void> Storage::CreateIndex(
 utils::BasicResult<StorageIndexDefinitionError, void> Storage::DropIndex(
     LabelId label, const std::optional<uint64_t> desired_commit_timestamp) {
   std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  if (indices_.label_index.IndexBeingCreated(label)) {
+    return StorageIndexDefinitionError{IndexBeingCreatedError{}};
+  }
   if (!indices_.label_index.DropIndex(label)) {
     return StorageIndexDefinitionError{IndexDefinitionError{}};
   }
@@ -1224,6 +1744,9 @@ utils::BasicResult<StorageIndexDefinitionError, void> Storage::DropIndex(
 utils::BasicResult<StorageIndexDefinitionError, void> Storage::DropIndex(
     LabelId label, PropertyId property, const std::optional<uint64_t> desired_commit_timestamp) {
   std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  if (indices_.label_property_index.IndexBeingCreated(label, property)) {
+    return StorageIndexDefinitionError{IndexBeingCreatedError{}};
+  }
   if (!indices_.label_property_index.DropIndex(label, property)) {
     return StorageIndexDefinitionError{IndexDefinitionError{}};
   }
@@ -1242,9 +1765,162 @@ utils::BasicResult<StorageIndexDefinitionError, void> Storage::DropIndex(
   return StorageIndexDefinitionError{ReplicationError{}};
 }
 
+utils::BasicResult<StorageIndexDefinitionError, void> Storage::CreateIndex(
+    LabelId label, const std::vector<PropertyId> &properties, const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  const std::set<PropertyId> unique_properties(properties.begin(), properties.end());
+  if (properties.size() < 2 || unique_properties.size() != properties.size() ||
+      !indices_.label_property_composite_index.CreateIndex(label, properties, vertices_.access(),
+                                                           config_.index_creation.num_threads)) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
+  }
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  const auto success = AppendToWalDataDefinition(
+      durability::StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE, label, properties, commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  last_commit_timestamp_ = commit_timestamp;
+
+  if (success) {
+    return {};
+  }
+
+  return StorageIndexDefinitionError{ReplicationError{}};
+}
+
+utils::BasicResult<StorageIndexDefinitionError, void> Storage::DropIndex(
+    LabelId label, const std::vector<PropertyId> &properties, const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  if (!indices_.label_property_composite_index.DropIndex(label, properties)) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
+  }
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  const auto success = AppendToWalDataDefinition(
+      durability::StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_DROP, label, properties, commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  last_commit_timestamp_ = commit_timestamp;
+
+  if (success) {
+    return {};
+  }
+
+  return StorageIndexDefinitionError{ReplicationError{}};
+}
+
+utils::BasicResult<StorageIndexDefinitionError, void> Storage::CreateIndex(
+    EdgeTypeId edge_type, const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  if (!indices_.edge_type_index.CreateIndex(edge_type, vertices_.access())) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
+  }
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  const auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::EDGE_TYPE_INDEX_CREATE,
+                                                 edge_type, {}, commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  last_commit_timestamp_ = commit_timestamp;
+
+  if (success) {
+    return {};
+  }
+
+  return StorageIndexDefinitionError{ReplicationError{}};
+}
+
+utils::BasicResult<StorageIndexDefinitionError, void> Storage::CreateIndex(
+    EdgeTypeId edge_type, PropertyId property, const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  if (!config_.items.properties_on_edges ||
+      !indices_.edge_type_property_index.CreateIndex(edge_type, property, vertices_.access())) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
+  }
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  const auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::EDGE_TYPE_PROPERTY_INDEX_CREATE,
+                                                 edge_type, {property}, commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  last_commit_timestamp_ = commit_timestamp;
+
+  if (success) {
+    return {};
+  }
+
+  return StorageIndexDefinitionError{ReplicationError{}};
+}
+
+utils::BasicResult<StorageIndexDefinitionError, void> Storage::DropIndex(
+    EdgeTypeId edge_type, const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  if (!indices_.edge_type_index.DropIndex(edge_type)) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
+  }
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  const auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::EDGE_TYPE_INDEX_DROP, edge_type,
+                                                 {}, commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  last_commit_timestamp_ = commit_timestamp;
+
+  if (success) {
+    return {};
+  }
+
+  return StorageIndexDefinitionError{ReplicationError{}};
+}
+
+utils::BasicResult<StorageIndexDefinitionError, void> Storage::DropIndex(
+    EdgeTypeId edge_type, PropertyId property, const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  if (!indices_.edge_type_property_index.DropIndex(edge_type, property)) {
+    return StorageIndexDefinitionError{IndexDefinitionError{}};
+  }
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  const auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::EDGE_TYPE_PROPERTY_INDEX_DROP,
+                                                 edge_type, {property}, commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  last_commit_timestamp_ = commit_timestamp;
+
+  if (success) {
+    return {};
+  }
+
+  return StorageIndexDefinitionError{ReplicationError{}};
+}
+
 IndicesInfo Storage::ListAllIndices() const {
   std::shared_lock<utils::RWLock> storage_guard_(main_lock_);
-  return {indices_.label_index.ListIndices(), indices_.label_property_index.ListIndices()};
+  return {indices_.label_index.ListIndices(), indices_.label_property_index.ListIndices(),
+          indices_.label_property_composite_index.ListIndices(), indices_.edge_type_index.ListIndices(),
+          indices_.edge_type_property_index.ListIndices()};
+}
+
+bool Storage::CreatePropertyColumn(LabelId label, PropertyId property) {
+  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  return property_columns_.CreateColumn(label, property, vertices_.access());
+}
+
+bool Storage::DropPropertyColumn(LabelId label, PropertyId property) {
+  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  return property_columns_.DropColumn(label, property);
+}
+
+std::vector<std::pair<LabelId, PropertyId>> Storage::ListAllPropertyColumns() const {
+  std::shared_lock<utils::RWLock> storage_guard_(main_lock_);
+  return property_columns_.ListColumns();
+}
+
+utils::BasicResult<StorageGraphStatisticsError, void> Storage::SetGraphStatistics(
+    GraphStatistics statistics, const std::optional<uint64_t> desired_commit_timestamp) {
+  std::unique_lock<utils::RWLock> storage_guard(main_lock_);
+  const auto named = ToNamedGraphStatistics(statistics, &name_id_mapper_);
+  graph_statistics_ = std::move(statistics);
+  const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
+  const auto success =
+      AppendToWalDataDefinition(durability::StorageGlobalOperation::GRAPH_STATISTICS_SET, named, commit_timestamp);
+  commit_log_->MarkFinished(commit_timestamp);
+  last_commit_timestamp_ = commit_timestamp;
+
+  if (success) {
+    return {};
+  }
+
+  return StorageGraphStatisticsError{ReplicationError{}};
 }
 
 utils::BasicResult<StorageExistenceConstraintDefinitionError, void> Storage::CreateExistenceConstraint(
@@ -1303,7 +1979,7 @@ Storage::CreateUniqueConstraint(LabelId label, const std::set<PropertyId> &prope
   }
   const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
   auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::UNIQUE_CONSTRAINT_CREATE, label,
-                                           properties, commit_timestamp);
+                                           {properties.begin(), properties.end()}, commit_timestamp);
   commit_log_->MarkFinished(commit_timestamp);
   last_commit_timestamp_ = commit_timestamp;
 
@@ -1324,7 +2000,7 @@ Storage::DropUniqueConstraint(LabelId label, const std::set<PropertyId> &propert
   }
   const auto commit_timestamp = CommitTimestamp(desired_commit_timestamp);
   auto success = AppendToWalDataDefinition(durability::StorageGlobalOperation::UNIQUE_CONSTRAINT_DROP, label,
-                                           properties, commit_timestamp);
+                                           {properties.begin(), properties.end()}, commit_timestamp);
   commit_log_->MarkFinished(commit_timestamp);
   last_commit_timestamp_ = commit_timestamp;
 
@@ -1340,15 +2016,79 @@ ConstraintsInfo Storage::ListAllConstraints() const {
   return {ListExistenceConstraints(constraints_), constraints_.unique_constraints.ListConstraints()};
 }
 
-StorageInfo Storage::GetInfo() const {
+void Storage::ApplyEdgeTypeCountDiffs(const std::unordered_map<EdgeTypeId, int64_t> &diffs) {
+  if (diffs.empty()) return;
+  edge_type_count_.WithLock([&](auto &edge_type_count) {
+    for (const auto &[edge_type, diff] : diffs) edge_type_count[edge_type] += diff;
+  });
+}
+
+void Storage::RecountEdgeTypes() {
+  std::unordered_map<EdgeTypeId, int64_t> edge_type_count;
+  auto acc = vertices_.access();
+  for (const auto &vertex : acc) {
+    for (const auto &[edge_type, to_vertex, edge] : vertex.out_edges) {
+      ++edge_type_count[edge_type];
+    }
+  }
+  edge_type_count_.WithLock([&](auto &count) { count = std::move(edge_type_count); });
+}
+
+uint64_t Storage::SampleVertexFootprint() {
+  // The footprint is measured on the first vertex of each chunk of the vertex
+  // skip list instead of on all vertices so that the cost doesn't grow with
+  // the graph. The chunks start at nodes of the highest skip list layer that
+  // has enough of them, and the node heights are random, so the sampled
+  // vertices are spread evenly over the list. When there are fewer vertices
+  // than samples, all of them are measured.
+  static constexpr uint64_t kFootprintSamples = 1024;
+  auto acc = vertices_.access();
+  uint64_t samples = 0;
+  uint64_t total_bytes = 0;
+  for (auto &chunk : acc.chunks(kFootprintSamples)) {
+    auto it = chunk.begin();
+    if (it == chunk.end()) continue;
+    const Vertex &vertex = *it;
+    std::lock_guard<utils::SpinLock> guard(vertex.lock);
+    total_bytes += sizeof(Vertex) + vertex.in_edges.HeapSize() + vertex.out_edges.HeapSize();
+    ++samples;
+  }
+  return samples == 0 ? 0 : total_bytes / samples;
+}
+
+StorageInfo Storage::GetInfo() {
   auto vertex_count = vertices_.size();
   auto edge_count = edge_count_.load(std::memory_order_acquire);
   double average_degree = 0.0;
+  uint64_t average_vertex_footprint = 0;
   if (vertex_count) {
     average_degree = 2.0 * static_cast<double>(edge_count) / vertex_count;
+    average_vertex_footprint = SampleVertexFootprint();
   }
-  return {vertex_count, edge_count, average_degree, utils::GetMemoryUsage(),
-          utils::GetDirDiskUsage(config_.durability.storage_directory)};
+  auto gc_info = *gc_info_.Lock();
+  gc_info.pending_transactions = committed_transactions_->size();
+  gc_info.pending_undo_buffers = garbage_undo_buffers_->size();
+  gc_info.pending_vertices += deleted_vertices_->size();
+  gc_info.pending_edges = deleted_edges_->size();
+  gc_info.pending_delta_bytes = gc_pending_delta_bytes_.load(std::memory_order_acquire);
+  return {vertex_count,
+          edge_count,
+          average_degree,
+          average_vertex_footprint,
+          utils::GetMemoryUsage(),
+          utils::GetDirDiskUsage(config_.durability.storage_directory),
+          gc_info,
+          object_memory_.GetStats()};
+}
+
+EdgesIterable Storage::Accessor::Edges(EdgeTypeId edge_type, View view) {
+  return EdgesIterable(storage_->indices_.edge_type_index.Edges(edge_type, view, &transaction_));
+}
+
+EdgesIterable Storage::Accessor::Edges(EdgeTypeId edge_type, PropertyId property, const PropertyValue &value,
+                                       View view) {
+  return EdgesIterable(
+      storage_->indices_.edge_type_property_index.Edges(edge_type, property, value, view, &transaction_));
 }
 
 VerticesIterable Storage::Accessor::Vertices(LabelId label, View view) {
@@ -1373,6 +2113,14 @@ VerticesIterable Storage::Accessor::Vertices(LabelId label, PropertyId property,
       storage_->indices_.label_property_index.Vertices(label, property, lower_bound, upper_bound, view, &transaction_));
 }
 
+VerticesIterable Storage::Accessor::Vertices(LabelId label, const std::vector<PropertyId> &properties,
+                                             const std::vector<PropertyValue> &prefix,
+                                             const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+                                             const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view) {
+  return VerticesIterable(storage_->indices_.label_property_composite_index.Vertices(
+      label, properties, prefix, lower_bound, upper_bound, view, &transaction_));
+}
+
 Transaction Storage::CreateTransaction(IsolationLevel isolation_level) {
   // We acquire the transaction engine lock here because we access (and
   // modify) the transaction engine variables (`transaction_id` and
@@ -1397,6 +2145,154 @@ Transaction Storage::CreateTransaction(IsolationLevel isolation_level) {
   return {transaction_id, start_timestamp, isolation_level};
 }
 
+namespace {
+
+// Minimum number of transactions whose deltas are unlinked by a single GC
+// thread, and minimum number of undo buffers or objects that are freed by a
+// single GC thread. Smaller amounts of work aren't worth starting a thread.
+inline constexpr size_t kGcMinTransactionsPerThread = 16;
+inline constexpr size_t kGcMinObjectsPerThread = 1024;
+
+// Splits the items into at most `num_threads` chunks of at least
+// `min_chunk_size` items and calls `callback(chunk)` for each of the chunks.
+// The chunks are processed in parallel, with the calling thread processing
+// one of them.
+template <typename TItem, typename TCallback>
+void ForEachChunkInParallel(std::vector<TItem> &items, uint64_t num_threads, size_t min_chunk_size,
+                            const TCallback &callback) {
+  if (items.empty()) return;
+  const auto chunk_count = std::clamp<size_t>(items.size() / min_chunk_size, 1, std::max<uint64_t>(num_threads, 1));
+  const auto chunk_size = (items.size() + chunk_count - 1) / chunk_count;
+  std::vector<std::function<void()>> tasks;
+  tasks.reserve(chunk_count);
+  for (size_t begin = 0; begin < items.size(); begin += chunk_size) {
+    tasks.emplace_back([&items, &callback, begin, size = std::min(chunk_size, items.size() - begin)] {
+      // The garbage collector mustn't fail because of the memory limit.
+      utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_blocker;
+      callback(std::span<TItem>(items).subspan(begin, size));
+    });
+  }
+  utils::RunTasksInParallel(tasks, num_threads);
+}
+
+// Unlinks all deltas of the committed transaction from their version chains.
+// The objects that were deleted by the transaction are appended to
+// `deleted_vertices` and `deleted_edges`. Deltas of different transactions
+// can be unlinked concurrently because each version chain is modified only
+// while the lock of its owner is held.
+void UnlinkDeltas(Transaction *transaction, std::list<Gid> *deleted_vertices, std::list<Gid> *deleted_edges) {
+  auto commit_timestamp = transaction->commit_timestamp->load(std::memory_order_acquire);
+
+  // When unlinking a delta which is the first delta in its version chain,
+  // special care has to be taken to avoid the following race condition:
+  //
+  // [Vertex] --> [Delta A]
+  //
+  //    GC thread: Delta A is the first in its chain, it must be unlinked from
+  //               vertex and marked for deletion
+  //    TX thread: Update vertex and add Delta B with Delta A as next
+  //
+  // [Vertex] --> [Delta B] <--> [Delta A]
+  //
+  //    GC thread: Unlink delta from Vertex
+  //
+  // [Vertex] --> (nullptr)
+  //
+  // When processing a delta that is the first one in its chain, we
+  // obtain the corresponding vertex or edge lock, and then verify that this
+  // delta still is the first in its chain.
+  // When processing a delta that is in the middle of the chain we only
+  // process the final delta of the given transaction in that chain. We
+  // determine the owner of the chain (either a vertex or an edge), obtain the
+  // corresponding lock, and then verify that this delta is still in the same
+  // position as it was before taking the lock.
+  //
+  // Even though the delta chain is lock-free (both `next` and `prev`) the
+  // chain should not be modified without taking the lock from the object that
+  // owns the chain (either a vertex or an edge). Modifying the chain without
+  // taking the lock will cause subtle race conditions that will leave the
+  // chain in a broken state.
+  // The chain can be only read without taking any locks.
+
+  for (Delta &delta : transaction->deltas) {
+    while (true) {
+      auto prev = delta.prev.Get();
+      switch (prev.type) {
+        case PreviousPtr::Type::VERTEX: {
+          Vertex *vertex = prev.vertex;
+          std::lock_guard<utils::SpinLock> vertex_guard(vertex->lock);
+          if (vertex->delta != &delta) {
+            // Something changed, we're not the first delta in the chain
+            // anymore.
+            continue;
+          }
+          vertex->delta = nullptr;
+          if (vertex->deleted) {
+            deleted_vertices->push_back(vertex->gid);
+          }
+          break;
+        }
+        case PreviousPtr::Type::EDGE: {
+          Edge *edge = prev.edge;
+          std::lock_guard<utils::SpinLock> edge_guard(edge->lock);
+          if (edge->delta != &delta) {
+            // Something changed, we're not the first delta in the chain
+            // anymore.
+            continue;
+          }
+          edge->delta = nullptr;
+          if (edge->deleted) {
+            deleted_edges->push_back(edge->gid);
+          }
+          break;
+        }
+        case PreviousPtr::Type::DELTA: {
+          if (prev.delta->timestamp->load(std::memory_order_acquire) == commit_timestamp) {
+            // The delta that is newer than this one is also a delta from this
+            // transaction. We skip the current delta and will remove it as a
+            // part of the suffix later.
+            break;
+          }
+          std::unique_lock<utils::SpinLock> guard;
+          {
+            // We need to find the parent object in order to be able to use
+            // its lock.
+            auto parent = prev;
+            while (parent.type == PreviousPtr::Type::DELTA) {
+              parent = parent.delta->prev.Get();
+            }
+            switch (parent.type) {
+              case PreviousPtr::Type::VERTEX:
+                guard = std::unique_lock<utils::SpinLock>(parent.vertex->lock);
+                break;
+              case PreviousPtr::Type::EDGE:
+                guard = std::unique_lock<utils::SpinLock>(parent.edge->lock);
+                break;
+              case PreviousPtr::Type::DELTA:
+              case PreviousPtr::Type::NULLPTR:
+                LOG_FATAL("Invalid database state!");
+            }
+          }
+          if (delta.prev.Get() != prev) {
+            // Something changed, we could now be the first delta in the
+            // chain.
+            continue;
+          }
+          Delta *prev_delta = prev.delta;
+          prev_delta->next.store(nullptr, std::memory_order_release);
+          break;
+        }
+        case PreviousPtr::Type::NULLPTR: {
+          LOG_FATAL("Invalid pointer!");
+        }
+      }
+      break;
+    }
+  }
+}
+
+}  // namespace
+
 template <bool force>
 void Storage::CollectGarbage() {
   if constexpr (force) {
@@ -1433,11 +2329,14 @@ void Storage::CollectGarbage() {
     return;
   }
 
+  const auto num_threads = config_.gc.num_threads;
+  utils::Timer phase_timer;
+
   uint64_t oldest_active_start_timestamp = commit_log_->OldestActive();
   // We don't move undo buffers of unlinked transactions to garbage_undo_buffers
   // list immediately, because we would have to repeatedly take
   // garbage_undo_buffers lock.
-  std::list<std::pair<uint64_t, std::list<Delta>>> unlinked_undo_buffers;
+  std::list<std::pair<uint64_t, UndoBuffer>> unlinked_undo_buffers;
 
   // We will only free vertices deleted up until now in this GC cycle, and we
   // will do it after cleaning-up the indices. That way we are sure that all
@@ -1453,147 +2352,74 @@ void Storage::CollectGarbage() {
   // eliminates high CPU usage when the GC doesn't have to clean up anything.
   bool run_index_cleanup = !committed_transactions_->empty() || !garbage_undo_buffers_->empty();
 
-  while (true) {
-    // We don't want to hold the lock on commited transactions for too long,
-    // because that prevents other transactions from committing.
-    Transaction *transaction;
-    {
-      auto committed_transactions_ptr = committed_transactions_.Lock();
-      if (committed_transactions_ptr->empty()) {
-        break;
-      }
-      transaction = &committed_transactions_ptr->front();
+  // The committed transactions are sorted by their commit timestamps, so the
+  // transactions whose deltas won't be applied by any transaction anymore are
+  // all at the front of the list. They are taken out of the list at once so
+  // that the lock on committed transactions, which prevents other
+  // transactions from committing, is held only briefly.
+  std::list<Transaction> unlinked_transactions;
+  committed_transactions_.WithLock([&](auto &committed_transactions) {
+    auto end = committed_transactions.begin();
+    while (end != committed_transactions.end() &&
+           end->commit_timestamp->load(std::memory_order_acquire) < oldest_active_start_timestamp) {
+      ++end;
     }
+    unlinked_transactions.splice(unlinked_transactions.end(), committed_transactions, committed_transactions.begin(),
+                                 end);
+  });
 
-    auto commit_timestamp = transaction->commit_timestamp->load(std::memory_order_acquire);
-    if (commit_timestamp >= oldest_active_start_timestamp) {
-      break;
+  {
+    std::vector<Transaction *> transactions;
+    transactions.reserve(unlinked_transactions.size());
+    for (auto &transaction : unlinked_transactions) {
+      transactions.push_back(&transaction);
     }
-
-    // When unlinking a delta which is the first delta in its version chain,
-    // special care has to be taken to avoid the following race condition:
-    //
-    // [Vertex] --> [Delta A]
-    //
-    //    GC thread: Delta A is the first in its chain, it must be unlinked from
-    //               vertex and marked for deletion
-    //    TX thread: Update vertex and add Delta B with Delta A as next
-    //
-    // [Vertex] --> [Delta B] <--> [Delta A]
-    //
-    //    GC thread: Unlink delta from Vertex
-    //
-    // [Vertex] --> (nullptr)
-    //
-    // When processing a delta that is the first one in its chain, we
-    // obtain the corresponding vertex or edge lock, and then verify that this
-    // delta still is the first in its chain.
-    // When processing a delta that is in the middle of the chain we only
-    // process the final delta of the given transaction in that chain. We
-    // determine the owner of the chain (either a vertex or an edge), obtain the
-    // corresponding lock, and then verify that this delta is still in the same
-    // position as it was before taking the lock.
-    //
-    // Even though the delta chain is lock-free (both `next` and `prev`) the
-    // chain should not be modified without taking the lock from the object that
-    // owns the chain (either a vertex or an edge). Modifying the chain without
-    // taking the lock will cause subtle race conditions that will leave the
-    // chain in a broken state.
-    // The chain can be only read without taking any locks.
-
-    for (Delta &delta : transaction->deltas) {
-      while (true) {
-        auto prev = delta.prev.Get();
-        switch (prev.type) {
-          case PreviousPtr::Type::VERTEX: {
-            Vertex *vertex = prev.vertex;
-            std::lock_guard<utils::SpinLock> vertex_guard(vertex->lock);
-            if (vertex->delta != &delta) {
-              // Something changed, we're not the first delta in the chain
-              // anymore.
-              continue;
-            }
-            vertex->delta = nullptr;
-            if (vertex->deleted) {
-              current_deleted_vertices.push_back(vertex->gid);
-            }
-            break;
-          }
-          case PreviousPtr::Type::EDGE: {
-            Edge *edge = prev.edge;
-            std::lock_guard<utils::SpinLock> edge_guard(edge->lock);
-            if (edge->delta != &delta) {
-              // Something changed, we're not the first delta in the chain
-              // anymore.
-              continue;
-            }
-            edge->delta = nullptr;
-            if (edge->deleted) {
-              current_deleted_edges.push_back(edge->gid);
-            }
-            break;
-          }
-          case PreviousPtr::Type::DELTA: {
-            if (prev.delta->timestamp->load(std::memory_order_acquire) == commit_timestamp) {
-              // The delta that is newer than this one is also a delta from this
-              // transaction. We skip the current delta and will remove it as a
-              // part of the suffix later.
-              break;
-            }
-            std::unique_lock<utils::SpinLock> guard;
-            {
-              // We need to find the parent object in order to be able to use
-              // its lock.
-              auto parent = prev;
-              while (parent.type == PreviousPtr::Type::DELTA) {
-                parent = parent.delta->prev.Get();
-              }
-              switch (parent.type) {
-                case PreviousPtr::Type::VERTEX:
-                  guard = std::unique_lock<utils::SpinLock>(parent.vertex->lock);
-                  break;
-                case PreviousPtr::Type::EDGE:
-                  guard = std::unique_lock<utils::SpinLock>(parent.edge->lock);
-                  break;
-                case PreviousPtr::Type::DELTA:
-                case PreviousPtr::Type::NULLPTR:
-                  LOG_FATAL("Invalid database state!");
-              }
-            }
-            if (delta.prev.Get() != prev) {
-              // Something changed, we could now be the first delta in the
-              // chain.
-              continue;
-            }
-            Delta *prev_delta = prev.delta;
-            prev_delta->next.store(nullptr, std::memory_order_release);
-            break;
-          }
-          case PreviousPtr::Type::NULLPTR: {
-            LOG_FATAL("Invalid pointer!");
-          }
-        }
-        break;
+    // Each chunk of transactions collects the deleted objects in its own lists
+    // which are merged once all of the deltas are unlinked.
+    std::vector<std::pair<std::list<Gid>, std::list<Gid>>> deleted_objects(std::max<uint64_t>(num_threads, 1));
+    std::atomic<size_t> next_deleted_objects{0};
+    ForEachChunkInParallel(transactions, num_threads, kGcMinTransactionsPerThread, [&](auto chunk) {
+      auto &[deleted_vertices, deleted_edges] = deleted_objects[next_deleted_objects.fetch_add(1)];
+      for (auto *transaction : chunk) {
+        UnlinkDeltas(transaction, &deleted_vertices, &deleted_edges);
       }
-    }
-
-    committed_transactions_.WithLock([&](auto &committed_transactions) {
-      unlinked_undo_buffers.emplace_back(0, std::move(transaction->deltas));
-      committed_transactions.pop_front();
     });
+    for (auto &[deleted_vertices, deleted_edges] : deleted_objects) {
+      current_deleted_vertices.splice(current_deleted_vertices.end(), deleted_vertices);
+      current_deleted_edges.splice(current_deleted_edges.end(), deleted_edges);
+    }
+  }
+  for (auto &transaction : unlinked_transactions) {
+    unlinked_undo_buffers.emplace_back(0, std::move(transaction.deltas));
   }
+  unlinked_transactions.clear();
+  const auto unlink_duration = phase_timer.Elapsed<std::chrono::microseconds>();
 
   // After unlinking deltas from vertices, we refresh the indices. That way
   // we're sure that none of the vertices from `current_deleted_vertices`
   // appears in an index, and we can safely remove the from the main storage
   // after the last currently active transaction is finished.
+  phase_timer = {};
   if (run_index_cleanup) {
     // This operation is very expensive as it traverses through all of the items
-    // in every index every time.
-    RemoveObsoleteEntries(&indices_, oldest_active_start_timestamp);
-    constraints_.unique_constraints.RemoveObsoleteEntries(oldest_active_start_timestamp);
+    // in every index every time. Each index and constraint is cleaned up by its
+    // own task.
+    std::vector<std::function<void()>> tasks;
+    CollectCleanupTasks(&indices_, oldest_active_start_timestamp, &tasks);
+    constraints_.unique_constraints.CollectCleanupTasks(oldest_active_start_timestamp, &tasks);
+    property_columns_.CollectCleanupTasks(oldest_active_start_timestamp, &tasks);
+    for (auto &task : tasks) {
+      task = [cleanup = std::move(task)] {
+        // The garbage collector mustn't fail because of the memory limit.
+        utils::MemoryTracker::OutOfMemoryExceptionBlocker oom_blocker;
+        cleanup();
+      };
+    }
+    utils::RunTasksInParallel(tasks, num_threads);
   }
+  const auto index_cleanup_duration = phase_timer.Elapsed<std::chrono::microseconds>();
 
+  phase_timer = {};
   {
     std::unique_lock<utils::SpinLock> guard(engine_lock_);
     uint64_t mark_timestamp = timestamp_;
@@ -1616,66 +2442,172 @@ void Storage::CollectGarbage() {
     }
   }
 
+  // The undo buffers that can be freed are taken out of the list, so that the
+  // lock isn't held while the deltas are being destroyed.
+  std::list<std::pair<uint64_t, UndoBuffer>> freed_undo_buffers;
   garbage_undo_buffers_.WithLock([&](auto &undo_buffers) {
     // if force is set to true we can simply delete all the leftover undos because
     // no transaction is active
-    if constexpr (force) {
-      undo_buffers.clear();
-    } else {
-      while (!undo_buffers.empty() && undo_buffers.front().first <= oldest_active_start_timestamp) {
-        undo_buffers.pop_front();
-      }
+    auto end = undo_buffers.begin();
+    while (end != undo_buffers.end() && (force || end->first <= oldest_active_start_timestamp)) {
+      ++end;
     }
+    freed_undo_buffers.splice(freed_undo_buffers.end(), undo_buffers, undo_buffers.begin(), end);
   });
-
   {
-    auto vertex_acc = vertices_.access();
-    if constexpr (force) {
-      // if force is set to true, then we have unique_lock and no transactions are active
-      // so we can clean all of the deleted vertices
-      while (!garbage_vertices_.empty()) {
-        MG_ASSERT(vertex_acc.remove(garbage_vertices_.front().second), "Invalid database state!");
-        garbage_vertices_.pop_front();
-      }
-    } else {
-      while (!garbage_vertices_.empty() && garbage_vertices_.front().first < oldest_active_start_timestamp) {
-        MG_ASSERT(vertex_acc.remove(garbage_vertices_.front().second), "Invalid database state!");
-        garbage_vertices_.pop_front();
-      }
+    std::vector<UndoBuffer *> undo_buffers;
+    undo_buffers.reserve(freed_undo_buffers.size());
+    uint64_t freed_delta_bytes = 0;
+    for (auto &[timestamp, undo_buffer] : freed_undo_buffers) {
+      undo_buffers.push_back(&undo_buffer);
+      freed_delta_bytes += undo_buffer.size() * sizeof(Delta);
     }
+    gc_pending_delta_bytes_.fetch_sub(freed_delta_bytes, std::memory_order_acq_rel);
+    ForEachChunkInParallel(undo_buffers, num_threads, kGcMinObjectsPerThread, [](auto chunk) {
+      for (auto *undo_buffer : chunk) undo_buffer->clear();
+    });
+    freed_undo_buffers.clear();
   }
+
   {
-    auto edge_acc = edges_.access();
-    for (auto edge : current_deleted_edges) {
-      MG_ASSERT(edge_acc.remove(edge), "Invalid database state!");
+    // if force is set to true, then we have unique_lock and no transactions are active
+    // so we can clean all of the deleted vertices
+    std::vector<Gid> freed_vertices;
+    while (!garbage_vertices_.empty() && (force || garbage_vertices_.front().first < oldest_active_start_timestamp)) {
+      freed_vertices.push_back(garbage_vertices_.front().second);
+      garbage_vertices_.pop_front();
     }
+    ForEachChunkInParallel(freed_vertices, num_threads, kGcMinObjectsPerThread, [this](auto chunk) {
+      auto vertex_acc = vertices_.access();
+      for (auto vertex : chunk) {
+        MG_ASSERT(vertex_acc.remove(vertex), "Invalid database state!");
+      }
+    });
   }
+  {
+    std::vector<Gid> freed_edges(current_deleted_edges.begin(), current_deleted_edges.end());
+    ForEachChunkInParallel(freed_edges, num_threads, kGcMinObjectsPerThread, [this](auto chunk) {
+      auto edge_acc = edges_.access();
+      for (auto edge : chunk) {
+        MG_ASSERT(edge_acc.remove(edge), "Invalid database state!");
+      }
+    });
+  }
+  // An empty slab of each node size is kept for reuse by the object memory,
+  // which is returned here so that it doesn't stay reserved after the objects
+  // are deleted.
+  object_memory_.ReleaseEmptySlabs();
+  const auto free_duration = phase_timer.Elapsed<std::chrono::microseconds>();
+
+  gc_info_.WithLock([&](auto &gc_info) {
+    gc_info.pending_vertices = garbage_vertices_.size();
+    if (!run_index_cleanup) return;
+    ++gc_info.runs;
+    gc_info.last_unlink_duration = unlink_duration;
+    gc_info.last_index_cleanup_duration = index_cleanup_duration;
+    gc_info.last_free_duration = free_duration;
+  });
 }
 
 // tell the linker he can find the CollectGarbage definitions here
 template void Storage::CollectGarbage<true>();
 template void Storage::CollectGarbage<false>();
 
+std::optional<Storage::GcTrigger> Storage::CheckGcTrigger(uint64_t committed_transactions) const {
+  const auto &config = config_.gc;
+  // The garbage left after the last run can be larger than the current one
+  // because the run and the finished transactions race to update it.
+  const auto transactions_after_run = gc_transactions_after_run_.load(std::memory_order_acquire);
+  const auto new_transactions =
+      committed_transactions > transactions_after_run ? committed_transactions - transactions_after_run : 0;
+  if (config.trigger_transactions != 0 && new_transactions >= config.trigger_transactions) {
+    return GcTrigger::TRANSACTIONS;
+  }
+  const auto delta_bytes = gc_pending_delta_bytes_.load(std::memory_order_acquire);
+  const auto delta_bytes_after_run = gc_delta_bytes_after_run_.load(std::memory_order_acquire);
+  const auto new_delta_bytes = delta_bytes > delta_bytes_after_run ? delta_bytes - delta_bytes_after_run : 0;
+  if (config.trigger_delta_bytes != 0 && new_delta_bytes >= config.trigger_delta_bytes) {
+    return GcTrigger::DELTA_BYTES;
+  }
+  if (config.trigger_memory_ratio > 0.0 && (new_transactions != 0 || new_delta_bytes != 0)) {
+    const auto limit = utils::total_memory_tracker.HardLimit();
+    if (limit > 0 &&
+        static_cast<double>(utils::total_memory_tracker.Amount()) >= config.trigger_memory_ratio * limit) {
+      return GcTrigger::MEMORY;
+    }
+  }
+  return std::nullopt;
+}
+
+void Storage::RunAdaptiveGc() {
+  auto trigger = CheckGcTrigger(committed_transactions_->size());
+  const auto now = std::chrono::steady_clock::now();
+  if (!trigger) {
+    if (now < gc_next_run_) return;
+    trigger = GcTrigger::INTERVAL;
+  }
+
+  const auto runs = gc_info_->runs;
+  CollectGarbage<false>();
+  gc_transactions_after_run_.store(committed_transactions_->size(), std::memory_order_release);
+  gc_delta_bytes_after_run_.store(gc_pending_delta_bytes_.load(std::memory_order_acquire),
+                                  std::memory_order_release);
+
+  // The interval is backed off while the runs don't find anything to collect.
+  if (gc_info_->runs == runs) {
+    gc_interval_ = std::max(config_.gc.interval, std::min(2 * gc_interval_, config_.gc.max_interval));
+  } else {
+    gc_interval_ = config_.gc.interval;
+  }
+  gc_next_run_ = now + gc_interval_;
+
+  gc_info_.WithLock([&](auto &gc_info) {
+    gc_info.interval = gc_interval_;
+    switch (*trigger) {
+      case GcTrigger::INTERVAL:
+        ++gc_info.interval_triggers;
+        EventCounter::IncrementCounter(EventCounter::GcIntervalTriggered);
+        break;
+      case GcTrigger::TRANSACTIONS:
+        ++gc_info.transactions_triggers;
+        EventCounter::IncrementCounter(EventCounter::GcTransactionsTriggered);
+        break;
+      case GcTrigger::DELTA_BYTES:
+        ++gc_info.delta_bytes_triggers;
+        EventCounter::IncrementCounter(EventCounter::GcDeltaBytesTriggered);
+        break;
+      case GcTrigger::MEMORY:
+        ++gc_info.memory_triggers;
+        EventCounter::IncrementCounter(EventCounter::GcMemoryTriggered);
+        break;
+    }
+  });
+}
+
 bool Storage::InitializeWalFile() {
   if (config_.durability.snapshot_wal_mode != Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL)
     return false;
   if (!wal_file_) {
     wal_file_.emplace(wal_directory_, uuid_, epoch_id_, config_.items, &name_id_mapper_, wal_seq_num_++,
-                      &file_retainer_);
+                      &file_retainer_, config_.durability.compression, config_.durability.async_writes);
   }
   return true;
 }
 
 void Storage::FinalizeWalFile() {
+  const auto seq_num = wal_group_commit_.Register();
   ++wal_unsynced_transactions_;
   if (wal_unsynced_transactions_ >= config_.durability.wal_file_flush_every_n_tx) {
     wal_file_->Sync();
     wal_unsynced_transactions_ = 0;
+    wal_group_commit_.MarkDurable(seq_num);
   }
   if (wal_file_->GetSize() / 1024 >= config_.durability.wal_file_size_kibibytes) {
+    // The finalized WAL file is synced.
     wal_file_->FinalizeWal();
     wal_file_ = std::nullopt;
     wal_unsynced_transactions_ = 0;
+    wal_group_commit_.MarkDurable(seq_num);
   } else {
     // Try writing the internal buffer if possible, if not
     // the data should be written as soon as it's possible
@@ -1685,6 +2617,36 @@ void Storage::FinalizeWalFile() {
   }
 }
 
+uint64_t Storage::SyncWalFile() {
+  std::optional<utils::FileSyncHandle> sync_handle;
+  uint64_t seq_num = 0;
+  {
+    std::lock_guard<utils::SpinLock> guard(engine_lock_);
+    seq_num = wal_group_commit_.LastRegistered();
+    // If there is no current WAL file, the previous one was synced when it
+    // was finalized.
+    if (wal_file_) sync_handle.emplace(wal_file_->FlushForSync());
+  }
+  if (sync_handle) sync_handle->Sync();
+  return seq_num;
+}
+
+void Storage::WaitWalDurable(uint64_t seq_num, Config::Durability::CommitDurability commit_durability) {
+  switch (commit_durability) {
+    case Config::Durability::CommitDurability::ASYNC:
+      break;
+    case Config::Durability::CommitDurability::FSYNC_ON_COMMIT:
+      wal_group_commit_.WaitDurable(seq_num, [this] { return SyncWalFile(); });
+      break;
+    case Config::Durability::CommitDurability::PERIODIC_FSYNC: {
+      auto pending = wal_periodic_sync_pending_.load(std::memory_order_acquire);
+      while (pending < seq_num && !wal_periodic_sync_pending_.compare_exchange_weak(pending, seq_num)) {
+      }
+      break;
+    }
+  }
+}
+
 bool Storage::AppendToWalDataManipulation(const Transaction &transaction, uint64_t final_commit_timestamp) {
   if (!InitializeWalFile()) {
     return true;
@@ -1872,21 +2834,22 @@ bool Storage::AppendToWalDataManipulation(const Transaction &transaction, uint64
   return finalized_on_all_replicas;
 }
 
-bool Storage::AppendToWalDataDefinition(durability::StorageGlobalOperation operation, LabelId label,
-                                        const std::set<PropertyId> &properties, uint64_t final_commit_timestamp) {
+template <typename... TArgs>
+bool Storage::AppendToWalDataDefinitionImpl(durability::StorageGlobalOperation operation,
+                                            uint64_t final_commit_timestamp, const TArgs &...args) {
   if (!InitializeWalFile()) {
     return true;
   }
 
   auto finalized_on_all_replicas = true;
-  wal_file_->AppendOperation(operation, label, properties, final_commit_timestamp);
+  wal_file_->AppendOperation(operation, args..., final_commit_timestamp);
   {
     if (replication_role_.load() == ReplicationRole::MAIN) {
       replication_clients_.WithLock([&](auto &clients) {
         for (auto &client : clients) {
           client->StartTransactionReplication(wal_file_->SequenceNumber());
           client->IfStreamingTransaction(
-              [&](auto &stream) { stream.AppendOperation(operation, label, properties, final_commit_timestamp); });
+              [&](auto &stream) { stream.AppendOperation(operation, args..., final_commit_timestamp); });
 
           const auto finalized = client->FinalizeTransactionReplication();
           if (client->Mode() == replication::ReplicationMode::SYNC) {
@@ -1900,6 +2863,21 @@ bool Storage::AppendToWalDataDefinition(durability::StorageGlobalOperation opera
   return finalized_on_all_replicas;
 }
 
+bool Storage::AppendToWalDataDefinition(durability::StorageGlobalOperation operation, LabelId label,
+                                        const std::vector<PropertyId> &properties, uint64_t final_commit_timestamp) {
+  return AppendToWalDataDefinitionImpl(operation, final_commit_timestamp, label, properties);
+}
+
+bool Storage::AppendToWalDataDefinition(durability::StorageGlobalOperation operation, EdgeTypeId edge_type,
+                                        const std::vector<PropertyId> &properties, uint64_t final_commit_timestamp) {
+  return AppendToWalDataDefinitionImpl(operation, final_commit_timestamp, edge_type, properties);
+}
+
+bool Storage::AppendToWalDataDefinition(durability::StorageGlobalOperation operation,
+                                        const NamedGraphStatistics &statistics, uint64_t final_commit_timestamp) {
+  return AppendToWalDataDefinitionImpl(operation, final_commit_timestamp, statistics);
+}
+
 utils::BasicResult<Storage::CreateSnapshotError> Storage::CreateSnapshot() {
   if (replication_role_.load() != ReplicationRole::MAIN) {
     return CreateSnapshotError::DisabledForReplica;
@@ -1913,14 +2891,57 @@ utils::BasicResult<Storage::CreateSnapshotError> Storage::CreateSnapshot() {
   // Create the transaction used to create the snapshot.
   auto transaction = CreateTransaction(IsolationLevel::SNAPSHOT_ISOLATION);
 
-  // Create snapshot.
-  durability::CreateSnapshot(&transaction, snapshot_directory_, wal_directory_,
-                             config_.durability.snapshot_retention_count, &vertices_, &edges_, &name_id_mapper_,
-                             &indices_, &constraints_, config_.items, uuid_, epoch_id_, epoch_history_,
-                             &file_retainer_);
+  // The objects modified by the transactions which are visible to the
+  // snapshot transaction are taken for an incremental snapshot, the ones
+  // modified by the later transactions are left for the next snapshot.
+  std::optional<durability::SnapshotChanges> changes;
+  if (config_.durability.snapshot_incremental_count > 0) {
+    auto take_changes = [&transaction](auto *dirty, std::vector<Gid> *changed) {
+      for (auto it = dirty->begin(); it != dirty->end();) {
+        auto &[first_modified, last_modified] = it->second;
+        if (first_modified > transaction.start_timestamp) {
+          ++it;
+          continue;
+        }
+        changed->push_back(it->first);
+        if (last_modified > transaction.start_timestamp) {
+          // The object is written to the next snapshot as well because it
+          // was modified after the start of this one.
+          first_modified = transaction.start_timestamp + 1;
+          ++it;
+        } else {
+          it = dirty->erase(it);
+        }
+      }
+    };
+    durability::SnapshotChanges taken;
+    snapshot_dirty_objects_.WithLock([&](auto &dirty_objects) {
+      take_changes(&dirty_objects.vertices, &taken.vertices);
+      take_changes(&dirty_objects.edges, &taken.edges);
+    });
+    // An incremental snapshot which holds a large part of the graph isn't
+    // worth it, a full snapshot is created instead.
+    const auto changed_count = taken.vertices.size() + taken.edges.size();
+    if (last_snapshot_timestamp_ &&
+        incremental_snapshots_count_ < config_.durability.snapshot_incremental_count &&
+        changed_count * 2 < vertices_.size() + edges_.size()) {
+      taken.base_timestamp = *last_snapshot_timestamp_;
+      std::sort(taken.vertices.begin(), taken.vertices.end());
+      std::sort(taken.edges.begin(), taken.edges.end());
+      changes.emplace(std::move(taken));
+    }
+  }
+
+  // Create snapshot. The snapshot transaction is finalized as soon as the
+  // objects are written, so that the garbage collector isn't blocked while
+  // the rest of the snapshot is written.
+  durability::CreateSnapshot(&transaction, snapshot_directory_, wal_directory_, &vertices_, &edges_,
+                             &name_id_mapper_, &indices_, &constraints_, graph_statistics_, config_, uuid_, epoch_id_,
+                             epoch_history_, changes, &file_retainer_,
+                             [this, &transaction] { commit_log_->MarkFinished(transaction.start_timestamp); });
 
-  // Finalize snapshot transaction.
-  commit_log_->MarkFinished(transaction.start_timestamp);
+  last_snapshot_timestamp_ = transaction.start_timestamp;
+  incremental_snapshots_count_ = changes ? incremental_snapshots_count_ + 1 : 0;
   return {};
 }
 
@@ -1949,8 +2970,12 @@ void Storage::FreeMemory() {
   // SkipList is already threadsafe
   vertices_.run_gc();
   edges_.run_gc();
+  object_memory_.ReleaseEmptySlabs();
   indices_.label_index.RunGC();
   indices_.label_property_index.RunGC();
+  indices_.label_property_composite_index.RunGC();
+  indices_.edge_type_index.RunGC();
+  indices_.edge_type_property_index.RunGC();
 }
 
 uint64_t Storage::CommitTimestamp(const std::optional<uint64_t> desired_commit_timestamp) {
@@ -2000,6 +3025,13 @@ bool Storage::SetMainReplicationRole() {
     epoch_id_ = utils::GenerateUUID();
   }
 
+  {
+    // The objects modified while the instance was a replica weren't tracked,
+    // so the next snapshot has to be a full one.
+    std::lock_guard snapshot_guard(snapshot_lock_);
+    last_snapshot_timestamp_.reset();
+  }
+
   replication_role_.store(ReplicationRole::MAIN);
   return true;
 }
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -12,16 +12,22 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <filesystem>
+#include <list>
 #include <optional>
 #include <shared_mutex>
+#include <unordered_map>
+#include <utility>
 #include <variant>
+#include <vector>
 
 #include "io/network/endpoint.hpp"
 #include "kvstore/kvstore.hpp"
 #include "storage/v2/commit_log.hpp"
 #include "storage/v2/config.hpp"
 #include "storage/v2/constraints.hpp"
+#include "storage/v2/durability/group_commit.hpp"
 #include "storage/v2/durability/metadata.hpp"
 #include "storage/v2/durability/wal.hpp"
 #include "storage/v2/edge.hpp"
@@ -30,8 +36,11 @@
 #include "storage/v2/isolation_level.hpp"
 #include "storage/v2/mvcc.hpp"
 #include "storage/v2/name_id_mapper.hpp"
+#include "storage/v2/property_columns.hpp"
 #include "storage/v2/result.hpp"
+#include "storage/v2/statistics.hpp"
 #include "storage/v2/transaction.hpp"
+#include "storage/v2/undo_buffer.hpp"
 #include "storage/v2/vertex.hpp"
 #include "storage/v2/vertex_accessor.hpp"
 #include "utils/file_locker.hpp"
@@ -105,19 +114,21 @@ class AllVerticesIterable final {
 /// This class should be the primary type used by the client code to iterate
 /// over vertices inside a Storage instance.
 class VerticesIterable final {
-  enum class Type { ALL, BY_LABEL, BY_LABEL_PROPERTY };
+  enum class Type { ALL, BY_LABEL, BY_LABEL_PROPERTY, BY_LABEL_PROPERTY_COMPOSITE };
 
   Type type_;
   union {
     AllVerticesIterable all_vertices_;
     LabelIndex::Iterable vertices_by_label_;
     LabelPropertyIndex::Iterable vertices_by_label_property_;
+    LabelPropertyCompositeIndex::Iterable vertices_by_label_property_composite_;
   };
 
  public:
   explicit VerticesIterable(AllVerticesIterable);
   explicit VerticesIterable(LabelIndex::Iterable);
   explicit VerticesIterable(LabelPropertyIndex::Iterable);
+  explicit VerticesIterable(LabelPropertyCompositeIndex::Iterable);
 
   VerticesIterable(const VerticesIterable &) = delete;
   VerticesIterable &operator=(const VerticesIterable &) = delete;
@@ -133,6 +144,7 @@ class VerticesIterable final {
       AllVerticesIterable::Iterator all_it_;
       LabelIndex::Iterable::Iterator by_label_it_;
       LabelPropertyIndex::Iterable::Iterator by_label_property_it_;
+      LabelPropertyCompositeIndex::Iterable::Iterator by_label_property_composite_it_;
     };
 
     void Destroy() noexcept;
@@ -141,6 +153,7 @@ class VerticesIterable final {
     explicit Iterator(AllVerticesIterable::Iterator);
     explicit Iterator(LabelIndex::Iterable::Iterator);
     explicit Iterator(LabelPropertyIndex::Iterable::Iterator);
+    explicit Iterator(LabelPropertyCompositeIndex::Iterable::Iterator);
 
     Iterator(const Iterator &);
     Iterator &operator=(const Iterator &);
@@ -162,10 +175,161 @@ class VerticesIterable final {
   Iterator end();
 };
 
+/// All vertices of a Storage split into chunks, see `VertexChunks`.
+class AllVerticesChunks final {
+ public:
+  /// Returns the vertices of a single chunk that are visible to the
+  /// transaction, one by one.
+  class Scanner final {
+   public:
+    std::optional<VertexAccessor> Next();
+
+   private:
+    friend class AllVerticesChunks;
+
+    Scanner(const AllVerticesChunks *self, const utils::SkipList<Vertex>::Chunk &chunk)
+        : self_(self), it_(chunk.begin()), end_(chunk.end()) {}
+
+    const AllVerticesChunks *self_;
+    utils::SkipList<Vertex>::ChunkIterator it_;
+    utils::SkipList<Vertex>::ChunkIterator end_;
+  };
+
+  AllVerticesChunks(utils::SkipList<Vertex>::Accessor vertices_accessor, uint64_t num_chunks,
+                    Transaction *transaction, View view, Indices *indices, Constraints *constraints,
+                    Config::Items config)
+      : vertices_accessor_(std::move(vertices_accessor)),
+        chunks_(vertices_accessor_.chunks(num_chunks)),
+        transaction_(transaction),
+        view_(view),
+        indices_(indices),
+        constraints_(constraints),
+        config_(config) {}
+
+  size_t size() const { return chunks_.size(); }
+
+  Scanner Scan(size_t chunk) const { return Scanner(this, chunks_[chunk]); }
+
+ private:
+  utils::SkipList<Vertex>::Accessor vertices_accessor_;
+  std::vector<utils::SkipList<Vertex>::Chunk> chunks_;
+  Transaction *transaction_;
+  View view_;
+  Indices *indices_;
+  Constraints *constraints_;
+  Config::Items config_;
+};
+
+/// The vertices of a scan split into chunks of roughly equal sizes, which can
+/// be scanned concurrently by different threads. Each chunk is scanned with
+/// its own `Scanner`, so the threads share nothing but the transaction. The
+/// chunks are valid while the object is alive.
+class VertexChunks final {
+ public:
+  class Scanner final {
+   public:
+    explicit Scanner(AllVerticesChunks::Scanner scanner) : scanner_(std::move(scanner)) {}
+    explicit Scanner(LabelIndex::Chunks::Scanner scanner) : scanner_(std::move(scanner)) {}
+
+    /// Returns the next visible vertex of the chunk, or `std::nullopt` once the
+    /// chunk is exhausted.
+    std::optional<VertexAccessor> Next() {
+      return std::visit([](auto &scanner) { return scanner.Next(); }, scanner_);
+    }
+
+   private:
+    std::variant<AllVerticesChunks::Scanner, LabelIndex::Chunks::Scanner> scanner_;
+  };
+
+  explicit VertexChunks(AllVerticesChunks chunks) : chunks_(std::move(chunks)) {}
+  explicit VertexChunks(LabelIndex::Chunks chunks) : chunks_(std::move(chunks)) {}
+
+  size_t size() const {
+    return std::visit([](const auto &chunks) { return chunks.size(); }, chunks_);
+  }
+
+  Scanner Scan(size_t chunk) const {
+    return std::visit([chunk](const auto &chunks) { return Scanner(chunks.Scan(chunk)); }, chunks_);
+  }
+
+ private:
+  std::variant<AllVerticesChunks, LabelIndex::Chunks> chunks_;
+};
+
+/// Generic access to edges found through the edge indices.
+class EdgesIterable final {
+  enum class Type { BY_EDGE_TYPE, BY_EDGE_TYPE_PROPERTY };
+
+  Type type_;
+  union {
+    EdgeTypeIndex::Iterable edges_by_edge_type_;
+    EdgeTypePropertyIndex::Iterable edges_by_edge_type_property_;
+  };
+
+ public:
+  explicit EdgesIterable(EdgeTypeIndex::Iterable);
+  explicit EdgesIterable(EdgeTypePropertyIndex::Iterable);
+
+  EdgesIterable(const EdgesIterable &) = delete;
+  EdgesIterable &operator=(const EdgesIterable &) = delete;
+
+  EdgesIterable(EdgesIterable &&) noexcept;
+  EdgesIterable &operator=(EdgesIterable &&) noexcept;
+
+  ~EdgesIterable();
+
+  class Iterator final {
+    Type type_;
+    union {
+      EdgeTypeIndex::Iterable::Iterator by_edge_type_it_;
+      EdgeTypePropertyIndex::Iterable::Iterator by_edge_type_property_it_;
+    };
+
+    void Destroy() noexcept;
+
+   public:
+    explicit Iterator(EdgeTypeIndex::Iterable::Iterator);
+    explicit Iterator(EdgeTypePropertyIndex::Iterable::Iterator);
+
+    Iterator(const Iterator &);
+    Iterator &operator=(const Iterator &);
+
+    Iterator(Iterator &&) noexcept;
+    Iterator &operator=(Iterator &&) noexcept;
+
+    ~Iterator();
+
+    EdgeAccessor operator*() const;
+
+    Iterator &operator++();
+
+    bool operator==(const Iterator &other) const;
+    bool operator!=(const Iterator &other) const { return !(*this == other); }
+  };
+
+  Iterator begin();
+  Iterator end();
+};
+
 /// Structure used to return information about existing indices in the storage.
 struct IndicesInfo {
   std::vector<LabelId> label;
   std::vector<std::pair<LabelId, PropertyId>> label_property;
+  std::vector<std::pair<LabelId, std::vector<PropertyId>>> label_property_composite;
+  std::vector<EdgeTypeId> edge_type;
+  std::vector<std::pair<EdgeTypeId, PropertyId>> edge_type_property;
+};
+
+/// Property columns of the vertices with a label, summarized for a
+/// transaction, see `Storage::Accessor::ScanPropertyColumns`.
+struct PropertyColumnsScanResult {
+  /// Number of vertices whose values are summarized.
+  uint64_t count{0};
+  /// Summaries of the requested properties, in the requested order.
+  std::vector<PropertyColumnSummary> summaries;
+  /// Vertices with the label which aren't included in the summaries, because
+  /// they were changed after the transaction started.
+  std::vector<VertexAccessor> vertices;
 };
 
 /// Structure used to return information about existing constraints in the
@@ -175,13 +339,46 @@ struct ConstraintsInfo {
   std::vector<std::pair<LabelId, std::set<PropertyId>>> unique;
 };
 
+/// Structure used to return information about the garbage collector.
+struct GcInfo {
+  // Number of garbage collection runs that had anything to collect.
+  uint64_t runs{0};
+  // Durations of the phases of the last such run.
+  std::chrono::microseconds last_unlink_duration{0};
+  std::chrono::microseconds last_index_cleanup_duration{0};
+  std::chrono::microseconds last_free_duration{0};
+  // Garbage that waits to be collected: committed transactions whose deltas
+  // aren't unlinked yet, unlinked undo buffers and deleted objects which
+  // aren't freed yet.
+  uint64_t pending_transactions{0};
+  uint64_t pending_undo_buffers{0};
+  uint64_t pending_vertices{0};
+  uint64_t pending_edges{0};
+  // Bytes of the deltas which aren't freed yet.
+  uint64_t pending_delta_bytes{0};
+  // Number of runs of the adaptive garbage collector started by each of its
+  // triggers, and its current interval, which grows while it is idle.
+  uint64_t interval_triggers{0};
+  uint64_t transactions_triggers{0};
+  uint64_t delta_bytes_triggers{0};
+  uint64_t memory_triggers{0};
+  std::chrono::milliseconds interval{0};
+};
+
 /// Structure used to return information about the storage.
 struct StorageInfo {
   uint64_t vertex_count;
   uint64_t edge_count;
   double average_degree;
+  // Average number of bytes used by a vertex together with the heap memory of
+  // its adjacency lists, excluding labels and properties. It is measured on a
+  // sample of the vertices, see `Storage::SampleVertexFootprint`.
+  uint64_t average_vertex_footprint;
   uint64_t memory_usage;
   uint64_t disk_usage;
+  GcInfo gc;
+  // Memory of the skip lists holding the vertices and the edges.
+  utils::SlabResource::Stats object_memory;
 };
 
 enum class ReplicationRole : uint8_t { MAIN, REPLICA };
@@ -198,7 +395,7 @@ class Storage final {
    private:
     friend class Storage;
 
-    explicit Accessor(Storage *storage, IsolationLevel isolation_level);
+    Accessor(Storage *storage, IsolationLevel isolation_level, Config::Durability::CommitDurability commit_durability);
 
    public:
     Accessor(const Accessor &) = delete;
@@ -224,6 +421,18 @@ class Storage final {
 
     VerticesIterable Vertices(LabelId label, View view);
 
+    /// Splits the vertices visible to the transaction into at most
+    /// `num_chunks` chunks, which can be scanned concurrently.
+    VertexChunks ChunkVertices(View view, uint64_t num_chunks) {
+      return VertexChunks(AllVerticesChunks(storage_->vertices_.access(), num_chunks, &transaction_, view,
+                                            &storage_->indices_, &storage_->constraints_, storage_->config_.items));
+    }
+
+    /// Same as above, but only for the vertices in the index of the label.
+    VertexChunks ChunkVertices(LabelId label, View view, uint64_t num_chunks) {
+      return VertexChunks(storage_->indices_.label_index.VertexChunks(label, view, &transaction_, num_chunks));
+    }
+
     VerticesIterable Vertices(LabelId label, PropertyId property, View view);
 
     VerticesIterable Vertices(LabelId label, PropertyId property, const PropertyValue &value, View view);
@@ -232,6 +441,15 @@ class Storage final {
                               const std::optional<utils::Bound<PropertyValue>> &lower_bound,
                               const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view);
 
+    /// Returns the vertices from the composite index on the label and the
+    /// properties whose first `prefix.size()` properties are equal to
+    /// `prefix` and whose next property is within the bounds. The composite
+    /// index must exist.
+    VerticesIterable Vertices(LabelId label, const std::vector<PropertyId> &properties,
+                              const std::vector<PropertyValue> &prefix,
+                              const std::optional<utils::Bound<PropertyValue>> &lower_bound,
+                              const std::optional<utils::Bound<PropertyValue>> &upper_bound, View view);
+
     /// Return approximate number of all vertices in the database.
     /// Note that this is always an over-estimate and never an under-estimate.
     int64_t ApproximateVertexCount() const { return storage_->vertices_.size(); }
@@ -264,6 +482,69 @@ class Storage final {
       return storage_->indices_.label_property_index.ApproximateVertexCount(label, property, lower, upper);
     }
 
+    /// Return approximate number of vertices in the composite index on the
+    /// label and the properties. Note that this is always an over-estimate
+    /// and never an under-estimate.
+    int64_t ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties) const {
+      return storage_->indices_.label_property_composite_index.ApproximateVertexCount(label, properties);
+    }
+
+    /// Return approximate number of vertices in the composite index whose
+    /// first `prefix.size()` properties are equal to `prefix`.
+    int64_t ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties,
+                                   const std::vector<PropertyValue> &prefix) const {
+      return storage_->indices_.label_property_composite_index.ApproximateVertexCount(label, properties, prefix);
+    }
+
+    /// Return approximate number of vertices in the composite index whose
+    /// first `prefix.size()` properties are equal to `prefix` and whose next
+    /// property is in the range defined by the bounds.
+    int64_t ApproximateVertexCount(LabelId label, const std::vector<PropertyId> &properties,
+                                   const std::vector<PropertyValue> &prefix,
+                                   const std::optional<utils::Bound<PropertyValue>> &lower,
+                                   const std::optional<utils::Bound<PropertyValue>> &upper) const {
+      return storage_->indices_.label_property_composite_index.ApproximateVertexCount(label, properties, prefix,
+                                                                                      lower, upper);
+    }
+
+    /// Return approximate number of edges with the given edge type. The count
+    /// includes the edges created and deleted by this transaction, but not by
+    /// the other transactions that aren't committed yet.
+    int64_t ApproximateEdgeCount(EdgeTypeId edge_type) const {
+      int64_t count = 0;
+      if (auto found = transaction_.edge_type_count_diffs.find(edge_type);
+          found != transaction_.edge_type_count_diffs.end()) {
+        count = found->second;
+      }
+      return count + storage_->edge_type_count_.WithLock([&](const auto &edge_type_count) -> int64_t {
+               auto found = edge_type_count.find(edge_type);
+               if (found == edge_type_count.end()) return 0;
+               return found->second;
+             });
+    }
+
+    /// Returns the edges of the given edge type. The edge-type index must
+    /// exist.
+    EdgesIterable Edges(EdgeTypeId edge_type, View view);
+
+    /// Returns the edges of the given edge type whose property is equal to
+    /// `value`. The edge-type-property index must exist.
+    EdgesIterable Edges(EdgeTypeId edge_type, PropertyId property, const PropertyValue &value, View view);
+
+    /// Return approximate number of edges of the given edge type with the
+    /// given property. Note that this is always an over-estimate and never an
+    /// under-estimate.
+    int64_t ApproximateEdgeCount(EdgeTypeId edge_type, PropertyId property) const {
+      return storage_->indices_.edge_type_property_index.ApproximateEdgeCount(edge_type, property);
+    }
+
+    /// Return approximate number of edges of the given edge type with the
+    /// given value for the given property. Note that this is always an
+    /// over-estimate and never an under-estimate.
+    int64_t ApproximateEdgeCount(EdgeTypeId edge_type, PropertyId property, const PropertyValue &value) const {
+      return storage_->indices_.edge_type_property_index.ApproximateEdgeCount(edge_type, property, value);
+    }
+
     /// @return Accessor to the deleted vertex if a deletion took place, std::nullopt otherwise
     /// @throw std::bad_alloc
     Result<std::optional<VertexAccessor>> DeleteVertex(VertexAccessor *vertex);
@@ -299,8 +580,40 @@ class Storage final {
       return storage_->indices_.label_property_index.IndexExists(label, property);
     }
 
+    bool LabelPropertyCompositeIndexExists(LabelId label, const std::vector<PropertyId> &properties) const {
+      return storage_->indices_.label_property_composite_index.IndexExists(label, properties);
+    }
+
+    /// Returns the property lists of all composite indices on the label.
+    std::vector<std::vector<PropertyId>> LabelPropertyCompositeIndices(LabelId label) const {
+      return storage_->indices_.label_property_composite_index.ListIndices(label);
+    }
+
+    bool EdgeTypeIndexExists(EdgeTypeId edge_type) const {
+      return storage_->indices_.edge_type_index.IndexExists(edge_type);
+    }
+
+    bool EdgeTypePropertyIndexExists(EdgeTypeId edge_type, PropertyId property) const {
+      return storage_->indices_.edge_type_property_index.IndexExists(edge_type, property);
+    }
+
+    bool PropertyColumnExists(LabelId label, PropertyId property) const {
+      return storage_->property_columns_.ColumnExists(label, property);
+    }
+
+    /// Summarizes the property columns of the vertices with the label.
+    /// Returns `std::nullopt` if any of the properties doesn't have a column,
+    /// or if the columns can't be used by the transaction because it has
+    /// uncommitted changes or the READ_UNCOMMITTED isolation level.
+    /// @throw std::bad_alloc
+    std::optional<PropertyColumnsScanResult> ScanPropertyColumns(LabelId label,
+                                                                 const std::vector<PropertyId> &properties, View view);
+
     IndicesInfo ListAllIndices() const {
-      return {storage_->indices_.label_index.ListIndices(), storage_->indices_.label_property_index.ListIndices()};
+      return {storage_->indices_.label_index.ListIndices(), storage_->indices_.label_property_index.ListIndices(),
+              storage_->indices_.label_property_composite_index.ListIndices(),
+              storage_->indices_.edge_type_index.ListIndices(),
+              storage_->indices_.edge_type_property_index.ListIndices()};
     }
 
     ConstraintsInfo ListAllConstraints() const {
@@ -308,6 +621,42 @@ class Storage final {
               storage_->constraints_.unique_constraints.ListConstraints()};
     }
 
+    /// Returns the statistics which were last set with `SetGraphStatistics`.
+    const GraphStatistics &GetGraphStatistics() const { return storage_->graph_statistics_; }
+
+    std::optional<LabelStats> GetLabelStats(LabelId label) const {
+      const auto &labels = storage_->graph_statistics_.labels;
+      if (auto it = labels.find(label); it != labels.end()) return it->second;
+      return std::nullopt;
+    }
+
+    std::optional<LabelPropertyStats> GetLabelPropertyStats(LabelId label, PropertyId property) const {
+      const auto &label_properties = storage_->graph_statistics_.label_properties;
+      if (auto it = label_properties.find({label, property}); it != label_properties.end()) return it->second;
+      return std::nullopt;
+    }
+
+    std::optional<EdgeTypeStats> GetEdgeTypeStats(EdgeTypeId edge_type) const {
+      const auto &edge_types = storage_->graph_statistics_.edge_types;
+      if (auto it = edge_types.find(edge_type); it != edge_types.end()) return it->second;
+      return std::nullopt;
+    }
+
+    /// Returns the average number of outgoing edges of a vertex, or
+    /// `std::nullopt` if the statistics haven't been computed.
+    std::optional<double> GetAverageDegree() const {
+      const auto &statistics = storage_->graph_statistics_;
+      if (statistics.vertex_count == 0) return std::nullopt;
+      return static_cast<double>(statistics.edge_count) / static_cast<double>(statistics.vertex_count);
+    }
+
+    /// Computes the statistics of the graph visible to this accessor. Label
+    /// and edge type statistics are computed for all labels and edge types,
+    /// while the property statistics are computed only for the properties
+    /// with a label+property index.
+    /// @throw std::bad_alloc
+    GraphStatistics ComputeGraphStatistics();
+
     void AdvanceCommand();
 
     /// Returns void if the transaction has been committed.
@@ -337,10 +686,13 @@ class Storage final {
     std::optional<uint64_t> commit_timestamp_;
     bool is_transaction_active_;
     Config::Items config_;
+    Config::Durability::CommitDurability commit_durability_;
   };
 
-  Accessor Access(std::optional<IsolationLevel> override_isolation_level = {}) {
-    return Accessor{this, override_isolation_level.value_or(isolation_level_)};
+  Accessor Access(std::optional<IsolationLevel> override_isolation_level = {},
+                  std::optional<Config::Durability::CommitDurability> override_commit_durability = {}) {
+    return Accessor{this, override_isolation_level.value_or(isolation_level_),
+                    override_commit_durability.value_or(config_.durability.commit_durability)};
   }
 
   const std::string &LabelToName(LabelId label) const;
@@ -360,6 +712,7 @@ class Storage final {
   /// Returns void if the index has been created.
   /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
   /// * `IndexDefinitionError`: the index already exists.
+  /// * `IndexBeingCreatedError`: the index is still being created.
   /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
   /// @throw std::bad_alloc
   utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(
@@ -370,6 +723,7 @@ class Storage final {
   /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
   /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
   /// * `IndexDefinitionError`: the index already exists.
+  /// * `IndexBeingCreatedError`: the index is still being created.
   /// @throw std::bad_alloc
   utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(
       LabelId label, PropertyId property, std::optional<uint64_t> desired_commit_timestamp = {});
@@ -379,6 +733,7 @@ class Storage final {
   /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
   /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
   /// * `IndexDefinitionError`: the index does not exist.
+  /// * `IndexBeingCreatedError`: the index is still being created.
   utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(
       LabelId label, std::optional<uint64_t> desired_commit_timestamp = {});
 
@@ -387,11 +742,87 @@ class Storage final {
   /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
   /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
   /// * `IndexDefinitionError`: the index does not exist.
+  /// * `IndexBeingCreatedError`: the index is still being created.
   utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(
       LabelId label, PropertyId property, std::optional<uint64_t> desired_commit_timestamp = {});
 
+  /// Create an edge-type index.
+  /// Returns void if the index has been created.
+  /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
+  /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
+  /// * `IndexDefinitionError`: the index already exists.
+  /// @throw std::bad_alloc
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(
+      EdgeTypeId edge_type, std::optional<uint64_t> desired_commit_timestamp = {});
+
+  /// Create an edge-type-property index.
+  /// Returns void if the index has been created.
+  /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
+  /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
+  /// * `IndexDefinitionError`: the index already exists or properties on edges are disabled.
+  /// @throw std::bad_alloc
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(
+      EdgeTypeId edge_type, PropertyId property, std::optional<uint64_t> desired_commit_timestamp = {});
+
+  /// Drop an existing edge-type index.
+  /// Returns void if the index has been dropped.
+  /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
+  /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
+  /// * `IndexDefinitionError`: the index does not exist.
+  utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(
+      EdgeTypeId edge_type, std::optional<uint64_t> desired_commit_timestamp = {});
+
+  /// Drop an existing edge-type-property index.
+  /// Returns void if the index has been dropped.
+  /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
+  /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
+  /// * `IndexDefinitionError`: the index does not exist.
+  utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(
+      EdgeTypeId edge_type, PropertyId property, std::optional<uint64_t> desired_commit_timestamp = {});
+
+  /// Create a composite index on the label and the ordered list of
+  /// properties. Composite indices are always created while holding the
+  /// storage lock, even if concurrent index creation is enabled.
+  /// Returns void if the index has been created.
+  /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
+  /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
+  /// * `IndexDefinitionError`: the index already exists, or there are less than two properties, or a property is
+  ///   repeated.
+  /// @throw std::bad_alloc
+  utils::BasicResult<StorageIndexDefinitionError, void> CreateIndex(
+      LabelId label, const std::vector<PropertyId> &properties, std::optional<uint64_t> desired_commit_timestamp = {});
+
+  /// Drop an existing composite index.
+  /// Returns void if the index has been dropped.
+  /// Returns `StorageIndexDefinitionError` if an error occures. Error can be:
+  /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
+  /// * `IndexDefinitionError`: the index does not exist.
+  utils::BasicResult<StorageIndexDefinitionError, void> DropIndex(
+      LabelId label, const std::vector<PropertyId> &properties, std::optional<uint64_t> desired_commit_timestamp = {});
+
   IndicesInfo ListAllIndices() const;
 
+  /// Creates a column of the property's values on the vertices with the
+  /// label, which is kept in sync on every commit. The columns aren't
+  /// persisted, they are created on startup from the configuration.
+  /// Returns false if the column already exists.
+  /// @throw std::bad_alloc
+  bool CreatePropertyColumn(LabelId label, PropertyId property);
+
+  /// Returns false if there was no column to drop.
+  bool DropPropertyColumn(LabelId label, PropertyId property);
+
+  std::vector<std::pair<LabelId, PropertyId>> ListAllPropertyColumns() const;
+
+  /// Replaces the graph statistics used for the cardinality estimation. Empty
+  /// statistics clear the existing ones.
+  /// Returns void if the statistics have been set.
+  /// Returns `StorageGraphStatisticsError` if an error occures. Error can be:
+  /// * `ReplicationError`:  there is at least one SYNC replica that has not confirmed receiving the transaction.
+  /// @throw std::bad_alloc
+  utils::BasicResult<StorageGraphStatisticsError, void> SetGraphStatistics(
+      GraphStatistics statistics, std::optional<uint64_t> desired_commit_timestamp = {});
+
   /// Returns void if the existence constraint has been created.
   /// Returns `StorageExistenceConstraintDefinitionError` if an error occures. Error can be:
   /// * `ReplicationError`: there is at least one SYNC replica that has not confirmed receiving the transaction.
@@ -436,7 +867,7 @@ class Storage final {
 
   ConstraintsInfo ListAllConstraints() const;
 
-  StorageInfo GetInfo() const;
+  StorageInfo GetInfo();
 
   bool LockPath();
   bool UnlockPath();
@@ -504,14 +935,45 @@ class Storage final {
   template <bool force>
   void CollectGarbage();
 
+  enum class GcTrigger { INTERVAL, TRANSACTIONS, DELTA_BYTES, MEMORY };
+
+  // Returns the trigger of the adaptive garbage collector which is reached,
+  // if any. `committed_transactions` is the number of committed transactions
+  // whose deltas aren't unlinked yet.
+  std::optional<GcTrigger> CheckGcTrigger(uint64_t committed_transactions) const;
+
+  // A single run of the adaptive garbage collector. The garbage is collected
+  // if a trigger is reached or the current interval has passed.
+  void RunAdaptiveGc();
+
   bool InitializeWalFile();
   void FinalizeWalFile();
+  // Syncs the transactions which are appended to the WAL and returns the
+  // sequence number of the last synced one. The engine lock is held only
+  // while the WAL buffer is written, not during the sync itself.
+  uint64_t SyncWalFile();
+  // Makes the transaction with the given sequence number durable with the
+  // given durability.
+  void WaitWalDurable(uint64_t seq_num, Config::Durability::CommitDurability commit_durability);
 
   /// Return true in all cases excepted if any sync replicas have not sent confirmation.
   [[nodiscard]] bool AppendToWalDataManipulation(const Transaction &transaction, uint64_t final_commit_timestamp);
   /// Return true in all cases excepted if any sync replicas have not sent confirmation.
   [[nodiscard]] bool AppendToWalDataDefinition(durability::StorageGlobalOperation operation, LabelId label,
-                                               const std::set<PropertyId> &properties, uint64_t final_commit_timestamp);
+                                               const std::vector<PropertyId> &properties,
+                                               uint64_t final_commit_timestamp);
+  /// Return true in all cases excepted if any sync replicas have not sent confirmation.
+  [[nodiscard]] bool AppendToWalDataDefinition(durability::StorageGlobalOperation operation, EdgeTypeId edge_type,
+                                               const std::vector<PropertyId> &properties,
+                                               uint64_t final_commit_timestamp);
+  /// Return true in all cases excepted if any sync replicas have not sent confirmation.
+  [[nodiscard]] bool AppendToWalDataDefinition(durability::StorageGlobalOperation operation,
+                                               const NamedGraphStatistics &statistics, uint64_t final_commit_timestamp);
+  // Appends the operation with the arguments `args` to the WAL and replicates
+  // it.
+  template <typename... TArgs>
+  bool AppendToWalDataDefinitionImpl(durability::StorageGlobalOperation operation, uint64_t final_commit_timestamp,
+                                     const TArgs &...args);
 
   uint64_t CommitTimestamp(std::optional<uint64_t> desired_commit_timestamp = {});
 
@@ -519,6 +981,18 @@ class Storage final {
 
   bool ShouldStoreAndRestoreReplicas() const;
 
+  /// Adds the changes of the edge counts made by a committed transaction to
+  /// the counts of the storage.
+  void ApplyEdgeTypeCountDiffs(const std::unordered_map<EdgeTypeId, int64_t> &diffs);
+
+  /// Recounts the edges of each edge type from the adjacency lists. It must be
+  /// called with exclusive access to the storage, e.g. after recovery.
+  void RecountEdgeTypes();
+
+  /// Returns the average number of bytes used by a vertex together with its
+  /// adjacency lists, measured on a sample of the vertices.
+  uint64_t SampleVertexFootprint();
+
   // Main storage lock.
   //
   // Accessors take a shared lock when starting, so it is possible to block
@@ -527,6 +1001,11 @@ class Storage final {
   // creation.
   mutable utils::RWLock main_lock_{utils::RWLock::Priority::WRITE};
 
+  // Memory of the main object storage. The vertices and the edges are created
+  // and deleted all the time, so their skip list nodes are allocated from
+  // slabs to keep the memory from fragmenting.
+  utils::SlabResource object_memory_;
+
   // Main object storage
   utils::SkipList<storage::Vertex> vertices_;
   utils::SkipList<storage::Edge> edges_;
@@ -536,11 +1015,20 @@ class Storage final {
   // list is used only when properties are enabled for edges. Because of that we
   // keep a separate count of edges that is always updated.
   std::atomic<uint64_t> edge_count_{0};
+  // Number of edges of each edge type that is used for cardinality estimation
+  // when planning typed expansions.
+  utils::Synchronized<std::unordered_map<EdgeTypeId, int64_t>, utils::SpinLock> edge_type_count_;
 
   NameIdMapper name_id_mapper_;
 
   Constraints constraints_;
   Indices indices_;
+  // Statistics computed by `ANALYZE GRAPH`. They are changed only while
+  // holding the unique `main_lock_`, so accessors can read them freely.
+  GraphStatistics graph_statistics_;
+  // Columns are created and dropped only while holding the unique
+  // `main_lock_`, while their rows are updated by the commits.
+  PropertyColumns property_columns_;
 
   // Transaction engine
   utils::SpinLock engine_lock_;
@@ -559,8 +1047,11 @@ class Storage final {
   utils::Scheduler gc_runner_;
   std::mutex gc_lock_;
 
-  // Undo buffers that were unlinked and now are waiting to be freed.
-  utils::Synchronized<std::list<std::pair<uint64_t, std::list<Delta>>>, utils::SpinLock> garbage_undo_buffers_;
+  // Undo buffers that were unlinked and now are waiting to be freed. Each
+  // buffer is marked with the timestamp at which it was unlinked, which is the
+  // epoch after which no new transaction can see any of its deltas. The buffer
+  // is freed as a whole once all transactions older than that have finished.
+  utils::Synchronized<std::list<std::pair<uint64_t, UndoBuffer>>, utils::SpinLock> garbage_undo_buffers_;
 
   // Vertices that are logically deleted but still have to be removed from
   // indices before removing them from the main storage.
@@ -570,6 +1061,22 @@ class Storage final {
   // to be removed from the main storage.
   std::list<std::pair<uint64_t, Gid>> garbage_vertices_;
 
+  // Statistics of the garbage collector runs. The number of pending vertices
+  // is the size of `garbage_vertices_` after the last run.
+  utils::Synchronized<GcInfo, utils::SpinLock> gc_info_;
+
+  // Bytes of the deltas of the finished transactions which aren't freed yet.
+  std::atomic<uint64_t> gc_pending_delta_bytes_{0};
+  // The garbage which was left after the last run of the adaptive garbage
+  // collector. The triggers count only the garbage added since then, so that
+  // the garbage which can't be collected yet, e.g. because of a long running
+  // transaction, doesn't trigger the runs all the time.
+  std::atomic<uint64_t> gc_transactions_after_run_{0};
+  std::atomic<uint64_t> gc_delta_bytes_after_run_{0};
+  // Used only by the adaptive garbage collector thread.
+  std::chrono::milliseconds gc_interval_;
+  std::chrono::steady_clock::time_point gc_next_run_;
+
   // Edges that are logically deleted and wait to be removed from the main
   // storage.
   utils::Synchronized<std::list<Gid>, utils::SpinLock> deleted_edges_;
@@ -584,6 +1091,20 @@ class Storage final {
   utils::Scheduler snapshot_runner_;
   utils::SpinLock snapshot_lock_;
 
+  // Objects modified by the committed transactions along with the commit
+  // timestamps of their first and last modification since they were written
+  // to a snapshot. They are written to the next incremental snapshot.
+  struct SnapshotDirtyObjects {
+    std::unordered_map<Gid, std::pair<uint64_t, uint64_t>> vertices;
+    std::unordered_map<Gid, std::pair<uint64_t, uint64_t>> edges;
+  };
+  utils::Synchronized<SnapshotDirtyObjects, utils::SpinLock> snapshot_dirty_objects_;
+  // Start timestamp of the last snapshot and the number of incremental
+  // snapshots which were created since the last full snapshot. Both are
+  // protected by `snapshot_lock_`.
+  std::optional<uint64_t> last_snapshot_timestamp_;
+  uint64_t incremental_snapshots_count_{0};
+
   // UUID used to distinguish snapshots and to link snapshots to WALs
   std::string uuid_;
   // Sequence number used to keep track of the chain of WALs.
@@ -612,6 +1133,14 @@ class Storage final {
   std::optional<durability::WalFile> wal_file_;
   uint64_t wal_unsynced_transactions_{0};
 
+  // Syncs of the WAL which are shared between the concurrently committing
+  // transactions.
+  durability::GroupCommit wal_group_commit_;
+  // Sequence number of the last transaction which has to be synced by the
+  // periodic WAL sync.
+  std::atomic<uint64_t> wal_periodic_sync_pending_{0};
+  utils::Scheduler wal_sync_runner_;
+
   utils::FileRetainer file_retainer_;
 
   // Global locker that is used for clients file locking
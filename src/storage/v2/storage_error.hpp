@@ -22,7 +22,10 @@ struct ReplicationError {};
 using StorageDataManipulationError = std::variant<ConstraintViolation, ReplicationError>;
 
 struct IndexDefinitionError {};
-using StorageIndexDefinitionError = std::variant<IndexDefinitionError, ReplicationError>;
+// The index is still being created concurrently with the writes, so it can't
+// be created again or dropped yet.
+struct IndexBeingCreatedError {};
+using StorageIndexDefinitionError = std::variant<IndexDefinitionError, IndexBeingCreatedError, ReplicationError>;
 
 struct ConstraintDefinitionError {};
 
@@ -35,4 +38,6 @@ using StorageUniqueConstraintDefinitionError = std::variant<ConstraintViolation,
 
 using StorageUniqueConstraintDroppingError = std::variant<ReplicationError>;
 
+using StorageGraphStatisticsError = std::variant<ReplicationError>;
+
 }  // namespace memgraph::storage
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -13,15 +13,17 @@
 
 #include <atomic>
 #include <limits>
-#include <list>
 #include <memory>
+#include <unordered_map>
 
 #include "utils/skip_list.hpp"
 
 #include "storage/v2/delta.hpp"
 #include "storage/v2/edge.hpp"
+#include "storage/v2/id_types.hpp"
 #include "storage/v2/isolation_level.hpp"
 #include "storage/v2/property_value.hpp"
+#include "storage/v2/undo_buffer.hpp"
 #include "storage/v2/vertex.hpp"
 #include "storage/v2/view.hpp"
 
@@ -44,6 +46,7 @@ struct Transaction {
         commit_timestamp(std::move(other.commit_timestamp)),
         command_id(other.command_id),
         deltas(std::move(other.deltas)),
+        edge_type_count_diffs(std::move(other.edge_type_count_diffs)),
         must_abort(other.must_abort),
         isolation_level(other.isolation_level) {}
 
@@ -67,7 +70,11 @@ struct Transaction {
   // `commited_transactions_` list for GC.
   std::unique_ptr<std::atomic<uint64_t>> commit_timestamp;
   uint64_t command_id;
-  std::list<Delta> deltas;
+  UndoBuffer deltas;
+  // Changes of the edge counts of each edge type made by the transaction.
+  // They are added to the storage's counts when the transaction commits so
+  // that the edge writers don't contend on the shared counts.
+  std::unordered_map<EdgeTypeId, int64_t> edge_type_count_diffs;
   bool must_abort;
   IsolationLevel isolation_level;
 };
@@ -0,0 +1,50 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/undo_buffer.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace memgraph::storage {
+
+void UndoBuffer::clear() noexcept {
+  while (head_ != nullptr) {
+    auto *block = head_;
+    head_ = block->next;
+    std::destroy_n(block->deltas(), block->size);
+    ::operator delete(block);
+  }
+  tail_ = nullptr;
+  size_ = 0;
+}
+
+size_t UndoBuffer::BlockCount() const {
+  size_t count = 0;
+  for (const auto *block = head_; block != nullptr; block = block->next) ++count;
+  return count;
+}
+
+void UndoBuffer::AddBlock() {
+  const auto capacity = tail_ == nullptr ? kFirstBlockCapacity : std::min(tail_->capacity * 2, kMaxBlockCapacity);
+  auto *block = static_cast<Block *>(::operator new(sizeof(Block) + capacity * sizeof(Delta)));
+  block->next = nullptr;
+  block->size = 0;
+  block->capacity = capacity;
+  if (tail_ == nullptr) {
+    head_ = block;
+  } else {
+    tail_->next = block;
+  }
+  tail_ = block;
+}
+
+}  // namespace memgraph::storage
@@ -0,0 +1,154 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include "storage/v2/delta.hpp"
+
+namespace memgraph::storage {
+
+/// Arena which holds all of the deltas created by a single transaction.
+///
+/// The deltas are stored in blocks which are allocated as a whole, so
+/// creating a delta is a bump allocation in the last block instead of a heap
+/// allocation per delta. The first block is small because most transactions
+/// create only a few deltas, and each following block is twice as large as
+/// the previous one up to `kMaxBlockCapacity` deltas. The deltas never move,
+/// so pointers to them stay valid until the buffer is cleared or destroyed,
+/// also when the buffer itself is moved.
+///
+/// Once the transaction is finished the whole buffer is handed over to the
+/// garbage collector, which keeps it until no active transaction can see any
+/// of its deltas and then frees it block by block.
+class UndoBuffer final {
+  struct Block {
+    Block *next;
+    uint32_t size;
+    uint32_t capacity;
+
+    Delta *deltas() { return reinterpret_cast<Delta *>(this + 1); }
+    const Delta *deltas() const { return reinterpret_cast<const Delta *>(this + 1); }
+  };
+  static_assert(sizeof(Block) % alignof(Delta) == 0, "The deltas in a block must be aligned!");
+
+ public:
+  static constexpr uint32_t kFirstBlockCapacity = 4;
+  static constexpr uint32_t kMaxBlockCapacity = 512;
+
+  template <typename TDelta, typename TBlock>
+  class IteratorBase final {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Delta;
+    using difference_type = std::ptrdiff_t;
+    using pointer = TDelta *;
+    using reference = TDelta &;
+
+    IteratorBase() = default;
+    explicit IteratorBase(TBlock *block) : block_(block) { SkipEmptyBlocks(); }
+
+    reference operator*() const { return block_->deltas()[index_]; }
+    pointer operator->() const { return &block_->deltas()[index_]; }
+
+    IteratorBase &operator++() {
+      if (++index_ == block_->size) {
+        block_ = block_->next;
+        index_ = 0;
+        SkipEmptyBlocks();
+      }
+      return *this;
+    }
+
+    IteratorBase operator++(int) {
+      auto old = *this;
+      ++*this;
+      return old;
+    }
+
+    bool operator==(const IteratorBase &other) const { return block_ == other.block_ && index_ == other.index_; }
+    bool operator!=(const IteratorBase &other) const { return !(*this == other); }
+
+   private:
+    // Only the last block can be empty, when the creation of the first delta
+    // in it failed.
+    void SkipEmptyBlocks() {
+      while (block_ != nullptr && block_->size == 0) block_ = block_->next;
+    }
+
+    TBlock *block_{nullptr};
+    uint32_t index_{0};
+  };
+
+  using Iterator = IteratorBase<Delta, Block>;
+  using ConstIterator = IteratorBase<const Delta, const Block>;
+
+  UndoBuffer() = default;
+
+  UndoBuffer(UndoBuffer &&other) noexcept
+      : head_(std::exchange(other.head_, nullptr)),
+        tail_(std::exchange(other.tail_, nullptr)),
+        size_(std::exchange(other.size_, 0)) {}
+
+  UndoBuffer &operator=(UndoBuffer &&other) noexcept {
+    if (this != &other) {
+      clear();
+      head_ = std::exchange(other.head_, nullptr);
+      tail_ = std::exchange(other.tail_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  UndoBuffer(const UndoBuffer &) = delete;
+  UndoBuffer &operator=(const UndoBuffer &) = delete;
+
+  ~UndoBuffer() { clear(); }
+
+  /// Creates a new delta at the end of the buffer.
+  /// @throw std::bad_alloc
+  template <typename... TArgs>
+  Delta &emplace_back(TArgs &&...args) {
+    if (tail_ == nullptr || tail_->size == tail_->capacity) AddBlock();
+    auto *delta = new (tail_->deltas() + tail_->size) Delta(std::forward<TArgs>(args)...);
+    ++tail_->size;
+    ++size_;
+    return *delta;
+  }
+
+  /// Destroys all of the deltas and frees all of the blocks.
+  void clear() noexcept;
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  /// Number of allocated blocks.
+  size_t BlockCount() const;
+
+  Iterator begin() { return Iterator(head_); }
+  Iterator end() { return Iterator(); }
+  ConstIterator begin() const { return ConstIterator(head_); }
+  ConstIterator end() const { return ConstIterator(); }
+
+ private:
+  void AddBlock();
+
+  Block *head_{nullptr};
+  Block *tail_{nullptr};
+  size_t size_{0};
+};
+
+}  // namespace memgraph::storage
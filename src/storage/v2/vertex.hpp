@@ -12,11 +12,10 @@
 #pragma once
 
 #include <limits>
-#include <tuple>
 #include <vector>
 
 #include "storage/v2/delta.hpp"
-#include "storage/v2/edge_ref.hpp"
+#include "storage/v2/edge_list.hpp"
 #include "storage/v2/id_types.hpp"
 #include "storage/v2/property_store.hpp"
 #include "utils/spin_lock.hpp"
@@ -34,8 +33,8 @@ struct Vertex {
   std::vector<LabelId> labels;
   PropertyStore properties;
 
-  std::vector<std::tuple<EdgeTypeId, Vertex *, EdgeRef>> in_edges;
-  std::vector<std::tuple<EdgeTypeId, Vertex *, EdgeRef>> out_edges;
+  EdgeList in_edges;
+  EdgeList out_edges;
 
   mutable utils::SpinLock lock;
   bool deleted;
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -11,6 +11,7 @@
 
 #include "storage/v2/vertex_accessor.hpp"
 
+#include <algorithm>
 #include <memory>
 
 #include "storage/v2/edge_accessor.hpp"
@@ -57,6 +58,15 @@ std::pair<bool, bool> IsVisible(Vertex *vertex, Transaction *transaction, View v
 
   return {exists, deleted};
 }
+
+// Calls `func` for each edge type in `edge_types` skipping the duplicates.
+template <typename TFunc>
+void ForEachDistinctEdgeType(const std::vector<EdgeTypeId> &edge_types, const TFunc &func) {
+  for (auto it = edge_types.begin(); it != edge_types.end(); ++it) {
+    if (std::find(edge_types.begin(), it, *it) != it) continue;
+    func(*it);
+  }
+}
 }  // namespace
 }  // namespace detail
 
@@ -289,6 +299,49 @@ Result<PropertyValue> VertexAccessor::GetProperty(PropertyId property, View view
   return std::move(value);
 }
 
+Result<PropertyPredicate::Result> VertexAccessor::CheckPropertyPredicate(PropertyId property,
+                                                                         const PropertyPredicate &predicate,
+                                                                         View view) const {
+  bool exists = true;
+  bool deleted = false;
+  PropertyPredicate::Result result;
+  Delta *delta = nullptr;
+  {
+    std::lock_guard<utils::SpinLock> guard(vertex_->lock);
+    deleted = vertex_->deleted;
+    result = vertex_->properties.CheckPredicate(property, predicate);
+    delta = vertex_->delta;
+  }
+  ApplyDeltasForRead(transaction_, delta, view, [&exists, &deleted, &result, property, &predicate](const Delta &delta) {
+    switch (delta.action) {
+      case Delta::Action::SET_PROPERTY: {
+        if (delta.property.key == property) {
+          result = predicate.Evaluate(delta.property.value);
+        }
+        break;
+      }
+      case Delta::Action::DELETE_OBJECT: {
+        exists = false;
+        break;
+      }
+      case Delta::Action::RECREATE_OBJECT: {
+        deleted = false;
+        break;
+      }
+      case Delta::Action::ADD_LABEL:
+      case Delta::Action::REMOVE_LABEL:
+      case Delta::Action::ADD_IN_EDGE:
+      case Delta::Action::ADD_OUT_EDGE:
+      case Delta::Action::REMOVE_IN_EDGE:
+      case Delta::Action::REMOVE_OUT_EDGE:
+        break;
+    }
+  });
+  if (!exists) return Error::NONEXISTENT_OBJECT;
+  if (!for_deleted_ && deleted) return Error::DELETED_OBJECT;
+  return result;
+}
+
 Result<std::map<PropertyId, PropertyValue>> VertexAccessor::Properties(View view) const {
   bool exists = true;
   bool deleted = false;
@@ -350,15 +403,21 @@ Result<std::vector<EdgeAccessor>> VertexAccessor::InEdges(View view, const std::
     std::lock_guard<utils::SpinLock> guard(vertex_->lock);
     deleted = vertex_->deleted;
     if (edge_types.empty() && !destination) {
-      in_edges = vertex_->in_edges;
-    } else {
+      in_edges.assign(vertex_->in_edges.begin(), vertex_->in_edges.end());
+    } else if (edge_types.empty()) {
       for (const auto &item : vertex_->in_edges) {
-        const auto &[edge_type, from_vertex, edge] = item;
-        if (destination && from_vertex != destination->vertex_) continue;
-        if (!edge_types.empty() && std::find(edge_types.begin(), edge_types.end(), edge_type) == edge_types.end())
-          continue;
+        if (std::get<1>(item) != destination->vertex_) continue;
         in_edges.push_back(item);
       }
+    } else {
+      // The edges are grouped by their type so we only look at the edges of
+      // the requested types.
+      detail::ForEachDistinctEdgeType(edge_types, [&](EdgeTypeId edge_type) {
+        for (const auto &item : vertex_->in_edges.EdgesOfType(edge_type)) {
+          if (destination && std::get<1>(item) != destination->vertex_) continue;
+          in_edges.push_back(item);
+        }
+      });
     }
     delta = vertex_->delta;
   }
@@ -430,15 +489,21 @@ Result<std::vector<EdgeAccessor>> VertexAccessor::OutEdges(View view, const std:
     std::lock_guard<utils::SpinLock> guard(vertex_->lock);
     deleted = vertex_->deleted;
     if (edge_types.empty() && !destination) {
-      out_edges = vertex_->out_edges;
-    } else {
+      out_edges.assign(vertex_->out_edges.begin(), vertex_->out_edges.end());
+    } else if (edge_types.empty()) {
       for (const auto &item : vertex_->out_edges) {
-        const auto &[edge_type, to_vertex, edge] = item;
-        if (destination && to_vertex != destination->vertex_) continue;
-        if (!edge_types.empty() && std::find(edge_types.begin(), edge_types.end(), edge_type) == edge_types.end())
-          continue;
+        if (std::get<1>(item) != destination->vertex_) continue;
         out_edges.push_back(item);
       }
+    } else {
+      // The edges are grouped by their type so we only look at the edges of
+      // the requested types.
+      detail::ForEachDistinctEdgeType(edge_types, [&](EdgeTypeId edge_type) {
+        for (const auto &item : vertex_->out_edges.EdgesOfType(edge_type)) {
+          if (destination && std::get<1>(item) != destination->vertex_) continue;
+          out_edges.push_back(item);
+        }
+      });
     }
     delta = vertex_->delta;
   }
@@ -499,7 +564,7 @@ Result<std::vector<EdgeAccessor>> VertexAccessor::OutEdges(View view, const std:
   return std::move(ret);
 }
 
-Result<size_t> VertexAccessor::InDegree(View view) const {
+Result<size_t> VertexAccessor::InDegree(View view, const std::vector<EdgeTypeId> &edge_types) const {
   bool exists = true;
   bool deleted = false;
   size_t degree = 0;
@@ -507,15 +572,26 @@ Result<size_t> VertexAccessor::InDegree(View view) const {
   {
     std::lock_guard<utils::SpinLock> guard(vertex_->lock);
     deleted = vertex_->deleted;
-    degree = vertex_->in_edges.size();
+    if (edge_types.empty()) {
+      degree = vertex_->in_edges.size();
+    } else {
+      detail::ForEachDistinctEdgeType(edge_types,
+                                      [&](EdgeTypeId edge_type) { degree += vertex_->in_edges.Degree(edge_type); });
+    }
     delta = vertex_->delta;
   }
-  ApplyDeltasForRead(transaction_, delta, view, [&exists, &deleted, &degree](const Delta &delta) {
+  ApplyDeltasForRead(transaction_, delta, view, [&exists, &deleted, &degree, &edge_types](const Delta &delta) {
     switch (delta.action) {
       case Delta::Action::ADD_IN_EDGE:
+        if (!edge_types.empty() &&
+            std::find(edge_types.begin(), edge_types.end(), delta.vertex_edge.edge_type) == edge_types.end())
+          break;
         ++degree;
         break;
       case Delta::Action::REMOVE_IN_EDGE:
+        if (!edge_types.empty() &&
+            std::find(edge_types.begin(), edge_types.end(), delta.vertex_edge.edge_type) == edge_types.end())
+          break;
         --degree;
         break;
       case Delta::Action::DELETE_OBJECT:
@@ -537,7 +613,7 @@ Result<size_t> VertexAccessor::InDegree(View view) const {
   return degree;
 }
 
-Result<size_t> VertexAccessor::OutDegree(View view) const {
+Result<size_t> VertexAccessor::OutDegree(View view, const std::vector<EdgeTypeId> &edge_types) const {
   bool exists = true;
   bool deleted = false;
   size_t degree = 0;
@@ -545,15 +621,26 @@ Result<size_t> VertexAccessor::OutDegree(View view) const {
   {
     std::lock_guard<utils::SpinLock> guard(vertex_->lock);
     deleted = vertex_->deleted;
-    degree = vertex_->out_edges.size();
+    if (edge_types.empty()) {
+      degree = vertex_->out_edges.size();
+    } else {
+      detail::ForEachDistinctEdgeType(edge_types,
+                                      [&](EdgeTypeId edge_type) { degree += vertex_->out_edges.Degree(edge_type); });
+    }
     delta = vertex_->delta;
   }
-  ApplyDeltasForRead(transaction_, delta, view, [&exists, &deleted, &degree](const Delta &delta) {
+  ApplyDeltasForRead(transaction_, delta, view, [&exists, &deleted, &degree, &edge_types](const Delta &delta) {
     switch (delta.action) {
       case Delta::Action::ADD_OUT_EDGE:
+        if (!edge_types.empty() &&
+            std::find(edge_types.begin(), edge_types.end(), delta.vertex_edge.edge_type) == edge_types.end())
+          break;
         ++degree;
         break;
       case Delta::Action::REMOVE_OUT_EDGE:
+        if (!edge_types.empty() &&
+            std::find(edge_types.begin(), edge_types.end(), delta.vertex_edge.edge_type) == edge_types.end())
+          break;
         --degree;
         break;
       case Delta::Action::DELETE_OBJECT:
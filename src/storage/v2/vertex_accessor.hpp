@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -75,6 +75,12 @@ class VertexAccessor final {
   /// @throw std::bad_alloc
   Result<PropertyValue> GetProperty(PropertyId property, View view) const;
 
+  /// Checks the predicate `predicate` on the property `property` without
+  /// copying the property value unless it was changed by a transaction whose
+  /// changes are visible in `view`.
+  Result<PropertyPredicate::Result> CheckPropertyPredicate(PropertyId property, const PropertyPredicate &predicate,
+                                                           View view) const;
+
   /// @throw std::bad_alloc
   Result<std::map<PropertyId, PropertyValue>> Properties(View view) const;
 
@@ -90,9 +96,13 @@ class VertexAccessor final {
   Result<std::vector<EdgeAccessor>> OutEdges(View view, const std::vector<EdgeTypeId> &edge_types = {},
                                              const VertexAccessor *destination = nullptr) const;
 
-  Result<size_t> InDegree(View view) const;
+  /// Returns the number of in edges. When `edge_types` isn't empty only the
+  /// edges of the given types are counted.
+  Result<size_t> InDegree(View view, const std::vector<EdgeTypeId> &edge_types = {}) const;
 
-  Result<size_t> OutDegree(View view) const;
+  /// Returns the number of out edges. When `edge_types` isn't empty only the
+  /// edges of the given types are counted.
+  Result<size_t> OutDegree(View view, const std::vector<EdgeTypeId> &edge_types = {}) const;
 
   Gid Gid() const noexcept { return vertex_->gid; }
 
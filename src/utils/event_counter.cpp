@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -24,7 +24,12 @@
   M(ScanAllByLabelPropertyRangeOperator, "Number of times ScanAllByLabelPropertyRange operator was used.") \
   M(ScanAllByLabelPropertyValueOperator, "Number of times ScanAllByLabelPropertyValue operator was used.") \
   M(ScanAllByLabelPropertyOperator, "Number of times ScanAllByLabelProperty operator was used.")           \
+  M(ScanAllByLabelPropertyCompositeOperator,                                                               \
+    "Number of times ScanAllByLabelPropertyComposite operator was used.")                                  \
   M(ScanAllByIdOperator, "Number of times ScanAllById operator was used.")                                 \
+  M(ScanAllByEdgeTypeOperator, "Number of times ScanAllByEdgeType operator was used.")                     \
+  M(ScanAllByEdgeTypePropertyValueOperator,                                                                \
+    "Number of times ScanAllByEdgeTypePropertyValue operator was used.")                                   \
   M(ExpandOperator, "Number of times Expand operator was used.")                                           \
   M(ExpandVariableOperator, "Number of times ExpandVariable operator was used.")                           \
   M(ConstructNamedPathOperator, "Number of times ConstructNamedPath operator was used.")                   \
@@ -40,25 +45,36 @@
   M(EmptyResultOperator, "Number of times EmptyResult operator was used.")                                 \
   M(AccumulateOperator, "Number of times Accumulate operator was used.")                                   \
   M(AggregateOperator, "Number of times Aggregate operator was used.")                                     \
+  M(ParallelAggregateOperator, "Number of times ParallelAggregate operator was used.")                     \
+  M(ColumnarAggregateOperator, "Number of times ColumnarAggregate operator was used.")                     \
   M(SkipOperator, "Number of times Skip operator was used.")                                               \
   M(LimitOperator, "Number of times Limit operator was used.")                                             \
   M(OrderByOperator, "Number of times OrderBy operator was used.")                                         \
+  M(TopKOperator, "Number of times TopK operator was used.")                                               \
   M(MergeOperator, "Number of times Merge operator was used.")                                             \
   M(OptionalOperator, "Number of times Optional operator was used.")                                       \
   M(UnwindOperator, "Number of times Unwind operator was used.")                                           \
   M(DistinctOperator, "Number of times Distinct operator was used.")                                       \
   M(UnionOperator, "Number of times Union operator was used.")                                             \
   M(CartesianOperator, "Number of times Cartesian operator was used.")                                     \
+  M(HashJoinOperator, "Number of times HashJoin operator was used.")                                       \
   M(CallProcedureOperator, "Number of times CallProcedure operator was used.")                             \
   M(ForeachOperator, "Number of times Foreach operator was used.")                                         \
                                                                                                            \
   M(FailedQuery, "Number of times executing a query failed.")                                              \
   M(LabelIndexCreated, "Number of times a label index was created.")                                       \
+  M(EdgeIndexCreated, "Number of times an edge index was created.")                                        \
   M(LabelPropertyIndexCreated, "Number of times a label property index was created.")                      \
   M(StreamsCreated, "Number of Streams created.")                                                          \
   M(MessagesConsumed, "Number of consumed streamed messages.")                                             \
   M(TriggersCreated, "Number of Triggers created.")                                                        \
-  M(TriggersExecuted, "Number of Triggers executed.")
+  M(TriggersExecuted, "Number of Triggers executed.")                                                      \
+                                                                                                           \
+  M(GcIntervalTriggered, "Number of times the adaptive storage GC ran because its interval passed.")       \
+  M(GcTransactionsTriggered,                                                                               \
+    "Number of times the adaptive storage GC ran because of the committed transactions backlog.")          \
+  M(GcDeltaBytesTriggered, "Number of times the adaptive storage GC ran because of the deltas backlog.")   \
+  M(GcMemoryTriggered, "Number of times the adaptive storage GC ran because of the memory usage.")
 
 namespace EventCounter {
 
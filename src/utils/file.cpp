@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -21,6 +21,7 @@
 #include <mutex>
 #include <shared_mutex>
 #include <type_traits>
+#include <utility>
 
 #include "utils/logging.hpp"
 
@@ -288,6 +289,104 @@ bool InputFile::LoadBuffer() {
   return true;
 }
 
+namespace {
+
+// Number of entries in the submission queue of the ring used for the
+// asynchronous writes. A file has at most one write in flight.
+constexpr uint32_t kAsyncWriteQueueSize = 4;
+
+void WriteFileDescriptor(int fd, const uint8_t *data, size_t size, const std::filesystem::path &path,
+                         size_t written_since_last_sync) {
+  while (size > 0) {
+    auto written = write(fd, data, size);
+    if (written == -1 && errno == EINTR) {
+      continue;
+    }
+
+    MG_ASSERT(written > 0,
+              "while trying to write to {} an error occurred: {} ({}). "
+              "Possibly {} bytes of data were lost from this call and "
+              "possibly {} bytes were lost from previous calls.",
+              path, strerror(errno), errno, size, written_since_last_sync);
+
+    size -= written;
+    data += written;
+  }
+}
+
+void SyncFileDescriptor(int fd, const std::filesystem::path &path, size_t written_since_last_sync) {
+  int ret = 0;
+  while (true) {
+    ret = fsync(fd);
+    if (ret == -1 && errno == EINTR) {
+      // The call was interrupted, try again...
+      continue;
+    } else {
+      // All other possible errors are fatal errors and are handled in the
+      // MG_ASSERT below.
+      break;
+    }
+  }
+
+  // In this check we are extremely rigorous because any error except EINTR is
+  // treated as a fatal error that will crash the database. The errors that will
+  // mainly occur are EIO which indicates an I/O error on the physical device
+  // and ENOSPC (documented only in new kernels) which indicates that the
+  // physical device doesn't have any space left. If we don't succeed in
+  // syncing pending data to the physical device there is no mechanism to
+  // determine which parts of the `write` calls weren't synced. That is why
+  // we call this a fatal error and we don't continue further.
+  //
+  // A good description of issues with `fsync` can be seen here:
+  // https://stackoverflow.com/questions/42434872/writing-programs-to-cope-with-i-o-errors-causing-lost-writes-on-linux
+  //
+  // A discussion between PostgreSQL developers of what to do when `fsync`
+  // fails can be seen here:
+  // https://www.postgresql.org/message-id/flat/CAMsr%2BYE5Gs9iPqw2mQ6OHt1aC5Qk5EuBFCyG%2BvzHun1EqMxyQg%40mail.gmail.com#CAMsr+YE5Gs9iPqw2mQ6OHt1aC5Qk5EuBFCyG+vzHun1EqMxyQg@mail.gmail.com
+  //
+  // A brief of the `fsync` semantics can be seen here (part of the mailing list
+  // discussion linked above):
+  // https://www.postgresql.org/message-id/20180402185320.GM11627%40technoir
+  //
+  // The PostgreSQL developers decided to do the same thing (die) when such an
+  // error occurs:
+  // https://www.postgresql.org/message-id/20180427222842.in2e4mibx45zdth5@alap3.anarazel.de
+  MG_ASSERT(ret == 0,
+            "While trying to sync {}, an error occurred: {} ({}). Possibly {} "
+            "bytes from previous write calls were lost.",
+            path, strerror(errno), errno, written_since_last_sync);
+}
+
+}  // namespace
+
+FileSyncHandle::FileSyncHandle(int fd, std::filesystem::path path, size_t written_since_last_sync)
+    : fd_(fd), path_(std::move(path)), written_since_last_sync_(written_since_last_sync) {}
+
+FileSyncHandle::FileSyncHandle(FileSyncHandle &&other) noexcept
+    : fd_(std::exchange(other.fd_, -1)),
+      path_(std::move(other.path_)),
+      written_since_last_sync_(other.written_since_last_sync_) {}
+
+FileSyncHandle &FileSyncHandle::operator=(FileSyncHandle &&other) noexcept {
+  if (this != &other) {
+    if (fd_ != -1) close(fd_);
+    fd_ = std::exchange(other.fd_, -1);
+    path_ = std::move(other.path_);
+    written_since_last_sync_ = other.written_since_last_sync_;
+  }
+  return *this;
+}
+
+FileSyncHandle::~FileSyncHandle() {
+  if (fd_ != -1) close(fd_);
+}
+
+void FileSyncHandle::Sync() {
+  MG_ASSERT(fd_ != -1, "Trying to sync through an empty handle!");
+  SyncFileDescriptor(fd_, path_, written_since_last_sync_);
+  written_since_last_sync_ = 0;
+}
+
 OutputFile::~OutputFile() {
   if (IsOpen()) Close();
 }
@@ -296,6 +395,8 @@ OutputFile::OutputFile(OutputFile &&other) noexcept
     : fd_(other.fd_), written_since_last_sync_(other.written_since_last_sync_), path_(std::move(other.path_)) {
   memcpy(buffer_, other.buffer_, kFileBufferSize);
   buffer_position_.store(other.buffer_position_.load());
+  if (other.io_uring_) other.WaitForAsyncWrite();
+  io_uring_ = std::move(other.io_uring_);
   other.fd_ = -1;
   other.written_since_last_sync_ = 0;
   other.buffer_position_ = 0;
@@ -309,6 +410,8 @@ OutputFile &OutputFile::operator=(OutputFile &&other) noexcept {
   path_ = std::move(other.path_);
   buffer_position_ = other.buffer_position_.load();
   memcpy(buffer_, other.buffer_, kFileBufferSize);
+  if (other.io_uring_) other.WaitForAsyncWrite();
+  io_uring_ = std::move(other.io_uring_);
 
   other.fd_ = -1;
   other.written_since_last_sync_ = 0;
@@ -346,6 +449,17 @@ void OutputFile::Open(const std::filesystem::path &path, Mode mode) {
 
 bool OutputFile::IsOpen() const { return fd_ != -1; }
 
+bool OutputFile::EnableAsyncWrites() {
+  if (io_uring_) return true;
+  io_uring_ = IoUring::Create(kAsyncWriteQueueSize, kFileBufferSize);
+  if (!io_uring_) {
+    static std::once_flag warning;
+    std::call_once(warning, [] { spdlog::warn("io_uring isn't available, the files are written using write."); });
+    return false;
+  }
+  return true;
+}
+
 const std::filesystem::path &OutputFile::path() const { return path_; }
 
 void OutputFile::Write(const uint8_t *data, size_t size) {
@@ -373,6 +487,8 @@ void OutputFile::Write(const char *data, size_t size) { Write(reinterpret_cast<c
 void OutputFile::Write(const std::string_view data) { Write(data.data(), data.size()); }
 
 size_t OutputFile::SeekFile(const Position position, const ssize_t offset) {
+  // The asynchronous write moves the position of the file when it's done.
+  WaitForAsyncWrite();
   int whence;
   switch (position) {
     case Position::SET:
@@ -427,54 +543,34 @@ bool OutputFile::AcquireLock() {
 
 void OutputFile::Sync() {
   FlushBuffer(true);
+  WaitForAsyncWrite();
+  SyncFileDescriptor(fd_, path_, written_since_last_sync_);
 
-  int ret = 0;
+  // Reset the counter.
+  written_since_last_sync_ = 0;
+}
+
+FileSyncHandle OutputFile::FlushForSync() {
+  FlushBuffer(true);
+  WaitForAsyncWrite();
+  int fd = -1;
   while (true) {
-    ret = fsync(fd_);
-    if (ret == -1 && errno == EINTR) {
-      // The call was interrupted, try again...
-      continue;
-    } else {
-      // All other possible errors are fatal errors and are handled in the
-      // MG_ASSERT below.
-      break;
-    }
+    fd = fcntl(fd_, F_DUPFD_CLOEXEC, 0);
+    if (fd == -1 && errno == EINTR) continue;
+    break;
   }
-
-  // In this check we are extremely rigorous because any error except EINTR is
-  // treated as a fatal error that will crash the database. The errors that will
-  // mainly occur are EIO which indicates an I/O error on the physical device
-  // and ENOSPC (documented only in new kernels) which indicates that the
-  // physical device doesn't have any space left. If we don't succeed in
-  // syncing pending data to the physical device there is no mechanism to
-  // determine which parts of the `write` calls weren't synced. That is why
-  // we call this a fatal error and we don't continue further.
-  //
-  // A good description of issues with `fsync` can be seen here:
-  // https://stackoverflow.com/questions/42434872/writing-programs-to-cope-with-i-o-errors-causing-lost-writes-on-linux
-  //
-  // A discussion between PostgreSQL developers of what to do when `fsync`
-  // fails can be seen here:
-  // https://www.postgresql.org/message-id/flat/CAMsr%2BYE5Gs9iPqw2mQ6OHt1aC5Qk5EuBFCyG%2BvzHun1EqMxyQg%40mail.gmail.com#CAMsr+YE5Gs9iPqw2mQ6OHt1aC5Qk5EuBFCyG+vzHun1EqMxyQg@mail.gmail.com
-  //
-  // A brief of the `fsync` semantics can be seen here (part of the mailing list
-  // discussion linked above):
-  // https://www.postgresql.org/message-id/20180402185320.GM11627%40technoir
-  //
-  // The PostgreSQL developers decided to do the same thing (die) when such an
-  // error occurs:
-  // https://www.postgresql.org/message-id/20180427222842.in2e4mibx45zdth5@alap3.anarazel.de
-  MG_ASSERT(ret == 0,
-            "While trying to sync {}, an error occurred: {} ({}). Possibly {} "
-            "bytes from previous write calls were lost.",
-            path_, strerror(errno), errno, written_since_last_sync_);
-
-  // Reset the counter.
+  MG_ASSERT(fd != -1, "While trying to duplicate the descriptor of {}, an error occurred: {} ({}).", path_,
+            strerror(errno), errno);
+  // The data is counted as synced because the caller is responsible for
+  // syncing it through the handle.
+  FileSyncHandle handle(fd, path_, written_since_last_sync_);
   written_since_last_sync_ = 0;
+  return handle;
 }
 
 void OutputFile::Close() noexcept {
   FlushBuffer(true);
+  WaitForAsyncWrite();
 
   int ret = 0;
   while (true) {
@@ -514,28 +610,55 @@ void OutputFile::FlushBufferInternal() {
             "buffer than the buffer has space!",
             path_);
 
-  auto *buffer = buffer_;
-  auto buffer_position = buffer_position_.load();
-  while (buffer_position > 0) {
-    auto written = write(fd_, buffer, buffer_position_);
-    if (written == -1 && errno == EINTR) {
-      continue;
+  const auto buffer_position = buffer_position_.load();
+  if (io_uring_) {
+    std::lock_guard guard(async_write_lock_);
+    WaitForAsyncWriteLocked();
+    if (buffer_position == 0) return;
+    // The data is copied to the registered buffer of the ring, so the
+    // internal buffer can be filled again while the data is written.
+    memcpy(io_uring_->buffer(), buffer_, buffer_position);
+    if (const auto error = io_uring_->SubmitWrite(fd_, buffer_position, 0); error == 0) {
+      async_write_size_ = buffer_position;
+      buffer_position_.store(0);
+      return;
     }
-
-    MG_ASSERT(written > 0,
-              "while trying to write to {} an error occurred: {} ({}). "
-              "Possibly {} bytes of data were lost from this call and "
-              "possibly {} bytes were lost from previous calls.",
-              path_, strerror(errno), errno, buffer_position_, written_since_last_sync_);
-
-    buffer_position -= written;
-    buffer += written;
+    // The data is written using the blocking write if the asynchronous write
+    // couldn't be submitted.
   }
 
-  buffer_position_.store(buffer_position);
+  WriteFileDescriptor(fd_, buffer_, buffer_position, path_, written_since_last_sync_);
+  buffer_position_.store(0);
+}
+
+void OutputFile::WaitForAsyncWrite() {
+  if (!io_uring_) return;
+  std::lock_guard guard(async_write_lock_);
+  WaitForAsyncWriteLocked();
+}
+
+void OutputFile::WaitForAsyncWriteLocked() {
+  if (async_write_size_ == 0) return;
+  const auto [_, result] = io_uring_->WaitCompletion();
+  MG_ASSERT(result >= 0,
+            "while trying to write to {} an error occurred: {} ({}). "
+            "Possibly {} bytes of data were lost from this call and "
+            "possibly {} bytes were lost from previous calls.",
+            path_, strerror(-result), -result, async_write_size_, written_since_last_sync_);
+  // The rest of a short write is written using the blocking write.
+  const auto written = static_cast<size_t>(result);
+  if (written < async_write_size_) {
+    WriteFileDescriptor(fd_, io_uring_->buffer() + written, async_write_size_ - written, path_,
+                        written_since_last_sync_);
+  }
+  async_write_size_ = 0;
 }
 
-void OutputFile::DisableFlushing() { flush_lock_.lock_shared(); }
+void OutputFile::DisableFlushing() {
+  flush_lock_.lock_shared();
+  // The readers of the file expect all of the flushed data to be in it.
+  WaitForAsyncWrite();
+}
 
 void OutputFile::EnableFlushing() {
   flush_lock_.unlock_shared();
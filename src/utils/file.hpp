@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -19,11 +19,14 @@
 
 #include <atomic>
 #include <filesystem>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include "utils/io_uring.hpp"
 #include "utils/rw_lock.hpp"
 
 namespace memgraph::utils {
@@ -143,6 +146,31 @@ class InputFile {
   size_t buffer_position_{0};
 };
 
+/// Handle used to sync the data written by an `OutputFile` independently of
+/// the file itself. It owns a duplicate of the file descriptor, so it can be
+/// synced while the file is concurrently written to (or even closed). This is
+/// used to sync the write-ahead log without blocking its writers.
+class FileSyncHandle {
+ public:
+  FileSyncHandle(int fd, std::filesystem::path path, size_t written_since_last_sync);
+  ~FileSyncHandle();
+
+  FileSyncHandle(const FileSyncHandle &) = delete;
+  FileSyncHandle &operator=(const FileSyncHandle &) = delete;
+
+  FileSyncHandle(FileSyncHandle &&other) noexcept;
+  FileSyncHandle &operator=(FileSyncHandle &&other) noexcept;
+
+  /// Syncs the data which was written to the file before the handle was
+  /// created to permanent storage. On failure it crashes the program.
+  void Sync();
+
+ private:
+  int fd_{-1};
+  std::filesystem::path path_;
+  size_t written_since_last_sync_{0};
+};
+
 /// This class implements a file handler that is used for mission critical files
 /// that need to be written and synced to permanent storage. Typical usage for
 /// this class is in implementation of write-ahead logging or anything similar
@@ -201,6 +229,14 @@ class OutputFile {
   /// Returns a boolean indicating whether a file is opened.
   bool IsOpen() const;
 
+  /// Makes the full internal buffer be written asynchronously using
+  /// `io_uring`, so the writer can fill the buffer again while the previous
+  /// data is written. At most one write is in flight, it is waited for before
+  /// the file is synced, closed, seeked or read using `DisableFlushing`.
+  /// Returns `false` if `io_uring` isn't available, in which case the file
+  /// keeps using the blocking writes.
+  bool EnableAsyncWrites();
+
   /// Returns the path to the currently opened file. If a file isn't opened the
   /// path is empty.
   const std::filesystem::path &path() const;
@@ -232,6 +268,13 @@ class OutputFile {
   /// and misuse it crashes the program.
   void Sync();
 
+  /// Writes the internal buffer to the currently opened file and returns a
+  /// handle which syncs the written data. The handle can be synced without
+  /// holding the locks which protect this object, so the writers aren't
+  /// blocked while the data is synced. On failure and misuse it crashes the
+  /// program.
+  FileSyncHandle FlushForSync();
+
   /// Closes the currently opened file. It doesn't perform a `Sync` on the
   /// file. On failure and misuse it crashes the program.
   void Close() noexcept;
@@ -256,6 +299,9 @@ class OutputFile {
  private:
   void FlushBuffer(bool force_flush);
   void FlushBufferInternal();
+  // Waits until the asynchronous write is finished.
+  void WaitForAsyncWrite();
+  void WaitForAsyncWriteLocked();
 
   size_t SeekFile(Position position, ssize_t offset);
 
@@ -267,6 +313,12 @@ class OutputFile {
 
   // Flushing buffer should be a higher priority
   utils::RWLock flush_lock_{RWLock::Priority::WRITE};
+
+  // Set when the asynchronous writes are enabled. The data of the write in
+  // flight is in the buffer of the ring.
+  std::unique_ptr<IoUring> io_uring_;
+  size_t async_write_size_{0};
+  std::mutex async_write_lock_;
 };
 
 }  // namespace memgraph::utils
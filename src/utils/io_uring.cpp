@@ -0,0 +1,161 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "utils/io_uring.hpp"
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "utils/logging.hpp"
+
+namespace memgraph::utils {
+
+namespace {
+
+int IoUringSetup(uint32_t entries, io_uring_params *params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int ring_fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int IoUringRegister(int ring_fd, uint32_t opcode, const void *arg, uint32_t nr_args) {
+  return static_cast<int>(syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args));
+}
+
+template <typename T>
+T *RingField(void *ring, uint32_t offset) {
+  return reinterpret_cast<T *>(static_cast<uint8_t *>(ring) + offset);
+}
+
+}  // namespace
+
+std::unique_ptr<IoUring> IoUring::Create(uint32_t entries, size_t buffer_size) {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  const int ring_fd = IoUringSetup(entries, &params);
+  if (ring_fd < 0) {
+    spdlog::debug("Couldn't set up io_uring: {} ({})", strerror(errno), errno);
+    return nullptr;
+  }
+  std::unique_ptr<IoUring> ring(new IoUring());
+  ring->ring_fd_ = ring_fd;
+
+  // The writes are made at the current position of the file, which is
+  // supported only by the newer kernels.
+  if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+    spdlog::debug("The kernel doesn't support io_uring writes at the current file position.");
+    return nullptr;
+  }
+
+  ring->sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  ring->cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap) {
+    ring->sq_ring_size_ = ring->cq_ring_size_ = std::max(ring->sq_ring_size_, ring->cq_ring_size_);
+  }
+  auto map = [ring_fd](size_t size, off_t offset) -> void * {
+    auto *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, offset);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+  };
+  ring->sq_ring_ = map(ring->sq_ring_size_, IORING_OFF_SQ_RING);
+  if (!ring->sq_ring_) return nullptr;
+  if (single_mmap) {
+    ring->cq_ring_ = ring->sq_ring_;
+  } else {
+    ring->cq_ring_ = map(ring->cq_ring_size_, IORING_OFF_CQ_RING);
+    if (!ring->cq_ring_) return nullptr;
+  }
+  ring->sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  ring->sqes_ = map(ring->sqes_size_, IORING_OFF_SQES);
+  if (!ring->sqes_) return nullptr;
+
+  ring->sq_head_ = RingField<uint32_t>(ring->sq_ring_, params.sq_off.head);
+  ring->sq_tail_ = RingField<uint32_t>(ring->sq_ring_, params.sq_off.tail);
+  ring->sq_mask_ = *RingField<uint32_t>(ring->sq_ring_, params.sq_off.ring_mask);
+  ring->sq_array_ = RingField<uint32_t>(ring->sq_ring_, params.sq_off.array);
+  ring->cq_head_ = RingField<uint32_t>(ring->cq_ring_, params.cq_off.head);
+  ring->cq_tail_ = RingField<uint32_t>(ring->cq_ring_, params.cq_off.tail);
+  ring->cq_mask_ = *RingField<uint32_t>(ring->cq_ring_, params.cq_off.ring_mask);
+  ring->cqes_ = RingField<void>(ring->cq_ring_, params.cq_off.cqes);
+
+  ring->buffer_ = std::make_unique<uint8_t[]>(buffer_size);
+  ring->buffer_size_ = buffer_size;
+  iovec buffer_vec{ring->buffer_.get(), buffer_size};
+  if (IoUringRegister(ring_fd, IORING_REGISTER_BUFFERS, &buffer_vec, 1) == 0) {
+    ring->registered_buffer_ = true;
+  } else {
+    spdlog::debug("Couldn't register the io_uring buffer: {} ({})", strerror(errno), errno);
+  }
+  return ring;
+}
+
+IoUring::~IoUring() {
+  if (sqes_) munmap(sqes_, sqes_size_);
+  if (cq_ring_ && cq_ring_ != sq_ring_) munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_) munmap(sq_ring_, sq_ring_size_);
+  if (ring_fd_ != -1) close(ring_fd_);
+}
+
+int IoUring::SubmitWrite(int fd, size_t size, uint64_t user_data) {
+  MG_ASSERT(size <= buffer_size_, "Trying to write more data than the io_uring buffer holds!");
+  const auto tail = *sq_tail_;
+  if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) > sq_mask_) return EBUSY;
+  const auto index = tail & sq_mask_;
+  auto *sqe = static_cast<io_uring_sqe *>(sqes_) + index;
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = registered_buffer_ ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+  sqe->fd = fd;
+  // An offset of -1 makes the write use and advance the position of the file.
+  sqe->off = static_cast<uint64_t>(-1);
+  sqe->addr = reinterpret_cast<uint64_t>(buffer_.get());
+  sqe->len = static_cast<uint32_t>(size);
+  sqe->buf_index = 0;
+  sqe->user_data = user_data;
+  sq_array_[index] = index;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+  while (true) {
+    const int ret = IoUringEnter(ring_fd_, 1, 0, 0);
+    if (ret == -1 && (errno == EINTR || errno == EAGAIN)) continue;
+    if (ret == -1) {
+      // The entry wasn't consumed, so it is taken back.
+      __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+      return errno;
+    }
+    return 0;
+  }
+}
+
+std::pair<uint64_t, int32_t> IoUring::WaitCompletion() {
+  while (true) {
+    const auto head = *cq_head_;
+    if (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+      const auto *cqe = static_cast<io_uring_cqe *>(cqes_) + (head & cq_mask_);
+      std::pair<uint64_t, int32_t> result{cqe->user_data, cqe->res};
+      __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+      return result;
+    }
+    const int ret = IoUringEnter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS);
+    MG_ASSERT(ret != -1 || errno == EINTR, "Waiting for an io_uring completion failed: {} ({})", strerror(errno),
+              errno);
+  }
+}
+
+}  // namespace memgraph::utils
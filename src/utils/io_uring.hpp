@@ -0,0 +1,95 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/**
+ * @file
+ *
+ * This file contains a minimal wrapper around the Linux `io_uring` interface
+ * which is used to write files asynchronously. The ring is set up directly
+ * with the system calls, so it doesn't depend on `liburing`.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace memgraph::utils {
+
+/// An `io_uring` instance with a single buffer which is registered with the
+/// kernel. The writes are made from the registered buffer, so the kernel
+/// doesn't have to map the memory for each of them.
+///
+/// The class isn't thread-safe.
+class IoUring {
+ public:
+  /// Creates a ring with `entries` submission queue entries and a registered
+  /// buffer of `buffer_size` bytes. Returns `nullptr` if `io_uring` isn't
+  /// available, e.g. because the kernel is too old or the system calls are
+  /// blocked. When the buffer can't be registered (e.g. because of the locked
+  /// memory limit) the ring is still created and the writes are made without
+  /// the registered buffer.
+  static std::unique_ptr<IoUring> Create(uint32_t entries, size_t buffer_size);
+
+  IoUring(const IoUring &) = delete;
+  IoUring &operator=(const IoUring &) = delete;
+  IoUring(IoUring &&) = delete;
+  IoUring &operator=(IoUring &&) = delete;
+
+  ~IoUring();
+
+  /// The buffer from which the data is written.
+  uint8_t *buffer() { return buffer_.get(); }
+  size_t buffer_size() const { return buffer_size_; }
+
+  /// Returns `true` if the buffer is registered with the kernel.
+  bool has_registered_buffer() const { return registered_buffer_; }
+
+  /// Submits a write of the first `size` bytes of the buffer at the current
+  /// position of the file, which is moved forward like with `write`. The
+  /// writes to the same file have to be waited for one at a time because the
+  /// kernel can execute the queued writes in any order. Returns the error
+  /// number if the write couldn't be submitted, 0 otherwise.
+  int SubmitWrite(int fd, size_t size, uint64_t user_data);
+
+  /// Waits for the next completed operation and returns its user data and
+  /// result. The result is the number of written bytes or a negative error
+  /// number.
+  std::pair<uint64_t, int32_t> WaitCompletion();
+
+ private:
+  IoUring() = default;
+
+  int ring_fd_{-1};
+
+  void *sq_ring_{nullptr};
+  size_t sq_ring_size_{0};
+  void *cq_ring_{nullptr};
+  size_t cq_ring_size_{0};
+  void *sqes_{nullptr};
+  size_t sqes_size_{0};
+
+  uint32_t *sq_head_{nullptr};
+  uint32_t *sq_tail_{nullptr};
+  uint32_t sq_mask_{0};
+  uint32_t *sq_array_{nullptr};
+  uint32_t *cq_head_{nullptr};
+  uint32_t *cq_tail_{nullptr};
+  uint32_t cq_mask_{0};
+  void *cqes_{nullptr};
+
+  std::unique_ptr<uint8_t[]> buffer_;
+  size_t buffer_size_{0};
+  bool registered_buffer_{false};
+};
+
+}  // namespace memgraph::utils
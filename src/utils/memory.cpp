@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -12,6 +12,7 @@
 #include "utils/memory.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <limits>
@@ -348,4 +349,167 @@ void PoolResource::Release() {
 
 // PoolResource END
 
+// SlabResource
+
+namespace {
+
+size_t CurrentThreadShard(size_t num_shards) {
+  static std::atomic<size_t> next_thread{0};
+  thread_local const size_t thread_index = next_thread.fetch_add(1, std::memory_order_relaxed);
+  return thread_index % num_shards;
+}
+
+template <class TItem>
+void ListPushFront(TItem **head, TItem *item) {
+  item->prev = nullptr;
+  item->next = *head;
+  if (*head) (*head)->prev = item;
+  *head = item;
+}
+
+template <class TItem>
+void ListRemove(TItem **head, TItem *item) {
+  if (item->prev) {
+    item->prev->next = item->next;
+  } else {
+    *head = item->next;
+  }
+  if (item->next) item->next->prev = item->prev;
+  item->prev = nullptr;
+  item->next = nullptr;
+}
+
+}  // namespace
+
+SlabResource::SlabResource(size_t max_block_size, size_t num_shards, MemoryResource *memory)
+    : memory_(memory), max_block_size_(max_block_size), shards_(num_shards) {
+  MG_ASSERT(num_shards > 0U, "Invalid number of shards");
+  MG_ASSERT(max_block_size_ > 0U && max_block_size_ <= kSlabSize / 2, "Invalid size of block");
+  const auto num_size_classes = (max_block_size_ + kBlockAlignment - 1) / kBlockAlignment;
+  for (auto &shard : shards_) {
+    shard.size_classes.resize(num_size_classes);
+    for (size_t i = 0; i < num_size_classes; ++i) {
+      auto &size_class = shard.size_classes[i];
+      size_class.shard = &shard;
+      size_class.block_size = (i + 1) * kBlockAlignment;
+      size_class.capacity = static_cast<uint32_t>((kSlabSize - kSlabHeaderSize) / size_class.block_size);
+    }
+  }
+}
+
+SlabResource::~SlabResource() {
+  for (auto &shard : shards_) {
+    for (auto &size_class : shard.size_classes) {
+      for (auto *list : {&size_class.partial, &size_class.full}) {
+        while (*list) {
+          auto *slab = *list;
+          ListRemove(list, slab);
+          FreeSlab(slab);
+        }
+      }
+      if (size_class.empty) FreeSlab(std::exchange(size_class.empty, nullptr));
+    }
+  }
+}
+
+SlabResource::Slab *SlabResource::NewSlab(SizeClass *size_class) {
+  auto *slab = static_cast<Slab *>(memory_->Allocate(kSlabSize, kSlabSize));
+  *slab = Slab{nullptr, nullptr, size_class, nullptr, 0, 0};
+  auto &stats = size_class->shard->stats;
+  stats.reserved_bytes += kSlabSize;
+  ++stats.slabs;
+  return slab;
+}
+
+void SlabResource::FreeSlab(Slab *slab) {
+  auto &stats = slab->size_class->shard->stats;
+  stats.reserved_bytes -= kSlabSize;
+  --stats.slabs;
+  memory_->Deallocate(slab, kSlabSize, kSlabSize);
+}
+
+void *SlabResource::DoAllocate(size_t bytes, size_t alignment) {
+  if (bytes > max_block_size_ || alignment > kBlockAlignment) return memory_->Allocate(bytes, alignment);
+  auto &shard = shards_[CurrentThreadShard(shards_.size())];
+  std::lock_guard<SpinLock> guard(shard.lock);
+  auto &size_class = shard.size_classes[(bytes - 1) / kBlockAlignment];
+  auto *slab = size_class.partial;
+  if (!slab) {
+    slab = size_class.empty ? std::exchange(size_class.empty, nullptr) : NewSlab(&size_class);
+    ListPushFront(&size_class.partial, slab);
+  }
+  void *block = nullptr;
+  if (slab->free_list) {
+    block = slab->free_list;
+    slab->free_list = *static_cast<void **>(block);
+  } else {
+    // The blocks which were never allocated aren't in the free list, they are
+    // carved from the rest of the slab instead.
+    block = reinterpret_cast<char *>(slab) + kSlabHeaderSize + slab->carved * size_class.block_size;
+    ++slab->carved;
+  }
+  if (++slab->used == size_class.capacity) {
+    ListRemove(&size_class.partial, slab);
+    ListPushFront(&size_class.full, slab);
+  }
+  shard.stats.allocated_bytes += size_class.block_size;
+  return block;
+}
+
+void SlabResource::DoDeallocate(void *p, size_t bytes, size_t alignment) {
+  if (bytes > max_block_size_ || alignment > kBlockAlignment) return memory_->Deallocate(p, bytes, alignment);
+  auto *slab = reinterpret_cast<Slab *>(reinterpret_cast<uintptr_t>(p) & ~(kSlabSize - 1));
+  auto *size_class = slab->size_class;
+  auto &shard = *size_class->shard;
+  std::lock_guard<SpinLock> guard(shard.lock);
+  MG_ASSERT(size_class->block_size == (bytes + kBlockAlignment - 1) / kBlockAlignment * kBlockAlignment,
+            "Failed deallocation");
+  *static_cast<void **>(p) = slab->free_list;
+  slab->free_list = p;
+  shard.stats.allocated_bytes -= size_class->block_size;
+  if (slab->used-- == size_class->capacity) {
+    ListRemove(&size_class->full, slab);
+    ListPushFront(&size_class->partial, slab);
+  }
+  if (slab->used == 0) {
+    ListRemove(&size_class->partial, slab);
+    if (size_class->empty) {
+      FreeSlab(slab);
+      ++shard.stats.released_slabs;
+    } else {
+      slab->free_list = nullptr;
+      slab->carved = 0;
+      size_class->empty = slab;
+    }
+  }
+}
+
+size_t SlabResource::ReleaseEmptySlabs() {
+  size_t released = 0;
+  for (auto &shard : shards_) {
+    std::lock_guard<SpinLock> guard(shard.lock);
+    for (auto &size_class : shard.size_classes) {
+      if (!size_class.empty) continue;
+      FreeSlab(std::exchange(size_class.empty, nullptr));
+      ++shard.stats.released_slabs;
+      ++released;
+    }
+  }
+  return released;
+}
+
+SlabResource::Stats SlabResource::GetStats() const {
+  Stats stats;
+  for (const auto &shard : shards_) {
+    std::lock_guard<SpinLock> guard(shard.lock);
+    stats.reserved_bytes += shard.stats.reserved_bytes;
+    stats.allocated_bytes += shard.stats.allocated_bytes;
+    stats.slabs += shard.stats.slabs;
+    stats.released_slabs += shard.stats.released_slabs;
+  }
+  return stats;
+}
+
+// SlabResource END
+
 }  // namespace memgraph::utils
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -539,6 +539,118 @@ class SynchronizedPoolResource final : public MemoryResource {
   bool DoIsEqual(const MemoryResource &other) const noexcept override { return this == &other; }
 };
 
+/// Thread-safe MemoryResource which serves small blocks of the same size from
+/// slabs. It is meant for long-lived objects which are created and deleted
+/// all the time, e.g. the nodes of the skip lists holding the vertices and the
+/// edges.
+///
+/// This class has the following properties with regards to memory management.
+///
+///   * The requested sizes are rounded up to a multiple of `kBlockAlignment`,
+///     and each such size class is served from its own slabs of `kSlabSize`
+///     bytes. Requests which are larger than the maximum block size or have a
+///     larger alignment than `kBlockAlignment` are forwarded to upstream.
+///   * The slabs are aligned to their size, so the slab owning a block is
+///     found from the block's address.
+///   * The resource is divided into shards, each with its own lock and slabs.
+///     Each thread allocates from the same shard, so the shards act as thread
+///     caches while there are at least as many shards as threads. A block is
+///     always returned to the shard it was allocated from.
+///   * Once all blocks of a slab are freed, the slab is returned to upstream.
+///     Only a single empty slab per size class is kept to avoid allocating a
+///     new slab each time a block is allocated and freed in turn. These are
+///     returned with `ReleaseEmptySlabs`.
+///   * All allocated memory is freed upon destruction, even if Deallocate has
+///     not been called for some of the allocated blocks.
+class SlabResource final : public MemoryResource {
+ public:
+  static constexpr size_t kSlabSize = 16UL * 1024UL;
+  static constexpr size_t kBlockAlignment = alignof(std::max_align_t);
+
+  struct Stats {
+    // Bytes of the slabs obtained from upstream.
+    uint64_t reserved_bytes{0};
+    // Bytes of the blocks which are currently allocated.
+    uint64_t allocated_bytes{0};
+    uint64_t slabs{0};
+    // Number of slabs which were returned to upstream after all of their
+    // blocks were freed.
+    uint64_t released_slabs{0};
+
+    /// Share of the reserved memory which isn't used by the allocated blocks.
+    double Fragmentation() const {
+      if (reserved_bytes == 0) return 0.0;
+      return 1.0 - static_cast<double>(allocated_bytes) / static_cast<double>(reserved_bytes);
+    }
+  };
+
+  /// Construct with the given maximum block size, number of shards and
+  /// upstream memory. `max_block_size` can be at most `kSlabSize / 2`.
+  SlabResource(size_t max_block_size, size_t num_shards, MemoryResource *memory = NewDeleteResource());
+
+  SlabResource(const SlabResource &) = delete;
+  SlabResource &operator=(const SlabResource &) = delete;
+  SlabResource(SlabResource &&) = delete;
+  SlabResource &operator=(SlabResource &&) = delete;
+
+  ~SlabResource() override;
+
+  MemoryResource *GetUpstreamResource() const { return memory_; }
+
+  /// Returns the empty slabs which are kept for reuse to upstream. Returns the
+  /// number of released slabs.
+  size_t ReleaseEmptySlabs();
+
+  Stats GetStats() const;
+
+ private:
+  struct Shard;
+  struct SizeClass;
+
+  struct Slab {
+    Slab *prev;
+    Slab *next;
+    SizeClass *size_class;
+    void *free_list;
+    uint32_t used;
+    uint32_t carved;
+  };
+
+  struct SizeClass {
+    Shard *shard{nullptr};
+    size_t block_size{0};
+    uint32_t capacity{0};
+    // Slabs which have both allocated and free blocks.
+    Slab *partial{nullptr};
+    // Slabs whose blocks are all allocated.
+    Slab *full{nullptr};
+    // A single slab whose blocks are all free.
+    Slab *empty{nullptr};
+  };
+
+  struct alignas(64) Shard {
+    mutable SpinLock lock;
+    std::vector<SizeClass> size_classes;
+    Stats stats;
+  };
+
+  // The blocks follow the header, so it is padded to keep them aligned.
+  static constexpr size_t kSlabHeaderSize = (sizeof(Slab) + kBlockAlignment - 1) / kBlockAlignment * kBlockAlignment;
+
+  Slab *NewSlab(SizeClass *size_class);
+  void FreeSlab(Slab *slab);
+
+  MemoryResource *memory_;
+  size_t max_block_size_;
+  std::vector<Shard> shards_;
+
+  void *DoAllocate(size_t bytes, size_t alignment) override;
+
+  void DoDeallocate(void *p, size_t bytes, size_t alignment) override;
+
+  bool DoIsEqual(const MemoryResource &other) const noexcept override { return this == &other; }
+};
+
 class LimitedMemoryResource final : public utils::MemoryResource {
  public:
   explicit LimitedMemoryResource(utils::MemoryResource *memory, size_t max_allocated_bytes)
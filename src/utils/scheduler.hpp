@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -16,6 +16,7 @@
 #include <condition_variable>
 #include <ctime>
 #include <functional>
+#include <mutex>
 #include <thread>
 
 #include "utils/logging.hpp"
@@ -62,12 +63,20 @@ class Scheduler {
         auto now = std::chrono::system_clock::now();
         start_time += pause;
         if (start_time > now) {
-          condition_variable_.wait_for(lk, start_time - now, [&] { return is_working_.load() == false; });
+          condition_variable_.wait_for(lk, start_time - now,
+                                       [&] { return is_working_.load() == false || notified_.load(); });
         } else {
           start_time = now;
         }
+        if (notified_.exchange(false)) {
+          // The next pause is measured from this execution.
+          start_time = std::chrono::system_clock::now();
+        }
 
         if (!is_working_) break;
+        // The function is executed without the lock so that `Notify` doesn't
+        // wait for it.
+        lk.unlock();
         f();
       }
     });
@@ -87,6 +96,23 @@ class Scheduler {
     if (thread_.joinable()) thread_.join();
   }
 
+  /**
+   * @brief Wakes the thread up so that the function is executed right away
+   * instead of after the rest of the pause. The call doesn't block, so it can
+   * be made while the function is executing, in which case the function is
+   * executed again right after it finishes.
+   */
+  void Notify() {
+    {
+      // The flag is set under the lock so that it can't be set between the
+      // check of the predicate and the blocking of the waiting thread, which
+      // would lose the notification until the end of the pause.
+      std::lock_guard<std::mutex> guard(mutex_);
+      if (notified_.exchange(true)) return;
+    }
+    condition_variable_.notify_one();
+  }
+
   /**
    * Returns whether the scheduler is running.
    */
@@ -100,6 +126,12 @@ class Scheduler {
    */
   std::atomic<bool> is_working_{false};
 
+  /**
+   * Variable is true when the function should be executed without waiting
+   * for the rest of the pause.
+   */
+  std::atomic<bool> notified_{false};
+
   /**
    * Mutex used to synchronize threads using condition variable.
    */
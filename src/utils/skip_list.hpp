@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <cmath>
 #include <cstdint>
@@ -20,6 +21,7 @@
 #include <optional>
 #include <random>
 #include <utility>
+#include <vector>
 
 #include "utils/bound.hpp"
 #include "utils/linux.hpp"
@@ -59,6 +61,12 @@ const uint64_t kSkipListGcHeightTrigger = 16;
 /// elements.
 const int kSkipListCountEstimateDefaultLayer = 10;
 
+/// This is the number of nodes that are sampled from the upper layers of the
+/// list for each chunk when the list is split into chunks. More samples give
+/// chunks of more even sizes, but the upper layers have to be traversed
+/// further to collect them.
+const uint64_t kSkipListChunkSamplesPerChunk = 8;
+
 /// These variables define the storage sizes for the SkipListGc. The internal
 /// storage of the GC and the Stack storage used within the GC are all
 /// optimized to have block sizes that are a whole multiple of the memory page
@@ -621,6 +629,68 @@ class SkipList final {
     TNode *node_;
   };
 
+  class Chunk;
+
+  /// Iterator over the items of a single `Chunk`. The iteration ends when an
+  /// item that isn't less than the first item of the next chunk is reached.
+  /// The end is found by comparing the items instead of the nodes so that the
+  /// iteration stops correctly even when the first node of the next chunk is
+  /// removed concurrently.
+  class ChunkIterator final {
+   private:
+    friend class SkipList;
+    friend class Chunk;
+
+    ChunkIterator(TNode *node, TNode *end) : node_(node), end_(end) { skip_removed_and_check_end(); }
+
+   public:
+    TObj &operator*() const { return node_->obj; }
+
+    TObj *operator->() const { return &node_->obj; }
+
+    bool operator==(const ChunkIterator &other) const { return node_ == other.node_; }
+
+    bool operator!=(const ChunkIterator &other) const { return node_ != other.node_; }
+
+    ChunkIterator &operator++() {
+      node_ = node_->nexts[0].load(std::memory_order_acquire);
+      skip_removed_and_check_end();
+      return *this;
+    }
+
+   private:
+    void skip_removed_and_check_end() {
+      while (node_ != nullptr && node_->marked.load(std::memory_order_acquire)) {
+        node_ = node_->nexts[0].load(std::memory_order_acquire);
+      }
+      if (node_ != nullptr && end_ != nullptr && !(node_->obj < end_->obj)) {
+        node_ = nullptr;
+      }
+    }
+
+    TNode *node_;
+    TNode *end_;
+  };
+
+  /// A contiguous key range of the list that can be iterated independently of
+  /// the other chunks of the list, see `Accessor::chunks`. The chunk is only
+  /// valid while the accessor that created it is alive.
+  class Chunk final {
+   private:
+    friend class SkipList;
+
+    Chunk(TNode *first, TNode *end) : first_(first), end_(end) {}
+
+   public:
+    ChunkIterator begin() const { return ChunkIterator{first_, end_}; }
+
+    ChunkIterator end() const { return ChunkIterator{nullptr, nullptr}; }
+
+   private:
+    TNode *first_;
+    TNode *end_;
+  };
+
   class Accessor final {
    private:
     friend class SkipList;
@@ -664,6 +734,15 @@ class SkipList final {
     ///         bool indicates whether the item was inserted into the list
     std::pair<Iterator, bool> insert(TObj &&object) { return skiplist_->insert(std::move(object)); }
 
+    /// Inserts the objects from the range [first, last) into an empty list.
+    /// The objects are linked into the list one after another without
+    /// searching for their positions, which is much faster than inserting them
+    /// one by one. The objects must be sorted in ascending order and mustn't
+    /// contain duplicates. The list mustn't be accessed by other threads until
+    /// the function returns.
+    template <typename TIterator>
+    void bulk_insert(TIterator first, TIterator last) { skiplist_->bulk_insert(first, last); }
+
     /// Checks whether the key exists in the list.
     ///
     /// @return bool indicating whether the item exists
@@ -744,6 +823,17 @@ class SkipList final {
       return skiplist_->template remove(key);
     }
 
+    /// Splits the list into at most `num_chunks` chunks of roughly equal sizes
+    /// that together cover the whole list. The chunks are determined using the
+    /// nodes of the upper layers of the list as sampling points, so the split
+    /// takes O(num_chunks) time and doesn't depend on the size of the list.
+    /// Fewer chunks are returned when the list doesn't have enough items, but
+    /// there is always at least one chunk. Each chunk can be iterated by a
+    /// different thread while this accessor is alive.
+    ///
+    /// @return chunks of the list ordered by their keys
+    std::vector<Chunk> chunks(uint64_t num_chunks) { return skiplist_->chunks(num_chunks); }
+
     /// Returns the number of items contained in the list.
     ///
     /// @return size of the list
@@ -990,6 +1080,38 @@ class SkipList final {
     }
   }
 
+  template <typename TIterator>
+  void bulk_insert(TIterator first, TIterator last) {
+    MG_ASSERT(head_->nexts[0].load(std::memory_order_acquire) == nullptr,
+              "Bulk insertion is supported only for an empty SkipList!");
+    // The last node of each layer, the new node is appended after it.
+    TNode *preds[kSkipListMaxHeight];
+    for (int layer = 0; layer < kSkipListMaxHeight; ++layer) {
+      preds[layer] = head_;
+    }
+    for (; first != last; ++first) {
+      int top_layer = gen_height();
+      size_t node_bytes = sizeof(TNode) + top_layer * sizeof(std::atomic<TNode *>);
+      void *ptr = GetMemoryResource()->Allocate(node_bytes);
+      // `calloc` would be faster, but the API has no such call.
+      memset(ptr, 0, node_bytes);
+      auto *new_node = static_cast<TNode *>(ptr);
+      // Construct through allocator so it propagates if needed.
+      Allocator<TNode> allocator(GetMemoryResource());
+      allocator.construct(new_node, top_layer, *first);
+      DMG_ASSERT(preds[0] == head_ || preds[0]->obj < new_node->obj,
+                 "The objects must be sorted and unique for the SkipList bulk insertion!");
+
+      for (int layer = 0; layer < top_layer; ++layer) {
+        preds[layer]->nexts[layer].store(new_node, std::memory_order_release);
+        preds[layer] = new_node;
+      }
+
+      new_node->fully_linked.store(true, std::memory_order_release);
+      size_.fetch_add(1, std::memory_order_acq_rel);
+    }
+  }
+
   template <typename TKey>
   bool contains(const TKey &key) const {
     TNode *preds[kSkipListMaxHeight], *succs[kSkipListMaxHeight];
@@ -1192,6 +1314,39 @@ class SkipList final {
     return nodes_traversed / unique_count;
   }
 
+  std::vector<Chunk> chunks(uint64_t num_chunks) const {
+    MG_ASSERT(num_chunks >= 1, "The SkipList must be split into at least one chunk!");
+
+    // Find the highest layer that has enough nodes to be used as the sampling
+    // points. Each layer is expected to have two times more nodes than the
+    // layer above it so the layers above the chosen one together have about
+    // as many nodes as the chosen layer.
+    const uint64_t wanted_samples = num_chunks * kSkipListChunkSamplesPerChunk;
+    std::vector<TNode *> samples;
+    for (int layer = kSkipListMaxHeight - 1; layer >= 0; --layer) {
+      samples.clear();
+      for (TNode *curr = head_->nexts[layer].load(std::memory_order_acquire); curr != nullptr;
+           curr = curr->nexts[layer].load(std::memory_order_acquire)) {
+        samples.push_back(curr);
+      }
+      if (samples.size() >= wanted_samples) break;
+    }
+
+    // The first chunk always starts at the beginning of the list and the last
+    // chunk always ends at the end of the list so that the whole list is
+    // covered even though the samples don't have to include the first node.
+    num_chunks = std::max<uint64_t>(1, std::min<uint64_t>(num_chunks, samples.size()));
+    std::vector<Chunk> chunks;
+    chunks.reserve(num_chunks);
+    for (uint64_t i = 0; i < num_chunks; ++i) {
+      TNode *first =
+          i == 0 ? head_->nexts[0].load(std::memory_order_acquire) : samples[i * samples.size() / num_chunks];
+      TNode *end = i + 1 < num_chunks ? samples[(i + 1) * samples.size() / num_chunks] : nullptr;
+      chunks.push_back(Chunk{first, end});
+    }
+    return chunks;
+  }
+
   bool ok_to_delete(TNode *candidate, int layer_found) {
     // The paper has an incorrect check here. It expects the `layer_found`
     // variable to be 1-indexed, but in fact it is 0-indexed.
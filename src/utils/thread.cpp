@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -13,7 +13,13 @@
 
 #include <sys/prctl.h>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
 #include "utils/logging.hpp"
+#include "utils/memory_tracker.hpp"
 
 namespace memgraph::utils {
 
@@ -26,4 +32,30 @@ void ThreadSetName(const std::string &name) {
   }
 }
 
+void RunTasksInParallel(const std::vector<std::function<void()>> &tasks, uint64_t num_threads) {
+  std::atomic<size_t> next_task{0};
+  const auto thread_count = std::min<size_t>(std::max<uint64_t>(num_threads, 1), tasks.size());
+  std::vector<std::exception_ptr> errors(tasks.size());
+  auto run_tasks = [&] {
+    MemoryTracker::OutOfMemoryExceptionEnabler oom_exception;
+    for (auto i = next_task.fetch_add(1); i < tasks.size(); i = next_task.fetch_add(1)) {
+      try {
+        tasks[i]();
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    }
+  };
+  {
+    std::vector<std::jthread> threads;
+    for (size_t i = 1; i < thread_count; ++i) {
+      threads.emplace_back(run_tasks);
+    }
+    run_tasks();
+  }
+  for (const auto &error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
+
 }  // namespace memgraph::utils
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -12,7 +12,10 @@
 /// @file
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <vector>
 
 namespace memgraph::utils {
 
@@ -22,4 +25,10 @@ constexpr size_t GetMaxThreadNameSize() { return 16; }
 /// Beware, the name length limit is 16 characters!
 void ThreadSetName(const std::string &name);
 
+/// Runs the tasks using at most `num_threads` threads, including the calling
+/// thread. The tasks are taken one by one, so they don't have to be of the
+/// same size. If any of the tasks throws, the exception is rethrown once all
+/// of the tasks are done.
+void RunTasksInParallel(const std::vector<std::function<void()>> &tasks, uint64_t num_threads);
+
 };  // namespace memgraph::utils
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -462,6 +462,65 @@ BENCHMARK_TEMPLATE(OrderBy, MonotonicBufferResource)
 
 BENCHMARK_TEMPLATE(OrderBy, PoolResource)->Ranges({{4, 1U << 7U}, {512, 1U << 13U}})->Unit(benchmark::kMicrosecond);
 
+// Pulls the first `state.range(0)` of `state.range(1)` vertices ordered by a
+// random property, either by sorting all of the vertices or with `TopK`.
+template <class TMemory, bool kTopK>
+// NOLINTNEXTLINE(google-runtime-references)
+static void OrderByLimit(benchmark::State &state) {
+  memgraph::query::AstStorage ast;
+  memgraph::storage::Storage db;
+  {
+    auto dba = db.Access();
+    auto prop = dba.NameToProperty("prop");
+    // NOLINTNEXTLINE(cert-msc32-c,cert-msc51-cpp)
+    std::mt19937_64 rg(42);
+    for (int i = 0; i < state.range(1); ++i) {
+      auto rand_value = memgraph::utils::MemcpyCast<int64_t>(rg());
+      MG_ASSERT(dba.CreateVertex().SetProperty(prop, memgraph::storage::PropertyValue(rand_value)).HasValue());
+    }
+    MG_ASSERT(!dba.Commit().HasError());
+  }
+  memgraph::query::SymbolTable symbol_table;
+  auto sym = symbol_table.CreateSymbol("v", false);
+  auto scan_all = std::make_shared<memgraph::query::plan::ScanAll>(nullptr, sym);
+  auto *v_prop = ast.Create<memgraph::query::PropertyLookup>(
+      ast.Create<memgraph::query::Identifier>(sym.name())->MapTo(sym), ast.GetPropertyIx("prop"));
+  auto *limit = ast.Create<memgraph::query::PrimitiveLiteral>(state.range(0));
+  std::shared_ptr<memgraph::query::plan::LogicalOperator> order_by;
+  if constexpr (kTopK) {
+    order_by = std::make_shared<memgraph::query::plan::TopK>(
+        scan_all, memgraph::query::TypedValueVectorCompare({memgraph::query::Ordering::ASC}),
+        std::vector<memgraph::query::Expression *>{v_prop}, std::vector<memgraph::query::Symbol>{sym}, limit, nullptr);
+  } else {
+    order_by = std::make_shared<memgraph::query::plan::OrderBy>(
+        scan_all, std::vector<memgraph::query::SortItem>{{memgraph::query::Ordering::ASC, v_prop}},
+        std::vector<memgraph::query::Symbol>{sym});
+  }
+  memgraph::query::plan::Limit limit_op(order_by, limit);
+  auto storage_dba = db.Access();
+  memgraph::query::DbAccessor dba(&storage_dba);
+  // We need to only set the memory for temporary (per pull) evaluations
+  TMemory per_pull_memory;
+  memgraph::query::EvaluationContext evaluation_context{per_pull_memory.get()};
+  evaluation_context.properties = memgraph::query::NamesToProperties(ast.properties_, &dba);
+  while (state.KeepRunning()) {
+    memgraph::query::ExecutionContext execution_context{&dba, symbol_table, evaluation_context};
+    TMemory memory;
+    memgraph::query::Frame frame(symbol_table.max_position(), memory.get());
+    auto cursor = limit_op.MakeCursor(memory.get());
+    while (cursor->Pull(frame, execution_context)) per_pull_memory.Reset();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(OrderByLimit, PoolResource, false)
+    ->Ranges({{16, 1U << 10U}, {1U << 10U, 1U << 17U}})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(OrderByLimit, PoolResource, true)
+    ->Ranges({{16, 1U << 10U}, {1U << 10U, 1U << 17U}})
+    ->Unit(benchmark::kMicrosecond);
+
 template <class TMemory>
 // NOLINTNEXTLINE(google-runtime-references)
 static void Unwind(benchmark::State &state) {
@@ -0,0 +1,87 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "utils/skip_list.hpp"
+
+const uint64_t kNumItems = 4000000;
+const int kMaxThreadsNum = 32;
+
+memgraph::utils::SkipList<uint64_t> &List() {
+  static auto *list = [] {
+    auto *list = new memgraph::utils::SkipList<uint64_t>();
+    auto acc = list->access();
+    for (uint64_t i = 0; i < kNumItems; ++i) {
+      acc.insert(i);
+    }
+    return list;
+  }();
+  return *list;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// memgraph::utils::SkipList split into chunks
+///////////////////////////////////////////////////////////////////////////////
+
+static void SkipListChunks(benchmark::State &state) {
+  auto &list = List();
+  for (auto _ : state) {
+    auto acc = list.access();
+    auto chunks = acc.chunks(state.range(0));
+    benchmark::DoNotOptimize(chunks);
+  }
+}
+
+BENCHMARK(SkipListChunks)->RangeMultiplier(2)->Range(1, kMaxThreadsNum)->Unit(benchmark::kMicrosecond);
+
+///////////////////////////////////////////////////////////////////////////////
+// memgraph::utils::SkipList scan where each thread iterates over its own chunk
+///////////////////////////////////////////////////////////////////////////////
+
+static void SkipListParallelScan(benchmark::State &state) {
+  auto &list = List();
+  uint64_t items = 0;
+  for (auto _ : state) {
+    auto acc = list.access();
+    auto chunks = acc.chunks(state.range(0));
+    std::vector<uint64_t> sums(chunks.size(), 0);
+    std::vector<std::thread> threads;
+    threads.reserve(chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+      threads.emplace_back([&chunk = chunks[i], &sum = sums[i]] {
+        uint64_t local_sum = 0;
+        for (auto item : chunk) {
+          local_sum += item;
+        }
+        sum = local_sum;
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    benchmark::DoNotOptimize(sums);
+    items += acc.size();
+  }
+  state.SetItemsProcessed(items);
+}
+
+BENCHMARK(SkipListParallelScan)
+    ->RangeMultiplier(2)
+    ->Range(1, kMaxThreadsNum)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,116 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include "storage/v2/storage.hpp"
+#include "utils/file.hpp"
+#include "utils/timer.hpp"
+
+// This benchmark measures the commit throughput of the WAL for each of the
+// commit durabilities, together with the latency of a single fsync on the same
+// device. FSYNC_ON_COMMIT should be compared with `EveryCommitFsync`, which
+// syncs each transaction separately while holding the engine lock.
+
+DEFINE_int32(num_threads, 8, "number of threads");
+DEFINE_int32(num_commits, 2000, "number of commits per thread");
+DEFINE_string(storage_directory, "", "directory of the WAL files, a temporary directory is used if empty");
+
+using CommitDurability = memgraph::storage::Config::Durability::CommitDurability;
+
+struct TestConfiguration {
+  std::string name;
+  CommitDurability commit_durability;
+  uint64_t wal_file_flush_every_n_tx;
+};
+
+const TestConfiguration kTestConfigurations[] = {
+    {"Async", CommitDurability::ASYNC, 100000},
+    {"EveryCommitFsync", CommitDurability::ASYNC, 1},
+    {"FsyncOnCommit", CommitDurability::FSYNC_ON_COMMIT, 100000},
+    {"10msPeriodicFsync", CommitDurability::PERIODIC_FSYNC, 100000}};
+
+// Returns the average latency of an fsync in microseconds.
+double MeasureFsyncLatency(const std::filesystem::path &directory) {
+  constexpr int kNumSyncs = 100;
+  memgraph::utils::OutputFile file;
+  file.Open(directory / "fsync_latency", memgraph::utils::OutputFile::Mode::OVERWRITE_EXISTING);
+  const std::string data(128, 'a');
+  memgraph::utils::Timer timer;
+  for (int i = 0; i < kNumSyncs; ++i) {
+    file.Write(data);
+    file.Sync();
+  }
+  const auto elapsed = timer.Elapsed().count();
+  file.Close();
+  std::filesystem::remove(directory / "fsync_latency");
+  return elapsed * 1e6 / kNumSyncs;
+}
+
+void CommitFunc(memgraph::storage::Storage *storage, int num_commits) {
+  const auto label = storage->NameToLabel("label");
+  for (int i = 0; i < num_commits; ++i) {
+    auto acc = storage->Access();
+    auto vertex = acc.CreateVertex();
+    MG_ASSERT(vertex.AddLabel(label).HasValue());
+    MG_ASSERT(!acc.Commit().HasError());
+  }
+}
+
+int main(int argc, char *argv[]) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  const auto directory = FLAGS_storage_directory.empty()
+                             ? std::filesystem::temp_directory_path() / "MG_benchmark_storage_v2_group_commit"
+                             : std::filesystem::path(FLAGS_storage_directory);
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+
+  std::cout << "Fsync latency: " << MeasureFsyncLatency(directory) << " us" << std::endl;
+
+  for (const auto &config : kTestConfigurations) {
+    const auto storage_directory = directory / config.name;
+    memgraph::utils::Timer timer;
+    {
+      memgraph::storage::Storage storage(
+          {.durability = {
+               .storage_directory = storage_directory,
+               .snapshot_wal_mode = memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL,
+               .snapshot_interval = std::chrono::minutes(20),
+               .wal_file_flush_every_n_tx = config.wal_file_flush_every_n_tx,
+               .commit_durability = config.commit_durability,
+               .wal_fsync_interval = std::chrono::milliseconds(10)}});
+
+      std::vector<std::thread> threads;
+      threads.reserve(FLAGS_num_threads);
+      for (int i = 0; i < FLAGS_num_threads; ++i) {
+        threads.emplace_back(CommitFunc, &storage, FLAGS_num_commits);
+      }
+      for (auto &thread : threads) {
+        thread.join();
+      }
+    }
+    const auto elapsed = timer.Elapsed().count();
+    const auto commits = static_cast<double>(FLAGS_num_threads) * FLAGS_num_commits;
+    std::cout << "Config: " << config.name << ", Time: " << elapsed << ", Commits/s: " << commits / elapsed
+              << std::endl;
+    std::filesystem::remove_all(storage_directory);
+  }
+
+  std::filesystem::remove_all(directory);
+  return 0;
+}
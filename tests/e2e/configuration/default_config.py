@@ -114,13 +114,85 @@ startup_config_dict = {
         "1",
         "The time duration between two replica checks/pings. If < 1, replicas will NOT be checked at all. NOTE: The MAIN instance allocates a new thread for each REPLICA.",
     ),
+    "storage_durability_async_writes": (
+        "false",
+        "false",
+        "Controls whether the snapshot and WAL files are written asynchronously using io_uring. The blocking "
+        "writes are used if io_uring isn't available.",
+    ),
+    "storage_durability_compression": (
+        "NONE",
+        "NONE",
+        "Block compression of the snapshot and WAL files. Allowed values: NONE, ZLIB",
+    ),
+    "storage_gc_adaptive": (
+        "false",
+        "false",
+        "Controls whether the storage garbage collector also runs right away when one of its triggers is reached. "
+        "Its interval is doubled up to --storage-gc-max-cycle-sec while there is nothing to collect.",
+    ),
     "storage_gc_cycle_sec": ("30", "30", "Storage garbage collector interval (in seconds)."),
+    "storage_gc_max_cycle_sec": (
+        "300",
+        "300",
+        "Maximum interval of the adaptive storage garbage collector (in seconds).",
+    ),
+    "storage_gc_thread_count": ("1", "1", "Number of threads used by a single run of the storage garbage collector."),
+    "storage_gc_trigger_delta_mb": (
+        "256",
+        "256",
+        "Size of the deltas (in MiB) added since the last run which triggers the adaptive storage garbage collector. "
+        "Set to 0 to disable the trigger.",
+    ),
+    "storage_gc_trigger_memory_percent": (
+        "80",
+        "80",
+        "Percentage of the memory limit in use after which any new garbage triggers the adaptive storage garbage "
+        "collector. Set to 0 to disable the trigger.",
+    ),
+    "storage_gc_trigger_transactions": (
+        "10000",
+        "10000",
+        "Number of committed transactions added since the last run which triggers the adaptive storage garbage "
+        "collector. Set to 0 to disable the trigger.",
+    ),
+    "storage_index_creation_concurrent": (
+        "false",
+        "false",
+        "Controls whether indices are populated while writes are running. The storage is then locked exclusively only at the start and at the end of the index creation.",
+    ),
+    "storage_index_creation_threads": (
+        "1",
+        "1",
+        "Number of threads used to scan the vertices when an index is created.",
+    ),
+    "storage_items_per_batch": (
+        "1000000",
+        "1000000",
+        "The number of vertices or edges written to a snapshot as a single batch. The batches are recovered in parallel.",
+    ),
     "storage_properties_on_edges": ("false", "true", "Controls whether edges have properties."),
+    "storage_property_columns": (
+        "",
+        "",
+        "Comma-separated list of Label.property pairs whose values are kept in columns, which makes the aggregations of the properties over all vertices with the label much faster.",
+    ),
     "storage_recover_on_startup": (
         "false",
         "false",
         "Controls whether the storage recovers persisted data on startup.",
     ),
+    "storage_recovery_thread_count": (
+        "8",
+        "8",
+        "The number of threads used to recover persisted data and to recreate the indices and constraints on startup.",
+    ),
+    "storage_snapshot_incremental_count": (
+        "0",
+        "0",
+        "Number of incremental snapshots, which hold only the objects modified since the previous snapshot, that are "
+        "created between two full snapshots. Set to 0 to disable incremental snapshots.",
+    ),
     "storage_snapshot_interval_sec": (
         "0",
         "300",
@@ -128,6 +200,16 @@ startup_config_dict = {
     ),
     "storage_snapshot_on_exit": ("false", "false", "Controls whether the storage creates another snapshot on exit."),
     "storage_snapshot_retention_count": ("3", "3", "The number of snapshots that should always be kept."),
+    "storage_snapshot_thread_count": (
+        "8",
+        "8",
+        "The number of threads used to write the vertices and edges of a snapshot.",
+    ),
+    "storage_wal_commit_durability": (
+        "ASYNC",
+        "ASYNC",
+        "Default durability of the committed transactions when the WAL is enabled. ASYNC syncs the WAL after --storage-wal-file-flush-every-n-tx transactions, FSYNC_ON_COMMIT waits for the WAL to be synced (concurrent commits share a single sync) and PERIODIC_FSYNC syncs the WAL every --storage-wal-fsync-interval-ms. Allowed values: ASYNC, FSYNC_ON_COMMIT, PERIODIC_FSYNC",
+    ),
     "storage_wal_enabled": (
         "false",
         "true",
@@ -139,6 +221,11 @@ startup_config_dict = {
         "Issue a 'fsync' call after this amount of transactions are written to the WAL file. Set to 1 for fully synchronous operation.",
     ),
     "storage_wal_file_size_kib": ("20480", "20480", "Minimum file size of each WAL file."),
+    "storage_wal_fsync_interval_ms": (
+        "10",
+        "10",
+        "Interval (in milliseconds) of the WAL 'fsync' calls when the commit durability is PERIODIC_FSYNC.",
+    ),
     "stream_transaction_conflict_retries": (
         "30",
         "30",
@@ -162,6 +249,31 @@ startup_config_dict = {
         "Maximum count of indexed vertices which provoke indexed lookup and then expand to existing, instead of a regular expand. Default is 10, to turn off use -1.",
     ),
     "query_max_plans": ("1000", "1000", "Maximum number of generated plans for a query."),
+    "query_join_order_budget": (
+        "1000",
+        "1000",
+        "Maximum number of partial expansion orders which are considered when ordering the expansions of a pattern from a single starting node. When the budget is exceeded, the expansions are ordered greedily.",
+    ),
+    "query_parallel_workers": (
+        "1",
+        "1",
+        "Maximum number of threads a single query uses to scan the vertices and aggregate the results. Default is 1, which disables parallel aggregation.",
+    ),
+    "query_parallel_scan_min_vertices": (
+        "100000",
+        "100000",
+        "Minimum estimated number of scanned vertices for which an aggregation is run in parallel.",
+    ),
+    "query_order_by_memory_limit_mb": (
+        "0",
+        "0",
+        "Memory (in MiB) which ORDER BY may use to hold the rows of a query before it starts spilling sorted runs of rows to disk. Default is 0, which disables spilling. Rows which hold graph elements are never spilled.",
+    ),
+    "query_order_by_spill_directory": (
+        "",
+        "",
+        "Directory where ORDER BY spills the rows which don't fit into its memory limit. Default is a directory in the system's temporary directory.",
+    ),
     "flag_file": ("", "", "load flags from file"),
     "init_file": (
         "",
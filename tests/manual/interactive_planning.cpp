@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -143,6 +143,7 @@ class InteractiveDbAccessor {
   auto NameToLabel(const std::string &name) { return dba_->NameToLabel(name); }
   auto NameToProperty(const std::string &name) { return dba_->NameToProperty(name); }
   auto NameToEdgeType(const std::string &name) { return dba_->NameToEdgeType(name); }
+  auto PropertyToName(memgraph::storage::PropertyId property) { return dba_->PropertyToName(property); }
 
   int64_t VerticesCount() { return vertices_count_; }
 
@@ -213,6 +214,50 @@ class InteractiveDbAccessor {
     return label_property_index_.at(key);
   }
 
+  // Composite indices are never used by the planner here, so the counts of
+  // their vertices are never needed.
+  std::vector<std::vector<memgraph::storage::PropertyId>> LabelPropertyCompositeIndices(memgraph::storage::LabelId) {
+    return {};
+  }
+
+  int64_t VerticesCount(memgraph::storage::LabelId, const std::vector<memgraph::storage::PropertyId> &,
+                        const std::vector<memgraph::storage::PropertyValue> &) {
+    return 0;
+  }
+
+  int64_t VerticesCount(memgraph::storage::LabelId, const std::vector<memgraph::storage::PropertyId> &,
+                        const std::vector<memgraph::storage::PropertyValue> &,
+                        const std::optional<memgraph::utils::Bound<memgraph::storage::PropertyValue>> &,
+                        const std::optional<memgraph::utils::Bound<memgraph::storage::PropertyValue>> &) {
+    return 0;
+  }
+
+  // Edge counts aren't cached and edge indices are never used by the planner
+  // here, so the questions are limited to vertices.
+  int64_t EdgesCount(memgraph::storage::EdgeTypeId edge_type) { return dba_->EdgesCount(edge_type); }
+
+  int64_t EdgesCount(memgraph::storage::EdgeTypeId edge_type, memgraph::storage::PropertyId property) {
+    return dba_->EdgesCount(edge_type, property);
+  }
+
+  int64_t EdgesCount(memgraph::storage::EdgeTypeId edge_type, memgraph::storage::PropertyId property,
+                     const memgraph::storage::PropertyValue &value) {
+    return dba_->EdgesCount(edge_type, property, value);
+  }
+
+  bool EdgeTypeIndexExists(memgraph::storage::EdgeTypeId) { return false; }
+
+  bool EdgeTypePropertyIndexExists(memgraph::storage::EdgeTypeId, memgraph::storage::PropertyId) { return false; }
+
+  bool PropertyColumnExists(memgraph::storage::LabelId, memgraph::storage::PropertyId) { return false; }
+
+  std::optional<memgraph::storage::LabelPropertyStats> GetLabelPropertyStats(memgraph::storage::LabelId label,
+                                                                             memgraph::storage::PropertyId property) {
+    return dba_->GetLabelPropertyStats(label, property);
+  }
+
+  std::optional<double> GetAverageDegree() { return dba_->GetAverageDegree(); }
+
   // Save the cached vertex counts to a stream.
   void Save(std::ostream &out) {
     out << "vertex-count " << vertices_count_ << std::endl;
@@ -1748,9 +1748,55 @@ TEST_P(CypherMainVisitorTest, DropIndexWithoutProperties) {
   EXPECT_THROW(ast_generator.ParseQuery("dRoP InDeX oN :mirko()"), SyntaxException);
 }
 
+TEST_P(CypherMainVisitorTest, CreateIndexWithMultipleProperties) {
+  auto &ast_generator = *GetParam();
+  auto *index_query = dynamic_cast<IndexQuery *>(ast_generator.ParseQuery("Create InDeX oN :mirko(slavko, pero)"));
+  ASSERT_TRUE(index_query);
+  EXPECT_EQ(index_query->action_, IndexQuery::Action::CREATE);
+  EXPECT_EQ(index_query->label_, ast_generator.Label("mirko"));
+  std::vector<PropertyIx> expected_properties{ast_generator.Prop("slavko"), ast_generator.Prop("pero")};
+  EXPECT_EQ(index_query->properties_, expected_properties);
+}
+
 TEST_P(CypherMainVisitorTest, DropIndexWithMultipleProperties) {
   auto &ast_generator = *GetParam();
-  EXPECT_THROW(ast_generator.ParseQuery("dRoP InDeX oN :mirko(slavko, pero)"), SyntaxException);
+  auto *index_query = dynamic_cast<IndexQuery *>(ast_generator.ParseQuery("dRoP InDeX oN :mirko(slavko, pero)"));
+  ASSERT_TRUE(index_query);
+  EXPECT_EQ(index_query->action_, IndexQuery::Action::DROP);
+  EXPECT_EQ(index_query->label_, ast_generator.Label("mirko"));
+  std::vector<PropertyIx> expected_properties{ast_generator.Prop("slavko"), ast_generator.Prop("pero")};
+  EXPECT_EQ(index_query->properties_, expected_properties);
+}
+
+TEST_P(CypherMainVisitorTest, CreateEdgeIndex) {
+  auto &ast_generator = *GetParam();
+  {
+    auto *index_query = dynamic_cast<EdgeIndexQuery *>(ast_generator.ParseQuery("Create EdGe InDeX oN :mirko"));
+    ASSERT_TRUE(index_query);
+    EXPECT_EQ(index_query->action_, EdgeIndexQuery::Action::CREATE);
+    EXPECT_EQ(index_query->edge_type_, ast_generator.EdgeType("mirko"));
+    EXPECT_TRUE(index_query->properties_.empty());
+  }
+  {
+    auto *index_query =
+        dynamic_cast<EdgeIndexQuery *>(ast_generator.ParseQuery("Create EdGe InDeX oN :mirko(slavko)"));
+    ASSERT_TRUE(index_query);
+    EXPECT_EQ(index_query->action_, EdgeIndexQuery::Action::CREATE);
+    EXPECT_EQ(index_query->edge_type_, ast_generator.EdgeType("mirko"));
+    std::vector<PropertyIx> expected_properties{ast_generator.Prop("slavko")};
+    EXPECT_EQ(index_query->properties_, expected_properties);
+  }
+}
+
+TEST_P(CypherMainVisitorTest, DropEdgeIndex) {
+  auto &ast_generator = *GetParam();
+  auto *index_query = dynamic_cast<EdgeIndexQuery *>(ast_generator.ParseQuery("dRoP EdGe InDeX oN :mirko(slavko)"));
+  ASSERT_TRUE(index_query);
+  EXPECT_EQ(index_query->action_, EdgeIndexQuery::Action::DROP);
+  EXPECT_EQ(index_query->edge_type_, ast_generator.EdgeType("mirko"));
+  std::vector<PropertyIx> expected_properties{ast_generator.Prop("slavko")};
+  EXPECT_EQ(index_query->properties_, expected_properties);
+  EXPECT_THROW(ast_generator.ParseQuery("dRoP EdGe InDeX oN :mirko(slavko, pero)"), SyntaxException);
 }
 
 TEST_P(CypherMainVisitorTest, ReturnAll) {
@@ -4222,6 +4268,23 @@ TEST_P(CypherMainVisitorTest, ConfigQuery) {
   ASSERT_NO_THROW(ast_generator.ParseQuery("SHOW CONFIG"));
 }
 
+TEST_P(CypherMainVisitorTest, AnalyzeGraphQuery) {
+  auto &ast_generator = *GetParam();
+
+  TestInvalidQuery("ANALYZE", ast_generator);
+  TestInvalidQuery("ANALYZE GRAPHS", ast_generator);
+  TestInvalidQuery("ANALYZE GRAPH DELETE", ast_generator);
+  TestInvalidQuery("ANALYZE GRAPH STATISTICS", ast_generator);
+
+  auto *analyze_query = dynamic_cast<AnalyzeGraphQuery *>(ast_generator.ParseQuery("ANALYZE GRAPH"));
+  ASSERT_TRUE(analyze_query);
+  EXPECT_EQ(analyze_query->action_, AnalyzeGraphQuery::Action::ANALYZE);
+
+  auto *delete_query = dynamic_cast<AnalyzeGraphQuery *>(ast_generator.ParseQuery("ANALYZE GRAPH DELETE STATISTICS"));
+  ASSERT_TRUE(delete_query);
+  EXPECT_EQ(delete_query->action_, AnalyzeGraphQuery::Action::DELETE_STATISTICS);
+}
+
 TEST_P(CypherMainVisitorTest, ForeachThrow) {
   auto &ast_generator = *GetParam();
   EXPECT_THROW(ast_generator.ParseQuery("FOREACH(i IN [1, 2] | UNWIND [1,2,3] AS j CREATE (n))"), SyntaxException);
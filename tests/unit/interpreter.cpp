@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -733,7 +733,7 @@ TEST_F(InterpreterTest, ExplainQueryWithParams) {
       Interpret("EXPLAIN MATCH (n) WHERE n.id = $id RETURN *;", {{"id", memgraph::storage::PropertyValue(42)}});
   ASSERT_EQ(stream.GetHeader().size(), 1U);
   EXPECT_EQ(stream.GetHeader().front(), "QUERY PLAN");
-  std::vector<std::string> expected_rows{" * Produce {n}", " * Filter", " * ScanAll (n)", " * Once"};
+  std::vector<std::string> expected_rows{" * Produce {n}", " * ScanAll (n) filter {id}", " * Once"};
   ASSERT_EQ(stream.GetResults().size(), expected_rows.size());
   auto expected_it = expected_rows.begin();
   for (const auto &row : stream.GetResults()) {
@@ -828,7 +828,7 @@ TEST_F(InterpreterTest, ProfileQueryWithParams) {
       Interpret("PROFILE MATCH (n) WHERE n.id = $id RETURN *;", {{"id", memgraph::storage::PropertyValue(42)}});
   std::vector<std::string> expected_header{"OPERATOR", "ACTUAL HITS", "RELATIVE TIME", "ABSOLUTE TIME"};
   EXPECT_EQ(stream.GetHeader(), expected_header);
-  std::vector<std::string> expected_rows{"* Produce", "* Filter", "* ScanAll", "* Once"};
+  std::vector<std::string> expected_rows{"* Produce", "* ScanAll", "* Once"};
   ASSERT_EQ(stream.GetResults().size(), expected_rows.size());
   auto expected_it = expected_rows.begin();
   for (const auto &row : stream.GetResults()) {
@@ -845,6 +845,25 @@ TEST_F(InterpreterTest, ProfileQueryWithParams) {
   EXPECT_EQ(interpreter_context.ast_cache.size(), 2U);
 }
 
+TEST_F(InterpreterTest, PropertyFiltersInScan) {
+  Interpret("CREATE ({x: 1}), ({x: 2.0}), ({x: 'a'}), ({x: 'b'}), ({x: true}), ({x: [1]}), ({y: 1})");
+  auto count = [this](const std::string &query, const std::map<std::string, memgraph::storage::PropertyValue> &params) {
+    auto stream = Interpret(query, params);
+    EXPECT_EQ(stream.GetResults().size(), 1U);
+    return stream.GetResults()[0][0].ValueInt();
+  };
+  EXPECT_EQ(count("MATCH (n) WHERE n.x = 2 RETURN count(n)", {}), 1);
+  EXPECT_EQ(count("MATCH (n) WHERE n.x = $x RETURN count(n)", {{"x", memgraph::storage::PropertyValue(1)}}), 1);
+  EXPECT_EQ(count("MATCH (n) WHERE n.x = [1] RETURN count(n)", {}), 1);
+  EXPECT_EQ(count("MATCH (n) WHERE n.x IS NULL RETURN count(n)", {}), 1);
+  EXPECT_EQ(count("MATCH (n) WHERE n.x IS NOT NULL RETURN count(n)", {}), 6);
+  EXPECT_EQ(count("MATCH (n) WHERE n.y = 1 AND n.x IS NULL RETURN count(n)", {}), 1);
+  // Comparing values which can't be ordered still raises an error.
+  ASSERT_THROW(Interpret("MATCH (n) WHERE n.x > 1 RETURN count(n)", {}), memgraph::query::QueryRuntimeException);
+  Interpret("CREATE (:S {x: 'a'}), (:S {x: 'ab'}), (:S {x: 'b'})");
+  EXPECT_EQ(count("MATCH (n:S) WHERE n.x >= 'a' AND n.x < 'b' RETURN count(n)", {}), 2);
+}
+
 TEST_F(InterpreterTest, ProfileQueryWithLiterals) {
   const auto &interpreter_context = default_interpreter.interpreter_context;
 
@@ -73,6 +73,33 @@ class QueryCostEstimator : public ::testing::Test {
     dba->AdvanceCommand();
   }
 
+  /** Commits the current transaction, computes the graph statistics and
+   * starts a new transaction. */
+  void Analyze() {
+    dba.reset();
+    ASSERT_FALSE(storage_dba->Commit().HasError());
+    storage_dba.reset();
+    memgraph::storage::GraphStatistics statistics;
+    {
+      auto acc = db.Access();
+      statistics = acc.ComputeGraphStatistics();
+    }
+    ASSERT_FALSE(db.SetGraphStatistics(std::move(statistics)).HasError());
+    storage_dba.emplace(db.Access());
+    dba.emplace(&*storage_dba);
+  }
+
+  /** Adds the given number of labeled vertices whose property values are
+   * `i % distinct_count`. */
+  void AddSkewedVertices(int vertex_count, int distinct_count) {
+    for (int i = 0; i < vertex_count; i++) {
+      auto vertex = dba->InsertVertex();
+      ASSERT_TRUE(vertex.AddLabel(label).HasValue());
+      ASSERT_TRUE(vertex.SetProperty(property, memgraph::storage::PropertyValue(i % distinct_count)).HasValue());
+    }
+    dba->AdvanceCommand();
+  }
+
   auto Cost() {
     CostEstimator<memgraph::query::DbAccessor> cost_estimator(&*dba, parameters_);
     last_op_->Accept(cost_estimator);
@@ -138,6 +165,15 @@ TEST_F(QueryCostEstimator, ScanAllByLabelPropertyValueConstExpr) {
   }
 }
 
+TEST_F(QueryCostEstimator, ScanAllByLabelPropertyValueStatistics) {
+  AddSkewedVertices(30, 5);
+  Analyze();
+  MakeOp<ScanAllByLabelPropertyValue>(nullptr, NextSymbol(), label, property, "property",
+                                      storage_.Create<UnaryPlusOperator>(Literal(12)));
+  // 30 vertices share 5 distinct values
+  EXPECT_COST(6 * CostParam::MakeScanAllByLabelPropertyValue);
+}
+
 TEST_F(QueryCostEstimator, ScanAllByLabelPropertyRangeUpperConstant) {
   AddVertices(100, 30, 20);
   for (auto const_val : {Literal(12), Parameter(12)}) {
@@ -168,12 +204,69 @@ TEST_F(QueryCostEstimator, ScanAllByLabelPropertyRangeConstExpr) {
   }
 }
 
+TEST_F(QueryCostEstimator, ScanAllByLabelPropertyRangeStatistics) {
+  AddSkewedVertices(30, 5);
+  Analyze();
+  MakeOp<ScanAllByLabelPropertyRange>(nullptr, NextSymbol(), label, property, "property", nullopt,
+                                      InclusiveBound(Literal(1)));
+  // the histogram estimates the values 0 and 1 as 2 out of 5 values
+  EXPECT_COST(12 * CostParam::MakeScanAllByLabelPropertyRange);
+}
+
 TEST_F(QueryCostEstimator, Expand) {
   MakeOp<Expand>(last_op_, NextSymbol(), NextSymbol(), NextSymbol(), EdgeAtom::Direction::IN,
                  std::vector<memgraph::storage::EdgeTypeId>{}, false, memgraph::storage::View::OLD);
   EXPECT_COST(CardParam::kExpand * CostParam::kExpand);
 }
 
+TEST_F(QueryCostEstimator, ExpandWithEdgeTypes) {
+  auto edge_type = db.NameToEdgeType("edge_type");
+  auto other_edge_type = db.NameToEdgeType("other_edge_type");
+  // 10 vertices with 5 edges of `edge_type` and no edges of `other_edge_type`.
+  for (int i = 0; i < 5; ++i) {
+    auto from = dba->InsertVertex();
+    auto to = dba->InsertVertex();
+    ASSERT_TRUE(dba->InsertEdge(&from, &to, edge_type).HasValue());
+  }
+  dba->AdvanceCommand();
+
+  MakeOp<Expand>(last_op_, NextSymbol(), NextSymbol(), NextSymbol(), EdgeAtom::Direction::OUT,
+                 std::vector<memgraph::storage::EdgeTypeId>{edge_type}, false, memgraph::storage::View::OLD);
+  EXPECT_COST(0.5 * CostParam::kExpand);
+
+  MakeOp<Expand>(last_op_, NextSymbol(), NextSymbol(), NextSymbol(), EdgeAtom::Direction::BOTH,
+                 std::vector<memgraph::storage::EdgeTypeId>{edge_type}, false, memgraph::storage::View::OLD);
+  // The previous Expand is the input of this one.
+  EXPECT_COST(0.5 * CostParam::kExpand + 0.5 * 1.0 * CostParam::kExpand);
+
+  // A repeated edge type, as in `[:edge_type|edge_type]`, is counted once.
+  last_op_ = std::make_shared<Once>();
+  MakeOp<Expand>(last_op_, NextSymbol(), NextSymbol(), NextSymbol(), EdgeAtom::Direction::OUT,
+                 std::vector<memgraph::storage::EdgeTypeId>{edge_type, edge_type}, false,
+                 memgraph::storage::View::OLD);
+  EXPECT_COST(0.5 * CostParam::kExpand);
+
+  last_op_ = std::make_shared<Once>();
+  MakeOp<Expand>(last_op_, NextSymbol(), NextSymbol(), NextSymbol(), EdgeAtom::Direction::OUT,
+                 std::vector<memgraph::storage::EdgeTypeId>{other_edge_type}, false, memgraph::storage::View::OLD);
+  EXPECT_COST(0);
+}
+
+TEST_F(QueryCostEstimator, ExpandStatistics) {
+  auto edge_type = db.NameToEdgeType("edge_type");
+  // 10 vertices with 5 edges.
+  for (int i = 0; i < 5; ++i) {
+    auto from = dba->InsertVertex();
+    auto to = dba->InsertVertex();
+    ASSERT_TRUE(dba->InsertEdge(&from, &to, edge_type).HasValue());
+  }
+  Analyze();
+
+  MakeOp<Expand>(last_op_, NextSymbol(), NextSymbol(), NextSymbol(), EdgeAtom::Direction::IN,
+                 std::vector<memgraph::storage::EdgeTypeId>{}, false, memgraph::storage::View::OLD);
+  EXPECT_COST(0.5 * CostParam::kExpand);
+}
+
 TEST_F(QueryCostEstimator, ExpandVariable) {
   MakeOp<ExpandVariable>(last_op_, NextSymbol(), NextSymbol(), NextSymbol(), EdgeAtom::Type::DEPTH_FIRST,
                          EdgeAtom::Direction::IN, std::vector<memgraph::storage::EdgeTypeId>{}, false, nullptr, nullptr,
@@ -548,6 +548,31 @@ TEST(DumpTest, IndicesKeys) {
   }
 }
 
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(DumpTest, CompositeIndicesKeys) {
+  memgraph::storage::Storage db;
+  {
+    auto dba = db.Access();
+    CreateVertex(&dba, {"Label1"}, {{"p", memgraph::storage::PropertyValue(1)}}, false);
+    ASSERT_FALSE(dba.Commit().HasError());
+  }
+  std::vector<memgraph::storage::PropertyId> properties{db.NameToProperty("b"), db.NameToProperty("a")};
+  ASSERT_FALSE(db.CreateIndex(db.NameToLabel("Label1"), properties).HasError());
+
+  {
+    ResultStreamFaker stream(&db);
+    memgraph::query::AnyStream query_stream(&stream, memgraph::utils::NewDeleteResource());
+    {
+      auto acc = db.Access();
+      memgraph::query::DbAccessor dba(&acc);
+      memgraph::query::DumpDatabaseToCypherQueries(&dba, &query_stream);
+    }
+    VerifyQueries(stream.GetResults(), "CREATE INDEX ON :`Label1`(`b`, `a`);", kCreateInternalIndex,
+                  "CREATE (:__mg_vertex__:`Label1` {__mg_id__: 0, `p`: 1});", kDropInternalIndex,
+                  kRemoveInternalLabelProperty);
+  }
+}
+
 // NOLINTNEXTLINE(hicpp-special-member-functions)
 TEST(DumpTest, ExistenceConstraints) {
   memgraph::storage::Storage db;
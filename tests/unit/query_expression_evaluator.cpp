@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -11,7 +11,9 @@
 
 #include <chrono>
 #include <cmath>
+#include <functional>
 #include <iterator>
+#include <map>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -23,6 +25,7 @@
 #include "query/frontend/ast/ast.hpp"
 #include "query/frontend/opencypher/parser.hpp"
 #include "query/interpret/awesome_memgraph_functions.hpp"
+#include "query/interpret/compiled_expression.hpp"
 #include "query/interpret/eval.hpp"
 #include "query/interpret/frame.hpp"
 #include "query/path.hpp"
@@ -1161,6 +1164,159 @@ TEST_F(ExpressionEvaluatorPropertyLookup, MapLiteral) {
   EXPECT_TRUE(Value(prop_height).IsNull());
 }
 
+class CompiledExpressionTest : public ExpressionEvaluatorTest {
+ protected:
+  template <class TExpression>
+  TypedValue EvalCompiled(TExpression *expr, size_t fallback_count = 0) {
+    ctx.properties = NamesToProperties(storage.properties_, &dba);
+    ctx.labels = NamesToLabels(storage.labels_, &dba);
+    CompiledExpression compiled(expr, symbol_table);
+    EXPECT_EQ(compiled.FallbackCount(), fallback_count);
+    auto value = compiled.Evaluate(&eval);
+    EXPECT_EQ(value.GetMemoryResource(), &mem) << "CompiledExpression must use the MemoryResource from "
+                                                  "EvaluationContext for allocations!";
+    return value;
+  }
+
+  // The compiled expression must evaluate to the same value as the evaluator.
+  void ExpectSameValue(Expression *expr, size_t fallback_count = 0) {
+    auto expected = Eval(expr);
+    auto value = EvalCompiled(expr, fallback_count);
+    EXPECT_TRUE(TypedValue::BoolEqual{}(value, expected)) << value.type() << " != " << expected.type();
+  }
+
+  PrimitiveLiteral *Null() { return storage.Create<PrimitiveLiteral>(memgraph::storage::PropertyValue()); }
+  PrimitiveLiteral *Literal(bool value) { return storage.Create<PrimitiveLiteral>(value); }
+};
+
+TEST_F(CompiledExpressionTest, Arithmetic) {
+  auto *x = CreateIdentifierWithValue("x", TypedValue(7));
+  auto *y = CreateIdentifierWithValue("y", TypedValue(2.5));
+  auto *two = storage.Create<PrimitiveLiteral>(2);
+  ExpectSameValue(storage.Create<AdditionOperator>(x, y));
+  ExpectSameValue(storage.Create<SubtractionOperator>(x, two));
+  ExpectSameValue(storage.Create<MultiplicationOperator>(storage.Create<AdditionOperator>(x, two), y));
+  ExpectSameValue(storage.Create<DivisionOperator>(x, two));
+  ExpectSameValue(storage.Create<ModOperator>(x, two));
+  ExpectSameValue(storage.Create<AdditionOperator>(x, Null()));
+  auto *op = storage.Create<AdditionOperator>(x, Literal(true));
+  EXPECT_THROW(Eval(op), QueryRuntimeException);
+  EXPECT_THROW(EvalCompiled(op), QueryRuntimeException);
+}
+
+TEST_F(CompiledExpressionTest, Comparisons) {
+  auto *x = CreateIdentifierWithValue("x", TypedValue(7));
+  auto *s = CreateIdentifierWithValue("s", TypedValue("a"));
+  for (auto *literal : {storage.Create<PrimitiveLiteral>(7), storage.Create<PrimitiveLiteral>(8.5), Null()}) {
+    ExpectSameValue(storage.Create<EqualOperator>(x, literal));
+    ExpectSameValue(storage.Create<NotEqualOperator>(x, literal));
+    ExpectSameValue(storage.Create<LessOperator>(x, literal));
+    ExpectSameValue(storage.Create<GreaterOperator>(x, literal));
+    ExpectSameValue(storage.Create<LessEqualOperator>(x, literal));
+    ExpectSameValue(storage.Create<GreaterEqualOperator>(x, literal));
+  }
+  ExpectSameValue(storage.Create<EqualOperator>(x, s));
+  auto *op = storage.Create<LessOperator>(x, s);
+  EXPECT_THROW(Eval(op), QueryRuntimeException);
+  EXPECT_THROW(EvalCompiled(op), QueryRuntimeException);
+}
+
+TEST_F(CompiledExpressionTest, BooleanOperators) {
+  std::vector<std::function<Expression *()>> operands{[this] { return Literal(true); },
+                                                      [this] { return Literal(false); }, [this] { return Null(); }};
+  for (const auto &lhs : operands) {
+    for (const auto &rhs : operands) {
+      // The operands are wrapped in `IS NULL` and `NOT`, so that they are
+      // compiled as predicates.
+      auto predicate = [this](Expression *expr) {
+        return storage.Create<NotOperator>(storage.Create<NotOperator>(expr));
+      };
+      ExpectSameValue(storage.Create<AndOperator>(predicate(lhs()), predicate(rhs())));
+      ExpectSameValue(storage.Create<OrOperator>(predicate(lhs()), predicate(rhs())));
+      ExpectSameValue(storage.Create<XorOperator>(predicate(lhs()), predicate(rhs())));
+      ExpectSameValue(storage.Create<AndOperator>(storage.Create<IsNullOperator>(lhs()), predicate(rhs())));
+    }
+  }
+}
+
+TEST_F(CompiledExpressionTest, AndOperatorShortCircuit) {
+  auto *x = CreateIdentifierWithValue("x", TypedValue(1));
+  auto *y = CreateIdentifierWithValue("y", TypedValue("a"));
+  // The right side would throw if it was evaluated.
+  auto *op = storage.Create<AndOperator>(storage.Create<EqualOperator>(x, storage.Create<PrimitiveLiteral>(2)),
+                                         storage.Create<LessOperator>(x, y));
+  ExpectSameValue(op);
+  // Null doesn't short circuit.
+  op = storage.Create<AndOperator>(storage.Create<EqualOperator>(x, Null()), storage.Create<LessOperator>(x, y));
+  EXPECT_THROW(Eval(op), QueryRuntimeException);
+  EXPECT_THROW(EvalCompiled(op), QueryRuntimeException);
+  // The operands which aren't predicates are evaluated by the evaluator.
+  op = storage.Create<AndOperator>(Null(), storage.Create<PrimitiveLiteral>(5));
+  EXPECT_THROW(Eval(op), QueryRuntimeException);
+  EXPECT_THROW(EvalCompiled(op, 1), QueryRuntimeException);
+}
+
+TEST_F(CompiledExpressionTest, PropertyLookup) {
+  auto prop = dba.NameToProperty("prop");
+  auto v1 = dba.InsertVertex();
+  auto e11 = dba.InsertEdge(&v1, &v1, dba.NameToEdgeType("edge_type"));
+  ASSERT_TRUE(e11.HasValue());
+  ASSERT_TRUE(v1.SetProperty(prop, memgraph::storage::PropertyValue(42)).HasValue());
+  ASSERT_TRUE(e11->SetProperty(prop, memgraph::storage::PropertyValue("43")).HasValue());
+  dba.AdvanceCommand();
+
+  auto lookup = [this](Identifier *identifier, const std::string &name) {
+    return storage.Create<PropertyLookup>(identifier, storage.GetPropertyIx(name));
+  };
+  auto *vertex = CreateIdentifierWithValue("v1", TypedValue(v1));
+  auto *edge = CreateIdentifierWithValue("e11", TypedValue(*e11));
+  auto *null = CreateIdentifierWithValue("null", TypedValue());
+  auto *map = CreateIdentifierWithValue("map", TypedValue(std::map<std::string, TypedValue>{{"prop", TypedValue(1)}}));
+  ExpectSameValue(lookup(vertex, "prop"));
+  ExpectSameValue(lookup(vertex, "other"));
+  ExpectSameValue(lookup(edge, "prop"));
+  ExpectSameValue(lookup(null, "prop"));
+  ExpectSameValue(lookup(map, "prop"));
+  ExpectSameValue(storage.Create<GreaterOperator>(lookup(vertex, "prop"), storage.Create<PrimitiveLiteral>(40)));
+  ExpectSameValue(storage.Create<IsNullOperator>(lookup(edge, "other")));
+}
+
+TEST_F(CompiledExpressionTest, Fallback) {
+  auto *list_literal = storage.Create<ListLiteral>(
+      std::vector<Expression *>{storage.Create<PrimitiveLiteral>(1), storage.Create<PrimitiveLiteral>(2)});
+  auto *x = CreateIdentifierWithValue("x", TypedValue(2));
+  // Only the `IN` and the subscript operators aren't compiled.
+  auto *in_list = storage.Create<InListOperator>(x, list_literal);
+  auto *op = storage.Create<AndOperator>(storage.Create<IsNullOperator>(in_list),
+                                         storage.Create<LessOperator>(x, storage.Create<PrimitiveLiteral>(3)));
+  ExpectSameValue(op, 1);
+  auto *subscript = storage.Create<SubscriptOperator>(list_literal, storage.Create<PrimitiveLiteral>(0));
+  ExpectSameValue(storage.Create<AdditionOperator>(x, subscript), 1);
+}
+
+TEST_F(CompiledExpressionTest, NamedExpression) {
+  auto *x = CreateIdentifierWithValue("x", TypedValue(2));
+  auto symbol = symbol_table.CreateSymbol("named", true);
+  auto *named = storage.Create<NamedExpression>("named", storage.Create<AdditionOperator>(x, x))->MapTo(symbol);
+  auto value = EvalCompiled(named);
+  EXPECT_EQ(value.ValueInt(), 4);
+  EXPECT_EQ(frame[symbol].ValueInt(), 4);
+}
+
+TEST_F(CompiledExpressionTest, EvaluateFilter) {
+  auto *x = CreateIdentifierWithValue("x", TypedValue(2));
+  auto filter = [this](Expression *expr) {
+    CompiledExpression compiled(expr, symbol_table);
+    return compiled.EvaluateFilter(&eval);
+  };
+  EXPECT_TRUE(filter(storage.Create<EqualOperator>(x, storage.Create<PrimitiveLiteral>(2))));
+  EXPECT_FALSE(filter(storage.Create<EqualOperator>(x, storage.Create<PrimitiveLiteral>(3))));
+  EXPECT_FALSE(filter(storage.Create<EqualOperator>(x, Null())));
+  EXPECT_FALSE(filter(Null()));
+  EXPECT_TRUE(filter(Literal(true)));
+  EXPECT_THROW(filter(x), QueryRuntimeException);
+}
+
 class FunctionTest : public ExpressionEvaluatorTest {
  protected:
   std::vector<Expression *> ExpressionsFromTypedValues(const std::vector<TypedValue> &tvs) {
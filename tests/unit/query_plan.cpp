@@ -424,6 +424,96 @@ TYPED_TEST(TestPlanner, MatchReturnSum) {
   CheckPlan(planner.plan(), symbol_table, ExpectScanAll(), aggr, ExpectProduce());
 }
 
+TYPED_TEST(TestPlanner, MatchReturnSumInParallel) {
+  // Test MATCH (n) RETURN SUM(n.prop1) AS sum, n.prop2 AS group
+  FakeDbAccessor dba;
+  auto prop1 = dba.Property("prop1");
+  auto prop2 = dba.Property("prop2");
+  AstStorage storage;
+  auto sum = SUM(PROPERTY_LOOKUP("n", prop1), false);
+  auto n_prop2 = PROPERTY_LOOKUP("n", prop2);
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n"))), RETURN(sum, AS("sum"), n_prop2, AS("group"))));
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  const auto old_parallel_workers = FLAGS_query_parallel_workers;
+  FLAGS_query_parallel_workers = 4;
+  {
+    // Too few vertices to aggregate in parallel.
+    dba.SetVerticesCount(FLAGS_query_parallel_scan_min_vertices - 1);
+    auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+    EXPECT_EQ(planner.plan().input()->GetTypeInfo(), Aggregate::kType);
+  }
+  {
+    dba.SetVerticesCount(FLAGS_query_parallel_scan_min_vertices);
+    auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+    auto *parallel_aggregate = dynamic_cast<ParallelAggregate *>(planner.plan().input().get());
+    ASSERT_TRUE(parallel_aggregate);
+    EXPECT_EQ(parallel_aggregate->num_workers_, 4);
+    CheckPlan(planner.plan(), symbol_table, ExpectScanAll(), ExpectAggregate({sum}, {n_prop2}), ExpectProduce());
+  }
+  FLAGS_query_parallel_workers = old_parallel_workers;
+}
+
+TYPED_TEST(TestPlanner, MatchReturnSumFromColumns) {
+  // Test MATCH (n :label) RETURN SUM(n.prop) AS sum, COUNT(n.prop) AS count
+  FakeDbAccessor dba;
+  auto label = dba.Label("label");
+  auto prop = dba.Property("prop");
+  dba.SetIndexCount(label, 0);
+  AstStorage storage;
+  auto sum = SUM(PROPERTY_LOOKUP("n", prop), false);
+  auto count = COUNT(PROPERTY_LOOKUP("n", prop), false);
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n", "label"))), RETURN(sum, AS("sum"), count, AS("count"))));
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  {
+    // The property doesn't have a column.
+    auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+    EXPECT_EQ(planner.plan().input()->GetTypeInfo(), Aggregate::kType);
+  }
+  dba.AddPropertyColumn(label, prop);
+  auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+  auto *columnar_aggregate = dynamic_cast<ColumnarAggregate *>(planner.plan().input().get());
+  ASSERT_TRUE(columnar_aggregate);
+  EXPECT_EQ(columnar_aggregate->label_, label);
+  EXPECT_EQ(columnar_aggregate->properties_, std::vector<memgraph::storage::PropertyId>({prop, prop}));
+  CheckPlan(planner.plan(), symbol_table, ExpectScanAllByLabel(), ExpectAggregate({sum, count}, {}), ExpectProduce());
+}
+
+TYPED_TEST(TestPlanner, MatchReturnGroupedSumNotFromColumns) {
+  // Test MATCH (n :label) RETURN SUM(n.prop) AS sum, n.group AS group
+  FakeDbAccessor dba;
+  auto label = dba.Label("label");
+  auto prop = dba.Property("prop");
+  auto group = dba.Property("group");
+  dba.SetIndexCount(label, 0);
+  dba.AddPropertyColumn(label, prop);
+  dba.AddPropertyColumn(label, group);
+  AstStorage storage;
+  auto sum = SUM(PROPERTY_LOOKUP("n", prop), false);
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n", "label"))),
+                                   RETURN(sum, AS("sum"), PROPERTY_LOOKUP("n", group), AS("group"))));
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+  // The columns are only summarized as a whole.
+  EXPECT_EQ(planner.plan().input()->GetTypeInfo(), Aggregate::kType);
+}
+
+TYPED_TEST(TestPlanner, MatchReturnCollectNotInParallel) {
+  // Test MATCH (n) RETURN COLLECT(n.prop) AS values
+  FakeDbAccessor dba;
+  auto prop = dba.Property("prop");
+  AstStorage storage;
+  auto collect = COLLECT_LIST(PROPERTY_LOOKUP("n", prop), false);
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n"))), RETURN(collect, AS("values"))));
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  const auto old_parallel_workers = FLAGS_query_parallel_workers;
+  FLAGS_query_parallel_workers = 4;
+  dba.SetVerticesCount(FLAGS_query_parallel_scan_min_vertices);
+  auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+  // Partial results of COLLECT can't be merged.
+  EXPECT_EQ(planner.plan().input()->GetTypeInfo(), Aggregate::kType);
+  FLAGS_query_parallel_workers = old_parallel_workers;
+}
+
 TYPED_TEST(TestPlanner, CreateWithSum) {
   // Test CREATE (n) WITH SUM(n.prop) AS sum
   FakeDbAccessor dba;
@@ -575,6 +665,48 @@ TYPED_TEST(TestPlanner, MatchReturnOrderBy) {
   auto symbol_table = memgraph::query::MakeSymbolTable(query);
   auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
   CheckPlan(planner.plan(), symbol_table, ExpectScanAll(), ExpectProduce(), ExpectOrderBy());
+  // Without LIMIT all of the rows are sorted.
+  EXPECT_EQ(planner.plan().GetTypeInfo(), OrderBy::kType);
+}
+
+TYPED_TEST(TestPlanner, MatchReturnOrderByLimit) {
+  // Test MATCH (n) RETURN n AS m ORDER BY n.prop LIMIT 3
+  FakeDbAccessor dba;
+  auto prop = dba.Property("prop");
+  AstStorage storage;
+  auto *as_m = NEXPR("m", IDENT("n"));
+  auto *limit = LITERAL(3);
+  auto *query =
+      QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n"))), RETURN(as_m, ORDER_BY(PROPERTY_LOOKUP("n", prop)), LIMIT(limit))));
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+  CheckPlan(planner.plan(), symbol_table, ExpectScanAll(), ExpectProduce(), ExpectTopK(), ExpectLimit());
+  auto *top_k = dynamic_cast<TopK *>(planner.plan().input().get());
+  ASSERT_TRUE(top_k);
+  EXPECT_EQ(top_k->limit_, limit);
+  EXPECT_EQ(top_k->skip_, nullptr);
+}
+
+TYPED_TEST(TestPlanner, MatchWithOrderBySkipLimitReturn) {
+  // Test MATCH (n) WITH n ORDER BY n.prop SKIP 2 LIMIT 3 RETURN n
+  FakeDbAccessor dba;
+  auto prop = dba.Property("prop");
+  AstStorage storage;
+  auto *skip = LITERAL(2);
+  auto *limit = LITERAL(3);
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n"))),
+                                   WITH("n", ORDER_BY(PROPERTY_LOOKUP("n", prop)), SKIP(skip), LIMIT(limit)),
+                                   RETURN("n")));
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+  // Skip and Limit stay above TopK, which only keeps the first SKIP + LIMIT
+  // rows.
+  CheckPlan(planner.plan(), symbol_table, ExpectScanAll(), ExpectProduce(), ExpectTopK(), ExpectSkip(), ExpectLimit(),
+            ExpectProduce());
+  auto *top_k = dynamic_cast<TopK *>(planner.plan().input()->input()->input().get());
+  ASSERT_TRUE(top_k);
+  EXPECT_EQ(top_k->limit_, limit);
+  EXPECT_EQ(top_k->skip_, skip);
 }
 
 TYPED_TEST(TestPlanner, CreateWithOrderByWhere) {
@@ -1121,6 +1253,44 @@ TYPED_TEST(TestPlanner, MultiPropertyIndexScan) {
             ExpectScanAllByLabelPropertyValue(label2, prop2, lit_2), ExpectProduce());
 }
 
+TYPED_TEST(TestPlanner, WhereIndexedLabelPropertyComposite) {
+  // Test MATCH (n :label) WHERE n.a = 1 AND n.b = 2 AND n.c > 3 RETURN n
+  FakeDbAccessor dba;
+  auto label = dba.Label("label");
+  auto prop_a = PROPERTY_PAIR("a");
+  auto prop_b = dba.Property("b");
+  auto prop_c = dba.Property("c");
+  // The single property index has fewer vertices, but the composite index
+  // covers more filters.
+  dba.SetIndexCount(label, prop_a.second, 1);
+  dba.SetIndexCount(label, std::vector{prop_a.second, prop_b}, 10);
+  dba.SetIndexCount(label, std::vector{prop_a.second, prop_b, prop_c}, 100);
+  {
+    AstStorage storage;
+    auto *query = QUERY(SINGLE_QUERY(
+        MATCH(PATTERN(NODE("n", "label"))),
+        WHERE(AND(AND(EQ(PROPERTY_LOOKUP("n", prop_a), LITERAL(1)), EQ(PROPERTY_LOOKUP("n", prop_b), LITERAL(2))),
+                  GREATER(PROPERTY_LOOKUP("n", prop_c), LITERAL(3)))),
+        RETURN("n")));
+    auto symbol_table = memgraph::query::MakeSymbolTable(query);
+    auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+    CheckPlan(planner.plan(), symbol_table,
+              ExpectScanAllByLabelPropertyComposite(label, {prop_a.second, prop_b, prop_c}, 2, true), ExpectProduce());
+  }
+  {
+    // Without the filter on `b` only the single property index can be used.
+    AstStorage storage;
+    auto *query = QUERY(SINGLE_QUERY(
+        MATCH(PATTERN(NODE("n", "label"))),
+        WHERE(AND(EQ(PROPERTY_LOOKUP("n", prop_a), LITERAL(1)), GREATER(PROPERTY_LOOKUP("n", prop_c), LITERAL(3)))),
+        RETURN("n")));
+    auto symbol_table = memgraph::query::MakeSymbolTable(query);
+    auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+    CheckPlan(planner.plan(), symbol_table, ExpectScanAllByLabelPropertyValue(label, prop_a, LITERAL(1)),
+              ExpectFilter(), ExpectProduce());
+  }
+}
+
 TYPED_TEST(TestPlanner, WhereIndexedLabelPropertyRange) {
   // Test MATCH (n :label) WHERE n.property REL_OP 42 RETURN n
   // REL_OP is one of: `<`, `<=`, `>`, `>=`
@@ -1221,6 +1391,25 @@ TYPED_TEST(TestPlanner, SecondPropertyIndex) {
             ExpectScanAllByLabelPropertyValue(label, property, n_prop), ExpectProduce());
 }
 
+TYPED_TEST(TestPlanner, MatchHashJoin) {
+  // Test MATCH (n), (m) -[r]- (l) WHERE n.prop = m.prop RETURN n
+  FakeDbAccessor dba;
+  auto prop = dba.Property("prop");
+  AstStorage storage;
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n")), PATTERN(NODE("m"), EDGE("r"), NODE("l"))),
+                                   WHERE(EQ(PROPERTY_LOOKUP("n", prop), PROPERTY_LOOKUP("m", prop))), RETURN("n")));
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+  // The equality filter is replaced by the keys of the join, so there's no
+  // `Filter` operator left.
+  std::list<std::unique_ptr<BaseOpChecker>> left;
+  left.emplace_back(new ExpectScanAll());
+  std::list<std::unique_ptr<BaseOpChecker>> right;
+  right.emplace_back(new ExpectScanAll());
+  right.emplace_back(new ExpectExpand());
+  CheckPlan(planner.plan(), symbol_table, ExpectHashJoin(left, right), ExpectProduce());
+}
+
 TYPED_TEST(TestPlanner, ReturnSumGroupByAll) {
   // Test RETURN sum([1,2,3]), all(x in [1] where x = 1)
   AstStorage storage;
@@ -1735,4 +1924,43 @@ TYPED_TEST(TestPlanner, Foreach) {
     DeleteListContent(&on_create);
   }
 }
+
+TYPED_TEST(TestPlanner, MatchEdgeTypeIndex) {
+  // Test MATCH (n)-[r:type]->(m) RETURN n
+  AstStorage storage;
+  FakeDbAccessor dba;
+  auto edge_type = dba.NameToEdgeType("type");
+  dba.SetIndexCount(edge_type, 10);
+  {
+    auto *query = QUERY(
+        SINGLE_QUERY(MATCH(PATTERN(NODE("n"), EDGE("r", Direction::OUT, {"type"}), NODE("m"))), RETURN("n")));
+    auto symbol_table = memgraph::query::MakeSymbolTable(query);
+    auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+    CheckPlan(planner.plan(), symbol_table, ExpectScanAllByEdgeType(), ExpectProduce());
+  }
+  {
+    // The index cannot be used when expanding in both directions.
+    auto *query = QUERY(
+        SINGLE_QUERY(MATCH(PATTERN(NODE("n"), EDGE("r", Direction::BOTH, {"type"}), NODE("m"))), RETURN("n")));
+    auto symbol_table = memgraph::query::MakeSymbolTable(query);
+    auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+    CheckPlan(planner.plan(), symbol_table, ExpectScanAll(), ExpectExpand(), ExpectProduce());
+  }
+}
+
+TYPED_TEST(TestPlanner, MatchEdgeTypePropertyIndex) {
+  // Test MATCH (n)<-[r:type {property: 42}]-(m) RETURN n
+  AstStorage storage;
+  FakeDbAccessor dba;
+  auto edge_type = dba.NameToEdgeType("type");
+  auto property = PROPERTY_PAIR("property");
+  dba.SetIndexCount(edge_type, 10);
+  dba.SetIndexCount(edge_type, property.second, 1);
+  auto *edge = EDGE("r", Direction::IN, {"type"});
+  std::get<0>(edge->properties_)[storage.GetPropertyIx(property.first)] = LITERAL(42);
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n"), edge, NODE("m"))), RETURN("n")));
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+  CheckPlan(planner.plan(), symbol_table, ExpectScanAllByEdgeTypePropertyValue(), ExpectProduce());
+}
 }  // namespace
@@ -1009,3 +1009,53 @@ TEST(QueryPlan, AggregateTypesWithDistinct) {
   EXPECT_THROW(aggregate(n_p2, Aggregation::Op::AVG), QueryRuntimeException);
   EXPECT_THROW(aggregate(n_p2, Aggregation::Op::SUM), QueryRuntimeException);
 }
+
+TEST(QueryPlan, ParallelAggregate) {
+  memgraph::storage::Storage db;
+  auto storage_dba = db.Access();
+  memgraph::query::DbAccessor dba(&storage_dba);
+  auto prop = dba.NameToProperty("prop");
+  auto group = dba.NameToProperty("group");
+  // More vertices than fit into a single morsel, some of them without the
+  // aggregated property.
+  for (int i = 0; i < 10000; ++i) {
+    auto vertex = dba.InsertVertex();
+    ASSERT_TRUE(vertex.SetProperty(group, memgraph::storage::PropertyValue(i % 7)).HasValue());
+    if (i % 10 == 0) continue;
+    ASSERT_TRUE(vertex.SetProperty(prop, memgraph::storage::PropertyValue(i)).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  AstStorage storage;
+  SymbolTable symbol_table;
+  auto n = MakeScanAll(storage, symbol_table, "n");
+  auto n_p = PROPERTY_LOOKUP(IDENT("n")->MapTo(n.sym_), prop);
+  auto n_group = PROPERTY_LOOKUP(IDENT("n")->MapTo(n.sym_), group);
+  auto produce = MakeAggregationProduce(
+      n.op_, symbol_table, storage, {nullptr, n_p, n_p, n_p, n_p, n_p},
+      {Aggregation::Op::COUNT, Aggregation::Op::COUNT, Aggregation::Op::MIN, Aggregation::Op::MAX,
+       Aggregation::Op::SUM, Aggregation::Op::AVG},
+      {n_group}, {}, false);
+  auto context = MakeContext(storage, symbol_table, &dba);
+  auto expected = CollectProduce(*produce, &context);
+  ASSERT_EQ(expected.size(), 7);
+
+  auto aggregate = std::dynamic_pointer_cast<Aggregate>(produce->input());
+  ASSERT_TRUE(aggregate);
+  produce->set_input(std::make_shared<ParallelAggregate>(aggregate->input_, aggregate->aggregations_,
+                                                         aggregate->group_by_, aggregate->remember_, 4));
+  auto parallel_context = MakeContext(storage, symbol_table, &dba);
+  auto results = CollectProduce(*produce, &parallel_context);
+  ASSERT_EQ(results.size(), expected.size());
+
+  // The groups can be produced in any order, the group value is the last column.
+  auto by_group = [](const auto &a, const auto &b) { return a.back().ValueInt() < b.back().ValueInt(); };
+  std::sort(expected.begin(), expected.end(), by_group);
+  std::sort(results.begin(), results.end(), by_group);
+  for (size_t i = 0; i < results.size(); ++i) {
+    ASSERT_EQ(results[i].size(), expected[i].size());
+    for (size_t j = 0; j < results[i].size(); ++j) {
+      EXPECT_TRUE(TypedValue::BoolEqual{}(results[i][j], expected[i][j]));
+    }
+  }
+}
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -15,8 +15,13 @@
 //
 
 #include <algorithm>
+#include <cstdint>
+#include <filesystem>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <numeric>
+#include <string>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -25,6 +30,7 @@
 #include "query/context.hpp"
 #include "query/exceptions.hpp"
 #include "query/plan/operator.hpp"
+#include "query/plan/spill_file.hpp"
 
 #include "query_plan_common.hpp"
 
@@ -300,3 +306,156 @@ TEST(QueryPlan, OrderByExceptions) {
     EXPECT_THROW(PullAll(*order_by, &context), QueryRuntimeException);
   }
 }
+
+TEST(QueryPlan, TopK) {
+  memgraph::storage::Storage db;
+  auto storage_dba = db.Access();
+  memgraph::query::DbAccessor dba(&storage_dba);
+  AstStorage storage;
+  SymbolTable symbol_table;
+  auto prop = dba.NameToProperty("prop");
+
+  // create vertices with the values 0, 0, 1, 1, ... in a random order
+  const int N = 100;
+  std::vector<int> values;
+  for (int i = 0; i < N; ++i) values.push_back(i / 2);
+  std::random_shuffle(values.begin(), values.end());
+  for (int value : values)
+    ASSERT_TRUE(dba.InsertVertex().SetProperty(prop, memgraph::storage::PropertyValue(value)).HasValue());
+  dba.AdvanceCommand();
+
+  // Returns the values of the rows kept by TopK, which are all of the rows
+  // that Skip and Limit above it would need.
+  auto top_k_values = [&](Ordering ordering, Expression *limit, Expression *skip) {
+    auto n = MakeScanAll(storage, symbol_table, "n");
+    auto n_p = PROPERTY_LOOKUP(IDENT("n")->MapTo(n.sym_), prop);
+    auto top_k = std::make_shared<TopK>(n.op_, TypedValueVectorCompare({ordering}), std::vector<Expression *>{n_p},
+                                        std::vector<Symbol>{n.sym_}, limit, skip);
+    auto n_p_ne = NEXPR("n.p", n_p)->MapTo(symbol_table.CreateSymbol("n.p", true));
+    auto produce = MakeProduce(top_k, n_p_ne);
+    auto context = MakeContext(storage, symbol_table, &dba);
+    std::vector<int64_t> result;
+    for (const auto &row : CollectProduce(*produce, &context)) result.push_back(row[0].ValueInt());
+    return result;
+  };
+
+  EXPECT_THAT(top_k_values(Ordering::ASC, LITERAL(5), nullptr), testing::ElementsAre(0, 0, 1, 1, 2));
+  EXPECT_THAT(top_k_values(Ordering::ASC, LITERAL(3), LITERAL(2)), testing::ElementsAre(0, 0, 1, 1, 2));
+  EXPECT_THAT(top_k_values(Ordering::DESC, LITERAL(3), nullptr), testing::ElementsAre(49, 49, 48));
+  EXPECT_TRUE(top_k_values(Ordering::ASC, LITERAL(0), nullptr).empty());
+  EXPECT_EQ(top_k_values(Ordering::ASC, LITERAL(2 * N), nullptr).size(), N);
+
+  // With an invalid limit or skip all of the rows are sorted, so that Limit
+  // and Skip can raise the error.
+  const auto max_int = std::numeric_limits<int64_t>::max();
+  std::vector<std::pair<Expression *, Expression *>> invalid{{LITERAL("5"), nullptr},
+                                                             {LITERAL(-1), nullptr},
+                                                             {LITERAL(5), LITERAL(1.5)},
+                                                             {LITERAL(1), LITERAL(max_int)}};
+  for (auto [limit, skip] : invalid) {
+    auto result = top_k_values(Ordering::ASC, limit, skip);
+    ASSERT_EQ(result.size(), N);
+    EXPECT_TRUE(std::is_sorted(result.begin(), result.end()));
+  }
+}
+
+TEST(QueryPlan, OrderBySpill) {
+  memgraph::storage::Storage db;
+  auto storage_dba = db.Access();
+  memgraph::query::DbAccessor dba(&storage_dba);
+  AstStorage storage;
+  SymbolTable symbol_table;
+  auto prop = dba.NameToProperty("prop");
+  auto text = dba.NameToProperty("text");
+
+  // create enough vertices that their rows take a few MiB
+  const int N = 10000;
+  std::vector<int> values(N);
+  std::iota(values.begin(), values.end(), 0);
+  std::random_shuffle(values.begin(), values.end());
+  for (int value : values) {
+    auto v = dba.InsertVertex();
+    ASSERT_TRUE(v.SetProperty(prop, memgraph::storage::PropertyValue(value)).HasValue());
+    ASSERT_TRUE(v.SetProperty(text, memgraph::storage::PropertyValue(std::string(200, 'a' + value % 26))).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  const auto spill_directory = std::filesystem::temp_directory_path() / "MG_test_unit_query_plan_order_by_spill";
+  std::filesystem::remove_all(spill_directory);
+  const auto old_memory_limit = FLAGS_query_order_by_memory_limit_mb;
+  const auto old_spill_directory = FLAGS_query_order_by_spill_directory;
+  FLAGS_query_order_by_memory_limit_mb = 1;
+  FLAGS_query_order_by_spill_directory = spill_directory.string();
+
+  // Sorts the rows with the values of the properties, or with the vertices
+  // themselves, which can't be spilled.
+  auto sorted_values = [&](bool with_vertex) {
+    auto n = MakeScanAll(storage, symbol_table, "n");
+    auto n_p_ne = NEXPR("n.p", PROPERTY_LOOKUP(IDENT("n")->MapTo(n.sym_), prop))
+                      ->MapTo(symbol_table.CreateSymbol("n.p", true));
+    auto n_t_ne = NEXPR("n.t", PROPERTY_LOOKUP(IDENT("n")->MapTo(n.sym_), text))
+                      ->MapTo(symbol_table.CreateSymbol("n.t", true));
+    auto properties = MakeProduce(n.op_, n_p_ne, n_t_ne);
+    std::vector<Symbol> output_symbols{symbol_table.at(*n_p_ne), symbol_table.at(*n_t_ne)};
+    if (with_vertex) output_symbols.push_back(n.sym_);
+    auto order_by = std::make_shared<plan::OrderBy>(
+        properties, std::vector<SortItem>{{Ordering::DESC, IDENT("n.p")->MapTo(symbol_table.at(*n_p_ne))}},
+        output_symbols);
+    auto p_ne = NEXPR("p", IDENT("n.p")->MapTo(symbol_table.at(*n_p_ne)))->MapTo(symbol_table.CreateSymbol("p", true));
+    auto t_ne = NEXPR("t", IDENT("n.t")->MapTo(symbol_table.at(*n_t_ne)))->MapTo(symbol_table.CreateSymbol("t", true));
+    auto produce = MakeProduce(order_by, p_ne, t_ne);
+    auto context = MakeContext(storage, symbol_table, &dba);
+    return CollectProduce(*produce, &context);
+  };
+
+  for (bool with_vertex : {false, true}) {
+    auto results = sorted_values(with_vertex);
+    ASSERT_EQ(results.size(), N);
+    for (int i = 0; i < N; ++i) {
+      const int value = N - 1 - i;
+      ASSERT_EQ(results[i][0].ValueInt(), value);
+      ASSERT_EQ(results[i][1].ValueString(), std::string(200, 'a' + value % 26));
+    }
+  }
+  // The rows were spilled, and the files were deleted with the cursor.
+  ASSERT_TRUE(std::filesystem::is_directory(spill_directory));
+  ASSERT_TRUE(std::filesystem::is_empty(spill_directory));
+
+  std::filesystem::remove_all(spill_directory);
+  FLAGS_query_order_by_memory_limit_mb = old_memory_limit;
+  FLAGS_query_order_by_spill_directory = old_spill_directory;
+}
+
+TEST(QueryPlan, SpillFile) {
+  const auto spill_directory = std::filesystem::temp_directory_path() / "MG_test_unit_query_plan_spill_file";
+  std::filesystem::remove_all(spill_directory);
+  const auto old_spill_directory = FLAGS_query_order_by_spill_directory;
+  FLAGS_query_order_by_spill_directory = spill_directory.string();
+
+  std::vector<TypedValue> values{TypedValue(),
+                                 TypedValue(true),
+                                 TypedValue(-42),
+                                 TypedValue(3.5),
+                                 TypedValue("spilled"),
+                                 TypedValue(memgraph::utils::Date(1000000)),
+                                 TypedValue(memgraph::utils::LocalTime(2000000)),
+                                 TypedValue(memgraph::utils::LocalDateTime(3000000)),
+                                 TypedValue(memgraph::utils::Duration(-4000000))};
+  // Lists with a null aren't equal to themselves, so the null is left out.
+  values.emplace_back(std::vector<TypedValue>(values.begin() + 1, values.end()));
+  values.emplace_back(std::map<std::string, TypedValue>{{"a", TypedValue(1)}, {"b", values.back()}});
+  {
+    memgraph::query::plan::SpillFile file;
+    for (const auto &value : values) file.Write(value);
+    file.FinishWriting();
+    for (const auto &value : values) {
+      EXPECT_TRUE(TypedValue::BoolEqual{}(file.Read(memgraph::utils::NewDeleteResource()), value));
+    }
+    // Reading past the end of the file fails only the query.
+    EXPECT_THROW(file.Read(memgraph::utils::NewDeleteResource()), QueryRuntimeException);
+  }
+  ASSERT_TRUE(std::filesystem::is_empty(spill_directory));
+
+  std::filesystem::remove_all(spill_directory);
+  FLAGS_query_order_by_spill_directory = old_spill_directory;
+}
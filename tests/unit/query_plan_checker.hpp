@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -9,6 +9,9 @@
 // by the Apache License, Version 2.0, included in the file
 // licenses/APL.txt.
 
+#include <set>
+#include <utility>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -60,8 +63,11 @@ class PlanChecker : public virtual HierarchicalLogicalOperatorVisitor {
   PRE_VISIT(ScanAllByLabel);
   PRE_VISIT(ScanAllByLabelPropertyValue);
   PRE_VISIT(ScanAllByLabelPropertyRange);
+  PRE_VISIT(ScanAllByLabelPropertyComposite);
   PRE_VISIT(ScanAllByLabelProperty);
   PRE_VISIT(ScanAllById);
+  PRE_VISIT(ScanAllByEdgeType);
+  PRE_VISIT(ScanAllByEdgeTypePropertyValue);
   PRE_VISIT(Expand);
   PRE_VISIT(ExpandVariable);
   PRE_VISIT(Filter);
@@ -76,9 +82,12 @@ class PlanChecker : public virtual HierarchicalLogicalOperatorVisitor {
   PRE_VISIT(EdgeUniquenessFilter);
   PRE_VISIT(Accumulate);
   PRE_VISIT(Aggregate);
+  PRE_VISIT(ParallelAggregate);
+  PRE_VISIT(ColumnarAggregate);
   PRE_VISIT(Skip);
   PRE_VISIT(Limit);
   PRE_VISIT(OrderBy);
+  PRE_VISIT(TopK);
   bool PreVisit(Merge &op) override {
     CheckOp(op);
     op.input()->Accept(*this);
@@ -107,6 +116,11 @@ class PlanChecker : public virtual HierarchicalLogicalOperatorVisitor {
     return false;
   }
 
+  bool PreVisit(HashJoin &op) override {
+    CheckOp(op);
+    return false;
+  }
+
   PRE_VISIT(CallProcedure);
 
 #undef PRE_VISIT
@@ -140,6 +154,8 @@ using ExpectDelete = OpChecker<Delete>;
 using ExpectScanAll = OpChecker<ScanAll>;
 using ExpectScanAllByLabel = OpChecker<ScanAllByLabel>;
 using ExpectScanAllById = OpChecker<ScanAllById>;
+using ExpectScanAllByEdgeType = OpChecker<ScanAllByEdgeType>;
+using ExpectScanAllByEdgeTypePropertyValue = OpChecker<ScanAllByEdgeTypePropertyValue>;
 using ExpectExpand = OpChecker<Expand>;
 using ExpectFilter = OpChecker<Filter>;
 using ExpectConstructNamedPath = OpChecker<ConstructNamedPath>;
@@ -154,8 +170,11 @@ using ExpectEdgeUniquenessFilter = OpChecker<EdgeUniquenessFilter>;
 using ExpectSkip = OpChecker<Skip>;
 using ExpectLimit = OpChecker<Limit>;
 using ExpectOrderBy = OpChecker<OrderBy>;
+using ExpectTopK = OpChecker<TopK>;
 using ExpectUnwind = OpChecker<Unwind>;
 using ExpectDistinct = OpChecker<Distinct>;
+using ExpectParallelAggregate = OpChecker<ParallelAggregate>;
+using ExpectColumnarAggregate = OpChecker<ColumnarAggregate>;
 
 class ExpectForeach : public OpChecker<Foreach> {
  public:
@@ -323,6 +342,27 @@ class ExpectScanAllByLabelPropertyRange : public OpChecker<ScanAllByLabelPropert
   std::optional<ScanAllByLabelPropertyRange::Bound> upper_bound_;
 };
 
+class ExpectScanAllByLabelPropertyComposite : public OpChecker<ScanAllByLabelPropertyComposite> {
+ public:
+  ExpectScanAllByLabelPropertyComposite(memgraph::storage::LabelId label,
+                                        const std::vector<memgraph::storage::PropertyId> &properties,
+                                        size_t prefix_size, bool has_range)
+      : label_(label), properties_(properties), prefix_size_(prefix_size), has_range_(has_range) {}
+
+  void ExpectOp(ScanAllByLabelPropertyComposite &scan_all, const SymbolTable &) override {
+    EXPECT_EQ(scan_all.label_, label_);
+    EXPECT_EQ(scan_all.properties_, properties_);
+    EXPECT_EQ(scan_all.prefix_.size(), prefix_size_);
+    EXPECT_EQ(scan_all.lower_bound_ || scan_all.upper_bound_, has_range_);
+  }
+
+ private:
+  memgraph::storage::LabelId label_;
+  std::vector<memgraph::storage::PropertyId> properties_;
+  size_t prefix_size_;
+  bool has_range_;
+};
+
 class ExpectScanAllByLabelProperty : public OpChecker<ScanAllByLabelProperty> {
  public:
   ExpectScanAllByLabelProperty(memgraph::storage::LabelId label,
@@ -359,6 +399,27 @@ class ExpectCartesian : public OpChecker<Cartesian> {
   const std::list<std::unique_ptr<BaseOpChecker>> &right_;
 };
 
+class ExpectHashJoin : public OpChecker<HashJoin> {
+ public:
+  ExpectHashJoin(const std::list<std::unique_ptr<BaseOpChecker>> &left,
+                 const std::list<std::unique_ptr<BaseOpChecker>> &right)
+      : left_(left), right_(right) {}
+
+  void ExpectOp(HashJoin &op, const SymbolTable &symbol_table) override {
+    EXPECT_EQ(op.left_keys_.size(), op.right_keys_.size());
+    ASSERT_TRUE(op.left_op_);
+    PlanChecker left_checker(left_, symbol_table);
+    op.left_op_->Accept(left_checker);
+    ASSERT_TRUE(op.right_op_);
+    PlanChecker right_checker(right_, symbol_table);
+    op.right_op_->Accept(right_checker);
+  }
+
+ private:
+  const std::list<std::unique_ptr<BaseOpChecker>> &left_;
+  const std::list<std::unique_ptr<BaseOpChecker>> &right_;
+};
+
 class ExpectCallProcedure : public OpChecker<CallProcedure> {
  public:
   ExpectCallProcedure(const std::string &name, const std::vector<memgraph::query::Expression *> &args,
@@ -409,6 +470,8 @@ TPlanner MakePlanner(TDbAccessor *dba, AstStorage &storage, SymbolTable &symbol_
 
 class FakeDbAccessor {
  public:
+  int64_t VerticesCount() const { return vertices_count_; }
+
   int64_t VerticesCount(memgraph::storage::LabelId label) const {
     auto found = label_index_.find(label);
     if (found != label_index_.end()) return found->second;
@@ -437,6 +500,86 @@ class FakeDbAccessor {
     return false;
   }
 
+  int64_t VerticesCount(memgraph::storage::LabelId label,
+                        const std::vector<memgraph::storage::PropertyId> &properties,
+                        const std::vector<memgraph::storage::PropertyValue> &) const {
+    for (auto &index : label_property_composite_index_) {
+      if (std::get<0>(index) == label && std::get<1>(index) == properties) {
+        return std::get<2>(index);
+      }
+    }
+    return 0;
+  }
+
+  int64_t VerticesCount(memgraph::storage::LabelId label,
+                        const std::vector<memgraph::storage::PropertyId> &properties,
+                        const std::vector<memgraph::storage::PropertyValue> &prefix,
+                        const std::optional<memgraph::utils::Bound<memgraph::storage::PropertyValue>> &,
+                        const std::optional<memgraph::utils::Bound<memgraph::storage::PropertyValue>> &) const {
+    return VerticesCount(label, properties, prefix);
+  }
+
+  std::vector<std::vector<memgraph::storage::PropertyId>> LabelPropertyCompositeIndices(
+      memgraph::storage::LabelId label) const {
+    std::vector<std::vector<memgraph::storage::PropertyId>> ret;
+    for (auto &index : label_property_composite_index_) {
+      if (std::get<0>(index) == label) ret.push_back(std::get<1>(index));
+    }
+    return ret;
+  }
+
+  int64_t EdgesCount(memgraph::storage::EdgeTypeId edge_type) const {
+    auto found = edge_type_index_.find(edge_type);
+    if (found != edge_type_index_.end()) return found->second;
+    return 0;
+  }
+
+  int64_t EdgesCount(memgraph::storage::EdgeTypeId edge_type, memgraph::storage::PropertyId property) const {
+    for (auto &index : edge_type_property_index_) {
+      if (std::get<0>(index) == edge_type && std::get<1>(index) == property) {
+        return std::get<2>(index);
+      }
+    }
+    return 0;
+  }
+
+  int64_t EdgesCount(memgraph::storage::EdgeTypeId edge_type, memgraph::storage::PropertyId property,
+                     const memgraph::storage::PropertyValue &) const {
+    return EdgesCount(edge_type, property);
+  }
+
+  bool EdgeTypeIndexExists(memgraph::storage::EdgeTypeId edge_type) const {
+    return edge_type_index_.find(edge_type) != edge_type_index_.end();
+  }
+
+  bool EdgeTypePropertyIndexExists(memgraph::storage::EdgeTypeId edge_type,
+                                   memgraph::storage::PropertyId property) const {
+    for (auto &index : edge_type_property_index_) {
+      if (std::get<0>(index) == edge_type && std::get<1>(index) == property) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool PropertyColumnExists(memgraph::storage::LabelId label, memgraph::storage::PropertyId property) const {
+    return property_columns_.contains({label, property});
+  }
+
+  // The graph statistics are never computed for the fake.
+  std::optional<memgraph::storage::LabelPropertyStats> GetLabelPropertyStats(memgraph::storage::LabelId,
+                                                                             memgraph::storage::PropertyId) const {
+    return std::nullopt;
+  }
+
+  std::optional<double> GetAverageDegree() const { return std::nullopt; }
+
+  void SetVerticesCount(int64_t count) { vertices_count_ = count; }
+
+  void AddPropertyColumn(memgraph::storage::LabelId label, memgraph::storage::PropertyId property) {
+    property_columns_.emplace(label, property);
+  }
+
   void SetIndexCount(memgraph::storage::LabelId label, int64_t count) { label_index_[label] = count; }
 
   void SetIndexCount(memgraph::storage::LabelId label, memgraph::storage::PropertyId property, int64_t count) {
@@ -449,6 +592,29 @@ class FakeDbAccessor {
     label_property_index_.emplace_back(label, property, count);
   }
 
+  void SetIndexCount(memgraph::storage::LabelId label, const std::vector<memgraph::storage::PropertyId> &properties,
+                     int64_t count) {
+    for (auto &index : label_property_composite_index_) {
+      if (std::get<0>(index) == label && std::get<1>(index) == properties) {
+        std::get<2>(index) = count;
+        return;
+      }
+    }
+    label_property_composite_index_.emplace_back(label, properties, count);
+  }
+
+  void SetIndexCount(memgraph::storage::EdgeTypeId edge_type, int64_t count) { edge_type_index_[edge_type] = count; }
+
+  void SetIndexCount(memgraph::storage::EdgeTypeId edge_type, memgraph::storage::PropertyId property, int64_t count) {
+    for (auto &index : edge_type_property_index_) {
+      if (std::get<0>(index) == edge_type && std::get<1>(index) == property) {
+        std::get<2>(index) = count;
+        return;
+      }
+    }
+    edge_type_property_index_.emplace_back(edge_type, property, count);
+  }
+
   memgraph::storage::LabelId NameToLabel(const std::string &name) {
     auto found = labels_.find(name);
     if (found != labels_.end()) return found->second;
@@ -485,8 +651,15 @@ class FakeDbAccessor {
   std::unordered_map<std::string, memgraph::storage::EdgeTypeId> edge_types_;
   std::unordered_map<std::string, memgraph::storage::PropertyId> properties_;
 
+  int64_t vertices_count_{0};
   std::unordered_map<memgraph::storage::LabelId, int64_t> label_index_;
   std::vector<std::tuple<memgraph::storage::LabelId, memgraph::storage::PropertyId, int64_t>> label_property_index_;
+  std::vector<std::tuple<memgraph::storage::LabelId, std::vector<memgraph::storage::PropertyId>, int64_t>>
+      label_property_composite_index_;
+  std::unordered_map<memgraph::storage::EdgeTypeId, int64_t> edge_type_index_;
+  std::vector<std::tuple<memgraph::storage::EdgeTypeId, memgraph::storage::PropertyId, int64_t>>
+      edge_type_property_index_;
+  std::set<std::pair<memgraph::storage::LabelId, memgraph::storage::PropertyId>> property_columns_;
 };
 
 }  // namespace memgraph::query::plan
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -79,6 +79,26 @@ std::vector<std::vector<TypedValue>> CollectProduce(const Produce &produce, Exec
   return results;
 }
 
+/** Same as `CollectProduce`, but pulls the results in batches of at most
+ * `capacity` rows. */
+std::vector<std::vector<TypedValue>> CollectProduceBatches(const Produce &produce, ExecutionContext *context,
+                                                           size_t capacity) {
+  Frame frame(context->symbol_table.max_position());
+  auto symbols = produce.OutputSymbols(context->symbol_table);
+  auto cursor = produce.MakeCursor(memgraph::utils::NewDeleteResource());
+  FrameBatch batch(frame, capacity);
+  std::vector<std::vector<TypedValue>> results;
+  while (cursor->PullBatch(batch, *context)) {
+    for (size_t row = 0; row < batch.size(); ++row) {
+      std::vector<TypedValue> values;
+      for (auto &symbol : symbols) values.emplace_back(batch[row][symbol]);
+      results.emplace_back(values);
+    }
+  }
+
+  return results;
+}
+
 int PullAll(const LogicalOperator &logical_op, ExecutionContext *context) {
   Frame frame(context->symbol_table.max_position());
   auto cursor = logical_op.MakeCursor(memgraph::utils::NewDeleteResource());
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -14,7 +14,9 @@
 #include <iterator>
 #include <memory>
 #include <optional>
+#include <set>
 #include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -465,6 +467,84 @@ TEST(QueryPlan, CartesianThreeWay) {
   }
 }
 
+TEST(QueryPlan, HashJoin) {
+  memgraph::storage::Storage db;
+  auto storage_dba = db.Access();
+  memgraph::query::DbAccessor dba(&storage_dba);
+  auto property = PROPERTY_PAIR("property");
+  // Vertices without the property have a null key and they are never joined.
+  // Integers and doubles which compare equal have to be joined.
+  for (const auto &value : {memgraph::storage::PropertyValue(1), memgraph::storage::PropertyValue(1.0),
+                            memgraph::storage::PropertyValue(2), memgraph::storage::PropertyValue(2),
+                            memgraph::storage::PropertyValue(3), memgraph::storage::PropertyValue()}) {
+    auto vertex = dba.InsertVertex();
+    ASSERT_TRUE(vertex.SetProperty(property.second, value).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  AstStorage storage;
+  SymbolTable symbol_table;
+
+  auto n = MakeScanAll(storage, symbol_table, "n");
+  auto m = MakeScanAll(storage, symbol_table, "m");
+  auto return_n = NEXPR("n", IDENT("n")->MapTo(n.sym_))->MapTo(symbol_table.CreateSymbol("named_expression_1", true));
+  auto return_m = NEXPR("m", IDENT("m")->MapTo(m.sym_))->MapTo(symbol_table.CreateSymbol("named_expression_2", true));
+
+  std::vector<Symbol> left_symbols{n.sym_};
+  std::vector<Symbol> right_symbols{m.sym_};
+  std::vector<Expression *> left_keys{PROPERTY_LOOKUP(n.node_->identifier_, property)};
+  std::vector<Expression *> right_keys{PROPERTY_LOOKUP(m.node_->identifier_, property)};
+  auto hash_join_op = std::make_shared<HashJoin>(n.op_, left_symbols, m.op_, right_symbols, left_keys, right_keys);
+
+  auto produce = MakeProduce(hash_join_op, return_n, return_m);
+  auto context = MakeContext(storage, symbol_table, &dba);
+  auto results = CollectProduce(*produce, &context);
+  // 2 * 2 pairs with the value 1, 2 * 2 pairs with the value 2 and 1 pair
+  // with the value 3.
+  EXPECT_EQ(results.size(), 9);
+  for (const auto &row : results) {
+    auto n_value = row[0].ValueVertex().GetProperty(memgraph::storage::View::OLD, property.second);
+    auto m_value = row[1].ValueVertex().GetProperty(memgraph::storage::View::OLD, property.second);
+    ASSERT_TRUE(n_value.HasValue() && m_value.HasValue());
+    EXPECT_TRUE(memgraph::query::TypedValue::BoolEqual{}(memgraph::query::TypedValue(*n_value),
+                                                          memgraph::query::TypedValue(*m_value)));
+  }
+}
+
+TEST(QueryPlan, HashJoinEmptySide) {
+  memgraph::storage::Storage db;
+  auto storage_dba = db.Access();
+  memgraph::query::DbAccessor dba(&storage_dba);
+  auto label = dba.NameToLabel("label");
+  auto property = PROPERTY_PAIR("property");
+  for (int i = 0; i < 3; ++i) {
+    auto vertex = dba.InsertVertex();
+    ASSERT_TRUE(vertex.SetProperty(property.second, memgraph::storage::PropertyValue(i)).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  AstStorage storage;
+  SymbolTable symbol_table;
+
+  // None of the vertices has the label, so the right side is exhausted
+  // before the left one and the join produces no rows.
+  auto n = MakeScanAll(storage, symbol_table, "n");
+  auto m = MakeScanAll(storage, symbol_table, "m");
+  auto m_filter = std::make_shared<Filter>(
+      m.op_, storage.Create<LabelsTest>(m.node_->identifier_,
+                                         std::vector<LabelIx>{storage.GetLabelIx(dba.LabelToName(label))}));
+  auto return_n = NEXPR("n", IDENT("n")->MapTo(n.sym_))->MapTo(symbol_table.CreateSymbol("named_expression_1", true));
+
+  std::vector<Expression *> left_keys{PROPERTY_LOOKUP(n.node_->identifier_, property)};
+  std::vector<Expression *> right_keys{PROPERTY_LOOKUP(m.node_->identifier_, property)};
+  auto hash_join_op = std::make_shared<HashJoin>(n.op_, std::vector<Symbol>{n.sym_}, m_filter,
+                                                 std::vector<Symbol>{m.sym_}, left_keys, right_keys);
+
+  auto produce = MakeProduce(hash_join_op, return_n);
+  auto context = MakeContext(storage, symbol_table, &dba);
+  EXPECT_EQ(CollectProduce(*produce, &context).size(), 0);
+}
+
 class ExpandFixture : public testing::Test {
  protected:
   memgraph::storage::Storage db;
@@ -2978,6 +3058,104 @@ TEST(QueryPlan, EdgeUniquenessFilter) {
   EXPECT_EQ(1, check_expand_results(true));
 }
 
+TEST(QueryPlan, PullBatch) {
+  memgraph::storage::Storage db;
+  auto storage_dba = db.Access();
+  memgraph::query::DbAccessor dba(&storage_dba);
+
+  // Vertex i has i % 5 outgoing edges and every tenth vertex is without the
+  // property, so the edges of a single vertex can be split between batches.
+  auto prop = PROPERTY_PAIR("prop");
+  auto edge_type = dba.NameToEdgeType("edge_type");
+  std::vector<memgraph::query::VertexAccessor> vertices;
+  for (int i = 0; i < 1000; ++i) {
+    auto vertex = dba.InsertVertex();
+    if (i % 10 != 0) ASSERT_TRUE(vertex.SetProperty(prop.second, memgraph::storage::PropertyValue(i)).HasValue());
+    vertices.push_back(vertex);
+  }
+  for (int i = 0; i < 1000; ++i) {
+    for (int j = 1; j <= i % 5; ++j) {
+      ASSERT_TRUE(dba.InsertEdge(&vertices[i], &vertices[(i * 7 + j) % 1000], edge_type).HasValue());
+    }
+  }
+  dba.AdvanceCommand();
+
+  AstStorage storage;
+  SymbolTable symbol_table;
+
+  // MATCH (n)-[r]->(m) WHERE m.prop > 200 RETURN n.prop AS x, m.prop AS y
+  auto n = MakeScanAll(storage, symbol_table, "n");
+  auto r_m = MakeExpand(storage, symbol_table, n.op_, n.sym_, "r", EdgeAtom::Direction::OUT, {}, "m", false,
+                        memgraph::storage::View::OLD);
+  auto filter = std::make_shared<Filter>(
+      r_m.op_, GREATER(PROPERTY_LOOKUP(IDENT("m")->MapTo(r_m.node_sym_), prop), LITERAL(200)));
+  auto output_x = NEXPR("x", PROPERTY_LOOKUP(IDENT("n")->MapTo(n.sym_), prop))
+                      ->MapTo(symbol_table.CreateSymbol("named_expression_1", true));
+  auto output_y = NEXPR("y", PROPERTY_LOOKUP(IDENT("m")->MapTo(r_m.node_sym_), prop))
+                      ->MapTo(symbol_table.CreateSymbol("named_expression_2", true));
+  auto produce = MakeProduce(filter, output_x, output_y);
+  EXPECT_TRUE(CanPullBatches(*produce));
+
+  auto context = MakeContext(storage, symbol_table, &dba);
+  auto expected = CollectProduce(*produce, &context);
+  ASSERT_GT(expected.size(), FrameBatch::kDefaultCapacity);
+  for (size_t capacity : {size_t{1}, size_t{7}, FrameBatch::kDefaultCapacity}) {
+    auto batch_context = MakeContext(storage, symbol_table, &dba);
+    auto results = CollectProduceBatches(*produce, &batch_context, capacity);
+    ASSERT_EQ(results.size(), expected.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+      ASSERT_EQ(results[i].size(), 2);
+      EXPECT_TRUE(TypedValue::BoolEqual{}(results[i][0], expected[i][0]));
+      EXPECT_TRUE(TypedValue::BoolEqual{}(results[i][1], expected[i][1]));
+    }
+  }
+
+  // Operators which don't produce their rows in batches are pulled row by row.
+  auto edge_uniqueness = std::make_shared<EdgeUniquenessFilter>(r_m.op_, r_m.edge_sym_, std::vector<Symbol>{});
+  EXPECT_FALSE(CanPullBatches(*MakeProduce(edge_uniqueness, output_x, output_y)));
+  auto unwind = MakeUnwind(symbol_table, "u", nullptr, LIST(LITERAL(1), LITERAL(2)));
+  auto unwind_produce = MakeProduce(
+      unwind.op_, NEXPR("u", IDENT("u")->MapTo(unwind.sym_))->MapTo(symbol_table.CreateSymbol("u_output", true)));
+  EXPECT_FALSE(CanPullBatches(*unwind_produce));
+  auto unwind_context = MakeContext(storage, symbol_table, &dba);
+  auto unwind_results = CollectProduceBatches(*unwind_produce, &unwind_context, 1);
+  ASSERT_EQ(unwind_results.size(), 2);
+  EXPECT_EQ(unwind_results[0][0].ValueInt(), 1);
+  EXPECT_EQ(unwind_results[1][0].ValueInt(), 2);
+}
+
+TEST(QueryPlan, PullBatchScanWithInput) {
+  memgraph::storage::Storage db;
+  auto storage_dba = db.Access();
+  memgraph::query::DbAccessor dba(&storage_dba);
+  auto prop = PROPERTY_PAIR("prop");
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(dba.InsertVertex().SetProperty(prop.second, memgraph::storage::PropertyValue(i)).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  AstStorage storage;
+  SymbolTable symbol_table;
+
+  // MATCH (a), (b) RETURN a.prop AS x, b.prop AS y
+  auto a = MakeScanAll(storage, symbol_table, "a");
+  auto b = MakeScanAll(storage, symbol_table, "b", a.op_);
+  auto output_x = NEXPR("x", PROPERTY_LOOKUP(IDENT("a")->MapTo(a.sym_), prop))
+                      ->MapTo(symbol_table.CreateSymbol("named_expression_1", true));
+  auto output_y = NEXPR("y", PROPERTY_LOOKUP(IDENT("b")->MapTo(b.sym_), prop))
+                      ->MapTo(symbol_table.CreateSymbol("named_expression_2", true));
+  auto produce = MakeProduce(b.op_, output_x, output_y);
+  ASSERT_TRUE(CanPullBatches(*produce));
+
+  // The rows of the inner scan get the symbols of the outer scan's row.
+  auto context = MakeContext(storage, symbol_table, &dba);
+  auto results = CollectProduceBatches(*produce, &context, 7);
+  ASSERT_EQ(results.size(), 100);
+  std::set<std::pair<int64_t, int64_t>> pairs;
+  for (const auto &row : results) pairs.emplace(row[0].ValueInt(), row[1].ValueInt());
+  EXPECT_EQ(pairs.size(), 100);
+}
+
 TEST(QueryPlan, Distinct) {
   // test queries like
   // UNWIND [1, 2, 3, 3] AS x RETURN DISTINCT x
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -19,6 +19,7 @@
 #include "query/plan/planner.hpp"
 #include "utils/algorithm.hpp"
 
+#include "query_plan_checker.hpp"
 #include "query_plan_common.hpp"
 
 #include "formatters.hpp"
@@ -330,4 +331,69 @@ TEST(TestVariableStartPlanner, MatchBfs) {
   CheckPlansProduce(2, query, storage, &dba, [&](const auto &results) { AssertRows(results, {{r1_list}}, dba); });
 }
 
+TEST(TestVariableStartPlanner, OrderExpansionsByCardinality) {
+  AstStorage storage;
+  auto *node_a = NODE("a");
+  auto *node_b = NODE("b");
+  auto *node_c = NODE("c");
+  auto *node_d = NODE("d");
+  auto *edge_e = EDGE("e");
+  auto *edge_f = EDGE("f");
+  // Test MATCH (a) -[r]- (b) -[e]- (c), (b) -[f]- (d) RETURN a
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(node_a, EDGE("r"), node_b, edge_e, node_c),
+                                         PATTERN(NODE("b"), edge_f, node_d)),
+                                   RETURN("a")));
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  auto query_parts = CollectQueryParts(symbol_table, storage, query);
+  const auto &matching = query_parts.query_parts.at(0).single_query_parts.at(0).matching;
+  auto symbol = [&](const auto *atom) { return symbol_table.at(*atom->identifier_); };
+  // Only a few vertices are matched by `c`, so it should be expanded to as
+  // soon as possible.
+  PatternEstimates estimates;
+  estimates.vertex_count = 1000;
+  for (const auto &expansion : matching.expansions) {
+    estimates.node_cardinalities[symbol(expansion.node1)] = 1000;
+    estimates.node_cardinalities[symbol(expansion.node2)] = 1000;
+    estimates.edge_degrees[symbol(expansion.edge)] = 3;
+  }
+  estimates.node_cardinalities[symbol(node_c)] = 1;
+  {
+    auto expansions = impl::OrderExpansions(node_b, matching, symbol_table, estimates);
+    ASSERT_EQ(expansions.size(), 3);
+    EXPECT_EQ(expansions[0].edge, edge_e);
+    EXPECT_EQ(symbol(expansions[0].node1), symbol(node_b));
+  }
+  auto check_from_d = [&] {
+    auto expansions = impl::OrderExpansions(node_d, matching, symbol_table, estimates);
+    ASSERT_EQ(expansions.size(), 3);
+    // The expansion `(b) -[f]- (d)` has to be flipped to start from `d`.
+    EXPECT_EQ(expansions[0].edge, edge_f);
+    EXPECT_TRUE(expansions[0].is_flipped);
+    EXPECT_EQ(symbol(expansions[0].node1), symbol(node_d));
+    EXPECT_EQ(expansions[1].edge, edge_e);
+  };
+  check_from_d();
+  // Without any budget for the exhaustive search, the greedy order should be
+  // the same.
+  const auto budget = FLAGS_query_join_order_budget;
+  FLAGS_query_join_order_budget = 0;
+  check_from_d();
+  FLAGS_query_join_order_budget = budget;
+}
+
+TEST(TestVariableStartPlanner, EstimatePatternsRepeatedEdgeType) {
+  AstStorage storage;
+  FakeDbAccessor dba;
+  dba.SetVerticesCount(100);
+  dba.SetIndexCount(dba.NameToEdgeType("A"), 300);
+  // Test MATCH (a) -[e:A|A]-> (b) RETURN a
+  auto *edge = EDGE("e", Direction::OUT, {"A", "A"});
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("a"), edge, NODE("b"))), RETURN("a")));
+  auto symbol_table = memgraph::query::MakeSymbolTable(query);
+  auto query_parts = CollectQueryParts(symbol_table, storage, query);
+  const auto estimates = EstimatePatterns(query_parts.query_parts.at(0).single_query_parts, symbol_table, &dba);
+  // The edges of the repeated type are counted only once.
+  EXPECT_DOUBLE_EQ(estimates.edge_degrees.at(symbol_table.at(*edge->identifier_)), 3.0);
+}
+
 }  // namespace
@@ -9,6 +9,7 @@
 // by the Apache License, Version 2.0, included in the file
 // licenses/APL.txt.
 
+#include <algorithm>
 #include <vector>
 
 #include <fmt/format.h>
@@ -478,6 +479,130 @@ TEST(SkipList, FindEqualOrGreater) {
   }
 }
 
+TEST(SkipList, Chunks) {
+  memgraph::utils::SkipList<uint64_t> list;
+
+  {
+    auto acc = list.access();
+    auto chunks = acc.chunks(4);
+    ASSERT_EQ(chunks.size(), 1);
+    ASSERT_EQ(chunks[0].begin(), chunks[0].end());
+  }
+
+  const uint64_t kNumItems = 100000;
+  {
+    auto acc = list.access();
+    for (uint64_t i = 0; i < kNumItems; ++i) {
+      ASSERT_TRUE(acc.insert(i).second);
+    }
+  }
+
+  for (uint64_t num_chunks : {1, 2, 7, 16, 64}) {
+    auto acc = list.access();
+    auto chunks = acc.chunks(num_chunks);
+    ASSERT_EQ(chunks.size(), num_chunks);
+    uint64_t expected = 0;
+    for (const auto &chunk : chunks) {
+      uint64_t chunk_size = 0;
+      for (auto item : chunk) {
+        ASSERT_EQ(item, expected);
+        ++expected;
+        ++chunk_size;
+      }
+      // The chunks are determined from samples so they are only roughly
+      // equal in size.
+      ASSERT_GT(chunk_size, kNumItems / num_chunks / 4);
+      ASSERT_LT(chunk_size, kNumItems / num_chunks * 4);
+    }
+    ASSERT_EQ(expected, kNumItems);
+  }
+}
+
+TEST(SkipList, ChunksSmallList) {
+  memgraph::utils::SkipList<uint64_t> list;
+  {
+    auto acc = list.access();
+    for (uint64_t i = 0; i < 3; ++i) {
+      ASSERT_TRUE(acc.insert(i).second);
+    }
+  }
+  auto acc = list.access();
+  auto chunks = acc.chunks(8);
+  ASSERT_GE(chunks.size(), 1);
+  ASSERT_LE(chunks.size(), 3);
+  std::vector<uint64_t> items;
+  for (const auto &chunk : chunks) {
+    for (auto item : chunk) {
+      items.push_back(item);
+    }
+  }
+  ASSERT_EQ(items, (std::vector<uint64_t>{0, 1, 2}));
+}
+
+TEST(SkipList, ChunksWithRemovedBoundary) {
+  memgraph::utils::SkipList<uint64_t> list;
+  const uint64_t kNumItems = 10000;
+  {
+    auto acc = list.access();
+    for (uint64_t i = 0; i < kNumItems; ++i) {
+      ASSERT_TRUE(acc.insert(i).second);
+    }
+  }
+  auto acc = list.access();
+  auto chunks = acc.chunks(4);
+  ASSERT_EQ(chunks.size(), 4);
+  // Remove the first item of each chunk, except the first one, after the
+  // chunks were created. The iteration must still stop at the next chunk.
+  std::vector<uint64_t> removed;
+  for (size_t i = 1; i < chunks.size(); ++i) {
+    removed.push_back(*chunks[i].begin());
+  }
+  for (auto item : removed) {
+    ASSERT_TRUE(acc.remove(item));
+  }
+  uint64_t count = 0;
+  uint64_t prev = 0;
+  for (const auto &chunk : chunks) {
+    for (auto item : chunk) {
+      ASSERT_TRUE(count == 0 || item > prev);
+      ASSERT_EQ(std::find(removed.begin(), removed.end(), item), removed.end());
+      prev = item;
+      ++count;
+    }
+  }
+  ASSERT_EQ(count, kNumItems - removed.size());
+}
+
+TEST(SkipList, BulkInsert) {
+  memgraph::utils::SkipList<uint64_t> list;
+  std::vector<uint64_t> items;
+  for (uint64_t i = 0; i < 10000; ++i) {
+    items.push_back(i * 2);
+  }
+
+  {
+    auto acc = list.access();
+    acc.bulk_insert(items.begin(), items.end());
+    ASSERT_EQ(acc.size(), items.size());
+  }
+
+  {
+    auto acc = list.access();
+    std::vector<uint64_t> found;
+    for (auto item : acc) {
+      found.push_back(item);
+    }
+    ASSERT_EQ(found, items);
+    for (uint64_t i = 0; i < 20000; ++i) {
+      ASSERT_EQ(acc.contains(i), i % 2 == 0);
+    }
+    // The list can be modified as usual after the bulk insertion.
+    ASSERT_TRUE(acc.insert(1).second);
+    ASSERT_TRUE(acc.remove(2));
+    ASSERT_EQ(acc.estimate_range_count<uint64_t>(std::nullopt, std::nullopt, 1), items.size());
+  }
+}
+
 struct Counter {
   int64_t key;
   int64_t value;
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -2089,6 +2089,45 @@ TEST(StorageV2, VertexLabelPropertyMixed) {
   ASSERT_FALSE(acc.Commit().HasError());
 }
 
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(StorageV2, VertexPropertyPredicate) {
+  using Result = memgraph::storage::PropertyPredicate::Result;
+  memgraph::storage::Storage store;
+  auto equal = memgraph::storage::PropertyPredicate::Equal(memgraph::storage::PropertyValue("value"));
+  auto is_null = memgraph::storage::PropertyPredicate::IsNull();
+  memgraph::storage::Gid gid = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
+  memgraph::storage::PropertyId property;
+  {
+    auto acc = store.Access();
+    auto vertex = acc.CreateVertex();
+    gid = vertex.Gid();
+    property = acc.NameToProperty("property");
+    ASSERT_FALSE(vertex.SetProperty(property, memgraph::storage::PropertyValue("value")).HasError());
+    ASSERT_EQ(*vertex.CheckPropertyPredicate(property, equal, memgraph::storage::View::NEW), Result::MATCH);
+    ASSERT_EQ(vertex.CheckPropertyPredicate(property, equal, memgraph::storage::View::OLD).GetError(),
+              memgraph::storage::Error::NONEXISTENT_OBJECT);
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+  {
+    auto acc = store.Access();
+    auto vertex = acc.FindVertex(gid, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex);
+    ASSERT_EQ(*vertex->CheckPropertyPredicate(property, equal, memgraph::storage::View::OLD), Result::MATCH);
+    ASSERT_EQ(*vertex->CheckPropertyPredicate(property, is_null, memgraph::storage::View::OLD), Result::NO_MATCH);
+
+    // The predicate is checked on the value from the delta.
+    ASSERT_FALSE(vertex->SetProperty(property, memgraph::storage::PropertyValue()).HasError());
+    ASSERT_EQ(*vertex->CheckPropertyPredicate(property, equal, memgraph::storage::View::OLD), Result::MATCH);
+    ASSERT_EQ(*vertex->CheckPropertyPredicate(property, equal, memgraph::storage::View::NEW), Result::NO_MATCH);
+    ASSERT_EQ(*vertex->CheckPropertyPredicate(property, is_null, memgraph::storage::View::NEW), Result::MATCH);
+
+    ASSERT_FALSE(acc.DeleteVertex(&*vertex).HasError());
+    ASSERT_EQ(vertex->CheckPropertyPredicate(property, equal, memgraph::storage::View::NEW).GetError(),
+              memgraph::storage::Error::DELETED_OBJECT);
+    acc.Abort();
+  }
+}
+
 TEST(StorageV2, VertexPropertyClear) {
   memgraph::storage::Storage store;
   memgraph::storage::Gid gid;
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -12,9 +12,11 @@
 #include <gtest/gtest.h>
 
 #include <filesystem>
+#include <fstream>
 #include <limits>
 
 #include "storage/v2/durability/serialization.hpp"
+#include "storage/v2/durability/version.hpp"
 #include "storage/v2/property_value.hpp"
 #include "storage/v2/temporal.hpp"
 
@@ -355,6 +357,13 @@ TEST_F(DecoderEncoderTest, PropertyValueInvalidMarker) {
         case memgraph::storage::durability::Marker::DELTA_EXISTENCE_CONSTRAINT_DROP:
         case memgraph::storage::durability::Marker::DELTA_UNIQUE_CONSTRAINT_CREATE:
         case memgraph::storage::durability::Marker::DELTA_UNIQUE_CONSTRAINT_DROP:
+        case memgraph::storage::durability::Marker::DELTA_EDGE_TYPE_INDEX_CREATE:
+        case memgraph::storage::durability::Marker::DELTA_EDGE_TYPE_INDEX_DROP:
+        case memgraph::storage::durability::Marker::DELTA_EDGE_TYPE_PROPERTY_INDEX_CREATE:
+        case memgraph::storage::durability::Marker::DELTA_EDGE_TYPE_PROPERTY_INDEX_DROP:
+        case memgraph::storage::durability::Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+        case memgraph::storage::durability::Marker::DELTA_LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+        case memgraph::storage::durability::Marker::DELTA_GRAPH_STATISTICS_SET:
         case memgraph::storage::durability::Marker::VALUE_FALSE:
         case memgraph::storage::durability::Marker::VALUE_TRUE:
           valid_marker = false;
@@ -459,3 +468,91 @@ TEST_F(DecoderEncoderTest, EncoderPosition) {
     ASSERT_EQ(pos, decoder.GetSize());
   }
 }
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(DecoderEncoderTest, Compression) {
+  const uint64_t kCount = 100000;
+  uint64_t offset_placeholder = 0;
+  uint64_t offset_middle = 0;
+  uint64_t size = 0;
+  {
+    memgraph::storage::durability::Encoder encoder;
+    encoder.Initialize(storage_file, kTestMagic, memgraph::storage::durability::kVersion,
+                       memgraph::storage::Config::Durability::Compression::ZLIB);
+    offset_placeholder = encoder.GetPosition();
+    encoder.WriteUint(0);
+    encoder.StartCompression();
+    for (uint64_t i = 0; i < kCount; ++i) {
+      if (i == kCount / 2) offset_middle = encoder.GetPosition();
+      encoder.WriteUint(i);
+      encoder.WriteString("compressed");
+    }
+    size = encoder.GetPosition();
+    encoder.SetPosition(offset_placeholder);
+    encoder.WriteUint(offset_middle);
+    encoder.SetPosition(size);
+    encoder.WriteBool(true);
+    size = encoder.GetPosition();
+    encoder.Finalize();
+  }
+  ASSERT_LT(std::filesystem::file_size(storage_file), size / 4);
+
+  memgraph::storage::durability::Decoder decoder;
+  auto version = decoder.Initialize(storage_file, kTestMagic);
+  ASSERT_TRUE(version);
+  ASSERT_EQ(*version, memgraph::storage::durability::kVersion);
+  ASSERT_EQ(decoder.GetSize(), size);
+  ASSERT_EQ(decoder.ReadUint(), offset_middle);
+  for (uint64_t i = 0; i < kCount; ++i) {
+    ASSERT_EQ(decoder.ReadUint(), i);
+    ASSERT_EQ(decoder.ReadString(), "compressed");
+  }
+  ASSERT_EQ(decoder.ReadBool(), true);
+  ASSERT_EQ(decoder.GetPosition(), size);
+  ASSERT_FALSE(decoder.ReadMarker());
+
+  // Random access using a decoder which shares the blocks.
+  memgraph::storage::durability::Decoder other;
+  ASSERT_TRUE(other.Initialize(decoder));
+  ASSERT_TRUE(other.SetPosition(offset_middle));
+  ASSERT_EQ(other.ReadUint(), kCount / 2);
+  ASSERT_TRUE(other.SetPosition(offset_placeholder));
+  ASSERT_EQ(other.ReadUint(), offset_middle);
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(DecoderEncoderTest, CompressionCorrupted) {
+  {
+    memgraph::storage::durability::Encoder encoder;
+    encoder.Initialize(storage_file, kTestMagic, memgraph::storage::durability::kVersion,
+                       memgraph::storage::Config::Durability::Compression::ZLIB);
+    encoder.StartCompression();
+    for (uint64_t i = 0; i < 1000; ++i) {
+      encoder.WriteUint(i);
+    }
+    // Each sync writes the current block.
+    encoder.Sync();
+    for (uint64_t i = 0; i < 1000; ++i) {
+      encoder.WriteUint(i);
+    }
+    encoder.Finalize();
+  }
+  // Corrupt the last byte of the file which is in the second block.
+  const auto file_size = std::filesystem::file_size(storage_file);
+  {
+    std::fstream file(storage_file, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekg(static_cast<std::streamoff>(file_size - 1));
+    char value = 0;
+    file.read(&value, 1);
+    value = static_cast<char>(~value);
+    file.seekp(static_cast<std::streamoff>(file_size - 1));
+    file.write(&value, 1);
+  }
+
+  memgraph::storage::durability::Decoder decoder;
+  ASSERT_TRUE(decoder.Initialize(storage_file, kTestMagic));
+  for (uint64_t i = 0; i < 1000; ++i) {
+    ASSERT_EQ(decoder.ReadUint(), i);
+  }
+  ASSERT_FALSE(decoder.ReadUint());
+}
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -16,6 +16,7 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <csignal>
 #include <filesystem>
@@ -693,6 +694,123 @@ TEST_P(DurabilityTest, SnapshotOnExit) {
   }
 }
 
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(DurabilityTest, SnapshotBatches) {
+  // Create snapshot with small batches.
+  {
+    memgraph::storage::Storage store(
+        {.items = {.properties_on_edges = GetParam()},
+         .durability = {.storage_directory = storage_directory, .snapshot_on_exit = true, .items_per_batch = 100}});
+    CreateBaseDataset(&store, GetParam());
+    CreateExtendedDataset(&store);
+    VerifyDataset(&store, DatasetType::BASE_WITH_EXTENDED, GetParam());
+  }
+
+  auto snapshots = GetSnapshotsList();
+  ASSERT_EQ(snapshots.size(), 1);
+  auto info = memgraph::storage::durability::ReadSnapshotInfo(*snapshots.begin());
+  ASSERT_GT(info.vertex_batches.size(), 1);
+  uint64_t vertices_count = 0;
+  for (const auto &batch : info.vertex_batches) {
+    ASSERT_LE(batch.count, 100);
+    vertices_count += batch.count;
+  }
+  ASSERT_EQ(vertices_count, info.vertices_count);
+  if (GetParam()) {
+    ASSERT_GT(info.edge_batches.size(), 1);
+  } else {
+    ASSERT_TRUE(info.edge_batches.empty());
+  }
+
+  // Recover the batches with multiple threads.
+  memgraph::storage::Storage store(
+      {.items = {.properties_on_edges = GetParam()},
+       .durability = {.storage_directory = storage_directory, .recover_on_startup = true, .recovery_thread_count = 4}});
+  VerifyDataset(&store, DatasetType::BASE_WITH_EXTENDED, GetParam());
+
+  // Try to use the storage.
+  {
+    auto acc = store.Access();
+    auto vertex = acc.CreateVertex();
+    auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
+    ASSERT_TRUE(edge.HasValue());
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(DurabilityTest, SnapshotSegments) {
+  // Create snapshot with multiple threads.
+  {
+    memgraph::storage::Storage store({.items = {.properties_on_edges = GetParam()},
+                                      .durability = {.storage_directory = storage_directory,
+                                                     .snapshot_on_exit = true,
+                                                     .items_per_batch = 100,
+                                                     .snapshot_thread_count = 4}});
+    CreateBaseDataset(&store, GetParam());
+    CreateExtendedDataset(&store);
+    VerifyDataset(&store, DatasetType::BASE_WITH_EXTENDED, GetParam());
+  }
+
+  // The segments are merged into a single snapshot file.
+  auto snapshots = GetSnapshotsList();
+  ASSERT_EQ(snapshots.size(), 1);
+  auto info = memgraph::storage::durability::ReadSnapshotInfo(*snapshots.begin());
+  ASSERT_GT(info.vertex_batches.size(), 1);
+  for (const auto *batches : {&info.edge_batches, &info.vertex_batches}) {
+    for (size_t i = 0; i < batches->size(); ++i) {
+      ASSERT_GT((*batches)[i].count, 0);
+      ASSERT_LE((*batches)[i].count, 100);
+      if (i > 0) ASSERT_GT((*batches)[i].offset, (*batches)[i - 1].offset);
+    }
+  }
+
+  // Recover the snapshot with a single thread.
+  memgraph::storage::Storage store(
+      {.items = {.properties_on_edges = GetParam()},
+       .durability = {.storage_directory = storage_directory, .recover_on_startup = true, .recovery_thread_count = 1}});
+  VerifyDataset(&store, DatasetType::BASE_WITH_EXTENDED, GetParam());
+
+  // Try to use the storage.
+  {
+    auto acc = store.Access();
+    auto vertex = acc.CreateVertex();
+    auto edge = acc.CreateEdge(&vertex, &vertex, store.NameToEdgeType("et"));
+    ASSERT_TRUE(edge.HasValue());
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(DurabilityTest, SnapshotCompression) {
+  // Create snapshot with compressed batches which are written by multiple
+  // threads.
+  {
+    memgraph::storage::Storage store(
+        {.items = {.properties_on_edges = GetParam()},
+         .durability = {.storage_directory = storage_directory,
+                        .snapshot_on_exit = true,
+                        .items_per_batch = 100,
+                        .snapshot_thread_count = 4,
+                        .compression = memgraph::storage::Config::Durability::Compression::ZLIB}});
+    CreateBaseDataset(&store, GetParam());
+    CreateExtendedDataset(&store);
+    VerifyDataset(&store, DatasetType::BASE_WITH_EXTENDED, GetParam());
+  }
+
+  auto snapshots = GetSnapshotsList();
+  ASSERT_EQ(snapshots.size(), 1);
+  auto info = memgraph::storage::durability::ReadSnapshotInfo(*snapshots.begin());
+  ASSERT_GT(info.vertex_batches.size(), 1);
+  ASSERT_LT(std::filesystem::file_size(*snapshots.begin()), info.offset_metadata);
+
+  // Recover the compressed snapshot, the compression is read from the file.
+  memgraph::storage::Storage store(
+      {.items = {.properties_on_edges = GetParam()},
+       .durability = {.storage_directory = storage_directory, .recover_on_startup = true, .recovery_thread_count = 4}});
+  VerifyDataset(&store, DatasetType::BASE_WITH_EXTENDED, GetParam());
+}
+
 // NOLINTNEXTLINE(hicpp-special-member-functions)
 TEST_P(DurabilityTest, SnapshotPeriodic) {
   // Create snapshot.
@@ -922,6 +1040,136 @@ TEST_P(DurabilityTest, SnapshotRetention) {
   }
 }
 
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(DurabilityTest, SnapshotIncremental) {
+  constexpr int64_t kNumVertices = 1000;
+  const memgraph::storage::Config::Durability durability{
+      .storage_directory = storage_directory,
+      .snapshot_wal_mode = memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT,
+      .snapshot_interval = std::chrono::minutes(20),
+      .snapshot_retention_count = 1,
+      .snapshot_incremental_count = 2};
+  std::vector<memgraph::storage::Gid> gids;
+
+  // Create a full snapshot followed by two incremental snapshots.
+  {
+    memgraph::storage::Storage store({.items = {.properties_on_edges = GetParam()}, .durability = durability});
+    const auto id = store.NameToProperty("id");
+    const auto next = store.NameToEdgeType("next");
+    {
+      auto acc = store.Access();
+      std::vector<memgraph::storage::VertexAccessor> vertices;
+      for (int64_t i = 0; i < kNumVertices; ++i) {
+        auto vertex = acc.CreateVertex();
+        ASSERT_TRUE(vertex.SetProperty(id, memgraph::storage::PropertyValue(i)).HasValue());
+        gids.push_back(vertex.Gid());
+        vertices.push_back(vertex);
+      }
+      for (int64_t i = 0; i + 1 < kNumVertices; ++i) {
+        ASSERT_TRUE(acc.CreateEdge(&vertices[i], &vertices[i + 1], next).HasValue());
+      }
+      ASSERT_FALSE(acc.Commit().HasError());
+    }
+    ASSERT_FALSE(store.CreateSnapshot().HasError());
+
+    // Modify a vertex, delete a vertex with its edges and create a new vertex
+    // connected to the last one.
+    {
+      auto acc = store.Access();
+      auto first = acc.FindVertex(gids[0], memgraph::storage::View::OLD);
+      ASSERT_TRUE(first);
+      ASSERT_TRUE(first->SetProperty(id, memgraph::storage::PropertyValue(-1)).HasValue());
+      auto second = acc.FindVertex(gids[1], memgraph::storage::View::OLD);
+      ASSERT_TRUE(second);
+      ASSERT_TRUE(acc.DetachDeleteVertex(&*second).HasValue());
+      auto last = acc.FindVertex(gids.back(), memgraph::storage::View::OLD);
+      ASSERT_TRUE(last);
+      auto vertex = acc.CreateVertex();
+      ASSERT_TRUE(vertex.SetProperty(id, memgraph::storage::PropertyValue(kNumVertices)).HasValue());
+      auto edge = acc.CreateEdge(&*last, &vertex, next);
+      ASSERT_TRUE(edge.HasValue());
+      if (GetParam()) {
+        ASSERT_TRUE(edge->SetProperty(id, memgraph::storage::PropertyValue(kNumVertices)).HasValue());
+      }
+      gids.push_back(vertex.Gid());
+      ASSERT_FALSE(acc.Commit().HasError());
+    }
+    ASSERT_FALSE(store.CreateSnapshot().HasError());
+
+    {
+      auto acc = store.Access();
+      auto third = acc.FindVertex(gids[2], memgraph::storage::View::OLD);
+      ASSERT_TRUE(third);
+      ASSERT_TRUE(third->AddLabel(store.NameToLabel("third")).HasValue());
+      ASSERT_FALSE(acc.Commit().HasError());
+    }
+    ASSERT_FALSE(store.CreateSnapshot().HasError());
+  }
+
+  // The full snapshot is kept because the incremental snapshots are based on
+  // it, even though only a single snapshot should be retained.
+  auto snapshots = GetSnapshotsList();
+  ASSERT_EQ(snapshots.size(), 3);
+  std::vector<memgraph::storage::durability::SnapshotInfo> infos;
+  for (const auto &path : snapshots) {
+    infos.push_back(memgraph::storage::durability::ReadSnapshotInfo(path));
+  }
+  std::sort(infos.begin(), infos.end(),
+            [](const auto &lhs, const auto &rhs) { return lhs.start_timestamp < rhs.start_timestamp; });
+  ASSERT_FALSE(infos[0].incremental);
+  ASSERT_EQ(infos[0].vertices_count, kNumVertices);
+  ASSERT_TRUE(infos[1].incremental);
+  ASSERT_EQ(infos[1].base_timestamp, infos[0].start_timestamp);
+  ASSERT_EQ(infos[1].vertices_count, 4);
+  ASSERT_TRUE(infos[2].incremental);
+  ASSERT_EQ(infos[2].base_timestamp, infos[1].start_timestamp);
+  ASSERT_EQ(infos[2].vertices_count, 1);
+
+  // Recover the chain of snapshots.
+  memgraph::storage::Storage store(
+      {.items = {.properties_on_edges = GetParam()}, .durability = {.storage_directory = storage_directory,
+                                                                    .recover_on_startup = true,
+                                                                    .snapshot_retention_count = 1,
+                                                                    .snapshot_incremental_count = 2}});
+  {
+    auto acc = store.Access();
+    const auto id = store.NameToProperty("id");
+    ASSERT_EQ(acc.ApproximateVertexCount(), kNumVertices);
+    uint64_t edges_count = 0;
+    for (auto vertex : acc.Vertices(memgraph::storage::View::OLD)) {
+      auto out_edges = vertex.OutEdges(memgraph::storage::View::OLD);
+      ASSERT_TRUE(out_edges.HasValue());
+      edges_count += out_edges->size();
+    }
+    ASSERT_EQ(edges_count, kNumVertices - 2);
+    ASSERT_FALSE(acc.FindVertex(gids[1], memgraph::storage::View::OLD));
+    auto first = acc.FindVertex(gids[0], memgraph::storage::View::OLD);
+    ASSERT_TRUE(first);
+    ASSERT_EQ(*first->GetProperty(id, memgraph::storage::View::OLD), memgraph::storage::PropertyValue(-1));
+    ASSERT_EQ(first->OutEdges(memgraph::storage::View::OLD)->size(), 0);
+    auto third = acc.FindVertex(gids[2], memgraph::storage::View::OLD);
+    ASSERT_TRUE(third);
+    ASSERT_TRUE(*third->HasLabel(store.NameToLabel("third"), memgraph::storage::View::OLD));
+    ASSERT_EQ(third->InEdges(memgraph::storage::View::OLD)->size(), 0);
+    auto created = acc.FindVertex(gids.back(), memgraph::storage::View::OLD);
+    ASSERT_TRUE(created);
+    auto in_edges = created->InEdges(memgraph::storage::View::OLD);
+    ASSERT_TRUE(in_edges.HasValue());
+    ASSERT_EQ(in_edges->size(), 1);
+    if (GetParam()) {
+      ASSERT_EQ(*in_edges->front().GetProperty(id, memgraph::storage::View::OLD),
+                memgraph::storage::PropertyValue(kNumVertices));
+    }
+  }
+
+  // The first snapshot after the recovery is a full one, so the old chain
+  // isn't needed anymore.
+  ASSERT_FALSE(store.CreateSnapshot().HasError());
+  snapshots = GetSnapshotsList();
+  ASSERT_EQ(snapshots.size(), 1);
+  ASSERT_FALSE(memgraph::storage::durability::ReadSnapshotInfo(snapshots.front()).incremental);
+}
+
 // NOLINTNEXTLINE(hicpp-special-member-functions)
 TEST_P(DurabilityTest, SnapshotMixedUUID) {
   // Create snapshot.
@@ -1179,6 +1427,149 @@ TEST_P(DurabilityTest, WalBasic) {
   }
 }
 
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(DurabilityTest, WalCompression) {
+  // Create compressed WALs.
+  {
+    memgraph::storage::Storage store(
+        {.items = {.properties_on_edges = GetParam()},
+         .durability = {
+             .storage_directory = storage_directory,
+             .snapshot_wal_mode = memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL,
+             .snapshot_interval = std::chrono::minutes(20),
+             .wal_file_flush_every_n_tx = kFlushWalEvery,
+             .compression = memgraph::storage::Config::Durability::Compression::ZLIB}});
+    CreateBaseDataset(&store, GetParam());
+    CreateExtendedDataset(&store);
+  }
+
+  ASSERT_EQ(GetSnapshotsList().size(), 0);
+  ASSERT_GE(GetWalsList().size(), 1);
+
+  // Recover WALs.
+  {
+    memgraph::storage::Storage store(
+        {.items = {.properties_on_edges = GetParam()},
+         .durability = {
+             .storage_directory = storage_directory,
+             .recover_on_startup = true,
+             .snapshot_wal_mode = memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL,
+             .snapshot_interval = std::chrono::minutes(20),
+             .wal_file_flush_every_n_tx = kFlushWalEvery,
+             .compression = memgraph::storage::Config::Durability::Compression::ZLIB}});
+    VerifyDataset(&store, DatasetType::BASE_WITH_EXTENDED, GetParam());
+
+    // Write more data to a new compressed WAL.
+    auto acc = store.Access();
+    auto vertex = acc.CreateVertex();
+    ASSERT_TRUE(vertex.AddLabel(store.NameToLabel("compressed")).HasValue());
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+
+  // Recover the WALs without compression configured.
+  memgraph::storage::Storage store(
+      {.items = {.properties_on_edges = GetParam()},
+       .durability = {.storage_directory = storage_directory, .recover_on_startup = true}});
+  {
+    auto acc = store.Access();
+    uint64_t count = 0;
+    for (auto vertex : acc.Vertices(memgraph::storage::View::OLD)) {
+      if (*vertex.HasLabel(store.NameToLabel("compressed"), memgraph::storage::View::OLD)) ++count;
+    }
+    ASSERT_EQ(count, 1);
+  }
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(DurabilityTest, SnapshotAndWalAsyncWrites) {
+  // Create a snapshot and WALs using the asynchronous writes.
+  {
+    memgraph::storage::Storage store(
+        {.items = {.properties_on_edges = GetParam()},
+         .durability = {
+             .storage_directory = storage_directory,
+             .snapshot_wal_mode = memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL,
+             .snapshot_interval = std::chrono::minutes(20),
+             .wal_file_flush_every_n_tx = kFlushWalEvery,
+             .snapshot_on_exit = true,
+             .items_per_batch = 100,
+             .snapshot_thread_count = 4,
+             .async_writes = true}});
+    CreateBaseDataset(&store, GetParam());
+    ASSERT_FALSE(store.CreateSnapshot().HasError());
+    CreateExtendedDataset(&store);
+  }
+
+  ASSERT_EQ(GetSnapshotsList().size(), 2);
+  ASSERT_GE(GetWalsList().size(), 1);
+
+  // Recover the newest snapshot.
+  {
+    memgraph::storage::Storage store(
+        {.items = {.properties_on_edges = GetParam()},
+         .durability = {.storage_directory = storage_directory, .recover_on_startup = true}});
+    VerifyDataset(&store, DatasetType::BASE_WITH_EXTENDED, GetParam());
+  }
+
+  // Recover the older snapshot and the WALs.
+  std::filesystem::remove(GetSnapshotsList().front());
+  memgraph::storage::Storage store(
+      {.items = {.properties_on_edges = GetParam()},
+       .durability = {.storage_directory = storage_directory, .recover_on_startup = true}});
+  VerifyDataset(&store, DatasetType::BASE_WITH_EXTENDED, GetParam());
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(DurabilityTest, WalCommitDurability) {
+  constexpr int kNumThreads = 4;
+  constexpr int kNumCommits = 100;
+  using CommitDurability = memgraph::storage::Config::Durability::CommitDurability;
+
+  // Commit concurrently with all of the durabilities.
+  {
+    memgraph::storage::Storage store(
+        {.items = {.properties_on_edges = GetParam()},
+         .durability = {
+             .storage_directory = storage_directory,
+             .snapshot_wal_mode = memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL,
+             .snapshot_interval = std::chrono::minutes(20),
+             .wal_file_flush_every_n_tx = kFlushWalEvery,
+             .commit_durability = CommitDurability::FSYNC_ON_COMMIT,
+             .wal_fsync_interval = std::chrono::milliseconds(1)}});
+    const auto label = store.NameToLabel("durable");
+    std::vector<std::thread> threads;
+    threads.reserve(kNumThreads);
+    for (int i = 0; i < kNumThreads; ++i) {
+      threads.emplace_back([&, i] {
+        const std::array durabilities{std::optional<CommitDurability>{}, std::optional{CommitDurability::ASYNC},
+                                      std::optional{CommitDurability::PERIODIC_FSYNC}};
+        for (int j = 0; j < kNumCommits; ++j) {
+          auto acc = store.Access({}, durabilities[(i + j) % durabilities.size()]);
+          auto vertex = acc.CreateVertex();
+          ASSERT_TRUE(vertex.AddLabel(label).HasValue());
+          ASSERT_FALSE(acc.Commit().HasError());
+        }
+      });
+    }
+    for (auto &thread : threads) thread.join();
+  }
+
+  ASSERT_EQ(GetSnapshotsList().size(), 0);
+  ASSERT_GE(GetWalsList().size(), 1);
+
+  // Recover WALs.
+  memgraph::storage::Storage store(
+      {.items = {.properties_on_edges = GetParam()},
+       .durability = {.storage_directory = storage_directory, .recover_on_startup = true}});
+  auto acc = store.Access();
+  uint64_t count = 0;
+  for (auto vertex : acc.Vertices(memgraph::storage::View::OLD)) {
+    ASSERT_TRUE(*vertex.HasLabel(store.NameToLabel("durable"), memgraph::storage::View::OLD));
+    ++count;
+  }
+  ASSERT_EQ(count, kNumThreads * kNumCommits);
+}
+
 // NOLINTNEXTLINE(hicpp-special-member-functions)
 TEST_P(DurabilityTest, WalBackup) {
   // Create WALs.
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -13,6 +13,7 @@
 #include <gtest/gtest.h>
 
 #include <limits>
+#include <vector>
 
 #include "storage/v2/storage.hpp"
 
@@ -5389,3 +5390,103 @@ TEST(StorageWithProperties, EdgeNonexistentPropertyAPI) {
 
   ASSERT_FALSE(acc.Commit().HasError());
 }
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(StorageEdgeTest, EdgeTypedDegreeAndCount) {
+  memgraph::storage::Storage store({.items = {.properties_on_edges = GetParam()}});
+  auto et1 = store.NameToEdgeType("et1");
+  auto et2 = store.NameToEdgeType("et2");
+  auto et3 = store.NameToEdgeType("et3");
+  memgraph::storage::Gid gid_from = memgraph::storage::Gid::FromUint(std::numeric_limits<uint64_t>::max());
+
+  // Create a vertex with edges of mixed types.
+  {
+    auto acc = store.Access();
+    auto vertex_from = acc.CreateVertex();
+    gid_from = vertex_from.Gid();
+    for (int i = 0; i < 10; ++i) {
+      auto vertex_to = acc.CreateVertex();
+      ASSERT_TRUE(acc.CreateEdge(&vertex_from, &vertex_to, i % 3 == 0 ? et1 : et2).HasValue());
+    }
+    ASSERT_EQ(vertex_from.OutDegree(memgraph::storage::View::OLD, {et1}).GetError(),
+              memgraph::storage::Error::NONEXISTENT_OBJECT);
+    ASSERT_EQ(*vertex_from.OutDegree(memgraph::storage::View::NEW, {et1}), 4);
+    ASSERT_EQ(*vertex_from.OutDegree(memgraph::storage::View::NEW, {et2}), 6);
+    ASSERT_EQ(*vertex_from.OutDegree(memgraph::storage::View::NEW, {et1, et2, et1}), 10);
+    ASSERT_EQ(*vertex_from.OutDegree(memgraph::storage::View::NEW, {et3}), 0);
+    ASSERT_EQ(vertex_from.OutEdges(memgraph::storage::View::NEW, {et1, et1})->size(), 4);
+    ASSERT_EQ(acc.ApproximateEdgeCount(et1), 4);
+    ASSERT_EQ(acc.ApproximateEdgeCount(et2), 6);
+    ASSERT_EQ(acc.ApproximateEdgeCount(et3), 0);
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+
+  // Delete the edges of a single type and abort.
+  {
+    auto acc = store.Access();
+    auto vertex_from = acc.FindVertex(gid_from, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex_from);
+    auto edges = vertex_from->OutEdges(memgraph::storage::View::OLD, {et2});
+    ASSERT_TRUE(edges.HasValue());
+    for (auto &edge : *edges) {
+      ASSERT_TRUE(acc.DeleteEdge(&edge).HasValue());
+    }
+    ASSERT_EQ(*vertex_from->OutDegree(memgraph::storage::View::OLD, {et2}), 6);
+    ASSERT_EQ(*vertex_from->OutDegree(memgraph::storage::View::NEW, {et2}), 0);
+    ASSERT_EQ(*vertex_from->OutDegree(memgraph::storage::View::NEW, {et1}), 4);
+    ASSERT_EQ(acc.ApproximateEdgeCount(et2), 0);
+    acc.Abort();
+  }
+
+  {
+    auto acc = store.Access();
+    auto vertex_from = acc.FindVertex(gid_from, memgraph::storage::View::OLD);
+    ASSERT_TRUE(vertex_from);
+    ASSERT_EQ(*vertex_from->OutDegree(memgraph::storage::View::OLD, {et2}), 6);
+    ASSERT_EQ(acc.ApproximateEdgeCount(et1), 4);
+    ASSERT_EQ(acc.ApproximateEdgeCount(et2), 6);
+  }
+
+  // The edges of another transaction are counted once it commits.
+  {
+    auto acc1 = store.Access();
+    auto acc2 = store.Access();
+    auto vertex_from = acc1.CreateVertex();
+    auto vertex_to = acc1.CreateVertex();
+    ASSERT_TRUE(acc1.CreateEdge(&vertex_from, &vertex_to, et3).HasValue());
+    ASSERT_EQ(acc1.ApproximateEdgeCount(et3), 1);
+    ASSERT_EQ(acc2.ApproximateEdgeCount(et3), 0);
+    ASSERT_FALSE(acc1.Commit().HasError());
+    ASSERT_EQ(acc2.ApproximateEdgeCount(et3), 1);
+  }
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_P(StorageEdgeTest, AverageVertexFootprint) {
+  memgraph::storage::Storage store({.items = {.properties_on_edges = GetParam()}});
+  std::vector<memgraph::storage::Gid> gids;
+  {
+    auto acc = store.Access();
+    for (int i = 0; i < 101; ++i) gids.push_back(acc.CreateVertex().Gid());
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+  EXPECT_EQ(store.GetInfo().average_vertex_footprint, sizeof(memgraph::storage::Vertex));
+
+  // The hub keeps its 100 out edges in an array of capacity 128 while each
+  // other vertex keeps its single in edge inline.
+  {
+    auto acc = store.Access();
+    auto et = acc.NameToEdgeType("et");
+    auto hub = acc.FindVertex(gids[0], memgraph::storage::View::OLD);
+    ASSERT_TRUE(hub);
+    for (size_t i = 1; i < gids.size(); ++i) {
+      auto vertex = acc.FindVertex(gids[i], memgraph::storage::View::OLD);
+      ASSERT_TRUE(vertex);
+      ASSERT_TRUE(acc.CreateEdge(&*hub, &*vertex, et).HasValue());
+    }
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+  const uint64_t total_bytes =
+      gids.size() * sizeof(memgraph::storage::Vertex) + 128 * sizeof(memgraph::storage::EdgeList::Entry);
+  EXPECT_EQ(store.GetInfo().average_vertex_footprint, total_bytes / gids.size());
+}
@@ -0,0 +1,256 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <new>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "storage/v2/edge_list.hpp"
+
+using memgraph::storage::EdgeList;
+using memgraph::storage::EdgeRef;
+using memgraph::storage::EdgeTypeId;
+using memgraph::storage::Gid;
+using memgraph::storage::Vertex;
+using testing::UnorderedElementsAreArray;
+
+namespace {
+Vertex *FakeVertex(uint64_t id) { return reinterpret_cast<Vertex *>((id + 1) * alignof(uint64_t)); }
+
+std::vector<EdgeList::Item> Items(const EdgeList &list) { return {list.begin(), list.end()}; }
+
+// While the arena is enabled, all allocations are placed back-to-back in it so
+// that the arrays of an `EdgeList` are adjacent in memory. The memory of the
+// arena is never freed.
+struct Arena {
+  alignas(std::max_align_t) std::byte data[1U << 20U];
+  size_t used{0};
+  bool enabled{false};
+
+  bool Contains(const void *ptr) const { return ptr >= data && ptr < data + sizeof(data); }
+} arena;
+}  // namespace
+
+void *operator new(size_t size) {
+  if (arena.enabled) {
+    constexpr size_t kAlignment = alignof(std::max_align_t);
+    auto *ptr = arena.data + arena.used;
+    arena.used += (size + kAlignment - 1) / kAlignment * kAlignment;
+    if (arena.used > sizeof(arena.data)) throw std::bad_alloc();
+    return ptr;
+  }
+  if (auto *ptr = std::malloc(size)) return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept {
+  if (!arena.Contains(ptr)) std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept { operator delete(ptr); }
+
+TEST(EdgeList, Empty) {
+  EdgeList list;
+  ASSERT_TRUE(list.empty());
+  ASSERT_EQ(list.size(), 0);
+  ASSERT_EQ(list.begin(), list.end());
+  ASSERT_EQ(list.HeapSize(), 0);
+  ASSERT_FALSE(list.Remove(EdgeTypeId::FromUint(1), FakeVertex(1), EdgeRef(Gid::FromUint(1))));
+}
+
+TEST(EdgeList, SingleEdgeIsInline) {
+  EdgeList list;
+  list.Add(EdgeTypeId::FromUint(5), FakeVertex(1), EdgeRef(Gid::FromUint(10)));
+  ASSERT_EQ(list.size(), 1);
+  ASSERT_EQ(list.HeapSize(), 0);
+  ASSERT_TRUE(list.Contains(EdgeTypeId::FromUint(5), FakeVertex(1), EdgeRef(Gid::FromUint(10))));
+  ASSERT_FALSE(list.Contains(EdgeTypeId::FromUint(6), FakeVertex(1), EdgeRef(Gid::FromUint(10))));
+  ASSERT_THAT(Items(list), UnorderedElementsAreArray(std::vector<EdgeList::Item>{
+                               {EdgeTypeId::FromUint(5), FakeVertex(1), EdgeRef(Gid::FromUint(10))}}));
+  ASSERT_TRUE(list.Remove(EdgeTypeId::FromUint(5), FakeVertex(1), EdgeRef(Gid::FromUint(10))));
+  ASSERT_TRUE(list.empty());
+}
+
+TEST(EdgeList, MultipleTypes) {
+  EdgeList list;
+  std::vector<EdgeList::Item> expected;
+  for (uint64_t i = 0; i < 100; ++i) {
+    EdgeList::Item item{EdgeTypeId::FromUint(i % 3), FakeVertex(i), EdgeRef(Gid::FromUint(i))};
+    list.Add(std::get<0>(item), std::get<1>(item), std::get<2>(item));
+    expected.push_back(item);
+  }
+  ASSERT_EQ(list.size(), expected.size());
+  ASSERT_THAT(Items(list), UnorderedElementsAreArray(expected));
+
+  // Remove all edges of a single type so that a group disappears.
+  for (auto it = expected.begin(); it != expected.end();) {
+    if (std::get<0>(*it) == EdgeTypeId::FromUint(1)) {
+      ASSERT_TRUE(list.Remove(std::get<0>(*it), std::get<1>(*it), std::get<2>(*it)));
+      it = expected.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  ASSERT_EQ(list.size(), expected.size());
+  ASSERT_THAT(Items(list), UnorderedElementsAreArray(expected));
+}
+
+TEST(EdgeList, RandomOperations) {
+  std::mt19937 gen(42);
+  EdgeList list;
+  std::vector<EdgeList::Item> expected;
+  for (uint64_t i = 0; i < 10000; ++i) {
+    if (expected.empty() || gen() % 3 != 0) {
+      EdgeList::Item item{EdgeTypeId::FromUint(gen() % 5), FakeVertex(gen() % 20), EdgeRef(Gid::FromUint(i))};
+      list.Add(std::get<0>(item), std::get<1>(item), std::get<2>(item));
+      expected.push_back(item);
+    } else {
+      auto pos = gen() % expected.size();
+      auto [edge_type, vertex, edge] = expected[pos];
+      ASSERT_TRUE(list.Contains(edge_type, vertex, edge));
+      ASSERT_TRUE(list.Remove(edge_type, vertex, edge));
+      ASSERT_FALSE(list.Contains(edge_type, vertex, edge));
+      expected.erase(expected.begin() + pos);
+    }
+    ASSERT_EQ(list.size(), expected.size());
+  }
+  ASSERT_THAT(Items(list), UnorderedElementsAreArray(expected));
+}
+
+TEST(EdgeList, Move) {
+  EdgeList list;
+  for (uint64_t i = 0; i < 10; ++i) {
+    list.Add(EdgeTypeId::FromUint(i % 2), FakeVertex(i), EdgeRef(Gid::FromUint(i)));
+  }
+  auto expected = Items(list);
+  EdgeList moved(std::move(list));
+  ASSERT_EQ(moved.size(), 10);
+  ASSERT_THAT(Items(moved), UnorderedElementsAreArray(expected));
+  EdgeList assigned;
+  assigned.Add(EdgeTypeId::FromUint(7), FakeVertex(7), EdgeRef(Gid::FromUint(7)));
+  assigned = std::move(moved);
+  ASSERT_THAT(Items(assigned), UnorderedElementsAreArray(expected));
+}
+
+TEST(EdgeList, EdgesOfType) {
+  EdgeList list;
+  std::vector<EdgeList::Item> expected;
+  // The edge types are added in a descending order to check that the groups
+  // are kept sorted.
+  for (uint64_t i = 0; i < 60; ++i) {
+    EdgeList::Item item{EdgeTypeId::FromUint(10 - i % 4), FakeVertex(i), EdgeRef(Gid::FromUint(i))};
+    list.Add(std::get<0>(item), std::get<1>(item), std::get<2>(item));
+    expected.push_back(item);
+  }
+  for (uint64_t edge_type = 6; edge_type <= 11; ++edge_type) {
+    std::vector<EdgeList::Item> of_type;
+    std::copy_if(expected.begin(), expected.end(), std::back_inserter(of_type),
+                 [&](const auto &item) { return std::get<0>(item) == EdgeTypeId::FromUint(edge_type); });
+    auto range = list.EdgesOfType(EdgeTypeId::FromUint(edge_type));
+    ASSERT_THAT(std::vector<EdgeList::Item>(range.begin(), range.end()), UnorderedElementsAreArray(of_type));
+    ASSERT_EQ(list.Degree(EdgeTypeId::FromUint(edge_type)), of_type.size());
+  }
+  auto items = Items(list);
+  ASSERT_TRUE(std::is_sorted(items.begin(), items.end(),
+                             [](const auto &a, const auto &b) { return std::get<0>(a) < std::get<0>(b); }));
+}
+
+TEST(EdgeList, ForEachEdgeType) {
+  auto degrees = [](const EdgeList &list) {
+    std::vector<std::pair<EdgeTypeId, size_t>> ret;
+    list.ForEachEdgeType([&](EdgeTypeId edge_type, size_t degree) { ret.emplace_back(edge_type, degree); });
+    return ret;
+  };
+  EdgeList list;
+  ASSERT_TRUE(degrees(list).empty());
+  list.Add(EdgeTypeId::FromUint(3), FakeVertex(0), EdgeRef(Gid::FromUint(0)));
+  ASSERT_EQ(degrees(list), (std::vector<std::pair<EdgeTypeId, size_t>>{{EdgeTypeId::FromUint(3), 1}}));
+  list.Add(EdgeTypeId::FromUint(3), FakeVertex(1), EdgeRef(Gid::FromUint(1)));
+  ASSERT_EQ(degrees(list), (std::vector<std::pair<EdgeTypeId, size_t>>{{EdgeTypeId::FromUint(3), 2}}));
+  for (uint64_t i = 2; i < 10; ++i) {
+    list.Add(EdgeTypeId::FromUint(i % 2), FakeVertex(i), EdgeRef(Gid::FromUint(i)));
+  }
+  ASSERT_EQ(degrees(list), (std::vector<std::pair<EdgeTypeId, size_t>>{{EdgeTypeId::FromUint(0), 4},
+                                                                        {EdgeTypeId::FromUint(1), 4},
+                                                                        {EdgeTypeId::FromUint(3), 2}}));
+}
+
+TEST(EdgeList, AdjacentGroupArrays) {
+  EdgeList list;
+  std::vector<EdgeList::Item> expected;
+  auto add = [&](uint64_t edge_type, uint64_t id) {
+    EdgeList::Item item{EdgeTypeId::FromUint(edge_type), FakeVertex(id), EdgeRef(Gid::FromUint(id))};
+    list.Add(std::get<0>(item), std::get<1>(item), std::get<2>(item));
+    expected.push_back(item);
+  };
+  add(5, 1);
+  arena.used = 0;
+  arena.enabled = true;
+  // The array of the first edge is allocated right before the array of the
+  // second edge, whose group is first because its edge type is smaller. So the
+  // end of the last group's array is the start of the first group's array.
+  add(3, 2);
+  arena.enabled = false;
+  ASSERT_EQ(list.size(), 2);
+  ASSERT_THAT(Items(list), UnorderedElementsAreArray(expected));
+
+  arena.enabled = true;
+  add(4, 3);
+  add(3, 4);
+  arena.enabled = false;
+  ASSERT_EQ(list.size(), 4);
+  ASSERT_THAT(Items(list), UnorderedElementsAreArray(expected));
+}
+
+TEST(EdgeList, MixedTypeAddRemove) {
+  constexpr uint64_t kEdgeTypes = 5;
+  for (bool ascending : {true, false}) {
+    for (bool use_arena : {false, true}) {
+      std::mt19937 gen(42);
+      EdgeList list;
+      std::vector<EdgeList::Item> expected;
+      expected.reserve(1000);
+      arena.used = 0;
+      arena.enabled = use_arena;
+      for (uint64_t round = 0, id = 0; round < 20; ++round) {
+        // Each round adds an edge of every type, in the ascending or the
+        // descending order of the types, and then removes half of the edges.
+        for (uint64_t i = 0; i < kEdgeTypes; ++i, ++id) {
+          auto edge_type = EdgeTypeId::FromUint(ascending ? i : kEdgeTypes - 1 - i);
+          list.Add(edge_type, FakeVertex(id), EdgeRef(Gid::FromUint(id)));
+          expected.emplace_back(edge_type, FakeVertex(id), EdgeRef(Gid::FromUint(id)));
+        }
+        for (auto to_remove = expected.size() / 2; to_remove > 0; --to_remove) {
+          auto pos = gen() % expected.size();
+          auto [edge_type, vertex, edge] = expected[pos];
+          ASSERT_TRUE(list.Remove(edge_type, vertex, edge));
+          expected.erase(expected.begin() + pos);
+        }
+        size_t degrees = 0;
+        for (uint64_t edge_type = 0; edge_type < kEdgeTypes; ++edge_type) {
+          degrees += list.Degree(EdgeTypeId::FromUint(edge_type));
+        }
+        ASSERT_EQ(std::distance(list.begin(), list.end()), degrees);
+        ASSERT_EQ(degrees, list.size());
+        ASSERT_THAT(Items(list), UnorderedElementsAreArray(expected));
+      }
+      arena.enabled = false;
+    }
+  }
+}
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -12,6 +12,10 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <functional>
+#include <thread>
+
 #include "storage/v2/storage.hpp"
 
 using testing::UnorderedElementsAre;
@@ -198,3 +202,212 @@ TEST(StorageV2Gc, Indices) {
     EXPECT_EQ(gids.size(), 1000);
   }
 }
+
+// Runs the GC with multiple threads on many small transactions which update
+// the same vertices and verifies that the deltas, the indices and the deleted
+// objects are all cleaned up.
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(StorageV2Gc, Parallel) {
+  memgraph::storage::Storage storage(
+      memgraph::storage::Config{.gc = {.type = memgraph::storage::Config::Gc::Type::NONE, .num_threads = 4}});
+  const auto label = storage.NameToLabel("label");
+  const auto property = storage.NameToProperty("property");
+  const auto edge_type = storage.NameToEdgeType("edge_type");
+  ASSERT_FALSE(storage.CreateIndex(label).HasError());
+  ASSERT_FALSE(storage.CreateIndex(label, property).HasError());
+
+  std::vector<memgraph::storage::Gid> vertices;
+  for (uint64_t i = 0; i < 100; ++i) {
+    auto acc = storage.Access();
+    for (uint64_t j = 0; j < 50; ++j) {
+      auto vertex = acc.CreateVertex();
+      ASSERT_TRUE(*vertex.AddLabel(label));
+      vertices.push_back(vertex.Gid());
+    }
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+  // Each vertex is updated by a number of transactions, so the version chains
+  // hold the deltas of different transactions.
+  for (int64_t round = 0; round < 5; ++round) {
+    for (uint64_t i = 0; i < vertices.size(); i += 50) {
+      auto acc = storage.Access();
+      for (uint64_t j = i; j < i + 50; ++j) {
+        auto vertex = acc.FindVertex(vertices[j], memgraph::storage::View::OLD);
+        ASSERT_TRUE(vertex);
+        ASSERT_TRUE(vertex->SetProperty(property, memgraph::storage::PropertyValue(round)).HasValue());
+        if (round == 0 && j + 1 < i + 50) {
+          auto to = acc.FindVertex(vertices[j + 1], memgraph::storage::View::OLD);
+          ASSERT_TRUE(to);
+          ASSERT_TRUE(acc.CreateEdge(&*vertex, &*to, edge_type).HasValue());
+        }
+      }
+      ASSERT_FALSE(acc.Commit().HasError());
+    }
+  }
+  // Every second vertex is deleted together with its edges.
+  for (uint64_t i = 0; i < vertices.size(); i += 50) {
+    auto acc = storage.Access();
+    for (uint64_t j = i; j < i + 50; j += 2) {
+      auto vertex = acc.FindVertex(vertices[j], memgraph::storage::View::OLD);
+      ASSERT_TRUE(vertex);
+      ASSERT_TRUE(acc.DetachDeleteVertex(&*vertex).HasValue());
+    }
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+
+  // The deleted objects are known to the GC only once the deltas of the
+  // transactions are unlinked.
+  auto info = storage.GetInfo();
+  EXPECT_EQ(info.gc.runs, 0);
+  EXPECT_EQ(info.gc.pending_transactions, 100 + 5 * 100 + 100);
+  EXPECT_EQ(info.gc.pending_vertices, 0);
+
+  storage.FreeMemory();
+
+  info = storage.GetInfo();
+  EXPECT_EQ(info.vertex_count, vertices.size() / 2);
+  EXPECT_EQ(info.edge_count, 0);
+  EXPECT_EQ(info.gc.runs, 1);
+  EXPECT_EQ(info.gc.pending_transactions, 0);
+  EXPECT_EQ(info.gc.pending_undo_buffers, 0);
+  EXPECT_EQ(info.gc.pending_vertices, 0);
+  EXPECT_EQ(info.gc.pending_edges, 0);
+
+  auto acc = storage.Access();
+  EXPECT_EQ(acc.ApproximateVertexCount(label), vertices.size() / 2);
+  EXPECT_EQ(acc.ApproximateVertexCount(label, property), vertices.size() / 2);
+  uint64_t count = 0;
+  for (auto vertex : acc.Vertices(label, property, memgraph::storage::PropertyValue(4), memgraph::storage::View::OLD)) {
+    EXPECT_EQ(vertex.Gid().AsUint() % 2, 1);
+    EXPECT_EQ(*vertex.OutDegree(memgraph::storage::View::OLD), 0);
+    ++count;
+  }
+  EXPECT_EQ(count, vertices.size() / 2);
+}
+
+// Verifies that the memory of the deleted vertices is returned once they are
+// freed.
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(StorageV2Gc, ObjectMemory) {
+  memgraph::storage::Storage storage(
+      memgraph::storage::Config{.gc = {.type = memgraph::storage::Config::Gc::Type::NONE}});
+  const auto initial = storage.GetInfo().object_memory;
+  {
+    auto acc = storage.Access();
+    for (uint64_t i = 0; i < 20000; ++i) acc.CreateVertex();
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+  auto object_memory = storage.GetInfo().object_memory;
+  EXPECT_GE(object_memory.allocated_bytes, initial.allocated_bytes + 20000 * sizeof(memgraph::storage::Vertex));
+  EXPECT_GE(object_memory.reserved_bytes, object_memory.allocated_bytes);
+  EXPECT_LT(object_memory.Fragmentation(), 0.5);
+
+  {
+    auto acc = storage.Access();
+    for (auto vertex : acc.Vertices(memgraph::storage::View::OLD)) {
+      ASSERT_TRUE(acc.DeleteVertex(&vertex).HasValue());
+    }
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+  storage.FreeMemory();
+  // The skip list nodes are freed only once all accessors which could have
+  // seen them are gone, which is known after newer accessors are released.
+  for (int i = 0; i < 2; ++i) {
+    auto acc = storage.Access();
+    for (auto vertex : acc.Vertices(memgraph::storage::View::OLD)) {
+      FAIL() << "Vertex " << vertex.Gid().AsUint() << " wasn't deleted";
+    }
+  }
+  storage.FreeMemory();
+
+  object_memory = storage.GetInfo().object_memory;
+  EXPECT_EQ(object_memory.allocated_bytes, initial.allocated_bytes);
+  EXPECT_EQ(object_memory.reserved_bytes, initial.reserved_bytes);
+  EXPECT_GT(object_memory.released_slabs, 0);
+}
+
+namespace {
+// Waits for at most 10 seconds until the condition holds.
+bool WaitFor(const std::function<bool()> &condition) {
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!condition()) {
+    if (std::chrono::steady_clock::now() > deadline) return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return true;
+}
+
+void CreateVertices(memgraph::storage::Storage *storage, uint64_t num_transactions, uint64_t num_vertices) {
+  for (uint64_t i = 0; i < num_transactions; ++i) {
+    auto acc = storage->Access();
+    for (uint64_t j = 0; j < num_vertices; ++j) acc.CreateVertex();
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+}
+
+// Adaptive GC with a long interval and all of the triggers disabled.
+memgraph::storage::Config AdaptiveGcConfig() {
+  return {.gc = {.type = memgraph::storage::Config::Gc::Type::ADAPTIVE,
+                 .interval = std::chrono::hours(1),
+                 .max_interval = std::chrono::hours(1),
+                 .trigger_transactions = 0,
+                 .trigger_delta_bytes = 0,
+                 .trigger_memory_ratio = 0.0}};
+}
+}  // namespace
+
+// The adaptive GC runs as soon as one of its triggers is reached, even though
+// its interval is long.
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(StorageV2Gc, AdaptiveTriggers) {
+  {
+    auto config = AdaptiveGcConfig();
+    config.gc.trigger_transactions = 10;
+    memgraph::storage::Storage storage(config);
+    CreateVertices(&storage, 9, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(storage.GetInfo().gc.runs, 0);
+    CreateVertices(&storage, 1, 1);
+    ASSERT_TRUE(WaitFor([&] { return storage.GetInfo().gc.transactions_triggers == 1; }));
+    auto info = storage.GetInfo();
+    EXPECT_EQ(info.gc.runs, 1);
+    EXPECT_EQ(info.gc.interval_triggers, 0);
+    EXPECT_EQ(info.gc.pending_transactions, 0);
+    EXPECT_EQ(info.gc.pending_delta_bytes, 0);
+  }
+  {
+    auto config = AdaptiveGcConfig();
+    config.gc.trigger_delta_bytes = 100 * sizeof(memgraph::storage::Delta);
+    memgraph::storage::Storage storage(config);
+    CreateVertices(&storage, 1, 99);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    auto info = storage.GetInfo();
+    EXPECT_EQ(info.gc.runs, 0);
+    EXPECT_EQ(info.gc.pending_delta_bytes, 99 * sizeof(memgraph::storage::Delta));
+    CreateVertices(&storage, 1, 1);
+    ASSERT_TRUE(WaitFor([&] { return storage.GetInfo().gc.delta_bytes_triggers == 1; }));
+    info = storage.GetInfo();
+    EXPECT_EQ(info.gc.transactions_triggers, 0);
+    EXPECT_EQ(info.gc.pending_delta_bytes, 0);
+  }
+}
+
+// The interval of the adaptive GC grows while there is nothing to collect and
+// it is reset once there is.
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(StorageV2Gc, AdaptiveBackoff) {
+  memgraph::storage::Storage storage(
+      memgraph::storage::Config{.gc = {.type = memgraph::storage::Config::Gc::Type::ADAPTIVE,
+                                       .interval = std::chrono::milliseconds(20),
+                                       .max_interval = std::chrono::milliseconds(80)}});
+  EXPECT_EQ(storage.GetInfo().gc.interval, std::chrono::milliseconds(20));
+  ASSERT_TRUE(WaitFor([&] { return storage.GetInfo().gc.interval == std::chrono::milliseconds(80); }));
+  EXPECT_EQ(storage.GetInfo().gc.runs, 0);
+
+  CreateVertices(&storage, 1, 1);
+  ASSERT_TRUE(WaitFor([&] { return storage.GetInfo().gc.runs == 1; }));
+  auto info = storage.GetInfo();
+  EXPECT_EQ(info.gc.pending_transactions, 0);
+  EXPECT_GE(info.gc.interval_triggers, 3);
+  EXPECT_EQ(info.gc.transactions_triggers, 0);
+}
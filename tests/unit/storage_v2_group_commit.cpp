@@ -0,0 +1,118 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "storage/v2/durability/group_commit.hpp"
+
+using memgraph::storage::durability::GroupCommit;
+
+TEST(GroupCommit, SingleTransaction) {
+  GroupCommit group_commit;
+  const auto seq_num = group_commit.Register();
+  ASSERT_EQ(seq_num, 1);
+  ASSERT_EQ(group_commit.LastRegistered(), 1);
+  ASSERT_EQ(group_commit.LastDurable(), 0);
+
+  uint64_t syncs = 0;
+  group_commit.WaitDurable(seq_num, [&] {
+    ++syncs;
+    return group_commit.LastRegistered();
+  });
+  ASSERT_EQ(syncs, 1);
+  ASSERT_EQ(group_commit.LastDurable(), 1);
+  ASSERT_EQ(group_commit.SyncCount(), 1);
+
+  // A durable transaction doesn't sync again.
+  group_commit.WaitDurable(seq_num, [&] {
+    ++syncs;
+    return group_commit.LastRegistered();
+  });
+  ASSERT_EQ(syncs, 1);
+}
+
+TEST(GroupCommit, MarkDurable) {
+  GroupCommit group_commit;
+  for (int i = 0; i < 10; ++i) group_commit.Register();
+  group_commit.MarkDurable(7);
+  ASSERT_EQ(group_commit.LastDurable(), 7);
+  // The durable sequence number never goes back.
+  group_commit.MarkDurable(3);
+  ASSERT_EQ(group_commit.LastDurable(), 7);
+
+  group_commit.WaitDurable(5, [] {
+    ADD_FAILURE() << "The transaction is already durable!";
+    return 0;
+  });
+  ASSERT_EQ(group_commit.SyncCount(), 0);
+}
+
+TEST(GroupCommit, ConcurrentCommitsShareSyncs) {
+  constexpr int kNumThreads = 8;
+  constexpr int kNumCommits = 200;
+  GroupCommit group_commit;
+  std::mutex append_lock;
+  std::atomic<uint64_t> syncs{0};
+
+  auto sync = [&] {
+    uint64_t seq_num = 0;
+    {
+      std::lock_guard guard(append_lock);
+      seq_num = group_commit.LastRegistered();
+    }
+    // Simulate the latency of the sync so that the other threads register
+    // their transactions in the meantime.
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    syncs.fetch_add(1);
+    return seq_num;
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(kNumThreads);
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 0; j < kNumCommits; ++j) {
+        uint64_t seq_num = 0;
+        {
+          std::lock_guard guard(append_lock);
+          seq_num = group_commit.Register();
+        }
+        group_commit.WaitDurable(seq_num, sync);
+        ASSERT_GE(group_commit.LastDurable(), seq_num);
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+
+  ASSERT_EQ(group_commit.LastRegistered(), kNumThreads * kNumCommits);
+  ASSERT_EQ(group_commit.LastDurable(), kNumThreads * kNumCommits);
+  ASSERT_EQ(group_commit.SyncCount(), syncs.load());
+  // The commits which wait for the same leader are synced together.
+  ASSERT_LT(syncs.load(), kNumThreads * kNumCommits);
+}
+
+TEST(GroupCommit, FailedSyncReleasesLeader) {
+  GroupCommit group_commit;
+  const auto seq_num = group_commit.Register();
+  ASSERT_THROW(group_commit.WaitDurable(seq_num, []() -> uint64_t { throw std::runtime_error("sync failed"); }),
+               std::runtime_error);
+  ASSERT_EQ(group_commit.LastDurable(), 0);
+  // The next waiter becomes the leader.
+  group_commit.WaitDurable(seq_num, [&] { return group_commit.LastRegistered(); });
+  ASSERT_EQ(group_commit.LastDurable(), seq_num);
+}
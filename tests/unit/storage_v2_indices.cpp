@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -12,6 +12,10 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <thread>
+#include <variant>
+
 #include "storage/v2/property_value.hpp"
 #include "storage/v2/storage.hpp"
 #include "storage/v2/temporal.hpp"
@@ -21,6 +25,7 @@ using namespace memgraph::storage;
 
 using testing::IsEmpty;
 using testing::UnorderedElementsAre;
+using testing::UnorderedElementsAreArray;
 
 // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
 #define ASSERT_NO_ERROR(result) ASSERT_FALSE((result).HasError())
@@ -326,6 +331,48 @@ TEST_F(IndexTest, LabelIndexDuplicateVersions) {
   }
 }
 
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(IndexTest, LabelIndexChunks) {
+  // Each vertex gets a few entries in the index, which can be split between
+  // the chunks. Every vertex has to be scanned exactly once.
+  EXPECT_FALSE(storage.CreateIndex(label1).HasError());
+  std::vector<int64_t> expected;
+  {
+    auto acc = storage.Access();
+    for (int i = 0; i < 1000; ++i) {
+      auto vertex = CreateVertex(&acc);
+      if (i % 4 == 0) continue;
+      ASSERT_NO_ERROR(vertex.AddLabel(label1));
+      expected.push_back(i);
+    }
+    ASSERT_NO_ERROR(acc.Commit());
+  }
+  for (int i = 0; i < 3; ++i) {
+    auto acc = storage.Access();
+    for (auto vertex : acc.Vertices(label1, View::OLD)) {
+      ASSERT_NO_ERROR(vertex.RemoveLabel(label1));
+      ASSERT_NO_ERROR(vertex.AddLabel(label1));
+    }
+    ASSERT_NO_ERROR(acc.Commit());
+  }
+
+  auto acc = storage.Access();
+  auto get_ids = [this](const VertexChunks &chunks) {
+    std::vector<int64_t> ret;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+      auto scanner = chunks.Scan(i);
+      while (auto vertex = scanner.Next()) ret.push_back(vertex->GetProperty(prop_id, View::OLD)->ValueInt());
+    }
+    return ret;
+  };
+  for (uint64_t num_chunks : {1, 3, 16, 100}) {
+    auto chunks = acc.ChunkVertices(label1, View::OLD, num_chunks);
+    EXPECT_LE(chunks.size(), num_chunks);
+    EXPECT_THAT(get_ids(chunks), UnorderedElementsAreArray(expected));
+    EXPECT_EQ(get_ids(acc.ChunkVertices(View::OLD, num_chunks)).size(), 1000);
+  }
+}
+
 // NOLINTNEXTLINE(hicpp-special-member-functions)
 TEST_F(IndexTest, LabelIndexTransactionalIsolation) {
   // Check that transactions only see entries they are supposed to see.
@@ -830,3 +877,421 @@ TEST_F(IndexTest, LabelPropertyIndexMixedIteration) {
   // Iteration without any bounds should return all items of the index.
   verify(std::nullopt, std::nullopt, values);
 }
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(IndexTest, LabelPropertyCompositeIndexCreateAndDrop) {
+  const std::vector<PropertyId> properties{prop_val, prop_id};
+  EXPECT_EQ(storage.ListAllIndices().label_property_composite.size(), 0);
+  EXPECT_FALSE(storage.CreateIndex(label1, properties).HasError());
+  {
+    auto acc = storage.Access();
+    EXPECT_TRUE(acc.LabelPropertyCompositeIndexExists(label1, properties));
+    EXPECT_FALSE(acc.LabelPropertyCompositeIndexExists(label1, {prop_id, prop_val}));
+    EXPECT_FALSE(acc.LabelPropertyCompositeIndexExists(label2, properties));
+    EXPECT_THAT(acc.LabelPropertyCompositeIndices(label1), UnorderedElementsAre(properties));
+  }
+  EXPECT_THAT(storage.ListAllIndices().label_property_composite,
+              UnorderedElementsAre(std::make_pair(label1, properties)));
+
+  // The order of the properties matters.
+  EXPECT_TRUE(storage.CreateIndex(label1, properties).HasError());
+  EXPECT_FALSE(storage.CreateIndex(label1, std::vector<PropertyId>{prop_id, prop_val}).HasError());
+
+  // Composite indices need at least two distinct properties.
+  EXPECT_TRUE(storage.CreateIndex(label2, std::vector<PropertyId>{prop_id}).HasError());
+  EXPECT_TRUE(storage.CreateIndex(label2, std::vector<PropertyId>{prop_id, prop_id}).HasError());
+
+  EXPECT_FALSE(storage.DropIndex(label1, properties).HasError());
+  EXPECT_TRUE(storage.DropIndex(label1, properties).HasError());
+  {
+    auto acc = storage.Access();
+    EXPECT_FALSE(acc.LabelPropertyCompositeIndexExists(label1, properties));
+  }
+  EXPECT_THAT(storage.ListAllIndices().label_property_composite,
+              UnorderedElementsAre(std::make_pair(label1, std::vector<PropertyId>{prop_id, prop_val})));
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(IndexTest, LabelPropertyCompositeIndexBasic) {
+  const std::vector<PropertyId> properties{prop_val, prop_id};
+  EXPECT_FALSE(storage.CreateIndex(label1, properties).HasError());
+
+  {
+    auto acc = storage.Access();
+    for (int i = 0; i < 10; ++i) {
+      auto vertex = CreateVertex(&acc);
+      ASSERT_NO_ERROR(vertex.AddLabel(i % 2 ? label1 : label2));
+      ASSERT_NO_ERROR(vertex.SetProperty(prop_val, PropertyValue(i % 3)));
+    }
+    // A vertex without all of the properties isn't indexed.
+    auto vertex = acc.CreateVertex();
+    ASSERT_NO_ERROR(vertex.AddLabel(label1));
+    ASSERT_NO_ERROR(vertex.SetProperty(prop_val, PropertyValue(0)));
+
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {}, std::nullopt, std::nullopt, View::OLD), View::OLD),
+                IsEmpty());
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {}, std::nullopt, std::nullopt, View::NEW), View::NEW),
+                UnorderedElementsAre(1, 3, 5, 7, 9));
+    ASSERT_NO_ERROR(acc.Commit());
+  }
+
+  {
+    auto acc = storage.Access();
+    // Equality on the whole key.
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {PropertyValue(0), PropertyValue(3)}, std::nullopt,
+                                    std::nullopt, View::OLD)),
+                UnorderedElementsAre(3));
+    // Equality on the first property.
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {PropertyValue(1)}, std::nullopt, std::nullopt, View::OLD)),
+                UnorderedElementsAre(1, 7));
+    // Equality on the first property and a range on the second one.
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {PropertyValue(0)},
+                                    memgraph::utils::MakeBoundExclusive(PropertyValue(3)),
+                                    memgraph::utils::MakeBoundInclusive(PropertyValue(9)), View::OLD)),
+                UnorderedElementsAre(9));
+    // A range on the first property.
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {}, memgraph::utils::MakeBoundInclusive(PropertyValue(1)),
+                                    std::nullopt, View::OLD)),
+                UnorderedElementsAre(1, 5, 7));
+    // Null can't be matched by an equality.
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {PropertyValue()}, std::nullopt, std::nullopt, View::OLD)),
+                IsEmpty());
+
+    // Changing a property moves the vertex within the index.
+    for (auto vertex : acc.Vertices(label1, properties, {PropertyValue(1)}, std::nullopt, std::nullopt, View::OLD)) {
+      ASSERT_NO_ERROR(vertex.SetProperty(prop_val, PropertyValue(2)));
+    }
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {PropertyValue(1)}, std::nullopt, std::nullopt, View::NEW),
+                       View::NEW),
+                IsEmpty());
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {PropertyValue(2)}, std::nullopt, std::nullopt, View::NEW),
+                       View::NEW),
+                UnorderedElementsAre(1, 5, 7));
+    ASSERT_NO_ERROR(acc.Commit());
+  }
+
+  {
+    auto acc = storage.Access();
+    for (auto vertex : acc.Vertices(label1, properties, {PropertyValue(2)}, std::nullopt, std::nullopt, View::OLD)) {
+      ASSERT_NO_ERROR(vertex.RemoveLabel(label1));
+    }
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {}, std::nullopt, std::nullopt, View::NEW), View::NEW),
+                UnorderedElementsAre(3, 9));
+    ASSERT_NO_ERROR(acc.Commit());
+  }
+
+  storage.FreeMemory();
+  {
+    auto acc = storage.Access();
+    EXPECT_THAT(GetIds(acc.Vertices(label1, properties, {}, std::nullopt, std::nullopt, View::OLD)),
+                UnorderedElementsAre(3, 9));
+  }
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST_F(IndexTest, LabelPropertyCompositeIndexCountEstimate) {
+  const std::vector<PropertyId> properties{prop_val, prop_id};
+  EXPECT_FALSE(storage.CreateIndex(label1, properties).HasError());
+
+  auto acc = storage.Access();
+  for (int i = 1; i <= 10; ++i) {
+    for (int j = 0; j < i; ++j) {
+      auto vertex = CreateVertex(&acc);
+      ASSERT_NO_ERROR(vertex.AddLabel(label1));
+      ASSERT_NO_ERROR(vertex.SetProperty(prop_val, PropertyValue(i)));
+    }
+  }
+
+  EXPECT_EQ(acc.ApproximateVertexCount(label1, properties), 55);
+  for (int i = 1; i <= 10; ++i) {
+    EXPECT_EQ(acc.ApproximateVertexCount(label1, properties, {PropertyValue(i)}), i);
+  }
+  EXPECT_EQ(acc.ApproximateVertexCount(label1, properties, {}, memgraph::utils::MakeBoundInclusive(PropertyValue(2)),
+                                       memgraph::utils::MakeBoundInclusive(PropertyValue(6))),
+            2 + 3 + 4 + 5 + 6);
+}
+
+namespace {
+// Creates vertices of which every third has the label and every second has
+// the property.
+void CreateIndexedVertices(Storage *storage, LabelId label, PropertyId property) {
+  auto acc = storage->Access();
+  for (int64_t i = 0; i < 10000; ++i) {
+    auto vertex = acc.CreateVertex();
+    if (i % 3 == 0) MG_ASSERT(!vertex.AddLabel(label).HasError());
+    if (i % 2 == 0) MG_ASSERT(!vertex.SetProperty(property, PropertyValue(i % 100)).HasError());
+  }
+  MG_ASSERT(!acc.Commit().HasError());
+}
+
+// Checks that the indices contain exactly the vertices found by a full scan.
+void VerifyIndices(Storage *storage, LabelId label, PropertyId property) {
+  auto acc = storage->Access();
+  ASSERT_TRUE(acc.LabelIndexExists(label));
+  ASSERT_TRUE(acc.LabelPropertyIndexExists(label, property));
+  std::vector<Gid> expected_label;
+  std::vector<Gid> expected_label_property;
+  for (auto vertex : acc.Vertices(View::OLD)) {
+    if (!*vertex.HasLabel(label, View::OLD)) continue;
+    expected_label.push_back(vertex.Gid());
+    if (!vertex.GetProperty(property, View::OLD)->IsNull()) expected_label_property.push_back(vertex.Gid());
+  }
+  std::vector<Gid> label_index;
+  for (auto vertex : acc.Vertices(label, View::OLD)) {
+    label_index.push_back(vertex.Gid());
+  }
+  EXPECT_THAT(label_index, UnorderedElementsAreArray(expected_label));
+  std::vector<Gid> label_property_index;
+  std::optional<PropertyValue> prev;
+  for (auto vertex : acc.Vertices(label, property, View::OLD)) {
+    auto value = *vertex.GetProperty(property, View::OLD);
+    // The label+property index is ordered by the property value.
+    if (prev) EXPECT_FALSE(value < *prev);
+    prev = value;
+    label_property_index.push_back(vertex.Gid());
+  }
+  EXPECT_THAT(label_property_index, UnorderedElementsAreArray(expected_label_property));
+}
+}  // namespace
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(IndexCreationTest, Parallel) {
+  Storage storage(Config{.index_creation = {.num_threads = 4}});
+  LabelId label = storage.NameToLabel("label");
+  PropertyId property = storage.NameToProperty("property");
+  CreateIndexedVertices(&storage, label, property);
+  ASSERT_NO_ERROR(storage.CreateIndex(label));
+  ASSERT_NO_ERROR(storage.CreateIndex(label, property));
+  ASSERT_TRUE(storage.CreateIndex(label).HasError());
+  VerifyIndices(&storage, label, property);
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(IndexCreationTest, ConcurrentWithWrites) {
+  Storage storage(Config{.index_creation = {.num_threads = 2, .concurrent = true}});
+  LabelId label = storage.NameToLabel("label");
+  PropertyId property = storage.NameToProperty("property");
+  CreateIndexedVertices(&storage, label, property);
+
+  // Vertices are added, relabeled and modified while the indices are created.
+  std::atomic<bool> done{false};
+  std::thread writer([&] {
+    for (int64_t i = 0; !done.load(); ++i) {
+      auto acc = storage.Access();
+      auto vertex = acc.CreateVertex();
+      MG_ASSERT(!vertex.AddLabel(label).HasError());
+      MG_ASSERT(!vertex.SetProperty(property, PropertyValue(i)).HasError());
+      auto other = acc.FindVertex(Gid::FromUint(i % 10000), View::OLD);
+      MG_ASSERT(other);
+      if (*other->HasLabel(label, View::OLD)) {
+        MG_ASSERT(!other->RemoveLabel(label).HasError());
+      } else {
+        MG_ASSERT(!other->AddLabel(label).HasError());
+      }
+      MG_ASSERT(!other->SetProperty(property, PropertyValue(-i)).HasError());
+      MG_ASSERT(!acc.Commit().HasError());
+    }
+  });
+  ASSERT_NO_ERROR(storage.CreateIndex(label));
+  ASSERT_NO_ERROR(storage.CreateIndex(label, property));
+  done.store(true);
+  writer.join();
+  VerifyIndices(&storage, label, property);
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(IndexCreationTest, DropWhileCreating) {
+  Storage storage(Config{.index_creation = {.num_threads = 2, .concurrent = true}});
+  LabelId label = storage.NameToLabel("label");
+  PropertyId property = storage.NameToProperty("property");
+  CreateIndexedVertices(&storage, label, property);
+
+  auto is_being_created = [](const auto &result) {
+    return result.HasError() && std::holds_alternative<IndexBeingCreatedError>(result.GetError());
+  };
+  uint64_t rejected_drops = 0;
+  for (int round = 0; round < 5; ++round) {
+    std::atomic<bool> created{false};
+    std::thread creator([&] {
+      MG_ASSERT(!storage.CreateIndex(label).HasError());
+      MG_ASSERT(!storage.CreateIndex(label, property).HasError());
+      created.store(true);
+    });
+    // The index can't be dropped or created again while it is populated. It
+    // can only be dropped once it is published, which may happen right after
+    // the drop was rejected.
+    bool label_dropped = false;
+    bool label_property_dropped = false;
+    while (!created.load() || !label_dropped || !label_property_dropped) {
+      if (!label_dropped) {
+        auto result = storage.DropIndex(label);
+        if (is_being_created(result)) {
+          ++rejected_drops;
+          EXPECT_TRUE(storage.CreateIndex(label).HasError());
+        }
+        label_dropped = !result.HasError();
+      }
+      if (!label_property_dropped) {
+        auto result = storage.DropIndex(label, property);
+        if (is_being_created(result)) {
+          ++rejected_drops;
+          EXPECT_TRUE(storage.CreateIndex(label, property).HasError());
+        }
+        label_property_dropped = !result.HasError();
+      }
+    }
+    creator.join();
+    auto acc = storage.Access();
+    EXPECT_FALSE(acc.LabelIndexExists(label));
+    EXPECT_FALSE(acc.LabelPropertyIndexExists(label, property));
+  }
+  EXPECT_GT(rejected_drops, 0);
+
+  // The indices are created correctly after they were dropped.
+  ASSERT_NO_ERROR(storage.CreateIndex(label));
+  ASSERT_NO_ERROR(storage.CreateIndex(label, property));
+  VerifyIndices(&storage, label, property);
+}
+
+namespace {
+std::vector<int64_t> GetEdgeIds(EdgesIterable iterable, PropertyId property, View view) {
+  std::vector<int64_t> ret;
+  for (auto edge : iterable) {
+    ret.push_back(edge.GetProperty(property, view)->ValueInt());
+  }
+  return ret;
+}
+}  // namespace
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(EdgeIndexTest, EdgeTypeIndexBasic) {
+  Storage storage(Config{.gc = {.type = Config::Gc::Type::NONE}});
+  auto edge_type1 = storage.NameToEdgeType("type1");
+  auto edge_type2 = storage.NameToEdgeType("type2");
+  auto prop_id = storage.NameToProperty("id");
+
+  {
+    auto acc = storage.Access();
+    auto from = acc.CreateVertex();
+    auto to = acc.CreateVertex();
+    for (int64_t i = 0; i < 10; ++i) {
+      auto edge = acc.CreateEdge(&from, &to, i % 2 ? edge_type1 : edge_type2);
+      ASSERT_NO_ERROR(edge);
+      ASSERT_NO_ERROR(edge->SetProperty(prop_id, PropertyValue(i)));
+    }
+    ASSERT_NO_ERROR(acc.Commit());
+  }
+
+  // Existing edges are added to the index when it is created.
+  ASSERT_NO_ERROR(storage.CreateIndex(edge_type1));
+  ASSERT_TRUE(storage.CreateIndex(edge_type1).HasError());
+  EXPECT_THAT(storage.ListAllIndices().edge_type, UnorderedElementsAre(edge_type1));
+
+  {
+    auto acc = storage.Access();
+    EXPECT_TRUE(acc.EdgeTypeIndexExists(edge_type1));
+    EXPECT_FALSE(acc.EdgeTypeIndexExists(edge_type2));
+    EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type1, View::OLD), prop_id, View::OLD), UnorderedElementsAre(1, 3, 5, 7, 9));
+
+    // New edges are visible only in the NEW view until the command advances.
+    auto from = acc.CreateVertex();
+    auto to = acc.CreateVertex();
+    auto edge = acc.CreateEdge(&from, &to, edge_type1);
+    ASSERT_NO_ERROR(edge);
+    ASSERT_NO_ERROR(edge->SetProperty(prop_id, PropertyValue(11)));
+    EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type1, View::OLD), prop_id, View::OLD), UnorderedElementsAre(1, 3, 5, 7, 9));
+    EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type1, View::NEW), prop_id, View::NEW),
+                UnorderedElementsAre(1, 3, 5, 7, 9, 11));
+    acc.Abort();
+  }
+
+  {
+    auto acc = storage.Access();
+    EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type1, View::OLD), prop_id, View::OLD), UnorderedElementsAre(1, 3, 5, 7, 9));
+    for (auto edge : acc.Edges(edge_type1, View::OLD)) {
+      if (edge.GetProperty(prop_id, View::OLD)->ValueInt() < 5) {
+        ASSERT_NO_ERROR(acc.DeleteEdge(&edge));
+      }
+    }
+    EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type1, View::OLD), prop_id, View::OLD), UnorderedElementsAre(1, 3, 5, 7, 9));
+    EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type1, View::NEW), prop_id, View::NEW), UnorderedElementsAre(5, 7, 9));
+    ASSERT_NO_ERROR(acc.Commit());
+  }
+
+  // Garbage collection removes the entries of the aborted and deleted edges.
+  storage.FreeMemory();
+  {
+    auto acc = storage.Access();
+    EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type1, View::OLD), prop_id, View::OLD), UnorderedElementsAre(5, 7, 9));
+    EXPECT_EQ(acc.ApproximateEdgeCount(edge_type1), 3);
+  }
+
+  ASSERT_NO_ERROR(storage.DropIndex(edge_type1));
+  ASSERT_TRUE(storage.DropIndex(edge_type1).HasError());
+  EXPECT_THAT(storage.ListAllIndices().edge_type, IsEmpty());
+}
+
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+TEST(EdgeIndexTest, EdgeTypePropertyIndexBasic) {
+  Storage storage(Config{.gc = {.type = Config::Gc::Type::NONE}});
+  auto edge_type = storage.NameToEdgeType("type");
+  auto prop_id = storage.NameToProperty("id");
+  auto prop_val = storage.NameToProperty("val");
+
+  ASSERT_NO_ERROR(storage.CreateIndex(edge_type, prop_val));
+  ASSERT_TRUE(storage.CreateIndex(edge_type, prop_val).HasError());
+  EXPECT_THAT(storage.ListAllIndices().edge_type_property,
+              UnorderedElementsAre(std::make_pair(edge_type, prop_val)));
+
+  {
+    auto acc = storage.Access();
+    auto from = acc.CreateVertex();
+    auto to = acc.CreateVertex();
+    for (int64_t i = 0; i < 10; ++i) {
+      auto edge = acc.CreateEdge(&from, &to, edge_type);
+      ASSERT_NO_ERROR(edge);
+      ASSERT_NO_ERROR(edge->SetProperty(prop_id, PropertyValue(i)));
+      ASSERT_NO_ERROR(edge->SetProperty(prop_val, PropertyValue(i % 3)));
+    }
+    EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type, prop_val, PropertyValue(1), View::OLD), prop_id, View::OLD),
+                IsEmpty());
+    EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type, prop_val, PropertyValue(1), View::NEW), prop_id, View::NEW),
+                UnorderedElementsAre(1, 4, 7));
+    ASSERT_NO_ERROR(acc.Commit());
+  }
+
+  {
+    auto acc = storage.Access();
+    EXPECT_TRUE(acc.EdgeTypePropertyIndexExists(edge_type, prop_val));
+    EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type, prop_val, PropertyValue(0), View::OLD), prop_id, View::OLD),
+                UnorderedElementsAre(0, 3, 6, 9));
+    EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type, prop_val, PropertyValue(), View::OLD), prop_id, View::OLD),
+                IsEmpty());
+
+    // Changing the property moves the edge to a different value.
+    for (auto edge : acc.Edges(edge_type, prop_val, PropertyValue(0), View::OLD)) {
+      ASSERT_NO_ERROR(edge.SetProperty(prop_val, PropertyValue(1)));
+    }
+    EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type, prop_val, PropertyValue(0), View::NEW), prop_id, View::NEW),
+                IsEmpty());
+    EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type, prop_val, PropertyValue(1), View::NEW), prop_id, View::NEW),
+                UnorderedElementsAre(0, 1, 3, 4, 6, 7, 9));
+    ASSERT_NO_ERROR(acc.Commit());
+  }
+
+  storage.FreeMemory();
+  {
+    auto acc = storage.Access();
+    EXPECT_EQ(acc.ApproximateEdgeCount(edge_type, prop_val), 10);
+    EXPECT_THAT(GetEdgeIds(acc.Edges(edge_type, prop_val, PropertyValue(1), View::OLD), prop_id, View::OLD),
+                UnorderedElementsAre(0, 1, 3, 4, 6, 7, 9));
+  }
+
+  ASSERT_NO_ERROR(storage.DropIndex(edge_type, prop_val));
+  EXPECT_THAT(storage.ListAllIndices().edge_type_property, IsEmpty());
+
+  // The edge-type-property index can't be created without properties on edges.
+  Storage no_properties(Config{.items = {.properties_on_edges = false}});
+  ASSERT_TRUE(no_properties.CreateIndex(no_properties.NameToEdgeType("type"), no_properties.NameToProperty("val"))
+                  .HasError());
+}
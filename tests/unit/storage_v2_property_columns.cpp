@@ -0,0 +1,222 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "storage/v2/storage.hpp"
+
+using memgraph::storage::Config;
+using memgraph::storage::IsolationLevel;
+using memgraph::storage::LabelId;
+using memgraph::storage::PropertyId;
+using memgraph::storage::PropertyValue;
+using memgraph::storage::Storage;
+using memgraph::storage::View;
+
+class PropertyColumnsTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    label = storage.NameToLabel("L");
+    other_label = storage.NameToLabel("M");
+    prop = storage.NameToProperty("p");
+    other_prop = storage.NameToProperty("q");
+  }
+
+  // Creates a vertex with the label and the value of `prop`, which isn't set
+  // when it's null.
+  memgraph::storage::Gid CreateVertex(const PropertyValue &value, LabelId vertex_label) {
+    auto acc = storage.Access();
+    auto vertex = acc.CreateVertex();
+    MG_ASSERT(vertex.AddLabel(vertex_label).HasValue());
+    if (!value.IsNull()) MG_ASSERT(vertex.SetProperty(prop, value).HasValue());
+    MG_ASSERT(!acc.Commit().HasError());
+    return vertex.Gid();
+  }
+
+  memgraph::storage::Gid CreateVertex(const PropertyValue &value) { return CreateVertex(value, label); }
+
+  Storage storage;
+  LabelId label;
+  LabelId other_label;
+  PropertyId prop;
+  PropertyId other_prop;
+};
+
+TEST_F(PropertyColumnsTest, CreateAndDrop) {
+  ASSERT_TRUE(storage.ListAllPropertyColumns().empty());
+  ASSERT_TRUE(storage.CreatePropertyColumn(label, prop));
+  ASSERT_FALSE(storage.CreatePropertyColumn(label, prop));
+  ASSERT_TRUE(storage.CreatePropertyColumn(label, other_prop));
+  ASSERT_EQ(storage.ListAllPropertyColumns().size(), 2);
+  {
+    auto acc = storage.Access();
+    ASSERT_TRUE(acc.PropertyColumnExists(label, prop));
+    ASSERT_FALSE(acc.PropertyColumnExists(other_label, prop));
+    ASSERT_FALSE(acc.ScanPropertyColumns(other_label, {prop}, View::OLD));
+    ASSERT_TRUE(acc.ScanPropertyColumns(label, {prop, other_prop}, View::OLD));
+  }
+  ASSERT_TRUE(storage.DropPropertyColumn(label, prop));
+  ASSERT_FALSE(storage.DropPropertyColumn(label, prop));
+  {
+    auto acc = storage.Access();
+    ASSERT_FALSE(acc.PropertyColumnExists(label, prop));
+    ASSERT_FALSE(acc.ScanPropertyColumns(label, {prop}, View::OLD));
+  }
+}
+
+TEST_F(PropertyColumnsTest, Summary) {
+  CreateVertex(PropertyValue(5));
+  CreateVertex(PropertyValue(-3));
+  CreateVertex(PropertyValue(2.5));
+  CreateVertex(PropertyValue(std::numeric_limits<double>::quiet_NaN()));
+  CreateVertex(PropertyValue("b"));
+  CreateVertex(PropertyValue("a"));
+  CreateVertex(PropertyValue("b"));
+  CreateVertex(PropertyValue(true));
+  CreateVertex(PropertyValue());
+  CreateVertex(PropertyValue(100), other_label);
+  // The vertices created before the column are added to it.
+  ASSERT_TRUE(storage.CreatePropertyColumn(label, prop));
+  CreateVertex(PropertyValue(std::vector<PropertyValue>{PropertyValue(1)}));
+  CreateVertex(PropertyValue(7));
+
+  auto acc = storage.Access();
+  auto scan = acc.ScanPropertyColumns(label, {prop}, View::OLD);
+  ASSERT_TRUE(scan);
+  ASSERT_EQ(scan->count, 11);
+  ASSERT_TRUE(scan->vertices.empty());
+  const auto &summary = scan->summaries[0];
+  ASSERT_EQ(summary.int_count, 3);
+  ASSERT_EQ(summary.int_sum, 9);
+  ASSERT_EQ(summary.int_min, -3);
+  ASSERT_EQ(summary.int_max, 7);
+  ASSERT_EQ(summary.double_count, 1);
+  ASSERT_EQ(summary.double_sum, 2.5);
+  ASSERT_EQ(summary.string_count, 3);
+  ASSERT_EQ(summary.string_min, "a");
+  ASSERT_EQ(summary.string_max, "b");
+  // NaN, the boolean and the list.
+  ASSERT_EQ(summary.other_count, 3);
+  ASSERT_EQ(summary.Count(), 10);
+}
+
+TEST_F(PropertyColumnsTest, SnapshotIsolation) {
+  ASSERT_TRUE(storage.CreatePropertyColumn(label, prop));
+  auto gid = CreateVertex(PropertyValue(1));
+  CreateVertex(PropertyValue(2));
+
+  auto old_acc = storage.Access();
+  {
+    auto acc = storage.Access();
+    auto vertex = acc.FindVertex(gid, View::OLD);
+    ASSERT_TRUE(vertex);
+    ASSERT_TRUE(vertex->SetProperty(prop, PropertyValue(10)).HasValue());
+    ASSERT_TRUE(vertex->SetProperty(other_prop, PropertyValue(10)).HasValue());
+    // The transaction with uncommitted changes can't use the columns.
+    ASSERT_FALSE(acc.ScanPropertyColumns(label, {prop}, View::OLD));
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+  CreateVertex(PropertyValue(3));
+
+  {
+    // The changed vertex is read through its accessor, while the new vertex
+    // isn't visible at all.
+    auto scan = old_acc.ScanPropertyColumns(label, {prop}, View::OLD);
+    ASSERT_TRUE(scan);
+    ASSERT_EQ(scan->count, 1);
+    ASSERT_EQ(scan->summaries[0].int_sum, 2);
+    ASSERT_EQ(scan->vertices.size(), 1);
+    ASSERT_EQ(scan->vertices[0].Gid(), gid);
+    ASSERT_EQ(*scan->vertices[0].GetProperty(prop, View::OLD), PropertyValue(1));
+  }
+  {
+    auto acc = storage.Access();
+    auto scan = acc.ScanPropertyColumns(label, {prop}, View::OLD);
+    ASSERT_TRUE(scan);
+    ASSERT_EQ(scan->count, 3);
+    ASSERT_EQ(scan->summaries[0].int_sum, 15);
+    ASSERT_TRUE(scan->vertices.empty());
+  }
+  {
+    // READ_COMMITTED sees all of the committed rows.
+    auto acc = storage.Access(IsolationLevel::READ_COMMITTED);
+    auto scan = acc.ScanPropertyColumns(label, {prop}, View::OLD);
+    ASSERT_TRUE(scan);
+    ASSERT_EQ(scan->count, 3);
+    ASSERT_TRUE(scan->vertices.empty());
+  }
+  {
+    auto acc = storage.Access(IsolationLevel::READ_UNCOMMITTED);
+    ASSERT_FALSE(acc.ScanPropertyColumns(label, {prop}, View::OLD));
+  }
+}
+
+TEST_F(PropertyColumnsTest, RemovedRows) {
+  ASSERT_TRUE(storage.CreatePropertyColumn(label, prop));
+  auto deleted_gid = CreateVertex(PropertyValue(1));
+  auto unlabeled_gid = CreateVertex(PropertyValue(2));
+  CreateVertex(PropertyValue(4));
+
+  auto old_acc = storage.Access();
+  {
+    auto acc = storage.Access();
+    auto deleted = acc.FindVertex(deleted_gid, View::OLD);
+    ASSERT_TRUE(deleted);
+    ASSERT_TRUE(acc.DeleteVertex(&*deleted).HasValue());
+    auto unlabeled = acc.FindVertex(unlabeled_gid, View::OLD);
+    ASSERT_TRUE(unlabeled);
+    ASSERT_TRUE(unlabeled->RemoveLabel(label).HasValue());
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+
+  {
+    auto scan = old_acc.ScanPropertyColumns(label, {prop}, View::OLD);
+    ASSERT_TRUE(scan);
+    ASSERT_EQ(scan->count, 1);
+    ASSERT_EQ(scan->vertices.size(), 2);
+  }
+  {
+    auto acc = storage.Access();
+    auto scan = acc.ScanPropertyColumns(label, {prop}, View::OLD);
+    ASSERT_TRUE(scan);
+    ASSERT_EQ(scan->count, 1);
+    ASSERT_EQ(scan->summaries[0].int_sum, 4);
+    ASSERT_TRUE(scan->vertices.empty());
+  }
+  ASSERT_FALSE(old_acc.Commit().HasError());
+
+  // The removed rows are freed and reused once no transaction sees them.
+  storage.FreeMemory();
+  CreateVertex(PropertyValue(8));
+  {
+    auto acc = storage.Access();
+    auto unlabeled = acc.FindVertex(unlabeled_gid, View::OLD);
+    ASSERT_TRUE(unlabeled);
+    ASSERT_TRUE(unlabeled->AddLabel(label).HasValue());
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+  auto acc = storage.Access();
+  auto scan = acc.ScanPropertyColumns(label, {prop}, View::OLD);
+  ASSERT_TRUE(scan);
+  ASSERT_EQ(scan->count, 3);
+  ASSERT_EQ(scan->summaries[0].int_sum, 14);
+  ASSERT_TRUE(scan->vertices.empty());
+}
+
+TEST(PropertyColumns, CreatedFromConfig) {
+  Storage storage(Config{.columns = {.label_properties = {{"L", "p"}}}});
+  auto acc = storage.Access();
+  ASSERT_TRUE(acc.PropertyColumnExists(acc.NameToLabel("L"), acc.NameToProperty("p")));
+}
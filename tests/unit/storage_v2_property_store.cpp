@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -649,3 +649,108 @@ TEST(PropertyStore, IsPropertyEqualTemporalData) {
   ASSERT_FALSE(props.IsPropertyEqual(prop, memgraph::storage::PropertyValue(memgraph::storage::TemporalData{
                                                memgraph::storage::TemporalType::Date, 30})));
 }
+
+TEST(PropertyStore, CheckPredicateEqual) {
+  using Result = memgraph::storage::PropertyPredicate::Result;
+  using memgraph::storage::PropertyPredicate;
+  using memgraph::storage::PropertyValue;
+  memgraph::storage::PropertyStore props;
+  auto prop_int = memgraph::storage::PropertyId::FromInt(1);
+  auto prop_double = memgraph::storage::PropertyId::FromInt(2);
+  auto prop_string = memgraph::storage::PropertyId::FromInt(3);
+  auto prop_bool = memgraph::storage::PropertyId::FromInt(4);
+  auto prop_list = memgraph::storage::PropertyId::FromInt(5);
+  auto prop_missing = memgraph::storage::PropertyId::FromInt(6);
+  const std::string str = "a string which doesn't fit into the local buffer";
+  ASSERT_TRUE(props.SetProperty(prop_int, PropertyValue(42)));
+  ASSERT_TRUE(props.SetProperty(prop_double, PropertyValue(4.5)));
+  ASSERT_TRUE(props.SetProperty(prop_string, PropertyValue(str)));
+  ASSERT_TRUE(props.SetProperty(prop_bool, PropertyValue(true)));
+  ASSERT_TRUE(props.SetProperty(prop_list, PropertyValue(std::vector<PropertyValue>{PropertyValue(42)})));
+
+  ASSERT_EQ(props.CheckPredicate(prop_int, PropertyPredicate::Equal(PropertyValue(42))), Result::MATCH);
+  ASSERT_EQ(props.CheckPredicate(prop_int, PropertyPredicate::Equal(PropertyValue(42.0))), Result::MATCH);
+  ASSERT_EQ(props.CheckPredicate(prop_int, PropertyPredicate::Equal(PropertyValue(43))), Result::NO_MATCH);
+  ASSERT_EQ(props.CheckPredicate(prop_int, PropertyPredicate::Equal(PropertyValue("42"))), Result::NO_MATCH);
+  ASSERT_EQ(props.CheckPredicate(prop_double, PropertyPredicate::Equal(PropertyValue(4.5))), Result::MATCH);
+  ASSERT_EQ(props.CheckPredicate(prop_double, PropertyPredicate::Equal(PropertyValue(4))), Result::NO_MATCH);
+  ASSERT_EQ(props.CheckPredicate(prop_string, PropertyPredicate::Equal(PropertyValue(str))), Result::MATCH);
+  ASSERT_EQ(props.CheckPredicate(prop_string, PropertyPredicate::Equal(PropertyValue(str + "."))), Result::NO_MATCH);
+  ASSERT_EQ(props.CheckPredicate(prop_bool, PropertyPredicate::Equal(PropertyValue(true))), Result::MATCH);
+  ASSERT_EQ(props.CheckPredicate(prop_bool, PropertyPredicate::Equal(PropertyValue(false))), Result::NO_MATCH);
+  ASSERT_EQ(props.CheckPredicate(prop_bool, PropertyPredicate::Equal(PropertyValue(1))), Result::NO_MATCH);
+
+  // Comparing to null never matches.
+  ASSERT_EQ(props.CheckPredicate(prop_missing, PropertyPredicate::Equal(PropertyValue(42))), Result::NO_MATCH);
+  ASSERT_EQ(props.CheckPredicate(prop_int, PropertyPredicate::Equal(PropertyValue())), Result::NO_MATCH);
+
+  // Lists are left to the caller.
+  ASSERT_EQ(props.CheckPredicate(prop_list, PropertyPredicate::Equal(PropertyValue(42))), Result::UNKNOWN);
+  ASSERT_EQ(props.CheckPredicate(prop_int, PropertyPredicate::Equal(PropertyValue(std::vector<PropertyValue>{}))),
+            Result::UNKNOWN);
+}
+
+TEST(PropertyStore, CheckPredicateRange) {
+  using Result = memgraph::storage::PropertyPredicate::Result;
+  using memgraph::storage::PropertyPredicate;
+  using memgraph::storage::PropertyValue;
+  using memgraph::utils::MakeBoundExclusive;
+  using memgraph::utils::MakeBoundInclusive;
+  memgraph::storage::PropertyStore props;
+  auto prop_int = memgraph::storage::PropertyId::FromInt(1);
+  auto prop_double = memgraph::storage::PropertyId::FromInt(2);
+  auto prop_string = memgraph::storage::PropertyId::FromInt(3);
+  auto prop_bool = memgraph::storage::PropertyId::FromInt(4);
+  auto prop_missing = memgraph::storage::PropertyId::FromInt(5);
+  ASSERT_TRUE(props.SetProperty(prop_int, PropertyValue(42)));
+  ASSERT_TRUE(props.SetProperty(prop_double, PropertyValue(4.5)));
+  ASSERT_TRUE(props.SetProperty(prop_string, PropertyValue("bcd")));
+  ASSERT_TRUE(props.SetProperty(prop_bool, PropertyValue(false)));
+
+  using Bound = std::optional<memgraph::utils::Bound<PropertyValue>>;
+  auto check = [&](auto property, Bound lower, Bound upper) {
+    return props.CheckPredicate(property, PropertyPredicate::Range(std::move(lower), std::move(upper)));
+  };
+
+  ASSERT_EQ(check(prop_int, MakeBoundInclusive(PropertyValue(42)), std::nullopt), Result::MATCH);
+  ASSERT_EQ(check(prop_int, MakeBoundExclusive(PropertyValue(42)), std::nullopt), Result::NO_MATCH);
+  ASSERT_EQ(check(prop_int, std::nullopt, MakeBoundInclusive(PropertyValue(42))), Result::MATCH);
+  ASSERT_EQ(check(prop_int, std::nullopt, MakeBoundExclusive(PropertyValue(42))), Result::NO_MATCH);
+  ASSERT_EQ(check(prop_int, MakeBoundExclusive(PropertyValue(41.5)), MakeBoundExclusive(PropertyValue(42.5))),
+            Result::MATCH);
+  ASSERT_EQ(check(prop_int, MakeBoundExclusive(PropertyValue(42.5)), std::nullopt), Result::NO_MATCH);
+  ASSERT_EQ(check(prop_double, MakeBoundInclusive(PropertyValue(4)), MakeBoundInclusive(PropertyValue(5))),
+            Result::MATCH);
+  ASSERT_EQ(check(prop_double, std::nullopt, MakeBoundInclusive(PropertyValue(4))), Result::NO_MATCH);
+  ASSERT_EQ(check(prop_string, MakeBoundExclusive(PropertyValue("bc")), std::nullopt), Result::MATCH);
+  ASSERT_EQ(check(prop_string, MakeBoundExclusive(PropertyValue("bce")), std::nullopt), Result::NO_MATCH);
+  ASSERT_EQ(check(prop_string, std::nullopt, MakeBoundInclusive(PropertyValue("bcd"))), Result::MATCH);
+  ASSERT_EQ(check(prop_missing, MakeBoundInclusive(PropertyValue(0)), std::nullopt), Result::NO_MATCH);
+
+  // Ordering values of different types is an error, which is left to the
+  // caller.
+  ASSERT_EQ(check(prop_int, MakeBoundInclusive(PropertyValue("a")), std::nullopt), Result::UNKNOWN);
+  ASSERT_EQ(check(prop_string, MakeBoundInclusive(PropertyValue(1)), std::nullopt), Result::UNKNOWN);
+  ASSERT_EQ(check(prop_bool, MakeBoundInclusive(PropertyValue(1)), std::nullopt), Result::UNKNOWN);
+  ASSERT_EQ(check(prop_int, MakeBoundInclusive(PropertyValue(100)), MakeBoundInclusive(PropertyValue("a"))),
+            Result::UNKNOWN);
+}
+
+TEST(PropertyStore, CheckPredicateIsNull) {
+  using Result = memgraph::storage::PropertyPredicate::Result;
+  using memgraph::storage::PropertyPredicate;
+  using memgraph::storage::PropertyValue;
+  memgraph::storage::PropertyStore props;
+  auto prop = memgraph::storage::PropertyId::FromInt(1);
+  auto prop_map = memgraph::storage::PropertyId::FromInt(2);
+  ASSERT_EQ(props.CheckPredicate(prop, PropertyPredicate::IsNull()), Result::MATCH);
+  ASSERT_EQ(props.CheckPredicate(prop, PropertyPredicate::IsNotNull()), Result::NO_MATCH);
+  ASSERT_TRUE(props.SetProperty(prop, PropertyValue(false)));
+  ASSERT_TRUE(props.SetProperty(prop_map, PropertyValue(std::map<std::string, PropertyValue>{{"a", PropertyValue()}})));
+  ASSERT_EQ(props.CheckPredicate(prop, PropertyPredicate::IsNull()), Result::NO_MATCH);
+  ASSERT_EQ(props.CheckPredicate(prop, PropertyPredicate::IsNotNull()), Result::MATCH);
+  ASSERT_EQ(props.CheckPredicate(prop_map, PropertyPredicate::IsNull()), Result::NO_MATCH);
+  ASSERT_EQ(props.CheckPredicate(prop_map, PropertyPredicate::IsNotNull()), Result::MATCH);
+  ASSERT_FALSE(props.SetProperty(prop, PropertyValue()));
+  ASSERT_EQ(props.CheckPredicate(prop, PropertyPredicate::IsNull()), Result::MATCH);
+}
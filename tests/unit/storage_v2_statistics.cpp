@@ -0,0 +1,283 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "storage/v2/durability/serialization.hpp"
+#include "storage/v2/durability/version.hpp"
+#include "storage/v2/statistics.hpp"
+#include "storage/v2/storage.hpp"
+
+using memgraph::storage::GraphStatistics;
+using memgraph::storage::Histogram;
+using memgraph::storage::PropertyValue;
+using memgraph::utils::MakeBoundExclusive;
+using memgraph::utils::MakeBoundInclusive;
+
+TEST(Histogram, Empty) {
+  auto histogram = Histogram::Build({}, 10);
+  ASSERT_TRUE(histogram.empty());
+  ASSERT_EQ(histogram.EstimateFraction(std::nullopt, std::nullopt), 0.0);
+}
+
+TEST(Histogram, Uniform) {
+  std::vector<double> values(1000);
+  std::iota(values.begin(), values.end(), 0);
+  auto histogram = Histogram::Build(values, 10);
+  ASSERT_EQ(histogram.upper_bounds.size(), 10);
+  ASSERT_EQ(histogram.count, 1000);
+  ASSERT_EQ(histogram.min, 0);
+  ASSERT_EQ(histogram.upper_bounds.back(), 999);
+  ASSERT_DOUBLE_EQ(histogram.EstimateFraction(std::nullopt, std::nullopt), 1.0);
+  ASSERT_NEAR(histogram.EstimateFraction(MakeBoundInclusive<double>(0), MakeBoundExclusive<double>(500)), 0.5, 0.01);
+  ASSERT_NEAR(histogram.EstimateFraction(MakeBoundInclusive<double>(250), std::nullopt), 0.75, 0.01);
+  ASSERT_EQ(histogram.EstimateFraction(MakeBoundExclusive<double>(999), std::nullopt), 0.0);
+  ASSERT_EQ(histogram.EstimateFraction(std::nullopt, MakeBoundExclusive<double>(0)), 0.0);
+}
+
+TEST(Histogram, Skewed) {
+  // Half of the values are the same, an equi-depth histogram has to estimate
+  // the frequent value as half of the values.
+  std::vector<double> values(500, 1.0);
+  for (int i = 0; i < 500; ++i) values.push_back(100.0 + i);
+  auto histogram = Histogram::Build(values, 10);
+  ASSERT_NEAR(histogram.EstimateFraction(MakeBoundInclusive<double>(1), MakeBoundInclusive<double>(1)), 0.5, 0.01);
+  ASSERT_NEAR(histogram.EstimateFraction(MakeBoundInclusive<double>(200), MakeBoundExclusive<double>(450)), 0.25, 0.02);
+}
+
+TEST(Histogram, ExclusiveUpperBoundAtMaximum) {
+  // The maximum is one of the 10 distinct values of the last bucket.
+  std::vector<double> values(100);
+  std::iota(values.begin(), values.end(), 0);
+  auto histogram = Histogram::Build(values, 10);
+  ASSERT_NEAR(histogram.EstimateFraction(std::nullopt, MakeBoundExclusive<double>(99)), 0.99, 1e-9);
+  ASSERT_DOUBLE_EQ(histogram.EstimateFraction(std::nullopt, MakeBoundInclusive<double>(99)), 1.0);
+  ASSERT_NEAR(histogram.EstimateFraction(MakeBoundInclusive<double>(99), MakeBoundInclusive<double>(99)), 0.01, 1e-9);
+
+  // A frequent maximum fills the last buckets, so none of them is below it.
+  std::vector<double> skewed(50);
+  std::iota(skewed.begin(), skewed.end(), 0);
+  skewed.insert(skewed.end(), 50, 100.0);
+  auto skewed_histogram = Histogram::Build(skewed, 10);
+  ASSERT_NEAR(skewed_histogram.EstimateFraction(std::nullopt, MakeBoundExclusive<double>(100)), 0.5, 1e-9);
+  ASSERT_NEAR(skewed_histogram.EstimateFraction(MakeBoundInclusive<double>(100), std::nullopt), 0.5, 1e-9);
+}
+
+TEST(Histogram, FewerValuesThanBuckets) {
+  auto histogram = Histogram::Build({1, 2, 3}, 64);
+  ASSERT_EQ(histogram.upper_bounds.size(), 3);
+  ASSERT_NEAR(histogram.EstimateFraction(std::nullopt, MakeBoundInclusive<double>(2)), 2.0 / 3, 1e-9);
+}
+
+TEST(LabelPropertyStatsBuilder, Estimates) {
+  // Each of the numbers is repeated, so there are many more values than
+  // distinct values, and more distinct values than the sketch holds.
+  constexpr int kDistinct = 50000;
+  memgraph::storage::LabelPropertyStatsBuilder builder;
+  for (int i = 0; i < 4 * kDistinct; ++i) builder.Add(PropertyValue(i % kDistinct));
+  builder.Add(PropertyValue("a"));
+  auto stats = builder.Finish();
+  ASSERT_EQ(stats.count, 4 * kDistinct + 1);
+  ASSERT_NEAR(static_cast<double>(stats.distinct_values_count), kDistinct + 1, 0.1 * kDistinct);
+  ASSERT_EQ(stats.histogram.count, 4 * kDistinct);
+  ASSERT_LE(stats.histogram.upper_bounds.size(), memgraph::storage::kHistogramMaxBuckets);
+  ASSERT_NEAR(stats.histogram.EstimateFraction(std::nullopt, MakeBoundExclusive<double>(kDistinct / 4)), 0.25, 0.03);
+}
+
+TEST(LabelPropertyStatsBuilder, ExactForFewDistinctValues) {
+  // Integers and equal doubles are the same value.
+  memgraph::storage::LabelPropertyStatsBuilder builder;
+  for (const auto &value : {PropertyValue(1), PropertyValue(1.0), PropertyValue(0), PropertyValue(-0.0),
+                            PropertyValue("1"), PropertyValue(std::vector<PropertyValue>{PropertyValue(1)})}) {
+    builder.Add(value);
+  }
+  auto stats = builder.Finish();
+  ASSERT_EQ(stats.count, 6);
+  ASSERT_EQ(stats.distinct_values_count, 4);
+  ASSERT_EQ(stats.histogram.count, 4);
+}
+
+class StatisticsTest : public ::testing::Test {
+ protected:
+  void TearDown() override { std::filesystem::remove_all(storage_directory_); }
+
+  // Creates 10 `Person` vertices with the `age` property set to `i % 5` and
+  // the edges `Person(i) -[:Knows]-> Person(i + 1)`.
+  static void CreateGraph(memgraph::storage::Storage *store) {
+    auto acc = store->Access();
+    auto person = acc.NameToLabel("Person");
+    auto age = acc.NameToProperty("age");
+    auto knows = acc.NameToEdgeType("Knows");
+    std::vector<memgraph::storage::VertexAccessor> vertices;
+    for (int i = 0; i < 10; ++i) {
+      auto vertex = acc.CreateVertex();
+      ASSERT_TRUE(vertex.AddLabel(person).HasValue());
+      ASSERT_TRUE(vertex.SetProperty(age, PropertyValue(i % 5)).HasValue());
+      vertices.push_back(vertex);
+    }
+    acc.CreateVertex();
+    for (int i = 0; i + 1 < 10; ++i) {
+      ASSERT_TRUE(acc.CreateEdge(&vertices[i], &vertices[i + 1], knows).HasValue());
+    }
+    ASSERT_FALSE(acc.Commit().HasError());
+  }
+
+  static void CheckStatistics(memgraph::storage::Storage *store) {
+    auto acc = store->Access();
+    const auto &statistics = acc.GetGraphStatistics();
+    ASSERT_EQ(statistics.vertex_count, 11);
+    ASSERT_EQ(statistics.edge_count, 9);
+
+    auto label_stats = acc.GetLabelStats(acc.NameToLabel("Person"));
+    ASSERT_TRUE(label_stats);
+    ASSERT_EQ(label_stats->count, 10);
+    ASSERT_DOUBLE_EQ(label_stats->avg_degree, 1.8);
+
+    auto property_stats = acc.GetLabelPropertyStats(acc.NameToLabel("Person"), acc.NameToProperty("age"));
+    ASSERT_TRUE(property_stats);
+    ASSERT_EQ(property_stats->count, 10);
+    ASSERT_EQ(property_stats->distinct_values_count, 5);
+    ASSERT_DOUBLE_EQ(property_stats->AvgGroupSize(), 2.0);
+    auto fraction =
+        property_stats->EstimateRangeFraction(MakeBoundInclusive(PropertyValue(0)), MakeBoundInclusive(PropertyValue(1)));
+    ASSERT_TRUE(fraction);
+    ASSERT_NEAR(*fraction, 0.4, 0.01);
+    ASSERT_FALSE(property_stats->EstimateRangeFraction(MakeBoundInclusive(PropertyValue("a")), std::nullopt));
+
+    auto edge_type_stats = acc.GetEdgeTypeStats(acc.NameToEdgeType("Knows"));
+    ASSERT_TRUE(edge_type_stats);
+    ASSERT_EQ(edge_type_stats->count, 9);
+    ASSERT_DOUBLE_EQ(edge_type_stats->avg_out_degree, 1.0);
+    ASSERT_DOUBLE_EQ(edge_type_stats->avg_in_degree, 1.0);
+
+    ASSERT_FALSE(acc.GetLabelStats(acc.NameToLabel("Other")));
+    ASSERT_FALSE(acc.GetLabelPropertyStats(acc.NameToLabel("Person"), acc.NameToProperty("name")));
+  }
+
+  static void Analyze(memgraph::storage::Storage *store) {
+    GraphStatistics statistics;
+    {
+      auto acc = store->Access();
+      statistics = acc.ComputeGraphStatistics();
+    }
+    ASSERT_FALSE(store->SetGraphStatistics(std::move(statistics)).HasError());
+  }
+
+  std::filesystem::path storage_directory_{std::filesystem::temp_directory_path() /
+                                           "MG_test_unit_storage_v2_statistics"};
+};
+
+TEST_F(StatisticsTest, Compute) {
+  memgraph::storage::Storage store;
+  ASSERT_FALSE(store.CreateIndex(store.NameToLabel("Person"), store.NameToProperty("age")).HasError());
+  CreateGraph(&store);
+  {
+    auto acc = store.Access();
+    ASSERT_TRUE(acc.GetGraphStatistics().empty());
+  }
+  Analyze(&store);
+  CheckStatistics(&store);
+
+  // Setting empty statistics drops the previous ones.
+  ASSERT_FALSE(store.SetGraphStatistics({}).HasError());
+  auto acc = store.Access();
+  ASSERT_TRUE(acc.GetGraphStatistics().empty());
+  ASSERT_FALSE(acc.GetLabelStats(acc.NameToLabel("Person")));
+}
+
+TEST(GraphStatistics, EncodingRoundtrip) {
+  memgraph::storage::NameIdMapper mapper;
+  auto label = memgraph::storage::LabelId::FromUint(mapper.NameToId("Person"));
+  auto property = memgraph::storage::PropertyId::FromUint(mapper.NameToId("age"));
+  auto edge_type = memgraph::storage::EdgeTypeId::FromUint(mapper.NameToId("Knows"));
+  GraphStatistics statistics;
+  statistics.vertex_count = 11;
+  statistics.edge_count = 9;
+  statistics.labels[label] = {10, 1.8};
+  statistics.label_properties[{label, property}] = {10, 5, Histogram::Build({0, 0, 1, 1, 2, 2, 3, 3, 4, 4}, 4)};
+  statistics.edge_types[edge_type] = {9, 1.0, 1.0};
+  const auto named = memgraph::storage::ToNamedGraphStatistics(statistics, &mapper);
+
+  const auto path = std::filesystem::temp_directory_path() / "MG_test_unit_storage_v2_statistics_encoding";
+  const std::string magic{"MGst"};
+  {
+    memgraph::storage::durability::Encoder encoder;
+    encoder.Initialize(path, magic, memgraph::storage::durability::kVersion);
+    memgraph::storage::EncodeGraphStatistics(&encoder, named);
+    encoder.Finalize();
+  }
+  {
+    memgraph::storage::durability::Decoder decoder;
+    ASSERT_TRUE(decoder.Initialize(path, magic));
+    auto decoded = memgraph::storage::DecodeGraphStatistics(&decoder);
+    ASSERT_TRUE(decoded);
+    ASSERT_EQ(*decoded, named);
+  }
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+  {
+    memgraph::storage::durability::Decoder decoder;
+    ASSERT_TRUE(decoder.Initialize(path, magic));
+    ASSERT_FALSE(memgraph::storage::DecodeGraphStatistics(&decoder));
+  }
+  std::filesystem::remove(path);
+
+  // The statistics are stored by name, so they have to be recovered correctly
+  // with a mapper which assigns different ids.
+  memgraph::storage::NameIdMapper other_mapper;
+  other_mapper.NameToId("unrelated");
+  auto other_label = memgraph::storage::LabelId::FromUint(other_mapper.NameToId("Person"));
+  auto other_property = memgraph::storage::PropertyId::FromUint(other_mapper.NameToId("age"));
+  auto other_edge_type = memgraph::storage::EdgeTypeId::FromUint(other_mapper.NameToId("Knows"));
+  auto recovered = memgraph::storage::FromNamedGraphStatistics(named, &other_mapper);
+  ASSERT_EQ(recovered.vertex_count, 11);
+  ASSERT_EQ(recovered.edge_count, 9);
+  ASSERT_EQ(recovered.labels.size(), 1);
+  ASSERT_EQ(recovered.labels[other_label], statistics.labels[label]);
+  ASSERT_EQ(recovered.label_properties.size(), 1);
+  ASSERT_EQ((recovered.label_properties[{other_label, other_property}]),
+            (statistics.label_properties[{label, property}]));
+  ASSERT_EQ(recovered.edge_types.size(), 1);
+  ASSERT_EQ(recovered.edge_types[other_edge_type], statistics.edge_types[edge_type]);
+}
+
+TEST_F(StatisticsTest, RecoverFromSnapshot) {
+  {
+    memgraph::storage::Storage store(
+        {.durability = {.storage_directory = storage_directory_, .snapshot_on_exit = true}});
+    ASSERT_FALSE(store.CreateIndex(store.NameToLabel("Person"), store.NameToProperty("age")).HasError());
+    CreateGraph(&store);
+    Analyze(&store);
+  }
+  memgraph::storage::Storage store({.durability = {.storage_directory = storage_directory_,
+                                                   .recover_on_startup = true}});
+  CheckStatistics(&store);
+}
+
+TEST_F(StatisticsTest, RecoverFromWal) {
+  {
+    memgraph::storage::Storage store(
+        {.durability = {
+             .storage_directory = storage_directory_,
+             .snapshot_wal_mode = memgraph::storage::Config::Durability::SnapshotWalMode::PERIODIC_SNAPSHOT_WITH_WAL,
+             .snapshot_interval = std::chrono::minutes(20)}});
+    ASSERT_FALSE(store.CreateIndex(store.NameToLabel("Person"), store.NameToProperty("age")).HasError());
+    CreateGraph(&store);
+    Analyze(&store);
+  }
+  memgraph::storage::Storage store({.durability = {.storage_directory = storage_directory_,
+                                                   .recover_on_startup = true}});
+  CheckStatistics(&store);
+}
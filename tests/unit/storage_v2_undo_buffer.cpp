@@ -0,0 +1,136 @@
+// Copyright 2023 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "storage/v2/undo_buffer.hpp"
+
+using memgraph::storage::Delta;
+using memgraph::storage::PropertyId;
+using memgraph::storage::PropertyValue;
+using memgraph::storage::UndoBuffer;
+
+namespace {
+std::vector<uint64_t> CommandIds(const UndoBuffer &buffer) {
+  std::vector<uint64_t> ids;
+  for (const auto &delta : buffer) ids.push_back(delta.command_id);
+  return ids;
+}
+}  // namespace
+
+TEST(UndoBuffer, Empty) {
+  UndoBuffer buffer;
+  ASSERT_TRUE(buffer.empty());
+  ASSERT_EQ(buffer.size(), 0);
+  ASSERT_EQ(buffer.BlockCount(), 0);
+  ASSERT_EQ(buffer.begin(), buffer.end());
+}
+
+TEST(UndoBuffer, StableAddresses) {
+  std::atomic<uint64_t> timestamp{0};
+  UndoBuffer buffer;
+  std::vector<Delta *> deltas;
+  std::vector<uint64_t> expected;
+  for (uint64_t i = 0; i < 10000; ++i) {
+    deltas.push_back(&buffer.emplace_back(Delta::DeleteObjectTag(), &timestamp, i));
+    expected.push_back(i);
+  }
+  ASSERT_EQ(buffer.size(), 10000);
+  ASSERT_EQ(CommandIds(buffer), expected);
+
+  // The deltas are linked into the version chains by their addresses, so they
+  // must not move when the buffer grows or when it is moved.
+  UndoBuffer moved(std::move(buffer));
+  ASSERT_TRUE(buffer.empty());
+  ASSERT_EQ(buffer.begin(), buffer.end());
+  uint64_t i = 0;
+  for (auto &delta : moved) {
+    ASSERT_EQ(&delta, deltas[i]);
+    ASSERT_EQ(delta.timestamp, &timestamp);
+    ++i;
+  }
+  ASSERT_EQ(i, 10000);
+}
+
+TEST(UndoBuffer, BlockGrowth) {
+  std::atomic<uint64_t> timestamp{0};
+  UndoBuffer buffer;
+  buffer.emplace_back(Delta::DeleteObjectTag(), &timestamp, 0);
+  ASSERT_EQ(buffer.BlockCount(), 1);
+  for (uint64_t i = 1; i < UndoBuffer::kFirstBlockCapacity; ++i) {
+    buffer.emplace_back(Delta::DeleteObjectTag(), &timestamp, i);
+  }
+  ASSERT_EQ(buffer.BlockCount(), 1);
+  buffer.emplace_back(Delta::DeleteObjectTag(), &timestamp, 0);
+  ASSERT_EQ(buffer.BlockCount(), 2);
+
+  // The blocks double in size until they reach the maximum capacity.
+  size_t capacity = UndoBuffer::kFirstBlockCapacity;
+  size_t total = 0;
+  size_t blocks = 0;
+  while (capacity < UndoBuffer::kMaxBlockCapacity) {
+    total += capacity;
+    capacity *= 2;
+    ++blocks;
+  }
+  total += 3 * UndoBuffer::kMaxBlockCapacity;
+  blocks += 3;
+
+  buffer.clear();
+  ASSERT_TRUE(buffer.empty());
+  ASSERT_EQ(buffer.BlockCount(), 0);
+  for (size_t i = 0; i < total; ++i) buffer.emplace_back(Delta::DeleteObjectTag(), &timestamp, i);
+  ASSERT_EQ(buffer.BlockCount(), blocks);
+  buffer.emplace_back(Delta::DeleteObjectTag(), &timestamp, total);
+  ASSERT_EQ(buffer.BlockCount(), blocks + 1);
+  ASSERT_EQ(buffer.size(), total + 1);
+}
+
+TEST(UndoBuffer, MoveAssignment) {
+  std::atomic<uint64_t> timestamp{0};
+  UndoBuffer first;
+  UndoBuffer second;
+  for (uint64_t i = 0; i < 100; ++i) first.emplace_back(Delta::DeleteObjectTag(), &timestamp, i);
+  for (uint64_t i = 0; i < 10; ++i) second.emplace_back(Delta::RecreateObjectTag(), &timestamp, 100 + i);
+  second = std::move(first);
+  ASSERT_TRUE(first.empty());
+  ASSERT_EQ(first.BlockCount(), 0);
+  ASSERT_EQ(second.size(), 100);
+  ASSERT_EQ(CommandIds(second).back(), 99);
+
+  // The moved-from buffer can be used again.
+  first.emplace_back(Delta::DeleteObjectTag(), &timestamp, 7);
+  ASSERT_EQ(CommandIds(first), std::vector<uint64_t>{7});
+}
+
+TEST(UndoBuffer, PropertyValues) {
+  std::atomic<uint64_t> timestamp{0};
+  UndoBuffer buffer;
+  const std::string value(1000, 'x');
+  for (uint64_t i = 0; i < 100; ++i) {
+    buffer.emplace_back(Delta::SetPropertyTag(), PropertyId::FromUint(i), PropertyValue(value), &timestamp, i);
+  }
+  uint64_t i = 0;
+  for (const auto &delta : buffer) {
+    ASSERT_EQ(delta.action, Delta::Action::SET_PROPERTY);
+    ASSERT_EQ(delta.property.key, PropertyId::FromUint(i));
+    ASSERT_EQ(delta.property.value.ValueString(), value);
+    ++i;
+  }
+  // The property values owned by the deltas are destroyed with the buffer.
+  buffer.clear();
+  ASSERT_TRUE(buffer.empty());
+}
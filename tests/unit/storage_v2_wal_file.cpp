@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -15,6 +15,7 @@
 
 #include <algorithm>
 #include <filesystem>
+#include <list>
 #include <string_view>
 
 #include "storage/v2/durability/exceptions.hpp"
@@ -22,6 +23,7 @@
 #include "storage/v2/durability/wal.hpp"
 #include "storage/v2/mvcc.hpp"
 #include "storage/v2/name_id_mapper.hpp"
+#include "storage/v2/statistics.hpp"
 #include "utils/file.hpp"
 #include "utils/file_locker.hpp"
 #include "utils/uuid.hpp"
@@ -46,9 +48,39 @@ memgraph::storage::durability::WalDeltaData::Type StorageGlobalOperationToWalDel
       return memgraph::storage::durability::WalDeltaData::Type::UNIQUE_CONSTRAINT_CREATE;
     case memgraph::storage::durability::StorageGlobalOperation::UNIQUE_CONSTRAINT_DROP:
       return memgraph::storage::durability::WalDeltaData::Type::UNIQUE_CONSTRAINT_DROP;
+    case memgraph::storage::durability::StorageGlobalOperation::EDGE_TYPE_INDEX_CREATE:
+      return memgraph::storage::durability::WalDeltaData::Type::EDGE_TYPE_INDEX_CREATE;
+    case memgraph::storage::durability::StorageGlobalOperation::EDGE_TYPE_INDEX_DROP:
+      return memgraph::storage::durability::WalDeltaData::Type::EDGE_TYPE_INDEX_DROP;
+    case memgraph::storage::durability::StorageGlobalOperation::EDGE_TYPE_PROPERTY_INDEX_CREATE:
+      return memgraph::storage::durability::WalDeltaData::Type::EDGE_TYPE_PROPERTY_INDEX_CREATE;
+    case memgraph::storage::durability::StorageGlobalOperation::EDGE_TYPE_PROPERTY_INDEX_DROP:
+      return memgraph::storage::durability::WalDeltaData::Type::EDGE_TYPE_PROPERTY_INDEX_DROP;
+    case memgraph::storage::durability::StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+      return memgraph::storage::durability::WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE;
+    case memgraph::storage::durability::StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+      return memgraph::storage::durability::WalDeltaData::Type::LABEL_PROPERTY_COMPOSITE_INDEX_DROP;
+    case memgraph::storage::durability::StorageGlobalOperation::GRAPH_STATISTICS_SET:
+      return memgraph::storage::durability::WalDeltaData::Type::GRAPH_STATISTICS_SET;
   }
 }
 
+// Helper function used to create the graph statistics of a single label and
+// its properties.
+memgraph::storage::NamedGraphStatistics MakeGraphStatistics(const std::string &label,
+                                                            const std::vector<std::string> &properties) {
+  memgraph::storage::NamedGraphStatistics statistics;
+  statistics.vertex_count = 10;
+  statistics.edge_count = 5;
+  statistics.labels.emplace_back(label, memgraph::storage::LabelStats{10, 1.0});
+  const auto histogram = memgraph::storage::Histogram::Build({1, 2, 3}, 2);
+  for (const auto &property : properties) {
+    statistics.label_properties.emplace_back(label, property, memgraph::storage::LabelPropertyStats{10, 5, histogram});
+  }
+  statistics.edge_types.emplace_back("Type", memgraph::storage::EdgeTypeStats{5, 1.0, 2.5});
+  return statistics;
+}
+
 // This class mimics the internals of the storage to generate the deltas.
 class DeltaGenerator final {
  public:
@@ -199,13 +231,27 @@ class DeltaGenerator final {
   }
 
   void AppendOperation(memgraph::storage::durability::StorageGlobalOperation operation, const std::string &label,
-                       const std::set<std::string> properties = {}) {
-    auto label_id = memgraph::storage::LabelId::FromUint(mapper_.NameToId(label));
-    std::set<memgraph::storage::PropertyId> property_ids;
+                       const std::vector<std::string> properties = {}) {
+    std::vector<memgraph::storage::PropertyId> property_ids;
     for (const auto &property : properties) {
-      property_ids.insert(memgraph::storage::PropertyId::FromUint(mapper_.NameToId(property)));
+      property_ids.push_back(memgraph::storage::PropertyId::FromUint(mapper_.NameToId(property)));
+    }
+    switch (operation) {
+      case memgraph::storage::durability::StorageGlobalOperation::EDGE_TYPE_INDEX_CREATE:
+      case memgraph::storage::durability::StorageGlobalOperation::EDGE_TYPE_INDEX_DROP:
+      case memgraph::storage::durability::StorageGlobalOperation::EDGE_TYPE_PROPERTY_INDEX_CREATE:
+      case memgraph::storage::durability::StorageGlobalOperation::EDGE_TYPE_PROPERTY_INDEX_DROP:
+        wal_file_.AppendOperation(operation, memgraph::storage::EdgeTypeId::FromUint(mapper_.NameToId(label)),
+                                  property_ids, timestamp_);
+        break;
+      case memgraph::storage::durability::StorageGlobalOperation::GRAPH_STATISTICS_SET:
+        wal_file_.AppendOperation(operation, MakeGraphStatistics(label, properties), timestamp_);
+        break;
+      default:
+        wal_file_.AppendOperation(operation, memgraph::storage::LabelId::FromUint(mapper_.NameToId(label)),
+                                  property_ids, timestamp_);
+        break;
     }
-    wal_file_.AppendOperation(operation, label_id, property_ids, timestamp_);
     if (valid_) {
       UpdateStats(timestamp_, 1);
       memgraph::storage::durability::WalDeltaData data;
@@ -224,7 +270,25 @@ class DeltaGenerator final {
         case memgraph::storage::durability::StorageGlobalOperation::UNIQUE_CONSTRAINT_CREATE:
         case memgraph::storage::durability::StorageGlobalOperation::UNIQUE_CONSTRAINT_DROP:
           data.operation_label_properties.label = label;
-          data.operation_label_properties.properties = properties;
+          data.operation_label_properties.properties = {properties.begin(), properties.end()};
+          break;
+        case memgraph::storage::durability::StorageGlobalOperation::EDGE_TYPE_INDEX_CREATE:
+        case memgraph::storage::durability::StorageGlobalOperation::EDGE_TYPE_INDEX_DROP:
+          data.operation_edge_type.edge_type = label;
+          break;
+        case memgraph::storage::durability::StorageGlobalOperation::EDGE_TYPE_PROPERTY_INDEX_CREATE:
+        case memgraph::storage::durability::StorageGlobalOperation::EDGE_TYPE_PROPERTY_INDEX_DROP:
+          data.operation_edge_type_property.edge_type = label;
+          data.operation_edge_type_property.property = *properties.begin();
+          break;
+        case memgraph::storage::durability::StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_CREATE:
+        case memgraph::storage::durability::StorageGlobalOperation::LABEL_PROPERTY_COMPOSITE_INDEX_DROP:
+          data.operation_label_property_list.label = label;
+          data.operation_label_property_list.properties = properties;
+          break;
+        case memgraph::storage::durability::StorageGlobalOperation::GRAPH_STATISTICS_SET:
+          data.operation_graph_statistics.statistics = MakeGraphStatistics(label, properties);
+          break;
       }
       data_.emplace_back(timestamp_, data);
     }
@@ -514,6 +578,13 @@ GENERATE_SIMPLE_TEST(AllGlobalOperations, {
   OPERATION(EXISTENCE_CONSTRAINT_DROP, "hello", {"world"});
   OPERATION(UNIQUE_CONSTRAINT_CREATE, "hello", {"world", "and", "universe"});
   OPERATION(UNIQUE_CONSTRAINT_DROP, "hello", {"world", "and", "universe"});
+  OPERATION(EDGE_TYPE_INDEX_CREATE, "hello");
+  OPERATION(EDGE_TYPE_INDEX_DROP, "hello");
+  OPERATION(EDGE_TYPE_PROPERTY_INDEX_CREATE, "hello", {"world"});
+  OPERATION(EDGE_TYPE_PROPERTY_INDEX_DROP, "hello", {"world"});
+  OPERATION(LABEL_PROPERTY_COMPOSITE_INDEX_CREATE, "hello", {"world", "and", "universe"});
+  OPERATION(LABEL_PROPERTY_COMPOSITE_INDEX_DROP, "hello", {"world", "and", "universe"});
+  OPERATION(GRAPH_STATISTICS_SET, "hello", {"world", "and", "universe"});
 });
 
 // NOLINTNEXTLINE(hicpp-special-member-functions)
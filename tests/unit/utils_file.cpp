@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -276,9 +276,63 @@ TEST_F(UtilsFileTest, OutputFileDescriptorLeackage) {
   }
 }
 
-TEST_F(UtilsFileTest, ConcurrentReadingAndWritting) {
+TEST_F(UtilsFileTest, OutputFileAsyncWrites) {
+  const auto file_path = storage / "existing_dir_777" / "async_file";
+  std::string expected;
+  {
+    memgraph::utils::OutputFile handle;
+    // The blocking writes are used if io_uring isn't available, the result
+    // has to be the same.
+    handle.EnableAsyncWrites();
+    handle.Open(file_path, memgraph::utils::OutputFile::Mode::OVERWRITE_EXISTING);
+    for (size_t i = 0; i < 3 * memgraph::utils::kFileBufferSize + 123; ++i) {
+      const auto value = static_cast<char>('a' + i % 26);
+      handle.Write(&value, 1);
+      expected.push_back(value);
+    }
+    ASSERT_EQ(handle.GetPosition(), expected.size());
+    ASSERT_EQ(handle.GetSize(), expected.size());
+
+    // Overwrite the start of the file and then append to it.
+    handle.SetPosition(memgraph::utils::OutputFile::Position::SET, 0);
+    handle.Write("overwritten");
+    expected.replace(0, 11, "overwritten");
+    handle.SetPosition(memgraph::utils::OutputFile::Position::RELATIVE_TO_END, 0);
+    const std::string appended(memgraph::utils::kFileBufferSize + 7, 'x');
+    handle.Write(appended);
+    expected += appended;
+    handle.Sync();
+    handle.Write("end");
+    expected += "end";
+    handle.Close();
+  }
+  std::ifstream stream(file_path);
+  const std::string content{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+  ASSERT_EQ(content.size(), expected.size());
+  ASSERT_EQ(content, expected);
+}
+
+TEST_F(UtilsFileTest, OutputFileAsyncWritesAppend) {
+  const auto file_path = storage / "existing_dir_777" / "existing_file_666";
+  const auto initial_size = fs::file_size(file_path);
+  memgraph::utils::OutputFile handle;
+  handle.EnableAsyncWrites();
+  handle.Open(file_path, memgraph::utils::OutputFile::Mode::APPEND_TO_EXISTING);
+  const std::string data(2 * memgraph::utils::kFileBufferSize + 5, 'y');
+  handle.Write(data);
+  ASSERT_EQ(handle.GetSize(), initial_size + data.size());
+  handle.Close();
+  ASSERT_EQ(fs::file_size(file_path), initial_size + data.size());
+}
+
+class UtilsFileConcurrentTest : public UtilsFileTest, public ::testing::WithParamInterface<bool> {};
+
+INSTANTIATE_TEST_CASE_P(AsyncWrites, UtilsFileConcurrentTest, ::testing::Bool());
+
+TEST_P(UtilsFileConcurrentTest, ConcurrentReadingAndWritting) {
   const auto file_path = storage / "existing_dir_777" / "existing_file_777";
   memgraph::utils::OutputFile handle;
+  if (GetParam()) handle.EnableAsyncWrites();
   handle.Open(file_path, memgraph::utils::OutputFile::Mode::OVERWRITE_EXISTING);
 
   std::default_random_engine engine(586478780);
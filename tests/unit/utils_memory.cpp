@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -12,6 +12,8 @@
 #include <cstdint>
 #include <cstring>
 #include <limits>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -323,6 +325,108 @@ TEST(PoolResource, BlockDeallocation) {
   EXPECT_EQ(test_mem.new_count_, 0U);
 }
 
+TEST(SlabResource, SmallBlockAllocations) {
+  TestMemory test_mem;
+  memgraph::utils::SlabResource mem(256U, 1U, &test_mem);
+  const size_t block_size = 100U;
+  const size_t rounded_block_size = 112U;
+  std::vector<void *> blocks;
+  for (size_t i = 0; i < 1000U; ++i) blocks.push_back(CheckAllocation(&mem, block_size));
+  auto stats = mem.GetStats();
+  EXPECT_EQ(stats.allocated_bytes, 1000U * rounded_block_size);
+  EXPECT_EQ(stats.reserved_bytes, stats.slabs * memgraph::utils::SlabResource::kSlabSize);
+  EXPECT_EQ(test_mem.new_count_, stats.slabs);
+  EXPECT_LT(stats.Fragmentation(), 0.2);
+
+  // Freed blocks are reused before new slabs are allocated.
+  mem.Deallocate(blocks.back(), block_size);
+  EXPECT_EQ(mem.Allocate(block_size), blocks.back());
+  EXPECT_EQ(test_mem.new_count_, stats.slabs);
+
+  // All but a single empty slab are returned to upstream once their blocks are
+  // freed.
+  for (auto *block : blocks) mem.Deallocate(block, block_size);
+  stats = mem.GetStats();
+  EXPECT_EQ(stats.allocated_bytes, 0U);
+  EXPECT_EQ(stats.slabs, 1U);
+  EXPECT_EQ(stats.released_slabs, test_mem.new_count_ - 1U);
+  EXPECT_DOUBLE_EQ(stats.Fragmentation(), 1.0);
+  EXPECT_EQ(mem.ReleaseEmptySlabs(), 1U);
+  EXPECT_EQ(mem.GetStats().reserved_bytes, 0U);
+  EXPECT_EQ(test_mem.delete_count_, test_mem.new_count_);
+}
+
+TEST(SlabResource, SizeClasses) {
+  memgraph::utils::SlabResource mem(256U, 1U);
+  // Blocks of different sizes come from different slabs, and the ones of the
+  // same size class share a slab.
+  auto *first = mem.Allocate(8U);
+  auto *second = mem.Allocate(16U);
+  auto *third = mem.Allocate(24U);
+  EXPECT_EQ(mem.GetStats().slabs, 2U);
+  EXPECT_EQ(mem.GetStats().allocated_bytes, 64U);
+  const auto slab_mask = ~(memgraph::utils::SlabResource::kSlabSize - 1U);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(first) & slab_mask, reinterpret_cast<uintptr_t>(second) & slab_mask);
+  EXPECT_NE(reinterpret_cast<uintptr_t>(first) & slab_mask, reinterpret_cast<uintptr_t>(third) & slab_mask);
+  mem.Deallocate(first, 8U);
+  mem.Deallocate(second, 16U);
+  mem.Deallocate(third, 24U);
+  EXPECT_EQ(mem.GetStats().allocated_bytes, 0U);
+}
+
+TEST(SlabResource, UnpooledAllocations) {
+  TestMemory test_mem;
+  memgraph::utils::SlabResource mem(64U, 1U, &test_mem);
+  // Blocks larger than the maximum block size and the ones with a larger
+  // alignment are forwarded to upstream.
+  auto *big = CheckAllocation(&mem, 128U);
+  auto *aligned = CheckAllocation(&mem, 32U, 2U * memgraph::utils::SlabResource::kBlockAlignment);
+  EXPECT_EQ(test_mem.new_count_, 2U);
+  EXPECT_EQ(mem.GetStats().reserved_bytes, 0U);
+  mem.Deallocate(big, 128U);
+  mem.Deallocate(aligned, 32U, 2U * memgraph::utils::SlabResource::kBlockAlignment);
+  EXPECT_EQ(test_mem.delete_count_, 2U);
+}
+
+TEST(SlabResource, MultipleThreads) {
+  memgraph::utils::SlabResource mem(256U, 4U);
+  const size_t num_threads = 8U;
+  const size_t num_blocks = 10000U;
+  std::vector<std::vector<void *>> blocks(num_threads);
+  {
+    std::vector<std::jthread> threads;
+    for (size_t i = 0; i < num_threads; ++i) {
+      threads.emplace_back([&mem, &blocks, i] {
+        for (size_t j = 0; j < num_blocks; ++j) {
+          auto *block = static_cast<size_t *>(mem.Allocate(sizeof(size_t) * (1U + j % 8U)));
+          *block = i;
+          blocks[i].push_back(block);
+        }
+      });
+    }
+  }
+  // The sizes of each 8 consecutive blocks are rounded up to 16, 16, 32, 32,
+  // 48, 48, 64 and 64 bytes.
+  EXPECT_EQ(mem.GetStats().allocated_bytes, num_threads * num_blocks / 8U * 320U);
+  {
+    // The blocks are freed by other threads than the ones which allocated them.
+    std::vector<std::jthread> threads;
+    for (size_t i = 0; i < num_threads; ++i) {
+      threads.emplace_back([&mem, &blocks, i] {
+        const auto &thread_blocks = blocks[(i + 1) % num_threads];
+        for (size_t j = 0; j < num_blocks; ++j) {
+          auto *block = static_cast<size_t *>(thread_blocks[j]);
+          EXPECT_EQ(*block, (i + 1) % num_threads);
+          mem.Deallocate(block, sizeof(size_t) * (1U + j % 8U));
+        }
+      });
+    }
+  }
+  EXPECT_EQ(mem.GetStats().allocated_bytes, 0U);
+  mem.ReleaseEmptySlabs();
+  EXPECT_EQ(mem.GetStats().reserved_bytes, 0U);
+}
+
 class AllocationTrackingMemory final : public memgraph::utils::MemoryResource {
  public:
   std::vector<size_t> allocated_sizes_;
@@ -1,4 +1,4 @@
-// Copyright 2022 Memgraph Ltd.
+// Copyright 2023 Memgraph Ltd.
 //
 // Use of this software is governed by the Business Source License
 // included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
@@ -40,3 +40,48 @@ TEST(Scheduler, TestFunctionExecuting) {
   scheduler.Stop();
   EXPECT_EQ(x, 3);
 }
+
+/**
+ * Scheduler runs every hour, but it is notified to run right away.
+ */
+TEST(Scheduler, TestNotify) {
+  std::atomic<int> x{0};
+  std::function<void()> func{[&x]() { ++x; }};
+  memgraph::utils::Scheduler scheduler;
+  scheduler.Run("Test", std::chrono::hours(1), func);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(x, 0);
+
+  scheduler.Notify();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(x, 1);
+
+  scheduler.Notify();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(x, 2);
+
+  scheduler.Stop();
+  EXPECT_EQ(x, 2);
+}
+
+/**
+ * Each notification made after the previous execution finished must be
+ * followed by another execution, even when it is made right as the scheduler
+ * thread starts to wait.
+ */
+TEST(Scheduler, TestNotifyIsNeverLost) {
+  std::atomic<int> x{0};
+  std::function<void()> func{[&x]() { ++x; }};
+  memgraph::utils::Scheduler scheduler;
+  scheduler.Run("Test", std::chrono::hours(1), func);
+
+  for (int i = 1; i <= 1000; ++i) {
+    scheduler.Notify();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (x < i && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+    ASSERT_GE(x, i);
+  }
+
+  scheduler.Stop();
+}